@@ -76,6 +76,10 @@ namespace components {
 /// If both `update-interval` and `full-update-interval` are present,
 /// `full-and-incremental` types is assumed. Otherwise `only-full` is used.
 ///
+/// Incremental updates usually copy the current data and Set() the modified
+/// copy. For big caches use a container with cheap copies, e.g.
+/// cache::PersistentHashMap, so the update does not copy the whole data.
+///
 /// @see `dump::Dumper` for more info on persistent cache dumps and
 /// corresponding config options.
 
@@ -1,16 +1,31 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <vector>
 
+#include <userver/cache/impl/clock_map.hpp>
 #include <userver/cache/lru_map.hpp>
 #include <userver/engine/mutex.hpp>
+#include <userver/engine/shared_mutex.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace cache {
 
+/// Eviction policy of the cache::NWayLRU ways
+enum class EvictionPolicy {
+  /// Exact LRU, every hit reorders the way under an exclusive lock
+  kLru,
+  /// CLOCK approximation of LRU, hits only set an access bit of the entry
+  /// and take a shared lock of the way. Better for read-mostly caches.
+  kClock,
+};
+
 /// @ingroup userver_containers
 template <typename T, typename U, typename Hash = std::hash<T>,
           typename Equal = std::equal_to<T>>
@@ -19,6 +34,9 @@ class NWayLRU final {
   NWayLRU(size_t ways, size_t way_size, const Hash& hash = Hash(),
           const Equal& equal = Equal());
 
+  NWayLRU(size_t ways, size_t way_size, EvictionPolicy policy,
+          const Hash& hash = Hash(), const Equal& equal = Equal());
+
   void Put(const T& key, U value);
 
   template <typename Validator>
@@ -42,6 +60,8 @@ class NWayLRU final {
 
   void UpdateWaySize(size_t way_size);
 
+  EvictionPolicy GetPolicy() const noexcept { return policy_; }
+
  private:
   struct Way {
     Way(Way&& other) noexcept : cache(std::move(other.cache)) {}
@@ -53,25 +73,59 @@ class NWayLRU final {
     LruMap<T, U, Hash, Equal> cache;
   };
 
+  struct ClockWay {
+    ClockWay(ClockWay&& other) noexcept : cache(std::move(other.cache)) {}
+
+    // max_size is not used, will be reset by SetMaxSize() in NWayLRU::NWayLRU
+    ClockWay(const Hash& hash, const Equal& equal) : cache(1, hash, equal) {}
+
+    mutable engine::SharedMutex mutex;
+    impl::ClockMap<T, U, Hash, Equal> cache;
+  };
+
+  size_t GetWayIndex(const T& key) const;
   Way& GetWay(const T& key);
+  ClockWay& GetClockWay(const T& key);
 
+  const EvictionPolicy policy_;
+  // Only the ways of the policy_ are populated
   std::vector<Way> caches_;
+  std::vector<ClockWay> clock_caches_;
   Hash hash_fn_;
 };
 
 template <typename T, typename U, typename Hash, typename Eq>
 NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size, const Hash& hash,
                                  const Eq& equal)
-    : caches_(), hash_fn_(hash) {
-  caches_.reserve(ways);
-  for (size_t i = 0; i < ways; ++i) caches_.emplace_back(hash, equal);
+    : NWayLRU(ways, way_size, EvictionPolicy::kLru, hash, equal) {}
+
+template <typename T, typename U, typename Hash, typename Eq>
+NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size,
+                                 EvictionPolicy policy, const Hash& hash,
+                                 const Eq& equal)
+    : policy_(policy), caches_(), clock_caches_(), hash_fn_(hash) {
   if (ways == 0) throw std::logic_error("Ways must be positive");
 
-  for (auto& way : caches_) way.cache.SetMaxSize(way_size);
+  if (policy_ == EvictionPolicy::kClock) {
+    clock_caches_.reserve(ways);
+    for (size_t i = 0; i < ways; ++i) clock_caches_.emplace_back(hash, equal);
+    for (auto& way : clock_caches_) way.cache.SetMaxSize(way_size);
+  } else {
+    caches_.reserve(ways);
+    for (size_t i = 0; i < ways; ++i) caches_.emplace_back(hash, equal);
+    for (auto& way : caches_) way.cache.SetMaxSize(way_size);
+  }
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::Put(const T& key, U value) {
+  if (policy_ == EvictionPolicy::kClock) {
+    auto& way = GetClockWay(key);
+    std::unique_lock<engine::SharedMutex> lock(way.mutex);
+    way.cache.Put(key, std::move(value));
+    return;
+  }
+
   auto& way = GetWay(key);
 
   std::unique_lock<engine::Mutex> lock(way.mutex);
@@ -82,6 +136,22 @@ template <typename T, typename U, typename Hash, typename Eq>
 template <typename Validator>
 std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key,
                                               Validator validator) {
+  if (policy_ == EvictionPolicy::kClock) {
+    auto& way = GetClockWay(key);
+    {
+      std::shared_lock<engine::SharedMutex> lock(way.mutex);
+      const auto* value = way.cache.Get(key);
+      if (!value) return std::nullopt;
+      if (validator(*value)) return *value;
+    }
+
+    // The value might have been replaced while the lock was released
+    std::unique_lock<engine::SharedMutex> lock(way.mutex);
+    const auto* value = way.cache.Get(key);
+    if (value && !validator(*value)) way.cache.Erase(key);
+    return std::nullopt;
+  }
+
   auto& way = GetWay(key);
   std::unique_lock<engine::Mutex> lock(way.mutex);
   auto* value = way.cache.Get(key);
@@ -96,6 +166,13 @@ std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key,
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
+  if (policy_ == EvictionPolicy::kClock) {
+    auto& way = GetClockWay(key);
+    std::unique_lock<engine::SharedMutex> lock(way.mutex);
+    way.cache.Erase(key);
+    return;
+  }
+
   auto& way = GetWay(key);
   std::unique_lock<engine::Mutex> lock(way.mutex);
   way.cache.Erase(key);
@@ -103,6 +180,12 @@ void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
 
 template <typename T, typename U, typename Hash, typename Eq>
 U NWayLRU<T, U, Hash, Eq>::GetOr(const T& key, const U& default_value) {
+  if (policy_ == EvictionPolicy::kClock) {
+    auto& way = GetClockWay(key);
+    std::shared_lock<engine::SharedMutex> lock(way.mutex);
+    return way.cache.GetOr(key, default_value);
+  }
+
   auto& way = GetWay(key);
   std::unique_lock<engine::Mutex> lock(way.mutex);
   return way.cache.GetOr(key, default_value);
@@ -114,6 +197,10 @@ void NWayLRU<T, U, Hash, Eq>::Invalidate() {
     std::unique_lock<engine::Mutex> lock(way.mutex);
     way.cache.Clear();
   }
+  for (auto& way : clock_caches_) {
+    std::unique_lock<engine::SharedMutex> lock(way.mutex);
+    way.cache.Clear();
+  }
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
@@ -123,6 +210,10 @@ void NWayLRU<T, U, Hash, Eq>::VisitAll(Function func) const {
     std::unique_lock<engine::Mutex> lock(way.mutex);
     way.cache.VisitAll(func);
   }
+  for (const auto& way : clock_caches_) {
+    std::shared_lock<engine::SharedMutex> lock(way.mutex);
+    way.cache.VisitAll(func);
+  }
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
@@ -132,6 +223,10 @@ size_t NWayLRU<T, U, Hash, Eq>::GetSize() const {
     std::unique_lock<engine::Mutex> lock(way.mutex);
     size += way.cache.GetSize();
   }
+  for (const auto& way : clock_caches_) {
+    std::shared_lock<engine::SharedMutex> lock(way.mutex);
+    size += way.cache.GetSize();
+  }
   return size;
 }
 
@@ -141,13 +236,30 @@ void NWayLRU<T, U, Hash, Eq>::UpdateWaySize(size_t way_size) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
     way.cache.SetMaxSize(way_size);
   }
+  for (auto& way : clock_caches_) {
+    std::unique_lock<engine::SharedMutex> lock(way.mutex);
+    way.cache.SetMaxSize(way_size);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+size_t NWayLRU<T, U, Hash, Eq>::GetWayIndex(const T& key) const {
+  const auto ways = std::max(caches_.size(), clock_caches_.size());
+  return hash_fn_(key) % ways;
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 typename NWayLRU<T, U, Hash, Eq>::Way& NWayLRU<T, U, Hash, Eq>::GetWay(
     const T& key) {
-  auto n = hash_fn_(key) % caches_.size();
-  return caches_[n];
+  UASSERT(policy_ == EvictionPolicy::kLru);
+  return caches_[GetWayIndex(key)];
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+typename NWayLRU<T, U, Hash, Eq>::ClockWay&
+NWayLRU<T, U, Hash, Eq>::GetClockWay(const T& key) {
+  UASSERT(policy_ == EvictionPolicy::kClock);
+  return clock_caches_[GetWayIndex(key)];
 }
 
 }  // namespace cache
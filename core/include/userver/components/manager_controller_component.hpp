@@ -45,6 +45,7 @@ class Manager;
 /// thread_name | set OS thread name to this value | -
 /// worker_threads | threads count for the task processor | -
 /// os-scheduling | OS scheduling mode for the task processor threads. 'idle' sets the lowest pririty. 'low-priority' sets the priority below 'normal' but higher than 'idle'. | normal
+/// task-processor-queue | Task queue implementation. 'global-task-queue' is a single queue shared by all the workers, 'work-stealing-task-queue' gives each worker its own run queue with work stealing between the workers. | global-task-queue
 /// task-trace | optional dictionary of tracing options | empty (disabled)
 /// task-trace.every | set N to trace each Nth task | 1000
 /// task-trace.max-context-switch-count | set upper limit of context switches to trace for a single task | 1000
@@ -75,6 +76,7 @@ class ManagerControllerComponent final : public impl::ComponentBase {
 
   const components::Manager& components_manager_;
   utils::statistics::Entry statistics_holder_;
+  utils::statistics::Entry logger_statistics_holder_;
   concurrent::AsyncEventSubscriberScope config_subscription_;
 };
 
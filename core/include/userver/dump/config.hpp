@@ -46,6 +46,8 @@ struct Config final {
   std::optional<std::chrono::milliseconds> max_dump_age;
   bool max_dump_age_set;
   bool dump_is_encrypted;
+  bool use_io_uring;
+  bool use_direct_io;
 
   bool dumps_enabled;
   std::chrono::milliseconds min_dump_interval;
@@ -84,6 +84,8 @@ enum class UpdateType {
 /// `min-interval` | `string` (duration) | `WriteDumpAsync` calls performed in a fast succession are ignored | `0s`
 /// `fs-task-processor` | `string` | `TaskProcessor` for blocking disk IO | `fs-task-processor`
 /// `encrypted` | `boolean` | Whether to encrypt the dump | `false`
+/// `io-uring` | `boolean` | Whether to use io_uring for the dump file I/O if the kernel supports it | `true`
+/// `direct-io` | `boolean` | Whether to bypass the page cache with O_DIRECT when writing and reading the dump | `false`
 /// `first-update-mode` | `string` | specifies whether required or best-effort first update will be used | skip
 /// `first-update-type` | `string` | specifies whether incremental and/or full first update will be used | full
 ///
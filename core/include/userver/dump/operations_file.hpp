@@ -4,8 +4,6 @@
 
 #include <boost/filesystem/operations.hpp>
 
-#include <userver/fs/blocking/c_file.hpp>
-#include <userver/utils/cpu_relax.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 
 #include <userver/dump/factory.hpp>
@@ -15,46 +13,65 @@ USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
-/// A handle to a dump file. File operations block the thread.
+/// Options of the dump file I/O
+struct FileIoOptions final {
+  /// Use io_uring if it is supported by the kernel, so that the thread is not
+  /// blocked for the duration of the I/O
+  bool use_io_uring{true};
+
+  /// Bypass the page cache with O_DIRECT if the filesystem supports it
+  bool use_direct_io{false};
+};
+
+/// @brief A handle to a dump file.
+///
+/// The data is written in large chunks, the next chunk is filled while the
+/// previous one is being written. Without io_uring the file operations block
+/// the thread.
 class FileWriter final : public Writer {
  public:
   /// @brief Creates a new dump file and opens it
   /// @throws `Error` on a filesystem error
   explicit FileWriter(std::string path, boost::filesystem::perms perms,
-                      tracing::ScopeTime& scope);
+                      tracing::ScopeTime& scope, FileIoOptions options = {});
+
+  ~FileWriter() override;
 
   void Finish() override;
 
  private:
   void WriteRaw(std::string_view data) override;
 
-  fs::blocking::CFile file_;
-  std::string final_path_;
-  std::string path_;
-  boost::filesystem::perms perms_;
-  utils::StreamingCpuRelax cpu_relax_;
+  struct Impl;
+  utils::FastPimpl<Impl, 280, 8> impl_;
 };
 
-/// A handle to a dump file. File operations block the thread.
+/// @brief A handle to a dump file.
+///
+/// The data is read in large chunks, the next chunk is read ahead while the
+/// current one is being parsed. Without io_uring the file operations block
+/// the thread.
 class FileReader final : public Reader {
  public:
   /// @brief Opens an existing dump file
   /// @throws `Error` on a filesystem error
-  explicit FileReader(std::string path);
+  explicit FileReader(std::string path, FileIoOptions options = {});
+
+  ~FileReader() override;
 
   void Finish() override;
 
  private:
   std::string_view ReadRaw(std::size_t max_size) override;
 
-  fs::blocking::CFile file_;
-  std::string path_;
-  std::string curr_chunk_;
+  struct Impl;
+  utils::FastPimpl<Impl, 200, 8> impl_;
 };
 
 class FileOperationsFactory final : public OperationsFactory {
  public:
-  explicit FileOperationsFactory(boost::filesystem::perms perms);
+  explicit FileOperationsFactory(boost::filesystem::perms perms,
+                                 FileIoOptions options = {});
 
   std::unique_ptr<Reader> CreateReader(std::string full_path) override;
 
@@ -63,6 +80,7 @@ class FileOperationsFactory final : public OperationsFactory {
 
  private:
   const boost::filesystem::perms perms_;
+  const FileIoOptions options_;
 };
 
 }  // namespace dump
@@ -44,6 +44,8 @@ FileInfoWithDataMap ReadRecursiveFilesInfoWithData(
     utils::Flags<SettingsReadFile> flags = {SettingsReadFile::kSkipHidden});
 
 /// @brief Reads file contents asynchronously
+/// @note Uses io_uring if it is supported by the kernel, `async_tp` is only
+/// used otherwise
 /// @param async_tp TaskProcessor for synchronous waiting
 /// @param path file to open
 /// @returns file contents
@@ -29,6 +29,8 @@ void CreateDirectories(engine::TaskProcessor& async_tp, std::string_view path);
 /// @brief Rewrite file contents asynchronously
 /// It doesn't provide strict atomic guarantees. If you need them, use
 /// `fs::RewriteFileContentsAtomically`.
+/// @note Uses io_uring if it is supported by the kernel, `async_tp` is only
+/// used otherwise
 /// @param async_tp TaskProcessor for synchronous waiting
 /// @param path file to rewrite
 /// @param contents new file contents
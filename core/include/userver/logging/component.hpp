@@ -9,7 +9,9 @@
 #include <userver/components/component_fwd.hpp>
 #include <userver/components/impl/component_base.hpp>
 #include <userver/concurrent/async_event_source.hpp>
+#include <userver/formats/json_fwd.hpp>
 #include <userver/os_signals/component.hpp>
+#include <userver/utils/statistics/fwd.hpp>
 
 #include <userver/utils/periodic_task.hpp>
 
@@ -83,6 +85,13 @@ class Logging final : public impl::ComponentBase {
   /// Reopens log files after rotation
   void OnLogRotate();
 
+  /// @cond
+  // Registered by ManagerControllerComponent, as StatisticsStorage itself
+  // depends on this component
+  formats::json::Value ExtendStatistics(
+      const utils::statistics::StatisticsRequest&);
+  /// @endcond
+
   class TestsuiteCaptureSink;
 
   static yaml_config::Schema GetStaticConfigSchema();
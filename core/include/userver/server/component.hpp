@@ -68,6 +68,10 @@ namespace components {
 /// connection.in_buffer_size | size of the buffer to preallocate for request receive: bigger values use more RAM and less CPU | 32 * 1024
 /// connection.requests_queue_size_threshold | drop requests from handlers that allow trottling if there's more pending requests than allowed by this value | 100
 /// connection.keepalive_timeout | timeout in seconds to drop connection if there's not data received from it | 600
+/// connection.http-version | '2' to additionally accept HTTP/2 connections with prior knowledge (h2c), '1.1' to accept only HTTP/1.1 | '1.1'
+/// connection.http2-session.max_concurrent_streams | max number of concurrently processed streams (requests) of a single HTTP/2 connection | 100
+/// connection.http2-session.max_frame_size | max size of a frame payload in bytes the server is willing to receive | 16384
+/// connection.http2-session.initial_window_size | initial stream-level flow control window size in bytes | 65535
 /// shards | how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing | -
 
 // clang-format on
@@ -36,6 +36,8 @@ struct HandlerConfig {
   std::optional<size_t> max_requests_in_flight;
   std::optional<size_t> max_requests_per_second;
   bool decompress_request{false};
+  bool compress_response{false};
+  size_t compress_response_min_size{1024};
   bool throttling_enabled{true};
   bool response_body_stream{false};
   std::optional<bool> set_response_server_hostname;
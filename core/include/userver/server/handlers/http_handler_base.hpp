@@ -143,6 +143,8 @@ class HttpHandlerBase : public HandlerBase {
   void CheckRatelimit(const http::HttpRequest& http_request) const;
 
   void DecompressRequestBody(http::HttpRequest& http_request) const;
+  void CompressResponse(const http::HttpRequest& http_request,
+                        http::HttpResponse& response) const;
 
   formats::json::ValueBuilder ExtendStatistics(
       const utils::statistics::StatisticsRequest&);
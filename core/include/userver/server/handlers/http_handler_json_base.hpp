@@ -3,6 +3,8 @@
 /// @file userver/server/handlers/http_handler_json_base.hpp
 /// @brief @copybrief server::handlers::HttpHandlerJsonBase
 
+#include <userver/formats/json/on_demand_value.hpp>
+#include <userver/formats/json/string_builder_fwd.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -16,6 +18,14 @@ namespace server::handlers {
 /// @brief Convenient base for handlers that accept requests with body in
 /// JSON format and respond with body in JSON format.
 ///
+/// ## Static options:
+/// Inherits all the options from server::handlers::HttpHandlerBase and adds
+/// the following ones:
+///
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// request-json-on-demand | parse the request body with formats::json::OnDemandValue and call HandleRequestJsonOnDemandThrow() | false
+///
 /// ## Example usage:
 ///
 /// @snippet samples/config_service/config_service.cpp Config service sample - component
@@ -36,6 +46,31 @@ class HttpHandlerJsonBase : public HttpHandlerBase {
       const formats::json::Value& request_json,
       request::RequestContext& context) const = 0;
 
+  /// @brief Override it to serialize the response with `WriteToStream`
+  /// functions, without building a DOM.
+  ///
+  /// The default implementation calls HandleRequestJsonThrow() and writes its
+  /// result.
+  /// @note Not called if the `request-json-on-demand` static option is set.
+  virtual void HandleRequestJsonStreamThrow(
+      const http::HttpRequest& request,
+      const formats::json::Value& request_json,
+      formats::json::StringBuilder& response_json,
+      request::RequestContext& context) const;
+
+  /// @brief Called instead of HandleRequestJsonThrow() if the
+  /// `request-json-on-demand` static option is set.
+  ///
+  /// Override it to read a few fields of large requests without building a
+  /// DOM. Note that the values of `request_json` are only validated on access.
+  ///
+  /// The default implementation materializes the whole request, responding
+  /// with a bad request to an invalid JSON, and calls HandleRequestJsonThrow().
+  virtual formats::json::Value HandleRequestJsonOnDemandThrow(
+      const http::HttpRequest& request,
+      const formats::json::OnDemandValue& request_json,
+      request::RequestContext& context) const;
+
   static yaml_config::Schema GetStaticConfigSchema();
 
  protected:
@@ -44,8 +79,15 @@ class HttpHandlerJsonBase : public HttpHandlerBase {
   static const formats::json::Value* GetRequestJson(
       const request::RequestContext& context);
 
+  /// @returns A pointer to the on-demand json request if the
+  /// `request-json-on-demand` static option is set and the request was indexed
+  /// successfully, or nullptr otherwise.
+  static const formats::json::OnDemandValue* GetRequestJsonOnDemand(
+      const request::RequestContext& context);
+
   /// @returns a pointer to json response if it was returned successfully by
-  /// `HandleRequestJsonThrow()` or nullptr otherwise.
+  /// `HandleRequestJsonThrow()` or nullptr otherwise. Responses written by
+  /// `HandleRequestJsonStreamThrow()` overrides are not available.
   static const formats::json::Value* GetResponseJson(
       const request::RequestContext& context);
 
@@ -55,6 +97,8 @@ class HttpHandlerJsonBase : public HttpHandlerBase {
  private:
   FormattedErrorData GetFormattedExternalErrorBody(
       const CustomHandlerException& exc) const final;
+
+  const bool request_json_on_demand_;
 };
 
 }  // namespace server::handlers
@@ -12,6 +12,7 @@
 #include <userver/server/http/form_data_arg.hpp>
 #include <userver/server/http/http_method.hpp>
 #include <userver/server/http/http_response.hpp>
+#include <userver/utils/impl/monotonic_arena.hpp>
 #include <userver/utils/impl/projecting_view.hpp>
 #include <userver/utils/str_icase.hpp>
 
@@ -25,13 +26,18 @@ class HttpRequestImpl;
 /// @brief HTTP Request data
 class HttpRequest final {
  public:
-  using HeadersMap =
-      std::unordered_map<std::string, std::string, utils::StrIcaseHash,
-                         utils::StrIcaseEqual>;
+  // Nodes of the request maps live in the per-request memory arena. Copies
+  // and move-assigned maps use the heap and may outlive the request.
+  using HeadersMap = std::unordered_map<
+      std::string, std::string, utils::StrIcaseHash, utils::StrIcaseEqual,
+      utils::impl::ArenaAllocator<std::pair<const std::string, std::string>>>;
 
   using HeadersMapKeys = decltype(utils::impl::MakeKeysView(HeadersMap()));
 
-  using CookiesMap = std::unordered_map<std::string, std::string>;
+  using CookiesMap = std::unordered_map<
+      std::string, std::string, std::hash<std::string>,
+      std::equal_to<std::string>,
+      utils::impl::ArenaAllocator<std::pair<const std::string, std::string>>>;
 
   using CookiesMapKeys = decltype(utils::impl::MakeKeysView(CookiesMap()));
 
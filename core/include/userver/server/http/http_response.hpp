@@ -4,8 +4,10 @@
 /// @brief @copybrief server::http::HttpResponse
 
 #include <chrono>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <userver/concurrent/queue.hpp>
 #include <userver/engine/single_consumer_event.hpp>
@@ -29,6 +31,7 @@ void OutputHeader(std::string& header, std::string_view key,
 }
 
 class HttpRequestImpl;
+class Http2Session;
 
 /// @brief HTTP Response data
 class HttpResponse final : public request::ResponseBase {
@@ -97,6 +100,12 @@ class HttpResponse final : public request::ResponseBase {
   /// @cond
   // TODO: server internals. remove from public interface
   void SendResponse(engine::io::Socket& socket) override;
+  void SendResponse(Http2Session& session, std::int32_t stream_id);
+
+  // Sends the responses with non-streamed bodies using a single write, used
+  // for the pipelined requests
+  static void SendResponses(engine::io::Socket& socket,
+                            const std::vector<HttpResponse*>& responses);
   /// @endcond
 
   void SetStatusServiceUnavailable() override {
@@ -116,8 +125,11 @@ class HttpResponse final : public request::ResponseBase {
   Queue::Producer GetBodyProducer();
 
  private:
+  // Status line and headers, without the body framing headers
+  std::string SerializeHeaders();
+  // Finishes the headers, returns the part of the body to send
+  std::string_view FinishHeadersNotstreamed(std::string& header);
   void SetBodyStreamed(engine::io::Socket& socket, std::string& header);
-  void SetBodyNotstreamed(engine::io::Socket& socket, std::string& header);
 
   const HttpRequestImpl& request_;
   HttpStatus status_ = HttpStatus::kOk;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include <userver/server/http/http_response.hpp>
@@ -7,6 +8,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace compression {
+class Compressor;
+}
+
 namespace server::handlers {
 class HttpHandlerBase;
 }
@@ -15,10 +20,13 @@ namespace server::http {
 
 class ResponseBodyStream final {
  public:
-  ResponseBodyStream(ResponseBodyStream&&) = default;
+  ResponseBodyStream(ResponseBodyStream&&) noexcept;
+  ~ResponseBodyStream();
 
   // Send a chunk of response data. It may NOT generate
   // exactly one HTTP chunk per call to PushBodyChunk().
+  // With `compress_response` enabled the chunk is compressed and flushed,
+  // so prefer pushing fewer bigger chunks.
   void PushBodyChunk(std::string&& chunk);
 
   void SetHeader(const std::string&, const std::string&);
@@ -32,11 +40,13 @@ class ResponseBodyStream final {
 
   ResponseBodyStream(
       server::http::HttpResponse::Queue::Producer&& queue_producer,
-      server::http::HttpResponse& http_response);
+      server::http::HttpResponse& http_response,
+      std::unique_ptr<compression::Compressor> compressor = nullptr);
 
   bool headers_ended_{false};
   HttpResponse::Queue::Producer queue_producer_;
   server::http::HttpResponse& http_response_;
+  std::unique_ptr<compression::Compressor> compressor_;
 };
 
 }  // namespace server::http
@@ -30,7 +30,7 @@ class InPlaceSpan final {
 
  private:
   struct Impl;
-  utils::FastPimpl<Impl, 4176, 8> impl_;
+  utils::FastPimpl<Impl, 2336, 8> impl_;
 };
 
 }  // namespace tracing
@@ -16,6 +16,23 @@ USERVER_NAMESPACE_BEGIN
 
 namespace tracing {
 
+/// @brief Name of a tracing::Span that the span does not copy.
+///
+/// The name must outlive the span, e.g. be a string literal:
+/// @code
+///   tracing::Span span{tracing::StaticSpanName{"my_span"}};
+/// @endcode
+class StaticSpanName final {
+ public:
+  constexpr explicit StaticSpanName(std::string_view name) noexcept
+      : name_(name) {}
+
+  constexpr std::string_view Get() const noexcept { return name_; }
+
+ private:
+  std::string_view name_;
+};
+
 /// @brief Measures the execution time of the current code block, links it with
 /// the parent tracing::Spans and stores that info in the log.
 ///
@@ -37,6 +54,11 @@ class Span final {
                 ReferenceType reference_type = ReferenceType::kChild,
                 logging::Level log_level = logging::Level::kInfo);
 
+  /// Same as above, but does not copy the name
+  explicit Span(StaticSpanName name,
+                ReferenceType reference_type = ReferenceType::kChild,
+                logging::Level log_level = logging::Level::kInfo);
+
   /// @cond
   // For internal use only
   explicit Span(Span::Impl& impl);
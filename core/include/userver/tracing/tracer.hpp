@@ -16,7 +16,7 @@ struct NoLogSpans;
 class Tracer : public std::enable_shared_from_this<Tracer> {
  public:
   static void SetNoLogSpans(NoLogSpans&& spans);
-  static bool IsNoLogSpan(const std::string& name);
+  static bool IsNoLogSpan(std::string_view name);
 
   static void SetTracer(TracerPtr tracer);
 
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+// Bump allocator that frees all the memory at once on destruction.
+// Starts from a caller-provided buffer, e.g. a member of the owning object,
+// then allocates geometrically growing blocks from the heap.
+// Not thread-safe.
+class MonotonicArena final {
+ public:
+  MonotonicArena() noexcept = default;
+  MonotonicArena(void* initial_buffer, std::size_t size) noexcept;
+
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena(MonotonicArena&&) = delete;
+  ~MonotonicArena();
+
+  void* Allocate(std::size_t size, std::size_t alignment) {
+    const auto current = reinterpret_cast<std::uintptr_t>(current_);
+    const auto aligned = (current + alignment - 1) & ~(alignment - 1);
+    if (current_ && aligned + size <= reinterpret_cast<std::uintptr_t>(end_)) {
+      current_ = reinterpret_cast<char*>(aligned + size);
+      return reinterpret_cast<void*>(aligned);
+    }
+    return AllocateSlow(size, alignment);
+  }
+
+  // Amount of heap blocks allocated by the arena
+  std::size_t GetBlocksCount() const noexcept { return blocks_count_; }
+
+ private:
+  struct BlockHeader {
+    BlockHeader* next;
+  };
+
+  void* AllocateSlow(std::size_t size, std::size_t alignment);
+
+  char* current_{nullptr};
+  char* end_{nullptr};
+  BlockHeader* blocks_{nullptr};
+  std::size_t blocks_count_{0};
+  std::size_t next_block_size_{0};
+};
+
+// Allocator for the standard containers that takes the memory from
+// MonotonicArena and never frees it. Default-constructed allocator uses the
+// heap, so do copies of the containers: a copy may outlive the arena.
+//
+// The allocator is never propagated on assignment or swap, so a container
+// assigned from an arena one keeps its own allocator and moves the elements.
+// Move construction always takes the arena, so the arena containers must not
+// be moved out of their owner.
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+  using is_always_equal = std::false_type;
+
+  ArenaAllocator() noexcept = default;
+
+  explicit ArenaAllocator(MonotonicArena& arena) noexcept : arena_(&arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+      : arena_(other.arena_) {}
+
+  T* allocate(std::size_t n) {
+    if (!arena_) return std::allocator<T>{}.allocate(n);
+    if (n > static_cast<std::size_t>(-1) / sizeof(T)) throw std::bad_alloc{};
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* ptr, std::size_t n) noexcept {
+    if (!arena_) std::allocator<T>{}.deallocate(ptr, n);
+  }
+
+  ArenaAllocator select_on_container_copy_construction() const noexcept {
+    return {};
+  }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const noexcept {
+    return arena_ == other.arena_;
+  }
+
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+    return arena_ != other.arena_;
+  }
+
+ private:
+  template <typename U>
+  friend class ArenaAllocator;
+
+  MonotonicArena* arena_{nullptr};
+};
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
@@ -89,6 +89,14 @@ properties:
                 type: boolean
                 description: Whether to encrypt the dump
                 defaultDescription: false
+            io-uring:
+                type: boolean
+                description: Whether to use io_uring for the dump file I/O if the kernel supports it
+                defaultDescription: true
+            direct-io:
+                type: boolean
+                description: Whether to bypass the page cache with O_DIRECT when writing and reading the dump
+                defaultDescription: false
             first-update-mode:
                 type: string
                 description: specifies whether required or best-effort first update will be used
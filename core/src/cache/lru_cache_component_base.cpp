@@ -70,6 +70,13 @@ properties:
     ways:
         type: integer
         description: number of ways for associative cache
+    eviction-policy:
+        type: string
+        description: eviction policy of the cache ways
+        defaultDescription: lru
+        enum:
+          - lru
+          - clock
     lifetime:
         type: string
         description: TTL for cache entries (0 is unlimited)
@@ -18,6 +18,13 @@ constexpr std::string_view kSize = "size";
 constexpr std::string_view kLifetime = "lifetime";
 constexpr std::string_view kBackgroundUpdate = "background-update";
 constexpr std::string_view kLifetimeMs = "lifetime-ms";
+constexpr std::string_view kEvictionPolicy = "eviction-policy";
+
+EvictionPolicy ParseEvictionPolicy(const std::string& value) {
+  if (value == "lru") return EvictionPolicy::kLru;
+  if (value == "clock") return EvictionPolicy::kClock;
+  throw std::runtime_error("Unknown cache eviction-policy: " + value);
+}
 
 }  // namespace
 
@@ -58,6 +65,8 @@ LruCacheConfigStatic::LruCacheConfigStatic(
     const yaml_config::YamlConfig& config)
     : config(config),
       ways(config[kWays].As<std::size_t>()),
+      policy(ParseEvictionPolicy(
+          config[kEvictionPolicy].As<std::string>("lru"))),
       use_dynamic_config(config["config-settings"].As<bool>(true)) {
   if (ways <= 0) throw std::runtime_error("cache-ways is non-positive");
 }
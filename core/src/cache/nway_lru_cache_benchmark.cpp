@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <vector>
+
+#include <userver/cache/nway_lru_cache.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kWays = 16;
+constexpr std::size_t kWaySize = 1024;
+constexpr unsigned kKeysCount = 4096;
+constexpr std::size_t kWorkerThreads = 4;
+
+}  // namespace
+
+// Every Get() is a hit, state.range(0) coroutines read concurrently
+template <cache::EvictionPolicy Policy>
+void nway_lru_hits(benchmark::State& state) {
+  engine::RunStandalone(kWorkerThreads, [&] {
+    cache::NWayLRU<unsigned, unsigned> cache(kWays, kWaySize, Policy);
+    for (unsigned i = 0; i < kKeysCount; ++i) cache.Put(i, i);
+
+    const auto coroutines = static_cast<std::size_t>(state.range(0));
+    std::atomic<bool> run{true};
+    std::atomic<std::size_t> hits{0};
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(coroutines - 1);
+    for (std::size_t i = 1; i < coroutines; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&cache, &run, &hits, i] {
+        std::size_t local_hits = 0;
+        for (unsigned key = i; run; key = (key + 1) % kKeysCount) {
+          benchmark::DoNotOptimize(cache.Get(key));
+          ++local_hits;
+        }
+        hits += local_hits;
+      }));
+    }
+
+    // Current coroutine work
+    unsigned key = 0;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(cache.Get(key));
+      key = (key + 1) % kKeysCount;
+    }
+
+    run = false;
+    for (auto& task : tasks) task.Get();
+    state.SetItemsProcessed(state.iterations() + hits.load());
+  });
+}
+
+BENCHMARK_TEMPLATE(nway_lru_hits, cache::EvictionPolicy::kLru)
+    ->RangeMultiplier(2)
+    ->Range(1, 64);
+
+BENCHMARK_TEMPLATE(nway_lru_hits, cache::EvictionPolicy::kClock)
+    ->RangeMultiplier(2)
+    ->Range(1, 64);
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,11 @@
 #include <userver/utest/utest.hpp>
 
+#include <atomic>
+#include <vector>
+
 #include <userver/cache/nway_lru_cache.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -54,4 +59,78 @@ UTEST(NWayLRU, SetMultipleWays) {
   EXPECT_EQ(1, cache.Get(1));
 }
 
+UTEST(NWayLRU, ClockSet) {
+  Cache cache(1, 2, cache::EvictionPolicy::kClock);
+  EXPECT_EQ(cache::EvictionPolicy::kClock, cache.GetPolicy());
+
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  EXPECT_EQ(2, cache.GetSize());
+
+  // 1 gets the second chance, 2 is evicted
+  EXPECT_EQ(1, cache.Get(1));
+  cache.Put(3, 3);
+
+  EXPECT_EQ(2, cache.GetSize());
+  EXPECT_EQ(1, cache.Get(1));
+  EXPECT_EQ(3, cache.Get(3));
+  EXPECT_FALSE(cache.Get(2).has_value());
+  EXPECT_EQ(-1, cache.GetOr(2, -1));
+}
+
+UTEST(NWayLRU, ClockGetExpired) {
+  Cache cache(1, 2, cache::EvictionPolicy::kClock);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+
+  EXPECT_FALSE(cache.Get(1, [](int) { return false; }).has_value());
+  EXPECT_EQ(1, cache.GetSize());
+
+  cache.InvalidateByKey(2);
+  EXPECT_EQ(0, cache.GetSize());
+}
+
+UTEST(NWayLRU, ClockUpdateWaySize) {
+  Cache cache(2, 10, cache::EvictionPolicy::kClock);
+  for (int i = 0; i < 20; ++i) cache.Put(i, i);
+  EXPECT_LE(cache.GetSize(), 20);
+
+  cache.UpdateWaySize(1);
+  EXPECT_LE(cache.GetSize(), 2);
+
+  std::size_t visited = 0;
+  cache.VisitAll([&visited](int key, int value) {
+    EXPECT_EQ(key, value);
+    ++visited;
+  });
+  EXPECT_EQ(visited, cache.GetSize());
+
+  cache.Invalidate();
+  EXPECT_EQ(0, cache.GetSize());
+}
+
+UTEST_MT(NWayLRU, ClockConcurrentHits, 4) {
+  constexpr int kKeys = 100;
+  Cache cache(4, kKeys, cache::EvictionPolicy::kClock);
+  for (int i = 0; i < kKeys; ++i) cache.Put(i, i);
+
+  std::atomic<int> misses{0};
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int i = 0; i < 8; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&cache, &misses] {
+      for (int j = 0; j < 1000; ++j) {
+        const auto value = cache.Get(j % kKeys);
+        if (!value) {
+          ++misses;
+        } else {
+          EXPECT_EQ(*value, j % kKeys);
+        }
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_EQ(misses, 0);
+}
+
 USERVER_NAMESPACE_END
@@ -92,6 +92,12 @@ properties:
                 type: integer
                 description: size of a single coroutine, bytes
                 defaultDescription: 256 * 1024
+            per-numa-node:
+                type: boolean
+                description: >
+                    keep the idle coroutines of each NUMA node separately, so
+                    that the coroutine stacks are reused by the same node
+                defaultDescription: false
     event_thread_pool:
         type: object
         description: event thread pool options
@@ -107,6 +113,19 @@ properties:
                 description: >
                     Whether to defer timer events to a per-thread periodic timer
                     or notify ev-loop right away
+            cpu-list:
+                type: string
+                description: >
+                    CPUs to pin the ev threads to, in the "0-3,8" format
+            numa-nodes:
+                type: array
+                description: >
+                    NUMA nodes to spread the ev threads over. Sockets prefer
+                    the ev threads of the NUMA node of the task that creates
+                    them.
+                items:
+                    type: integer
+                    description: NUMA node id
     components:
         type: object
         description: 'dictionary of "component name": "options"'
@@ -142,6 +161,32 @@ properties:
                       - normal
                       - low-priority
                       - idle
+                task-processor-queue:
+                    type: string
+                    description: |
+                        Task queue implementation for the task processor.
+                        `global-task-queue` is a single queue shared by all
+                        the workers. `work-stealing-task-queue` gives each
+                        worker its own run queue and lets idle workers steal
+                        tasks from the busy ones.
+                    defaultDescription: global-task-queue
+                    enum:
+                      - global-task-queue
+                      - work-stealing-task-queue
+                cpu-list:
+                    type: string
+                    description: |
+                        CPUs to pin the worker threads to, in the "0-3,8"
+                        format.
+                numa-nodes:
+                    type: array
+                    description: |
+                        NUMA nodes to spread the worker threads over
+                        round-robin. Combined with `cpu-list` the threads
+                        are pinned to the listed CPUs of the node.
+                    items:
+                        type: integer
+                        description: NUMA node id
                 task-trace:
                     type: object
                     description: .
@@ -35,6 +35,7 @@ components_manager:
     main-task-processor:
       thread_name: main-worker
       worker_threads: $main_worker_threads
+      task-processor-queue: work-stealing-task-queue
     monitor-task-processor:
       thread_name: mon-worker
       worker_threads: $monitor_worker_threads
@@ -201,6 +202,13 @@ TEST(ManagerConfig, Basic) {
   EXPECT_EQ(mc.coro_pool.max_size, 10000) << "config vars do not work";
   EXPECT_EQ(mc.coro_pool.initial_size, 5000) << "#fallback does not work";
   EXPECT_EQ(mc.task_processors.size(), 5);
+  for (const auto& task_processor : mc.task_processors) {
+    EXPECT_EQ(task_processor.task_processor_queue,
+              task_processor.name == "main-task-processor"
+                  ? engine::TaskQueueType::kWorkStealingTaskQueue
+                  : engine::TaskQueueType::kGlobalTaskQueue)
+        << task_processor.name;
+  }
 
   ASSERT_EQ(mc.components.size(), 27);
 
@@ -49,6 +49,7 @@ formats::json::ValueBuilder GetTaskProcessorStats(
   json_context_switch["slow"] = counter.GetTaskSwitchSlow();
   json_context_switch["fast"] = counter.GetTaskSwitchFast();
   json_context_switch["spurious_wakeups"] = counter.GetSpuriousWakeups();
+  json_context_switch["cross_numa_wakeups"] = counter.GetCrossNumaWakeups();
 
   json_context_switch["overloaded"] = counter.GetTasksOverloadSensor();
   json_context_switch["no_overloaded"] = counter.GetTasksNoOverloadSensor();
@@ -80,6 +81,11 @@ ManagerControllerComponent::ManagerControllerComponent(
       [this](const auto& request) { return ExtendStatistics(request); });
 
   auto& logger_component = context.FindComponent<components::Logging>();
+  logger_statistics_holder_ = storage.RegisterExtender(
+      "logger", [&logger_component](const auto& request) {
+        return logger_component.ExtendStatistics(request);
+      });
+
   for (const auto& [name, task_processor] :
        components_manager_.GetTaskProcessorsMap()) {
     const auto& logger_name = task_processor->GetTaskTraceLoggerName();
@@ -91,6 +97,7 @@ ManagerControllerComponent::ManagerControllerComponent(
 }
 
 ManagerControllerComponent::~ManagerControllerComponent() {
+  logger_statistics_holder_.Unregister();
   statistics_holder_.Unregister();
   config_subscription_.Unsubscribe();
 }
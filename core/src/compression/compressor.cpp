@@ -0,0 +1,242 @@
+#include <compression/compressor.hpp>
+
+#include <cstdint>
+
+#include <brotli/encode.h>
+#include <fmt/format.h>
+#include <zlib.h>
+#ifndef USERVER_NO_ZSTD
+#include <zstd.h>
+#endif
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression {
+namespace {
+
+constexpr std::size_t kOutputChunkSize = 16 * 1024;
+
+constexpr int kGzipDefaultLevel = 5;
+constexpr int kBrotliDefaultLevel = 4;
+constexpr int kZstdDefaultLevel = 3;
+
+// Lets the compression library write right into the output string, `func`
+// gets the free space and returns the size of it left unused
+template <typename Func>
+void AppendChunk(std::string& output, Func&& func) {
+  const auto old_size = output.size();
+  output.resize(old_size + kOutputChunkSize);
+  auto* out = reinterpret_cast<std::uint8_t*>(output.data() + old_size);
+  const std::size_t unused = func(out, kOutputChunkSize);
+  output.resize(old_size + kOutputChunkSize - unused);
+}
+
+void CheckLevel(Encoding encoding, int level, int min, int max) {
+  if (level < min || level > max) {
+    throw std::runtime_error(
+        fmt::format("Invalid {} compression level {}, expected [{}, {}]",
+                    ToString(encoding), level, min, max));
+  }
+}
+
+class GzipCompressor final : public Compressor {
+ public:
+  explicit GzipCompressor(int level) : Compressor(Encoding::kGzip) {
+    CheckLevel(Encoding::kGzip, level, Z_BEST_SPEED, Z_BEST_COMPRESSION);
+    // 16 makes zlib write the gzip header and trailer
+    if (deflateInit2(&stream_, level, Z_DEFLATED, MAX_WBITS + 16,
+                     MAX_MEM_LEVEL - 1, Z_DEFAULT_STRATEGY) != Z_OK) {
+      throw CompressionError("Failed to initialize gzip compressor");
+    }
+  }
+
+  ~GzipCompressor() override { deflateEnd(&stream_); }
+
+  void Compress(std::string_view input, std::string& output,
+                bool flush) override {
+    Deflate(input, output, flush ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+  }
+
+  void Finish(std::string& output) override { Deflate({}, output, Z_FINISH); }
+
+ private:
+  void Deflate(std::string_view input, std::string& output, int mode) {
+    stream_.next_in =
+        reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream_.avail_in = input.size();
+
+    // zlib reports that the output is not exhausted by filling it completely
+    bool is_output_full = true;
+    while (is_output_full) {
+      AppendChunk(output, [&](std::uint8_t* out, std::size_t size) {
+        stream_.next_out = out;
+        stream_.avail_out = size;
+        const auto result = deflate(&stream_, mode);
+        if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+          throw CompressionError(fmt::format("gzip compression failed: {}",
+                                             stream_.msg ? stream_.msg : ""));
+        }
+        is_output_full = stream_.avail_out == 0;
+        return stream_.avail_out;
+      });
+    }
+    UASSERT(stream_.avail_in == 0);
+  }
+
+  z_stream stream_{};
+};
+
+class BrotliCompressor final : public Compressor {
+ public:
+  explicit BrotliCompressor(int level)
+      : Compressor(Encoding::kBrotli),
+        state_(BrotliEncoderCreateInstance(nullptr, nullptr, nullptr)) {
+    CheckLevel(Encoding::kBrotli, level, BROTLI_MIN_QUALITY,
+               BROTLI_MAX_QUALITY);
+    if (!state_) throw CompressionError("Failed to create brotli compressor");
+    BrotliEncoderSetParameter(state_.get(), BROTLI_PARAM_QUALITY, level);
+  }
+
+  void Compress(std::string_view input, std::string& output,
+                bool flush) override {
+    Encode(input, output,
+           flush ? BROTLI_OPERATION_FLUSH : BROTLI_OPERATION_PROCESS);
+  }
+
+  void Finish(std::string& output) override {
+    Encode({}, output, BROTLI_OPERATION_FINISH);
+    UASSERT(BrotliEncoderIsFinished(state_.get()));
+  }
+
+ private:
+  struct Deleter {
+    void operator()(BrotliEncoderState* state) const noexcept {
+      BrotliEncoderDestroyInstance(state);
+    }
+  };
+
+  void Encode(std::string_view input, std::string& output,
+              BrotliEncoderOperation operation) {
+    auto* next_in = reinterpret_cast<const std::uint8_t*>(input.data());
+    std::size_t avail_in = input.size();
+
+    do {
+      AppendChunk(output, [&](std::uint8_t* out, std::size_t size) {
+        if (!BrotliEncoderCompressStream(state_.get(), operation, &avail_in,
+                                         &next_in, &size, &out, nullptr)) {
+          throw CompressionError("brotli compression failed");
+        }
+        return size;
+      });
+      // PROCESS may keep the input buffered inside without any output
+    } while (avail_in != 0 || BrotliEncoderHasMoreOutput(state_.get()) ||
+             (operation == BROTLI_OPERATION_FINISH &&
+              !BrotliEncoderIsFinished(state_.get())));
+  }
+
+  std::unique_ptr<BrotliEncoderState, Deleter> state_;
+};
+
+#ifndef USERVER_NO_ZSTD
+class ZstdCompressor final : public Compressor {
+ public:
+  explicit ZstdCompressor(int level)
+      : Compressor(Encoding::kZstd), context_(ZSTD_createCCtx()) {
+    CheckLevel(Encoding::kZstd, level, 1, ZSTD_maxCLevel());
+    if (!context_) throw CompressionError("Failed to create zstd compressor");
+    ZSTD_CCtx_setParameter(context_.get(), ZSTD_c_compressionLevel, level);
+  }
+
+  void Compress(std::string_view input, std::string& output,
+                bool flush) override {
+    CompressStream(input, output, flush ? ZSTD_e_flush : ZSTD_e_continue);
+  }
+
+  void Finish(std::string& output) override {
+    CompressStream({}, output, ZSTD_e_end);
+  }
+
+ private:
+  struct Deleter {
+    void operator()(ZSTD_CCtx* context) const noexcept {
+      ZSTD_freeCCtx(context);
+    }
+  };
+
+  void CompressStream(std::string_view input, std::string& output,
+                      ZSTD_EndDirective mode) {
+    ZSTD_inBuffer in{input.data(), input.size(), 0};
+    std::size_t remaining = 0;
+
+    do {
+      AppendChunk(output, [&](std::uint8_t* out, std::size_t size) {
+        ZSTD_outBuffer out_buffer{out, size, 0};
+        remaining =
+            ZSTD_compressStream2(context_.get(), &out_buffer, &in, mode);
+        if (ZSTD_isError(remaining)) {
+          throw CompressionError(fmt::format("zstd compression failed: {}",
+                                             ZSTD_getErrorName(remaining)));
+        }
+        return size - out_buffer.pos;
+      });
+      // `remaining` is the size of the data yet to be flushed
+    } while (in.pos != in.size || (mode != ZSTD_e_continue && remaining != 0));
+  }
+
+  std::unique_ptr<ZSTD_CCtx, Deleter> context_;
+};
+#endif
+
+}  // namespace
+
+Compressor::~Compressor() = default;
+
+std::unique_ptr<Compressor> Compressor::Create(Encoding encoding,
+                                               std::optional<int> level) {
+  const int actual_level = level.value_or(GetDefaultLevel(encoding));
+  switch (encoding) {
+    case Encoding::kGzip:
+      return std::make_unique<GzipCompressor>(actual_level);
+    case Encoding::kBrotli:
+      return std::make_unique<BrotliCompressor>(actual_level);
+    case Encoding::kZstd:
+#ifndef USERVER_NO_ZSTD
+      return std::make_unique<ZstdCompressor>(actual_level);
+#else
+      break;
+#endif
+    case Encoding::kIdentity:
+      break;
+  }
+  throw std::runtime_error(fmt::format("Compression with '{}' is not supported",
+                                       ToString(encoding)));
+}
+
+std::string Compress(Encoding encoding, std::string_view data,
+                     std::optional<int> level) {
+  auto compressor = Compressor::Create(encoding, level);
+  std::string result;
+  compressor->Compress(data, result, /*flush=*/false);
+  compressor->Finish(result);
+  return result;
+}
+
+int GetDefaultLevel(Encoding encoding) {
+  switch (encoding) {
+    case Encoding::kGzip:
+      return kGzipDefaultLevel;
+    case Encoding::kBrotli:
+      return kBrotliDefaultLevel;
+    case Encoding::kZstd:
+      return kZstdDefaultLevel;
+    case Encoding::kIdentity:
+      return 0;
+  }
+  UINVARIANT(false, "Unexpected compression encoding");
+}
+
+}  // namespace compression
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <compression/encoding.hpp>
+#include <compression/error.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression {
+
+/// @brief Streaming compressor, appends the compressed data to the output.
+///
+/// Not thread-safe, one instance compresses a single stream.
+class Compressor {
+ public:
+  virtual ~Compressor();
+
+  /// @brief Creates a compressor for the coding, uses the default level for
+  /// the coding if none is specified.
+  /// @throws std::runtime_error for kIdentity and invalid levels
+  static std::unique_ptr<Compressor> Create(
+      Encoding encoding, std::optional<int> level = std::nullopt);
+
+  Encoding GetEncoding() const { return encoding_; }
+
+  /// @brief Compresses the input.
+  /// @param flush makes all the data passed so far decodable from the output
+  /// at the cost of the compression ratio, use it before sending a chunk
+  /// @throws CompressionError
+  virtual void Compress(std::string_view input, std::string& output,
+                        bool flush) = 0;
+
+  /// @brief Completes the stream, no other calls are allowed afterwards.
+  /// @throws CompressionError
+  virtual void Finish(std::string& output) = 0;
+
+ protected:
+  explicit Compressor(Encoding encoding) : encoding_(encoding) {}
+
+ private:
+  const Encoding encoding_;
+};
+
+/// Compresses the whole string in one go
+std::string Compress(Encoding encoding, std::string_view data,
+                     std::optional<int> level = std::nullopt);
+
+/// Level used when none is specified
+int GetDefaultLevel(Encoding encoding);
+
+}  // namespace compression
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,121 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <compression/compressor.hpp>
+#include <compression/decompressor.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kDataSize = 1024 * 1024;
+constexpr std::size_t kChunkSize = 16 * 1024;
+constexpr double kMegabyte = 1024 * 1024;
+
+// A JSON array of typical API objects
+std::string MakeJsonData() {
+  std::string data = "[";
+  for (std::size_t i = 0; data.size() < kDataSize; ++i) {
+    data += R"({"id":)" + std::to_string(i * 7919) + R"(,"name":"item-)" +
+            std::to_string(i % 1000) + R"(","price":)" +
+            std::to_string(i % 97) + "." + std::to_string(i % 100) +
+            R"(,"tags":["new","sale"],"available":)" +
+            (i % 3 ? "true" : "false") + "},";
+  }
+  data.back() = ']';
+  return data;
+}
+
+const std::string& GetJsonData() {
+  static const std::string kData = MakeJsonData();
+  return kData;
+}
+
+void SetCounters(benchmark::State& state, std::size_t compressed_size) {
+  const auto& data = GetJsonData();
+  state.SetBytesProcessed(state.iterations() * data.size());
+  // CPU seconds per megabyte of the input
+  state.counters["cpu_s_per_mb"] = benchmark::Counter(
+      state.iterations() * data.size() / kMegabyte,
+      benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+  state.counters["ratio"] = static_cast<double>(data.size()) / compressed_size;
+}
+
+}  // namespace
+
+// state.range(0) is the compression level
+template <compression::Encoding Encoding>
+void compression_compress(benchmark::State& state) {
+  const auto& data = GetJsonData();
+  const auto level = static_cast<int>(state.range(0));
+  std::size_t compressed_size = 0;
+
+  for ([[maybe_unused]] auto _ : state) {
+    const auto compressed = compression::Compress(Encoding, data, level);
+    compressed_size = compressed.size();
+    benchmark::DoNotOptimize(compressed);
+  }
+  SetCounters(state, compressed_size);
+}
+BENCHMARK_TEMPLATE(compression_compress, compression::Encoding::kGzip)
+    ->DenseRange(1, 9);
+BENCHMARK_TEMPLATE(compression_compress, compression::Encoding::kBrotli)
+    ->DenseRange(0, 11);
+#ifndef USERVER_NO_ZSTD
+BENCHMARK_TEMPLATE(compression_compress, compression::Encoding::kZstd)
+    ->DenseRange(1, 19, 2);
+#endif
+
+// The way the response body stream does it, flushing every chunk
+template <compression::Encoding Encoding>
+void compression_compress_chunked(benchmark::State& state) {
+  const std::string_view data = GetJsonData();
+  const auto level = static_cast<int>(state.range(0));
+  std::size_t compressed_size = 0;
+
+  for ([[maybe_unused]] auto _ : state) {
+    auto compressor = compression::Compressor::Create(Encoding, level);
+    compressed_size = 0;
+    for (std::size_t pos = 0; pos < data.size(); pos += kChunkSize) {
+      std::string compressed;
+      compressor->Compress(data.substr(pos, kChunkSize), compressed,
+                           /*flush=*/true);
+      compressed_size += compressed.size();
+    }
+    std::string tail;
+    compressor->Finish(tail);
+    compressed_size += tail.size();
+  }
+  SetCounters(state, compressed_size);
+}
+BENCHMARK_TEMPLATE(compression_compress_chunked, compression::Encoding::kGzip)
+    ->Arg(1)
+    ->Arg(compression::GetDefaultLevel(compression::Encoding::kGzip));
+BENCHMARK_TEMPLATE(compression_compress_chunked, compression::Encoding::kBrotli)
+    ->Arg(1)
+    ->Arg(compression::GetDefaultLevel(compression::Encoding::kBrotli));
+#ifndef USERVER_NO_ZSTD
+BENCHMARK_TEMPLATE(compression_compress_chunked, compression::Encoding::kZstd)
+    ->Arg(1)
+    ->Arg(compression::GetDefaultLevel(compression::Encoding::kZstd));
+#endif
+
+template <compression::Encoding Encoding>
+void compression_decompress(benchmark::State& state) {
+  const auto& data = GetJsonData();
+  const auto compressed = compression::Compress(Encoding, data);
+
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(
+        compression::Decompress(Encoding, compressed, data.size()));
+  }
+  SetCounters(state, compressed.size());
+}
+BENCHMARK_TEMPLATE(compression_decompress, compression::Encoding::kGzip);
+BENCHMARK_TEMPLATE(compression_decompress, compression::Encoding::kBrotli);
+#ifndef USERVER_NO_ZSTD
+BENCHMARK_TEMPLATE(compression_decompress, compression::Encoding::kZstd);
+#endif
+
+USERVER_NAMESPACE_END
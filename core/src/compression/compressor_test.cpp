@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <compression/compressor.hpp>
+#include <compression/decompressor.hpp>
+#include <compression/gzip.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string MakeData(std::size_t size) {
+  std::string data;
+  data.reserve(size);
+  for (std::size_t i = 0; data.size() < size; ++i) {
+    data += R"({"id":)" + std::to_string(i) + R"(,"name":"item"},)";
+  }
+  data.resize(size);
+  return data;
+}
+
+class CompressionEncoding
+    : public ::testing::TestWithParam<compression::Encoding> {};
+
+}  // namespace
+
+INSTANTIATE_TEST_SUITE_P(/*no prefix*/, CompressionEncoding,
+                         ::testing::ValuesIn(
+                             compression::GetSupportedEncodings()));
+
+TEST_P(CompressionEncoding, RoundTrip) {
+  const auto data = MakeData(100 * 1024);
+  const auto compressed = compression::Compress(GetParam(), data);
+  EXPECT_LT(compressed.size(), data.size() / 4);
+  EXPECT_EQ(compression::Decompress(GetParam(), compressed, data.size()),
+            data);
+}
+
+TEST_P(CompressionEncoding, Empty) {
+  const auto compressed = compression::Compress(GetParam(), {});
+  EXPECT_EQ(compression::Decompress(GetParam(), compressed, 0), "");
+}
+
+TEST_P(CompressionEncoding, FlushedChunksAreDecodable) {
+  auto compressor = compression::Compressor::Create(GetParam());
+  auto decompressor = compression::Decompressor::Create(GetParam(), 1 << 20);
+
+  std::string expected;
+  std::string decompressed;
+  for (int i = 0; i < 10; ++i) {
+    const auto chunk = MakeData(1000 + i);
+    expected += chunk;
+
+    std::string compressed;
+    compressor->Compress(chunk, compressed, /*flush=*/true);
+    decompressor->Decompress(compressed, decompressed);
+    EXPECT_EQ(decompressed, expected);
+  }
+
+  std::string tail;
+  compressor->Finish(tail);
+  decompressor->Decompress(tail, decompressed);
+  decompressor->Finish();
+  EXPECT_EQ(decompressed, expected);
+}
+
+TEST_P(CompressionEncoding, ByteByByte) {
+  const auto data = MakeData(10000);
+  const auto compressed = compression::Compress(GetParam(), data);
+
+  auto decompressor = compression::Decompressor::Create(GetParam(), 10000);
+  std::string decompressed;
+  for (char c : compressed) {
+    decompressor->Decompress(std::string_view{&c, 1}, decompressed);
+  }
+  decompressor->Finish();
+  EXPECT_EQ(decompressed, data);
+}
+
+TEST_P(CompressionEncoding, TooBig) {
+  const auto data = std::string(10 * 1024 * 1024, 'a');
+  const auto compressed = compression::Compress(GetParam(), data);
+
+  EXPECT_THROW(compression::Decompress(GetParam(), compressed, 1024),
+               compression::TooBigError);
+  EXPECT_THROW(
+      compression::Decompress(GetParam(), compressed, data.size() - 1),
+      compression::TooBigError);
+  EXPECT_EQ(compression::Decompress(GetParam(), compressed, data.size()),
+            data);
+}
+
+TEST_P(CompressionEncoding, Truncated) {
+  const auto compressed = compression::Compress(GetParam(), MakeData(10000));
+
+  EXPECT_THROW(compression::Decompress(
+                   GetParam(), compressed.substr(0, compressed.size() / 2),
+                   1 << 20),
+               compression::DecompressionError);
+}
+
+TEST_P(CompressionEncoding, Garbage) {
+  EXPECT_THROW(
+      compression::Decompress(GetParam(), "definitely not compressed", 1024),
+      compression::DecompressionError);
+}
+
+TEST_P(CompressionEncoding, Concatenated) {
+  const auto first = MakeData(5000);
+  const auto second = MakeData(3000);
+  const auto compressed = compression::Compress(GetParam(), first) +
+                          compression::Compress(GetParam(), second);
+  const auto expected = first + second;
+
+  if (GetParam() == compression::Encoding::kBrotli) {
+    // RFC 7932 has no concatenated streams
+    EXPECT_THROW(compression::Decompress(GetParam(), compressed, 1 << 20),
+                 compression::DecompressionError);
+    return;
+  }
+
+  EXPECT_EQ(compression::Decompress(GetParam(), compressed, expected.size()),
+            expected);
+  EXPECT_THROW(
+      compression::Decompress(GetParam(), compressed, expected.size() - 1),
+      compression::TooBigError);
+
+  auto decompressor =
+      compression::Decompressor::Create(GetParam(), expected.size());
+  std::string decompressed;
+  for (char c : compressed) {
+    decompressor->Decompress(std::string_view{&c, 1}, decompressed);
+  }
+  decompressor->Finish();
+  EXPECT_EQ(decompressed, expected);
+}
+
+TEST_P(CompressionEncoding, InvalidLevel) {
+  EXPECT_THROW(compression::Compressor::Create(GetParam(), 100),
+               std::runtime_error);
+}
+
+TEST(Compression, GzipDecompress) {
+  const auto data = MakeData(5000);
+  const auto compressed =
+      compression::Compress(compression::Encoding::kGzip, data);
+  EXPECT_EQ(compression::gzip::Decompress(compressed, data.size()), data);
+  EXPECT_THROW(compression::gzip::Decompress(compressed, data.size() - 1),
+               compression::TooBigError);
+}
+
+TEST(Compression, Negotiate) {
+  using compression::Encoding;
+  const std::vector<Encoding> supported{Encoding::kZstd, Encoding::kBrotli,
+                                        Encoding::kGzip};
+  const auto negotiate = [&supported](std::string_view accept_encoding) {
+    return compression::NegotiateEncoding(accept_encoding, supported);
+  };
+
+  EXPECT_EQ(negotiate(""), Encoding::kIdentity);
+  EXPECT_EQ(negotiate("identity"), Encoding::kIdentity);
+  EXPECT_EQ(negotiate("deflate, compress"), Encoding::kIdentity);
+  EXPECT_EQ(negotiate("gzip"), Encoding::kGzip);
+  EXPECT_EQ(negotiate("GZip"), Encoding::kGzip);
+  EXPECT_EQ(negotiate("gzip, deflate, br"), Encoding::kBrotli);
+  EXPECT_EQ(negotiate("gzip;q=1.0, br;q=0.5"), Encoding::kGzip);
+  EXPECT_EQ(negotiate("gzip ; q=0.8 , br ; q=0.9"), Encoding::kBrotli);
+  EXPECT_EQ(negotiate("br;q=0, gzip;q=0"), Encoding::kIdentity);
+  EXPECT_EQ(negotiate("*"), Encoding::kZstd);
+  EXPECT_EQ(negotiate("zstd;q=0, *"), Encoding::kBrotli);
+  EXPECT_EQ(negotiate("*;q=0.5, gzip"), Encoding::kGzip);
+  EXPECT_EQ(negotiate("gzip;q=bad"), Encoding::kGzip);
+  EXPECT_EQ(negotiate(",, ,gzip,"), Encoding::kGzip);
+
+  EXPECT_EQ(compression::NegotiateEncoding("zstd, br", {Encoding::kGzip}),
+            Encoding::kIdentity);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,227 @@
+#include <compression/decompressor.hpp>
+
+#include <cstdint>
+
+#include <brotli/decode.h>
+#include <fmt/format.h>
+#include <zlib.h>
+#ifndef USERVER_NO_ZSTD
+#include <zstd.h>
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression {
+namespace {
+
+constexpr std::size_t kOutputChunkSize = 16 * 1024;
+
+class GzipDecompressor final : public Decompressor {
+ public:
+  explicit GzipDecompressor(std::size_t max_size) : Decompressor(max_size) {
+    // 16 makes zlib expect the gzip header and trailer
+    if (inflateInit2(&stream_, MAX_WBITS + 16) != Z_OK) {
+      throw DecompressionError("Failed to initialize gzip decompressor");
+    }
+  }
+
+  ~GzipDecompressor() override { inflateEnd(&stream_); }
+
+ private:
+  std::size_t DoDecompress(std::string_view& input, char* out,
+                           std::size_t out_size) override {
+    stream_.next_in =
+        reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream_.avail_in = input.size();
+    stream_.next_out = reinterpret_cast<Bytef*>(out);
+    stream_.avail_out = out_size;
+
+    const auto result = inflate(&stream_, Z_NO_FLUSH);
+    if (result == Z_STREAM_END) {
+      is_finished_ = true;
+    } else if (result != Z_OK && result != Z_BUF_ERROR) {
+      throw DecompressionError(fmt::format("Failed to decompress gzip: {}",
+                                           stream_.msg ? stream_.msg : ""));
+    }
+
+    input.remove_prefix(input.size() - stream_.avail_in);
+    return out_size - stream_.avail_out;
+  }
+
+  bool IsFinished() const override { return is_finished_; }
+
+  // Multi-member gzip, RFC 1952
+  void StartNextStream() override {
+    if (inflateReset(&stream_) != Z_OK) {
+      throw DecompressionError("Failed to reset gzip decompressor");
+    }
+    is_finished_ = false;
+  }
+
+  z_stream stream_{};
+  bool is_finished_{false};
+};
+
+class BrotliDecompressor final : public Decompressor {
+ public:
+  explicit BrotliDecompressor(std::size_t max_size)
+      : Decompressor(max_size),
+        state_(BrotliDecoderCreateInstance(nullptr, nullptr, nullptr)) {
+    if (!state_) {
+      throw DecompressionError("Failed to create brotli decompressor");
+    }
+  }
+
+ private:
+  struct Deleter {
+    void operator()(BrotliDecoderState* state) const noexcept {
+      BrotliDecoderDestroyInstance(state);
+    }
+  };
+
+  std::size_t DoDecompress(std::string_view& input, char* out,
+                           std::size_t out_size) override {
+    auto* next_in = reinterpret_cast<const std::uint8_t*>(input.data());
+    std::size_t avail_in = input.size();
+    auto* next_out = reinterpret_cast<std::uint8_t*>(out);
+    std::size_t avail_out = out_size;
+
+    const auto result = BrotliDecoderDecompressStream(
+        state_.get(), &avail_in, &next_in, &avail_out, &next_out, nullptr);
+    if (result == BROTLI_DECODER_RESULT_ERROR) {
+      throw DecompressionError(fmt::format(
+          "Failed to decompress brotli: {}",
+          BrotliDecoderErrorString(BrotliDecoderGetErrorCode(state_.get()))));
+    }
+
+    input.remove_prefix(input.size() - avail_in);
+    return out_size - avail_out;
+  }
+
+  bool IsFinished() const override {
+    return BrotliDecoderIsFinished(state_.get());
+  }
+
+  std::unique_ptr<BrotliDecoderState, Deleter> state_;
+};
+
+#ifndef USERVER_NO_ZSTD
+class ZstdDecompressor final : public Decompressor {
+ public:
+  explicit ZstdDecompressor(std::size_t max_size)
+      : Decompressor(max_size), context_(ZSTD_createDCtx()) {
+    if (!context_) {
+      throw DecompressionError("Failed to create zstd decompressor");
+    }
+  }
+
+ private:
+  struct Deleter {
+    void operator()(ZSTD_DCtx* context) const noexcept {
+      ZSTD_freeDCtx(context);
+    }
+  };
+
+  std::size_t DoDecompress(std::string_view& input, char* out,
+                           std::size_t out_size) override {
+    ZSTD_inBuffer in{input.data(), input.size(), 0};
+    ZSTD_outBuffer out_buffer{out, out_size, 0};
+
+    const auto result = ZSTD_decompressStream(context_.get(), &out_buffer, &in);
+    if (ZSTD_isError(result)) {
+      throw DecompressionError(fmt::format("Failed to decompress zstd: {}",
+                                           ZSTD_getErrorName(result)));
+    }
+    // 0 means the frame is completely decoded and flushed
+    is_finished_ = result == 0;
+
+    input.remove_prefix(in.pos);
+    return out_buffer.pos;
+  }
+
+  bool IsFinished() const override { return is_finished_; }
+
+  // Concatenated frames, RFC 8878. The context starts the next frame by
+  // itself once the previous one is flushed.
+  void StartNextStream() override { is_finished_ = false; }
+
+  std::unique_ptr<ZSTD_DCtx, Deleter> context_;
+  bool is_finished_{false};
+};
+#endif
+
+}  // namespace
+
+Decompressor::~Decompressor() = default;
+
+void Decompressor::StartNextStream() {
+  throw DecompressionError("Unexpected data after the compressed stream");
+}
+
+std::unique_ptr<Decompressor> Decompressor::Create(Encoding encoding,
+                                                   std::size_t max_size) {
+  switch (encoding) {
+    case Encoding::kGzip:
+      return std::make_unique<GzipDecompressor>(max_size);
+    case Encoding::kBrotli:
+      return std::make_unique<BrotliDecompressor>(max_size);
+    case Encoding::kZstd:
+#ifndef USERVER_NO_ZSTD
+      return std::make_unique<ZstdDecompressor>(max_size);
+#else
+      break;
+#endif
+    case Encoding::kIdentity:
+      break;
+  }
+  throw std::runtime_error(fmt::format(
+      "Decompression of '{}' is not supported", ToString(encoding)));
+}
+
+void Decompressor::Decompress(std::string_view input, std::string& output) {
+  while (true) {
+    // The limit applies to all the members together
+    if (IsFinished() && !input.empty()) StartNextStream();
+
+    // One byte over the limit is enough to tell that it is exceeded
+    const auto allowed = max_size_ - total_size_;
+    const auto chunk_size =
+        allowed < kOutputChunkSize ? allowed + 1 : kOutputChunkSize;
+    const auto input_size = input.size();
+    const auto old_size = output.size();
+    output.resize(old_size + chunk_size);
+    const auto written =
+        DoDecompress(input, output.data() + old_size, chunk_size);
+    output.resize(old_size + written);
+
+    total_size_ += written;
+    if (total_size_ > max_size_) throw TooBigError();
+
+    if (IsFinished()) {
+      if (input.empty()) return;
+      continue;
+    }
+    // The output is not full, so everything available is decompressed
+    if (written < chunk_size && input.empty()) return;
+    if (written == 0 && input.size() == input_size) {
+      throw DecompressionError("Decompression makes no progress");
+    }
+  }
+}
+
+void Decompressor::Finish() {
+  if (!IsFinished()) throw DecompressionError("Compressed data is truncated");
+}
+
+std::string Decompress(Encoding encoding, std::string_view compressed,
+                       std::size_t max_size) {
+  auto decompressor = Decompressor::Create(encoding, max_size);
+  std::string result;
+  decompressor->Decompress(compressed, result);
+  decompressor->Finish();
+  return result;
+}
+
+}  // namespace compression
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <compression/encoding.hpp>
+#include <compression/error.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression {
+
+/// @brief Streaming decompressor with a limit on the decompressed size.
+///
+/// Stops as soon as the limit is exceeded, so a small malicious input never
+/// expands in memory beyond `max_size` plus a chunk. Not thread-safe.
+class Decompressor {
+ public:
+  virtual ~Decompressor();
+
+  /// @throws std::runtime_error for kIdentity and unsupported codings
+  static std::unique_ptr<Decompressor> Create(Encoding encoding,
+                                              std::size_t max_size);
+
+  /// @brief Decompresses the next part of the stream, appends to the output.
+  /// @throws TooBigError if the total output exceeds the limit
+  /// @throws DecompressionError on malformed input
+  void Decompress(std::string_view input, std::string& output);
+
+  /// @brief Checks that the stream is complete.
+  /// @throws DecompressionError on truncated input
+  void Finish();
+
+ protected:
+  explicit Decompressor(std::size_t max_size) : max_size_(max_size) {}
+
+  /// Returns the number of bytes written to `out`
+  virtual std::size_t DoDecompress(std::string_view& input, char* out,
+                                   std::size_t out_size) = 0;
+
+  virtual bool IsFinished() const = 0;
+
+  /// Prepares for the next member of a concatenated stream, called once the
+  /// current one is finished and there is more input
+  /// @throws DecompressionError if the coding does not allow concatenation
+  virtual void StartNextStream();
+
+ private:
+  const std::size_t max_size_;
+  std::size_t total_size_{0};
+};
+
+/// Decompresses the whole string in one go
+/// @throws DecompressionError
+std::string Decompress(Encoding encoding, std::string_view compressed,
+                       std::size_t max_size);
+
+}  // namespace compression
+
+USERVER_NAMESPACE_END
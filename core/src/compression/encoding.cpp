@@ -0,0 +1,131 @@
+#include <compression/encoding.hpp>
+
+#include <cstdlib>
+#include <string>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/str_icase.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression {
+namespace {
+
+constexpr double kNotListed = -1.0;
+
+const utils::StrIcaseEqual IsEqual{};
+
+std::string_view Trim(std::string_view str) {
+  const auto begin = str.find_first_not_of(" \t");
+  if (begin == std::string_view::npos) return {};
+  const auto end = str.find_last_not_of(" \t");
+  return str.substr(begin, end - begin + 1);
+}
+
+// Malformed qvalues are treated as 1, the same way most servers do
+double ParseQValue(std::string_view params) {
+  while (!params.empty()) {
+    const auto pos = params.find(';');
+    auto param = Trim(params.substr(0, pos));
+    params = pos == std::string_view::npos ? std::string_view{}
+                                           : params.substr(pos + 1);
+    if (param.size() < 2 || (param[0] != 'q' && param[0] != 'Q') ||
+        param[1] != '=') {
+      continue;
+    }
+
+    const std::string value{Trim(param.substr(2))};
+    char* end = nullptr;
+    const double q = std::strtod(value.c_str(), &end);
+    if (value.empty() || end != value.c_str() + value.size() || q < 0 ||
+        q > 1) {
+      return 1.0;
+    }
+    return q;
+  }
+  return 1.0;
+}
+
+}  // namespace
+
+std::string_view ToString(Encoding encoding) {
+  switch (encoding) {
+    case Encoding::kIdentity:
+      return "identity";
+    case Encoding::kGzip:
+      return "gzip";
+    case Encoding::kBrotli:
+      return "br";
+    case Encoding::kZstd:
+      return "zstd";
+  }
+  UINVARIANT(false, "Unexpected compression encoding");
+}
+
+std::optional<Encoding> ParseEncoding(std::string_view token) {
+  token = Trim(token);
+  if (IsEqual(token, "identity")) return Encoding::kIdentity;
+  if (IsEqual(token, "gzip") || IsEqual(token, "x-gzip")) {
+    return Encoding::kGzip;
+  }
+  if (IsEqual(token, "br")) return Encoding::kBrotli;
+  if (IsEqual(token, "zstd")) return Encoding::kZstd;
+  return std::nullopt;
+}
+
+const std::vector<Encoding>& GetSupportedEncodings() {
+  static const std::vector<Encoding> kSupported{
+#ifndef USERVER_NO_ZSTD
+      Encoding::kZstd,
+#endif
+      Encoding::kBrotli,
+      Encoding::kGzip,
+  };
+  return kSupported;
+}
+
+Encoding NegotiateEncoding(std::string_view accept_encoding,
+                           const std::vector<Encoding>& supported) {
+  std::vector<double> qvalues(supported.size(), kNotListed);
+  double any_qvalue = kNotListed;
+
+  while (!accept_encoding.empty()) {
+    const auto pos = accept_encoding.find(',');
+    const auto item = accept_encoding.substr(0, pos);
+    accept_encoding = pos == std::string_view::npos
+                          ? std::string_view{}
+                          : accept_encoding.substr(pos + 1);
+
+    const auto params_pos = item.find(';');
+    const auto coding = Trim(item.substr(0, params_pos));
+    if (coding.empty()) continue;
+    const double q = params_pos == std::string_view::npos
+                         ? 1.0
+                         : ParseQValue(item.substr(params_pos + 1));
+
+    if (coding == "*") {
+      any_qvalue = q;
+      continue;
+    }
+    const auto encoding = ParseEncoding(coding);
+    if (!encoding) continue;
+    for (std::size_t i = 0; i < supported.size(); ++i) {
+      if (supported[i] == *encoding) qvalues[i] = q;
+    }
+  }
+
+  auto result = Encoding::kIdentity;
+  double best_qvalue = 0;
+  for (std::size_t i = 0; i < supported.size(); ++i) {
+    const double q = qvalues[i] == kNotListed ? any_qvalue : qvalues[i];
+    if (q > best_qvalue) {
+      best_qvalue = q;
+      result = supported[i];
+    }
+  }
+  return result;
+}
+
+}  // namespace compression
+
+USERVER_NAMESPACE_END
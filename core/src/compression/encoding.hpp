@@ -0,0 +1,38 @@
+#pragma once
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression {
+
+/// HTTP content codings
+enum class Encoding {
+  kIdentity,
+  kGzip,
+  kBrotli,
+  kZstd,
+};
+
+/// Content-Encoding token of the coding
+std::string_view ToString(Encoding encoding);
+
+/// Parses the Content-Encoding token, std::nullopt for unknown codings.
+/// Does not check that the coding is supported by this build.
+std::optional<Encoding> ParseEncoding(std::string_view token);
+
+/// Codings this build is able to compress and decompress, preferred first
+const std::vector<Encoding>& GetSupportedEncodings();
+
+/// @brief Chooses the response coding for the Accept-Encoding header value.
+///
+/// Follows the qvalues of RFC 7231 5.3.4, the order of `supported` breaks the
+/// ties. Returns kIdentity if no supported coding is acceptable.
+Encoding NegotiateEncoding(std::string_view accept_encoding,
+                           const std::vector<Encoding>& supported);
+
+}  // namespace compression
+
+USERVER_NAMESPACE_END
@@ -19,6 +19,8 @@ constexpr std::string_view kDumpFormatVersion = "format-version";
 constexpr std::string_view kMaxDumpCount = "max-count";
 constexpr std::string_view kWorldReadable = "world-readable";
 constexpr std::string_view kEncrypted = "encrypted";
+constexpr std::string_view kIoUring = "io-uring";
+constexpr std::string_view kDirectIo = "direct-io";
 
 constexpr auto kDefaultFsTaskProcessor = std::string_view{"fs-task-processor"};
 constexpr auto kDefaultMaxDumpCount = uint64_t{1};
@@ -67,6 +69,8 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config,
           config[kMaxDumpAge].As<std::optional<std::chrono::milliseconds>>()),
       max_dump_age_set(config.HasMember(kMaxDumpAge)),
       dump_is_encrypted(config[kEncrypted].As<bool>(false)),
+      use_io_uring(config[kIoUring].As<bool>(true)),
+      use_direct_io(config[kDirectIo].As<bool>(false)),
       dumps_enabled(config[kDumpsEnabled].As<bool>()),
       min_dump_interval(
           config[kMinDumpInterval].As<std::chrono::milliseconds>(0)) {
@@ -19,6 +19,13 @@ boost::filesystem::perms GetPerms(const Config& config) {
     return perms::owner_read;
 }
 
+FileIoOptions GetFileIoOptions(const Config& config) {
+  FileIoOptions options;
+  options.use_io_uring = config.use_io_uring;
+  options.use_direct_io = config.use_direct_io;
+  return options;
+}
+
 }  // namespace
 
 std::unique_ptr<dump::OperationsFactory> CreateOperationsFactory(
@@ -31,14 +38,16 @@ std::unique_ptr<dump::OperationsFactory> CreateOperationsFactory(
     return std::make_unique<dump::EncryptedOperationsFactory>(
         std::move(secret_key), dump_perms);
   } else {
-    return std::make_unique<dump::FileOperationsFactory>(dump_perms);
+    return std::make_unique<dump::FileOperationsFactory>(
+        dump_perms, GetFileIoOptions(config));
   }
 }
 
 std::unique_ptr<dump::OperationsFactory> CreateDefaultOperationsFactory(
     const Config& config) {
   auto dump_perms = GetPerms(config);
-  return std::make_unique<dump::FileOperationsFactory>(dump_perms);
+  return std::make_unique<dump::FileOperationsFactory>(
+      dump_perms, GetFileIoOptions(config));
 }
 
 }  // namespace dump
@@ -1,131 +1,352 @@
 #include <userver/dump/operations_file.hpp>
 
+#include <fcntl.h>
+
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <deque>
+#include <new>
+#include <optional>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 
+#include <fs/impl/async_file.hpp>
 #include <userver/fs/blocking/write.hpp>
+#include <userver/utils/cpu_relax.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
 namespace {
+
 constexpr std::size_t kCheckTimeAfterBytes{1 << 15};
+
+// Large enough for the disk to be busy while the next chunk is processed
+constexpr std::size_t kBufferSize{1 << 20};
+
+struct BufferDeleter {
+  void operator()(char* data) const noexcept {
+    ::operator delete(data, std::align_val_t{fs::impl::kDirectIoAlignment});
+  }
+};
+
+// Aligned for O_DIRECT
+using Buffer = std::unique_ptr<char, BufferDeleter>;
+
+Buffer MakeBuffer() {
+  return Buffer{static_cast<char*>(::operator new(
+      kBufferSize, std::align_val_t{fs::impl::kDirectIoAlignment}))};
 }
 
+fs::impl::AsyncFile OpenFile(const std::string& path, int flags,
+                             ::mode_t mode, FileIoOptions options) {
+#ifdef O_DIRECT
+  if (options.use_direct_io) flags |= O_DIRECT;
+#endif
+  auto* uring = options.use_io_uring ? fs::impl::GetUring() : nullptr;
+  return fs::impl::AsyncFile::Open(uring, path, flags, mode);
+}
+
+}  // namespace
+
+struct FileWriter::Impl {
+  Impl(std::string&& path, boost::filesystem::perms perms,
+       tracing::ScopeTime& scope)
+      : final_path(std::move(path)),
+        path(final_path + ".tmp"),
+        perms(perms),
+        cpu_relax(kCheckTimeAfterBytes, &scope),
+        buffers{MakeBuffer(), MakeBuffer()} {}
+
+  struct PendingWrite {
+    fs::impl::PendingIo io;
+    std::string_view data;
+    std::uint64_t offset;
+  };
+
+  std::string_view CurrentData() const {
+    return {buffers[current].get(), buffer_size};
+  }
+
+  void SubmitBuffer() {
+    const auto data = CurrentData();
+    pending.push_back(
+        {file->Write(data.data(), data.size(), offset), data, offset});
+    // The write of the current buffer stays in flight while the other buffer
+    // is filled
+    WaitPending(1);
+
+    offset += buffer_size;
+    buffer_size = 0;
+    current ^= 1;
+  }
+
+  // Waits for the oldest writes until at most `max_pending` are left
+  void WaitPending(std::size_t max_pending = 0) {
+    // Rests of the short writes, they are not aligned anymore
+    std::vector<std::pair<std::string_view, std::uint64_t>> rests;
+    while (pending.size() > max_pending) {
+      auto& write = pending.front();
+      const auto written = write.io.Wait();
+      if (written < write.data.size()) {
+        rests.emplace_back(write.data.substr(written), write.offset + written);
+        // O_DIRECT may be disabled only when no direct write is in flight
+        max_pending = 0;
+      }
+      pending.pop_front();
+    }
+
+    if (rests.empty()) return;
+    file->DisableDirectIo();
+    for (const auto& [data, data_offset] : rests) {
+      file->WriteFull(data, data_offset);
+    }
+  }
+
+  // Writes the buffered bytes together with `data` in a single vectored
+  // write, without copying `data` into the buffer
+  void WriteVectored(std::string_view data) {
+    WaitPending();
+    const auto buffered = CurrentData();
+    std::array<::iovec, 2> iov{
+        ::iovec{const_cast<char*>(buffered.data()), buffered.size()},
+        ::iovec{const_cast<char*>(data.data()), data.size()}};
+    const auto written = file->WriteV(iov.data(), iov.size(), offset).Wait();
+
+    if (written < buffered.size()) {
+      file->WriteFull(buffered.substr(written), offset + written);
+      file->WriteFull(data, offset + buffered.size());
+    } else if (written < buffered.size() + data.size()) {
+      file->WriteFull(data.substr(written - buffered.size()), offset + written);
+    }
+
+    offset += buffered.size() + data.size();
+    buffer_size = 0;
+  }
+
+  std::string final_path;
+  std::string path;
+  boost::filesystem::perms perms;
+  utils::StreamingCpuRelax cpu_relax;
+  std::optional<fs::impl::AsyncFile> file;
+  std::array<Buffer, 2> buffers;
+  std::size_t current{0};
+  std::size_t buffer_size{0};
+  // File offset of the current buffer
+  std::uint64_t offset{0};
+  // Writes of the buffers, destroyed first as they use the buffers
+  std::deque<PendingWrite> pending;
+};
+
 FileWriter::FileWriter(std::string path, boost::filesystem::perms perms,
-                       tracing::ScopeTime& scope)
-    : final_path_(std::move(path)),
-      path_(final_path_ + ".tmp"),
-      perms_(perms),
-      cpu_relax_(kCheckTimeAfterBytes, &scope) {
-  constexpr fs::blocking::OpenMode mode{
-      fs::blocking::OpenFlag::kWrite, fs::blocking::OpenFlag::kExclusiveCreate};
-  const auto tmp_perms = perms_ | boost::filesystem::perms::owner_write;
+                       tracing::ScopeTime& scope, FileIoOptions options)
+    : impl_(std::move(path), perms, scope) {
+  const auto tmp_perms = impl_->perms | boost::filesystem::perms::owner_write;
 
   try {
-    file_ = fs::blocking::CFile{path_, mode, tmp_perms};
+    impl_->file.emplace(OpenFile(impl_->path, O_WRONLY | O_CREAT | O_EXCL,
+                                 static_cast<::mode_t>(tmp_perms), options));
   } catch (const std::exception& ex) {
     throw Error(fmt::format("Failed to open the dump file for write \"{}\": {}",
-                            path_, ex.what()));
+                            impl_->path, ex.what()));
   }
 }
 
+FileWriter::~FileWriter() = default;
+
 void FileWriter::WriteRaw(std::string_view data) {
+  auto& impl = *impl_;
+  const auto size = data.size();
+
   try {
-    file_.Write(data);
+    if (data.size() >= kBufferSize && !impl.file->IsDirectIo()) {
+      impl.WriteVectored(data);
+      data = {};
+    }
+
+    while (!data.empty()) {
+      const auto chunk = std::min(kBufferSize - impl.buffer_size, data.size());
+      std::memcpy(impl.buffers[impl.current].get() + impl.buffer_size,
+                  data.data(), chunk);
+      impl.buffer_size += chunk;
+      data.remove_prefix(chunk);
+      if (impl.buffer_size == kBufferSize) impl.SubmitBuffer();
+    }
   } catch (const std::exception& ex) {
     throw Error(fmt::format("Failed to write to the dump file \"{}\": {}",
-                            path_, ex.what()));
+                            impl.path, ex.what()));
   }
-  cpu_relax_.Relax(data.size());
+  impl.cpu_relax.Relax(size);
 }
 
 void FileWriter::Finish() {
+  auto& impl = *impl_;
   try {
-    file_.Flush();
-    std::move(file_).Close();
-    fs::blocking::Chmod(path_, perms_);  // drop perms::owner_write
-    fs::blocking::Rename(path_, final_path_);
+    if (impl.buffer_size != 0) {
+      if (impl.buffer_size % fs::impl::kDirectIoAlignment != 0) {
+        impl.WaitPending();
+        impl.file->DisableDirectIo();
+      }
+      impl.SubmitBuffer();
+    }
+    impl.WaitPending();
+    impl.file->FSync();
+    std::move(*impl.file).Close();
+    impl.file.reset();
+
+    fs::blocking::Chmod(impl.path, impl.perms);  // drop perms::owner_write
+    fs::blocking::Rename(impl.path, impl.final_path);
     fs::blocking::SyncDirectoryContents(
-        boost::filesystem::path(final_path_).parent_path().string());
+        boost::filesystem::path(impl.final_path).parent_path().string());
   } catch (const std::exception& ex) {
-    throw Error(fmt::format("Failed to finalize dump \"{}\". Reason: {}", path_,
-                            ex.what()));
+    throw Error(fmt::format("Failed to finalize dump \"{}\". Reason: {}",
+                            impl.path, ex.what()));
   }
 }
 
-FileReader::FileReader(std::string path) : path_(std::move(path)) {
+struct FileReader::Impl {
+  explicit Impl(std::string&& path)
+      : path(std::move(path)), buffers{MakeBuffer(), MakeBuffer()} {}
+
+  const char* CurrentData() const { return buffers[current].get(); }
+
+  void StartRead() {
+    prefetch.emplace(
+        file->Read(buffers[current ^ 1].get(), kBufferSize, next_offset));
+  }
+
+  // @returns false on end-of-file
+  bool Refill() {
+    if (is_eof) return false;
+    if (!prefetch) StartRead();
+
+    auto* const data = buffers[current ^ 1].get();
+    auto bytes = prefetch->Wait();
+    prefetch.reset();
+    const bool may_read_more =
+        bytes != 0 && !(file->IsDirectIo() &&
+                        bytes % fs::impl::kDirectIoAlignment != 0);
+    if (bytes < kBufferSize && may_read_more) {
+      bytes += file->ReadFull(data + bytes, kBufferSize - bytes,
+                              next_offset + bytes);
+    }
+
+    current ^= 1;
+    buffer_offset = next_offset;
+    begin = 0;
+    end = bytes;
+    next_offset += bytes;
+    is_eof = bytes < kBufferSize;
+
+    // Read ahead while the caller is busy with the current buffer
+    if (!is_eof) StartRead();
+    return end != 0;
+  }
+
+  std::string path;
+  std::optional<fs::impl::AsyncFile> file;
+  std::array<Buffer, 2> buffers;
+  std::size_t current{0};
+  // Unread bytes of the current buffer
+  std::size_t begin{0};
+  std::size_t end{0};
+  // File offset of the current buffer
+  std::uint64_t buffer_offset{0};
+  // File offset of the next read
+  std::uint64_t next_offset{0};
+  bool is_eof{false};
+  // Storage for the data that spans multiple buffers
+  std::string chunk;
+  // The read into the other buffer, destroyed first as it uses the buffers
+  std::optional<fs::impl::PendingIo> prefetch;
+};
+
+FileReader::FileReader(std::string path, FileIoOptions options)
+    : impl_(std::move(path)) {
   try {
-    file_ = fs::blocking::CFile(path_, fs::blocking::OpenFlag::kRead);
+    impl_->file.emplace(OpenFile(impl_->path, O_RDONLY, 0, options));
+    impl_->StartRead();
   } catch (const std::exception& ex) {
     throw Error(fmt::format(
-        "Failed to open the dump file for reading \"{}\". Reason: {}", path_,
-        ex.what()));
+        "Failed to open the dump file for reading \"{}\". Reason: {}",
+        impl_->path, ex.what()));
   }
 }
 
+FileReader::~FileReader() = default;
+
 std::string_view FileReader::ReadRaw(std::size_t max_size) {
-  // the storage of curr_chunk_ is reused between ReadRaw calls. It acts
-  // as a buffer, with its size being the capacity of the buffer.
-  if (curr_chunk_.size() < max_size) {
-    curr_chunk_.resize(
-        std::max(max_size, static_cast<std::size_t>(curr_chunk_.size() * 1.5)));
+  auto& impl = *impl_;
+  if (impl.end - impl.begin >= max_size) {
+    const std::string_view result{impl.CurrentData() + impl.begin, max_size};
+    impl.begin += max_size;
+    return result;
   }
 
-  std::size_t bytes_read = 0;
   try {
-    bytes_read = file_.Read(curr_chunk_.data(), max_size);
+    impl.chunk.assign(impl.CurrentData() + impl.begin, impl.end - impl.begin);
+    impl.begin = impl.end;
+    while (impl.chunk.size() < max_size && impl.Refill()) {
+      const auto size =
+          std::min(max_size - impl.chunk.size(), impl.end - impl.begin);
+      impl.chunk.append(impl.CurrentData() + impl.begin, size);
+      impl.begin += size;
+    }
   } catch (const std::exception& ex) {
     throw Error(fmt::format("Failed to read from the dump file \"{}\": {}",
-                            path_, ex.what()));
+                            impl.path, ex.what()));
   }
 
-  return {curr_chunk_.data(), bytes_read};
+  return impl.chunk;
 }
 
 void FileReader::Finish() {
-  std::size_t bytes_read = 0;
+  auto& impl = *impl_;
+  bool has_extra_data = false;
 
   try {
-    char extra_byte = 0;
-    bytes_read = file_.Read(&extra_byte, 1);
+    has_extra_data = impl.begin != impl.end || impl.Refill();
   } catch (const std::exception& ex) {
     throw Error(fmt::format("Failed to read from the dump file \"{}\": {}",
-                            path_, ex.what()));
+                            impl.path, ex.what()));
   }
 
-  if (bytes_read != 0) {
-    const auto file_size = file_.GetSize();
-    const auto position = file_.GetPosition() - bytes_read;
+  if (has_extra_data) {
+    const auto file_size = impl.file->GetSize();
+    const auto position = impl.buffer_offset + impl.begin;
     throw Error(
         fmt::format("Unexpected extra data at the end of the dump file \"{}\": "
                     "file-size={}, position={}, unread-size={}",
-                    path_, file_size, position, file_size - position));
+                    impl.path, file_size, position, file_size - position));
   }
 
   try {
-    std::move(file_).Close();
+    std::move(*impl.file).Close();
+    impl.file.reset();
   } catch (const std::exception& ex) {
     throw Error(fmt::format("Failed to finalize dump file \"{}\". Reason: {}",
-                            path_, ex.what()));
+                            impl.path, ex.what()));
   }
 }
 
-FileOperationsFactory::FileOperationsFactory(boost::filesystem::perms perms)
-    : perms_(perms) {}
+FileOperationsFactory::FileOperationsFactory(boost::filesystem::perms perms,
+                                             FileIoOptions options)
+    : perms_(perms), options_(options) {}
 
 std::unique_ptr<Reader> FileOperationsFactory::CreateReader(
     std::string full_path) {
-  return std::make_unique<FileReader>(std::move(full_path));
+  return std::make_unique<FileReader>(std::move(full_path), options_);
 }
 
 std::unique_ptr<Writer> FileOperationsFactory::CreateWriter(
     std::string full_path, tracing::ScopeTime& scope) {
-  return std::make_unique<FileWriter>(std::move(full_path), perms_, scope);
+  return std::make_unique<FileWriter>(std::move(full_path), perms_, scope,
+                                      options_);
 }
 
 }  // namespace dump
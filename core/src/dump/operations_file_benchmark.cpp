@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/dump/operations_file.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/tracing/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kDumpSize = 256 * 1024 * 1024;
+
+// state.range(0) is the size of a single write, state.range(1) is whether
+// io_uring is used and state.range(2) is whether O_DIRECT is used
+dump::FileIoOptions GetOptions(const benchmark::State& state) {
+  dump::FileIoOptions options;
+  options.use_io_uring = state.range(1);
+  options.use_direct_io = state.range(2);
+  return options;
+}
+
+void WriteDump(const std::string& path, std::size_t write_size,
+               dump::FileIoOptions options) {
+  const std::string data(write_size, 'a');
+  tracing::Span span{"dump_benchmark"};
+  auto scope_time = span.CreateScopeTime("write");
+
+  dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                          scope_time, options);
+  for (std::size_t written = 0; written < kDumpSize; written += write_size) {
+    WriteStringViewUnsafe(writer, data);
+  }
+  writer.Finish();
+}
+
+void ApplyArguments(benchmark::internal::Benchmark* bench) {
+  for (const auto write_size : {16, 4096, 4 * 1024 * 1024}) {
+    for (const auto use_io_uring : {false, true}) {
+      for (const auto use_direct_io : {false, true}) {
+        bench->Args({write_size, use_io_uring, use_direct_io});
+      }
+    }
+  }
+  bench->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+}  // namespace
+
+void dump_file_write(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto write_size = static_cast<std::size_t>(state.range(0));
+
+    std::size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+      WriteDump(dir.GetPath() + "/dump" + std::to_string(i++), write_size,
+                GetOptions(state));
+    }
+    state.SetBytesProcessed(state.iterations() * kDumpSize);
+  });
+}
+BENCHMARK(dump_file_write)->Apply(ApplyArguments);
+
+void dump_file_read(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dir.GetPath() + "/dump";
+    const auto read_size = static_cast<std::size_t>(state.range(0));
+    WriteDump(path, read_size, GetOptions(state));
+
+    for ([[maybe_unused]] auto _ : state) {
+      dump::FileReader reader(path, GetOptions(state));
+      for (std::size_t read = 0; read < kDumpSize; read += read_size) {
+        benchmark::DoNotOptimize(ReadStringViewUnsafe(reader, read_size));
+      }
+      reader.Finish();
+    }
+    state.SetBytesProcessed(state.iterations() * kDumpSize);
+  });
+}
+BENCHMARK(dump_file_read)->Apply(ApplyArguments);
+
+USERVER_NAMESPACE_END
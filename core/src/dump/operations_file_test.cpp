@@ -1,5 +1,6 @@
 #include <userver/dump/operations_file.hpp>
 
+#include <fmt/format.h>
 #include <boost/regex.hpp>
 
 #include <userver/dump/unsafe.hpp>
@@ -18,8 +19,31 @@ std::string DumpFilePath(const fs::blocking::TempDirectory& dir) {
   return dir.GetPath() + "/dump";
 }
 
+class DumpOperationsFileIo
+    : public ::testing::TestWithParam<dump::FileIoOptions> {};
+
+std::string PrintFileIoOptions(
+    const ::testing::TestParamInfo<dump::FileIoOptions>& info) {
+  return fmt::format("{}_{}", info.param.use_io_uring ? "IoUring" : "Blocking",
+                     info.param.use_direct_io ? "DirectIo" : "BufferedIo");
+}
+
+dump::FileIoOptions MakeFileIoOptions(bool use_io_uring, bool use_direct_io) {
+  dump::FileIoOptions options;
+  options.use_io_uring = use_io_uring;
+  options.use_direct_io = use_direct_io;
+  return options;
+}
+
 }  // namespace
 
+INSTANTIATE_UTEST_SUITE_P(/*no prefix*/, DumpOperationsFileIo,
+                          ::testing::Values(MakeFileIoOptions(true, false),
+                                            MakeFileIoOptions(false, false),
+                                            MakeFileIoOptions(true, true),
+                                            MakeFileIoOptions(false, true)),
+                          PrintFileIoOptions);
+
 UTEST(DumpOperationsFile, WriteReadRaw) {
   const auto dir = fs::blocking::TempDirectory::Create();
   const auto path = DumpFilePath(dir);
@@ -113,4 +137,48 @@ TEST(DumpOperationsFile, Underread) {
   FAIL();
 }
 
+UTEST_P(DumpOperationsFileIo, LargeWriteRead) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  // Both the small writes that are buffered and the large ones that are not,
+  // with the total size not aligned to the buffers
+  std::string expected;
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                          scope_time, GetParam());
+  for (std::size_t i = 0; i < 3000; ++i) {
+    const auto size = i % 500 == 0 ? (3 << 20) + i : i * 7 % 5000;
+    const auto data = std::string(size, static_cast<char>('a' + i % 26));
+    WriteStringViewUnsafe(writer, data);
+    expected += data;
+  }
+  writer.Finish();
+
+  EXPECT_EQ(fs::blocking::ReadFileContents(path), expected);
+
+  dump::FileReader reader(path, GetParam());
+  const std::string_view expected_view = expected;
+  for (std::size_t pos = 0, i = 0; pos < expected.size(); ++i) {
+    const auto size =
+        std::min(i * 131 % (3 << 20) + 1, expected.size() - pos);
+    ASSERT_EQ(ReadStringViewUnsafe(reader, size),
+              expected_view.substr(pos, size));
+    pos += size;
+  }
+  reader.Finish();
+}
+
+UTEST_P(DumpOperationsFileIo, Underread) {
+  const auto file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(file.GetPath(),
+                                    std::string((1 << 20) + 10, 'a'));
+
+  dump::FileReader reader(file.GetPath(), GetParam());
+  EXPECT_EQ(ReadStringViewUnsafe(reader, (1 << 20) + 9),
+            std::string((1 << 20) + 9, 'a'));
+  UEXPECT_THROW_MSG(reader.Finish(), dump::Error,
+                    "file-size=1048586, position=1048585, unread-size=1");
+}
+
 USERVER_NAMESPACE_END
@@ -2,7 +2,10 @@
 
 #include <algorithm>  // for std::max
 #include <atomic>
+#include <cstdint>
+#include <optional>
 #include <utility>
+#include <vector>
 
 #include <moodycamel/concurrentqueue.h>
 #include <uboost_coro/coroutine2/coroutine.hpp>
@@ -10,6 +13,8 @@
 
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <utils/numa.hpp>
 
 #include "pool_config.hpp"
 #include "pool_stats.hpp"
@@ -35,17 +40,30 @@ class Pool final {
   std::size_t GetStackSize() const;
 
  private:
+  // Idle coroutines of a NUMA node, coroutines are returned to the queue
+  // they were created for to keep the touched stack pages node-local
+  struct NodeQueue {
+    explicit NodeQueue(std::size_t capacity);
+
+    static std::uint64_t NextId() noexcept;
+
+    template <typename Token>
+    Token& GetToken();
+
+    const std::uint64_t id;
+    moodycamel::ConcurrentQueue<Coroutine> coroutines;
+  };
+
   Coroutine CreateCoroutine(bool quiet = false);
   void OnCoroutineDestruction() noexcept;
 
-  template <typename Token>
-  Token& GetToken();
+  std::size_t GetCurrentNodeQueueIndex() const noexcept;
 
   const PoolConfig config_;
   const Executor executor_;
 
   boost::coroutines2::protected_fixedsize_stack stack_allocator_;
-  moodycamel::ConcurrentQueue<Coroutine> coroutines_;
+  utils::FixedArray<NodeQueue> node_queues_;
   std::atomic<std::size_t> idle_coroutines_num_;
   std::atomic<std::size_t> total_coroutines_num_;
 };
@@ -53,8 +71,11 @@ class Pool final {
 template <typename Task>
 class Pool<Task>::CoroutinePtr final {
  public:
-  CoroutinePtr(Coroutine&& coro, Pool<Task>& pool) noexcept
-      : coro_(std::move(coro)), pool_(&pool) {}
+  CoroutinePtr(Coroutine&& coro, Pool<Task>& pool,
+               std::size_t node_queue_index = 0) noexcept
+      : coro_(std::move(coro)),
+        pool_(&pool),
+        node_queue_index_(node_queue_index) {}
 
   CoroutinePtr(CoroutinePtr&&) noexcept = default;
   CoroutinePtr& operator=(CoroutinePtr&&) noexcept = default;
@@ -74,23 +95,57 @@ class Pool<Task>::CoroutinePtr final {
     pool_->PutCoroutine(std::move(*this));
   }
 
+  std::size_t GetNodeQueueIndex() const noexcept { return node_queue_index_; }
+
  private:
   Coroutine coro_;
   Pool<Task>* pool_;
+  std::size_t node_queue_index_;
 };
 
+template <typename Task>
+Pool<Task>::NodeQueue::NodeQueue(std::size_t capacity)
+    : id(NextId()), coroutines(capacity) {}
+
+template <typename Task>
+std::uint64_t Pool<Task>::NodeQueue::NextId() noexcept {
+  static std::atomic<std::uint64_t> next_id{0};
+  return next_id++;
+}
+
+template <typename Task>
+template <typename Token>
+Token& Pool<Task>::NodeQueue::GetToken() {
+  // A thread may work with several queues, tokens are bound to a queue. Ids
+  // are never reused, so a token of a destroyed queue is never picked.
+  thread_local std::vector<std::pair<std::uint64_t, Token>> tokens;
+  for (auto& [queue_id, token] : tokens) {
+    if (queue_id == id) return token;
+  }
+  return tokens.emplace_back(id, Token(coroutines)).second;
+}
+
 template <typename Task>
 Pool<Task>::Pool(PoolConfig config, Executor executor)
     : config_(std::move(config)),
       executor_(executor),
       stack_allocator_(config.stack_size),
-      coroutines_(config_.max_size),
+      node_queues_(config_.per_numa_node ? utils::numa::GetNodeCount() : 1,
+                   config_.max_size),
       idle_coroutines_num_(config_.initial_size),
       total_coroutines_num_(0) {
-  moodycamel::ProducerToken token(coroutines_);
-  for (std::size_t i = 0; i < config_.initial_size; ++i) {
-    bool ok = coroutines_.enqueue(token, CreateCoroutine(/*quiet =*/true));
-    UINVARIANT(ok, "Failed to allocate the initial coro pool");
+  for (std::size_t node = 0; node < node_queues_.size(); ++node) {
+    auto& queue = node_queues_[node].coroutines;
+    // The initial coroutines are split between the nodes
+    const auto node_initial_size =
+        config_.initial_size / node_queues_.size() +
+        (node < config_.initial_size % node_queues_.size() ? 1 : 0);
+
+    moodycamel::ProducerToken token(queue);
+    for (std::size_t i = 0; i < node_initial_size; ++i) {
+      bool ok = queue.enqueue(token, CreateCoroutine(/*quiet =*/true));
+      UINVARIANT(ok, "Failed to allocate the initial coro pool");
+    }
   }
 }
 
@@ -110,28 +165,36 @@ typename Pool<Task>::CoroutinePtr Pool<Task>::GetCoroutine() {
 
   std::optional<Coroutine> coroutine;
   CoroutineMover mover{coroutine};
-  auto& token = GetToken<moodycamel::ConsumerToken>();
-  if (coroutines_.try_dequeue(token, mover)) {
+  const auto node_queue_index = GetCurrentNodeQueueIndex();
+  auto& queue = node_queues_[node_queue_index];
+  auto& token = queue.template GetToken<moodycamel::ConsumerToken>();
+  if (queue.coroutines.try_dequeue(token, mover)) {
     --idle_coroutines_num_;
   } else {
     coroutine.emplace(CreateCoroutine());
   }
-  return CoroutinePtr(std::move(*coroutine), *this);
+  return CoroutinePtr(std::move(*coroutine), *this, node_queue_index);
 }
 
 template <typename Task>
 void Pool<Task>::PutCoroutine(CoroutinePtr&& coroutine_ptr) {
   if (idle_coroutines_num_.load() >= config_.max_size) return;
-  auto& token = GetToken<moodycamel::ProducerToken>();
-  const bool ok = coroutines_.enqueue(token, std::move(coroutine_ptr.Get()));
+  auto& queue = node_queues_[coroutine_ptr.GetNodeQueueIndex()];
+  auto& token = queue.template GetToken<moodycamel::ProducerToken>();
+  const bool ok =
+      queue.coroutines.enqueue(token, std::move(coroutine_ptr.Get()));
   if (ok) ++idle_coroutines_num_;
 }
 
 template <typename Task>
 PoolStats Pool<Task>::GetStats() const {
+  std::size_t idle_coroutines = 0;
+  for (const auto& queue : node_queues_) {
+    idle_coroutines += queue.coroutines.size_approx();
+  }
+
   PoolStats stats;
-  stats.active_coroutines =
-      total_coroutines_num_.load() - coroutines_.size_approx();
+  stats.active_coroutines = total_coroutines_num_.load() - idle_coroutines;
   stats.total_coroutines =
       std::max(total_coroutines_num_.load(), stats.active_coroutines);
   return stats;
@@ -159,10 +222,14 @@ std::size_t Pool<Task>::GetStackSize() const {
 }
 
 template <typename Task>
-template <typename Token>
-Token& Pool<Task>::GetToken() {
-  thread_local Token token(coroutines_);
-  return token;
+std::size_t Pool<Task>::GetCurrentNodeQueueIndex() const noexcept {
+  if (node_queues_.size() == 1) return 0;
+  const auto node = utils::numa::GetCurrentNode();
+  if (node == utils::numa::kUnknownNode ||
+      static_cast<std::size_t>(node) >= node_queues_.size()) {
+    return 0;
+  }
+  return node;
 }
 
 }  // namespace engine::coro
@@ -13,6 +13,8 @@ struct PoolConfig {
   size_t initial_size = 1000;
   size_t max_size = 10000;
   size_t stack_size = 256 * 1024ULL;
+  /// Keep the idle coroutines of each NUMA node separately
+  bool per_numa_node = false;
 };
 
 PoolConfig Parse(const yaml_config::YamlConfig& value,
@@ -11,6 +11,7 @@
 #include <userver/utils/thread_name.hpp>
 #include <utils/check_syscall.hpp>
 #include <utils/impl/assert_extra.hpp>
+#include <utils/numa.hpp>
 
 #include "child_process_map.hpp"
 
@@ -56,15 +57,15 @@ void ReleaseEvDefaultLoop() {
 }  // namespace
 
 Thread::Thread(const std::string& thread_name,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, false, register_event_mode) {}
+               RegisterEventMode register_event_mode, std::vector<int> cpus)
+    : Thread(thread_name, false, register_event_mode, std::move(cpus)) {}
 
 Thread::Thread(const std::string& thread_name, UseDefaultEvLoop,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, true, register_event_mode) {}
+               RegisterEventMode register_event_mode, std::vector<int> cpus)
+    : Thread(thread_name, true, register_event_mode, std::move(cpus)) {}
 
 Thread::Thread(const std::string& thread_name, bool use_ev_default_loop,
-               RegisterEventMode register_event_mode)
+               RegisterEventMode register_event_mode, std::vector<int> cpus)
     : use_ev_default_loop_(use_ev_default_loop),
       register_event_mode_(register_event_mode),
       func_queue_(kInitFuncQueueCapacity),
@@ -72,7 +73,7 @@ Thread::Thread(const std::string& thread_name, bool use_ev_default_loop,
       lock_(loop_mutex_, std::defer_lock),
       is_running_(false) {
   if (use_ev_default_loop_) AcquireEvDefaultLoop(thread_name);
-  Start(thread_name);
+  Start(thread_name, std::move(cpus));
 }
 
 Thread::~Thread() {
@@ -128,7 +129,7 @@ bool Thread::IsInEvThread() const {
   return (std::this_thread::get_id() == thread_.get_id());
 }
 
-void Thread::Start(const std::string& name) {
+void Thread::Start(const std::string& name, std::vector<int> cpus) {
   loop_ = use_ev_default_loop_ ? ev_default_loop(EVFLAG_AUTO)
                                : ev_loop_new(EVFLAG_AUTO);
   UASSERT(loop_);
@@ -164,8 +165,13 @@ void Thread::Start(const std::string& name) {
   }
 
   is_running_ = true;
-  thread_ = std::thread([this, name] {
+  thread_ = std::thread([this, name, cpus = std::move(cpus)] {
     utils::SetCurrentThreadName(name);
+    try {
+      utils::numa::SetCurrentThreadAffinity(cpus);
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Failed to pin ev thread " << name << ": " << ex;
+    }
     RunEvLoop();
   });
 }
@@ -5,6 +5,7 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <ev.h>
 #include <boost/lockfree/queue.hpp>
@@ -33,8 +34,11 @@ class Thread final {
     kDeferred
   };
 
-  Thread(const std::string& thread_name, RegisterEventMode);
-  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode);
+  /// @param cpus CPUs to pin the thread to, the thread is not pinned if empty
+  Thread(const std::string& thread_name, RegisterEventMode,
+         std::vector<int> cpus = {});
+  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode,
+         std::vector<int> cpus = {});
   ~Thread();
 
   struct ev_loop* GetEvLoop() const {
@@ -55,11 +59,11 @@ class Thread final {
 
  private:
   Thread(const std::string& thread_name, bool use_ev_default_loop,
-         RegisterEventMode register_event_mode);
+         RegisterEventMode register_event_mode, std::vector<int> cpus);
 
   void RegisterInEvLoop(OnAsyncPayload* func, AsyncPayloadPtr&& data);
 
-  void Start(const std::string& name);
+  void Start(const std::string& name, std::vector<int> cpus);
 
   void StopEventLoop();
   void RunEvLoop();
@@ -3,6 +3,7 @@
 #include <fmt/format.h>
 
 #include <userver/utils/assert.hpp>
+#include <utils/numa.hpp>
 
 #include "thread.hpp"
 #include "thread_control.hpp"
@@ -13,6 +14,8 @@ namespace engine::ev {
 
 namespace {
 
+thread_local ThreadControl* scoped_thread = nullptr;
+
 Thread::RegisterEventMode GetRegisterEventMode(bool defer_timers) {
   return defer_timers ? Thread::RegisterEventMode::kDeferred
                       : Thread::RegisterEventMode::kImmediate;
@@ -20,6 +23,15 @@ Thread::RegisterEventMode GetRegisterEventMode(bool defer_timers) {
 
 }  // namespace
 
+EventThreadScope::EventThreadScope(ThreadControl& thread) noexcept
+    : previous_(scoped_thread) {
+  scoped_thread = &thread;
+}
+
+EventThreadScope::~EventThreadScope() { scoped_thread = previous_; }
+
+ThreadControl* EventThreadScope::GetCurrent() noexcept { return scoped_thread; }
+
 ThreadPool::ThreadPool(ThreadPoolConfig config)
     : ThreadPool(std::move(config), false) {}
 
@@ -31,17 +43,33 @@ ThreadPool::ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop)
   const auto register_timer_event_mode =
       GetRegisterEventMode(config.defer_events);
 
+  std::vector<std::vector<int>> thread_cpus;
+  thread_cpus.reserve(config.threads);
+  for (std::size_t i = 0; i < config.threads; ++i) {
+    thread_cpus.push_back(config.affinity.GetThreadCpus(i));
+  }
+
   threads_ = utils::GenerateFixedArray(config.threads, [&](std::size_t index) {
     const auto thread_name = fmt::format("{}_{}", config.thread_name, index);
     return (use_ev_default_loop && index == 0)
                ? Thread(thread_name, Thread::kUseDefaultEvLoop,
-                        register_timer_event_mode)
-               : Thread(thread_name, register_timer_event_mode);
+                        register_timer_event_mode, thread_cpus[index])
+               : Thread(thread_name, register_timer_event_mode,
+                        thread_cpus[index]);
   });
 
   thread_controls_ = utils::GenerateFixedArray(
       threads_.size(),
       [&](std::size_t index) { return ThreadControl(threads_[index]); });
+
+  if (!config.affinity.nodes.empty()) {
+    node_thread_controls_.resize(utils::numa::GetNodeCount());
+    for (std::size_t i = 0; i < thread_controls_.size(); ++i) {
+      const auto node = utils::numa::GetCpusNode(thread_cpus[i]);
+      if (node == utils::numa::kUnknownNode) continue;
+      node_thread_controls_[node].push_back(&thread_controls_[i]);
+    }
+  }
 }
 
 ThreadPool::~ThreadPool() = default;
@@ -50,6 +78,16 @@ std::size_t ThreadPool::GetSize() const { return threads_.size(); }
 
 ThreadControl& ThreadPool::NextThread() {
   UASSERT(!thread_controls_.empty());
+  if (!node_thread_controls_.empty()) {
+    const auto node = utils::numa::GetCurrentNode();
+    if (node != utils::numa::kUnknownNode &&
+        static_cast<std::size_t>(node) < node_thread_controls_.size()) {
+      const auto& node_threads = node_thread_controls_[node];
+      if (!node_threads.empty()) {
+        return *node_threads[next_thread_idx_++ % node_threads.size()];
+      }
+    }
+  }
   // just ignore counter_ overflow
   return thread_controls_[next_thread_idx_++ % thread_controls_.size()];
 }
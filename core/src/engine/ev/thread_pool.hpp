@@ -13,6 +13,24 @@ namespace engine::ev {
 
 class Thread;
 
+/// Makes current_task::GetEventThread() return the specified thread while the
+/// scope is alive, e.g. to bind a socket to a specific ev thread.
+/// @warning The scope must not span context switches of the current task.
+class EventThreadScope final {
+ public:
+  explicit EventThreadScope(ThreadControl& thread) noexcept;
+  ~EventThreadScope();
+
+  EventThreadScope(const EventThreadScope&) = delete;
+  EventThreadScope& operator=(const EventThreadScope&) = delete;
+
+  /// The thread of the innermost scope of the current thread or nullptr
+  static ThreadControl* GetCurrent() noexcept;
+
+ private:
+  ThreadControl* const previous_;
+};
+
 class ThreadPool final {
  public:
   struct UseDefaultEvLoop {};
@@ -25,6 +43,8 @@ class ThreadPool final {
 
   std::size_t GetSize() const;
 
+  /// Returns the next thread of the pool, prefers the threads of the NUMA
+  /// node of the current thread if the pool is pinned to the NUMA nodes
   ThreadControl& NextThread();
 
   std::vector<ThreadControl*> NextThreads(std::size_t count);
@@ -37,6 +57,8 @@ class ThreadPool final {
   bool use_ev_default_loop_;
   utils::FixedArray<Thread> threads_;
   utils::FixedArray<ThreadControl> thread_controls_;
+  // Threads of each NUMA node, empty if the threads are not pinned to nodes
+  std::vector<std::vector<ThreadControl*>> node_thread_controls_;
   std::atomic<std::size_t> next_thread_idx_{0};
 };
 
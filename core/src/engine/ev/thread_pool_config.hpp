@@ -4,6 +4,7 @@
 
 #include <userver/formats/yaml.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
+#include <utils/numa.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -14,6 +15,7 @@ struct ThreadPoolConfig {
   std::string thread_name = "event-worker";
   bool ev_default_loop_disabled = false;
   bool defer_events = false;
+  utils::numa::AffinityConfig affinity;
 };
 
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
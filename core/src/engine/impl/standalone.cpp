@@ -32,10 +32,11 @@ std::shared_ptr<TaskProcessorPools> MakeTaskProcessorPools(
 
 TaskProcessorHolder TaskProcessorHolder::Make(
     std::size_t threads_num, std::string thread_name,
-    std::shared_ptr<TaskProcessorPools> pools) {
+    std::shared_ptr<TaskProcessorPools> pools, TaskQueueType task_queue_type) {
   TaskProcessorConfig config;
   config.worker_threads = threads_num;
   config.thread_name = std::move(thread_name);
+  config.task_processor_queue = task_queue_type;
 
   return TaskProcessorHolder(
       std::make_unique<TaskProcessor>(std::move(config), std::move(pools)));
@@ -2,10 +2,13 @@
 
 #include <array>
 #include <thread>
+#include <vector>
 
+#include <engine/impl/standalone.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/impl/task_local_storage.hpp>
 #include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/utils/async.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -90,4 +93,39 @@ void async_comparisons_coro_spanned(benchmark::State& state) {
 }
 BENCHMARK(async_comparisons_coro_spanned)->RangeMultiplier(2)->Range(1, 32);
 
+// Each iteration spawns `state.range(1)` tasks and waits for all of them.
+void async_fan_out(benchmark::State& state,
+                   engine::TaskQueueType task_queue_type) {
+  auto task_processor_holder = engine::impl::TaskProcessorHolder::Make(
+      state.range(0), "bench-worker", engine::impl::MakeTaskProcessorPools({}),
+      task_queue_type);
+
+  engine::impl::RunOnTaskProcessorSync(*task_processor_holder, [&] {
+    const auto fan_out = static_cast<std::size_t>(state.range(1));
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(fan_out);
+
+    for (auto _ : state) {
+      for (std::size_t i = 0; i < fan_out; ++i) {
+        tasks.push_back(engine::AsyncNoSpan([] {
+          std::uint64_t sum = 0;
+          for (std::uint64_t j = 0; j < 100; ++j) sum += j;
+          benchmark::DoNotOptimize(sum);
+        }));
+      }
+      for (auto& task : tasks) task.Wait();
+      tasks.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * fan_out);
+  });
+}
+BENCHMARK_CAPTURE(async_fan_out, global_queue,
+                  engine::TaskQueueType::kGlobalTaskQueue)
+    ->ArgsProduct({{1, 2, 4, 8, 16, 32, 64}, {16, 256}})
+    ->UseRealTime();
+BENCHMARK_CAPTURE(async_fan_out, work_stealing_queue,
+                  engine::TaskQueueType::kWorkStealingTaskQueue)
+    ->ArgsProduct({{1, 2, 4, 8, 16, 32, 64}, {16, 256}})
+    ->UseRealTime();
+
 USERVER_NAMESPACE_END
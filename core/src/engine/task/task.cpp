@@ -3,6 +3,7 @@
 #include <future>
 
 #include <engine/coro/pool.hpp>
+#include <engine/ev/thread_pool.hpp>
 #include <engine/impl/generic_wait_list.hpp>
 #include <engine/task/task_context.hpp>
 #include <engine/task/task_processor.hpp>
@@ -182,6 +183,8 @@ TaskProcessor* GetTaskProcessorOptional() noexcept {
 }
 
 ev::ThreadControl& GetEventThread() {
+  auto* const scoped_thread = ev::EventThreadScope::GetCurrent();
+  if (scoped_thread) return *scoped_thread;
   return GetTaskProcessor().EventThreadPool().NextThread();
 }
 
@@ -1,9 +1,15 @@
 #include <benchmark/benchmark.h>
 
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <thread>
+#include <vector>
 
+#include <engine/impl/standalone.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/task_with_result.hpp>
@@ -43,6 +49,78 @@ void engine_task_yield_multiple_threads(benchmark::State& state) {
 }
 BENCHMARK(engine_task_yield_multiple_threads)->RangeMultiplier(2)->Range(1, 32);
 
+namespace {
+
+void RunStandaloneWithQueue(std::size_t worker_threads,
+                            engine::TaskQueueType task_queue_type,
+                            std::function<void()> payload) {
+  auto task_processor_holder = engine::impl::TaskProcessorHolder::Make(
+      worker_threads, "bench-worker",
+      engine::impl::MakeTaskProcessorPools({}), task_queue_type);
+  engine::impl::RunOnTaskProcessorSync(*task_processor_holder,
+                                       std::move(payload));
+}
+
+}  // namespace
+
+// Pairs of tasks waking each other up. Each pair does one round trip per
+// iteration, the rest of the pairs keep the workers busy.
+void engine_task_ping_pong(benchmark::State& state,
+                           engine::TaskQueueType task_queue_type) {
+  const auto worker_threads = static_cast<std::size_t>(state.range(0));
+  RunStandaloneWithQueue(worker_threads, task_queue_type, [&] {
+    std::atomic<bool> keep_running{true};
+    std::vector<engine::TaskWithResult<void>> background_pairs;
+    std::vector<std::unique_ptr<engine::SingleConsumerEvent>> events;
+
+    const auto start_pair = [&](engine::SingleConsumerEvent* ping,
+                                engine::SingleConsumerEvent* pong) {
+      background_pairs.push_back(engine::AsyncNoSpan([&keep_running, ping,
+                                                      pong] {
+        while (keep_running && ping->WaitForEvent()) pong->Send();
+      }));
+      background_pairs.push_back(engine::AsyncNoSpan([&keep_running, ping,
+                                                      pong] {
+        while (keep_running) {
+          ping->Send();
+          if (!pong->WaitForEvent()) break;
+        }
+      }));
+    };
+
+    for (std::size_t i = 1; i < worker_threads; ++i) {
+      events.push_back(std::make_unique<engine::SingleConsumerEvent>());
+      events.push_back(std::make_unique<engine::SingleConsumerEvent>());
+      start_pair(events[events.size() - 2].get(), events.back().get());
+    }
+
+    engine::SingleConsumerEvent ping;
+    engine::SingleConsumerEvent pong;
+    auto responder = engine::AsyncNoSpan([&] {
+      while (ping.WaitForEvent()) pong.Send();
+    });
+
+    for (auto _ : state) {
+      ping.Send();
+      [[maybe_unused]] const bool ok = pong.WaitForEvent();
+    }
+
+    keep_running = false;
+    responder.SyncCancel();
+    for (auto& task : background_pairs) task.SyncCancel();
+  });
+}
+BENCHMARK_CAPTURE(engine_task_ping_pong, global_queue,
+                  engine::TaskQueueType::kGlobalTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(engine_task_ping_pong, work_stealing_queue,
+                  engine::TaskQueueType::kWorkStealingTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+
 void thread_yield(benchmark::State& state) {
   for (auto _ : state) std::this_thread::yield();
 }
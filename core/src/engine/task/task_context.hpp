@@ -26,6 +26,7 @@
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/utils/flags.hpp>
 #include <userver/utils/impl/wrapped_call_base.hpp>
+#include <utils/numa.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -173,6 +174,11 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
     task_queue_wait_timepoint_ = tp;
   }
 
+  // NUMA node the task was executed on the last time, if known
+  int GetNumaNode() const { return numa_node_; }
+
+  void SetNumaNode(int node) { numa_node_ = node; }
+
   void SetCancelDeadline(Deadline deadline);
 
   bool HasLocalStorage() const noexcept;
@@ -231,6 +237,7 @@ class TaskContext final : public boost::intrusive_ref_counter<TaskContext>,
   std::chrono::steady_clock::time_point last_state_change_timepoint_;
 
   size_t trace_csw_left_;
+  int numa_node_{utils::numa::kUnknownNode};
 
   AtomicSleepState sleep_state_;
   WakeupSource wakeup_source_{WakeupSource::kNone};
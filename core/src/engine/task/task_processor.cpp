@@ -10,6 +10,7 @@
 #include <userver/utils/rand.hpp>
 #include <userver/utils/thread_name.hpp>
 #include <utils/impl/static_registration.hpp>
+#include <utils/numa.hpp>
 #include <utils/threads.hpp>
 
 #include <engine/task/task_context.hpp>
@@ -60,16 +61,32 @@ void TaskProcessorThreadStartedHook() {
   EmitMagicNanosleep();
 }
 
+std::variant<TaskQueue, WorkStealingTaskQueue> MakeTaskQueue(
+    const TaskProcessorConfig& config) {
+  switch (config.task_processor_queue) {
+    case TaskQueueType::kGlobalTaskQueue:
+      return std::variant<TaskQueue, WorkStealingTaskQueue>{
+          std::in_place_type<TaskQueue>};
+    case TaskQueueType::kWorkStealingTaskQueue:
+      return std::variant<TaskQueue, WorkStealingTaskQueue>{
+          std::in_place_type<WorkStealingTaskQueue>, config.worker_threads};
+  }
+
+  UINVARIANT(false, "Unexpected value of TaskQueueType");
+}
+
 }  // namespace
 
 TaskProcessor::TaskProcessor(TaskProcessorConfig config,
                              std::shared_ptr<impl::TaskProcessorPools> pools)
     : config_(std::move(config)),
+      is_numa_aware_(utils::numa::GetNodeCount() > 1),
       task_profiler_threshold_{std::chrono::microseconds(0)},
       profiler_force_stacktrace_{false},
       pools_(std::move(pools)),
       is_shutting_down_(false),
       detached_contexts_(impl::DetachedTasksSyncBlock::StopMode::kCancel),
+      task_queue_(MakeTaskQueue(config_)),
       max_task_queue_wait_time_(std::chrono::microseconds(0)),
       max_task_queue_wait_length_(0),
       task_trace_logger_{nullptr} {
@@ -78,9 +95,22 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config,
     LOG_INFO() << "creating task_processor " << Name() << " "
                << "worker_threads=" << config_.worker_threads
                << " thread_name=" << config_.thread_name;
+    std::vector<std::vector<int>> worker_cpus;
+    worker_cpus.reserve(config_.worker_threads);
+    for (size_t i = 0; i < config_.worker_threads; ++i) {
+      worker_cpus.push_back(config_.affinity.GetThreadCpus(i));
+    }
+
     workers_.reserve(config_.worker_threads);
     for (size_t i = 0; i < config_.worker_threads; ++i) {
-      workers_.emplace_back([this, i] {
+      workers_.emplace_back([this, i, cpus = std::move(worker_cpus[i])] {
+        try {
+          utils::numa::SetCurrentThreadAffinity(cpus);
+        } catch (const std::exception& ex) {
+          LOG_ERROR() << "Failed to pin a worker of task_processor " << Name()
+                      << ": " << ex;
+        }
+
         switch (config_.os_scheduling) {
           case OsScheduling::kNormal:
             break;
@@ -111,7 +141,7 @@ void TaskProcessor::Cleanup() noexcept {
   // Some tasks may be bound but not scheduled yet
   task_counter_.WaitForExhaustion(std::chrono::milliseconds(10));
 
-  task_queue_.enqueue(nullptr);
+  std::visit([](auto& queue) { queue.StopProcessing(); }, task_queue_);
 
   for (auto& w : workers_) {
     w.join();
@@ -141,12 +171,13 @@ void TaskProcessor::Schedule(impl::TaskContext* context) {
     context->RequestCancel(TaskCancellationReason::kShutdown);
 
   SetTaskQueueWaitTimepoint(context);
+  if (is_numa_aware_) AccountNumaWakeup(*context);
 
   // having native support for intrusive ptrs in lockfree would've been great
   // but oh well
   intrusive_ptr_add_ref(context);
 
-  task_queue_.enqueue(context);
+  std::visit([context](auto& queue) { queue.Push(context); }, task_queue_);
   // NOTE: task may be executed at this point
 }
 
@@ -227,23 +258,17 @@ logging::LoggerPtr TaskProcessor::GetTaskTraceLogger() const {
   return task_trace_logger_;
 }
 
-impl::TaskContext* TaskProcessor::DequeueTask() {
-  impl::TaskContext* buf = nullptr;
-
-  /* Current thread handles only a single TaskProcessor, so it's safe to store
-   * a token for the task processor in a thread-local variable.
-   */
-  thread_local moodycamel::ConsumerToken token(task_queue_);
+size_t TaskProcessor::GetTaskQueueSize() const {
+  return std::visit(
+      [](const auto& queue) { return queue.GetSizeApproximate(); },
+      task_queue_);
+}
 
-  task_queue_.wait_dequeue(token, buf);
+impl::TaskContext* TaskProcessor::DequeueTask() {
+  auto* context =
+      std::visit([](auto& queue) { return queue.PopBlocking(); }, task_queue_);
   GetTaskCounter().AccountTaskSwitchSlow();
-
-  if (!buf) {
-    // return "stop" token back
-    task_queue_.enqueue(nullptr);
-  }
-
-  return buf;
+  return context;
 }
 
 void RegisterThreadStartedHook(std::function<void()> func) {
@@ -262,6 +287,7 @@ void TaskProcessor::ProcessTasks() noexcept {
     if (!context) break;
 
     CheckWaitTime(*context);
+    if (is_numa_aware_) context->SetNumaNode(utils::numa::GetCurrentNode());
 
     bool has_failed = false;
     try {
@@ -277,6 +303,16 @@ void TaskProcessor::ProcessTasks() noexcept {
   }
 }
 
+void TaskProcessor::AccountNumaWakeup(const impl::TaskContext& context) {
+  const auto task_node = context.GetNumaNode();
+  if (task_node == utils::numa::kUnknownNode) return;
+
+  const auto waker_node = utils::numa::GetCurrentNode();
+  if (waker_node != utils::numa::kUnknownNode && waker_node != task_node) {
+    task_counter_.AccountCrossNumaWakeup();
+  }
+}
+
 void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
   const auto max_wait_time = max_task_queue_wait_time_.load();
   const auto sensor_wait_time = sensor_task_queue_wait_time_.load();
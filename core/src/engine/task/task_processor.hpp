@@ -7,14 +7,16 @@
 #include <memory>
 #include <thread>
 #include <unordered_set>
+#include <variant>
 #include <vector>
 
-#include <moodycamel/blockingconcurrentqueue.h>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
 #include <engine/task/counted_coroutine_ptr.hpp>
 #include <engine/task/task_counter.hpp>
 #include <engine/task/task_processor_config.hpp>
+#include <engine/task/task_queue.hpp>
+#include <engine/task/work_stealing_task_queue.hpp>
 #include <userver/engine/impl/detached_tasks_sync_block.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -55,7 +57,7 @@ class TaskProcessor final {
 
   const impl::TaskCounter& GetTaskCounter() const { return task_counter_; }
 
-  size_t GetTaskQueueSize() const { return task_queue_.size_approx(); }
+  size_t GetTaskQueueSize() const;
 
   size_t GetWorkerCount() const { return workers_.size(); }
 
@@ -84,7 +86,11 @@ class TaskProcessor final {
 
   void HandleOverload(impl::TaskContext& context);
 
+  void AccountNumaWakeup(const impl::TaskContext& context);
+
   const TaskProcessorConfig config_;
+  // NUMA bookkeeping is skipped on single node machines
+  const bool is_numa_aware_;
   std::atomic<std::chrono::microseconds> task_profiler_threshold_;
   std::atomic<bool> profiler_force_stacktrace_{false};
 
@@ -93,7 +99,7 @@ class TaskProcessor final {
   std::atomic<bool> is_shutting_down_;
   impl::DetachedTasksSyncBlock detached_contexts_;
 
-  moodycamel::BlockingConcurrentQueue<impl::TaskContext*> task_queue_;
+  std::variant<TaskQueue, WorkStealingTaskQueue> task_queue_;
 
   std::atomic<std::chrono::microseconds> sensor_task_queue_wait_time_{};
   std::atomic<std::chrono::microseconds> max_task_queue_wait_time_{};
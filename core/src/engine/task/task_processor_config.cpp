@@ -27,6 +27,18 @@ OsScheduling Parse(const yaml_config::YamlConfig& value,
   UINVARIANT(false, "Unknown OS scheduling value: " + str);
 }
 
+TaskQueueType Parse(const yaml_config::YamlConfig& value,
+                    formats::parse::To<TaskQueueType>) {
+  const auto str = value.As<std::string>();
+  if (str == "global-task-queue") {
+    return TaskQueueType::kGlobalTaskQueue;
+  } else if (str == "work-stealing-task-queue") {
+    return TaskQueueType::kWorkStealingTaskQueue;
+  }
+
+  UINVARIANT(false, "Unknown task processor queue type: " + str);
+}
+
 TaskProcessorConfig Parse(const yaml_config::YamlConfig& value,
                           formats::parse::To<TaskProcessorConfig>) {
   TaskProcessorConfig config;
@@ -36,6 +48,10 @@ TaskProcessorConfig Parse(const yaml_config::YamlConfig& value,
   config.thread_name = value["thread_name"].As<std::string>();
   config.os_scheduling =
       value["os-scheduling"].As<OsScheduling>(OsScheduling::kNormal);
+  config.task_processor_queue =
+      value["task-processor-queue"].As<TaskQueueType>(
+          config.task_processor_queue);
+  config.affinity = value.As<utils::numa::AffinityConfig>();
 
   const auto task_trace = value["task-trace"];
   if (!task_trace.IsMissing()) {
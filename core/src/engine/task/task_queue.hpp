@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+
+#include <moodycamel/blockingconcurrentqueue.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace impl {
+class TaskContext;
+}  // namespace impl
+
+/// Single multi-producer multi-consumer queue shared by all the workers of
+/// a TaskProcessor.
+class TaskQueue final {
+ public:
+  TaskQueue() = default;
+
+  void Push(impl::TaskContext* context);
+
+  /// Blocks until a task is available. Returns nullptr after StopProcessing().
+  impl::TaskContext* PopBlocking();
+
+  void StopProcessing();
+
+  std::size_t GetSizeApproximate() const noexcept;
+
+ private:
+  moodycamel::BlockingConcurrentQueue<impl::TaskContext*> queue_;
+};
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,287 @@
+#include <engine/task/work_stealing_task_queue.hpp>
+
+#include <algorithm>
+
+#include <engine/task/task_context.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+namespace {
+
+// Check the global queue first every Nth pop, so that tasks scheduled from
+// outside are not starved by the tasks that keep rescheduling locally.
+constexpr std::size_t kGlobalQueueCheckInterval = 61;
+
+// Limit on LIFO slot runs in a row, so that two tasks waking each other up
+// do not starve the local queue.
+constexpr std::size_t kMaxConsecutiveNextTaskRuns = 16;
+
+// Current thread handles only a single TaskProcessor, so it's safe to store
+// its consumer in a thread-local variable.
+struct ConsumerBinding final {
+  const WorkStealingTaskQueue* queue{nullptr};
+  impl::WorkStealingConsumer* consumer{nullptr};
+};
+
+thread_local ConsumerBinding current_consumer_binding;
+
+}  // namespace
+
+namespace impl {
+
+bool LocalTaskQueue::TryPush(TaskContext* context) noexcept {
+  const auto tail = tail_.load(std::memory_order_relaxed);
+  // acquire: the stealers must finish reading the slot we're about to reuse
+  const auto head = head_.load(std::memory_order_acquire);
+  if (tail - head >= kCapacity) return false;
+
+  buffer_[tail & kMask].store(context, std::memory_order_relaxed);
+  tail_.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+TaskContext* LocalTaskQueue::TryPop() noexcept {
+  auto head = head_.load(std::memory_order_acquire);
+  while (true) {
+    const auto tail = tail_.load(std::memory_order_acquire);
+    if (head == tail) return nullptr;
+
+    // The slot can not be overwritten by the owner until head_ moves past it
+    auto* context = buffer_[head & kMask].load(std::memory_order_relaxed);
+    if (head_.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel,
+                                    std::memory_order_acquire)) {
+      return context;
+    }
+  }
+}
+
+TaskContext* LocalTaskQueue::StealHalf(LocalTaskQueue& from) noexcept {
+  UASSERT(&from != this);
+
+  const auto dst_tail = tail_.load(std::memory_order_relaxed);
+  const auto dst_free =
+      kCapacity - (dst_tail - head_.load(std::memory_order_acquire));
+
+  auto head = from.head_.load(std::memory_order_acquire);
+  while (true) {
+    const auto tail = from.tail_.load(std::memory_order_acquire);
+    const auto size = tail - head;
+    if (size == 0) return nullptr;
+
+    // One task is returned to the caller, the rest go to our queue
+    const auto count = std::min<std::uint64_t>(size - size / 2, dst_free + 1);
+    for (std::uint64_t i = 1; i < count; ++i) {
+      buffer_[(dst_tail + i - 1) & kMask].store(
+          from.buffer_[(head + i) & kMask].load(std::memory_order_relaxed),
+          std::memory_order_relaxed);
+    }
+    auto* context = from.buffer_[head & kMask].load(std::memory_order_relaxed);
+
+    if (from.head_.compare_exchange_weak(head, head + count,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+      if (count > 1) {
+        tail_.store(dst_tail + count - 1, std::memory_order_release);
+      }
+      return context;
+    }
+  }
+}
+
+std::size_t LocalTaskQueue::GetSizeApproximate() const noexcept {
+  const auto head = head_.load(std::memory_order_relaxed);
+  const auto tail = tail_.load(std::memory_order_relaxed);
+  return tail > head ? tail - head : 0;
+}
+
+}  // namespace impl
+
+WorkStealingTaskQueue::WorkStealingTaskQueue(std::size_t consumers_count)
+    : consumers_(consumers_count) {
+  UINVARIANT(consumers_count != 0, "Unable to run anything using 0 threads");
+  for (std::size_t i = 0; i < consumers_count; ++i) {
+    consumers_[i].index = i;
+  }
+}
+
+void WorkStealingTaskQueue::Push(impl::TaskContext* context) {
+  UASSERT(context);
+  auto* consumer = GetCurrentConsumer();
+  if (!consumer) {
+    PushGlobal(context);
+    WakeUpOne();
+    return;
+  }
+
+  if (current_task::GetCurrentTaskContextUnchecked()) {
+    // A task running on this worker wakes up another one. Run it next on this
+    // core while its data is still hot in caches.
+    //
+    // Sleeping siblings are not woken up for the LIFO slot: the task is going
+    // to be run right after the current one, and a sibling would most likely
+    // only steal it away from the warm core.
+    context = consumer->next_task.exchange(context, std::memory_order_acq_rel);
+    if (!context) return;
+  }
+
+  if (!consumer->local_queue.TryPush(context)) {
+    PushGlobal(context);
+  }
+  WakeUpOne();
+}
+
+impl::TaskContext* WorkStealingTaskQueue::PopBlocking() {
+  auto* consumer = GetCurrentConsumer();
+  if (!consumer) consumer = &BindCurrentConsumer();
+
+  while (true) {
+    if (auto* context = TryPop(*consumer)) return context;
+    if (is_stopped_.load()) return nullptr;
+
+    PrepareToSleep();
+    // Recheck after announcing ourselves as a sleeper, otherwise we could
+    // miss a task pushed right before the announcement.
+    if (auto* context = TryPop(*consumer)) {
+      CancelSleep();
+      return context;
+    }
+    if (is_stopped_.load()) {
+      CancelSleep();
+      return nullptr;
+    }
+    sleep_semaphore_.wait();
+  }
+}
+
+void WorkStealingTaskQueue::StopProcessing() {
+  is_stopped_ = true;
+  sleep_semaphore_.signal(consumers_.size());
+}
+
+std::size_t WorkStealingTaskQueue::GetSizeApproximate() const noexcept {
+  std::size_t size = global_queue_.size_approx();
+  for (const auto& consumer : consumers_) {
+    size += consumer.local_queue.GetSizeApproximate();
+    if (consumer.next_task.load(std::memory_order_relaxed)) ++size;
+  }
+  return size;
+}
+
+impl::WorkStealingConsumer* WorkStealingTaskQueue::GetCurrentConsumer()
+    const noexcept {
+  const auto& binding = current_consumer_binding;
+  return binding.queue == this ? binding.consumer : nullptr;
+}
+
+impl::WorkStealingConsumer& WorkStealingTaskQueue::BindCurrentConsumer() {
+  const auto index = bound_consumers_.fetch_add(1);
+  UINVARIANT(index < consumers_.size(),
+             "More threads are consuming from WorkStealingTaskQueue than it "
+             "was created for");
+
+  current_consumer_binding = {this, &consumers_[index]};
+  return consumers_[index];
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPop(
+    impl::WorkStealingConsumer& consumer) {
+  if (++consumer.pops_count % kGlobalQueueCheckInterval == 0) {
+    if (auto* context = TryPopGlobal()) {
+      consumer.consecutive_next_task_runs = 0;
+      return context;
+    }
+  }
+
+  if (consumer.consecutive_next_task_runs < kMaxConsecutiveNextTaskRuns) {
+    auto* context =
+        consumer.next_task.exchange(nullptr, std::memory_order_acq_rel);
+    if (context) {
+      ++consumer.consecutive_next_task_runs;
+      return context;
+    }
+  } else if (auto* context = consumer.next_task.exchange(
+                 nullptr, std::memory_order_acq_rel)) {
+    // Give the queued tasks a chance, the LIFO task waits in the queue now
+    if (!consumer.local_queue.TryPush(context)) PushGlobal(context);
+  }
+  consumer.consecutive_next_task_runs = 0;
+
+  if (auto* context = consumer.local_queue.TryPop()) return context;
+  if (auto* context = TryPopGlobal()) return context;
+  return TrySteal(consumer);
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TrySteal(
+    impl::WorkStealingConsumer& consumer) {
+  const auto consumers_count = consumers_.size();
+  if (consumers_count == 1) return nullptr;
+
+  // Start from a random sibling to spread the stealers
+  const auto start = utils::RandRange(consumers_count);
+  for (std::size_t i = 0; i < consumers_count; ++i) {
+    auto& victim = consumers_[(start + i) % consumers_count];
+    if (&victim == &consumer) continue;
+    if (auto* context = consumer.local_queue.StealHalf(victim.local_queue)) {
+      return context;
+    }
+  }
+
+  // The sibling might be stuck in a long task with a task in its LIFO slot
+  for (std::size_t i = 0; i < consumers_count; ++i) {
+    auto& victim = consumers_[(start + i) % consumers_count];
+    if (&victim == &consumer) continue;
+    if (victim.next_task.load(std::memory_order_relaxed)) {
+      auto* context =
+          victim.next_task.exchange(nullptr, std::memory_order_acq_rel);
+      if (context) return context;
+    }
+  }
+  return nullptr;
+}
+
+void WorkStealingTaskQueue::PushGlobal(impl::TaskContext* context) {
+  global_queue_.enqueue(context);
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPopGlobal() {
+  impl::TaskContext* context = nullptr;
+  global_queue_.try_dequeue(context);
+  return context;
+}
+
+void WorkStealingTaskQueue::PrepareToSleep() {
+  sleepers_.fetch_add(1, std::memory_order_seq_cst);
+  // Pairs with the fence in WakeUpOne(): either the pusher sees us as a
+  // sleeper, or we see its task on recheck.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void WorkStealingTaskQueue::CancelSleep() {
+  auto sleepers = sleepers_.load();
+  while (sleepers != 0) {
+    if (sleepers_.compare_exchange_weak(sleepers, sleepers - 1)) return;
+  }
+
+  // Some pusher has already claimed us and is going to signal the semaphore.
+  // Consume that signal, otherwise the sleepers counter and the semaphore
+  // get out of sync.
+  sleep_semaphore_.wait();
+}
+
+void WorkStealingTaskQueue::WakeUpOne() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto sleepers = sleepers_.load(std::memory_order_relaxed);
+  while (sleepers != 0) {
+    if (sleepers_.compare_exchange_weak(sleepers, sleepers - 1)) {
+      sleep_semaphore_.signal();
+      return;
+    }
+  }
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
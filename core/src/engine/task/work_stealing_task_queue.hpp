@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <moodycamel/concurrentqueue.h>
+#include <moodycamel/lightweightsemaphore.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace impl {
+class TaskContext;
+
+/// Bounded run queue of a single worker. Only the owning worker pushes,
+/// any worker may pop (the owner) or steal (the siblings) from its head.
+class LocalTaskQueue final {
+ public:
+  static constexpr std::size_t kCapacity = 256;
+
+  /// Owner only. Returns false if the queue is full.
+  bool TryPush(TaskContext* context) noexcept;
+
+  TaskContext* TryPop() noexcept;
+
+  /// Moves about a half of `from` tasks into `*this` and returns one of them.
+  /// Must be called by the owner of `*this`.
+  TaskContext* StealHalf(LocalTaskQueue& from) noexcept;
+
+  std::size_t GetSizeApproximate() const noexcept;
+
+ private:
+  static constexpr std::size_t kMask = kCapacity - 1;
+  static_assert((kCapacity & kMask) == 0, "kCapacity must be a power of 2");
+
+  // head_ and tail_ grow monotonically, 64 bits do not overflow in practice
+  std::atomic<std::uint64_t> head_{0};
+  std::atomic<std::uint64_t> tail_{0};
+  std::array<std::atomic<TaskContext*>, kCapacity> buffer_{};
+};
+
+// Minimum offset between two objects to avoid false sharing
+inline constexpr std::size_t kInterferenceSize = 64;
+
+struct alignas(kInterferenceSize) WorkStealingConsumer final {
+  LocalTaskQueue local_queue;
+
+  // LIFO slot for the tasks woken up by the task running on this worker
+  std::atomic<TaskContext*> next_task{nullptr};
+
+  // Accessed by the owning worker only
+  std::size_t pops_count{0};
+  std::size_t consecutive_next_task_runs{0};
+  std::size_t index{0};
+};
+
+}  // namespace impl
+
+/// Task queue with a run queue per worker.
+///
+/// Tasks woken up by a task running on a worker are put into that worker's
+/// LIFO slot and are most likely to be executed next on the same (warm)
+/// core. Other tasks scheduled from the worker go to its local FIFO queue.
+/// Tasks scheduled from outside of the task processor (ev threads, other task
+/// processors) and local queue overflows go to the shared global queue.
+/// Idle workers steal from their siblings before going to sleep.
+class WorkStealingTaskQueue final {
+ public:
+  explicit WorkStealingTaskQueue(std::size_t consumers_count);
+
+  void Push(impl::TaskContext* context);
+
+  /// Blocks until a task is available. Must be called only from the
+  /// `consumers_count` worker threads, each thread is bound to its own
+  /// consumer on the first call. Returns nullptr after StopProcessing().
+  impl::TaskContext* PopBlocking();
+
+  void StopProcessing();
+
+  std::size_t GetSizeApproximate() const noexcept;
+
+ private:
+  impl::WorkStealingConsumer* GetCurrentConsumer() const noexcept;
+  impl::WorkStealingConsumer& BindCurrentConsumer();
+
+  impl::TaskContext* TryPop(impl::WorkStealingConsumer& consumer);
+  impl::TaskContext* TrySteal(impl::WorkStealingConsumer& consumer);
+
+  void PushGlobal(impl::TaskContext* context);
+  impl::TaskContext* TryPopGlobal();
+
+  void PrepareToSleep();
+  void CancelSleep();
+  void WakeUpOne();
+
+  std::vector<impl::WorkStealingConsumer> consumers_;
+  std::atomic<std::size_t> bound_consumers_{0};
+
+  moodycamel::ConcurrentQueue<impl::TaskContext*> global_queue_;
+
+  alignas(impl::kInterferenceSize) std::atomic<std::size_t> sleepers_{0};
+  moodycamel::LightweightSemaphore sleep_semaphore_;
+  std::atomic<bool> is_stopped_{false};
+};
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,145 @@
+#include <engine/task/work_stealing_task_queue.hpp>
+
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <engine/impl/standalone.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kWorkerThreads = 4;
+
+template <typename Func>
+void RunInWorkStealingTaskProcessor(std::size_t worker_threads, Func func) {
+  auto task_processor_holder = engine::impl::TaskProcessorHolder::Make(
+      worker_threads, "ws-worker", engine::impl::MakeTaskProcessorPools({}),
+      engine::TaskQueueType::kWorkStealingTaskQueue);
+  engine::impl::RunOnTaskProcessorSync(*task_processor_holder, func);
+}
+
+engine::impl::TaskContext* FakeContext(std::uintptr_t i) {
+  // The queue never dereferences the pointers
+  return reinterpret_cast<engine::impl::TaskContext*>((i + 1) * 8);
+}
+
+}  // namespace
+
+TEST(WorkStealingTaskQueue, ExternalPushes) {
+  constexpr std::size_t kTasks = 10000;
+  engine::WorkStealingTaskQueue queue(kWorkerThreads);
+
+  std::atomic<std::size_t> popped{0};
+  std::vector<std::vector<engine::impl::TaskContext*>> results(kWorkerThreads);
+  std::vector<std::thread> workers;
+  for (std::size_t i = 0; i < kWorkerThreads; ++i) {
+    workers.emplace_back([&, i] {
+      while (auto* context = queue.PopBlocking()) {
+        results[i].push_back(context);
+        ++popped;
+      }
+    });
+  }
+
+  for (std::size_t i = 0; i < kTasks; ++i) queue.Push(FakeContext(i));
+  while (popped != kTasks) std::this_thread::yield();
+  EXPECT_EQ(queue.GetSizeApproximate(), 0);
+
+  queue.StopProcessing();
+  for (auto& worker : workers) worker.join();
+
+  std::unordered_set<engine::impl::TaskContext*> unique;
+  for (const auto& result : results) {
+    unique.insert(result.begin(), result.end());
+  }
+  EXPECT_EQ(unique.size(), kTasks);
+}
+
+TEST(WorkStealingTaskQueue, LocalPushesAreStolen) {
+  constexpr std::size_t kTasks = 10000;
+  engine::WorkStealingTaskQueue queue(kWorkerThreads);
+
+  std::atomic<std::size_t> popped{0};
+  std::vector<std::thread> workers;
+  for (std::size_t i = 0; i < kWorkerThreads; ++i) {
+    workers.emplace_back([&] {
+      while (auto* context = queue.PopBlocking()) {
+        // The first task spawns all the others into the local queue of the
+        // worker, the siblings have to steal them.
+        if (context == FakeContext(0)) {
+          for (std::size_t j = 1; j < kTasks; ++j) queue.Push(FakeContext(j));
+        }
+        ++popped;
+      }
+    });
+  }
+
+  queue.Push(FakeContext(0));
+  while (popped != kTasks) std::this_thread::yield();
+
+  queue.StopProcessing();
+  for (auto& worker : workers) worker.join();
+}
+
+TEST(WorkStealingTaskQueue, ManyTasks) {
+  RunInWorkStealingTaskProcessor(kWorkerThreads, [] {
+    constexpr std::size_t kTasks = 1000;
+    std::atomic<std::size_t> counter{0};
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (std::size_t i = 0; i < kTasks; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&counter] {
+        engine::Yield();
+        ++counter;
+      }));
+    }
+    for (auto& task : tasks) task.Get();
+
+    EXPECT_EQ(counter, kTasks);
+  });
+}
+
+TEST(WorkStealingTaskQueue, PingPong) {
+  RunInWorkStealingTaskProcessor(kWorkerThreads, [] {
+    constexpr std::size_t kRoundTrips = 10000;
+    engine::SingleConsumerEvent ping;
+    engine::SingleConsumerEvent pong;
+
+    auto responder = engine::AsyncNoSpan([&] {
+      for (std::size_t i = 0; i < kRoundTrips; ++i) {
+        ASSERT_TRUE(ping.WaitForEvent());
+        pong.Send();
+      }
+    });
+
+    for (std::size_t i = 0; i < kRoundTrips; ++i) {
+      ping.Send();
+      ASSERT_TRUE(pong.WaitForEvent());
+    }
+    responder.Get();
+  });
+}
+
+TEST(WorkStealingTaskQueue, SingleWorker) {
+  RunInWorkStealingTaskProcessor(1, [] {
+    std::atomic<std::size_t> counter{0};
+    auto task = engine::AsyncNoSpan([&counter] {
+      for (int i = 0; i < 100; ++i) {
+        engine::AsyncNoSpan([&counter] { ++counter; }).Get();
+      }
+    });
+    task.Get();
+    EXPECT_EQ(counter, 100);
+  });
+}
+
+USERVER_NAMESPACE_END
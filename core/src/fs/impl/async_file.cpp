@@ -0,0 +1,219 @@
+#include <fs/impl/async_file.hpp>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fs::impl {
+
+namespace {
+
+constexpr int kNoFd = -1;
+
+// Files like /proc/* report zero size
+constexpr std::size_t kMinReadSize = 4096;
+
+#ifdef O_DIRECT
+constexpr int kDirectIoFlag = O_DIRECT;
+#else
+constexpr int kDirectIoFlag = 0;
+#endif
+
+int OpenBlocking(const std::string& path, int flags, ::mode_t mode) {
+  int fd = kNoFd;
+  do {
+    fd = ::open(path.c_str(), flags, mode);
+  } while (fd == kNoFd && errno == EINTR);
+  return utils::CheckSyscall(fd, "opening file '{}'", path);
+}
+
+int OpenAsync(Uring& uring, const std::string& path, int flags,
+              ::mode_t mode) {
+  try {
+    return uring.Open(path.c_str(), flags, mode).Wait();
+  } catch (const std::system_error& ex) {
+    throw std::system_error(ex.code(),
+                            fmt::format("Error while opening file '{}'", path));
+  }
+}
+
+template <typename Func>
+std::size_t RetryOnEintr(Func func, const char* operation) {
+  ::ssize_t result = 0;
+  do {
+    result = func();
+  } while (result == -1 && errno == EINTR);
+  return utils::CheckSyscall(result, "calling {}", operation);
+}
+
+}  // namespace
+
+AsyncFile AsyncFile::Open(Uring* uring, const std::string& path, int flags,
+                          ::mode_t mode) {
+  UASSERT(!path.empty());
+  flags |= O_CLOEXEC;
+  const auto open = [&](int open_flags) {
+    return uring ? OpenAsync(*uring, path, open_flags, mode)
+                 : OpenBlocking(path, open_flags, mode);
+  };
+
+  if (kDirectIoFlag && (flags & kDirectIoFlag)) {
+    try {
+      return AsyncFile{uring, open(flags), true};
+    } catch (const std::system_error& ex) {
+      if (ex.code() != std::errc::invalid_argument) throw;
+      LOG_INFO() << "O_DIRECT is not supported for '" << path
+                 << "', falling back to the buffered I/O";
+    }
+    flags &= ~kDirectIoFlag;
+  }
+  return AsyncFile{uring, open(flags), false};
+}
+
+AsyncFile::AsyncFile(Uring* uring, int fd, bool is_direct_io) noexcept
+    : uring_(uring), fd_(fd), is_direct_io_(is_direct_io) {
+  UASSERT(fd_ != kNoFd);
+}
+
+AsyncFile::AsyncFile(AsyncFile&& other) noexcept
+    : uring_(other.uring_),
+      fd_(std::exchange(other.fd_, kNoFd)),
+      is_direct_io_(other.is_direct_io_) {}
+
+AsyncFile::~AsyncFile() {
+  if (fd_ != kNoFd && ::close(fd_) == -1) {
+    const auto code = errno;
+    LOG_ERROR() << "Error while closing a file: "
+                << std::error_code(code, std::system_category()).message();
+  }
+}
+
+void AsyncFile::DisableDirectIo() {
+  if (!is_direct_io_) return;
+  const auto flags =
+      utils::CheckSyscall(::fcntl(fd_, F_GETFL), "calling ::fcntl");
+  utils::CheckSyscall(::fcntl(fd_, F_SETFL, flags & ~kDirectIoFlag),
+                      "calling ::fcntl");
+  is_direct_io_ = false;
+}
+
+PendingIo AsyncFile::Read(void* buffer, std::size_t size,
+                          std::uint64_t offset) {
+  UASSERT(fd_ != kNoFd);
+  if (uring_) return uring_->Read(fd_, buffer, size, offset);
+  return PendingIo{RetryOnEintr(
+      [&] { return ::pread(fd_, buffer, size, offset); }, "::pread")};
+}
+
+PendingIo AsyncFile::Write(const void* buffer, std::size_t size,
+                           std::uint64_t offset) {
+  UASSERT(fd_ != kNoFd);
+  if (uring_) return uring_->Write(fd_, buffer, size, offset);
+  return PendingIo{RetryOnEintr(
+      [&] { return ::pwrite(fd_, buffer, size, offset); }, "::pwrite")};
+}
+
+PendingIo AsyncFile::WriteV(const ::iovec* iov, std::size_t count,
+                            std::uint64_t offset) {
+  UASSERT(fd_ != kNoFd);
+  if (uring_) return uring_->WriteV(fd_, iov, count, offset);
+  return PendingIo{RetryOnEintr(
+      [&] { return ::pwritev(fd_, iov, count, offset); }, "::pwritev")};
+}
+
+std::size_t AsyncFile::ReadFull(void* buffer, std::size_t size,
+                                std::uint64_t offset) {
+  auto* data = static_cast<char*>(buffer);
+  std::size_t total = 0;
+  while (total < size) {
+    const auto bytes = Read(data + total, size - total, offset + total).Wait();
+    total += bytes;
+    if (bytes == 0) break;
+    // Only the end of the file is not aligned, and reading from an unaligned
+    // offset is not allowed with O_DIRECT
+    if (is_direct_io_ && bytes % kDirectIoAlignment != 0) break;
+  }
+  return total;
+}
+
+void AsyncFile::WriteFull(std::string_view data, std::uint64_t offset) {
+  while (!data.empty()) {
+    const auto bytes = Write(data.data(), data.size(), offset).Wait();
+    if (bytes == 0) {
+      // Retrying would not make any progress
+      throw std::system_error(std::make_error_code(std::errc::io_error),
+                              "Error while writing a file: nothing written");
+    }
+    data.remove_prefix(bytes);
+    offset += bytes;
+  }
+}
+
+std::uint64_t AsyncFile::GetSize() const {
+  UASSERT(fd_ != kNoFd);
+  struct ::stat stats {};
+  utils::CheckSyscall(::fstat(fd_, &stats), "calling ::fstat");
+  return stats.st_size;
+}
+
+void AsyncFile::FSync() {
+  UASSERT(fd_ != kNoFd);
+  if (uring_) {
+    uring_->FSync(fd_).Wait();
+  } else {
+    utils::CheckSyscall(::fsync(fd_), "calling ::fsync");
+  }
+}
+
+void AsyncFile::Close() && {
+  UASSERT(fd_ != kNoFd);
+  const auto fd = std::exchange(fd_, kNoFd);
+  if (uring_) {
+    uring_->Close(fd).Wait();
+  } else {
+    utils::CheckSyscall(::close(fd), "calling ::close");
+  }
+}
+
+std::string ReadFileContents(Uring& uring, const std::string& path) {
+  auto file = AsyncFile::Open(&uring, path, O_RDONLY);
+
+  std::string result;
+  result.resize(std::max<std::size_t>(file.GetSize(), kMinReadSize));
+  std::size_t total = 0;
+  while (true) {
+    total += file.ReadFull(result.data() + total, result.size() - total, total);
+    if (total < result.size()) break;
+    // The file has grown since GetSize
+    result.resize(result.size() * 2);
+  }
+  result.resize(total);
+
+  std::move(file).Close();
+  return result;
+}
+
+void RewriteFileContents(Uring& uring, const std::string& path,
+                         std::string_view contents) {
+  auto file = AsyncFile::Open(&uring, path, O_WRONLY | O_CREAT | O_TRUNC);
+  file.WriteFull(contents, 0);
+  file.FSync();
+  std::move(file).Close();
+}
+
+}  // namespace fs::impl
+
+USERVER_NAMESPACE_END
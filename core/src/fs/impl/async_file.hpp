@@ -0,0 +1,90 @@
+#pragma once
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <fs/impl/uring.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fs::impl {
+
+/// Alignment of the memory, offsets and sizes for O_DIRECT
+inline constexpr std::size_t kDirectIoAlignment = 4096;
+
+/// @brief A file with the I/O on io_uring, or on the blocking syscalls if
+/// io_uring is not available.
+///
+/// `Read` and `Write` only start the operation with io_uring, with the
+/// blocking syscalls the returned operation is already completed.
+/// @note Not thread-safe
+class AsyncFile final {
+ public:
+  /// @brief Opens the file, falls back to the buffered I/O if O_DIRECT is
+  /// requested but is not supported by the filesystem
+  /// @param uring io_uring or nullptr for the blocking syscalls
+  /// @throws std::system_error
+  static AsyncFile Open(Uring* uring, const std::string& path, int flags,
+                        ::mode_t mode = 0600);
+
+  AsyncFile(AsyncFile&& other) noexcept;
+  AsyncFile& operator=(AsyncFile&&) = delete;
+
+  /// Closes the file with a blocking ::close if Close was not called
+  ~AsyncFile();
+
+  bool IsAsync() const noexcept { return uring_ != nullptr; }
+
+  bool IsDirectIo() const noexcept { return is_direct_io_; }
+
+  /// @brief Switches the file to the buffered I/O, e.g. to write an unaligned
+  /// tail of the data
+  /// @throws std::system_error
+  void DisableDirectIo();
+
+  PendingIo Read(void* buffer, std::size_t size, std::uint64_t offset);
+  PendingIo Write(const void* buffer, std::size_t size, std::uint64_t offset);
+  PendingIo WriteV(const ::iovec* iov, std::size_t count,
+                   std::uint64_t offset);
+
+  /// @brief Reads until `size` bytes are read or the end of the file
+  /// @returns the amount of bytes read
+  /// @throws std::system_error
+  std::size_t ReadFull(void* buffer, std::size_t size, std::uint64_t offset);
+
+  /// @brief Writes the whole `data`, continuing after the short writes
+  /// @throws std::system_error
+  void WriteFull(std::string_view data, std::uint64_t offset);
+
+  /// @throws std::system_error
+  std::uint64_t GetSize() const;
+
+  /// @throws std::system_error
+  void FSync();
+
+  /// @throws std::system_error
+  void Close() &&;
+
+ private:
+  AsyncFile(Uring* uring, int fd, bool is_direct_io) noexcept;
+
+  Uring* uring_;
+  int fd_;
+  bool is_direct_io_;
+};
+
+/// Same as fs::blocking::ReadFileContents, but on io_uring
+std::string ReadFileContents(Uring& uring, const std::string& path);
+
+/// Same as fs::blocking::RewriteFileContents, but on io_uring
+void RewriteFileContents(Uring& uring, const std::string& path,
+                         std::string_view contents);
+
+}  // namespace fs::impl
+
+USERVER_NAMESPACE_END
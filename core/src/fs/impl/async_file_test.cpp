@@ -0,0 +1,152 @@
+#include <fs/impl/async_file.hpp>
+
+#include <fcntl.h>
+
+#include <array>
+#include <system_error>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// io_uring may be forbidden in the test environment
+std::vector<fs::impl::Uring*> GetBackends() {
+  std::vector<fs::impl::Uring*> backends{nullptr};
+  if (auto* uring = fs::impl::GetUring()) backends.push_back(uring);
+  return backends;
+}
+
+}  // namespace
+
+UTEST(AsyncFile, WriteRead) {
+  for (auto* uring : GetBackends()) {
+    const auto file = fs::blocking::TempFile::Create();
+    auto async_file =
+        fs::impl::AsyncFile::Open(uring, file.GetPath(), O_RDWR | O_TRUNC);
+    EXPECT_EQ(async_file.IsAsync(), uring != nullptr);
+
+    const std::string data(100000, 'a');
+    async_file.WriteFull(data, 0);
+    std::array<std::string, 2> parts{"hello", "world"};
+    std::array<::iovec, 2> iov{
+        ::iovec{parts[0].data(), parts[0].size()},
+        ::iovec{parts[1].data(), parts[1].size()},
+    };
+    EXPECT_EQ(async_file.WriteV(iov.data(), iov.size(), data.size()).Wait(),
+              10);
+    async_file.FSync();
+    EXPECT_EQ(async_file.GetSize(), data.size() + 10);
+
+    std::string result(data.size() * 2, '\0');
+    EXPECT_EQ(async_file.ReadFull(result.data(), result.size(), 0),
+              data.size() + 10);
+    result.resize(data.size() + 10);
+    EXPECT_EQ(result, data + "helloworld");
+
+    std::move(async_file).Close();
+    EXPECT_EQ(fs::blocking::ReadFileContents(file.GetPath()), result);
+  }
+}
+
+UTEST(AsyncFile, Errors) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  for (auto* uring : GetBackends()) {
+    UEXPECT_THROW_MSG(
+        fs::impl::AsyncFile::Open(uring, dir.GetPath() + "/missing", O_RDONLY),
+        std::system_error, "/missing");
+
+    auto async_file =
+        fs::impl::AsyncFile::Open(uring, dir.GetPath(), O_RDONLY);
+    char buffer[16];
+    UEXPECT_THROW(async_file.Read(buffer, sizeof(buffer), 0).Wait(),
+                  std::system_error);
+  }
+}
+
+UTEST(AsyncFile, ConcurrentWrites) {
+  auto* uring = fs::impl::GetUring();
+  if (!uring) GTEST_SKIP() << "io_uring is not available";
+
+  constexpr std::size_t kTasks = 8;
+  constexpr std::size_t kChunks = 1000;
+  constexpr std::size_t kChunkSize = 100;
+
+  const auto file = fs::blocking::TempFile::Create();
+  auto async_file = fs::impl::AsyncFile::Open(uring, file.GetPath(), O_WRONLY);
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t task = 0; task < kTasks; ++task) {
+    tasks.push_back(engine::AsyncNoSpan([&, task] {
+      const std::string chunk(kChunkSize, static_cast<char>('a' + task));
+      // Many operations in flight
+      std::vector<fs::impl::PendingIo> writes;
+      for (std::size_t i = 0; i < kChunks; ++i) {
+        writes.push_back(async_file.Write(
+            chunk.data(), chunk.size(), (task * kChunks + i) * kChunkSize));
+      }
+      for (auto& write : writes) EXPECT_EQ(write.Wait(), kChunkSize);
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+  std::move(async_file).Close();
+
+  std::string expected;
+  for (std::size_t task = 0; task < kTasks; ++task) {
+    expected += std::string(kChunks * kChunkSize, 'a' + task);
+  }
+  EXPECT_EQ(fs::blocking::ReadFileContents(file.GetPath()), expected);
+}
+
+UTEST(AsyncFile, CancelledTaskWaitsForTheIo) {
+  auto* uring = fs::impl::GetUring();
+  if (!uring) GTEST_SKIP() << "io_uring is not available";
+
+  const auto file = fs::blocking::TempFile::Create();
+  const std::string data(1 << 20, 'a');
+
+  engine::SingleConsumerEvent started;
+  auto task = engine::AsyncNoSpan([&] {
+    auto async_file =
+        fs::impl::AsyncFile::Open(uring, file.GetPath(), O_WRONLY);
+    started.Send();
+    while (!engine::current_task::ShouldCancel()) engine::Yield();
+
+    async_file.WriteFull(data, 0);
+    std::move(async_file).Close();
+  });
+  ASSERT_TRUE(started.WaitForEvent());
+  task.RequestCancel();
+  UEXPECT_NO_THROW(task.Get());
+
+  EXPECT_EQ(fs::blocking::ReadFileContents(file.GetPath()), data);
+}
+
+UTEST(AsyncFile, ReadRewriteContents) {
+  auto* uring = fs::impl::GetUring();
+  if (!uring) GTEST_SKIP() << "io_uring is not available";
+
+  const auto file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(file.GetPath(), "old long text");
+
+  fs::impl::RewriteFileContents(*uring, file.GetPath(), "new text");
+  EXPECT_EQ(fs::impl::ReadFileContents(*uring, file.GetPath()), "new text");
+
+  const std::string large(100000, 'a');
+  fs::impl::RewriteFileContents(*uring, file.GetPath(), large);
+  EXPECT_EQ(fs::impl::ReadFileContents(*uring, file.GetPath()), large);
+
+  EXPECT_FALSE(fs::impl::ReadFileContents(*uring, "/proc/self/stat").empty());
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,449 @@
+#include <fs/impl/uring.hpp>
+
+#include <fcntl.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <engine/task/task_context.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/thread_name.hpp>
+
+// Goes last, as <linux/fs.h> defines macros like BLOCK_SIZE that break
+// the other headers
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define USERVER_FS_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fs::impl {
+
+namespace {
+
+constexpr unsigned kDefaultEntries = 256;
+
+// io_uring takes 32-bit lengths, longer operations are reported as short ones
+constexpr std::size_t kMaxIoSize = 1 << 30;
+
+// Promises are never at the null address
+constexpr std::uint64_t kStopUserData = 0;
+
+using IoPromise = engine::Promise<std::int32_t>;
+
+}  // namespace
+
+PendingIo::PendingIo(std::size_t result) noexcept : result_(result) {}
+
+PendingIo::PendingIo(engine::Future<std::int32_t>&& future,
+                     const char* operation)
+    : future_(std::move(future)), operation_(operation) {}
+
+PendingIo::~PendingIo() {
+  if (!future_.valid()) return;
+  try {
+    Wait();
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Unwaited file operation has failed: " << ex;
+  }
+}
+
+std::size_t PendingIo::Wait() {
+  if (result_) return *result_;
+  UASSERT_MSG(future_.valid(), "The failed operation has already been waited");
+
+  std::int32_t result = 0;
+  {
+    engine::TaskCancellationBlocker block_cancel;
+    result = future_.get();
+  }
+
+  if (result < 0) {
+    throw std::system_error(std::error_code(-result, std::system_category()),
+                            fmt::format("Error while {}", operation_));
+  }
+  result_ = result;
+  return *result_;
+}
+
+#ifdef USERVER_FS_HAS_IO_URING
+
+namespace {
+
+int SyscallSetup(unsigned entries, io_uring_params& params) {
+  return ::syscall(__NR_io_uring_setup, entries, &params);
+}
+
+int SyscallEnter(int fd, unsigned to_submit, unsigned min_complete,
+                 unsigned flags) {
+  return ::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags,
+                   nullptr, 0);
+}
+
+int SyscallRegister(int fd, unsigned opcode, void* arg, unsigned nr_args) {
+  return ::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+constexpr std::array kRequiredOps{
+    IORING_OP_NOP,   IORING_OP_READ,   IORING_OP_WRITE,
+    IORING_OP_READV, IORING_OP_WRITEV, IORING_OP_FSYNC,
+    IORING_OP_OPENAT, IORING_OP_CLOSE,
+};
+
+bool AreRequiredOpsSupported(int fd) {
+  constexpr unsigned kMaxOps = 256;
+  std::vector<char> storage(sizeof(io_uring_probe) +
+                            kMaxOps * sizeof(io_uring_probe_op));
+  auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+  if (SyscallRegister(fd, IORING_REGISTER_PROBE, probe, kMaxOps) < 0) {
+    return false;
+  }
+
+  return std::all_of(kRequiredOps.begin(), kRequiredOps.end(), [probe](int op) {
+    return op < probe->ops_len &&
+           (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+  });
+}
+
+}  // namespace
+
+struct Uring::Ring {
+  Ring() = default;
+  Ring(const Ring&) = delete;
+  Ring(Ring&&) = delete;
+
+  ~Ring() {
+    if (sqes != MAP_FAILED) ::munmap(sqes, sqes_size);
+    if (rings != MAP_FAILED) ::munmap(rings, rings_size);
+    if (fd != -1) ::close(fd);
+  }
+
+  template <typename T>
+  T* At(std::uint32_t offset) const {
+    return reinterpret_cast<T*>(static_cast<char*>(rings) + offset);
+  }
+
+  // @returns false if the kernel is busy, e.g. the completion queue has
+  // overflown
+  bool Push(const io_uring_sqe& entry, const char* operation) {
+    // The kernel consumes the entry right in io_uring_enter, so the
+    // submission queue is always empty when the mutex is not held. The mutex
+    // is a coroutine one, the other submitters sleep instead of blocking
+    // the task processor threads while the syscall is in progress.
+    std::lock_guard lock{submit_mutex};
+    return PushUnlocked(entry, operation);
+  }
+
+  // Must be called with `submit_mutex` held, or when there are no other
+  // submitters
+  bool PushUnlocked(const io_uring_sqe& entry, const char* operation) {
+    const unsigned tail = *sq_tail;
+    const unsigned index = tail & sq_mask;
+    static_cast<io_uring_sqe*>(sqes)[index] = entry;
+    sq_array[index] = index;
+    __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    int submitted = 0;
+    do {
+      submitted = SyscallEnter(fd, 1, 0, 0);
+    } while (submitted < 0 && errno == EINTR);
+    if (submitted == 1) return true;
+
+    const auto code = submitted < 0 ? errno : EAGAIN;
+    // The kernel has not seen the entry, take it back
+    __atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+    if (code == EBUSY || code == EAGAIN) return false;
+
+    throw std::system_error(
+        std::error_code(code, std::system_category()),
+        fmt::format("Error while submitting io_uring {}", operation));
+  }
+
+  int fd{-1};
+  void* rings{MAP_FAILED};
+  std::size_t rings_size{0};
+  void* sqes{MAP_FAILED};
+  std::size_t sqes_size{0};
+
+  unsigned* sq_tail{nullptr};
+  unsigned sq_mask{0};
+  unsigned* sq_array{nullptr};
+
+  unsigned* cq_head{nullptr};
+  unsigned* cq_tail{nullptr};
+  unsigned cq_mask{0};
+  unsigned cq_entries{0};
+  io_uring_cqe* cqes{nullptr};
+
+  engine::Mutex submit_mutex;
+};
+
+std::unique_ptr<Uring> Uring::Create(unsigned entries) {
+  io_uring_params params{};
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = entries * 2;
+
+  auto ring = std::make_unique<Ring>();
+  ring->fd = SyscallSetup(entries, params);
+  if (ring->fd < 0) {
+    const auto code = errno;
+    LOG_INFO() << "io_uring is not available: "
+               << std::error_code(code, std::system_category()).message();
+    return nullptr;
+  }
+
+  constexpr auto kRequiredFeatures =
+      IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP;
+  if ((params.features & kRequiredFeatures) != kRequiredFeatures ||
+      !AreRequiredOpsSupported(ring->fd)) {
+    LOG_INFO() << "io_uring is not available: the kernel is too old";
+    return nullptr;
+  }
+
+  ring->rings_size =
+      std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+               params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+  ring->rings = ::mmap(nullptr, ring->rings_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+  ring->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+  ring->sqes = ::mmap(nullptr, ring->sqes_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+  if (ring->rings == MAP_FAILED || ring->sqes == MAP_FAILED) {
+    const auto code = errno;
+    LOG_WARNING() << "Failed to map the io_uring: "
+                  << std::error_code(code, std::system_category()).message();
+    return nullptr;
+  }
+
+  ring->sq_tail = ring->At<unsigned>(params.sq_off.tail);
+  ring->sq_mask = *ring->At<unsigned>(params.sq_off.ring_mask);
+  ring->sq_array = ring->At<unsigned>(params.sq_off.array);
+  ring->cq_head = ring->At<unsigned>(params.cq_off.head);
+  ring->cq_tail = ring->At<unsigned>(params.cq_off.tail);
+  ring->cq_mask = *ring->At<unsigned>(params.cq_off.ring_mask);
+  ring->cq_entries = params.cq_entries;
+  ring->cqes = ring->At<io_uring_cqe>(params.cq_off.cqes);
+
+  return std::unique_ptr<Uring>(new Uring(std::move(ring)));
+}
+
+Uring::Uring(std::unique_ptr<Ring> ring)
+    : ring_(std::move(ring)) {
+  reaper_ = std::thread([this] { ReapCompletions(); });
+}
+
+Uring::~Uring() {
+  io_uring_sqe stop{};
+  stop.opcode = IORING_OP_NOP;
+  stop.user_data = kStopUserData;
+
+  try {
+    // Destroyed outside of coroutines after all the submitters are gone
+    while (!ring_->PushUnlocked(stop, "stop")) std::this_thread::yield();
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to stop the io_uring reaper thread: " << ex;
+    reaper_.detach();
+    return;
+  }
+  reaper_.join();
+}
+
+template <typename PrepareFunc>
+PendingIo Uring::Submit(const char* operation, PrepareFunc prepare) {
+  auto promise = std::make_unique<IoPromise>();
+  auto future = promise->get_future();
+
+  io_uring_sqe entry{};
+  prepare(entry);
+  entry.user_data = reinterpret_cast<std::uint64_t>(promise.get());
+  while (!ring_->Push(entry, operation)) {
+    // The completion queue has overflown, let the reaper catch up
+    engine::Yield();
+  }
+
+  // Owned by the reaper thread from now on
+  [[maybe_unused]] auto* released_promise = promise.release();
+  return PendingIo{std::move(future), operation};
+}
+
+void Uring::ReapCompletions() {
+  utils::SetCurrentThreadName("io-uring");
+
+  struct Completion {
+    std::uint64_t user_data;
+    std::int32_t result;
+  };
+  std::vector<Completion> completions;
+  completions.reserve(ring_->cq_entries);
+
+  bool is_stopped = false;
+  while (!is_stopped) {
+    unsigned head = *ring_->cq_head;
+    const unsigned tail = __atomic_load_n(ring_->cq_tail, __ATOMIC_ACQUIRE);
+    if (head == tail) {
+      if (SyscallEnter(ring_->fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 &&
+          errno != EINTR) {
+        const auto code = errno;
+        LOG_ERROR() << "Error while waiting for io_uring completions: "
+                    << std::error_code(code, std::system_category()).message();
+      }
+      continue;
+    }
+
+    // Frees the completion queue before waking up the submitters, so that
+    // the resubmitted operations always fit into it
+    completions.clear();
+    for (; head != tail; ++head) {
+      const auto& cqe = ring_->cqes[head & ring_->cq_mask];
+      completions.push_back({cqe.user_data, cqe.res});
+    }
+    __atomic_store_n(ring_->cq_head, head, __ATOMIC_RELEASE);
+
+    for (const auto& completion : completions) {
+      if (completion.user_data == kStopUserData) {
+        is_stopped = true;
+        continue;
+      }
+      std::unique_ptr<IoPromise> promise{
+          reinterpret_cast<IoPromise*>(completion.user_data)};
+      promise->set_value(completion.result);
+    }
+  }
+}
+
+PendingIo Uring::Read(int fd, void* buffer, std::size_t size,
+                      std::uint64_t offset) {
+  return Submit("reading a file", [&](io_uring_sqe& sqe) {
+    sqe.opcode = IORING_OP_READ;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<std::uint64_t>(buffer);
+    sqe.len = std::min(size, kMaxIoSize);
+    sqe.off = offset;
+  });
+}
+
+PendingIo Uring::Write(int fd, const void* buffer, std::size_t size,
+                       std::uint64_t offset) {
+  return Submit("writing a file", [&](io_uring_sqe& sqe) {
+    sqe.opcode = IORING_OP_WRITE;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<std::uint64_t>(buffer);
+    sqe.len = std::min(size, kMaxIoSize);
+    sqe.off = offset;
+  });
+}
+
+PendingIo Uring::ReadV(int fd, const ::iovec* iov, std::size_t count,
+                       std::uint64_t offset) {
+  UASSERT(count <= IOV_MAX);
+  return Submit("reading a file", [&](io_uring_sqe& sqe) {
+    sqe.opcode = IORING_OP_READV;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<std::uint64_t>(iov);
+    sqe.len = count;
+    sqe.off = offset;
+  });
+}
+
+PendingIo Uring::WriteV(int fd, const ::iovec* iov, std::size_t count,
+                        std::uint64_t offset) {
+  UASSERT(count <= IOV_MAX);
+  return Submit("writing a file", [&](io_uring_sqe& sqe) {
+    sqe.opcode = IORING_OP_WRITEV;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<std::uint64_t>(iov);
+    sqe.len = count;
+    sqe.off = offset;
+  });
+}
+
+PendingIo Uring::FSync(int fd) {
+  return Submit("calling fsync", [&](io_uring_sqe& sqe) {
+    sqe.opcode = IORING_OP_FSYNC;
+    sqe.fd = fd;
+  });
+}
+
+PendingIo Uring::Open(const char* path, int flags, ::mode_t mode) {
+  return Submit("opening a file", [&](io_uring_sqe& sqe) {
+    sqe.opcode = IORING_OP_OPENAT;
+    sqe.fd = AT_FDCWD;
+    sqe.addr = reinterpret_cast<std::uint64_t>(path);
+    sqe.len = mode;
+    sqe.open_flags = flags;
+  });
+}
+
+PendingIo Uring::Close(int fd) {
+  return Submit("closing a file", [&](io_uring_sqe& sqe) {
+    sqe.opcode = IORING_OP_CLOSE;
+    sqe.fd = fd;
+  });
+}
+
+#else
+
+namespace {
+
+[[noreturn]] void ThrowNotAvailable() {
+  throw std::logic_error("io_uring is not available on this platform");
+}
+
+}  // namespace
+
+struct Uring::Ring {};
+
+std::unique_ptr<Uring> Uring::Create(unsigned /*entries*/) { return nullptr; }
+
+Uring::~Uring() = default;
+
+PendingIo Uring::Read(int, void*, std::size_t, std::uint64_t) {
+  ThrowNotAvailable();
+}
+
+PendingIo Uring::Write(int, const void*, std::size_t, std::uint64_t) {
+  ThrowNotAvailable();
+}
+
+PendingIo Uring::ReadV(int, const ::iovec*, std::size_t, std::uint64_t) {
+  ThrowNotAvailable();
+}
+
+PendingIo Uring::WriteV(int, const ::iovec*, std::size_t, std::uint64_t) {
+  ThrowNotAvailable();
+}
+
+PendingIo Uring::FSync(int) { ThrowNotAvailable(); }
+
+PendingIo Uring::Open(const char*, int, ::mode_t) { ThrowNotAvailable(); }
+
+PendingIo Uring::Close(int) { ThrowNotAvailable(); }
+
+#endif
+
+Uring* GetUring() {
+  if (!engine::current_task::GetCurrentTaskContextUnchecked()) return nullptr;
+
+  static const auto uring = Uring::Create(kDefaultEntries);
+  return uring.get();
+}
+
+}  // namespace fs::impl
+
+USERVER_NAMESPACE_END
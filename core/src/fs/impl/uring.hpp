@@ -0,0 +1,97 @@
+#pragma once
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+
+#include <userver/engine/future.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fs::impl {
+
+/// @brief Result of a file operation that may still be in progress.
+///
+/// The memory passed to the operation must stay valid until the operation is
+/// waited for, that's why the destructor waits for it as well.
+class PendingIo final {
+ public:
+  /// An already completed operation, e.g. a blocking syscall
+  explicit PendingIo(std::size_t result) noexcept;
+
+  PendingIo(PendingIo&&) noexcept = default;
+  PendingIo& operator=(PendingIo&&) = delete;
+  ~PendingIo();
+
+  /// @brief Waits for the operation, ignoring the task cancellation as the
+  /// kernel may still be using the buffers
+  /// @returns the non-negative result of the operation
+  /// @throws std::system_error if the operation has failed
+  std::size_t Wait();
+
+ private:
+  friend class Uring;
+
+  PendingIo(engine::Future<std::int32_t>&& future, const char* operation);
+
+  engine::Future<std::int32_t> future_;
+  const char* operation_{nullptr};
+  std::optional<std::size_t> result_;
+};
+
+/// @brief io_uring for the file I/O from coroutines.
+///
+/// The calling coroutine submits an operation and sleeps on a future. The
+/// completions are reaped by a dedicated thread that wakes the coroutines up,
+/// so no task processor thread is blocked for the duration of the I/O.
+///
+/// Thread-safe. Operations may only be submitted from coroutines.
+class Uring final {
+ public:
+  /// @returns nullptr if io_uring is not supported by the kernel or is
+  /// forbidden, e.g. by seccomp
+  static std::unique_ptr<Uring> Create(unsigned entries);
+
+  Uring(const Uring&) = delete;
+  Uring(Uring&&) = delete;
+  ~Uring();
+
+  PendingIo Read(int fd, void* buffer, std::size_t size, std::uint64_t offset);
+  PendingIo Write(int fd, const void* buffer, std::size_t size,
+                  std::uint64_t offset);
+  PendingIo ReadV(int fd, const ::iovec* iov, std::size_t count,
+                  std::uint64_t offset);
+  PendingIo WriteV(int fd, const ::iovec* iov, std::size_t count,
+                   std::uint64_t offset);
+  PendingIo FSync(int fd);
+
+  /// The result of the operation is the opened file descriptor
+  PendingIo Open(const char* path, int flags, ::mode_t mode);
+  PendingIo Close(int fd);
+
+ private:
+  struct Ring;
+
+  explicit Uring(std::unique_ptr<Ring> ring);
+
+  template <typename PrepareFunc>
+  PendingIo Submit(const char* operation, PrepareFunc prepare);
+
+  void ReapCompletions();
+
+  const std::unique_ptr<Ring> ring_;
+  std::thread reaper_;
+};
+
+/// @returns the process-wide io_uring, or nullptr if io_uring is not available
+/// or the caller is not a coroutine
+Uring* GetUring();
+
+}  // namespace fs::impl
+
+USERVER_NAMESPACE_END
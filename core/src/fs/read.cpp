@@ -1,5 +1,6 @@
 #include <userver/fs/read.hpp>
 
+#include <fs/impl/async_file.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/fs/blocking/read.hpp>
 
@@ -25,6 +26,9 @@ std::string GetRelative(std::string_view path, std::string_view dir) {
 
 std::string ReadFileContents(engine::TaskProcessor& async_tp,
                              const std::string& path) {
+  if (auto* uring = impl::GetUring()) {
+    return impl::ReadFileContents(*uring, path);
+  }
   return engine::AsyncNoSpan(async_tp, &fs::blocking::ReadFileContents, path)
       .Get();
 }
@@ -2,6 +2,7 @@
 
 #include <fmt/format.h>
 
+#include <fs/impl/async_file.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/fs/blocking/write.hpp>
 #include <userver/utils/boost_uuid4.hpp>
@@ -25,6 +26,10 @@ void CreateDirectories(engine::TaskProcessor& async_tp, std::string_view path) {
 
 void RewriteFileContents(engine::TaskProcessor& async_tp,
                          const std::string& path, std::string_view contents) {
+  if (auto* uring = impl::GetUring()) {
+    impl::RewriteFileContents(*uring, path, contents);
+    return;
+  }
   engine::AsyncNoSpan(async_tp, &fs::blocking::RewriteFileContents, path,
                       contents)
       .Get();
@@ -51,10 +56,13 @@ void RewriteFileContentsAtomically(engine::TaskProcessor& async_tp,
                                    const std::string& path,
                                    std::string_view contents,
                                    boost::filesystem::perms perms) {
+  auto tmp_path =
+      fmt::format("{}{}.tmp", path, utils::generators::GenerateBoostUuid());
+  auto* uring = impl::GetUring();
+  if (uring) impl::RewriteFileContents(*uring, tmp_path, contents);
+
   engine::AsyncNoSpan(async_tp, [&]() {
-    auto tmp_path =
-        fmt::format("{}{}.tmp", path, utils::generators::GenerateBoostUuid());
-    fs::blocking::RewriteFileContents(tmp_path, contents);
+    if (!uring) fs::blocking::RewriteFileContents(tmp_path, contents);
 
     boost::filesystem::path file_path(path);
     auto directory_path = file_path.parent_path();
@@ -0,0 +1,264 @@
+#include <logging/async_logger.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+#include <spdlog/sinks/sink.h>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/thread_name.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+namespace {
+
+constexpr std::size_t kMaxQueues = 64;
+constexpr std::size_t kMinQueueSize = 64;
+// Bounds the flush delay under a constant load
+constexpr std::size_t kMaxBatchSize = 4096;
+// Safety net for the wakeup races, the writer is woken up explicitly
+constexpr std::chrono::milliseconds kMaxWriterSleep{100};
+
+std::size_t RoundDownToPowerOf2(std::size_t value) {
+  std::size_t result = 1;
+  while (result * 2 <= value) result *= 2;
+  return result;
+}
+
+std::size_t GetThreadIndex() {
+  static std::atomic<std::size_t> next_index{0};
+  // Not cached across suspension points, the callers never suspend
+  thread_local const std::size_t index = next_index++;
+  return index;
+}
+
+}  // namespace
+
+// Bounded MPMC ring (D. Vyukov's algorithm), records keep their string
+// capacity between uses, so a warmed up queue does not allocate. The writer
+// pops the records, the producers pop the oldest ones on overflow.
+class AsyncLogger::RecordQueue final {
+ public:
+  struct Record {
+    spdlog::level::level_enum level{spdlog::level::off};
+    spdlog::log_clock::time_point time;
+    std::size_t thread_id{0};
+    std::string text;
+  };
+
+  explicit RecordQueue(std::size_t size)
+      : cells_(std::make_unique<Cell[]>(size)), mask_(size - 1) {
+    UASSERT(size && !(size & mask_));
+    for (std::size_t i = 0; i < size; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  bool TryPush(const spdlog::details::log_msg& msg) {
+    auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      const auto sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::intptr_t>(sequence) -
+                        static_cast<std::intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+
+    auto& record = cell->record;
+    record.level = msg.level;
+    record.time = msg.time;
+    record.thread_id = msg.thread_id;
+    record.text.assign(msg.payload.data(), msg.payload.size());
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <typename Func>
+  bool TryPop(Func& func) {
+    auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      const auto sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::intptr_t>(sequence) -
+                        static_cast<std::intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+
+    func(cell->record);
+    cell->record.text.clear();
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool IsEmpty() const {
+    const auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+    const auto& cell = cells_[pos & mask_];
+    return cell.sequence.load(std::memory_order_acquire) != pos + 1;
+  }
+
+  std::size_t GetPushed() const { return enqueue_pos_.load(); }
+
+ private:
+  struct Cell {
+    std::atomic<std::size_t> sequence{0};
+    Record record;
+  };
+
+  const std::unique_ptr<Cell[]> cells_;
+  const std::size_t mask_;
+  alignas(64) std::atomic<std::size_t> enqueue_pos_{0};
+  alignas(64) std::atomic<std::size_t> dequeue_pos_{0};
+};
+
+AsyncLogger::AsyncLogger(std::string name, spdlog::sink_ptr sink,
+                         std::size_t queue_size,
+                         OverflowBehavior overflow_behavior)
+    : spdlog::logger(std::move(name), std::move(sink)),
+      overflow_behavior_(overflow_behavior) {
+  const auto queues_count = RoundDownToPowerOf2(std::clamp<std::size_t>(
+      std::thread::hardware_concurrency(), 1, kMaxQueues));
+  const auto per_queue_size = std::max(
+      RoundDownToPowerOf2(queue_size / queues_count), kMinQueueSize);
+  queues_.reserve(queues_count);
+  for (std::size_t i = 0; i < queues_count; ++i) {
+    queues_.push_back(std::make_unique<RecordQueue>(per_queue_size));
+  }
+
+  writer_ = std::thread([this] {
+    utils::SetCurrentThreadName("log/" + name_);
+    Run();
+  });
+}
+
+AsyncLogger::~AsyncLogger() {
+  is_stopping_ = true;
+  WakeUpWriter();
+  writer_.join();
+}
+
+AsyncLoggerStats AsyncLogger::GetStatistics() const {
+  AsyncLoggerStats stats;
+  stats.dropped = dropped_.load();
+  for (const auto& queue : queues_) stats.total += queue->GetPushed();
+  return stats;
+}
+
+void AsyncLogger::sink_it_(const spdlog::details::log_msg& msg) {
+  auto& queue = GetQueue();
+  while (!queue.TryPush(msg)) {
+    if (overflow_behavior_ == OverflowBehavior::kDiscard) {
+      // Overwrites the oldest record, the same way spdlog's overrun_oldest
+      // policy does
+      auto discard = [](const RecordQueue::Record&) {};
+      if (queue.TryPop(discard)) ++dropped_;
+      continue;
+    }
+    WakeUpWriter();
+    std::this_thread::yield();
+  }
+
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (is_writer_sleeping_.load(std::memory_order_relaxed)) WakeUpWriter();
+}
+
+void AsyncLogger::flush_() {
+  // Does not wait for the writer, the same way spdlog::async_logger does
+  is_flush_requested_ = true;
+  WakeUpWriter();
+}
+
+AsyncLogger::RecordQueue& AsyncLogger::GetQueue() const {
+  return *queues_[GetThreadIndex() & (queues_.size() - 1)];
+}
+
+void AsyncLogger::WakeUpWriter() {
+  {
+    std::lock_guard lock(mutex_);
+    is_writer_sleeping_ = false;
+  }
+  cv_.notify_one();
+}
+
+void AsyncLogger::Run() {
+  while (true) {
+    const bool is_stopping = is_stopping_.load();
+    const bool has_written = Drain();
+    if (is_flush_requested_.exchange(false)) spdlog::logger::flush_();
+    if (has_written) continue;
+    if (is_stopping) break;
+
+    std::unique_lock lock(mutex_);
+    is_writer_sleeping_ = true;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (IsEmpty() && !is_flush_requested_ && !is_stopping_) {
+      cv_.wait_for(lock, kMaxWriterSleep,
+                   [this] { return !is_writer_sleeping_.load(); });
+    }
+    is_writer_sleeping_ = false;
+  }
+  spdlog::logger::flush_();
+}
+
+bool AsyncLogger::Drain() {
+  std::size_t written = 0;
+  bool should_flush = false;
+  auto write = [this, &written,
+                &should_flush](const RecordQueue::Record& record) {
+    ++written;
+    spdlog::details::log_msg msg(record.time, {}, name_, record.level,
+                                 record.text);
+    msg.thread_id = record.thread_id;
+    for (auto& sink : sinks_) {
+      if (!sink->should_log(msg.level)) continue;
+      try {
+        sink->log(msg);
+      } catch (const std::exception& e) {
+        err_handler_(e.what());
+      }
+    }
+    should_flush = should_flush || should_flush_(msg);
+  };
+
+  // Takes turns between the queues to keep the latencies fair
+  for (bool has_popped = true; has_popped && written < kMaxBatchSize;) {
+    has_popped = false;
+    for (auto& queue : queues_) {
+      has_popped = queue->TryPop(write) || has_popped;
+    }
+  }
+
+  // Once per batch instead of once per record
+  if (should_flush) spdlog::logger::flush_();
+  return written != 0;
+}
+
+bool AsyncLogger::IsEmpty() const {
+  return std::all_of(queues_.begin(), queues_.end(),
+                     [](const auto& queue) { return queue->IsEmpty(); });
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
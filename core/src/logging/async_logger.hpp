@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// this header must be included before any spdlog headers
+// to override spdlog's level names
+#include <logging/spdlog.hpp>
+
+#include <spdlog/logger.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+struct AsyncLoggerStats {
+  std::size_t total{0};
+  std::size_t dropped{0};
+};
+
+/// @brief Logger that hands the records over to a dedicated writer thread.
+///
+/// Unlike spdlog::async_logger there is no shared mutex-protected queue: the
+/// records go to lock-free rings sharded by the producing thread, the writer
+/// drains them in batches and flushes the sinks once per batch. The records
+/// of a single thread are written in order.
+class AsyncLogger final : public spdlog::logger {
+ public:
+  enum class OverflowBehavior { kDiscard, kBlock };
+
+  AsyncLogger(std::string name, spdlog::sink_ptr sink, std::size_t queue_size,
+              OverflowBehavior overflow_behavior);
+  ~AsyncLogger() override;
+
+  AsyncLoggerStats GetStatistics() const;
+
+ private:
+  class RecordQueue;
+
+  void sink_it_(const spdlog::details::log_msg& msg) override;
+  void flush_() override;
+
+  RecordQueue& GetQueue() const;
+  void WakeUpWriter();
+  void Run();
+  bool Drain();
+  bool IsEmpty() const;
+
+  const OverflowBehavior overflow_behavior_;
+  std::vector<std::unique_ptr<RecordQueue>> queues_;
+  std::atomic<std::size_t> dropped_{0};
+
+  std::atomic<bool> is_flush_requested_{false};
+  std::atomic<bool> is_stopping_{false};
+  std::atomic<bool> is_writer_sleeping_{false};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread writer_;
+};
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
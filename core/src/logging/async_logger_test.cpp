@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <logging/async_logger.hpp>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spdlog/sinks/ostream_sink.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using logging::impl::AsyncLogger;
+
+std::shared_ptr<AsyncLogger> MakeLogger(
+    std::ostream& stream, std::size_t queue_size,
+    AsyncLogger::OverflowBehavior overflow_behavior) {
+  auto logger = std::make_shared<AsyncLogger>(
+      "async", std::make_shared<spdlog::sinks::ostream_sink_mt>(stream),
+      queue_size, overflow_behavior);
+  logger->set_pattern("%v");
+  return logger;
+}
+
+std::vector<std::string> GetLines(const std::ostringstream& stream) {
+  std::vector<std::string> lines;
+  std::istringstream input(stream.str());
+  for (std::string line; std::getline(input, line);) lines.push_back(line);
+  return lines;
+}
+
+}  // namespace
+
+TEST(AsyncLogger, PerThreadOrder) {
+  constexpr int kThreads = 4;
+  constexpr int kRecords = 1000;
+  std::ostringstream stream;
+
+  auto logger =
+      MakeLogger(stream, 1024, AsyncLogger::OverflowBehavior::kBlock);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&logger, i] {
+      for (int j = 0; j < kRecords; ++j) logger->info("{} {}", i, j);
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(logger->GetStatistics().total, kThreads * kRecords);
+  EXPECT_EQ(logger->GetStatistics().dropped, 0);
+  // Writes out everything on destruction
+  logger.reset();
+
+  const auto lines = GetLines(stream);
+  ASSERT_EQ(lines.size(), kThreads * kRecords);
+  std::vector<int> next_record(kThreads, 0);
+  for (const auto& line : lines) {
+    std::istringstream input(line);
+    int thread = 0;
+    int record = 0;
+    input >> thread >> record;
+    ASSERT_LT(thread, kThreads);
+    EXPECT_EQ(record, next_record[thread]++);
+  }
+}
+
+TEST(AsyncLogger, Overflow) {
+  constexpr int kRecords = 100000;
+  std::ostringstream stream;
+
+  auto logger = MakeLogger(stream, 1, AsyncLogger::OverflowBehavior::kDiscard);
+  for (int i = 0; i < kRecords; ++i) logger->info("{}", i);
+  const auto stats = logger->GetStatistics();
+  logger.reset();
+
+  EXPECT_EQ(stats.total, kRecords);
+  const auto lines = GetLines(stream);
+  EXPECT_EQ(lines.size() + stats.dropped, kRecords);
+
+  // The oldest records are overwritten, the newest one is always written
+  ASSERT_FALSE(lines.empty());
+  EXPECT_EQ(lines.back(), std::to_string(kRecords - 1));
+}
+
+USERVER_NAMESPACE_END
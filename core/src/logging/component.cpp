@@ -11,21 +11,22 @@
 
 #include <fmt/format.h>
 
-#include <spdlog/async.h>
 #include <spdlog/sinks/stdout_sinks.h>
 
+#include <logging/async_logger.hpp>
 #include <logging/logger_with_info.hpp>
 #include <logging/reopening_file_sink.hpp>
 #include <logging/spdlog_helpers.hpp>
 #include <userver/components/component.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/formats/json/value_builder.hpp>
 #include <userver/logging/format.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/logger.hpp>
 #include <userver/os_signals/component.hpp>
 #include <userver/utils/algo.hpp>
-#include <userver/utils/thread_name.hpp>
+#include <userver/utils/statistics/metadata.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 #include "config.hpp"
@@ -103,26 +104,36 @@ std::shared_ptr<logging::impl::LoggerWithInfo> CreateAsyncLogger(
     return logging::MakeStdoutLogger(logger_name, logger_config.format,
                                      logger_config.level);
 
-  auto overflow_policy = spdlog::async_overflow_policy::overrun_oldest;
+  using OverflowBehavior = logging::impl::AsyncLogger::OverflowBehavior;
+  auto overflow_behavior = OverflowBehavior::kDiscard;
   if (logger_config.queue_overflow_behavior ==
       logging::LoggerConfig::QueueOveflowBehavior::kBlock) {
-    overflow_policy = spdlog::async_overflow_policy::block;
+    overflow_behavior = OverflowBehavior::kBlock;
   }
 
   CreateLogDirectory(logger_name, logger_config.file_path);
 
   auto file_sink =
       std::make_shared<logging::ReopeningFileSinkMT>(logger_config.file_path);
-  auto tp = std::make_shared<spdlog::details::thread_pool>(
-      logger_config.message_queue_size, logger_config.thread_pool_size,
-      [thread_name = "log/" + logger_name] {
-        utils::SetCurrentThreadName(thread_name);
-      });
 
   return std::make_shared<logging::impl::LoggerWithInfo>(
-      logger_config.format, tp,
-      utils::MakeSharedRef<spdlog::async_logger>(
-          logger_name, std::move(file_sink), tp, overflow_policy));
+      logger_config.format,
+      utils::MakeSharedRef<logging::impl::AsyncLogger>(
+          logger_name, std::move(file_sink), logger_config.message_queue_size,
+          overflow_behavior));
+}
+
+formats::json::Value GetLoggerStatistics(
+    const logging::impl::LoggerWithInfo& logger) {
+  formats::json::ValueBuilder builder(formats::json::Type::kObject);
+  const auto* async_logger =
+      dynamic_cast<const logging::impl::AsyncLogger*>(&*logger.ptr);
+  if (!async_logger) return builder.ExtractValue();
+
+  const auto stats = async_logger->GetStatistics();
+  builder["total"] = stats.total;
+  builder["dropped"] = stats.dropped;
+  return builder.ExtractValue();
 }
 
 }  // namespace
@@ -294,6 +305,17 @@ void Logging::FlushLogs() {
   }
 }
 
+formats::json::Value Logging::ExtendStatistics(
+    const utils::statistics::StatisticsRequest& /*request*/) {
+  formats::json::ValueBuilder builder(formats::json::Type::kObject);
+  builder["default"] = GetLoggerStatistics(*logging::DefaultLogger());
+  for (const auto& [name, logger] : loggers_) {
+    builder[name] = GetLoggerStatistics(*logger);
+  }
+  utils::statistics::SolomonChildrenAreLabelValues(builder, "logger");
+  return builder.ExtractValue();
+}
+
 yaml_config::Schema Logging::GetStaticConfigSchema() {
   return yaml_config::MergeSchemas<impl::ComponentBase>(R"(
 type: object
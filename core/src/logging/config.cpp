@@ -52,9 +52,6 @@ LoggerConfig Parse(const yaml_config::YamlConfig& value,
       value["overflow_behavior"].As<LoggerConfig::QueueOveflowBehavior>(
           LoggerConfig::QueueOveflowBehavior::kDiscard);
 
-  config.thread_pool_size = value["thread_pool_size"].As<size_t>(
-      LoggerConfig::kDefaultThreadPoolSize);
-
   return config;
 }
 
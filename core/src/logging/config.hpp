@@ -14,7 +14,6 @@ namespace logging {
 
 struct LoggerConfig {
   static constexpr size_t kDefaultMessageQueueSize = 1 << 16;
-  static constexpr size_t kDefaultThreadPoolSize = 1;
 
   enum class QueueOveflowBehavior { kDiscard, kBlock };
 
@@ -27,8 +26,6 @@ struct LoggerConfig {
   // must be a power of 2
   size_t message_queue_size = kDefaultMessageQueueSize;
   QueueOveflowBehavior queue_overflow_behavior = QueueOveflowBehavior::kDiscard;
-
-  size_t thread_pool_size = kDefaultThreadPoolSize;
 };
 
 LoggerConfig Parse(const yaml_config::YamlConfig& value,
@@ -1,9 +1,20 @@
 #include <benchmark/benchmark.h>
 
+// this header must be included before any spdlog headers
+// to override spdlog's level names
+#include <logging/spdlog.hpp>
+
+#include <spdlog/async.h>
+
+#include <logging/async_logger.hpp>
+#include <logging/reopening_file_sink.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/logger.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <ostream>
+#include <vector>
 
 #include <utils/gbench_auxilary.hpp>
 
@@ -98,4 +109,69 @@ BENCHMARK_REGISTER_F(LogHelperBenchmark, LogStruct)
     ->Range(8, 8 << 10)
     ->Complexity();
 
+namespace {
+
+constexpr std::size_t kAsyncQueueSize = 1 << 16;
+
+spdlog::logger& GetSpdlogAsyncLogger() {
+  static const auto thread_pool =
+      std::make_shared<spdlog::details::thread_pool>(kAsyncQueueSize, 1);
+  // Posts the records with shared_from_this()
+  static const auto logger = std::make_shared<spdlog::async_logger>(
+      "spdlog_async",
+      std::make_shared<logging::ReopeningFileSinkMT>("/dev/null"),
+      thread_pool, spdlog::async_overflow_policy::block);
+  return *logger;
+}
+
+spdlog::logger& GetNativeAsyncLogger() {
+  static logging::impl::AsyncLogger logger(
+      "native_async",
+      std::make_shared<logging::ReopeningFileSinkMT>("/dev/null"),
+      kAsyncQueueSize, logging::impl::AsyncLogger::OverflowBehavior::kBlock);
+  return logger;
+}
+
+template <spdlog::logger& (*GetLogger)()>
+void LogAsync(benchmark::State& state) {
+  auto& logger = GetLogger();
+  const std::string msg(state.range(0), '*');
+  std::vector<std::chrono::steady_clock::duration> latencies;
+  latencies.reserve(1 << 20);
+
+  for (auto _ : state) {
+    const auto start = std::chrono::steady_clock::now();
+    logger.info(msg);
+    if (latencies.size() < latencies.capacity()) {
+      latencies.push_back(std::chrono::steady_clock::now() - start);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  if (latencies.empty()) return;
+  auto p99 = latencies.begin() + latencies.size() * 99 / 100;
+  std::nth_element(latencies.begin(), p99, latencies.end());
+  state.counters["p99_ns"] = benchmark::Counter(
+      std::chrono::duration<double, std::nano>(*p99).count(),
+      benchmark::Counter::kAvgThreads);
+}
+
+}  // namespace
+
+// Records/sec and the producer side p99 latency of the async pipelines
+BENCHMARK_TEMPLATE(LogAsync, GetSpdlogAsyncLogger)
+    ->Arg(128)
+    ->Arg(1024)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(LogAsync, GetNativeAsyncLogger)
+    ->Arg(128)
+    ->Arg(1024)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(16)
+    ->UseRealTime();
+
 USERVER_NAMESPACE_END
@@ -134,9 +134,37 @@ properties:
                         type: integer
                         description: timeout in seconds to drop connection if there's not data received from it
                         defaultDescription: 600
+                    http-version:
+                        type: string
+                        description: "'2' to additionally accept HTTP/2 connections with prior knowledge (h2c), '1.1' to accept only HTTP/1.1"
+                        defaultDescription: '1.1'
+                        enum:
+                          - '1.1'
+                          - '2'
+                    http2-session:
+                        type: object
+                        description: HTTP/2 session options
+                        additionalProperties: false
+                        properties:
+                            max_concurrent_streams:
+                                type: integer
+                                description: max number of concurrently processed streams (requests) of a single HTTP/2 connection
+                                defaultDescription: 100
+                            max_frame_size:
+                                type: integer
+                                description: max size of a frame payload in bytes the server is willing to receive
+                                defaultDescription: 16384
+                            initial_window_size:
+                                type: integer
+                                description: initial stream-level flow control window size in bytes
+                                defaultDescription: 65535
             shards:
                 type: integer
                 description: how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing
+            reuseport-cpu-steering:
+                type: boolean
+                description: pass a new connection to the shard number `cpu % shards`, where `cpu` is the CPU that handles the incoming packet (Linux only)
+                defaultDescription: false
     listener-monitor:
         type: object
         description: describes the special monitoring socket, used for getting statistics and processing utility requests that should succeed even is the main socket is under heavy pressure
@@ -178,6 +206,30 @@ properties:
                         type: integer
                         description: timeout in seconds to drop connection if there's not data received from it
                         defaultDescription: 600
+                    http-version:
+                        type: string
+                        description: "'2' to additionally accept HTTP/2 connections with prior knowledge (h2c), '1.1' to accept only HTTP/1.1"
+                        defaultDescription: '1.1'
+                        enum:
+                          - '1.1'
+                          - '2'
+                    http2-session:
+                        type: object
+                        description: HTTP/2 session options
+                        additionalProperties: false
+                        properties:
+                            max_concurrent_streams:
+                                type: integer
+                                description: max number of concurrently processed streams (requests) of a single HTTP/2 connection
+                                defaultDescription: 100
+                            max_frame_size:
+                                type: integer
+                                description: max size of a frame payload in bytes the server is willing to receive
+                                defaultDescription: 16384
+                            initial_window_size:
+                                type: integer
+                                description: initial stream-level flow control window size in bytes
+                                defaultDescription: 65535
             handler-defaults:
                 type: object
                 description: handler defaults options
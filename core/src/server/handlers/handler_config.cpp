@@ -12,6 +12,7 @@ namespace server::handlers {
 
 namespace {
 constexpr size_t kLogRequestDataSizeDefaultLimit = 512;
+constexpr size_t kCompressResponseDefaultMinSize = 1024;
 }
 
 UrlTrailingSlashOption Parse(const yaml_config::YamlConfig& yaml,
@@ -81,6 +82,10 @@ HandlerConfig ParseHandlerConfigsWithDefaults(
   config.max_requests_per_second =
       value["max_requests_per_second"].As<std::optional<size_t>>();
   config.decompress_request = value["decompress_request"].As<bool>(false);
+  config.compress_response = value["compress_response"].As<bool>(false);
+  config.compress_response_min_size =
+      value["compress_response_min_size"].As<size_t>(
+          kCompressResponseDefaultMinSize);
   config.throttling_enabled = value["throttling_enabled"].As<bool>(true);
   config.set_response_server_hostname =
       value["set-response-server-hostname"].As<std::optional<bool>>();
@@ -1,9 +1,12 @@
 #include <userver/server/handlers/http_handler_base.hpp>
 
+#include <algorithm>
+
 #include <fmt/format.h>
 #include <boost/algorithm/string/split.hpp>
 
-#include <compression/gzip.hpp>
+#include <compression/compressor.hpp>
+#include <compression/decompressor.hpp>
 #include <server/handlers/http_handler_base_statistics.hpp>
 #include <server/handlers/http_server_settings.hpp>
 #include <server/http/http_request_impl.hpp>
@@ -75,6 +78,23 @@ std::vector<http::HttpMethod> InitAllowedMethods(const HandlerConfig& config) {
   return allowed_methods;
 }
 
+compression::Encoding NegotiateResponseEncoding(
+    const http::HttpRequest& http_request) {
+  return compression::NegotiateEncoding(
+      http_request.GetHeader(USERVER_NAMESPACE::http::headers::kAcceptEncoding),
+      compression::GetSupportedEncodings());
+}
+
+std::string MakeAcceptEncoding() {
+  std::string result;
+  for (const auto encoding : compression::GetSupportedEncodings()) {
+    result += compression::ToString(encoding);
+    result += ", ";
+  }
+  result += compression::ToString(compression::Encoding::kIdentity);
+  return result;
+}
+
 void SetFormattedErrorResponse(http::HttpResponse& http_response,
                                FormattedErrorData&& formatted_error_data) {
   http_response.SetData(std::move(formatted_error_data.external_body));
@@ -478,8 +498,20 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
             auto& response = http_request.GetHttpResponse();
             utils::ScopeGuard scope([&response] { response.SetHeadersEnd(); });
 
+            std::unique_ptr<compression::Compressor> compressor;
+            if (GetConfig().compress_response) {
+              response.SetHeader(
+                  USERVER_NAMESPACE::http::headers::kVary,
+                  USERVER_NAMESPACE::http::headers::kAcceptEncoding);
+              const auto encoding = NegotiateResponseEncoding(http_request);
+              if (encoding != compression::Encoding::kIdentity) {
+                compressor = compression::Compressor::Create(encoding);
+              }
+            }
+
             server::http::ResponseBodyStream response_body_stream{
-                response.GetBodyProducer(), http_request.GetHttpResponse()};
+                response.GetBodyProducer(), http_request.GetHttpResponse(),
+                std::move(compressor)};
 
             // Just in case HandleStreamRequest() throws an exception.
             // Though it can be changed in HandleStreamRequest().
@@ -495,6 +527,15 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
     LOG_ERROR() << "unable to handle request: " << ex;
   }
 
+  // After the response is logged, error responses are compressed as well
+  if (GetConfig().compress_response && !response.IsBodyStreamed()) {
+    try {
+      CompressResponse(http_request, response);
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "unable to compress the response: " << ex;
+    }
+  }
+
   SetResponseAcceptEncoding(response);
   SetResponseServerHostname(response);
 }
@@ -628,13 +669,20 @@ void HttpHandlerBase::DecompressRequestBody(
     http::HttpRequest& http_request) const {
   if (!http_request.IsBodyCompressed()) return;
 
-  const auto& content_encoding = http_request.GetHeader("Content-Encoding");
+  const auto encoding = compression::ParseEncoding(http_request.GetHeader(
+      USERVER_NAMESPACE::http::headers::kContentEncoding));
+  const auto& supported = compression::GetSupportedEncodings();
 
   try {
-    if (content_encoding == "gzip") {
-      auto body = compression::gzip::Decompress(
-          http_request.RequestBody(),
-          GetConfig().request_config.max_request_size);
+    if (encoding && std::find(supported.begin(), supported.end(),
+                              *encoding) != supported.end()) {
+      // Stops as soon as the limit is exceeded instead of inflating the whole
+      // body first
+      auto decompressor = compression::Decompressor::Create(
+          *encoding, GetConfig().request_config.max_request_size);
+      std::string body;
+      decompressor->Decompress(http_request.RequestBody(), body);
+      decompressor->Finish();
       http_request.SetRequestBody(std::move(body));
       if (GetConfig().request_config.parse_args_from_body) {
         http_request.ParseArgsFromBody();
@@ -653,6 +701,30 @@ void HttpHandlerBase::DecompressRequestBody(
   throw ClientError(HandlerErrorCode::kUnsupportedMediaType);
 }
 
+void HttpHandlerBase::CompressResponse(const http::HttpRequest& http_request,
+                                       http::HttpResponse& response) const {
+  response.SetHeader(USERVER_NAMESPACE::http::headers::kVary,
+                     USERVER_NAMESPACE::http::headers::kAcceptEncoding);
+
+  if (response.GetData().size() < GetConfig().compress_response_min_size) {
+    return;
+  }
+  // The handler has encoded the body itself
+  if (response.HasHeader(USERVER_NAMESPACE::http::headers::kContentEncoding)) {
+    return;
+  }
+
+  const auto encoding = NegotiateResponseEncoding(http_request);
+  if (encoding == compression::Encoding::kIdentity) return;
+
+  auto compressed = compression::Compress(encoding, response.GetData());
+  // Incompressible data is sent as is
+  if (compressed.size() >= response.GetData().size()) return;
+
+  response.SetData(std::move(compressed));
+  response.SetContentEncoding(std::string{compression::ToString(encoding)});
+}
+
 std::string HttpHandlerBase::GetRequestBodyForLogging(
     const http::HttpRequest&, request::RequestContext&,
     const std::string& request_body) const {
@@ -741,8 +813,9 @@ void HttpHandlerBase::SetResponseAcceptEncoding(
   }
 
   if (!response.HasHeader(USERVER_NAMESPACE::http::headers::kAcceptEncoding)) {
+    static const auto kAcceptEncoding = MakeAcceptEncoding();
     response.SetHeader(USERVER_NAMESPACE::http::headers::kAcceptEncoding,
-                       "gzip, identity");
+                       kAcceptEncoding);
   }
 }
 
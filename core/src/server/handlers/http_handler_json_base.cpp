@@ -1,7 +1,9 @@
 #include <userver/server/handlers/http_handler_json_base.hpp>
 
+#include <userver/components/component_config.hpp>
 #include <userver/formats/json/exception.hpp>
 #include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/string_builder.hpp>
 #include <userver/http/content_type.hpp>
 #include <userver/tracing/span.hpp>
 
@@ -10,7 +12,7 @@
 #include <userver/server/handlers/legacy_json_error_builder.hpp>
 #include <userver/server/http/http_error.hpp>
 #include <userver/server/http/http_status.hpp>
-#include <userver/yaml_config/schema.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -19,32 +21,65 @@ namespace server::handlers {
 namespace {
 
 const std::string kRequestDataName = "__request_json";
+const std::string kRequestOnDemandDataName = "__request_json_on_demand";
 const std::string kResponseDataName = "__response_json";
 const std::string kSerializeJson = "serialize_json";
 
+[[noreturn]] void ThrowInvalidJsonBody(const formats::json::Exception& e) {
+  throw RequestParseError(
+      InternalMessage{"Invalid JSON body"},
+      ExternalBody{std::string("Invalid JSON body: ") + e.what()});
+}
+
+void WriteResponseJson(formats::json::Value&& handler_response_json,
+                       formats::json::StringBuilder& response_json,
+                       request::RequestContext& context) {
+  const auto& stored_json = context.SetData<const formats::json::Value>(
+      kResponseDataName, std::move(handler_response_json));
+
+  const auto scope_time =
+      tracing::Span::CurrentSpan().CreateScopeTime(kSerializeJson);
+  WriteToStream(stored_json, response_json);
+}
+
 }  // namespace
 
 HttpHandlerJsonBase::HttpHandlerJsonBase(
     const components::ComponentConfig& config,
     const components::ComponentContext& component_context, bool is_monitor)
-    : HttpHandlerBase(config, component_context, is_monitor) {}
+    : HttpHandlerBase(config, component_context, is_monitor),
+      request_json_on_demand_(
+          config["request-json-on-demand"].As<bool>(false)) {}
 
 std::string HttpHandlerJsonBase::HandleRequestThrow(
     const http::HttpRequest& request, request::RequestContext& context) const {
-  const auto& request_json =
-      context.GetData<const formats::json::Value&>(kRequestDataName);
-
   auto& response = request.GetHttpResponse();
   response.SetContentType(
       USERVER_NAMESPACE::http::content_type::kApplicationJson);
 
-  const auto& response_json = context.SetData<const formats::json::Value>(
-      kResponseDataName,
-      HandleRequestJsonThrow(request, request_json, context));
+  formats::json::StringBuilder response_json;
+  if (request_json_on_demand_) {
+    WriteResponseJson(
+        HandleRequestJsonOnDemandThrow(
+            request,
+            context.GetData<const formats::json::OnDemandValue&>(
+                kRequestOnDemandDataName),
+            context),
+        response_json, context);
+  } else {
+    HandleRequestJsonStreamThrow(
+        request, context.GetData<const formats::json::Value&>(kRequestDataName),
+        response_json, context);
+  }
+  return response_json.GetString();
+}
 
-  const auto scope_time =
-      tracing::Span::CurrentSpan().CreateScopeTime(kSerializeJson);
-  return formats::json::ToString(response_json);
+void HttpHandlerJsonBase::HandleRequestJsonStreamThrow(
+    const http::HttpRequest& request, const formats::json::Value& request_json,
+    formats::json::StringBuilder& response_json,
+    request::RequestContext& context) const {
+  WriteResponseJson(HandleRequestJsonThrow(request, request_json, context),
+                    response_json, context);
 }
 
 const formats::json::Value* HttpHandlerJsonBase::GetRequestJson(
@@ -52,6 +87,28 @@ const formats::json::Value* HttpHandlerJsonBase::GetRequestJson(
   return context.GetDataOptional<const formats::json::Value>(kRequestDataName);
 }
 
+formats::json::Value HttpHandlerJsonBase::HandleRequestJsonOnDemandThrow(
+    const http::HttpRequest& request,
+    const formats::json::OnDemandValue& request_json,
+    request::RequestContext& context) const {
+  formats::json::Value materialized_json;
+  try {
+    materialized_json = request_json.Materialize();
+  } catch (const formats::json::Exception& e) {
+    ThrowInvalidJsonBody(e);
+  }
+
+  const auto& stored_json = context.SetData<const formats::json::Value>(
+      kRequestDataName, std::move(materialized_json));
+  return HandleRequestJsonThrow(request, stored_json, context);
+}
+
+const formats::json::OnDemandValue* HttpHandlerJsonBase::GetRequestJsonOnDemand(
+    const request::RequestContext& context) {
+  return context.GetDataOptional<const formats::json::OnDemandValue>(
+      kRequestOnDemandDataName);
+}
+
 const formats::json::Value* HttpHandlerJsonBase::GetResponseJson(
     const request::RequestContext& context) {
   return context.GetDataOptional<const formats::json::Value>(kResponseDataName);
@@ -70,23 +127,44 @@ FormattedErrorData HttpHandlerJsonBase::GetFormattedExternalErrorBody(
 
 void HttpHandlerJsonBase::ParseRequestData(
     const http::HttpRequest& request, request::RequestContext& context) const {
+  if (request_json_on_demand_) {
+    // the request body outlives the request context
+    formats::json::OnDemandValue request_json;
+    try {
+      if (!request.RequestBody().empty())
+        request_json = formats::json::FromString(request.RequestBody(),
+                                                 formats::json::kOnDemand);
+    } catch (const formats::json::Exception& e) {
+      ThrowInvalidJsonBody(e);
+    }
+
+    context.SetData<const formats::json::OnDemandValue>(
+        kRequestOnDemandDataName, std::move(request_json));
+    return;
+  }
+
   formats::json::Value request_json;
   try {
     if (!request.RequestBody().empty())
       request_json = formats::json::FromString(request.RequestBody());
   } catch (const formats::json::Exception& e) {
-    throw RequestParseError(
-        InternalMessage{"Invalid JSON body"},
-        ExternalBody{std::string("Invalid JSON body: ") + e.what()});
+    ThrowInvalidJsonBody(e);
   }
 
   context.SetData<const formats::json::Value>(kRequestDataName, request_json);
 }
 
 yaml_config::Schema HttpHandlerJsonBase::GetStaticConfigSchema() {
-  auto schema = HttpHandlerBase::GetStaticConfigSchema();
-  schema.UpdateDescription("HTTP handler JSON base config");
-  return schema;
+  return yaml_config::MergeSchemas<HttpHandlerBase>(R"(
+type: object
+description: HTTP handler JSON base config
+additionalProperties: false
+properties:
+    request-json-on-demand:
+        type: boolean
+        description: parse the request body with formats::json::OnDemandValue and call HandleRequestJsonOnDemandThrow()
+        defaultDescription: false
+)");
 }
 
 }  // namespace server::handlers
@@ -1,6 +1,7 @@
 #include "handler_info_index.hpp"
 
 #include <array>
+#include <deque>
 #include <stdexcept>
 
 #include <fmt/format.h>
@@ -9,9 +10,9 @@
 #include <userver/utils/assert.hpp>
 #include <userver/utils/overloaded.hpp>
 
-#include <server/http/fixed_path_index.hpp>
+#include <server/http/handler_method_index.hpp>
 #include <server/http/handler_methods.hpp>
-#include <server/http/wildcard_path_index.hpp>
+#include <server/http/path_router.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -27,17 +28,24 @@ class HandlerInfoIndex::HandlerInfoIndexImpl final {
 
   const HandlerList& GetHandlers() const;
 
+  void Compile();
+
   MatchRequestResult MatchRequest(HttpMethod method,
-                                  const std::string& path) const;
+                                  std::string_view path) const;
 
   void SetFallbackHandler(const handlers::HttpHandlerBase& handler,
                           engine::TaskProcessor& task_processor);
   const HandlerInfo* GetFallbackHandler(handlers::FallbackHandler) const;
 
  private:
+  void AddRoute(const std::string& path,
+                const handlers::HttpHandlerBase& handler,
+                engine::TaskProcessor& task_processor);
+
   HandlerList handler_list_;
-  impl::FixedPathIndex fixed_path_index_;
-  impl::WildcardPathIndex wildcard_path_index_;
+  impl::PathRouter path_router_;
+  // by PathRouter::RouteId
+  std::deque<impl::HandlerMethodIndex> handler_method_indices_;
   FallbackHandlersStorage fallback_handlers_{};
 };
 
@@ -45,27 +53,80 @@ void HandlerInfoIndex::HandlerInfoIndexImpl::AddHandler(
     const handlers::HttpHandlerBase& handler,
     engine::TaskProcessor& task_processor) {
   const auto& path = std::get<std::string>(handler.GetConfig().path);
-  if (!impl::HasWildcardSpecificSymbols(path) &&
-      (path.empty() || path.back() != '*')) {
-    fixed_path_index_.AddHandler(handler, task_processor);
-  } else {
-    wildcard_path_index_.AddHandler(handler, task_processor);
+  AddRoute(path, handler, task_processor);
+
+  auto url_trailing_slash = handler.GetConfig().url_trailing_slash;
+  if (url_trailing_slash == handlers::UrlTrailingSlashOption::kBoth &&
+      !path.empty()) {
+    if (path.back() == '/') {
+      if (path.size() > 1) {
+        if (path[path.size() - 2] == '/')
+          throw std::runtime_error(
+              "can't use 'url_trailing_slash' option with path ends with '//'");
+        AddRoute(path.substr(0, path.size() - 1), handler, task_processor);
+      }
+    } else if (path.back() == '*') {
+      if (path.size() > 1 && path[path.size() - 2] == '/') {
+        // ends with '/*' but not with '//*'
+        if (path.size() > 2 && path[path.size() - 3] == '/')
+          throw std::runtime_error(
+              "can't use 'url_trailing_slash' option with path ends with "
+              "'//*'");
+        AddRoute(path.substr(0, path.size() - 2), handler, task_processor);
+      } else {
+        throw std::runtime_error("incorrect path: '" + path +
+                                 "': trailing '*' allowed after '/' only");
+      }
+    } else {
+      AddRoute(path + '/', handler, task_processor);
+    }
   }
   handler_list_.emplace_back(&handler);
 }
 
+void HandlerInfoIndex::HandlerInfoIndexImpl::AddRoute(
+    const std::string& path, const handlers::HttpHandlerBase& handler,
+    engine::TaskProcessor& task_processor) {
+  auto route = path_router_.AddRoute(path, handler.GetAllowedMethods());
+  if (route.id == handler_method_indices_.size()) {
+    handler_method_indices_.emplace_back();
+  }
+  UASSERT(route.id < handler_method_indices_.size());
+  handler_method_indices_[route.id].AddHandler(handler, task_processor,
+                                               std::move(route.arg_names));
+}
+
 const HandlerInfoIndex::HandlerList&
 HandlerInfoIndex::HandlerInfoIndexImpl::GetHandlers() const {
   return handler_list_;
 }
 
+void HandlerInfoIndex::HandlerInfoIndexImpl::Compile() {
+  path_router_.Compile();
+}
+
 MatchRequestResult HandlerInfoIndex::HandlerInfoIndexImpl::MatchRequest(
-    HttpMethod method, const std::string& path) const {
+    HttpMethod method, std::string_view path) const {
   MatchRequestResult match_result;
-  if (fixed_path_index_.MatchRequest(method, path, match_result))
-    return match_result;
+  const auto route_match =
+      path_router_.Match(path, method, match_result.args_from_path);
+  if (route_match.method_not_allowed) {
+    match_result.status = MatchRequestResult::Status::kMethodNotAllowed;
+  }
+  if (!route_match.route) return match_result;
+
+  const auto* handler_info_data =
+      handler_method_indices_[*route_match.route].GetHandlerInfoData(method);
+  UASSERT(handler_info_data);
+  const auto& arg_names = handler_info_data->arg_names;
+  UASSERT(arg_names.size() <= match_result.args_from_path.size());
+  for (std::size_t i = 0; i < arg_names.size(); ++i) {
+    match_result.args_from_path[i].first = arg_names[i];
+  }
 
-  wildcard_path_index_.MatchRequest(method, path, match_result);
+  match_result.handler_info = &handler_info_data->handler_info;
+  match_result.matched_path_length = route_match.matched_path_length;
+  match_result.status = MatchRequestResult::Status::kOk;
   return match_result;
 }
 
@@ -112,8 +173,10 @@ const HandlerInfoIndex::HandlerList& HandlerInfoIndex::GetHandlers() const {
   return impl_->GetHandlers();
 }
 
+void HandlerInfoIndex::Compile() { impl_->Compile(); }
+
 MatchRequestResult HandlerInfoIndex::MatchRequest(
-    HttpMethod method, const std::string& path) const {
+    HttpMethod method, std::string_view path) const {
   return impl_->MatchRequest(method, path);
 }
 
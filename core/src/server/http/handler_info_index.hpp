@@ -3,6 +3,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <userver/engine/task/task_processor_fwd.hpp>
@@ -11,6 +12,8 @@
 #include <userver/server/http/http_method.hpp>
 #include <userver/utils/not_null.hpp>
 
+#include <server/http/path_router.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
@@ -34,7 +37,8 @@ struct MatchRequestResult {
   const HandlerInfo* handler_info = nullptr;
   size_t matched_path_length = 0;
   Status status = Status::kHandlerNotFound;
-  std::vector<std::pair<std::string, std::string>> args_from_path;
+  // views into the matched path and into the index
+  impl::PathArgs args_from_path;
 };
 
 class HandlerInfoIndex final {
@@ -51,8 +55,11 @@ class HandlerInfoIndex final {
 
   const HandlerInfo* GetFallbackHandler(handlers::FallbackHandler) const;
 
+  /// Prepares the index for matching, handlers may not be added after that
+  void Compile();
+
   MatchRequestResult MatchRequest(HttpMethod method,
-                                  const std::string& path) const;
+                                  std::string_view path) const;
 
  private:
   class HandlerInfoIndexImpl;
@@ -8,10 +8,10 @@ namespace server::http::impl {
 
 void HandlerMethodIndex::AddHandler(const handlers::HttpHandlerBase& handler,
                                     engine::TaskProcessor& task_processor,
-                                    std::vector<PathItem> wildcards) {
+                                    std::vector<std::string> arg_names) {
   auto& handler_info_data =
       *handler_info_holder_.emplace(handler_info_holder_.end(), task_processor,
-                                    handler, std::move(wildcards));
+                                    handler, std::move(arg_names));
 
   for (auto method : handler.GetAllowedMethods()) {
     AddHandlerInfoData(method, handler_info_data);
@@ -15,31 +15,23 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::http::impl {
 
-struct PathItem final {
-  PathItem() = default;
-  PathItem(size_t index, std::string name)
-      : index(index), name(std::move(name)) {}
-
-  size_t index{0};
-  std::string name;
-};
-
 class HandlerMethodIndex final {
  public:
   struct HandlerInfoData {
     HandlerInfoData(engine::TaskProcessor& task_processor,
                     const handlers::HttpHandlerBase& handler,
-                    std::vector<PathItem> wildcards)
+                    std::vector<std::string> arg_names)
         : handler_info(task_processor, handler),
-          wildcards(std::move(wildcards)) {}
+          arg_names(std::move(arg_names)) {}
 
     HandlerInfo handler_info;
-    std::vector<PathItem> wildcards;
+    // names of the path wildcards of this handler, see PathRouter::Route
+    std::vector<std::string> arg_names;
   };
 
   void AddHandler(const handlers::HttpHandlerBase& handler,
                   engine::TaskProcessor& task_processor,
-                  std::vector<PathItem> wildcards);
+                  std::vector<std::string> arg_names);
   [[nodiscard]] const HandlerInfoData* GetHandlerInfoData(
       HttpMethod method) const;
 
@@ -0,0 +1,627 @@
+#include "http2_session.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/server/http/http_method.hpp>
+#include <userver/server/request/request_base.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/scope_guard.hpp>
+
+#include "http_request_impl.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+// Size of the fixed frame header that precedes every frame payload
+constexpr std::size_t kFrameHeaderSize = 9;
+
+// Streamed body bytes of a stream that may wait for the peer, the producer
+// waits once there are more. Equals the default flow-control window.
+constexpr std::size_t kMaxQueuedBodySize = 65535;
+
+std::string_view ToStringView(const uint8_t* data, size_t size) {
+  return {reinterpret_cast<const char*>(data), size};
+}
+
+nghttp2_nv MakeNv(std::string_view name, std::string_view value) {
+  // nghttp2 copies the name and the value as no NO_COPY flags are set
+  return {reinterpret_cast<uint8_t*>(const_cast<char*>(name.data())),
+          reinterpret_cast<uint8_t*>(const_cast<char*>(value.data())),
+          name.size(), value.size(), NGHTTP2_NV_FLAG_NONE};
+}
+
+[[noreturn]] void ThrowNghttp2Error(std::string_view what, int error_code) {
+  throw std::runtime_error(
+      fmt::format("{}: {}", what, nghttp2_strerror(error_code)));
+}
+
+HttpMethod ConvertHttpMethod(std::string_view method) {
+  try {
+    return HttpMethodFromString(std::string{method});
+  } catch (const std::exception&) {
+    return HttpMethod::kUnknown;
+  }
+}
+
+}  // namespace
+
+struct Http2Session::Stream {
+  // Set while the request is being received
+  std::optional<HttpRequestConstructor> request_constructor;
+  bool is_headers_complete{false};
+  bool has_request{false};
+
+  // Response body, either a view into the HttpResponse data or the chunks of
+  // a streamed body
+  bool is_body_streamed{false};
+  bool is_body_finished{false};
+  std::string_view body;
+  std::deque<std::string> body_chunks;
+  std::size_t body_offset{0};
+  // Not yet sent bytes of the body chunks
+  std::size_t queued_body_size{0};
+  engine::SingleConsumerEvent body_consumed_event;
+
+  std::size_t sent_bytes{0};
+  bool is_response_sent{false};
+  bool is_closed{false};
+  engine::SingleConsumerEvent closed_event{
+      engine::SingleConsumerEvent::NoAutoReset{}};
+};
+
+Http2Session::Http2Session(const HandlerInfoIndex& handler_info_index,
+                           const request::HttpRequestConfig& request_config,
+                           OnNewRequestCb&& on_new_request_cb,
+                           net::ParserStats& stats,
+                           request::ResponseDataAccounter& data_accounter,
+                           engine::io::Socket& socket,
+                           const net::Http2SessionConfig& config,
+                           std::chrono::milliseconds send_timeout)
+    : handler_info_index_(handler_info_index),
+      request_constructor_config_{request_config},
+      on_new_request_cb_(std::move(on_new_request_cb)),
+      stats_(stats),
+      data_accounter_(data_accounter),
+      socket_(socket),
+      send_timeout_(send_timeout),
+      session_(MakeSession(*this)) {
+  const std::array<nghttp2_settings_entry, 3> settings{{
+      {NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS, config.max_concurrent_streams},
+      {NGHTTP2_SETTINGS_MAX_FRAME_SIZE, config.max_frame_size},
+      {NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE, config.initial_window_size},
+  }};
+  // Sent along with the first Flush()
+  const int rv = nghttp2_submit_settings(session_.get(), NGHTTP2_FLAG_NONE,
+                                         settings.data(), settings.size());
+  if (rv != 0) ThrowNghttp2Error("nghttp2_submit_settings() failed", rv);
+}
+
+Http2Session::~Http2Session() {
+  for (const auto& [stream_id, stream] : streams_) {
+    if (stream->request_constructor) --stats_.parsing_request_count;
+  }
+}
+
+bool Http2Session::Parse(const char* data, size_t size) {
+  std::vector<std::shared_ptr<request::RequestBase>> requests;
+  bool is_alive = true;
+  {
+    std::unique_lock lock(mutex_);
+    const auto parsed = nghttp2_session_mem_recv(
+        session_.get(), reinterpret_cast<const uint8_t*>(data), size);
+    if (parsed < 0) {
+      LOG_WARNING() << "HTTP/2 session error: "
+                    << nghttp2_strerror(static_cast<int>(parsed));
+      is_alive = false;
+    }
+
+    // Send GOAWAY if any, SETTINGS acks and WINDOW_UPDATEs
+    if (!Flush(lock)) is_alive = false;
+
+    requests.swap(finalized_requests_);
+    is_alive = is_alive && (nghttp2_session_want_read(session_.get()) ||
+                            nghttp2_session_want_write(session_.get()));
+  }
+
+  // Pushing into the requests queue may block, the responses of the previous
+  // requests should be sendable meanwhile
+  for (auto& request : requests) on_new_request_cb_(std::move(request));
+  return is_alive;
+}
+
+void Http2Session::SendResponse(request::RequestBase& request) {
+  std::int32_t stream_id = 0;
+  {
+    std::lock_guard lock(mutex_);
+    const auto it = request_streams_.find(&request);
+    UASSERT(it != request_streams_.end());
+    stream_id = it->second;
+    request_streams_.erase(it);
+  }
+
+  // The response body is referenced by the stream, forget the stream before
+  // the request dies whatever happens
+  utils::ScopeGuard stream_forgetter([this, stream_id] {
+    std::unique_lock lock(mutex_);
+    ForgetStream(stream_id);
+    Flush(lock);
+  });
+
+  auto& http_request = static_cast<HttpRequestImpl&>(request);
+  http_request.GetHttpResponse().SendResponse(*this, stream_id);
+}
+
+void Http2Session::CancelResponse(request::RequestBase& request) {
+  std::unique_lock lock(mutex_);
+  const auto it = request_streams_.find(&request);
+  UASSERT(it != request_streams_.end());
+  ForgetStream(it->second);
+  request_streams_.erase(it);
+  Flush(lock);
+}
+
+bool Http2Session::SubmitResponse(std::int32_t stream_id, int status,
+                                  const Headers& headers,
+                                  std::string_view body,
+                                  bool is_body_streamed) {
+  std::unique_lock lock(mutex_);
+  auto* stream = FindStream(stream_id);
+  if (!stream || stream->is_closed || is_closed_) return false;
+
+  const auto status_str = fmt::format(FMT_COMPILE("{}"), status);
+  std::vector<nghttp2_nv> nva;
+  nva.reserve(headers.size() + 1);
+  nva.push_back(MakeNv(":status", status_str));
+  for (const auto& [name, value] : headers) {
+    nva.push_back(MakeNv(name, value));
+  }
+
+  stream->is_body_streamed = is_body_streamed;
+  stream->body = body;
+
+  nghttp2_data_provider data_provider{};
+  data_provider.read_callback = &Http2Session::OnDataSourceRead;
+  const bool has_body = is_body_streamed || !body.empty();
+
+  const int rv =
+      nghttp2_submit_response(session_.get(), stream_id, nva.data(),
+                              nva.size(), has_body ? &data_provider : nullptr);
+  if (rv != 0) {
+    LOG_WARNING() << "Failed to submit HTTP/2 response for stream "
+                  << stream_id << ": " << nghttp2_strerror(rv);
+    return false;
+  }
+
+  return Flush(lock);
+}
+
+bool Http2Session::PushBodyChunk(std::int32_t stream_id, std::string chunk) {
+  std::unique_lock lock(mutex_);
+  auto* stream = FindStream(stream_id);
+  if (!stream || stream->is_closed || is_closed_) return false;
+  UASSERT(stream->is_body_streamed && !stream->is_body_finished);
+
+  // A slow peer or a closed flow-control window must not make the body pile
+  // up in memory, as with HTTP/1 the producer waits for the peer
+  while (stream->queued_body_size >= kMaxQueuedBodySize) {
+    lock.unlock();
+    // The stream may only be erased by this task, see WaitForStreamClose()
+    const bool is_consumed = stream->body_consumed_event.WaitForEvent();
+    lock.lock();
+    if (!is_consumed || stream->is_closed || is_closed_) return false;
+  }
+
+  stream->queued_body_size += chunk.size();
+  stream->body_chunks.push_back(std::move(chunk));
+  nghttp2_session_resume_data(session_.get(), stream_id);
+  return Flush(lock);
+}
+
+bool Http2Session::FinishBody(std::int32_t stream_id) {
+  std::unique_lock lock(mutex_);
+  auto* stream = FindStream(stream_id);
+  if (!stream || stream->is_closed || is_closed_) return false;
+  UASSERT(stream->is_body_streamed);
+
+  stream->is_body_finished = true;
+  nghttp2_session_resume_data(session_.get(), stream_id);
+  return Flush(lock);
+}
+
+std::optional<std::size_t> Http2Session::WaitForStreamClose(
+    std::int32_t stream_id) {
+  Stream* stream = nullptr;
+  {
+    std::lock_guard lock(mutex_);
+    stream = FindStream(stream_id);
+    if (!stream) return std::nullopt;
+  }
+
+  // The stream may only be erased by the task that sends its response, so
+  // it's safe to wait for it without holding the mutex
+  if (!stream->closed_event.WaitForEvent()) return std::nullopt;
+
+  std::lock_guard lock(mutex_);
+  if (!stream->is_response_sent) return std::nullopt;
+  return stream->sent_bytes;
+}
+
+void Http2Session::CloseAllStreams() {
+  std::lock_guard lock(mutex_);
+  CloseStreams();
+}
+
+Http2Session::SessionPtr Http2Session::MakeSession(Http2Session& self) {
+  nghttp2_session_callbacks* callbacks = nullptr;
+  int rv = nghttp2_session_callbacks_new(&callbacks);
+  if (rv != 0) ThrowNghttp2Error("nghttp2_session_callbacks_new() failed", rv);
+  utils::ScopeGuard callbacks_deleter(
+      [callbacks] { nghttp2_session_callbacks_del(callbacks); });
+
+  nghttp2_session_callbacks_set_on_begin_headers_callback(
+      callbacks, &Http2Session::OnBeginHeaders);
+  nghttp2_session_callbacks_set_on_header_callback(callbacks,
+                                                   &Http2Session::OnHeader);
+  nghttp2_session_callbacks_set_on_data_chunk_recv_callback(
+      callbacks, &Http2Session::OnDataChunkRecv);
+  nghttp2_session_callbacks_set_on_frame_recv_callback(
+      callbacks, &Http2Session::OnFrameRecv);
+  nghttp2_session_callbacks_set_on_frame_send_callback(
+      callbacks, &Http2Session::OnFrameSend);
+  nghttp2_session_callbacks_set_on_stream_close_callback(
+      callbacks, &Http2Session::OnStreamClose);
+
+  nghttp2_session* session = nullptr;
+  rv = nghttp2_session_server_new(&session, callbacks, &self);
+  if (rv != 0) ThrowNghttp2Error("nghttp2_session_server_new() failed", rv);
+  return {session, &nghttp2_session_del};
+}
+
+int Http2Session::OnBeginHeaders(nghttp2_session*, const nghttp2_frame* frame,
+                                 void* user_data) {
+  auto* http2_session = static_cast<Http2Session*>(user_data);
+  UASSERT(http2_session != nullptr);
+  return http2_session->OnBeginHeadersImpl(*frame);
+}
+
+int Http2Session::OnHeader(nghttp2_session*, const nghttp2_frame* frame,
+                           const uint8_t* name, size_t name_size,
+                           const uint8_t* value, size_t value_size, uint8_t,
+                           void* user_data) {
+  auto* http2_session = static_cast<Http2Session*>(user_data);
+  UASSERT(http2_session != nullptr);
+  return http2_session->OnHeaderImpl(*frame, ToStringView(name, name_size),
+                                     ToStringView(value, value_size));
+}
+
+int Http2Session::OnDataChunkRecv(nghttp2_session*, uint8_t,
+                                  std::int32_t stream_id, const uint8_t* data,
+                                  size_t size, void* user_data) {
+  auto* http2_session = static_cast<Http2Session*>(user_data);
+  UASSERT(http2_session != nullptr);
+  return http2_session->OnDataChunkRecvImpl(stream_id,
+                                            ToStringView(data, size));
+}
+
+int Http2Session::OnFrameRecv(nghttp2_session*, const nghttp2_frame* frame,
+                              void* user_data) {
+  auto* http2_session = static_cast<Http2Session*>(user_data);
+  UASSERT(http2_session != nullptr);
+  return http2_session->OnFrameRecvImpl(*frame);
+}
+
+int Http2Session::OnFrameSend(nghttp2_session*, const nghttp2_frame* frame,
+                              void* user_data) {
+  auto* http2_session = static_cast<Http2Session*>(user_data);
+  UASSERT(http2_session != nullptr);
+  http2_session->OnFrameSendImpl(*frame);
+  return 0;
+}
+
+int Http2Session::OnStreamClose(nghttp2_session*, std::int32_t stream_id,
+                                uint32_t error_code, void* user_data) {
+  auto* http2_session = static_cast<Http2Session*>(user_data);
+  UASSERT(http2_session != nullptr);
+  http2_session->OnStreamCloseImpl(stream_id, error_code);
+  return 0;
+}
+
+ssize_t Http2Session::OnDataSourceRead(nghttp2_session*,
+                                       std::int32_t stream_id, uint8_t* buf,
+                                       size_t length, uint32_t* data_flags,
+                                       nghttp2_data_source*, void* user_data) {
+  auto* http2_session = static_cast<Http2Session*>(user_data);
+  UASSERT(http2_session != nullptr);
+  return http2_session->OnDataSourceReadImpl(stream_id, buf, length,
+                                             data_flags);
+}
+
+int Http2Session::OnBeginHeadersImpl(const nghttp2_frame& frame) {
+  if (frame.hd.type != NGHTTP2_HEADERS ||
+      frame.headers.cat != NGHTTP2_HCAT_REQUEST) {
+    return 0;
+  }
+
+  LOG_TRACE() << "stream " << frame.hd.stream_id << " begin";
+  auto& stream = streams_[frame.hd.stream_id];
+  UASSERT(!stream);
+  stream = std::make_unique<Stream>();
+
+  ++stats_.parsing_request_count;
+  stream->request_constructor.emplace(request_constructor_config_,
+                                      handler_info_index_, data_accounter_);
+  stream->request_constructor->SetHttpMajor(2);
+  stream->request_constructor->SetHttpMinor(0);
+  return 0;
+}
+
+int Http2Session::OnHeaderImpl(const nghttp2_frame& frame,
+                               std::string_view name, std::string_view value) {
+  auto* stream = FindStream(frame.hd.stream_id);
+  // Trailers are ignored
+  if (!stream || !stream->request_constructor || stream->is_headers_complete) {
+    return 0;
+  }
+  auto& request_constructor = *stream->request_constructor;
+
+  LOG_TRACE() << "stream " << frame.hd.stream_id << " header: '" << name
+              << "': '" << value << '\'';
+  try {
+    if (name == ":method") {
+      request_constructor.SetMethod(ConvertHttpMethod(value));
+    } else if (name == ":path") {
+      request_constructor.AppendUrl(value.data(), value.size());
+    } else if (name == ":authority") {
+      // nghttp2 guarantees that pseudo headers go before the regular ones
+      const std::string_view host = USERVER_NAMESPACE::http::headers::kHost;
+      request_constructor.AppendHeaderField(host.data(), host.size());
+      request_constructor.AppendHeaderValue(value.data(), value.size());
+    } else if (!name.empty() && name[0] != ':') {
+      request_constructor.AppendHeaderField(name.data(), name.size());
+      request_constructor.AppendHeaderValue(value.data(), value.size());
+    }
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append header: " << ex;
+    // The request constructor knows the error status to respond with, the
+    // rest of the stream is ignored
+    FinalizeRequest(frame.hd.stream_id, *stream);
+  }
+  return 0;
+}
+
+int Http2Session::OnDataChunkRecvImpl(std::int32_t stream_id,
+                                      std::string_view data) {
+  auto* stream = FindStream(stream_id);
+  if (!stream || !stream->request_constructor) return 0;
+
+  try {
+    stream->request_constructor->AppendBody(data.data(), data.size());
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append body: " << ex;
+    FinalizeRequest(stream_id, *stream);
+  }
+  return 0;
+}
+
+int Http2Session::OnFrameRecvImpl(const nghttp2_frame& frame) {
+  if (frame.hd.type != NGHTTP2_HEADERS && frame.hd.type != NGHTTP2_DATA) {
+    return 0;
+  }
+
+  auto* stream = FindStream(frame.hd.stream_id);
+  if (!stream || !stream->request_constructor) return 0;
+
+  const bool is_headers_failed =
+      frame.hd.type == NGHTTP2_HEADERS && !stream->is_headers_complete &&
+      !FinishHeaders(*stream);
+
+  if (is_headers_failed || (frame.hd.flags & NGHTTP2_FLAG_END_STREAM)) {
+    FinalizeRequest(frame.hd.stream_id, *stream);
+  }
+  return 0;
+}
+
+void Http2Session::OnFrameSendImpl(const nghttp2_frame& frame) {
+  if (frame.hd.stream_id == 0) return;
+  auto* stream = FindStream(frame.hd.stream_id);
+  if (!stream) return;
+
+  stream->sent_bytes += kFrameHeaderSize + frame.hd.length;
+  if ((frame.hd.type == NGHTTP2_HEADERS || frame.hd.type == NGHTTP2_DATA) &&
+      (frame.hd.flags & NGHTTP2_FLAG_END_STREAM)) {
+    stream->is_response_sent = true;
+  }
+}
+
+void Http2Session::OnStreamCloseImpl(std::int32_t stream_id,
+                                     uint32_t error_code) {
+  const auto it = streams_.find(stream_id);
+  if (it == streams_.end()) return;
+  auto& stream = *it->second;
+
+  LOG_TRACE() << "stream " << stream_id << " closed, error_code="
+              << error_code;
+  if (stream.request_constructor) {
+    --stats_.parsing_request_count;
+    stream.request_constructor.reset();
+  }
+
+  if (!stream.has_request) {
+    streams_.erase(it);
+    return;
+  }
+
+  // The response sender forgets the stream
+  stream.is_closed = true;
+  stream.closed_event.Send();
+  stream.body_consumed_event.Send();
+}
+
+ssize_t Http2Session::OnDataSourceReadImpl(std::int32_t stream_id,
+                                           uint8_t* buf, size_t length,
+                                           uint32_t* data_flags) {
+  auto* stream = FindStream(stream_id);
+  // The response sender has already given up, resets the stream
+  if (!stream) return NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE;
+
+  if (!stream->is_body_streamed) {
+    const auto size =
+        std::min(length, stream->body.size() - stream->body_offset);
+    std::memcpy(buf, stream->body.data() + stream->body_offset, size);
+    stream->body_offset += size;
+    if (stream->body_offset == stream->body.size()) {
+      *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+    }
+    return static_cast<ssize_t>(size);
+  }
+
+  std::size_t copied = 0;
+  auto& chunks = stream->body_chunks;
+  while (copied < length && !chunks.empty()) {
+    const auto& chunk = chunks.front();
+    const auto size = std::min(length - copied,
+                               chunk.size() - stream->body_offset);
+    std::memcpy(buf + copied, chunk.data() + stream->body_offset, size);
+    copied += size;
+    stream->body_offset += size;
+    if (stream->body_offset == chunk.size()) {
+      chunks.pop_front();
+      stream->body_offset = 0;
+    }
+  }
+  if (copied != 0) {
+    stream->queued_body_size -= copied;
+    stream->body_consumed_event.Send();
+  }
+
+  if (chunks.empty() && stream->is_body_finished) {
+    *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+  } else if (copied == 0) {
+    // Resumed by PushBodyChunk() or FinishBody()
+    return NGHTTP2_ERR_DEFERRED;
+  }
+  return static_cast<ssize_t>(copied);
+}
+
+Http2Session::Stream* Http2Session::FindStream(std::int32_t stream_id) {
+  const auto it = streams_.find(stream_id);
+  return it == streams_.end() ? nullptr : it->second.get();
+}
+
+bool Http2Session::FinishHeaders(Stream& stream) {
+  UASSERT(stream.request_constructor);
+  stream.is_headers_complete = true;
+  try {
+    stream.request_constructor->ParseUrl();
+    stream.request_constructor->AppendHeaderField("", 0);
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't parse request headers: " << ex;
+    return false;
+  }
+  LOG_TRACE() << "headers complete";
+  return true;
+}
+
+void Http2Session::FinalizeRequest(std::int32_t stream_id, Stream& stream) {
+  UASSERT(stream.request_constructor);
+  // Streams are independent, the connection is never closed because of
+  // a single request
+  stream.request_constructor->SetIsFinal(false);
+  auto request = stream.request_constructor->Finalize();
+  --stats_.parsing_request_count;
+  stream.request_constructor.reset();
+
+  if (!request) {
+    LOG_ERROR() << "request is null after Finalize()";
+    nghttp2_submit_rst_stream(session_.get(), NGHTTP2_FLAG_NONE, stream_id,
+                              NGHTTP2_INTERNAL_ERROR);
+    return;
+  }
+
+  stream.has_request = true;
+  request_streams_.emplace(request.get(), stream_id);
+  finalized_requests_.push_back(std::move(request));
+}
+
+void Http2Session::ForgetStream(std::int32_t stream_id) {
+  const auto it = streams_.find(stream_id);
+  if (it == streams_.end()) return;
+
+  if (!it->second->is_closed && !is_closed_) {
+    // The response was not sent completely
+    nghttp2_submit_rst_stream(session_.get(), NGHTTP2_FLAG_NONE, stream_id,
+                              NGHTTP2_CANCEL);
+  }
+  streams_.erase(it);
+}
+
+void Http2Session::CloseStreams() {
+  is_closed_ = true;
+  out_buffer_.clear();
+  for (auto& [stream_id, stream] : streams_) {
+    stream->is_closed = true;
+    stream->closed_event.Send();
+    stream->body_consumed_event.Send();
+  }
+}
+
+bool Http2Session::Flush(std::unique_lock<engine::Mutex>& lock) {
+  UASSERT(lock.owns_lock());
+  if (is_closed_) return false;
+
+  while (true) {
+    const uint8_t* data = nullptr;
+    const auto size = nghttp2_session_mem_send(session_.get(), &data);
+    if (size < 0) {
+      LOG_WARNING() << "nghttp2_session_mem_send() failed: "
+                    << nghttp2_strerror(static_cast<int>(size));
+      CloseStreams();
+      return false;
+    }
+    if (size == 0) break;
+    out_buffer_.append(reinterpret_cast<const char*>(data), size);
+  }
+
+  // The task that is writing into the socket sends our frames as well
+  if (is_sending_) return true;
+
+  is_sending_ = true;
+  std::string buffer;
+  while (!out_buffer_.empty() && !is_closed_) {
+    buffer.clear();
+    buffer.swap(out_buffer_);
+
+    lock.unlock();
+    bool is_sent = false;
+    try {
+      is_sent = socket_.SendAll(buffer.data(), buffer.size(),
+                                engine::Deadline::FromDuration(
+                                    send_timeout_)) == buffer.size();
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "Failed to send HTTP/2 frames: " << ex;
+    }
+    lock.lock();
+
+    // The peer would not see the rest of the frames, nothing to wait for
+    if (!is_sent) CloseStreams();
+  }
+  is_sending_ = false;
+  return !is_closed_;
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
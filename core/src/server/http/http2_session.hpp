@@ -0,0 +1,163 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <nghttp2/nghttp2.h>
+
+#include <server/net/connection_config.hpp>
+#include <server/net/stats.hpp>
+#include <server/request/request_parser.hpp>
+
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/server/request/request_config.hpp>
+
+#include "http_request_constructor.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// Server side of an HTTP/2 connection. Parses the incoming frames into
+/// requests (one per stream) and multiplexes the responses back into the
+/// socket. Responses of different streams may be sent concurrently from
+/// different tasks.
+class Http2Session final : public request::RequestParser {
+ public:
+  using OnNewRequestCb =
+      std::function<void(std::shared_ptr<request::RequestBase>&&)>;
+
+  /// Response header, the name must be in lowercase
+  using Header = std::pair<std::string, std::string>;
+  using Headers = std::vector<Header>;
+
+  /// Client connection preface, starts every HTTP/2 connection
+  static constexpr std::string_view kConnectionPreface =
+      "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+  Http2Session(const HandlerInfoIndex& handler_info_index,
+               const request::HttpRequestConfig& request_config,
+               OnNewRequestCb&& on_new_request_cb, net::ParserStats& stats,
+               request::ResponseDataAccounter& data_accounter,
+               engine::io::Socket& socket,
+               const net::Http2SessionConfig& config,
+               std::chrono::milliseconds send_timeout);
+  ~Http2Session() override;
+
+  Http2Session(Http2Session&&) = delete;
+  Http2Session& operator=(Http2Session&&) = delete;
+
+  /// Feeds the received bytes into the session and flushes the pending
+  /// frames (SETTINGS, WINDOW_UPDATE, PING acks, ...) into the socket.
+  /// Returns false if the connection should be closed.
+  bool Parse(const char* data, size_t size) override;
+
+  /// Sends the response of a request produced by this session. Blocks until
+  /// the whole response is sent or the stream is closed by the peer.
+  void SendResponse(request::RequestBase& request);
+
+  /// Resets the stream of a request which response is not going to be sent
+  void CancelResponse(request::RequestBase& request);
+
+  /// @{
+  /// HttpResponse interface. Return false if the stream was closed (reset by
+  /// the peer or the connection was closed) and the response can not be sent.
+  bool SubmitResponse(std::int32_t stream_id, int status,
+                      const Headers& headers, std::string_view body,
+                      bool is_body_streamed);
+  /// Waits while too much of the streamed body is not sent yet
+  bool PushBodyChunk(std::int32_t stream_id, std::string chunk);
+  bool FinishBody(std::int32_t stream_id);
+
+  /// Waits for the stream to be closed. Returns the number of bytes sent for
+  /// the stream or std::nullopt if the response was not sent completely.
+  std::optional<std::size_t> WaitForStreamClose(std::int32_t stream_id);
+  /// @}
+
+  /// Wakes up all the waiters and stops sending, called once the peer frames
+  /// are not read anymore
+  void CloseAllStreams();
+
+ private:
+  struct Stream;
+
+  using SessionPtr =
+      std::unique_ptr<nghttp2_session, void (*)(nghttp2_session*)>;
+
+  static SessionPtr MakeSession(Http2Session& self);
+
+  static int OnBeginHeaders(nghttp2_session* session,
+                            const nghttp2_frame* frame, void* user_data);
+  static int OnHeader(nghttp2_session* session, const nghttp2_frame* frame,
+                      const uint8_t* name, size_t name_size,
+                      const uint8_t* value, size_t value_size, uint8_t flags,
+                      void* user_data);
+  static int OnDataChunkRecv(nghttp2_session* session, uint8_t flags,
+                             std::int32_t stream_id, const uint8_t* data,
+                             size_t size, void* user_data);
+  static int OnFrameRecv(nghttp2_session* session, const nghttp2_frame* frame,
+                         void* user_data);
+  static int OnFrameSend(nghttp2_session* session, const nghttp2_frame* frame,
+                         void* user_data);
+  static int OnStreamClose(nghttp2_session* session, std::int32_t stream_id,
+                           uint32_t error_code, void* user_data);
+  static ssize_t OnDataSourceRead(nghttp2_session* session,
+                                  std::int32_t stream_id, uint8_t* buf,
+                                  size_t length, uint32_t* data_flags,
+                                  nghttp2_data_source* source,
+                                  void* user_data);
+
+  int OnBeginHeadersImpl(const nghttp2_frame& frame);
+  int OnHeaderImpl(const nghttp2_frame& frame, std::string_view name,
+                   std::string_view value);
+  int OnDataChunkRecvImpl(std::int32_t stream_id, std::string_view data);
+  int OnFrameRecvImpl(const nghttp2_frame& frame);
+  void OnFrameSendImpl(const nghttp2_frame& frame);
+  void OnStreamCloseImpl(std::int32_t stream_id, uint32_t error_code);
+  ssize_t OnDataSourceReadImpl(std::int32_t stream_id, uint8_t* buf,
+                               size_t length, uint32_t* data_flags);
+
+  // The following functions must be called with mutex_ locked
+  Stream* FindStream(std::int32_t stream_id);
+  bool FinishHeaders(Stream& stream);
+  void FinalizeRequest(std::int32_t stream_id, Stream& stream);
+  void ForgetStream(std::int32_t stream_id);
+  void CloseStreams();
+
+  /// Sends the pending frames. Only one task writes into the socket at a time
+  /// and it does so with the mutex unlocked, the other tasks just leave their
+  /// frames for it. Returns false if the connection is broken.
+  bool Flush(std::unique_lock<engine::Mutex>& lock);
+
+  const HandlerInfoIndex& handler_info_index_;
+  const HttpRequestConstructor::Config request_constructor_config_;
+  OnNewRequestCb on_new_request_cb_;
+  net::ParserStats& stats_;
+  request::ResponseDataAccounter& data_accounter_;
+  engine::io::Socket& socket_;
+  const std::chrono::milliseconds send_timeout_;
+
+  engine::Mutex mutex_;
+  SessionPtr session_;
+  std::unordered_map<std::int32_t, std::unique_ptr<Stream>> streams_;
+  std::unordered_map<const request::RequestBase*, std::int32_t>
+      request_streams_;
+  std::vector<std::shared_ptr<request::RequestBase>> finalized_requests_;
+  std::string out_buffer_;
+  bool is_sending_{false};
+  bool is_closed_{false};
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -98,7 +98,7 @@ void HttpRequestConstructor::ParseUrl() {
   const auto* handler_info = match_result.handler_info;
 
   request_->SetMatchedPathLength(match_result.matched_path_length);
-  request_->SetPathArgs(std::move(match_result.args_from_path));
+  request_->SetPathArgs(match_result.args_from_path);
 
   if (!handler_info && request_->GetMethod() == HttpMethod::kOptions &&
       match_result.status == MatchRequestResult::Status::kMethodNotAllowed) {
@@ -159,6 +159,22 @@ void HttpRequestConstructor::AppendHeaderValue(const char* data, size_t size) {
   header_value_.append(data, size);
 }
 
+void HttpRequestConstructor::AppendHeader(std::string_view name,
+                                          std::string_view value) {
+  UASSERT(!header_field_flag_);
+
+  AccountHeadersSize(name.size());
+  AccountRequestSize(name.size());
+  AccountHeadersSize(value.size());
+  AccountRequestSize(value.size());
+
+  auto [it, inserted] = request_->headers_.try_emplace(std::string{name}, value);
+  if (!inserted) {
+    it->second += ',';
+    it->second += value;
+  }
+}
+
 void HttpRequestConstructor::AppendBody(const char* data, size_t size) {
   AccountRequestSize(size);
   request_->request_body_.append(data, size);
@@ -240,8 +256,7 @@ void HttpRequestConstructor::ParseArgs(const http_parser_url& url) {
 }
 
 void HttpRequestConstructor::ParseArgs(const char* data, size_t size) {
-  return USERVER_NAMESPACE::http::parser::ParseArgs(
-      std::string_view(data, size), request_->request_args_);
+  request_->ParseArgs(std::string_view(data, size));
 }
 
 void HttpRequestConstructor::AddHeader() {
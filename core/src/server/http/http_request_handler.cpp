@@ -180,13 +180,15 @@ engine::TaskWithResult<void> HttpRequestHandler::StartRequestTask(
   }
 }  // namespace http
 
-void HttpRequestHandler::DisableAddHandler() { add_handler_disabled_ = true; }
+void HttpRequestHandler::DisableAddHandler() {
+  std::lock_guard<engine::Mutex> lock(handler_infos_mutex_);
+  if (add_handler_disabled_) return;
+  handler_info_index_.Compile();
+  add_handler_disabled_ = true;
+}
 
 void HttpRequestHandler::AddHandler(const handlers::HttpHandlerBase& handler,
                                     engine::TaskProcessor& task_processor) {
-  if (add_handler_disabled_) {
-    throw std::runtime_error("handler adding disabled");
-  }
   if (is_monitor_ != handler.IsMonitor()) {
     throw std::runtime_error(
         std::string("adding ") + (handler.IsMonitor() ? "" : "non-") +
@@ -194,6 +196,9 @@ void HttpRequestHandler::AddHandler(const handlers::HttpHandlerBase& handler,
         "monitor HttpRequestHandler");
   }
   std::lock_guard<engine::Mutex> lock(handler_infos_mutex_);
+  if (add_handler_disabled_) {
+    throw std::runtime_error("handler adding disabled");
+  }
   handler_info_index_.AddHandler(handler, task_processor);
 }
 
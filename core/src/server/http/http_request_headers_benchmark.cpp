@@ -19,9 +19,25 @@ const char* kHeadersArray[kHeadersCount] = {
     "TestHeader28", "TestHeader29", "TestHeader30", "TestHeader31",
 };
 
+using HeadersMap = server::http::HttpRequest::HeadersMap;
+
 void http_request_headers_insert(benchmark::State& state) {
   for (auto _ : state) {
-    server::http::HttpRequest::HeadersMap map;
+    HeadersMap map;
+
+    for (int i = 0; i < state.range(0); i++) map[kHeadersArray[i]] = "1";
+
+    benchmark::DoNotOptimize(map);
+  }
+}
+
+// The way HttpRequestImpl stores the headers
+void http_request_headers_insert_arena(benchmark::State& state) {
+  for (auto _ : state) {
+    alignas(std::max_align_t) std::byte buffer[2048];
+    utils::impl::MonotonicArena arena{buffer, sizeof(buffer)};
+    HeadersMap map{16, utils::StrIcaseHash{}, utils::StrIcaseEqual{},
+                   HeadersMap::allocator_type{arena}};
 
     for (int i = 0; i < state.range(0); i++) map[kHeadersArray[i]] = "1";
 
@@ -30,7 +46,7 @@ void http_request_headers_insert(benchmark::State& state) {
 }
 
 void http_request_headers_get(benchmark::State& state) {
-  server::http::HttpRequest::HeadersMap map;
+  HeadersMap map;
   for (std::size_t i = 0; i < kHeadersCount; i++) map[kHeadersArray[i]] = "1";
 
   std::size_t i = 0;
@@ -45,6 +61,10 @@ BENCHMARK(http_request_headers_insert)
     ->RangeMultiplier(2)
     ->Range(1, kHeadersCount);
 
+BENCHMARK(http_request_headers_insert_arena)
+    ->RangeMultiplier(2)
+    ->Range(1, kHeadersCount);
+
 BENCHMARK(http_request_headers_get);
 
 USERVER_NAMESPACE_END
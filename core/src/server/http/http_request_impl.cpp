@@ -64,12 +64,24 @@ std::string EscapeForAccessTskvLog(const std::string& str) {
 const std::string kEmptyString{};
 const std::vector<std::string> kEmptyVector{};
 
+// Requests rarely have more headers
+constexpr std::size_t kHeadersBucketsHint = 16;
+
 }  // namespace
 
 namespace server::http {
 
 HttpRequestImpl::HttpRequestImpl(request::ResponseDataAccounter& data_accounter)
-    : response_(*this, data_accounter) {}
+    : arena_(arena_buffer_, sizeof(arena_buffer_)),
+      request_args_(RequestArgs::allocator_type{arena_}),
+      path_args_(ArenaAllocator<std::string>{arena_}),
+      path_args_by_name_index_(
+          decltype(path_args_by_name_index_)::allocator_type{arena_}),
+      headers_(kHeadersBucketsHint, utils::StrIcaseHash{},
+               utils::StrIcaseEqual{},
+               HttpRequest::HeadersMap::allocator_type{arena_}),
+      cookies_(HttpRequest::CookiesMap::allocator_type{arena_}),
+      response_(*this, data_accounter) {}
 
 HttpRequestImpl::~HttpRequestImpl() = default;
 
@@ -148,10 +160,10 @@ std::vector<std::string> HttpRequestImpl::FormDataArgNames() const {
 
 const std::string& HttpRequestImpl::GetPathArg(
     const std::string& arg_name) const {
-  auto it = path_args_by_name_index_.find(arg_name);
-  if (it == path_args_by_name_index_.end()) return kEmptyString;
-  UASSERT(it->second < path_args_.size());
-  return path_args_[it->second];
+  const auto* index = FindPathArgIndex(arg_name);
+  if (!index) return kEmptyString;
+  UASSERT(*index < path_args_.size());
+  return path_args_[*index];
 }
 
 const std::string& HttpRequestImpl::GetPathArg(size_t index) const {
@@ -159,8 +171,7 @@ const std::string& HttpRequestImpl::GetPathArg(size_t index) const {
 }
 
 bool HttpRequestImpl::HasPathArg(const std::string& arg_name) const {
-  return path_args_by_name_index_.find(arg_name) !=
-         path_args_by_name_index_.end();
+  return FindPathArgIndex(arg_name) != nullptr;
 }
 
 bool HttpRequestImpl::HasPathArg(size_t index) const {
@@ -208,8 +219,13 @@ void HttpRequestImpl::SetRequestBody(std::string body) {
   request_body_ = std::move(body);
 }
 
-void HttpRequestImpl::ParseArgsFromBody() {
-  USERVER_NAMESPACE::http::parser::ParseArgs(request_body_, request_args_);
+void HttpRequestImpl::ParseArgsFromBody() { ParseArgs(request_body_); }
+
+void HttpRequestImpl::ParseArgs(std::string_view args) {
+  USERVER_NAMESPACE::http::parser::ParseAndConsumeArgs(
+      args, [this](std::string&& key, std::string&& value) {
+        request_args_[std::move(key)].push_back(std::move(value));
+      });
 }
 
 bool HttpRequestImpl::IsBodyCompressed() const {
@@ -217,20 +233,28 @@ bool HttpRequestImpl::IsBodyCompressed() const {
   return !encoding.empty() && encoding != "identity";
 }
 
-void HttpRequestImpl::SetPathArgs(
-    std::vector<std::pair<std::string, std::string>> args) {
+void HttpRequestImpl::SetPathArgs(const impl::PathArgs& args) {
   path_args_.clear();
   path_args_.reserve(args.size());
 
   path_args_by_name_index_.clear();
-  for (auto& [name, value] : args) {
-    path_args_.push_back(std::move(value));
+  for (const auto& [name, value] : args) {
+    path_args_.emplace_back(value);
     if (!name.empty()) {
-      path_args_by_name_index_[std::move(name)] = path_args_.size() - 1;
+      path_args_by_name_index_.emplace_back(name, path_args_.size() - 1);
     }
   }
 }
 
+const size_t* HttpRequestImpl::FindPathArgIndex(
+    std::string_view arg_name) const {
+  // there are just a few path args, linear search is the fastest
+  for (const auto& [name, index] : path_args_by_name_index_) {
+    if (name == arg_name) return &index;
+  }
+  return nullptr;
+}
+
 void HttpRequestImpl::SetMatchedPathLength(size_t length) {
   path_suffix_ = request_path_.substr(length);
 }
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -12,6 +14,9 @@
 #include <userver/server/http/http_request.hpp>
 #include <userver/server/http/http_response.hpp>
 #include <userver/server/request/request_base.hpp>
+#include <userver/utils/impl/monotonic_arena.hpp>
+
+#include <server/http/path_router.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -26,6 +31,11 @@ namespace http {
 class HttpRequestImpl final : public request::RequestBase {
  public:
   HttpRequestImpl(request::ResponseDataAccounter& data_accounter);
+  // The containers use the arena of the request and may not leave it
+  HttpRequestImpl(const HttpRequestImpl&) = delete;
+  HttpRequestImpl(HttpRequestImpl&&) = delete;
+  HttpRequestImpl& operator=(const HttpRequestImpl&) = delete;
+  HttpRequestImpl& operator=(HttpRequestImpl&&) = delete;
   ~HttpRequestImpl() override;
 
   const HttpMethod& GetMethod() const { return method_; }
@@ -99,7 +109,7 @@ class HttpRequestImpl final : public request::RequestBase {
                           std::chrono::system_clock::time_point tp,
                           const std::string& remote_address) const;
 
-  void SetPathArgs(std::vector<std::pair<std::string, std::string>> args);
+  void SetPathArgs(const impl::PathArgs& args);
 
   void SetMatchedPathLength(size_t length) override;
 
@@ -118,6 +128,24 @@ class HttpRequestImpl final : public request::RequestBase {
   friend class HttpRequestConstructor;
 
  private:
+  void ParseArgs(std::string_view args);
+  const size_t* FindPathArgIndex(std::string_view arg_name) const;
+
+  template <typename T>
+  using ArenaAllocator = utils::impl::ArenaAllocator<T>;
+
+  using RequestArgs = std::unordered_map<
+      std::string, std::vector<std::string>, std::hash<std::string>,
+      std::equal_to<std::string>,
+      ArenaAllocator<std::pair<const std::string, std::vector<std::string>>>>;
+
+  // Enough for the containers of a typical request, the arena grows on the
+  // heap for larger ones. The whole arena is freed with the request.
+  static constexpr std::size_t kArenaInitialSize = 2048;
+
+  alignas(std::max_align_t) std::byte arena_buffer_[kArenaInitialSize];
+  utils::impl::MonotonicArena arena_;
+
   // method_ = (orig_method_ == kHead ? kGet : orig_method_)
   HttpMethod method_{HttpMethod::kUnknown};
   HttpMethod orig_method_{HttpMethod::kUnknown};
@@ -127,10 +155,13 @@ class HttpRequestImpl final : public request::RequestBase {
   std::string request_path_;
   std::string request_body_;
   std::string path_suffix_;
-  std::unordered_map<std::string, std::vector<std::string>> request_args_;
+  RequestArgs request_args_;
   std::unordered_map<std::string, std::vector<FormDataArg>> form_data_args_;
-  std::vector<std::string> path_args_;
-  std::unordered_map<std::string, size_t> path_args_by_name_index_;
+  std::vector<std::string, ArenaAllocator<std::string>> path_args_;
+  // names are views into the HandlerInfoIndex that outlives the request
+  std::vector<std::pair<std::string_view, size_t>,
+              ArenaAllocator<std::pair<std::string_view, size_t>>>
+      path_args_by_name_index_;
   HttpRequest::HeadersMap headers_;
   HttpRequest::CookiesMap cookies_;
   bool is_final_{false};
@@ -34,6 +34,8 @@ HttpMethod ConvertHttpMethod(http_method method) {
   }
 }
 
+static_assert(impl::kMaxRequestHeadSize < HTTP_MAX_HEADER_SIZE);
+
 }  // namespace
 
 const http_parser_settings HttpRequestParser::parser_settings = []() {
@@ -63,6 +65,38 @@ HttpRequestParser::HttpRequestParser(
 }
 
 bool HttpRequestParser::Parse(const char* data, size_t size) {
+  const std::string_view input(data, size);
+  std::size_t pos = 0;
+  while (pos < input.size() &&
+         (!request_constructor_ || is_request_head_parsed_)) {
+    if (request_constructor_) {
+      const auto body = input.substr(pos, body_bytes_left_);
+      pos += body.size();
+      if (!OnRequestHeadBody(body)) return false;
+      continue;
+    }
+
+    // http_parser skips them between the requests
+    if (input[pos] == '\r' || input[pos] == '\n') {
+      ++pos;
+      continue;
+    }
+    if (connection_closed_) {
+      LOG_WARNING() << "data received after the connection close";
+      FinalizeRequest();
+      return false;
+    }
+
+    if (!impl::ParseRequestHead(input.substr(pos), request_head_)) break;
+    pos += request_head_.size;
+    if (!OnRequestHead()) return false;
+  }
+
+  if (pos && pos == input.size()) return true;
+  return ParseWithHttpParser(data + pos, size - pos);
+}
+
+bool HttpRequestParser::ParseWithHttpParser(const char* data, size_t size) {
   size_t parsed = http_parser_execute(&parser_, &parser_settings, data, size);
   if (parsed != size) {
     LOG_WARNING() << "parsed=" << parsed << " size=" << size
@@ -79,6 +113,72 @@ bool HttpRequestParser::Parse(const char* data, size_t size) {
   return true;
 }
 
+bool HttpRequestParser::OnRequestHead() {
+  const auto& head = request_head_;
+  LOG_TRACE() << "message begin";
+  CreateRequestConstructor();
+  is_request_head_parsed_ = true;
+  body_bytes_left_ = head.content_length;
+
+  LOG_TRACE() << "url: '" << head.url << '\'';
+  request_constructor_->SetMethod(head.method);
+  try {
+    request_constructor_->AppendUrl(head.url.data(), head.url.size());
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append url: " << ex;
+    return FailRequestHead();
+  }
+  if (!CheckUrlComplete(head.method, 1, head.http_minor)) {
+    return FailRequestHead();
+  }
+
+  for (const auto& [name, value] : head.headers) {
+    LOG_TRACE() << "header: '" << name << "': '" << value << '\'';
+    try {
+      request_constructor_->AppendHeader(name, value);
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "can't append header: " << ex;
+      return FailRequestHead();
+    }
+  }
+  LOG_TRACE() << "headers complete";
+
+  if (!body_bytes_left_) return OnRequestHeadMessageComplete();
+  return true;
+}
+
+bool HttpRequestParser::OnRequestHeadBody(std::string_view data) {
+  UASSERT(request_constructor_);
+  LOG_TRACE() << "body: '" << data << "'";
+  try {
+    request_constructor_->AppendBody(data.data(), data.size());
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't append body: " << ex;
+    return FailRequestHead();
+  }
+  body_bytes_left_ -= data.size();
+
+  if (!body_bytes_left_) return OnRequestHeadMessageComplete();
+  return true;
+}
+
+bool HttpRequestParser::OnRequestHeadMessageComplete() {
+  UASSERT(request_constructor_);
+  is_request_head_parsed_ = false;
+  connection_closed_ = !request_head_.keep_alive;
+  request_constructor_->SetIsFinal(connection_closed_);
+  LOG_TRACE() << "message complete";
+  // the request is finalized even on failure, do not fail it once again
+  return FinalizeRequest();
+}
+
+bool HttpRequestParser::FailRequestHead() {
+  // same as a failed http_parser callback
+  is_request_head_parsed_ = false;
+  FinalizeRequest();
+  return false;
+}
+
 int HttpRequestParser::OnMessageBegin(http_parser* p) {
   auto* http_request_parser = static_cast<HttpRequestParser*>(p->data);
   UASSERT(http_request_parser != nullptr);
@@ -205,7 +305,8 @@ int HttpRequestParser::OnMessageCompleteImpl(http_parser* p) {
     LOG_WARNING() << "upgrade detected";
     return -1;  // error
   }
-  request_constructor_->SetIsFinal(!http_should_keep_alive(p));
+  connection_closed_ = !http_should_keep_alive(p);
+  request_constructor_->SetIsFinal(connection_closed_);
   if (!CheckUrlComplete(p)) return -1;
   LOG_TRACE() << "message complete";
   if (!FinalizeRequest()) return -1;
@@ -220,12 +321,19 @@ void HttpRequestParser::CreateRequestConstructor() {
 }
 
 bool HttpRequestParser::CheckUrlComplete(http_parser* p) {
+  return CheckUrlComplete(
+      ConvertHttpMethod(static_cast<http_method>(p->method)), p->http_major,
+      p->http_minor);
+}
+
+bool HttpRequestParser::CheckUrlComplete(HttpMethod method,
+                                         unsigned short http_major,
+                                         unsigned short http_minor) {
   if (url_complete_) return true;
   url_complete_ = true;
-  request_constructor_->SetMethod(
-      ConvertHttpMethod(static_cast<http_method>(p->method)));
-  request_constructor_->SetHttpMajor(p->http_major);
-  request_constructor_->SetHttpMinor(p->http_minor);
+  request_constructor_->SetMethod(method);
+  request_constructor_->SetHttpMajor(http_major);
+  request_constructor_->SetHttpMinor(http_minor);
   try {
     request_constructor_->ParseUrl();
   } catch (const std::exception& ex) {
@@ -4,9 +4,11 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <string_view>
 
 #include <http_parser.h>
 
+#include <server/http/request_head_parser.hpp>
 #include <server/net/stats.hpp>
 #include <server/request/request_parser.hpp>
 
@@ -50,9 +52,19 @@ class HttpRequestParser final : public request::RequestParser {
   int OnBodyImpl(http_parser* p, const char* data, size_t size);
   int OnMessageCompleteImpl(http_parser* p);
 
+  // Requests with a complete and usual head are parsed by
+  // impl::ParseRequestHead, the rest are left to http_parser
+  bool ParseWithHttpParser(const char* data, size_t size);
+  bool OnRequestHead();
+  bool OnRequestHeadBody(std::string_view data);
+  bool OnRequestHeadMessageComplete();
+  bool FailRequestHead();
+
   void CreateRequestConstructor();
 
   bool CheckUrlComplete(http_parser* p);
+  bool CheckUrlComplete(HttpMethod method, unsigned short http_major,
+                        unsigned short http_minor);
 
   bool FinalizeRequest();
   bool FinalizeRequestImpl();
@@ -67,6 +79,12 @@ class HttpRequestParser final : public request::RequestParser {
   http_parser parser_{};
   std::optional<HttpRequestConstructor> request_constructor_;
 
+  impl::RequestHead request_head_;
+  // the current request head was parsed by impl::ParseRequestHead
+  bool is_request_head_parsed_ = false;
+  std::size_t body_bytes_left_ = 0;
+  bool connection_closed_ = false;
+
   static const http_parser_settings parser_settings;
   net::ParserStats& stats_;
   request::ResponseDataAccounter& data_accounter_;
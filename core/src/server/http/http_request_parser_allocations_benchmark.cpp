@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <fmt/format.h>
+
+#include <userver/engine/run_standalone.hpp>
+
+#include <server/http/http_request_parser.hpp>
+#include <utils/gbench_allocations.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::string_view kTypicalRequest =
+    "GET /v1/service/items/details?item_id=a8e4c5f2&lang=en&fields=name%2Cprice"
+    " HTTP/1.1\r\n"
+    "Host: service.example.com\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36\r\n"
+    "Accept: application/json\r\n"
+    "Accept-Encoding: gzip, deflate, br\r\n"
+    "Accept-Language: en-US,en;q=0.9\r\n"
+    "X-Request-Id: 6f1c0b6a2a0c4d1e9f3b7a8c5d2e4f60\r\n"
+    "X-YaTraceId: 0f1e2d3c4b5a69788796a5b4c3d2e1f0\r\n"
+    "X-YaSpanId: 0123456789abcdef\r\n"
+    "Cookie: session=3b1f5e7a9c2d4f6b8a0c1e3d5f7b9a1c; theme=dark\r\n"
+    "Connection: keep-alive\r\n"
+    "\r\n";
+
+// Edge-like request: many headers and a large cookie
+std::string MakeHeaderHeavyRequest() {
+  std::string request{kTypicalRequest.substr(0, kTypicalRequest.find("\r\n"))};
+  request += "\r\n";
+  for (int i = 0; i < 30; ++i) {
+    request += fmt::format("X-Edge-Header-{}: value-{}-{}\r\n", i, i,
+                           std::string(40, 'a' + i % 26));
+  }
+  request += "Cookie: ";
+  for (int i = 0; i < 64; ++i) {
+    request += fmt::format("cookie_{}={}; ", i, std::string(48, 'c'));
+  }
+  request += "last=1\r\n\r\n";
+  return request;
+}
+
+// Whole request parsing, reports allocations per request
+void RunParseBenchmark(benchmark::State& state, std::string_view request) {
+  engine::RunStandalone([&] {
+    const server::http::HandlerInfoIndex handler_info_index;
+    const server::request::HttpRequestConfig request_config{
+        /*.max_url_size = */ 8192,
+        /*.max_request_size = */ 1024 * 1024,
+        /*.max_headers_size = */ 65536,
+        /*.parse_args_from_body = */ false,
+        /*.testing_mode = */ true,  // parse requests without handlers
+        /*.decompress_request = */ false,
+    };
+    server::net::ParserStats stats;
+    server::request::ResponseDataAccounter accounter;
+
+    std::size_t parsed = 0;
+    server::http::HttpRequestParser parser(
+        handler_info_index, request_config,
+        [&parsed](std::shared_ptr<server::request::RequestBase>&& request) {
+          benchmark::DoNotOptimize(request);
+          ++parsed;
+        },
+        stats, accounter);
+
+    const auto allocations_before = utils::impl::GetThreadAllocationsCount();
+    for (auto _ : state) {
+      parser.Parse(request.data(), request.size());
+    }
+    const auto allocations =
+        utils::impl::GetThreadAllocationsCount() - allocations_before;
+
+    if (parsed != static_cast<std::size_t>(state.iterations())) {
+      state.SkipWithError("Failed to parse the request");
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * request.size());
+    state.counters["allocs_per_request"] = benchmark::Counter(
+        static_cast<double>(allocations) / state.iterations());
+  });
+}
+
+}  // namespace
+
+void http_request_parse_typical(benchmark::State& state) {
+  RunParseBenchmark(state, kTypicalRequest);
+}
+BENCHMARK(http_request_parse_typical);
+
+void http_request_parse_header_heavy(benchmark::State& state) {
+  RunParseBenchmark(state, MakeHeaderHeavyRequest());
+}
+BENCHMARK(http_request_parse_header_heavy);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,89 @@
+#include <userver/utest/utest.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <server/http/http_request_impl.hpp>
+#include <server/http/http_request_parser.hpp>
+
+#include "create_parser_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using RequestPtr = std::shared_ptr<server::http::HttpRequestImpl>;
+
+auto CreateCollectingParser(std::vector<RequestPtr>& requests) {
+  return server::CreateTestParser(
+      [&requests](std::shared_ptr<server::request::RequestBase>&& request) {
+        requests.push_back(
+            std::dynamic_pointer_cast<server::http::HttpRequestImpl>(request));
+      });
+}
+
+}  // namespace
+
+// Requests with the usual heads and the rest of the requests are handled by
+// the different parsers, and may be freely mixed in a connection
+UTEST(HttpRequestParser, Pipelined) {
+  const std::string_view first =
+      "POST /first?a=1 HTTP/1.1\r\n"
+      "X-Header: 1\r\n"
+      "x-header: 2\r\n"
+      "Content-Length: 9\r\n"
+      "\r\n"
+      "body-1234";
+  const std::string_view second =
+      "POST /second HTTP/1.1\r\n"
+      "Transfer-Encoding: chunked\r\n"
+      "\r\n"
+      "4\r\nbody\r\n0\r\n\r\n";
+  const std::string_view third = "GET /third HTTP/1.0\r\n\r\n";
+
+  std::string data{first};
+  data += second;
+  data += third;
+
+  // split at every position, including the middle of the fast-parsed body
+  for (std::size_t split = 1; split < data.size(); ++split) {
+    std::vector<RequestPtr> requests;
+    auto parser = CreateCollectingParser(requests);
+    ASSERT_TRUE(parser.Parse(data.data(), split)) << split;
+    ASSERT_TRUE(parser.Parse(data.data() + split, data.size() - split))
+        << split;
+
+    ASSERT_EQ(requests.size(), 3) << split;
+    EXPECT_EQ(requests[0]->GetUrl(), "/first?a=1");
+    EXPECT_EQ(requests[0]->GetArg("a"), "1");
+    EXPECT_EQ(requests[0]->GetHeader("X-Header"), "1,2");
+    EXPECT_EQ(requests[0]->RequestBody(), "body-1234");
+    EXPECT_FALSE(requests[0]->IsFinal());
+
+    EXPECT_EQ(requests[1]->GetUrl(), "/second");
+    EXPECT_EQ(requests[1]->RequestBody(), "body");
+    EXPECT_FALSE(requests[1]->IsFinal());
+
+    EXPECT_EQ(requests[2]->GetUrl(), "/third");
+    EXPECT_EQ(requests[2]->GetHttpMinor(), 0);
+    EXPECT_TRUE(requests[2]->IsFinal());
+  }
+}
+
+UTEST(HttpRequestParser, DataAfterClose) {
+  const std::string_view data =
+      "GET / HTTP/1.1\r\n"
+      "Connection: close\r\n"
+      "\r\n"
+      "\r\n"
+      "GET / HTTP/1.1\r\n\r\n";
+
+  std::vector<RequestPtr> requests;
+  auto parser = CreateCollectingParser(requests);
+  EXPECT_FALSE(parser.Parse(data.data(), data.size()));
+  ASSERT_FALSE(requests.empty());
+  EXPECT_TRUE(requests[0]->IsFinal());
+}
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,9 @@
 #include <userver/server/http/http_response.hpp>
 
+#include <algorithm>
 #include <array>
+#include <climits>
+#include <vector>
 
 #include <cctz/time_zone.h>
 #include <fmt/compile.h>
@@ -17,6 +20,7 @@
 #include <userver/utils/assert.hpp>
 #include <userver/utils/userver_info.hpp>
 
+#include "http2_session.hpp"
 #include "http_request_impl.hpp"
 
 USERVER_NAMESPACE_BEGIN
@@ -65,12 +69,72 @@ void CheckHeaderValue(std::string_view value) {
   }
 }
 
+std::string FormatDate() {
+  static const std::string kFormatString = "%a, %d %b %Y %H:%M:%S %Z";
+  static const auto tz = cctz::utc_time_zone();
+  return cctz::format(kFormatString, std::chrono::system_clock::now(), tz);
+}
+
+// HTTP/2 does its own framing and connection management, RFC 7540 8.1.2.2
+bool IsConnectionSpecificHeader(std::string_view name) {
+  static constexpr std::array<std::string_view, 5> kHeaders{
+      USERVER_NAMESPACE::http::headers::kConnection,
+      USERVER_NAMESPACE::http::headers::kTransferEncoding,
+      "Keep-Alive",
+      "Proxy-Connection",
+      "Upgrade",
+  };
+  return std::any_of(kHeaders.begin(), kHeaders.end(), [name](auto header) {
+    return utils::StrIcaseEqual{}(name, header);
+  });
+}
+
+// HTTP/2 header names must be in lowercase, RFC 7540 8.1.2
+std::string ToLowerHeaderName(std::string_view name) {
+  std::string result{name};
+  for (auto& c : result) {
+    if (c >= 'A' && c <= 'Z') c = c - 'A' + 'a';
+  }
+  return result;
+}
+
 bool IsBodyForbiddenForStatus(server::http::HttpStatus status) {
   return status == server::http::HttpStatus::kNoContent ||
          status == server::http::HttpStatus::kNotModified ||
          (static_cast<int>(status) >= 100 && static_cast<int>(status) < 200);
 }
 
+// Limits the iovec count of a single write of a streamed body
+constexpr std::size_t kMaxChunksPerWrite = 64;
+
+constexpr std::string_view kTerminatingChunk = "\r\n0\r\n\r\n";
+
+// Sends the not yet sent part of the headers, the chunks and the terminating
+// chunk (if the body is finished) with a single writev()
+size_t SendChunks(engine::io::Socket& socket, std::string_view header,
+                  const std::vector<std::string>& body_parts,
+                  bool is_finished) {
+  std::vector<std::string> sizes;
+  sizes.reserve(body_parts.size());
+  std::vector<engine::io::IoData> io_data;
+  io_data.reserve(body_parts.size() * 2 + 2);
+
+  if (!header.empty()) io_data.push_back({header.data(), header.size()});
+  for (const auto& body_part : body_parts) {
+    // Chunk size line also terminates the previous chunk or the headers
+    const auto& size =
+        sizes.emplace_back(fmt::format("\r\n{:x}\r\n", body_part.size()));
+    io_data.push_back({size.data(), size.size()});
+    io_data.push_back({body_part.data(), body_part.size()});
+  }
+  if (is_finished) {
+    io_data.push_back({kTerminatingChunk.data(), kTerminatingChunk.size()});
+  }
+
+  if (io_data.empty()) return 0;
+  return socket.SendAll(io_data.data(), io_data.size(), {});
+}
+
 }  // namespace
 
 namespace server::http {
@@ -166,7 +230,7 @@ void HttpResponse::SetHeadersEnd() { headers_end_.Send(); }
 
 bool HttpResponse::WaitForHeadersEnd() { return headers_end_.WaitForEvent(); }
 
-void HttpResponse::SendResponse(engine::io::Socket& socket) {
+std::string HttpResponse::SerializeHeaders() {
   // According to https://www.chromium.org/spdy/spdy-whitepaper/
   // "typical header sizes of 700-800 bytes is common"
   // Adjusting it to 1KiB to fit jemalloc size class
@@ -185,13 +249,8 @@ void HttpResponse::SendResponse(engine::io::Socket& socket) {
   headers_.erase(USERVER_NAMESPACE::http::headers::kContentLength);
   const auto end = headers_.cend();
   if (headers_.find(USERVER_NAMESPACE::http::headers::kDate) == end) {
-    static const std::string kFormatString = "%a, %d %b %Y %H:%M:%S %Z";
-    static const auto tz = cctz::utc_time_zone();
-    const auto& time_str =
-        cctz::format(kFormatString, std::chrono::system_clock::now(), tz);
-
     impl::OutputHeader(header, USERVER_NAMESPACE::http::headers::kDate,
-                       time_str);
+                       FormatDate());
   }
   if (headers_.find(USERVER_NAMESPACE::http::headers::kContentType) == end) {
     impl::OutputHeader(header, USERVER_NAMESPACE::http::headers::kContentType,
@@ -211,14 +270,134 @@ void HttpResponse::SendResponse(engine::io::Socket& socket) {
     header.append(kCrlf);
   }
 
-  if (IsBodyStreamed())
+  return header;
+}
+
+void HttpResponse::SendResponse(engine::io::Socket& socket) {
+  if (IsBodyStreamed()) {
+    auto header = SerializeHeaders();
     SetBodyStreamed(socket, header);
-  else
-    SetBodyNotstreamed(socket, header);
+  } else {
+    SendResponses(socket, {this});
+  }
+}
+
+void HttpResponse::SendResponses(engine::io::Socket& socket,
+                                 const std::vector<HttpResponse*>& responses) {
+  UASSERT(!responses.empty());
+
+  std::vector<std::string> headers;
+  std::vector<std::string_view> bodies;
+  headers.reserve(responses.size());
+  bodies.reserve(responses.size());
+  for (auto* response : responses) {
+    UASSERT(!response->IsBodyStreamed());
+    headers.push_back(response->SerializeHeaders());
+    bodies.push_back(response->FinishHeadersNotstreamed(headers.back()));
+  }
+
+  std::vector<engine::io::IoData> io_data;
+  io_data.reserve(responses.size() * 2);
+  for (std::size_t i = 0; i < responses.size(); ++i) {
+    io_data.push_back({headers[i].data(), headers[i].size()});
+    if (!bodies[i].empty()) {
+      io_data.push_back({bodies[i].data(), bodies[i].size()});
+    }
+  }
+
+  // All the responses go into a single writev() unless there are too many
+  std::size_t sent_iovs = 0;
+  while (sent_iovs < io_data.size()) {
+    const auto iovs_count =
+        std::min<std::size_t>(io_data.size() - sent_iovs, IOV_MAX);
+    [[maybe_unused]] const auto sent_bytes =
+        socket.SendAll(io_data.data() + sent_iovs, iovs_count, {});
+    sent_iovs += iovs_count;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < responses.size(); ++i) {
+    responses[i]->SetSentTime(now);
+    responses[i]->SetSent(headers[i].size() + bodies[i].size());
+  }
 }
 
-void HttpResponse::SetBodyNotstreamed(engine::io::Socket& socket,
-                                      std::string& header) {
+void HttpResponse::SendResponse(Http2Session& session,
+                                std::int32_t stream_id) {
+  Http2Session::Headers headers;
+  headers.reserve(headers_.size() + cookies_.size() + 3);
+
+  headers_.erase(USERVER_NAMESPACE::http::headers::kContentLength);
+  const auto end = headers_.cend();
+  if (headers_.find(USERVER_NAMESPACE::http::headers::kDate) == end) {
+    headers.emplace_back("date", FormatDate());
+  }
+  if (headers_.find(USERVER_NAMESPACE::http::headers::kContentType) == end) {
+    headers.emplace_back("content-type", kDefaultContentTypeString);
+  }
+  for (const auto& [name, value] : headers_) {
+    if (IsConnectionSpecificHeader(name)) continue;
+    headers.emplace_back(ToLowerHeaderName(name), value);
+  }
+  for (const auto& cookie : cookies_) {
+    std::string value;
+    cookie.second.AppendToString(value);
+    headers.emplace_back("set-cookie", std::move(value));
+  }
+
+  const auto status = static_cast<int>(status_);
+  bool is_submitted = false;
+  if (IsBodyStreamed()) {
+    is_submitted = session.SubmitResponse(stream_id, status, headers, {},
+                                          /*is_body_streamed=*/true);
+
+    std::string body_part;
+    while (is_submitted && body_stream_->Pop(body_part)) {
+      if (body_part.empty()) {
+        LOG_DEBUG() << "Zero size body_part in http_response.cpp";
+        continue;
+      }
+      is_submitted = session.PushBodyChunk(stream_id, std::move(body_part));
+    }
+    if (is_submitted) is_submitted = session.FinishBody(stream_id);
+
+    body_stream_producer_.reset();
+    body_stream_.reset();
+  } else {
+    const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
+    const bool is_head_request = request_.GetOrigMethod() == HttpMethod::kHead;
+    const auto& data = GetData();
+
+    if (!is_body_forbidden) {
+      headers.emplace_back("content-length",
+                           fmt::format(FMT_COMPILE("{}"), data.size()));
+    } else if (!data.empty()) {
+      LOG_LIMITED_WARNING()
+          << "Non-empty body provided for response with HTTP code "
+          << static_cast<int>(status_)
+          << " which does not allow one, it will be dropped";
+    }
+
+    std::string_view body;
+    if (!is_head_request && !is_body_forbidden) body = data;
+    is_submitted = session.SubmitResponse(stream_id, status, headers, body,
+                                          /*is_body_streamed=*/false);
+  }
+
+  const auto sent_bytes = is_submitted ? session.WaitForStreamClose(stream_id)
+                                       : std::nullopt;
+  if (!sent_bytes) {
+    LOG_DEBUG() << "HTTP/2 stream " << stream_id
+                << " was closed before the response was sent";
+    SetSendFailed(std::chrono::steady_clock::now());
+    return;
+  }
+
+  SetSentTime(std::chrono::steady_clock::now());
+  SetSent(*sent_bytes);
+}
+
+std::string_view HttpResponse::FinishHeadersNotstreamed(std::string& header) {
   const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
   const bool is_head_request = request_.GetOrigMethod() == HttpMethod::kHead;
   const auto& data = GetData();
@@ -236,18 +415,8 @@ void HttpResponse::SetBodyNotstreamed(engine::io::Socket& socket,
         << " which does not allow one, it will be dropped";
   }
 
-  ssize_t sent_bytes = 0;
-  if (!is_head_request && !is_body_forbidden) {
-    sent_bytes = socket.SendAll(
-        {{header.data(), header.size()}, {data.data(), data.size()}},
-        engine::Deadline{});
-  } else {
-    sent_bytes =
-        socket.SendAll(header.data(), header.size(), engine::Deadline{});
-  }
-
-  SetSentTime(std::chrono::steady_clock::now());
-  SetSent(sent_bytes);
+  if (is_head_request || is_body_forbidden) return {};
+  return data;
 }
 
 void HttpResponse::SetBodyStreamed(engine::io::Socket& socket,
@@ -255,29 +424,49 @@ void HttpResponse::SetBodyStreamed(engine::io::Socket& socket,
   impl::OutputHeader(
       header, USERVER_NAMESPACE::http::headers::kTransferEncoding, "chunked");
 
-  // send HTTP headers
-  size_t sent_bytes = socket.SendAll(header.data(), header.size(), {});
-
-  std::string().swap(header);  // free memory before time consuming operation
-
-  // Transmit HTTP response body
   std::string body_part;
-
-  while (body_stream_->Pop(body_part)) {
-    if (body_part.empty()) {
-      LOG_DEBUG() << "Zero size body_part in http_response.cpp";
-      continue;
+  std::vector<std::string> body_parts;
+  body_parts.reserve(kMaxChunksPerWrite);
+  const auto pop_ready_body_parts = [&] {
+    while (body_parts.size() < kMaxChunksPerWrite &&
+           body_stream_->PopNoblock(body_part)) {
+      if (body_part.empty()) {
+        LOG_DEBUG() << "Zero size body_part in http_response.cpp";
+        continue;
+      }
+      body_parts.push_back(std::move(body_part));
     }
+  };
 
-    auto size = fmt::format("\r\n{:x}\r\n", body_part.size());
-    sent_bytes += socket.SendAll(
-        {{size.data(), size.size()}, {body_part.data(), body_part.size()}},
-        engine::Deadline{});
+  // The chunks that are already produced go along with the HTTP headers.
+  // Otherwise the headers are sent right away, the body may take a while.
+  size_t sent_bytes = 0;
+  pop_ready_body_parts();
+  if (body_parts.empty()) {
+    sent_bytes += socket.SendAll(header.data(), header.size(), {});
+    std::string().swap(header);  // free memory before time consuming operation
   }
 
-  const constexpr std::string_view terminating_chunk{"\r\n0\r\n\r\n"};
-  sent_bytes +=
-      socket.SendAll(terminating_chunk.data(), terminating_chunk.size(), {});
+  // Transmit HTTP response body, everything produced while the previous write
+  // was in progress is sent with a single write
+  bool is_finished = false;
+  while (!is_finished) {
+    if (body_parts.empty()) {
+      if (!body_stream_->Pop(body_part)) {
+        is_finished = true;
+      } else if (body_part.empty()) {
+        LOG_DEBUG() << "Zero size body_part in http_response.cpp";
+        continue;
+      } else {
+        body_parts.push_back(std::move(body_part));
+        pop_ready_body_parts();
+      }
+    }
+
+    sent_bytes += SendChunks(socket, header, body_parts, is_finished);
+    std::string().swap(header);
+    body_parts.clear();
+  }
 
   // TODO: exceptions?
   body_stream_producer_.reset();
@@ -1,9 +1,21 @@
 #include <benchmark/benchmark.h>
 
-#include <fmt/compile.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
 #include <sstream>
+#include <string>
+#include <vector>
+
+#include <fmt/compile.h>
 
+#include <server/http/http_request_impl.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
 #include <userver/http/common_headers.hpp>
+#include <userver/internal/net/net_listener.hpp>
 #include <userver/server/http/http_response.hpp>
 #include <userver/server/http/http_status.hpp>
 
@@ -65,9 +77,134 @@ void http_headers_serialization_ostreams(benchmark::State& state) {
   }
 }
 
+constexpr auto kMaxTestWaitTime = std::chrono::seconds{60};
+
+// Number of write syscalls made by the process, Linux only
+std::size_t GetWriteSyscallsCount() {
+  std::ifstream io_stats{"/proc/self/io"};
+  std::string key;
+  std::size_t value = 0;
+  while (io_stats >> key >> value) {
+    if (key == "syscw:") return value;
+  }
+  return 0;
+}
+
+// Sends responses to a socket which is drained by a background task and
+// reports the write syscalls made per response
+class ResponseSender final {
+ public:
+  ResponseSender() {
+    const auto deadline = engine::Deadline::FromDuration(kMaxTestWaitTime);
+    auto [server, client] =
+        internal::net::TcpListener{}.MakeSocketPair(deadline);
+    server_ = std::move(server);
+    reader_ = engine::AsyncNoSpan(
+        [this](auto&& client) {
+          std::array<char, 16 * 1024> buf{};
+          while (client.RecvSome(buf.data(), buf.size(), {}) > 0 &&
+                 is_reading_) {
+          }
+        },
+        std::move(client));
+  }
+
+  ~ResponseSender() {
+    is_reading_ = false;
+    server_.Close();
+    reader_.Get();
+  }
+
+  engine::io::Socket& GetSocket() { return server_; }
+
+  template <typename Func>
+  void Run(benchmark::State& state, std::size_t responses, Func send) {
+    const auto syscalls_before = GetWriteSyscallsCount();
+    for (auto _ : state) {
+      std::vector<std::unique_ptr<server::http::HttpResponse>> batch;
+      batch.reserve(responses);
+      for (std::size_t i = 0; i < responses; ++i) {
+        batch.push_back(
+            std::make_unique<server::http::HttpResponse>(request_, accounter_));
+      }
+      send(batch);
+    }
+    const auto syscalls = GetWriteSyscallsCount() - syscalls_before;
+
+    state.SetItemsProcessed(state.iterations() * responses);
+    state.counters["syscalls_per_request"] = benchmark::Counter(
+        static_cast<double>(syscalls) / (state.iterations() * responses));
+  }
+
+ private:
+  server::request::ResponseDataAccounter accounter_;
+  server::http::HttpRequestImpl request_{accounter_};
+  engine::io::Socket server_;
+  std::atomic<bool> is_reading_{true};
+  engine::TaskWithResult<void> reader_;
+};
+
+const std::string kBody(512, 'x');
+
 }  // namespace
 
 BENCHMARK(http_headers_serialization_no_ostreams);
 BENCHMARK(http_headers_serialization_ostreams);
 
+// Pipelined responses written one by one
+void http_response_send_pipelined_separately(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    ResponseSender sender;
+    sender.Run(state, state.range(0), [&sender](auto& batch) {
+      for (auto& response : batch) {
+        response->SetData(kBody);
+        response->SendResponse(sender.GetSocket());
+      }
+    });
+  });
+}
+BENCHMARK(http_response_send_pipelined_separately)
+    ->RangeMultiplier(4)
+    ->Range(1, 32);
+
+// Pipelined responses coalesced into a single write
+void http_response_send_pipelined_coalesced(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    ResponseSender sender;
+    sender.Run(state, state.range(0), [&sender](auto& batch) {
+      std::vector<server::http::HttpResponse*> responses;
+      responses.reserve(batch.size());
+      for (auto& response : batch) {
+        response->SetData(kBody);
+        responses.push_back(response.get());
+      }
+      server::http::HttpResponse::SendResponses(sender.GetSocket(), responses);
+    });
+  });
+}
+BENCHMARK(http_response_send_pipelined_coalesced)
+    ->RangeMultiplier(4)
+    ->Range(1, 32);
+
+// Streamed response with all the chunks produced before the send
+void http_response_send_streamed(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    ResponseSender sender;
+    const auto chunks = state.range(0);
+    sender.Run(state, 1, [&sender, chunks](auto& batch) {
+      auto& response = *batch.front();
+      response.SetStreamBody();
+      {
+        auto producer = response.GetBodyProducer();
+        for (int i = 0; i < chunks; ++i) {
+          [[maybe_unused]] const auto pushed =
+              producer.Push(std::string{kBody});
+        }
+      }
+      response.SendResponse(sender.GetSocket());
+    });
+  });
+}
+BENCHMARK(http_response_send_streamed)->RangeMultiplier(4)->Range(1, 64);
+
 USERVER_NAMESPACE_END
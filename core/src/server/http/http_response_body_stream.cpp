@@ -1,18 +1,46 @@
 #include <userver/server/http/http_response_body_stream.hpp>
 
+#include <compression/compressor.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
 
 ResponseBodyStream::ResponseBodyStream(
     server::http::HttpResponse::Queue::Producer&& queue_producer,
-    server::http::HttpResponse& http_response)
+    server::http::HttpResponse& http_response,
+    std::unique_ptr<compression::Compressor> compressor)
     : queue_producer_(std::move(queue_producer)),
-      http_response_(http_response) {}
+      http_response_(http_response),
+      compressor_(std::move(compressor)) {}
+
+ResponseBodyStream::ResponseBodyStream(ResponseBodyStream&&) noexcept =
+    default;
+
+ResponseBodyStream::~ResponseBodyStream() {
+  if (!compressor_ || !headers_ended_) return;
+
+  try {
+    std::string tail;
+    compressor_->Finish(tail);
+    queue_producer_.Push(std::move(tail));
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to complete the compressed response body: " << ex;
+  }
+}
 
 void ResponseBodyStream::PushBodyChunk(std::string&& chunk) {
   UASSERT_MSG(headers_ended_,
               "SetEndOfHeaders() was not called before PushBodyChunk()");
+  if (compressor_) {
+    if (chunk.empty()) return;
+    std::string compressed;
+    compressor_->Compress(chunk, compressed, /*flush=*/true);
+    queue_producer_.Push(std::move(compressed));
+    return;
+  }
   queue_producer_.Push(std::move(chunk));
 }
 
@@ -22,7 +50,24 @@ void ResponseBodyStream::SetHeader(const std::string& name,
   http_response_.SetHeader(name, value);
 }
 
-void ResponseBodyStream::SetEndOfHeaders() { headers_ended_ = true; }
+void ResponseBodyStream::SetEndOfHeaders() {
+  if (compressor_) {
+    const auto status = http_response_.GetStatus();
+    const bool has_no_body = status == HttpStatus::kNoContent ||
+                             status == HttpStatus::kNotModified;
+    const bool is_encoded = http_response_.HasHeader(
+        USERVER_NAMESPACE::http::headers::kContentEncoding);
+    if (has_no_body || is_encoded) {
+      // The handler has encoded the body itself or there is no body
+      compressor_.reset();
+    } else {
+      http_response_.SetHeader(
+          USERVER_NAMESPACE::http::headers::kContentEncoding,
+          std::string{compression::ToString(compressor_->GetEncoding())});
+    }
+  }
+  headers_ended_ = true;
+}
 
 void ResponseBodyStream::SetStatusCode(int status_code) {
   UINVARIANT(
@@ -79,4 +79,78 @@ UTEST_P(HttpResponseBody, ForbiddenBody) {
 INSTANTIATE_UTEST_SUITE_P(HttpResponseForbiddenBody, HttpResponseBody,
                           testing::Values(100, 101, 150, 199, 304, 204));
 
+UTEST(HttpResponse, StreamedBody) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+  response.SetStreamBody();
+
+  {
+    // Chunks produced before the send are coalesced with the headers
+    auto producer = response.GetBodyProducer();
+    ASSERT_TRUE(producer.Push("first", test_deadline));
+    ASSERT_TRUE(producer.Push("", test_deadline));
+    ASSERT_TRUE(producer.Push("second chunk", test_deadline));
+  }
+
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  auto send_task = engine::AsyncNoSpan(
+      [](auto&& response, auto&& socket) { response.SendResponse(socket); },
+      std::ref(response), std::move(server));
+
+  std::vector<char> buffer(4096, '\0');
+  const auto reply_size =
+      client.RecvAll(buffer.data(), buffer.size(), test_deadline);
+
+  std::string_view reply{buffer.data(), reply_size};
+  EXPECT_TRUE(reply.find("\r\nTransfer-Encoding: chunked\r\n") !=
+              std::string_view::npos);
+  constexpr std::string_view kExpectedBody =
+      "\r\n\r\n5\r\nfirst\r\nc\r\nsecond chunk\r\n0\r\n\r\n";
+  ASSERT_GE(reply.size(), kExpectedBody.size());
+  EXPECT_EQ(reply.substr(reply.size() - kExpectedBody.size()), kExpectedBody);
+
+  send_task.Get();
+  EXPECT_TRUE(response.IsSent());
+  EXPECT_EQ(response.BytesSent(), reply_size);
+}
+
+UTEST(HttpResponse, SendResponsesCoalesced) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse first{request, accounter};
+  server::http::HttpResponse second{request, accounter};
+  first.SetData("first");
+  second.SetData("second");
+  second.SetStatus(server::http::HttpStatus::kNotFound);
+
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  auto send_task = engine::AsyncNoSpan(
+      [&first, &second](auto&& socket) {
+        server::http::HttpResponse::SendResponses(socket, {&first, &second});
+      },
+      std::move(server));
+
+  std::vector<char> buffer(4096, '\0');
+  const auto reply_size =
+      client.RecvAll(buffer.data(), buffer.size(), test_deadline);
+
+  const std::string_view reply{buffer.data(), reply_size};
+  const auto second_pos = reply.find("HTTP/1.1 404 Not Found\r\n");
+  ASSERT_NE(second_pos, std::string_view::npos);
+  EXPECT_EQ(reply.substr(second_pos - 9, 9), "\r\n\r\nfirst");
+  EXPECT_EQ(reply.substr(reply.size() - 10), "\r\n\r\nsecond");
+
+  send_task.Get();
+  EXPECT_EQ(first.BytesSent() + second.BytesSent(), reply_size);
+}
+
 USERVER_NAMESPACE_END
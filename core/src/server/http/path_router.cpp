@@ -0,0 +1,278 @@
+#include <server/http/path_router.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+namespace {
+
+constexpr std::string_view kAnySuffixMark = "*";
+
+constexpr char kWildcardStart = '{';
+constexpr char kWildcardFinish = '}';
+
+constexpr std::uint32_t kNoIndex = std::numeric_limits<std::uint32_t>::max();
+
+bool HasWildcardSpecificSymbols(std::string_view path) {
+  return path.find(kWildcardStart) != std::string_view::npos ||
+         path.find(kWildcardFinish) != std::string_view::npos;
+}
+
+std::string ExtractWildcardName(std::string_view str) {
+  if (str.empty() || str.front() != kWildcardStart ||
+      str.back() != kWildcardFinish) {
+    throw std::runtime_error(fmt::format("Incorrect wildcard '{}'", str));
+  }
+
+  return std::string{str.substr(1, str.size() - 2)};
+}
+
+template <typename T>
+T& GetOrCreate(std::unique_ptr<T>& ptr) {
+  if (!ptr) ptr = std::make_unique<T>();
+  return *ptr;
+}
+
+std::uint32_t ToIndex(std::size_t value) {
+  UINVARIANT(value < kNoIndex, "Too many routes in PathRouter");
+  return static_cast<std::uint32_t>(value);
+}
+
+}  // namespace
+
+struct PathRouter::BuilderNode {
+  std::map<char, std::unique_ptr<BuilderNode>> literals;
+  std::unique_ptr<BuilderNode> wildcard;
+  std::optional<RouteId> route;
+  std::optional<RouteId> any_suffix_route;
+};
+
+struct PathRouter::Node {
+  // literal chars that the node consumes, starting with the char that is
+  // used to select the node from its parent
+  std::uint32_t prefix_begin{0};
+  std::uint32_t prefix_size{0};
+
+  std::uint32_t children_begin{0};
+  std::uint32_t children_size{0};
+  std::uint32_t wildcard_child{kNoIndex};
+
+  std::uint32_t route{kNoIndex};
+  std::uint32_t any_suffix_route{kNoIndex};
+};
+
+class PathRouter::Matcher final {
+ public:
+  Matcher(const PathRouter& router, std::string_view path, HttpMethod method,
+          PathArgs& args)
+      : router_(router), path_(path), method_(method), args_(args) {}
+
+  bool Match(std::uint32_t node_index, std::size_t pos) {
+    const auto& node = router_.nodes_[node_index];
+    const std::string_view prefix{router_.prefixes_.data() + node.prefix_begin,
+                                  node.prefix_size};
+    if (path_.substr(pos, prefix.size()) != prefix) return false;
+    pos += prefix.size();
+
+    if (pos == path_.size() && node.route != kNoIndex &&
+        TryRoute(node.route, pos)) {
+      return true;
+    }
+
+    if (pos < path_.size() && node.children_size) {
+      const auto* chars = router_.child_chars_.data() + node.children_begin;
+      const auto* it = std::char_traits<char>::find(chars, node.children_size,
+                                                    path_[pos]);
+      if (it && Match(router_.children_[node.children_begin + (it - chars)],
+                      pos)) {
+        return true;
+      }
+    }
+
+    if (node.wildcard_child != kNoIndex) {
+      const auto end = std::min(path_.find('/', pos), path_.size());
+      args_.emplace_back(std::string_view{}, path_.substr(pos, end - pos));
+      if (Match(node.wildcard_child, end)) return true;
+      args_.pop_back();
+    }
+
+    if (node.any_suffix_route != kNoIndex &&
+        TryRoute(node.any_suffix_route, pos)) {
+      // each segment of the suffix is a separate arg
+      for (auto begin = pos;; ++begin) {
+        const auto end = std::min(path_.find('/', begin), path_.size());
+        args_.emplace_back(std::string_view{},
+                           path_.substr(begin, end - begin));
+        if (end == path_.size()) break;
+        begin = end;
+      }
+      return true;
+    }
+
+    return false;
+  }
+
+  const MatchResult& GetResult() const { return result_; }
+
+ private:
+  bool TryRoute(std::uint32_t route, std::size_t matched_path_length) {
+    const auto method_index = static_cast<std::size_t>(method_);
+    if (method_index > kHandlerMethodsMax ||
+        !router_.route_methods_[route].test(method_index)) {
+      result_.method_not_allowed = true;
+      return false;
+    }
+
+    result_.route = route;
+    result_.matched_path_length = matched_path_length;
+    return true;
+  }
+
+  const PathRouter& router_;
+  const std::string_view path_;
+  const HttpMethod method_;
+  PathArgs& args_;
+  MatchResult result_;
+};
+
+PathRouter::PathRouter() : builder_root_(std::make_unique<BuilderNode>()) {}
+
+PathRouter::PathRouter(PathRouter&&) noexcept = default;
+
+PathRouter& PathRouter::operator=(PathRouter&&) noexcept = default;
+
+PathRouter::~PathRouter() = default;
+
+PathRouter::Route PathRouter::AddRoute(std::string_view path,
+                                       const std::vector<HttpMethod>& methods) {
+  if (!builder_root_) {
+    throw std::logic_error("Routes may not be added after the compilation");
+  }
+
+  Route result{};
+  std::optional<RouteId>* route = nullptr;
+  try {
+    auto* node = builder_root_.get();
+    auto rest = path;
+    while (true) {
+      const auto segment = rest.substr(0, rest.find('/'));
+      const bool is_last = segment.size() == rest.size();
+
+      if (HasWildcardSpecificSymbols(segment)) {
+        auto name = ExtractWildcardName(segment);
+        if (!name.empty() &&
+            std::find(result.arg_names.begin(), result.arg_names.end(),
+                      name) != result.arg_names.end()) {
+          throw std::runtime_error(
+              fmt::format("duplicate wildcard name: '{}'", name));
+        }
+        result.arg_names.push_back(std::move(name));
+        node = &GetOrCreate(node->wildcard);
+      } else if (is_last && segment == kAnySuffixMark) {
+        route = &node->any_suffix_route;
+        break;
+      } else {
+        for (const char c : segment) node = &GetOrCreate(node->literals[c]);
+      }
+
+      if (is_last) {
+        route = &node->route;
+        break;
+      }
+      node = &GetOrCreate(node->literals['/']);
+      rest.remove_prefix(segment.size() + 1);
+    }
+  } catch (const std::exception& ex) {
+    throw std::runtime_error(fmt::format(
+        "Failed to process handler path '{}': {}", path, ex.what()));
+  }
+
+  if (!*route) {
+    *route = route_methods_.size();
+    route_methods_.emplace_back();
+  }
+  result.id = **route;
+
+  auto& route_methods = route_methods_[result.id];
+  for (const auto method : methods) {
+    const auto method_index = static_cast<std::size_t>(method);
+    UASSERT(method_index <= kHandlerMethodsMax);
+    route_methods.set(method_index);
+  }
+  return result;
+}
+
+void PathRouter::Compile() {
+  UINVARIANT(builder_root_, "PathRouter may only be compiled once");
+  ToIndex(route_methods_.size());
+
+  CompileNode(*builder_root_, {});
+  builder_root_.reset();
+}
+
+PathRouter::MatchResult PathRouter::Match(std::string_view path,
+                                          HttpMethod method,
+                                          PathArgs& args) const {
+  UASSERT_MSG(!builder_root_ || route_methods_.empty(),
+              "PathRouter must be compiled before matching");
+  if (nodes_.empty()) return {};
+
+  Matcher matcher{*this, path, method, args};
+  matcher.Match(0, 0);
+  return matcher.GetResult();
+}
+
+std::uint32_t PathRouter::CompileNode(const BuilderNode& start,
+                                      std::string prefix) {
+  // merge the chain of nodes that have nothing but a single literal child
+  const auto* node = &start;
+  while (node->literals.size() == 1 && !node->wildcard && !node->route &&
+         !node->any_suffix_route) {
+    const auto& [c, child] = *node->literals.begin();
+    prefix += c;
+    node = child.get();
+  }
+
+  const auto index = ToIndex(nodes_.size());
+  {
+    auto& compiled = nodes_.emplace_back();
+    compiled.prefix_begin = ToIndex(prefixes_.size());
+    compiled.prefix_size = ToIndex(prefix.size());
+    if (node->route) compiled.route = *node->route;
+    if (node->any_suffix_route) {
+      compiled.any_suffix_route = *node->any_suffix_route;
+    }
+  }
+  prefixes_ += prefix;
+
+  std::vector<std::uint32_t> literal_children;
+  literal_children.reserve(node->literals.size());
+  for (const auto& [c, child] : node->literals) {
+    literal_children.push_back(CompileNode(*child, std::string(1, c)));
+  }
+  const auto wildcard_child =
+      node->wildcard ? CompileNode(*node->wildcard, {}) : kNoIndex;
+
+  // nodes_ could have been reallocated by the recursive calls
+  auto& compiled = nodes_[index];
+  compiled.children_begin = ToIndex(children_.size());
+  compiled.children_size = ToIndex(literal_children.size());
+  compiled.wildcard_child = wildcard_child;
+  children_.insert(children_.end(), literal_children.begin(),
+                   literal_children.end());
+  for (const auto& [c, child] : node->literals) child_chars_.push_back(c);
+
+  return index;
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+
+#include <server/http/handler_methods.hpp>
+#include <userver/server/http/http_method.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+/// Name and value of a path arg, the value is a view into the matched path
+using PathArg = std::pair<std::string_view, std::string_view>;
+using PathArgs = boost::container::small_vector<PathArg, 8>;
+
+/// @brief Compressed radix trie over the handler paths, both fixed and with
+/// wildcards.
+///
+/// Path segments may be `{name}` (or `{}`) wildcards that match any single
+/// segment, and the last segment may be `*` that matches any suffix of the
+/// path, starting from that segment. When several routes match a path,
+/// the literal segments are preferred over the wildcards and the wildcards
+/// are preferred over the `*`, going from left to right.
+///
+/// Routes are added at startup, then the trie is compiled into flat arrays.
+/// Matching does not allocate unless there are more than 8 path args.
+class PathRouter final {
+ public:
+  using RouteId = std::size_t;
+
+  struct Route {
+    RouteId id;
+    /// Names of the `{name}` wildcards in the order of appearance, unnamed
+    /// wildcards have empty names
+    std::vector<std::string> arg_names;
+  };
+
+  struct MatchResult {
+    std::optional<RouteId> route;
+    /// Some of the routes match the path, but not the method
+    bool method_not_allowed{false};
+    std::size_t matched_path_length{0};
+  };
+
+  PathRouter();
+  PathRouter(PathRouter&&) noexcept;
+  PathRouter& operator=(PathRouter&&) noexcept;
+  ~PathRouter();
+
+  /// @brief Adds a route for the `methods`, paths that only differ in the
+  /// wildcard names share the route
+  /// @throws std::runtime_error if the path is malformed
+  Route AddRoute(std::string_view path, const std::vector<HttpMethod>& methods);
+
+  /// Builds the trie that is used for matching, routes may not be added
+  /// after that
+  void Compile();
+
+  /// @brief Finds the best route for the path and the method
+  /// @param args is filled with the values of the route wildcards, followed by
+  /// the segments matched by `*`; names are left empty
+  MatchResult Match(std::string_view path, HttpMethod method,
+                    PathArgs& args) const;
+
+ private:
+  using Methods = std::bitset<kHandlerMethodsMax + 1>;
+
+  struct BuilderNode;
+  struct Node;
+  class Matcher;
+
+  std::uint32_t CompileNode(const BuilderNode& node, std::string prefix);
+
+  std::unique_ptr<BuilderNode> builder_root_;
+  std::vector<Methods> route_methods_;
+
+  std::vector<Node> nodes_;
+  std::string prefixes_;
+  // first chars of the literal children of the nodes, `children_` and
+  // `child_chars_` are indexed by Node::children_begin
+  std::string child_chars_;
+  std::vector<std::uint32_t> children_;
+};
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
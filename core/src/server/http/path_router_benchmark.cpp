@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <server/http/path_router.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::HttpMethod;
+using server::http::impl::PathArgs;
+using server::http::impl::PathRouter;
+
+constexpr std::size_t kRoutes = 500;
+
+// A half of the routes are fixed and a half have wildcards, as in a typical
+// service with many handlers
+PathRouter MakeRouter() {
+  PathRouter router;
+  const std::vector<HttpMethod> methods{HttpMethod::kGet, HttpMethod::kPost};
+  for (std::size_t i = 0; i < kRoutes / 2; ++i) {
+    router.AddRoute(fmt::format("/v{}/service-{}/action", i % 4, i), methods);
+    router.AddRoute(
+        fmt::format("/v{}/service-{}/items/{{item_id}}/details", i % 4, i),
+        methods);
+  }
+  router.Compile();
+  return router;
+}
+
+std::vector<std::string> MakePaths(std::size_t wildcard_percent) {
+  std::vector<std::string> paths;
+  for (std::size_t i = 0; i < kRoutes / 2; ++i) {
+    if (i * 100 < wildcard_percent * (kRoutes / 2)) {
+      paths.push_back(fmt::format(
+          "/v{}/service-{}/items/a8e4c5f2-{}/details", i % 4, i, i));
+    } else {
+      paths.push_back(fmt::format("/v{}/service-{}/action", i % 4, i));
+    }
+  }
+  // not found
+  paths.push_back("/v1/service-1/unknown");
+  return paths;
+}
+
+}  // namespace
+
+void path_router_match(benchmark::State& state) {
+  const auto router = MakeRouter();
+  const auto paths = MakePaths(state.range(0));
+
+  std::size_t i = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    PathArgs args;
+    benchmark::DoNotOptimize(
+        router.Match(paths[i++ % paths.size()], HttpMethod::kGet, args));
+    benchmark::DoNotOptimize(args);
+  }
+}
+// percent of the paths that match the routes with wildcards
+BENCHMARK(path_router_match)->Arg(0)->Arg(50)->Arg(100);
+
+void path_router_build(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(MakeRouter());
+  }
+}
+BENCHMARK(path_router_build);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,184 @@
+#include <userver/utest/utest.hpp>
+
+#include <string>
+#include <vector>
+
+#include <server/http/path_router.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::HttpMethod;
+using server::http::impl::PathArgs;
+using server::http::impl::PathRouter;
+
+const std::vector<HttpMethod> kGet{HttpMethod::kGet};
+
+struct Match {
+  std::optional<PathRouter::RouteId> route;
+  bool method_not_allowed{false};
+  std::size_t matched_path_length{0};
+  std::vector<std::string> args;
+};
+
+Match DoMatch(const PathRouter& router, std::string_view path,
+              HttpMethod method = HttpMethod::kGet) {
+  PathArgs args;
+  const auto result = router.Match(path, method, args);
+
+  Match match{result.route, result.method_not_allowed,
+              result.matched_path_length, {}};
+  for (const auto& [name, value] : args) {
+    EXPECT_TRUE(name.empty());
+    match.args.emplace_back(value);
+  }
+  return match;
+}
+
+}  // namespace
+
+TEST(PathRouter, Fixed) {
+  PathRouter router;
+  const auto root = router.AddRoute("/", kGet).id;
+  const auto ping = router.AddRoute("/ping", kGet).id;
+  const auto pong = router.AddRoute("/pong", kGet).id;
+  const auto ping_slash = router.AddRoute("/ping/", kGet).id;
+  router.Compile();
+
+  EXPECT_EQ(DoMatch(router, "/").route, root);
+  EXPECT_EQ(DoMatch(router, "/ping").route, ping);
+  EXPECT_EQ(DoMatch(router, "/pong").route, pong);
+  EXPECT_EQ(DoMatch(router, "/ping/").route, ping_slash);
+  EXPECT_EQ(DoMatch(router, "/ping").matched_path_length, 5);
+
+  for (const auto* path : {"", "/p", "/pin", "/pingg", "/ping//", "//"}) {
+    const auto match = DoMatch(router, path);
+    EXPECT_FALSE(match.route) << path;
+    EXPECT_FALSE(match.method_not_allowed) << path;
+  }
+}
+
+TEST(PathRouter, Wildcards) {
+  PathRouter router;
+  const auto route = router.AddRoute("/v1/{user}/orders/{}", kGet);
+  EXPECT_EQ(route.arg_names, (std::vector<std::string>{"user", ""}));
+  EXPECT_EQ(router.AddRoute("/v1/{name}/orders/{id}", kGet).id, route.id);
+  router.Compile();
+
+  auto match = DoMatch(router, "/v1/alice/orders/42");
+  EXPECT_EQ(match.route, route.id);
+  EXPECT_EQ(match.args, (std::vector<std::string>{"alice", "42"}));
+
+  // wildcards match empty segments
+  match = DoMatch(router, "/v1//orders/");
+  EXPECT_EQ(match.route, route.id);
+  EXPECT_EQ(match.args, (std::vector<std::string>{"", ""}));
+
+  EXPECT_FALSE(DoMatch(router, "/v1/alice/orders").route);
+  EXPECT_FALSE(DoMatch(router, "/v1/alice/orders/42/").route);
+  EXPECT_FALSE(DoMatch(router, "/v1/a/b/orders/42").route);
+}
+
+TEST(PathRouter, AnySuffix) {
+  PathRouter router;
+  const auto any = router.AddRoute("/static/*", kGet).id;
+  const auto nested = router.AddRoute("/static/{dir}/*", kGet).id;
+  router.Compile();
+
+  auto match = DoMatch(router, "/static/");
+  EXPECT_EQ(match.route, any);
+  EXPECT_EQ(match.args, (std::vector<std::string>{""}));
+  EXPECT_EQ(match.matched_path_length, 8);
+
+  match = DoMatch(router, "/static/file.txt");
+  EXPECT_EQ(match.route, any);
+  EXPECT_EQ(match.args, (std::vector<std::string>{"file.txt"}));
+
+  match = DoMatch(router, "/static/css/a/b.css");
+  EXPECT_EQ(match.route, nested);
+  EXPECT_EQ(match.args, (std::vector<std::string>{"css", "a", "b.css"}));
+  EXPECT_EQ(match.matched_path_length, 12);
+
+  EXPECT_FALSE(DoMatch(router, "/static").route);
+  EXPECT_FALSE(DoMatch(router, "/statics/a").route);
+}
+
+TEST(PathRouter, Priorities) {
+  PathRouter router;
+  const auto fixed = router.AddRoute("/a/b/c", kGet).id;
+  const auto literal_first = router.AddRoute("/a/b/{}", kGet).id;
+  const auto wildcard_first = router.AddRoute("/a/{}/c", kGet).id;
+  const auto wildcards = router.AddRoute("/a/{}/{}", kGet).id;
+  const auto any = router.AddRoute("/a/*", kGet).id;
+  router.Compile();
+
+  EXPECT_EQ(DoMatch(router, "/a/b/c").route, fixed);
+  EXPECT_EQ(DoMatch(router, "/a/b/d").route, literal_first);
+  EXPECT_EQ(DoMatch(router, "/a/x/c").route, wildcard_first);
+  EXPECT_EQ(DoMatch(router, "/a/x/y").route, wildcards);
+  EXPECT_EQ(DoMatch(router, "/a/x").route, any);
+  EXPECT_EQ(DoMatch(router, "/a/x/y/z").route, any);
+
+  // backtracking from the literal branch
+  EXPECT_EQ(DoMatch(router, "/a/b").route, any);
+}
+
+TEST(PathRouter, Methods) {
+  PathRouter router;
+  const auto get = router.AddRoute("/a/{}", kGet).id;
+  EXPECT_EQ(router.AddRoute("/a/{}", {HttpMethod::kPost}).id, get);
+  const auto put = router.AddRoute("/a/*", {HttpMethod::kPut}).id;
+  router.AddRoute("/a/b", {HttpMethod::kDelete});
+  router.Compile();
+
+  EXPECT_EQ(DoMatch(router, "/a/b", HttpMethod::kGet).route, get);
+  EXPECT_EQ(DoMatch(router, "/a/b", HttpMethod::kPost).route, get);
+
+  auto match = DoMatch(router, "/a/b", HttpMethod::kPut);
+  EXPECT_EQ(match.route, put);
+  EXPECT_TRUE(match.method_not_allowed);
+
+  match = DoMatch(router, "/a/b", HttpMethod::kPatch);
+  EXPECT_FALSE(match.route);
+  EXPECT_TRUE(match.method_not_allowed);
+  EXPECT_TRUE(match.args.empty());
+
+  match = DoMatch(router, "/b", HttpMethod::kPatch);
+  EXPECT_FALSE(match.route);
+  EXPECT_FALSE(match.method_not_allowed);
+}
+
+TEST(PathRouter, ManyArgs) {
+  PathRouter router;
+  const auto route = router.AddRoute("/{}/{}/{}/{}/{}/{}/{}/{}/{}/*", kGet).id;
+  router.Compile();
+
+  const auto match = DoMatch(router, "/1/2/3/4/5/6/7/8/9/10/11");
+  EXPECT_EQ(match.route, route);
+  EXPECT_EQ(match.args,
+            (std::vector<std::string>{"1", "2", "3", "4", "5", "6", "7", "8",
+                                      "9", "10", "11"}));
+}
+
+TEST(PathRouter, Errors) {
+  PathRouter router;
+  EXPECT_THROW(router.AddRoute("/a/{x", kGet), std::runtime_error);
+  EXPECT_THROW(router.AddRoute("/a/x}", kGet), std::runtime_error);
+  EXPECT_THROW(router.AddRoute("/a/{x}.json", kGet), std::runtime_error);
+  EXPECT_THROW(router.AddRoute("/{x}/{x}", kGet), std::runtime_error);
+  EXPECT_NO_THROW(router.AddRoute("/{}/{}", kGet));
+
+  router.Compile();
+  EXPECT_THROW(router.AddRoute("/a", kGet), std::logic_error);
+}
+
+TEST(PathRouter, Empty) {
+  PathRouter router;
+  EXPECT_FALSE(DoMatch(router, "/").route);
+
+  router.Compile();
+  EXPECT_FALSE(DoMatch(router, "/").route);
+}
+
+USERVER_NAMESPACE_END
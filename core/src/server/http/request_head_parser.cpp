@@ -0,0 +1,297 @@
+#include <server/http/request_head_parser.hpp>
+
+#include <cstdint>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include <userver/http/common_headers.hpp>
+#include <userver/utils/str_icase.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+namespace {
+
+constexpr std::size_t kMaxMethodSize = 7;
+constexpr std::size_t kMaxContentLengthDigits = 18;
+constexpr std::string_view kVersionPrefix = "HTTP/1.";
+
+struct KnownMethod {
+  std::string_view name;
+  HttpMethod method;
+};
+
+// CONNECT is an upgrade for http_parser
+constexpr KnownMethod kKnownMethods[] = {
+    {"GET", HttpMethod::kGet},         {"POST", HttpMethod::kPost},
+    {"PUT", HttpMethod::kPut},         {"DELETE", HttpMethod::kDelete},
+    {"HEAD", HttpMethod::kHead},       {"PATCH", HttpMethod::kPatch},
+    {"OPTIONS", HttpMethod::kOptions},
+};
+
+// Bytes that are either the delimiter or unusual for the scanned field:
+// [0, kLow] and [kHighBegin, kHighEnd]
+template <unsigned char Low, unsigned char HighBegin, unsigned char HighEnd>
+struct StopChars {
+  static constexpr unsigned char kLow = Low;
+  static constexpr unsigned char kHighBegin = HighBegin;
+  static constexpr unsigned char kHighEnd = HighEnd;
+
+  static constexpr bool IsStop(char c) noexcept {
+    const auto byte = static_cast<unsigned char>(c);
+    return byte <= Low || (byte >= HighBegin && byte <= HighEnd);
+  }
+};
+
+// URL ends with a space, the bytes out of the printable ASCII are left to
+// http_parser
+using UrlStop = StopChars<0x20, 0x7f, 0xff>;
+// Header value ends with CR, HTAB is allowed in the value and the other
+// control chars are left to http_parser
+using ValueStop = StopChars<0x1f, 0x7f, 0x7f>;
+
+using FindStopFunc = const char* (*)(const char* begin, const char* end);
+
+template <typename Stop>
+const char* FindStopScalar(const char* begin, const char* end) {
+  while (begin != end && !Stop::IsStop(*begin)) ++begin;
+  return begin;
+}
+
+#if defined(__x86_64__)
+template <typename Stop>
+__attribute__((target("sse4.2"))) const char* FindStopSse42(const char* begin,
+                                                            const char* end) {
+  const auto ranges = _mm_setr_epi8(
+      0, static_cast<char>(Stop::kLow), static_cast<char>(Stop::kHighBegin),
+      static_cast<char>(Stop::kHighEnd), 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  for (; end - begin >= 16; begin += 16) {
+    const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    const int index =
+        _mm_cmpestri(ranges, 4, chunk, 16,
+                     _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES |
+                         _SIDD_LEAST_SIGNIFICANT);
+    if (index != 16) return begin + index;
+  }
+  return FindStopScalar<Stop>(begin, end);
+}
+
+template <typename Stop>
+__attribute__((target("avx2"))) const char* FindStopAvx2(const char* begin,
+                                                         const char* end) {
+  const auto low = _mm256_set1_epi8(static_cast<char>(Stop::kLow));
+  const auto high_begin = _mm256_set1_epi8(static_cast<char>(Stop::kHighBegin));
+  const auto high_end = _mm256_set1_epi8(static_cast<char>(Stop::kHighEnd));
+  for (; end - begin >= 32; begin += 32) {
+    const auto chunk =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    // unsigned comparisons through min/max
+    const auto is_low =
+        _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, low), chunk);
+    const auto is_high = _mm256_and_si256(
+        _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, high_begin), chunk),
+        _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, high_end), chunk));
+    const auto mask = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_or_si256(is_low, is_high)));
+    if (mask) return begin + __builtin_ctz(mask);
+  }
+  return FindStopScalar<Stop>(begin, end);
+}
+#endif
+
+struct Scanners {
+  FindStopFunc find_url_end;
+  FindStopFunc find_value_end;
+};
+
+const Scanners& GetScanners(SimdLevel level) {
+  static constexpr Scanners kScalar{&FindStopScalar<UrlStop>,
+                                    &FindStopScalar<ValueStop>};
+#if defined(__x86_64__)
+  static constexpr Scanners kSse42{&FindStopSse42<UrlStop>,
+                                   &FindStopSse42<ValueStop>};
+  static constexpr Scanners kAvx2{&FindStopAvx2<UrlStop>,
+                                  &FindStopAvx2<ValueStop>};
+  switch (level) {
+    case SimdLevel::kScalar:
+      return kScalar;
+    case SimdLevel::kSse42:
+      return kSse42;
+    case SimdLevel::kAvx2:
+      return kAvx2;
+  }
+#endif
+  return kScalar;
+}
+
+// RFC 7230 tchar
+constexpr bool IsTokenChar(char c) noexcept {
+  if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+      (c >= '0' && c <= '9')) {
+    return true;
+  }
+  switch (c) {
+    case '!':
+    case '#':
+    case '$':
+    case '%':
+    case '&':
+    case '\'':
+    case '*':
+    case '+':
+    case '-':
+    case '.':
+    case '^':
+    case '_':
+    case '`':
+    case '|':
+    case '~':
+      return true;
+    default:
+      return false;
+  }
+}
+
+HttpMethod ParseMethod(std::string_view name) {
+  for (const auto& known : kKnownMethods) {
+    if (known.name == name) return known.method;
+  }
+  return HttpMethod::kUnknown;
+}
+
+bool ParseContentLength(std::string_view value, std::size_t& result) {
+  if (value.size() > kMaxContentLengthDigits) return false;
+  result = 0;
+  for (const char c : value) {
+    if (c < '0' || c > '9') return false;
+    result = result * 10 + (c - '0');
+  }
+  return true;
+}
+
+struct ConnectionFlags {
+  bool has_content_length{false};
+  bool close{false};
+  bool keep_alive{false};
+};
+
+// Headers that change the way the message is parsed
+bool ProcessSpecialHeader(std::string_view name, std::string_view value,
+                          RequestHead& head, ConnectionFlags& flags) {
+  const utils::StrIcaseEqual equal;
+  if (equal(name, USERVER_NAMESPACE::http::headers::kContentLength)) {
+    if (flags.has_content_length) return false;
+    flags.has_content_length = true;
+    return ParseContentLength(value, head.content_length);
+  }
+  if (equal(name, USERVER_NAMESPACE::http::headers::kConnection)) {
+    if (equal(value, "close")) {
+      flags.close = true;
+      return true;
+    }
+    if (equal(value, "keep-alive")) {
+      flags.keep_alive = true;
+      return true;
+    }
+    return false;
+  }
+  return !equal(name, USERVER_NAMESPACE::http::headers::kTransferEncoding) &&
+         !equal(name, "Upgrade") && !equal(name, "Proxy-Connection");
+}
+
+}  // namespace
+
+SimdLevel GetSimdLevel() noexcept {
+#if defined(__x86_64__)
+  static const SimdLevel kLevel = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::kAvx2;
+    if (__builtin_cpu_supports("sse4.2")) return SimdLevel::kSse42;
+    return SimdLevel::kScalar;
+  }();
+  return kLevel;
+#else
+  return SimdLevel::kScalar;
+#endif
+}
+
+bool ParseRequestHead(std::string_view data, RequestHead& head,
+                      SimdLevel level) {
+  const auto& scanners = GetScanners(level);
+  data = data.substr(0, kMaxRequestHeadSize);
+  const char* const begin = data.data();
+  const char* const end = begin + data.size();
+
+  const auto method_size = data.substr(0, kMaxMethodSize + 1).find(' ');
+  if (method_size == std::string_view::npos) return false;
+  head.method = ParseMethod(data.substr(0, method_size));
+  if (head.method == HttpMethod::kUnknown) return false;
+  const char* ptr = begin + method_size + 1;
+
+  // origin-form only
+  if (ptr == end || *ptr != '/') return false;
+  const char* url_end = scanners.find_url_end(ptr, end);
+  if (url_end == end || *url_end != ' ') return false;
+  head.url = std::string_view(ptr, url_end - ptr);
+  ptr = url_end + 1;
+
+  if (static_cast<std::size_t>(end - ptr) < kVersionPrefix.size() + 3 ||
+      std::string_view(ptr, kVersionPrefix.size()) != kVersionPrefix) {
+    return false;
+  }
+  ptr += kVersionPrefix.size();
+  if ((ptr[0] != '0' && ptr[0] != '1') || ptr[1] != '\r' || ptr[2] != '\n') {
+    return false;
+  }
+  head.http_minor = ptr[0] - '0';
+  ptr += 3;
+
+  head.headers.clear();
+  head.content_length = 0;
+  ConnectionFlags flags;
+  while (true) {
+    if (end - ptr < 2) return false;
+    if (ptr[0] == '\r') {
+      if (ptr[1] != '\n') return false;
+      ptr += 2;
+      break;
+    }
+
+    const char* name_end = ptr;
+    while (name_end != end && IsTokenChar(*name_end)) ++name_end;
+    if (name_end == ptr || name_end == end || *name_end != ':') return false;
+    const std::string_view name(ptr, name_end - ptr);
+
+    ptr = name_end + 1;
+    while (ptr != end && (*ptr == ' ' || *ptr == '\t')) ++ptr;
+    const char* value_end = ptr;
+    while (true) {
+      value_end = scanners.find_value_end(value_end, end);
+      if (value_end == end) return false;
+      if (*value_end != '\t') break;
+      ++value_end;
+    }
+    // empty values, trailing whitespace and bare LF are left to http_parser
+    if (*value_end != '\r' || value_end == ptr || value_end[-1] == ' ' ||
+        value_end[-1] == '\t' || end - value_end < 2 || value_end[1] != '\n') {
+      return false;
+    }
+    const std::string_view value(ptr, value_end - ptr);
+    ptr = value_end + 2;
+
+    if (!ProcessSpecialHeader(name, value, head, flags)) return false;
+    head.headers.emplace_back(name, value);
+  }
+
+  // same as http_should_keep_alive()
+  head.keep_alive = head.http_minor ? !flags.close : flags.keep_alive;
+  head.size = ptr - begin;
+  return true;
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
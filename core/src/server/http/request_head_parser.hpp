@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+#include <boost/container/small_vector.hpp>
+
+#include <userver/server/http/http_method.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+/// Heads larger than that are left to http_parser, that enforces its own
+/// HTTP_MAX_HEADER_SIZE limit
+inline constexpr std::size_t kMaxRequestHeadSize = 32 * 1024;
+
+/// Request line and headers, the views point into the parsed buffer
+struct RequestHead {
+  using Header = std::pair<std::string_view, std::string_view>;
+
+  HttpMethod method{HttpMethod::kUnknown};
+  std::string_view url;
+  unsigned short http_minor{0};
+  boost::container::small_vector<Header, 32> headers;
+  std::size_t content_length{0};
+  bool keep_alive{false};
+  /// Bytes taken by the request line and the headers, including the final
+  /// empty line
+  std::size_t size{0};
+};
+
+enum class SimdLevel {
+  kScalar,
+  kSse42,
+  kAvx2,
+};
+
+/// The best instruction set supported by the CPU
+SimdLevel GetSimdLevel() noexcept;
+
+/// @brief Parses the request line and the headers of an HTTP/1.x request,
+/// searching for the delimiters in bulk, in the style of picohttpparser.
+///
+/// Only accepts the common subset of the protocol: known methods,
+/// origin-form URLs, HTTP/1.0 and HTTP/1.1, headers without line folding or
+/// empty values, at most one Content-Length and no Transfer-Encoding,
+/// Upgrade or non-trivial Connection. Returns false for everything else,
+/// including incomplete heads, and those are to be parsed by http_parser.
+///
+/// @param data starts from the first byte of the request line
+bool ParseRequestHead(std::string_view data, RequestHead& head,
+                      SimdLevel level = GetSimdLevel());
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
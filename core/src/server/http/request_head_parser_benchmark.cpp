@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <fmt/format.h>
+
+#include <server/http/request_head_parser.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::impl::SimdLevel;
+
+// 30+ headers and a large cookie, as the requests from the edge
+std::string MakeRequestHead() {
+  std::string request =
+      "GET /v1/service/items/details?item_id=a8e4c5f2&lang=en HTTP/1.1\r\n"
+      "Host: service.example.com\r\n";
+  for (int i = 0; i < 30; ++i) {
+    request += fmt::format("X-Edge-Header-{}: value-{}-{}\r\n", i, i,
+                           std::string(40, 'a' + i % 26));
+  }
+  request += "Cookie: ";
+  for (int i = 0; i < 64; ++i) {
+    request += fmt::format("cookie_{}={}; ", i, std::string(48, 'c'));
+  }
+  request += "last=1\r\n\r\n";
+  return request;
+}
+
+}  // namespace
+
+void request_head_parse(benchmark::State& state) {
+  const auto level = static_cast<SimdLevel>(state.range(0));
+  if (static_cast<int>(level) >
+      static_cast<int>(server::http::impl::GetSimdLevel())) {
+    state.SkipWithError("Not supported by the CPU");
+    return;
+  }
+
+  const auto request = MakeRequestHead();
+  server::http::impl::RequestHead head;
+  for ([[maybe_unused]] auto _ : state) {
+    if (!server::http::impl::ParseRequestHead(request, head, level)) {
+      state.SkipWithError("Failed to parse the request");
+      break;
+    }
+    benchmark::DoNotOptimize(head);
+  }
+  state.SetBytesProcessed(state.iterations() * request.size());
+}
+BENCHMARK(request_head_parse)
+    ->Arg(static_cast<int>(SimdLevel::kScalar))
+    ->Arg(static_cast<int>(SimdLevel::kSse42))
+    ->Arg(static_cast<int>(SimdLevel::kAvx2));
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,147 @@
+#include <server/http/request_head_parser.hpp>
+
+#include <string>
+#include <vector>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::HttpMethod;
+using server::http::impl::ParseRequestHead;
+using server::http::impl::RequestHead;
+using server::http::impl::SimdLevel;
+
+std::vector<SimdLevel> GetSupportedLevels() {
+  std::vector<SimdLevel> levels{SimdLevel::kScalar};
+  const auto best = server::http::impl::GetSimdLevel();
+  if (best == SimdLevel::kSse42 || best == SimdLevel::kAvx2) {
+    levels.push_back(SimdLevel::kSse42);
+  }
+  if (best == SimdLevel::kAvx2) levels.push_back(SimdLevel::kAvx2);
+  return levels;
+}
+
+}  // namespace
+
+TEST(RequestHeadParser, Typical) {
+  const std::string_view request =
+      "POST /v1/items?id=42&lang=en HTTP/1.1\r\n"
+      "Host: example.com\r\n"
+      "Content-Length: 4\r\n"
+      "X-Tabbed:\tvalue\twith tabs\r\n"
+      "\r\n"
+      "body";
+
+  for (const auto level : GetSupportedLevels()) {
+    RequestHead head;
+    ASSERT_TRUE(ParseRequestHead(request, head, level));
+    EXPECT_EQ(head.method, HttpMethod::kPost);
+    EXPECT_EQ(head.url, "/v1/items?id=42&lang=en");
+    EXPECT_EQ(head.http_minor, 1);
+    EXPECT_EQ(head.content_length, 4);
+    EXPECT_TRUE(head.keep_alive);
+    EXPECT_EQ(head.size, request.size() - 4);
+
+    ASSERT_EQ(head.headers.size(), 3);
+    EXPECT_EQ(head.headers[0], RequestHead::Header("Host", "example.com"));
+    EXPECT_EQ(head.headers[1], RequestHead::Header("Content-Length", "4"));
+    EXPECT_EQ(head.headers[2],
+              RequestHead::Header("X-Tabbed", "value\twith tabs"));
+  }
+}
+
+TEST(RequestHeadParser, KeepAlive) {
+  RequestHead head;
+  ASSERT_TRUE(ParseRequestHead("GET / HTTP/1.0\r\n\r\n", head));
+  EXPECT_FALSE(head.keep_alive);
+
+  ASSERT_TRUE(ParseRequestHead(
+      "GET / HTTP/1.0\r\nConnection: Keep-Alive\r\n\r\n", head));
+  EXPECT_TRUE(head.keep_alive);
+
+  ASSERT_TRUE(
+      ParseRequestHead("GET / HTTP/1.1\r\nConnection: close\r\n\r\n", head));
+  EXPECT_FALSE(head.keep_alive);
+}
+
+TEST(RequestHeadParser, LongFields) {
+  // covers the SIMD loops and the scalar tails
+  for (const auto level : GetSupportedLevels()) {
+    for (std::size_t size = 1; size < 100; ++size) {
+      const std::string url = '/' + std::string(size, 'u');
+      const std::string value(size, 'v');
+      const std::string request =
+          "GET " + url + " HTTP/1.1\r\nCookie: " + value + "\r\n\r\n";
+
+      RequestHead head;
+      ASSERT_TRUE(ParseRequestHead(request, head, level)) << size;
+      EXPECT_EQ(head.url, url);
+      ASSERT_EQ(head.headers.size(), 1);
+      EXPECT_EQ(head.headers[0].second, value);
+      EXPECT_EQ(head.size, request.size());
+
+      for (const char bad : {'\x01', '\x7f'}) {
+        auto bad_request = request;
+        bad_request[request.size() - 5 - (size - 1) / 2] = bad;
+        EXPECT_FALSE(ParseRequestHead(bad_request, head, level)) << size;
+      }
+      auto bad_url_request = request;
+      bad_url_request[4 + size / 2 + 1] = '\x80';
+      EXPECT_FALSE(ParseRequestHead(bad_url_request, head, level)) << size;
+    }
+  }
+}
+
+TEST(RequestHeadParser, LeftToHttpParser) {
+  const std::string_view requests[] = {
+      // incomplete
+      "GET / HTTP/1.1\r\nHost: example.com\r\n",
+      "GET / HTTP/1.1\r\nHost: example.com",
+      "GET /path",
+      // unusual request line
+      "CONNECT example.com:443 HTTP/1.1\r\n\r\n",
+      "PROPFIND / HTTP/1.1\r\n\r\n",
+      "get / HTTP/1.1\r\n\r\n",
+      "GET http://example.com/ HTTP/1.1\r\n\r\n",
+      "GET * HTTP/1.1\r\n\r\n",
+      "GET  / HTTP/1.1\r\n\r\n",
+      "GET / HTTP/2.0\r\n\r\n",
+      "GET / HTTP/1.1\n\r\n",
+      // unusual headers
+      "GET / HTTP/1.1\r\nHost: example.com\n\r\n",
+      "GET / HTTP/1.1\r\nX-Folded: a\r\n b\r\n\r\n",
+      "GET / HTTP/1.1\r\nX-Empty:\r\n\r\n",
+      "GET / HTTP/1.1\r\nX-Trailing: a \r\n\r\n",
+      "GET / HTTP/1.1\r\nX Space: a\r\n\r\n",
+      "GET / HTTP/1.1\r\nX-Space : a\r\n\r\n",
+      "GET / HTTP/1.1\r\nX-Control: a\x01\r\n\r\n",
+      // headers that change the parsing
+      "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n",
+      "POST / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 1\r\n\r\n",
+      "POST / HTTP/1.1\r\nContent-Length: -1\r\n\r\n",
+      "POST / HTTP/1.1\r\nContent-Length: 1234567890123456789\r\n\r\n",
+      "GET / HTTP/1.1\r\nConnection: Upgrade\r\nUpgrade: h2c\r\n\r\n",
+      "GET / HTTP/1.1\r\nConnection: keep-alive, close\r\n\r\n",
+      "GET / HTTP/1.1\r\nProxy-Connection: close\r\n\r\n",
+  };
+
+  for (const auto level : GetSupportedLevels()) {
+    for (const auto request : requests) {
+      RequestHead head;
+      EXPECT_FALSE(ParseRequestHead(request, head, level)) << request;
+    }
+  }
+}
+
+TEST(RequestHeadParser, TooLarge) {
+  const std::string request =
+      "GET / HTTP/1.1\r\nCookie: " +
+      std::string(server::http::impl::kMaxRequestHeadSize, 'c') + "\r\n\r\n";
+  RequestHead head;
+  EXPECT_FALSE(ParseRequestHead(request, head));
+}
+
+USERVER_NAMESPACE_END
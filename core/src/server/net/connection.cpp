@@ -2,10 +2,13 @@
 
 #include <algorithm>
 #include <array>
+#include <optional>
 #include <stdexcept>
 #include <system_error>
+#include <utility>
 #include <vector>
 
+#include <server/http/http2_session.hpp>
 #include <server/http/http_request_parser.hpp>
 #include <server/http/request_handler_base.hpp>
 
@@ -15,6 +18,7 @@
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/server/http/http_response.hpp>
 #include <userver/server/request/request_config.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/scope_guard.hpp>
@@ -23,6 +27,34 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+namespace {
+
+enum class Protocol { kHttp11, kHttp2, kUnknown };
+
+// HTTP/2 with prior knowledge starts with the connection preface,
+// RFC 7540 3.4
+Protocol DetectProtocol(std::string_view data) {
+  const auto preface = http::Http2Session::kConnectionPreface;
+  const auto size = std::min(data.size(), preface.size());
+  if (data.substr(0, size) != preface.substr(0, size)) return Protocol::kHttp11;
+  return size == preface.size() ? Protocol::kHttp2 : Protocol::kUnknown;
+}
+
+// Limits the batch of the pipelined responses sent with a single write
+constexpr std::size_t kMaxCoalescedResponses = 32;
+
+void LogSendError(const engine::io::IoSystemError& ex) {
+  // working with raw values because std::errc compares error_category
+  // default_error_category() fixed only in GCC 9.1 (PR libstdc++/60555)
+  auto log_level =
+      ex.Code().value() == static_cast<int>(std::errc::broken_pipe)
+          ? logging::Level::kWarning
+          : logging::Level::kError;
+  LOG(log_level) << "I/O error while sending data: " << ex;
+}
+
+}  // namespace
+
 std::shared_ptr<Connection> Connection::Create(
     engine::TaskProcessor& task_processor, const ConnectionConfig& config,
     const request::HttpRequestConfig& handler_defaults_config,
@@ -58,6 +90,8 @@ Connection::Connection(
   ++stats_->connections_created;
 }
 
+Connection::~Connection() = default;
+
 void Connection::SetCloseCb(CloseCb close_cb) {
   close_cb_ = std::move(close_cb);
 }
@@ -90,6 +124,7 @@ void Connection::Start() {
 
         socket_listener.SyncCancel();
         self->ProcessResponses(consumer);  // Consume remaining requests
+        self->WaitForStreamSenders();
         self->Shutdown();
       },
       shared_from_this(), std::move(socket_listener));
@@ -139,23 +174,33 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
     }
   });
 
+  // Nobody would notice the peer closing the HTTP/2 streams, the stream
+  // senders must not wait for that
+  utils::ScopeGuard streams_closer([this] {
+    if (http2_session_) http2_session_->CloseAllStreams();
+  });
+
   try {
     request_tasks_->SetSoftMaxSize(config_.requests_queue_size_threshold);
 
-    http::HttpRequestParser request_parser(
-        request_handler_.GetHandlerInfoIndex(), handler_defaults_config_,
-        [this, &producer](RequestBasePtr&& request_ptr) {
-          if (!NewRequest(std::move(request_ptr), producer)) {
-            is_accepting_requests_ = false;
-          }
-        },
-        stats_->parser_stats, data_accounter_);
+    auto on_new_request = [this, &producer](RequestBasePtr&& request_ptr) {
+      if (!NewRequest(std::move(request_ptr), producer)) {
+        is_accepting_requests_ = false;
+      }
+    };
+
+    // Created once the protocol is known
+    std::optional<http::HttpRequestParser> http_request_parser;
+    request::RequestParser* request_parser = nullptr;
 
-    std::vector<char> buf(config_.in_buffer_size);
+    std::vector<char> buf(std::max(
+        config_.in_buffer_size, http::Http2Session::kConnectionPreface.size()));
+    std::size_t buffered_bytes = 0;
     while (is_accepting_requests_) {
       auto deadline = engine::Deadline::FromDuration(config_.keepalive_timeout);
       const auto bytes_read =
-          peer_socket_.RecvSome(buf.data(), buf.size(), deadline);
+          peer_socket_.RecvSome(buf.data() + buffered_bytes,
+                                buf.size() - buffered_bytes, deadline);
       if (!bytes_read) {
         LOG_TRACE() << "Peer " << peer_socket_.Getpeername() << " on fd "
                     << Fd() << " closed connection";
@@ -171,8 +216,34 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
       }
       LOG_TRACE() << "Received " << bytes_read << " byte(s) from "
                   << peer_socket_.Getpeername() << " on fd " << Fd();
+      buffered_bytes += bytes_read;
+
+      if (!request_parser) {
+        const auto protocol =
+            config_.http_version == HttpVersion::k2
+                ? DetectProtocol({buf.data(), buffered_bytes})
+                : Protocol::kHttp11;
+        if (protocol == Protocol::kUnknown) continue;  // wait for more data
+
+        if (protocol == Protocol::kHttp2) {
+          LOG_DEBUG() << "HTTP/2 connection from "
+                      << peer_socket_.Getpeername() << " on fd " << Fd();
+          http2_session_ = std::make_unique<http::Http2Session>(
+              request_handler_.GetHandlerInfoIndex(), handler_defaults_config_,
+              std::move(on_new_request), stats_->parser_stats, data_accounter_,
+              peer_socket_, config_.http2_session,
+              config_.keepalive_timeout);
+          request_parser = http2_session_.get();
+        } else {
+          request_parser = &http_request_parser.emplace(
+              request_handler_.GetHandlerInfoIndex(), handler_defaults_config_,
+              std::move(on_new_request), stats_->parser_stats,
+              data_accounter_);
+        }
+      }
 
-      if (!request_parser.Parse(buf.data(), bytes_read)) {
+      const auto parsed_bytes = std::exchange(buffered_bytes, 0);
+      if (!request_parser->Parse(buf.data(), parsed_bytes)) {
         LOG_DEBUG() << "Malformed request from " << peer_socket_.Getpeername()
                     << " on fd " << Fd();
 
@@ -182,10 +253,12 @@ void Connection::ListenForRequests(Queue::Producer producer) noexcept {
     }
 
     send_stopper.Release();
+    streams_closer.Release();
     LOG_TRACE() << "Gracefully stopping ListenForRequests()";
   } catch (const engine::io::IoTimeout&) {
     LOG_INFO() << "Closing idle connection on timeout";
     send_stopper.Release();
+    streams_closer.Release();
   } catch (const engine::io::IoCancelled&) {
     LOG_TRACE() << "engine::io::IoCancelled thrown in ListenForRequests()";
   } catch (const engine::io::IoSystemError& ex) {
@@ -227,25 +300,55 @@ bool Connection::NewRequest(std::shared_ptr<request::RequestBase>&& request_ptr,
 void Connection::ProcessResponses(Queue::Consumer& consumer) noexcept {
   try {
     QueueItem item;
+    std::vector<std::shared_ptr<request::RequestBase>> ready_requests;
+    ready_requests.reserve(kMaxCoalescedResponses);
     while (consumer.Pop(item)) {
-      HandleQueueItem(item);
+      if (http2_session_) {
+        StartStreamSender(std::move(item));
+        continue;
+      }
+
+      // Responses to the pipelined requests that are already handled are
+      // coalesced and sent with a single write
+      bool has_item = true;
+      while (has_item) {
+        // Do not hold the ready responses while waiting for a slow handler
+        if (!ready_requests.empty() && !item.second.IsFinished()) {
+          SendResponses(ready_requests);
+        }
+
+        if (!HandleQueueItem(item)) is_response_chain_valid_ = false;
+
+        if (is_response_chain_valid_ &&
+            !item.first->GetResponse().IsBodyStreamed()) {
+          ready_requests.push_back(std::move(item.first));
+          if (ready_requests.size() >= kMaxCoalescedResponses) {
+            SendResponses(ready_requests);
+          }
+        } else {
+          SendResponses(ready_requests);
 
-      // now we must complete processing
-      engine::TaskCancellationBlocker block_cancel;
+          // now we must complete processing
+          engine::TaskCancellationBlocker block_cancel;
 
-      /* In stream case we don't want a user task to exit
-       * until SendResponse() as the task produces body chunks.
-       */
-      SendResponse(*item.first);
-      item.first.reset();
-      item.second = {};
+          /* In stream case we don't want a user task to exit
+           * until SendResponse() as the task produces body chunks.
+           */
+          SendResponse(*item.first, is_response_chain_valid_);
+        }
+        item.first.reset();
+        item.second = {};
+
+        has_item = consumer.PopNoblock(item);
+      }
+      SendResponses(ready_requests);
     }
   } catch (const std::exception& e) {
     LOG_ERROR() << "Exception for fd " << Fd() << ": " << e;
   }
 }
 
-void Connection::HandleQueueItem(QueueItem& item) {
+bool Connection::HandleQueueItem(QueueItem& item) {
   auto& request = *item.first;
 
   if (engine::current_task::IsCancelRequested()) {
@@ -254,8 +357,7 @@ void Connection::HandleQueueItem(QueueItem& item) {
     auto request_task = std::move(item.second);
     request_task.SyncCancel();
     LOG_DEBUG() << "Request processing interrupted";
-    is_response_chain_valid_ = false;
-    return;  // avoids throwing and catching exception down below
+    return false;  // avoids throwing and catching exception down below
   }
 
   try {
@@ -275,36 +377,79 @@ void Connection::HandleQueueItem(QueueItem& item) {
     }
   } catch (const engine::WaitInterruptedException&) {
     LOG_DEBUG() << "Request processing interrupted";
-    is_response_chain_valid_ = false;
+    return false;
   } catch (const std::exception& e) {
     LOG_WARNING() << "Request failed with unhandled exception: " << e;
     request.MarkAsInternalServerError();
   }
+  return true;
 }
 
-void Connection::SendResponse(request::RequestBase& request) {
+void Connection::SendResponse(request::RequestBase& request,
+                              bool is_response_valid) {
   auto& response = request.GetResponse();
   UASSERT(!response.IsSent());
   request.SetStartSendResponseTime();
-  if (is_response_chain_valid_ && peer_socket_) {
+  if (is_response_valid && peer_socket_) {
     try {
       // Might be a stream reading or a fully constructed response
-      response.SendResponse(peer_socket_);
+      if (http2_session_) {
+        http2_session_->SendResponse(request);
+      } else {
+        response.SendResponse(peer_socket_);
+      }
     } catch (const engine::io::IoSystemError& ex) {
-      // working with raw values because std::errc compares error_category
-      // default_error_category() fixed only in GCC 9.1 (PR libstdc++/60555)
-      auto log_level =
-          ex.Code().value() == static_cast<int>(std::errc::broken_pipe)
-              ? logging::Level::kWarning
-              : logging::Level::kError;
-      LOG(log_level) << "I/O error while sending data: " << ex;
+      LogSendError(ex);
     } catch (const std::exception& ex) {
       LOG_ERROR() << "Error while sending data: " << ex;
       response.SetSendFailed(std::chrono::steady_clock::now());
     }
   } else {
+    if (http2_session_) http2_session_->CancelResponse(request);
     response.SetSendFailed(std::chrono::steady_clock::now());
   }
+  FinishRequest(request);
+}
+
+void Connection::SendResponses(
+    std::vector<std::shared_ptr<request::RequestBase>>& requests) {
+  if (requests.empty()) return;
+
+  // now we must complete processing
+  engine::TaskCancellationBlocker block_cancel;
+
+  std::vector<http::HttpResponse*> responses;
+  responses.reserve(requests.size());
+  for (const auto& request : requests) {
+    UASSERT(!request->GetResponse().IsSent());
+    request->SetStartSendResponseTime();
+    responses.push_back(
+        &static_cast<http::HttpResponse&>(request->GetResponse()));
+  }
+
+  const auto set_send_failed = [&responses] {
+    const auto now = std::chrono::steady_clock::now();
+    for (auto* response : responses) response->SetSendFailed(now);
+  };
+
+  if (peer_socket_) {
+    try {
+      http::HttpResponse::SendResponses(peer_socket_, responses);
+    } catch (const engine::io::IoSystemError& ex) {
+      LogSendError(ex);
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Error while sending data: " << ex;
+      set_send_failed();
+    }
+  } else {
+    set_send_failed();
+  }
+
+  for (const auto& request : requests) FinishRequest(*request);
+  requests.clear();
+}
+
+void Connection::FinishRequest(request::RequestBase& request) {
   request.SetFinishSendResponseTime();
   --stats_->active_request_count;
   ++stats_->requests_processed_count;
@@ -314,6 +459,55 @@ void Connection::SendResponse(request::RequestBase& request) {
                           std::chrono::system_clock::now(), remote_address_);
 }
 
+void Connection::StartStreamSender(QueueItem&& item) {
+  // Responses of the different streams are independent, a slow handler must
+  // not delay the others
+  stream_senders_.erase(
+      std::remove_if(stream_senders_.begin(), stream_senders_.end(),
+                     [](const auto& sender) { return sender.IsFinished(); }),
+      stream_senders_.end());
+
+  stream_senders_.push_back(engine::CriticalAsyncNoSpan(
+      task_processor_,
+      [this](QueueItem item) {
+        const bool is_response_valid = HandleQueueItem(item);
+
+        // now we must complete processing
+        engine::TaskCancellationBlocker block_cancel;
+        SendResponse(*item.first, is_response_valid);
+      },
+      std::move(item)));
+}
+
+void Connection::WaitForStreamSenders() noexcept {
+  if (!http2_session_) {
+    UASSERT(stream_senders_.empty());
+    return;
+  }
+
+  // The peer frames are not read anymore, so the flow control windows are
+  // never updated. Do not wait for the stalled responses forever.
+  const auto deadline =
+      engine::Deadline::FromDuration(config_.keepalive_timeout);
+  try {
+    for (auto& sender : stream_senders_) {
+      sender.WaitUntil(deadline);
+      if (!sender.IsFinished()) {
+        LOG_INFO() << "Timed out waiting for the streams of fd " << Fd();
+        break;
+      }
+    }
+  } catch (const engine::WaitInterruptedException&) {
+    LOG_DEBUG() << "Streams processing interrupted for fd " << Fd();
+  }
+
+  // Wakes up the senders waiting for the peer
+  http2_session_->CloseAllStreams();
+
+  for (auto& sender : stream_senders_) sender.SyncCancel();
+  stream_senders_.clear();
+}
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
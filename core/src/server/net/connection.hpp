@@ -3,6 +3,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <server/http/request_handler_base.hpp>
 #include <server/net/connection_config.hpp>
@@ -20,6 +21,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace server::http {
+class Http2Session;
+}  // namespace server::http
+
 namespace server::net {
 
 class Connection final : public std::enable_shared_from_this<Connection> {
@@ -46,6 +51,7 @@ class Connection final : public std::enable_shared_from_this<Connection> {
              const http::RequestHandlerBase& request_handler,
              std::shared_ptr<Stats> stats,
              request::ResponseDataAccounter& data_accounter, EmplaceEnabler);
+  ~Connection();
 
   void SetCloseCb(CloseCb close_cb);
 
@@ -69,8 +75,14 @@ class Connection final : public std::enable_shared_from_this<Connection> {
                   Queue::Producer&);
 
   void ProcessResponses(Queue::Consumer&) noexcept;
-  void HandleQueueItem(QueueItem& item);
-  void SendResponse(request::RequestBase& request);
+  bool HandleQueueItem(QueueItem& item);
+  void SendResponse(request::RequestBase& request, bool is_response_valid);
+  void SendResponses(
+      std::vector<std::shared_ptr<request::RequestBase>>& requests);
+  void FinishRequest(request::RequestBase& request);
+
+  void StartStreamSender(QueueItem&& item);
+  void WaitForStreamSenders() noexcept;
 
   engine::TaskProcessor& task_processor_;
   const ConnectionConfig& config_;
@@ -89,6 +101,11 @@ class Connection final : public std::enable_shared_from_this<Connection> {
   bool is_accepting_requests_{true};
   bool is_response_chain_valid_{true};
   CloseCb close_cb_;
+
+  // Set by the socket listener if the peer speaks HTTP/2
+  std::unique_ptr<http::Http2Session> http2_session_;
+  // HTTP/2 responses are sent concurrently, a task per stream
+  std::vector<engine::TaskWithResult<void>> stream_senders_;
 };
 
 }  // namespace server::net
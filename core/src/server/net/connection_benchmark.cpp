@@ -0,0 +1,216 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <nghttp2/nghttp2.h>
+
+#include <server/handlers/http_handler_base_statistics.hpp>
+#include <server/http/http_request_impl.hpp>
+#include <server/http/request_handler_base.hpp>
+#include <server/net/connection.hpp>
+#include <server/net/create_socket.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class NoopRequestHandler final : public server::http::RequestHandlerBase {
+ public:
+  engine::TaskWithResult<void> StartRequestTask(
+      std::shared_ptr<server::request::RequestBase> request) const override {
+    auto& http_request = dynamic_cast<server::http::HttpRequestImpl&>(*request);
+    static server::handlers::HttpRequestStatistics statistics;
+    http_request.SetHttpHandlerStatistics(statistics);
+    return engine::AsyncNoSpan([] {});
+  }
+
+  const server::http::HandlerInfoIndex& GetHandlerInfoIndex() const override {
+    return handler_info_index_;
+  }
+
+  const logging::LoggerPtr& LoggerAccess() const noexcept override {
+    return no_logger_;
+  };
+  const logging::LoggerPtr& LoggerAccessTskv() const noexcept override {
+    return no_logger_;
+  };
+
+ private:
+  logging::LoggerPtr no_logger_;
+  server::http::HandlerInfoIndex handler_info_index_;
+};
+
+// Server connection and a client socket connected to it
+class ConnectionPair final {
+ public:
+  explicit ConnectionPair(server::net::HttpVersion http_version) {
+    config_.handler_defaults = server::request::HttpRequestConfig{};
+    config_.connection_config.http_version = http_version;
+
+    auto listen_socket = server::net::CreateSocket(config_);
+    client_ = engine::io::Socket{listen_socket.Getsockname().Domain(),
+                                 engine::io::SocketType::kStream};
+    client_.Connect(listen_socket.Getsockname(), {});
+
+    connection_ = server::net::Connection::Create(
+        engine::current_task::GetTaskProcessor(), config_.connection_config,
+        config_.handler_defaults, listen_socket.Accept({}), handler_,
+        std::make_shared<server::net::Stats>(), data_accounter_);
+    connection_->Start();
+  }
+
+  ~ConnectionPair() {
+    client_.Close();
+    connection_->Stop();
+  }
+
+  engine::io::Socket& GetClient() { return client_; }
+
+ private:
+  server::net::ListenerConfig config_;
+  NoopRequestHandler handler_;
+  server::request::ResponseDataAccounter data_accounter_;
+  engine::io::Socket client_;
+  std::shared_ptr<server::net::Connection> connection_;
+};
+
+// Sends `count` pipelined requests and waits for all the responses
+void RunHttp11Pipeline(engine::io::Socket& client, std::size_t count) {
+  constexpr std::string_view kRequest =
+      "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  constexpr std::string_view kHeadersEnd = "\r\n\r\n";
+
+  std::string requests;
+  requests.reserve(kRequest.size() * count);
+  for (std::size_t i = 0; i < count; ++i) requests.append(kRequest);
+  [[maybe_unused]] const auto sent_bytes =
+      client.SendAll(requests.data(), requests.size(), {});
+
+  // Responses have no body, count the headers ends
+  std::string received;
+  std::size_t responses = 0;
+  std::array<char, 16 * 1024> buf{};
+  while (responses < count) {
+    const auto bytes_read = client.RecvSome(buf.data(), buf.size(), {});
+    UINVARIANT(bytes_read, "Connection closed by the server");
+    received.append(buf.data(), bytes_read);
+
+    std::size_t pos = 0;
+    std::size_t consumed = 0;
+    while ((pos = received.find(kHeadersEnd, pos)) != std::string::npos) {
+      pos += kHeadersEnd.size();
+      consumed = pos;
+      ++responses;
+    }
+    // Keep the tail that may turn out to be the beginning of a headers end
+    const auto tail_size = std::min(received.size(), kHeadersEnd.size() - 1);
+    received.erase(0, std::max(consumed, received.size() - tail_size));
+  }
+}
+
+class Http2Client final {
+ public:
+  explicit Http2Client(engine::io::Socket& socket)
+      : socket_(socket), session_(nullptr, &nghttp2_session_del) {
+    nghttp2_session_callbacks* callbacks = nullptr;
+    nghttp2_session_callbacks_new(&callbacks);
+    nghttp2_session_callbacks_set_on_stream_close_callback(
+        callbacks, [](nghttp2_session*, std::int32_t, uint32_t,
+                      void* user_data) {
+          ++static_cast<Http2Client*>(user_data)->closed_streams_;
+          return 0;
+        });
+    nghttp2_session* session = nullptr;
+    nghttp2_session_client_new(&session, callbacks, this);
+    nghttp2_session_callbacks_del(callbacks);
+    session_.reset(session);
+
+    nghttp2_submit_settings(session_.get(), NGHTTP2_FLAG_NONE, nullptr, 0);
+  }
+
+  // Sends `count` concurrent streams and waits for all the responses
+  void Run(std::size_t count) {
+    static constexpr std::string_view kHeaders[][2] = {
+        {":method", "GET"},
+        {":scheme", "http"},
+        {":authority", "localhost"},
+        {":path", "/"},
+    };
+    std::array<nghttp2_nv, std::size(kHeaders)> nva{};
+    for (std::size_t i = 0; i < nva.size(); ++i) {
+      const auto [name, value] = kHeaders[i];
+      nva[i] = {reinterpret_cast<uint8_t*>(const_cast<char*>(name.data())),
+                reinterpret_cast<uint8_t*>(const_cast<char*>(value.data())),
+                name.size(), value.size(), NGHTTP2_NV_FLAG_NONE};
+    }
+
+    closed_streams_ = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      nghttp2_submit_request(session_.get(), nullptr, nva.data(), nva.size(),
+                             nullptr, nullptr);
+    }
+    Flush();
+
+    std::array<char, 16 * 1024> buf{};
+    while (closed_streams_ < count) {
+      const auto bytes_read = socket_.RecvSome(buf.data(), buf.size(), {});
+      UINVARIANT(bytes_read, "Connection closed by the server");
+      const auto parsed = nghttp2_session_mem_recv(
+          session_.get(), reinterpret_cast<const uint8_t*>(buf.data()),
+          bytes_read);
+      UINVARIANT(parsed >= 0, "Invalid HTTP/2 data from the server");
+      Flush();
+    }
+  }
+
+ private:
+  void Flush() {
+    std::string out;
+    const uint8_t* data = nullptr;
+    while (const auto size = nghttp2_session_mem_send(session_.get(), &data)) {
+      UINVARIANT(size > 0, "nghttp2_session_mem_send() failed");
+      out.append(reinterpret_cast<const char*>(data), size);
+    }
+    if (out.empty()) return;
+    [[maybe_unused]] const auto sent_bytes =
+        socket_.SendAll(out.data(), out.size(), {});
+  }
+
+  engine::io::Socket& socket_;
+  std::unique_ptr<nghttp2_session, void (*)(nghttp2_session*)> session_;
+  std::size_t closed_streams_{0};
+};
+
+}  // namespace
+
+void connection_http11_pipeline(benchmark::State& state) {
+  engine::RunStandalone(4, [&] {
+    ConnectionPair connection_pair{server::net::HttpVersion::k11};
+    for (auto _ : state) {
+      RunHttp11Pipeline(connection_pair.GetClient(), state.range(0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  });
+}
+BENCHMARK(connection_http11_pipeline)->RangeMultiplier(4)->Range(1, 64);
+
+void connection_http2_streams(benchmark::State& state) {
+  engine::RunStandalone(4, [&] {
+    ConnectionPair connection_pair{server::net::HttpVersion::k2};
+    Http2Client client{connection_pair.GetClient()};
+    for (auto _ : state) client.Run(state.range(0));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  });
+}
+BENCHMARK(connection_http2_streams)->RangeMultiplier(4)->Range(1, 64);
+
+USERVER_NAMESPACE_END
@@ -1,11 +1,38 @@
 #include <server/net/connection_config.hpp>
 
+#include <userver/utils/assert.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+HttpVersion Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<HttpVersion>) {
+  const auto str = value.As<std::string>();
+  if (str == "1.1") {
+    return HttpVersion::k11;
+  } else if (str == "2") {
+    return HttpVersion::k2;
+  }
+
+  UINVARIANT(false, "Unknown HTTP version: " + str);
+}
+
+Http2SessionConfig Parse(const yaml_config::YamlConfig& value,
+                         formats::parse::To<Http2SessionConfig>) {
+  Http2SessionConfig config;
+
+  config.max_concurrent_streams = value["max_concurrent_streams"].As<uint32_t>(
+      config.max_concurrent_streams);
+  config.max_frame_size =
+      value["max_frame_size"].As<uint32_t>(config.max_frame_size);
+  config.initial_window_size =
+      value["initial_window_size"].As<uint32_t>(config.initial_window_size);
+
+  return config;
+}
+
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ConnectionConfig>) {
   ConnectionConfig config;
@@ -18,6 +45,10 @@ ConnectionConfig Parse(const yaml_config::YamlConfig& value,
   config.keepalive_timeout =
       value["keepalive_timeout"].As<std::chrono::seconds>(
           config.keepalive_timeout);
+  config.http_version =
+      value["http-version"].As<HttpVersion>(config.http_version);
+  config.http2_session =
+      value["http2-session"].As<Http2SessionConfig>(config.http2_session);
 
   return config;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -9,10 +10,29 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+enum class HttpVersion {
+  k11,  // HTTP/1.1 only
+  k2,   // HTTP/2 with prior knowledge (h2c) and HTTP/1.1
+};
+
+HttpVersion Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<HttpVersion>);
+
+struct Http2SessionConfig {
+  std::uint32_t max_concurrent_streams = 100;
+  std::uint32_t max_frame_size = 16 * 1024;
+  std::uint32_t initial_window_size = 64 * 1024 - 1;
+};
+
+Http2SessionConfig Parse(const yaml_config::YamlConfig& value,
+                         formats::parse::To<Http2SessionConfig>);
+
 struct ConnectionConfig {
   size_t in_buffer_size = 32 * 1024;
   size_t requests_queue_size_threshold = 100;
   std::chrono::seconds keepalive_timeout{10 * 60};
+  HttpVersion http_version = HttpVersion::k11;
+  Http2SessionConfig http2_session;
 };
 
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
@@ -92,6 +92,16 @@ clients::http::ResponseFuture CreateRequest(
   return ret->async_perform();
 }
 
+clients::http::ResponseFuture CreateHttp2Request(
+    clients::http::Client& http_client, engine::io::Socket& request_socket) {
+  return http_client.CreateRequest()
+      ->get(HttpConnectionUriFromSocket(request_socket))
+      ->http_version(clients::http::HttpVersion::k2PriorKnowledge)
+      ->retry(1)
+      ->timeout(utest::kMaxTestWaitTime)
+      ->async_perform();
+}
+
 net::ListenerConfig CreateConfig() {
   net::ListenerConfig config;
   config.handler_defaults = server::request::HttpRequestConfig{};
@@ -339,4 +349,100 @@ UTEST(ServerNetConnection, CancelMultipleInFlight) {
   FAIL() << "Failed to simulate cancellation of multiple requests";
 }
 
+UTEST(ServerNetConnection, Http2PriorKnowledge) {
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.http_version = net::HttpVersion::k2;
+  auto request_socket = net::CreateSocket(config);
+
+  auto http_client_ptr = utest::CreateHttpClient();
+  auto request = CreateHttp2Request(*http_client_ptr, request_socket);
+
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler;
+
+  auto connection_ptr = net::Connection::Create(
+      engine::current_task::GetTaskProcessor(), config.connection_config,
+      config.handler_defaults, std::move(peer), handler, stats, data_accounter);
+
+  connection_ptr->Start();
+  EXPECT_EQ(request.Get()->status_code(), 404);
+  EXPECT_EQ(handler.asyncs_finished, 1);
+
+  // The connection is kept alive
+  request = CreateHttp2Request(*http_client_ptr, request_socket);
+  EXPECT_EQ(request.Get()->status_code(), 404);
+  EXPECT_EQ(handler.asyncs_finished, 2);
+  EXPECT_EQ(stats->requests_processed_count, 2);
+}
+
+UTEST(ServerNetConnection, Http2MultiplexedStreams) {
+  constexpr std::size_t kInFlightRequests = 10;
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.http_version = net::HttpVersion::k2;
+  auto request_socket = net::CreateSocket(config);
+
+  auto http_client_ptr = utest::CreateHttpClient();
+  http_client_ptr->SetMaxHostConnections(1);
+
+  std::vector<clients::http::ResponseFuture> requests;
+  for (std::size_t i = 0; i < kInFlightRequests; ++i) {
+    requests.push_back(CreateHttp2Request(*http_client_ptr, request_socket));
+  }
+
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler;
+
+  auto connection_ptr = net::Connection::Create(
+      engine::current_task::GetTaskProcessor(), config.connection_config,
+      config.handler_defaults, std::move(peer), handler, stats, data_accounter);
+
+  connection_ptr->Start();
+  for (auto& request : requests) {
+    EXPECT_EQ(request.Get()->status_code(), 404);
+  }
+  EXPECT_EQ(handler.asyncs_finished, kInFlightRequests);
+  EXPECT_EQ(stats->active_connections, 1);
+}
+
+UTEST(ServerNetConnection, Http2CancelInFlight) {
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.http_version = net::HttpVersion::k2;
+  auto request_socket = net::CreateSocket(config);
+
+  auto http_client_ptr = utest::CreateHttpClient();
+  auto request = CreateHttp2Request(*http_client_ptr, request_socket);
+
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler{TestHttprequestHandler::Behaviors::kHang};
+
+  auto connection_ptr = net::Connection::Create(
+      engine::current_task::GetTaskProcessor(), config.connection_config,
+      config.handler_defaults, std::move(peer), handler, stats, data_accounter);
+
+  connection_ptr->Start();
+  while (stats->active_request_count == 0) engine::Yield();
+
+  connection_ptr->Stop();
+  std::weak_ptr<net::Connection> weak = connection_ptr;
+  connection_ptr.reset();
+
+  auto task = engine::AsyncNoSpan([weak]() {
+    while (weak.lock()) engine::Yield();
+  });
+
+  task.WaitFor(utest::kMaxTestWaitTime);
+  EXPECT_TRUE(task.IsFinished());
+  EXPECT_EQ(handler.asyncs_finished, 1);
+  UEXPECT_THROW(request.Get(), std::exception);
+}
+
 USERVER_NAMESPACE_END
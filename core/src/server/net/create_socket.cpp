@@ -7,6 +7,11 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#ifdef __linux__
+#include <linux/filter.h>
+#endif
+
+#include <array>
 #include <cstdint>
 #include <cstring>
 #include <stdexcept>
@@ -21,6 +26,8 @@
 #include <userver/engine/sleep.hpp>
 #include <userver/fs/blocking/read.hpp>
 #include <userver/fs/blocking/write.hpp>
+#include <userver/logging/log.hpp>
+#include <utils/check_syscall.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -82,6 +89,30 @@ engine::io::Socket CreateSocket(const ListenerConfig& config) {
     return CreateUnixSocket(config.unix_socket_path, config.backlog);
 }
 
+void AttachReuseportCpuSteering(engine::io::Socket& socket, size_t shards) {
+  if (shards <= 1) return;
+
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+  // return cpu % shards;
+  std::array<struct sock_filter, 3> code{{
+      {BPF_LD | BPF_W | BPF_ABS, 0, 0,
+       static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+      {BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<uint32_t>(shards)},
+      {BPF_RET | BPF_A, 0, 0, 0},
+  }};
+  struct sock_fprog program {};
+  program.len = code.size();
+  program.filter = code.data();
+
+  utils::CheckSyscall(
+      ::setsockopt(socket.Fd(), SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program,
+                   sizeof(program)),
+      "attaching reuseport BPF program, fd={}", socket.Fd());
+#else
+  LOG_WARNING() << "Reuseport CPU steering is not supported on this platform";
+#endif
+}
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
@@ -9,6 +9,12 @@ namespace server::net {
 
 engine::io::Socket CreateSocket(const ListenerConfig& config);
 
+/// Makes the kernel pass a new connection to the listening socket number
+/// `cpu % shards` of the SO_REUSEPORT group of the socket, where `cpu` is the
+/// CPU that handles the incoming packet. Does nothing on the platforms without
+/// the reuseport BPF support.
+void AttachReuseportCpuSteering(engine::io::Socket& socket, size_t shards);
+
 }  // namespace server::net
 
 USERVER_NAMESPACE_END
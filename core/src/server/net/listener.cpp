@@ -1,5 +1,6 @@
 #include "listener.hpp"
 
+#include <engine/ev/thread_pool.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/logging/log.hpp>
 
@@ -9,10 +10,13 @@ namespace server::net {
 
 Listener::Listener(std::shared_ptr<EndpointInfo> endpoint_info,
                    engine::TaskProcessor& task_processor,
-                   request::ResponseDataAccounter& data_accounter)
+                   request::ResponseDataAccounter& data_accounter,
+                   engine::ev::ThreadControl& ev_thread, size_t shards)
     : task_processor_(&task_processor),
       endpoint_info_(std::move(endpoint_info)),
-      data_accounter_(&data_accounter) {}
+      data_accounter_(&data_accounter),
+      ev_thread_(&ev_thread),
+      shards_(shards) {}
 
 Listener::~Listener() {
   if (!impl_) return;
@@ -23,8 +27,10 @@ Listener::~Listener() {
 }
 
 void Listener::Start() {
+  // Listening sockets of the shards are served by different ev threads
+  engine::ev::EventThreadScope ev_thread_scope(*ev_thread_);
   impl_ = std::make_unique<ListenerImpl>(*task_processor_, endpoint_info_,
-                                         *data_accounter_);
+                                         *data_accounter_, shards_);
 }
 
 Stats Listener::GetStats() const {
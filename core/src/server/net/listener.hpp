@@ -2,6 +2,7 @@
 
 #include <memory>
 
+#include <engine/ev/thread_control.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 
 #include "endpoint_info.hpp"
@@ -14,9 +15,12 @@ namespace server::net {
 
 class Listener final {
  public:
+  /// @param ev_thread ev thread to serve the listening socket
+  /// @param shards number of the listeners of the endpoint
   Listener(std::shared_ptr<EndpointInfo> endpoint_info,
            engine::TaskProcessor& task_processor,
-           request::ResponseDataAccounter& data_accounter);
+           request::ResponseDataAccounter& data_accounter,
+           engine::ev::ThreadControl& ev_thread, size_t shards);
   ~Listener();
 
   Listener(const Listener&) = delete;
@@ -32,6 +36,8 @@ class Listener final {
   engine::TaskProcessor* task_processor_;
   std::shared_ptr<EndpointInfo> endpoint_info_;
   request::ResponseDataAccounter* data_accounter_;
+  engine::ev::ThreadControl* ev_thread_;
+  size_t shards_;
 
   std::unique_ptr<ListenerImpl> impl_;
 };
@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include <sys/socket.h>
+
+#include <cstddef>
+#include <vector>
+
+#include <engine/ev/thread_pool.hpp>
+#include <engine/task/task_processor.hpp>
+#include <server/net/create_socket.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/io/exception.hpp>
+#include <userver/engine/io/socket.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/cancel.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kThreads = 4;
+constexpr std::size_t kConnectionsPerIteration = 64;
+
+// Accepts and drops connections on `shards` SO_REUSEPORT sockets, each one
+// served by its own accept task and ev thread, the same way the listener
+// shards are
+class Acceptors final {
+ public:
+  Acceptors(std::size_t shards, bool cpu_steering) {
+    auto& ev_pool = engine::current_task::GetTaskProcessor().EventThreadPool();
+    for (auto* ev_thread : ev_pool.NextThreads(shards)) {
+      engine::ev::EventThreadScope ev_thread_scope(*ev_thread);
+      auto socket = server::net::CreateSocket(config_);
+      // The first socket picks a free port for the whole group
+      if (!config_.port) {
+        address_ = socket.Getsockname();
+        config_.port = address_.Port();
+      }
+      if (cpu_steering) {
+        server::net::AttachReuseportCpuSteering(socket, shards);
+      }
+
+      accept_tasks_.push_back(engine::CriticalAsyncNoSpan(
+          [](engine::io::Socket&& socket) {
+            while (!engine::current_task::ShouldCancel()) {
+              try {
+                socket.Accept({}).Close();
+              } catch (const engine::io::IoCancelled&) {
+                break;
+              }
+            }
+          },
+          std::move(socket)));
+    }
+  }
+
+  ~Acceptors() {
+    for (auto& task : accept_tasks_) task.SyncCancel();
+  }
+
+  const engine::io::Sockaddr& GetAddress() const { return address_; }
+
+ private:
+  server::net::ListenerConfig config_;
+  engine::io::Sockaddr address_;
+  std::vector<engine::TaskWithResult<void>> accept_tasks_;
+};
+
+void Connect(const engine::io::Sockaddr& address) {
+  engine::io::Socket client{address.Domain(), engine::io::SocketType::kStream};
+  // Reset instead of the orderly shutdown, to not run out of the ephemeral
+  // ports because of the TIME_WAIT sockets
+  struct linger linger_option {};
+  linger_option.l_onoff = 1;
+  linger_option.l_linger = 0;
+  ::setsockopt(client.Fd(), SOL_SOCKET, SO_LINGER, &linger_option,
+               sizeof(linger_option));
+  client.Connect(address, {});
+}
+
+}  // namespace
+
+void ListenerConnectRate(benchmark::State& state) {
+  engine::TaskProcessorPoolsConfig config;
+  config.ev_threads_num = kThreads;
+  engine::RunStandalone(kThreads, config, [&] {
+    const Acceptors acceptors(state.range(0), state.range(1));
+
+    std::vector<engine::TaskWithResult<void>> clients;
+    clients.reserve(kConnectionsPerIteration);
+    for (auto _ : state) {
+      for (std::size_t i = 0; i < kConnectionsPerIteration; ++i) {
+        clients.push_back(engine::AsyncNoSpan(
+            [&acceptors] { Connect(acceptors.GetAddress()); }));
+      }
+      for (auto& client : clients) client.Get();
+      clients.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * kConnectionsPerIteration);
+  });
+}
+// {shards, reuseport-cpu-steering}
+BENCHMARK(ListenerConnectRate)
+    ->Args({1, 0})
+    ->Args({kThreads, 0})
+    ->Args({kThreads, 1})
+    ->UseRealTime();
+
+USERVER_NAMESPACE_END
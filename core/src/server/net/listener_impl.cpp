@@ -24,7 +24,8 @@ namespace server::net {
 
 ListenerImpl::ListenerImpl(engine::TaskProcessor& task_processor,
                            std::shared_ptr<EndpointInfo> endpoint_info,
-                           request::ResponseDataAccounter& data_accounter)
+                           request::ResponseDataAccounter& data_accounter,
+                           size_t shards)
     : task_processor_(task_processor),
       endpoint_info_(std::move(endpoint_info)),
       stats_(std::make_shared<Stats>()),
@@ -46,7 +47,7 @@ ListenerImpl::ListenerImpl(engine::TaskProcessor& task_processor,
               }
             }
           },
-          CreateSocket(endpoint_info_->listener_config))) {}
+          CreateListenSocket(shards))) {}
 
 ListenerImpl::~ListenerImpl() {
   LOG_TRACE() << "Stopping socket listener task";
@@ -62,6 +63,15 @@ engine::TaskProcessor& ListenerImpl::GetTaskProcessor() const {
   return task_processor_;
 }
 
+engine::io::Socket ListenerImpl::CreateListenSocket(size_t shards) const {
+  const auto& config = endpoint_info_->listener_config;
+  auto socket = CreateSocket(config);
+  if (config.reuseport_cpu_steering && config.unix_socket_path.empty()) {
+    AttachReuseportCpuSteering(socket, shards);
+  }
+  return socket;
+}
+
 void ListenerImpl::AcceptConnection(engine::io::Socket& request_socket) {
   auto peer_socket = request_socket.Accept({});
 
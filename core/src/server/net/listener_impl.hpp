@@ -19,9 +19,11 @@ namespace server::net {
 
 class ListenerImpl final {
  public:
+  /// @param shards number of the listeners of the endpoint
   ListenerImpl(engine::TaskProcessor& task_processor,
                std::shared_ptr<EndpointInfo> endpoint_info,
-               request::ResponseDataAccounter& data_accounter);
+               request::ResponseDataAccounter& data_accounter,
+               size_t shards = 1);
   ~ListenerImpl();
 
   Stats GetStats() const;
@@ -29,6 +31,8 @@ class ListenerImpl final {
   engine::TaskProcessor& GetTaskProcessor() const;
 
  private:
+  engine::io::Socket CreateListenSocket(size_t shards) const;
+
   void AcceptConnection(engine::io::Socket& request_socket);
 
   void SetupConnection(engine::io::Socket peer_socket);
@@ -148,12 +148,14 @@ void ServerImpl::InitPortInfo(
   info.endpoint_info_ = std::make_shared<net::EndpointInfo>(
       listener_config, *info.request_handler_);
 
-  const auto& event_thread_pool = task_processor.EventThreadPool();
-  size_t listener_shards = listener_config.shards ? *listener_config.shards
-                                                  : event_thread_pool.GetSize();
-  while (listener_shards--) {
+  auto& event_thread_pool = task_processor.EventThreadPool();
+  const size_t listener_shards = listener_config.shards
+                                     ? *listener_config.shards
+                                     : event_thread_pool.GetSize();
+  for (auto* ev_thread : event_thread_pool.NextThreads(listener_shards)) {
     info.listeners_.emplace_back(info.endpoint_info_, task_processor,
-                                 info.data_accounter_);
+                                 info.data_accounter_, *ev_thread,
+                                 listener_shards);
   }
 }
 
@@ -0,0 +1,88 @@
+#include <tracing/hex_id.hpp>
+
+#include <random>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+namespace {
+
+constexpr char kHexDigits[] = "0123456789abcdef";
+
+void WriteHex(std::uint64_t value, char* out) noexcept {
+  for (int i = 15; i >= 0; --i) {
+    out[i] = kHexDigits[value & 0xf];
+    value >>= 4;
+  }
+}
+
+}  // namespace
+
+HexId::HexId(const HexId& other)
+    : inline_(other.inline_), inline_size_(other.inline_size_) {
+  // The cached string of an inline id is not copied, so that copies never
+  // allocate
+  if (!inline_size_) string_ = other.string_;
+}
+
+HexId& HexId::operator=(const HexId& other) {
+  if (this == &other) return *this;
+  inline_ = other.inline_;
+  inline_size_ = other.inline_size_;
+  if (inline_size_) {
+    string_.clear();
+  } else {
+    string_ = other.string_;
+  }
+  return *this;
+}
+
+HexId HexId::Generate(std::size_t size) {
+  UASSERT(size == kSpanIdSize || size == kTraceIdSize);
+  std::uniform_int_distribution<std::uint64_t> dist;
+  auto& random = utils::DefaultRandom();
+
+  HexId result;
+  WriteHex(dist(random), result.inline_.data());
+  if (size == kTraceIdSize) WriteHex(dist(random), result.inline_.data() + 16);
+  result.inline_size_ = static_cast<std::uint8_t>(size * 2);
+  return result;
+}
+
+HexId HexId::FromString(std::string_view id) {
+  HexId result;
+  if (id.size() <= kMaxInlineSize) {
+    id.copy(result.inline_.data(), id.size());
+    result.inline_size_ = static_cast<std::uint8_t>(id.size());
+  } else {
+    result.string_ = std::string{id};
+  }
+  return result;
+}
+
+HexId HexId::FromString(std::string&& id) {
+  if (id.size() <= kMaxInlineSize) return FromString(std::string_view{id});
+
+  HexId result;
+  result.string_ = std::move(id);
+  return result;
+}
+
+const std::string& HexId::ToString() const {
+  if (inline_size_ && string_.empty()) {
+    string_.assign(inline_.data(), inline_size_);
+  }
+  return string_;
+}
+
+std::string HexId::Extract() && {
+  if (inline_size_ && string_.empty()) return std::string{GetView()};
+  return std::move(string_);
+}
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
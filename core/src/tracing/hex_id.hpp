@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+/// @brief Trace id or span id.
+///
+/// Generated ids are hex-encoded right away from the random bits, without
+/// the intermediate UUID formatting, and are stored inline, so that creating
+/// and copying them never allocates. Ids that come from the outside are kept
+/// as is, so that foreign ids are propagated unchanged. Only the foreign ids
+/// of an unusual length are stored in a heap string.
+class HexId final {
+ public:
+  static constexpr std::size_t kSpanIdSize = 8;
+  static constexpr std::size_t kTraceIdSize = 16;
+
+  HexId() = default;
+
+  HexId(const HexId& other);
+  HexId(HexId&&) noexcept = default;
+  HexId& operator=(const HexId& other);
+  HexId& operator=(HexId&&) noexcept = default;
+
+  /// Random id of `size` bytes, kSpanIdSize or kTraceIdSize
+  static HexId Generate(std::size_t size);
+
+  static HexId FromString(std::string_view id);
+  static HexId FromString(std::string&& id);
+
+  bool IsEmpty() const noexcept { return GetView().empty(); }
+
+  std::string_view GetView() const noexcept {
+    return inline_size_ ? std::string_view{inline_.data(), inline_size_}
+                        : std::string_view{string_};
+  }
+
+  /// Makes a string of an inline id on the first call, so it is as
+  /// thread-safe as the owning span
+  const std::string& ToString() const;
+
+  std::string Extract() &&;
+
+ private:
+  static constexpr std::size_t kMaxInlineSize = kTraceIdSize * 2;
+
+  std::array<char, kMaxInlineSize> inline_{};
+  std::uint8_t inline_size_{0};
+  // The id if it is not inline, otherwise the cached result of ToString()
+  mutable std::string string_;
+};
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #include <tracing/span_impl.hpp>
 
-#include <random>
+#include <atomic>
+#include <new>
 #include <type_traits>
 
 #include <fmt/compile.h>
@@ -11,7 +12,6 @@
 #include <userver/tracing/span.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/assert.hpp>
-#include <userver/utils/rand.hpp>
 #include <userver/utils/uuid4.hpp>
 #include <utils/internal_tag.hpp>
 
@@ -65,12 +65,6 @@ engine::TaskLocalVariable<boost::intrusive::list<
     Span::Impl, boost::intrusive::constant_time_size<false>>>
     task_local_spans;
 
-std::string GenerateSpanId() {
-  std::uniform_int_distribution<std::uint64_t> dist;
-  auto random_value = dist(utils::DefaultRandom());
-  return fmt::format(FMT_COMPILE("{:016x}"), random_value);
-}
-
 logging::LogHelper& operator<<(logging::LogHelper& lh,
                                tracing::Span::Impl&& span_impl) {
   std::move(span_impl).LogTo(lh);
@@ -93,15 +87,27 @@ Span::Impl::Impl(std::string name, ReferenceType reference_type,
 
 Span::Impl::Impl(TracerPtr tracer, std::string name, const Span::Impl* parent,
                  ReferenceType reference_type, logging::Level log_level)
-    : name_(std::move(name)),
+    : Impl(std::move(tracer), std::move(name), {}, parent, reference_type,
+           log_level) {}
+
+Span::Impl::Impl(TracerPtr tracer, StaticName name, const Span::Impl* parent,
+                 ReferenceType reference_type, logging::Level log_level)
+    : Impl(std::move(tracer), {}, name.value, parent, reference_type,
+           log_level) {}
+
+Span::Impl::Impl(TracerPtr tracer, std::string name_storage,
+                 std::string_view name, const Span::Impl* parent,
+                 ReferenceType reference_type, logging::Level log_level)
+    : name_storage_(std::move(name_storage)),
+      name_(name_storage_.empty() ? name : name_storage_),
       is_no_log_span_(tracing::Tracer::IsNoLogSpan(name_)),
       log_level_(is_no_log_span_ ? logging::Level::kNone : log_level),
       tracer_(std::move(tracer)),
       start_system_time_(std::chrono::system_clock::now()),
       start_steady_time_(std::chrono::steady_clock::now()),
-      trace_id_(parent ? parent->GetTraceId()
-                       : utils::generators::GenerateUuid()),
-      span_id_(GenerateSpanId()),
+      trace_id_(parent ? parent->trace_id_
+                       : impl::HexId::Generate(impl::HexId::kTraceIdSize)),
+      span_id_(impl::HexId::Generate(impl::HexId::kSpanIdSize)),
       parent_id_(GetParentIdForLogging(parent)),
       reference_type_(reference_type) {
   if (parent) {
@@ -127,7 +133,7 @@ Span::Impl::~Impl() {
   logging::LogExtra result;
 
   // Using result.Extend to move construct the keys and values.
-  result.Extend(kStopWatchAttrName, name_);
+  result.Extend(kStopWatchAttrName, std::string{name_});
   result.Extend(kTotalTimeAttrName, total_time_ms);
   result.Extend(kReferenceType, ref_type);
   result.Extend(kTimeUnitsAttrName, "ms");
@@ -143,12 +149,18 @@ Span::Impl::~Impl() {
 }
 
 void Span::Impl::LogTo(logging::LogHelper& log_helper) const& {
-  log_helper << log_extra_inheritable_;
+  if (log_extra_inheritable_) log_helper << *log_extra_inheritable_;
   tracer_->LogSpanContextTo(*this, log_helper);
 }
 
 void Span::Impl::LogTo(logging::LogHelper& log_helper) && {
-  log_helper << std::move(log_extra_inheritable_);
+  if (log_extra_inheritable_) {
+    if (log_extra_inheritable_.use_count() == 1) {
+      log_helper << std::move(*log_extra_inheritable_);
+    } else {
+      log_helper << *log_extra_inheritable_;
+    }
+  }
   tracer_->LogSpanContextTo(std::move(*this), log_helper);
 }
 
@@ -159,11 +171,11 @@ void Span::Impl::AttachToCoroStack() {
   task_local_spans->push_back(*this);
 }
 
-std::string Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
+impl::HexId Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
   if (!parent) return {};
 
   if (!parent->is_linked()) {
-    return parent->GetSpanId();
+    return parent->span_id_;
   }
 
   const auto* spans_ptr = task_local_spans.GetOptional();
@@ -176,9 +188,9 @@ std::string Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
   // orphaned. It's still possible for chaining to break in case parent span
   // becomes non-loggable after child span is created, but that we can't control
   for (auto current = spans_ptr->iterator_to(*parent);; --current) {
-    if (current->GetParentId().empty() /* won't find better candidate */ ||
+    if (current->parent_id_.IsEmpty() /* won't find better candidate */ ||
         current->ShouldLog()) {
-      return current->GetSpanId();
+      return current->span_id_;
     }
     if (current == spans_ptr->begin()) break;
   };
@@ -194,16 +206,81 @@ bool Span::Impl::ShouldLog() const {
          local_log_level_.value_or(logging::Level::kTrace) <= log_level_;
 }
 
+logging::LogExtra& Span::Impl::GetInheritableTagsForWrite() {
+  if (!log_extra_inheritable_) {
+    log_extra_inheritable_ = std::make_shared<logging::LogExtra>();
+  } else if (log_extra_inheritable_.use_count() != 1) {
+    log_extra_inheritable_ =
+        std::make_shared<logging::LogExtra>(*log_extra_inheritable_);
+  } else {
+    // Pairs with the release of the last reference by another span
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  return *log_extra_inheritable_;
+}
+
 namespace {
+
+// Span::Impl is several kilobytes and the spans are created at a high rate.
+// The freed memory is cached per thread, so the spans of the tasks on the
+// thread reuse it without going to the allocator. The cache is accessed with
+// no suspension points in between, so the task migration is not a problem.
+class ImplMemoryCache final {
+ public:
+  static constexpr std::size_t kMaxSize = 64;
+
+  ImplMemoryCache() = default;
+  ImplMemoryCache(const ImplMemoryCache&) = delete;
+  ImplMemoryCache& operator=(const ImplMemoryCache&) = delete;
+
+  ~ImplMemoryCache() {
+    for (std::size_t i = 0; i < size_; ++i) ::operator delete(memory_[i]);
+    is_destroyed_ = true;
+  }
+
+  void* Allocate() {
+    if (size_ == 0) return ::operator new(sizeof(Span::Impl));
+    return memory_[--size_];
+  }
+
+  void Deallocate(void* memory) noexcept {
+    // Thread-local spans may outlive the cache
+    if (is_destroyed_ || size_ == kMaxSize) {
+      ::operator delete(memory);
+      return;
+    }
+    memory_[size_++] = memory;
+  }
+
+ private:
+  void* memory_[kMaxSize]{};
+  std::size_t size_{0};
+  bool is_destroyed_{false};
+};
+
+ImplMemoryCache& GetImplMemoryCache() noexcept {
+  thread_local ImplMemoryCache cache;
+  return cache;
+}
+
 template <typename... Args>
 Span::Impl* AllocateImpl(Args&&... args) {
-  return new Span::Impl(std::forward<Args>(args)...);
+  auto& cache = GetImplMemoryCache();
+  void* memory = cache.Allocate();
+  try {
+    return new (memory) Span::Impl(std::forward<Args>(args)...);
+  } catch (...) {
+    cache.Deallocate(memory);
+    throw;
+  }
 }
+
 }  // namespace
 
 void Span::OptionalDeleter::operator()(Span::Impl* impl) const noexcept {
   if (do_delete) {
-    std::default_delete<Impl>{}(impl);
+    impl->~Impl();
+    GetImplMemoryCache().Deallocate(impl);
   }
 }
 
@@ -231,7 +308,20 @@ Span::Span(std::string name, ReferenceType reference_type,
                           GetParentSpanImpl(), reference_type, log_level),
              Span::OptionalDeleter{OptionalDeleter::ShouldDelete()}) {
   AttachToCoroStack();
-  if (pimpl_->GetParentId().empty()) {
+  if (pimpl_->parent_id_.IsEmpty()) {
+    SetLink(utils::generators::GenerateUuid());
+  }
+  pimpl_->span_ = this;
+}
+
+Span::Span(StaticSpanName name, ReferenceType reference_type,
+           logging::Level log_level)
+    : pimpl_(AllocateImpl(tracing::Tracer::GetTracer(),
+                          Impl::StaticName{name.Get()}, GetParentSpanImpl(),
+                          reference_type, log_level),
+             Span::OptionalDeleter{OptionalDeleter::ShouldDelete()}) {
+  AttachToCoroStack();
+  if (pimpl_->parent_id_.IsEmpty()) {
     SetLink(utils::generators::GenerateUuid());
   }
   pimpl_->span_ = this;
@@ -272,8 +362,8 @@ Span* Span::CurrentSpanUnchecked() {
 Span Span::MakeSpan(std::string name, std::string_view trace_id,
                     std::string_view parent_span_id) {
   Span span(std::move(name));
-  if (!trace_id.empty()) span.pimpl_->SetTraceId(std::string{trace_id});
-  span.pimpl_->SetParentId(std::string{parent_span_id});
+  if (!trace_id.empty()) span.pimpl_->SetTraceId(trace_id);
+  span.pimpl_->SetParentId(parent_span_id);
   return span;
 }
 
@@ -282,8 +372,8 @@ Span Span::MakeSpan(std::string name, std::string_view trace_id,
   Span span(Tracer::GetTracer(), std::move(name), nullptr,
             ReferenceType::kChild);
   span.SetLink(std::move(link));
-  if (!trace_id.empty()) span.pimpl_->SetTraceId(std::string{trace_id});
-  span.pimpl_->SetParentId(std::string{parent_span_id});
+  if (!trace_id.empty()) span.pimpl_->SetTraceId(trace_id);
+  span.pimpl_->SetParentId(parent_span_id);
   return span;
 }
 
@@ -329,17 +419,19 @@ std::optional<logging::Level> Span::GetLocalLogLevel() const {
 }
 
 void Span::AddTag(std::string key, logging::LogExtra::Value value) {
-  pimpl_->log_extra_inheritable_.Extend(std::move(key), std::move(value));
+  pimpl_->GetInheritableTagsForWrite().Extend(std::move(key),
+                                              std::move(value));
 }
 
 void Span::AddTags(const logging::LogExtra& log_extra, utils::InternalTag) {
-  pimpl_->log_extra_inheritable_.Extend(log_extra);
+  pimpl_->GetInheritableTagsForWrite().Extend(log_extra);
 }
 
 impl::TimeStorage& Span::GetTimeStorage() { return pimpl_->GetTimeStorage(); }
 
 std::string Span::GetTag(std::string_view tag) const {
-  const auto& value = pimpl_->log_extra_inheritable_.GetValue(tag);
+  if (!pimpl_->log_extra_inheritable_) return {};
+  const auto& value = pimpl_->log_extra_inheritable_->GetValue(tag);
   const auto* s = std::get_if<std::string>(&value);
   if (s)
     return *s;
@@ -348,8 +440,8 @@ std::string Span::GetTag(std::string_view tag) const {
 }
 
 void Span::AddTagFrozen(std::string key, logging::LogExtra::Value value) {
-  pimpl_->log_extra_inheritable_.Extend(std::move(key), std::move(value),
-                                        logging::LogExtra::ExtendType::kFrozen);
+  pimpl_->GetInheritableTagsForWrite().Extend(
+      std::move(key), std::move(value), logging::LogExtra::ExtendType::kFrozen);
 }
 
 void Span::SetLink(std::string link) {
@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <list>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -16,6 +17,7 @@
 #include <userver/tracing/span.hpp>
 #include <userver/tracing/tracer.hpp>
 
+#include <tracing/hex_id.hpp>
 #include <tracing/time_storage.hpp>
 
 // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
@@ -36,6 +38,11 @@ class Span::Impl
     : public boost::intrusive::list_base_hook<
           boost::intrusive::link_mode<boost::intrusive::auto_unlink>> {
  public:
+  /// Refers to a string literal instead of copying it
+  struct StaticName final {
+    std::string_view value;
+  };
+
   explicit Impl(std::string name,
                 ReferenceType reference_type = ReferenceType::kChild,
                 logging::Level log_level = logging::Level::kInfo);
@@ -43,7 +50,11 @@ class Span::Impl
   Impl(TracerPtr tracer, std::string name, const Span::Impl* parent,
        ReferenceType reference_type, logging::Level log_level);
 
-  Impl(Impl&&) = default;
+  Impl(TracerPtr tracer, StaticName name, const Span::Impl* parent,
+       ReferenceType reference_type, logging::Level log_level);
+
+  Impl(Impl&&) = delete;
+  Impl& operator=(Impl&&) = delete;
 
   ~Impl();
 
@@ -54,16 +65,26 @@ class Span::Impl
 
   void LogTo(logging::LogHelper& log_helper) &&;
 
-  const std::string& GetTraceId() const& noexcept { return trace_id_; }
-  const std::string& GetSpanId() const& noexcept { return span_id_; }
-  const std::string& GetParentId() const& noexcept { return parent_id_; }
-
-  std::string GetTraceId() && noexcept { return std::move(trace_id_); }
-  std::string GetSpanId() && noexcept { return std::move(span_id_); }
-  std::string GetParentId() && noexcept { return std::move(parent_id_); }
-
-  void SetTraceId(std::string&& id) noexcept { trace_id_ = std::move(id); }
-  void SetParentId(std::string&& id) noexcept { parent_id_ = std::move(id); }
+  const std::string& GetTraceId() const& { return trace_id_.ToString(); }
+  const std::string& GetSpanId() const& { return span_id_.ToString(); }
+  const std::string& GetParentId() const& { return parent_id_.ToString(); }
+
+  std::string GetTraceId() && { return std::move(trace_id_).Extract(); }
+  std::string GetSpanId() && { return std::move(span_id_).Extract(); }
+  std::string GetParentId() && { return std::move(parent_id_).Extract(); }
+
+  void SetTraceId(std::string&& id) {
+    trace_id_ = impl::HexId::FromString(std::move(id));
+  }
+  void SetTraceId(std::string_view id) {
+    trace_id_ = impl::HexId::FromString(id);
+  }
+  void SetParentId(std::string&& id) {
+    parent_id_ = impl::HexId::FromString(std::move(id));
+  }
+  void SetParentId(std::string_view id) {
+    parent_id_ = impl::HexId::FromString(id);
+  }
 
   ReferenceType GetReferenceType() const noexcept { return reference_type_; }
 
@@ -75,16 +96,26 @@ class Span::Impl
   static void AddOpentracingTags(formats::json::ValueBuilder& output,
                                  const logging::LogExtra& input);
 
-  static std::string GetParentIdForLogging(const Span::Impl* parent);
+  Impl(TracerPtr tracer, std::string name_storage, std::string_view name,
+       const Span::Impl* parent, ReferenceType reference_type,
+       logging::Level log_level);
+
+  static impl::HexId GetParentIdForLogging(const Span::Impl* parent);
   bool ShouldLog() const;
 
-  const std::string name_;
+  // Copies the tags shared with the other spans before the modification
+  logging::LogExtra& GetInheritableTagsForWrite();
+
+  const std::string name_storage_;
+  const std::string_view name_;
   const bool is_no_log_span_;
   logging::Level log_level_;
   std::optional<logging::Level> local_log_level_;
 
   std::shared_ptr<Tracer> tracer_;
-  logging::LogExtra log_extra_inheritable_;
+  // Shared with the children until either of them adds a tag, so creating a
+  // child span does not copy the tags. Null if there are no tags.
+  std::shared_ptr<logging::LogExtra> log_extra_inheritable_;
 
   Span* span_{nullptr};
 
@@ -94,9 +125,9 @@ class Span::Impl
   const std::chrono::system_clock::time_point start_system_time_;
   const std::chrono::steady_clock::time_point start_steady_time_;
 
-  std::string trace_id_;
-  std::string span_id_;
-  std::string parent_id_;
+  impl::HexId trace_id_;
+  impl::HexId span_id_;
+  impl::HexId parent_id_;
   const ReferenceType reference_type_;
 
   friend class Span;
@@ -651,4 +651,73 @@ UTEST_F(Span, MakeSpanWithParentIdTraceIdLinkWithExisting) {
   }
 }
 
+UTEST_F(Span, GeneratedIds) {
+  const auto is_hex = [](const std::string& id) {
+    return id.find_first_not_of("0123456789abcdef") == std::string::npos;
+  };
+
+  tracing::Span root_span("root_span");
+  EXPECT_EQ(root_span.GetTraceId().size(), 32);
+  EXPECT_EQ(root_span.GetSpanId().size(), 16);
+  EXPECT_TRUE(is_hex(root_span.GetTraceId()));
+  EXPECT_TRUE(is_hex(root_span.GetSpanId()));
+  EXPECT_EQ(root_span.GetParentId(), "");
+
+  tracing::Span child_span("child_span");
+  EXPECT_EQ(child_span.GetTraceId(), root_span.GetTraceId());
+  EXPECT_EQ(child_span.GetParentId(), root_span.GetSpanId());
+  EXPECT_NE(child_span.GetSpanId(), root_span.GetSpanId());
+
+  logging::LogFlush();
+  EXPECT_NE(GetStreamString().find("trace_id=" + root_span.GetTraceId()),
+            std::string::npos);
+}
+
+UTEST_F(Span, StaticName) {
+  {
+    tracing::Span span{tracing::StaticSpanName{"static_span"}};
+    EXPECT_EQ(span.GetParentId(), "");
+  }
+  logging::LogFlush();
+  EXPECT_NE(GetStreamString().find("stopwatch_name=static_span"),
+            std::string::npos);
+}
+
+UTEST_F(Span, ForeignIdsAreKeptAsIs) {
+  for (const std::string id :
+       {"0123456789abcdef0123456789abcdef", "0123456789ABCDEF0123456789ABCDEF",
+        "0000000000000000", "0123456789abcdeX", "x"}) {
+    tracing::Span span = tracing::Span::MakeSpan("span", id, id);
+    EXPECT_EQ(span.GetTraceId(), id);
+    EXPECT_EQ(span.GetParentId(), id);
+
+    tracing::Span child_span("child_span");
+    EXPECT_EQ(child_span.GetTraceId(), id);
+  }
+}
+
+UTEST_F(Span, TagsAreNotSharedAfterChildCreation) {
+  tracing::Span root_span("root_span");
+  root_span.AddTag("common", "root");
+
+  auto child_span = root_span.CreateChild("child_span");
+  child_span.AddTag("child_only", 1);
+  root_span.AddTag("root_only", 2);
+  root_span.AddTag("common", "changed");
+
+  logging::LogFlush();
+  {
+    // Logs with the tags of the current span, which is the child
+    LOG_INFO() << "from child";
+  }
+  logging::LogFlush();
+  const auto logs = GetStreamString();
+  const auto pos = logs.find("from child");
+  ASSERT_NE(pos, std::string::npos);
+  const auto line = logs.substr(logs.rfind('\n', pos) + 1);
+  EXPECT_NE(line.find("common=root"), std::string::npos);
+  EXPECT_NE(line.find("child_only=1"), std::string::npos);
+  EXPECT_EQ(line.find("root_only"), std::string::npos);
+}
+
 USERVER_NAMESPACE_END
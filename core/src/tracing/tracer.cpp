@@ -1,6 +1,8 @@
 #include <userver/tracing/tracer.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <functional>
 
 #include <tracing/no_log_spans.hpp>
 #include <userver/rcu/rcu.hpp>
@@ -25,15 +27,14 @@ auto& GlobalTracer() {
   return tracer;
 }
 
-template <class T>
-bool ValueMatchPrefix(const T& value, const T& prefix) {
+bool ValueMatchPrefix(std::string_view value, std::string_view prefix) {
   return prefix.size() <= value.size() &&
          value.compare(0, prefix.size(), prefix) == 0;
 }
 
-template <class T>
-bool ValueMatchesOneOfPrefixes(const T& value,
-                               const boost::container::flat_set<T>& prefixes) {
+bool ValueMatchesOneOfPrefixes(
+    std::string_view value,
+    const boost::container::flat_set<std::string>& prefixes) {
   for (const auto& prefix : prefixes) {
     if (ValueMatchPrefix(value, prefix)) {
       return true;
@@ -56,11 +57,12 @@ void Tracer::SetNoLogSpans(NoLogSpans&& spans) {
   global_spans.Assign(std::move(spans));
 }
 
-bool Tracer::IsNoLogSpan(const std::string& name) {
+bool Tracer::IsNoLogSpan(std::string_view name) {
   const auto spans = GlobalNoLogSpans().Read();
 
   return ValueMatchesOneOfPrefixes(name, spans->prefixes) ||
-         spans->names.find(name) != spans->names.end();
+         std::binary_search(spans->names.begin(), spans->names.end(), name,
+                            std::less<>{});
 }
 
 void Tracer::SetTracer(std::shared_ptr<Tracer> tracer) {
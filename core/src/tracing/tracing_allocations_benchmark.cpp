@@ -0,0 +1,157 @@
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/tracing/noop.hpp>
+#include <userver/tracing/opentracing.hpp>
+
+#include <tracing/hex_id.hpp>
+#include <utils/gbench_allocations.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class SpanCounters final {
+ public:
+  explicit SpanCounters(benchmark::State& state)
+      : state_(state),
+        allocations_before_(utils::impl::GetThreadAllocationsCount()) {}
+
+  ~SpanCounters() {
+    const auto spans = state_.iterations() * spans_per_iteration_;
+    state_.SetItemsProcessed(spans);
+    state_.counters["allocs_per_span"] = benchmark::Counter(
+        static_cast<double>(utils::impl::GetThreadAllocationsCount() -
+                            allocations_before_) /
+        spans);
+  }
+
+  void SetSpansPerIteration(std::size_t spans) { spans_per_iteration_ = spans; }
+
+ private:
+  benchmark::State& state_;
+  const std::size_t allocations_before_;
+  std::size_t spans_per_iteration_{1};
+};
+
+void tracing_noop_ctr(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    auto tracer = tracing::MakeNoopTracer("test_service");
+
+    SpanCounters counters{state};
+    for (auto _ : state)
+      benchmark::DoNotOptimize(tracer->CreateSpanWithoutParent("name"));
+  });
+}
+BENCHMARK(tracing_noop_ctr);
+
+// The way the spans of the downstream calls are created within a request
+void tracing_child_span(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    tracing::Span root_span{"http/handler-some-long-name"};
+    root_span.AddTag("meta_type", "/v1/some/long/handler/path");
+    root_span.AddTag("http_method", "POST");
+
+    SpanCounters counters{state};
+    for (auto _ : state) {
+      tracing::Span span{
+          tracing::StaticSpanName{"external/downstream-service-call"}};
+      benchmark::DoNotOptimize(span);
+    }
+  });
+}
+BENCHMARK(tracing_child_span);
+
+void tracing_child_span_dynamic_name(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    tracing::Span root_span{"http/handler-some-long-name"};
+    const std::string name = "external/downstream-service-call";
+
+    SpanCounters counters{state};
+    for (auto _ : state) {
+      tracing::Span span{name};
+      benchmark::DoNotOptimize(span);
+    }
+  });
+}
+BENCHMARK(tracing_child_span_dynamic_name);
+
+void tracing_nested_spans(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    tracing::Span root_span{"http/handler-some-long-name"};
+
+    SpanCounters counters{state};
+    counters.SetSpansPerIteration(3);
+    for (auto _ : state) {
+      tracing::Span call_span{
+          tracing::StaticSpanName{"external/downstream-service-call"}};
+      tracing::Span retry_span{
+          tracing::StaticSpanName{"external/downstream-service-try"}};
+      tracing::Span parse_span{tracing::StaticSpanName{"parse_response"}};
+      benchmark::DoNotOptimize(parse_span);
+    }
+  });
+}
+BENCHMARK(tracing_nested_spans);
+
+void tracing_span_ids(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    tracing::Span root_span{"http/handler-some-long-name"};
+
+    SpanCounters counters{state};
+    for (auto _ : state) {
+      tracing::Span span{
+          tracing::StaticSpanName{"external/downstream-service-call"}};
+      benchmark::DoNotOptimize(span.GetTraceId());
+      benchmark::DoNotOptimize(span.GetSpanId());
+    }
+  });
+}
+BENCHMARK(tracing_span_ids);
+
+// The ids of every span, they are stored inline and must not allocate
+void tracing_generate_ids(benchmark::State& state) {
+  using tracing::impl::HexId;
+  // Initializes the thread-local generator
+  benchmark::DoNotOptimize(HexId::Generate(HexId::kSpanIdSize));
+
+  const auto allocations_before = utils::impl::GetThreadAllocationsCount();
+  for (auto _ : state) {
+    auto trace_id = HexId::Generate(HexId::kTraceIdSize);
+    auto span_id = HexId::Generate(HexId::kSpanIdSize);
+    // The parent id of a child span and the trace id inherited by it
+    auto parent_id = span_id;
+    auto child_trace_id = trace_id;
+    benchmark::DoNotOptimize(child_trace_id.GetView());
+    benchmark::DoNotOptimize(parent_id.GetView());
+  }
+  if (utils::impl::GetThreadAllocationsCount() != allocations_before) {
+    state.SkipWithError("Span ids allocate");
+  }
+}
+BENCHMARK(tracing_generate_ids);
+
+tracing::Span GetSpanWithOpentracingHttpTags(tracing::TracerPtr tracer) {
+  auto span = tracer->CreateSpanWithoutParent("name");
+  span.AddTag("meta_code", 200);
+  span.AddTag("error", false);
+  span.AddTag("http.url", "http://example.com/example");
+  return span;
+}
+
+void tracing_opentracing_ctr(benchmark::State& state) {
+  logging::LoggerPtr logger = logging::MakeNullLogger("opentracing");
+  engine::RunStandalone([&] {
+    auto tracer = tracing::MakeNoopTracer("test_service");
+    tracing::SetOpentracingLogger(logger);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(GetSpanWithOpentracingHttpTags(tracer));
+    }
+    tracing::SetOpentracingLogger({});
+  });
+}
+BENCHMARK(tracing_opentracing_ctr);
+
+}  // namespace
+
+USERVER_NAMESPACE_END
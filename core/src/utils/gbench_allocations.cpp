@@ -0,0 +1,71 @@
+#include <utils/gbench_allocations.hpp>
+
+#include <cstdlib>
+#include <new>
+
+// Replaces the global operators new and delete of the allocations benchmarks
+// binary, see ALLOCATIONS_BENCH_SOURCES in CMakeLists.txt. The default nothrow
+// overloads call the replaced ones.
+
+namespace {
+
+thread_local std::size_t allocations_count = 0;
+
+void* Allocate(std::size_t size) {
+  ++allocations_count;
+  if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc{};
+}
+
+void* Allocate(std::size_t size, std::align_val_t alignment) {
+  ++allocations_count;
+  const auto align = static_cast<std::size_t>(alignment);
+  // aligned_alloc requires the size to be a multiple of the alignment
+  const auto aligned_size = ((size ? size : 1) + align - 1) & ~(align - 1);
+  if (void* ptr = std::aligned_alloc(align, aligned_size)) return ptr;
+  throw std::bad_alloc{};
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) { return Allocate(size); }
+
+void* operator new[](std::size_t size) { return Allocate(size); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return Allocate(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return Allocate(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+std::size_t GetThreadAllocationsCount() noexcept { return allocations_count; }
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
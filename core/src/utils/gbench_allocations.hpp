@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+/// @brief Amount of the global operator new calls made by the current thread.
+///
+/// Only available in the allocations benchmarks binary, where the global
+/// operator new is replaced with a counting one. Benchmarks opt into it by
+/// the `_allocations_benchmark.cpp` file name suffix.
+std::size_t GetThreadAllocationsCount() noexcept;
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
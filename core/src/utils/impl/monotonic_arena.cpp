@@ -0,0 +1,64 @@
+#include <userver/utils/impl/monotonic_arena.hpp>
+
+#include <algorithm>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+namespace {
+
+constexpr std::size_t kMinBlockSize = 4096;
+constexpr std::size_t kMaxBlockSize = 64 * 1024;
+
+}  // namespace
+
+MonotonicArena::MonotonicArena(void* initial_buffer, std::size_t size) noexcept
+    : current_(static_cast<char*>(initial_buffer)),
+      end_(current_ + size),
+      next_block_size_(std::max(kMinBlockSize, size * 2)) {}
+
+MonotonicArena::~MonotonicArena() {
+  while (blocks_) {
+    auto* next = blocks_->next;
+    ::operator delete(blocks_);
+    blocks_ = next;
+  }
+}
+
+void* MonotonicArena::AllocateSlow(std::size_t size, std::size_t alignment) {
+  UASSERT(alignment && (alignment & (alignment - 1)) == 0);
+
+  // Huge allocations get a dedicated block, the current block is kept
+  const auto required = sizeof(BlockHeader) + alignment + size;
+  const auto block_size =
+      std::max({required, next_block_size_, kMinBlockSize});
+
+  auto* block = static_cast<BlockHeader*>(::operator new(block_size));
+  block->next = blocks_;
+  blocks_ = block;
+  ++blocks_count_;
+
+  auto* block_begin = reinterpret_cast<char*>(block + 1);
+  auto* block_end = reinterpret_cast<char*>(block) + block_size;
+  if (required > next_block_size_ && current_) {
+    const auto aligned =
+        (reinterpret_cast<std::uintptr_t>(block_begin) + alignment - 1) &
+        ~(alignment - 1);
+    return reinterpret_cast<void*>(aligned);
+  }
+
+  current_ = block_begin;
+  end_ = block_end;
+  next_block_size_ = std::min(block_size * 2, kMaxBlockSize);
+
+  auto* result = Allocate(size, alignment);
+  UASSERT(result);
+  return result;
+}
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,85 @@
+#include <userver/utils/impl/monotonic_arena.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+bool IsAligned(const void* ptr, std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+}  // namespace
+
+TEST(MonotonicArena, InitialBuffer) {
+  alignas(std::max_align_t) std::byte buffer[256];
+  utils::impl::MonotonicArena arena{buffer, sizeof(buffer)};
+
+  auto* first = static_cast<std::byte*>(arena.Allocate(1, 1));
+  auto* second = static_cast<std::byte*>(arena.Allocate(8, 8));
+  EXPECT_EQ(first, buffer);
+  EXPECT_EQ(second, buffer + 8);
+  EXPECT_EQ(arena.GetBlocksCount(), 0);
+
+  auto* third = arena.Allocate(256, 16);
+  EXPECT_TRUE(IsAligned(third, 16));
+  EXPECT_EQ(arena.GetBlocksCount(), 1);
+}
+
+TEST(MonotonicArena, Blocks) {
+  utils::impl::MonotonicArena arena;
+  for (std::size_t i = 0; i < 10000; ++i) {
+    auto* ptr = arena.Allocate(i % 100 + 1, 8);
+    EXPECT_TRUE(IsAligned(ptr, 8));
+  }
+  // blocks grow geometrically
+  EXPECT_LT(arena.GetBlocksCount(), 20);
+
+  auto* small_before = static_cast<char*>(arena.Allocate(1, 1));
+  auto* huge = arena.Allocate(1 << 20, 64);
+  EXPECT_TRUE(IsAligned(huge, 64));
+  // the huge allocation does not waste the current block
+  auto* small_after = static_cast<char*>(arena.Allocate(1, 1));
+  EXPECT_EQ(small_after, small_before + 1);
+}
+
+TEST(MonotonicArena, Containers) {
+  using Allocator =
+      utils::impl::ArenaAllocator<std::pair<const std::string, int>>;
+  using Map = std::unordered_map<std::string, int, std::hash<std::string>,
+                                 std::equal_to<std::string>, Allocator>;
+
+  std::optional<Map> copy;
+  Map moved;
+  {
+    utils::impl::MonotonicArena arena;
+    Map map{Allocator{arena}};
+    for (int i = 0; i < 1000; ++i) map.emplace(std::to_string(i), i);
+    EXPECT_NE(arena.GetBlocksCount(), 0);
+
+    // copies use the heap and outlive the arena
+    copy.emplace(map);
+    EXPECT_EQ(copy->get_allocator(), Allocator{});
+
+    // move assignment keeps the heap allocator of the target
+    moved = std::move(map);
+    EXPECT_EQ(moved.get_allocator(), Allocator{});
+  }
+  ASSERT_EQ(copy->size(), 1000);
+  EXPECT_EQ(copy->at("42"), 42);
+  ASSERT_EQ(moved.size(), 1000);
+  EXPECT_EQ(moved.at("42"), 42);
+
+  std::vector<int, utils::impl::ArenaAllocator<int>> heap_vector(100, 1);
+  heap_vector.resize(1000, 2);
+  EXPECT_EQ(heap_vector.back(), 2);
+}
+
+USERVER_NAMESPACE_END
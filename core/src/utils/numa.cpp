@@ -0,0 +1,243 @@
+#include <utils/numa.hpp>
+
+#include <sched.h>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <map>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <boost/filesystem/operations.hpp>
+#include <fmt/format.h>
+
+#include <userver/fs/blocking/read.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/scope_guard.hpp>
+#include <userver/utils/text.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::numa {
+
+namespace {
+
+constexpr std::string_view kNodesPath = "/sys/devices/system/node";
+constexpr std::string_view kNodePrefix = "node";
+
+thread_local int current_thread_node = kUnknownNode;
+
+int ParseCpu(std::string_view cpu_list, std::string_view cpu) {
+  int result = 0;
+  const auto* const end = cpu.data() + cpu.size();
+  const auto [ptr, ec] = std::from_chars(cpu.data(), end, result);
+  if (ec != std::errc{} || ptr != end || result < 0) {
+    throw std::runtime_error(
+        fmt::format("Invalid CPU list '{}': bad CPU '{}'", cpu_list, cpu));
+  }
+  return result;
+}
+
+bool IsNodeId(std::string_view id) {
+  return !id.empty() && std::all_of(id.begin(), id.end(), [](char c) {
+    return std::isdigit(static_cast<unsigned char>(c));
+  });
+}
+
+struct Topology {
+  std::vector<std::vector<int>> node_cpus;
+  std::vector<int> cpu_nodes;
+};
+
+std::vector<int> GetOnlineCpus() {
+  const auto count = std::max(std::thread::hardware_concurrency(), 1U);
+  std::vector<int> cpus(count);
+  for (unsigned i = 0; i < count; ++i) cpus[i] = static_cast<int>(i);
+  return cpus;
+}
+
+Topology ReadTopology() {
+  std::map<int, std::vector<int>> nodes;
+  try {
+    if (fs::blocking::FileExists(std::string{kNodesPath})) {
+      for (const auto& entry :
+           boost::filesystem::directory_iterator(std::string{kNodesPath})) {
+        const auto name = entry.path().filename().string();
+        if (!utils::text::StartsWith(name, kNodePrefix)) continue;
+        const auto id = std::string_view{name}.substr(kNodePrefix.size());
+        if (!IsNodeId(id)) continue;
+
+        const auto cpu_list = utils::text::Trim(fs::blocking::ReadFileContents(
+            (entry.path() / "cpulist").string()));
+        auto cpus = ParseCpuList(cpu_list);
+        if (!cpus.empty()) nodes.emplace(ParseCpu(name, id), std::move(cpus));
+      }
+    }
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Failed to read NUMA topology, assuming a single node: "
+                  << ex;
+    nodes.clear();
+  }
+
+  Topology topology;
+  if (nodes.empty()) {
+    topology.node_cpus.push_back(GetOnlineCpus());
+  } else {
+    // Node ids are dense on all the sane systems, holes stay empty
+    topology.node_cpus.resize(nodes.rbegin()->first + 1);
+    for (auto& [node, cpus] : nodes) topology.node_cpus[node] = std::move(cpus);
+  }
+
+  for (std::size_t node = 0; node < topology.node_cpus.size(); ++node) {
+    for (const auto cpu : topology.node_cpus[node]) {
+      if (topology.cpu_nodes.size() <= static_cast<std::size_t>(cpu)) {
+        topology.cpu_nodes.resize(cpu + 1, kUnknownNode);
+      }
+      topology.cpu_nodes[cpu] = static_cast<int>(node);
+    }
+  }
+  return topology;
+}
+
+const Topology& GetTopology() {
+  static const Topology topology = ReadTopology();
+  return topology;
+}
+
+}  // namespace
+
+std::vector<int> ParseCpuList(std::string_view cpu_list) {
+  std::vector<int> result;
+  std::string_view rest = cpu_list;
+  while (!rest.empty()) {
+    const auto comma = rest.find(',');
+    const auto range = rest.substr(0, comma);
+    rest = (comma == std::string_view::npos) ? std::string_view{}
+                                             : rest.substr(comma + 1);
+    if (range.empty()) {
+      throw std::runtime_error(
+          fmt::format("Invalid CPU list '{}': empty range", cpu_list));
+    }
+
+    const auto dash = range.find('-');
+    const auto first = ParseCpu(cpu_list, range.substr(0, dash));
+    const auto last = (dash == std::string_view::npos)
+                          ? first
+                          : ParseCpu(cpu_list, range.substr(dash + 1));
+    if (last < first) {
+      throw std::runtime_error(fmt::format(
+          "Invalid CPU list '{}': bad range '{}'", cpu_list, range));
+    }
+    for (int cpu = first; cpu <= last; ++cpu) result.push_back(cpu);
+  }
+
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+std::size_t GetNodeCount() { return GetTopology().node_cpus.size(); }
+
+const std::vector<int>& GetNodeCpus(int node) {
+  const auto& node_cpus = GetTopology().node_cpus;
+  if (node < 0 || static_cast<std::size_t>(node) >= node_cpus.size() ||
+      node_cpus[node].empty()) {
+    throw std::runtime_error(fmt::format("Unknown NUMA node {}", node));
+  }
+  return node_cpus[node];
+}
+
+int GetCpuNode(int cpu) {
+  const auto& cpu_nodes = GetTopology().cpu_nodes;
+  if (cpu < 0 || static_cast<std::size_t>(cpu) >= cpu_nodes.size()) {
+    return kUnknownNode;
+  }
+  return cpu_nodes[cpu];
+}
+
+int GetCpusNode(const std::vector<int>& cpus) {
+  if (cpus.empty()) return kUnknownNode;
+  const auto node = GetCpuNode(cpus.front());
+  const bool is_single_node =
+      std::all_of(cpus.begin(), cpus.end(),
+                  [node](int cpu) { return GetCpuNode(cpu) == node; });
+  return is_single_node ? node : kUnknownNode;
+}
+
+int GetCurrentNode() {
+  if (current_thread_node != kUnknownNode) return current_thread_node;
+#ifdef __linux__
+  const auto cpu = ::sched_getcpu();
+  if (cpu >= 0) return GetCpuNode(cpu);
+#endif
+  return kUnknownNode;
+}
+
+void SetCurrentThreadAffinity(const std::vector<int>& cpus) {
+  if (cpus.empty()) return;
+
+#ifdef __linux__
+  const auto [min_cpu, max_cpu] = std::minmax_element(cpus.begin(), cpus.end());
+  if (*min_cpu < 0) {
+    throw std::runtime_error(fmt::format("Invalid CPU {}", *min_cpu));
+  }
+
+  // Static cpu_set_t holds only CPU_SETSIZE CPUs
+  const auto cpu_count = *max_cpu + 1;
+  cpu_set_t* set = CPU_ALLOC(cpu_count);
+  if (!set) throw std::bad_alloc();
+  utils::ScopeGuard set_deleter([set] { CPU_FREE(set); });
+
+  const auto set_size = CPU_ALLOC_SIZE(cpu_count);
+  CPU_ZERO_S(set_size, set);
+  for (const auto cpu : cpus) CPU_SET_S(cpu, set_size, set);
+  utils::CheckSyscall(::sched_setaffinity(0, set_size, set),
+                      "setting thread CPU affinity");
+  current_thread_node = GetCpusNode(cpus);
+#else
+  LOG_WARNING() << "CPU affinity is not supported on this platform, ignoring";
+#endif
+}
+
+std::vector<int> AffinityConfig::GetThreadCpus(std::size_t thread_index) const {
+  if (IsEmpty()) return {};
+  if (nodes.empty()) return cpus;
+
+  const auto node = nodes[thread_index % nodes.size()];
+  auto result = GetNodeCpus(node);
+  if (!cpus.empty()) {
+    result.erase(std::remove_if(result.begin(), result.end(),
+                                [this](int cpu) {
+                                  return !std::binary_search(
+                                      cpus.begin(), cpus.end(), cpu);
+                                }),
+                 result.end());
+  }
+  if (result.empty()) {
+    throw std::runtime_error(fmt::format(
+        "None of the allowed CPUs belong to the NUMA node {}", node));
+  }
+  return result;
+}
+
+AffinityConfig Parse(const yaml_config::YamlConfig& value,
+                     formats::parse::To<AffinityConfig>) {
+  AffinityConfig config;
+  const auto cpu_list = value["cpu-list"].As<std::string>({});
+  if (!cpu_list.empty()) config.cpus = ParseCpuList(cpu_list);
+  config.nodes = value["numa-nodes"].As<std::vector<int>>({});
+  for (const auto node : config.nodes) {
+    // Fail early on the misconfiguration
+    [[maybe_unused]] const auto& node_cpus = GetNodeCpus(node);
+  }
+  return config;
+}
+
+}  // namespace utils::numa
+
+USERVER_NAMESPACE_END
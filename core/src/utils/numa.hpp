@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include <userver/formats/parse/to.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::numa {
+
+inline constexpr int kUnknownNode = -1;
+
+/// Parses the kernel cpu list format, e.g. "0-3,8,10-11"
+std::vector<int> ParseCpuList(std::string_view cpu_list);
+
+/// Number of NUMA nodes, 1 if the topology is unknown
+std::size_t GetNodeCount();
+
+/// CPUs of the NUMA node, throws std::runtime_error on unknown node
+const std::vector<int>& GetNodeCpus(int node);
+
+/// NUMA node of the CPU or kUnknownNode
+int GetCpuNode(int cpu);
+
+/// NUMA node of all the CPUs or kUnknownNode if the CPUs belong to several
+/// nodes
+int GetCpusNode(const std::vector<int>& cpus);
+
+/// NUMA node the current thread is pinned to. For the threads that are not
+/// pinned to a single node returns the node of the CPU the thread is running
+/// on or kUnknownNode.
+int GetCurrentNode();
+
+/// Pins the current thread to the CPUs, the CPUs of a single NUMA node make
+/// the node a 'home' node of the thread for the GetCurrentNode()
+void SetCurrentThreadAffinity(const std::vector<int>& cpus);
+
+/// CPU and NUMA node placement of a thread pool
+struct AffinityConfig {
+  /// Allowed CPUs, all the CPUs if empty
+  std::vector<int> cpus;
+  /// NUMA nodes to spread the threads over, all the nodes if empty
+  std::vector<int> nodes;
+
+  bool IsEmpty() const { return cpus.empty() && nodes.empty(); }
+
+  /// Returns the CPUs for the thread of the pool, empty if the threads are
+  /// not pinned. Threads are distributed over the NUMA nodes round-robin.
+  std::vector<int> GetThreadCpus(std::size_t thread_index) const;
+};
+
+/// Parses the `cpu-list` and `numa-nodes` options of the config
+AffinityConfig Parse(const yaml_config::YamlConfig& value,
+                     formats::parse::To<AffinityConfig>);
+
+}  // namespace utils::numa
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include <userver/formats/yaml/serialize.hpp>
+#include <userver/utest/assert_macros.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+#include <utils/numa.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using utils::numa::ParseCpuList;
+
+TEST(Numa, ParseCpuList) {
+  EXPECT_EQ(ParseCpuList(""), std::vector<int>{});
+  EXPECT_EQ(ParseCpuList("3"), std::vector<int>{3});
+  EXPECT_EQ(ParseCpuList("0-3"), (std::vector<int>{0, 1, 2, 3}));
+  EXPECT_EQ(ParseCpuList("8,0-2,10-11"),
+            (std::vector<int>{0, 1, 2, 8, 10, 11}));
+  EXPECT_EQ(ParseCpuList("1,1,0-1"), (std::vector<int>{0, 1}));
+}
+
+TEST(Numa, ParseCpuListInvalid) {
+  UEXPECT_THROW(ParseCpuList(","), std::runtime_error);
+  UEXPECT_THROW(ParseCpuList("1,"), std::runtime_error);
+  UEXPECT_THROW(ParseCpuList("a"), std::runtime_error);
+  UEXPECT_THROW(ParseCpuList("3-1"), std::runtime_error);
+  UEXPECT_THROW(ParseCpuList("-1"), std::runtime_error);
+  UEXPECT_THROW(ParseCpuList("1-2-3"), std::runtime_error);
+}
+
+TEST(Numa, Topology) {
+  ASSERT_GE(utils::numa::GetNodeCount(), 1);
+  for (const auto cpu : utils::numa::GetNodeCpus(0)) {
+    EXPECT_EQ(utils::numa::GetCpuNode(cpu), 0);
+  }
+  EXPECT_EQ(utils::numa::GetCpuNode(-1), utils::numa::kUnknownNode);
+  UEXPECT_THROW(utils::numa::GetNodeCpus(-1), std::runtime_error);
+}
+
+TEST(Numa, SetAffinityInvalidCpu) {
+  UEXPECT_THROW(utils::numa::SetCurrentThreadAffinity({-1}),
+                std::runtime_error);
+#ifdef __linux__
+  // Out of the static cpu_set_t range, none of the CPUs exist
+  UEXPECT_THROW(utils::numa::SetCurrentThreadAffinity({1 << 16}),
+                std::exception);
+#endif
+}
+
+TEST(Numa, AffinityConfig) {
+  const yaml_config::YamlConfig empty{formats::yaml::FromString("{}"), {}};
+  const auto empty_config = empty.As<utils::numa::AffinityConfig>();
+  EXPECT_TRUE(empty_config.IsEmpty());
+  EXPECT_TRUE(empty_config.GetThreadCpus(0).empty());
+
+  const yaml_config::YamlConfig cpus{
+      formats::yaml::FromString("cpu-list: 0,2-3"), {}};
+  const auto cpus_config = cpus.As<utils::numa::AffinityConfig>();
+  EXPECT_EQ(cpus_config.GetThreadCpus(0), (std::vector<int>{0, 2, 3}));
+  EXPECT_EQ(cpus_config.GetThreadCpus(5), (std::vector<int>{0, 2, 3}));
+
+  const yaml_config::YamlConfig nodes{
+      formats::yaml::FromString("numa-nodes: [0]"), {}};
+  const auto nodes_config = nodes.As<utils::numa::AffinityConfig>();
+  EXPECT_EQ(nodes_config.GetThreadCpus(1), utils::numa::GetNodeCpus(0));
+}
+
+USERVER_NAMESPACE_END
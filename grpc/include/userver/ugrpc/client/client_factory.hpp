@@ -4,6 +4,8 @@
 /// @brief @copybrief ugrpc::client::ClientFactory
 
 #include <cstddef>
+#include <memory>
+#include <vector>
 
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/security/credentials.h>
@@ -15,6 +17,9 @@
 #include <userver/yaml_config/fwd.hpp>
 
 #include <userver/ugrpc/client/impl/channel_cache.hpp>
+#include <userver/ugrpc/client/impl/completion_queues.hpp>
+#include <userver/ugrpc/client/queue_distribution.hpp>
+#include <userver/ugrpc/client/queue_holder.hpp>
 #include <userver/ugrpc/impl/statistics_storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -38,6 +43,13 @@ struct ClientFactoryConfig {
   /// Number of underlying channels that will be created for every client
   /// in this factory.
   std::size_t channel_count{1};
+
+  /// Number of completion queues created by the factory, each one is served
+  /// by its own thread. Only used if the factory is not given the queues.
+  std::size_t completion_queue_count{1};
+
+  /// How the RPCs are spread over the completion queues
+  QueueDistribution queue_distribution{QueueDistribution::kRoundRobin};
 };
 
 ClientFactoryConfig Parse(const yaml_config::YamlConfig& value,
@@ -53,6 +65,18 @@ class ClientFactory final {
                 grpc::CompletionQueue& queue,
                 utils::statistics::Storage& statistics_storage);
 
+  /// Spreads the RPCs over the `queues` according to
+  /// ClientFactoryConfig::queue_distribution
+  ClientFactory(ClientFactoryConfig&& config,
+                engine::TaskProcessor& channel_task_processor,
+                std::vector<grpc::CompletionQueue*> queues,
+                utils::statistics::Storage& statistics_storage);
+
+  /// Creates ClientFactoryConfig::completion_queue_count own completion queues
+  ClientFactory(ClientFactoryConfig&& config,
+                engine::TaskProcessor& channel_task_processor,
+                utils::statistics::Storage& statistics_storage);
+
   template <typename Client>
   Client MakeClient(const std::string& endpoint);
 
@@ -60,16 +84,17 @@ class ClientFactory final {
   impl::ChannelCache::Token GetChannel(const std::string& endpoint);
 
   engine::TaskProcessor& channel_task_processor_;
-  grpc::CompletionQueue& queue_;
-  impl::ChannelCache channel_cache_;
   ugrpc::impl::StatisticsStorage client_statistics_storage_;
+  std::vector<std::unique_ptr<QueueHolder>> own_queues_;
+  impl::CompletionQueues queues_;
+  impl::ChannelCache channel_cache_;
 };
 
 template <typename Client>
 Client ClientFactory::MakeClient(const std::string& endpoint) {
   auto& statistics =
       client_statistics_storage_.GetServiceStatistics(Client::GetMetadata());
-  return Client(GetChannel(endpoint), queue_, statistics);
+  return Client(GetChannel(endpoint), queues_, statistics);
 }
 
 }  // namespace ugrpc::client
@@ -34,6 +34,13 @@ namespace ugrpc::client {
 /// We allow setting default service_config: pass desired JSON literal
 /// to `default-service-config` parameter
 ///
+/// ## Completion queues
+/// If ugrpc::server::ServerComponent exists, the clients use the completion
+/// queues of the server. Otherwise the factory creates
+/// `completion-queue-count` queues, each one is served by its own thread.
+/// With `queue-distribution: round-robin` each RPC uses the next queue,
+/// with `by-channel` all the RPCs of a channel use the same queue.
+///
 /// ## Static options:
 /// The default component name for static config is `"grpc-client-factory"`.
 ///
@@ -45,6 +52,8 @@ namespace ugrpc::client {
 /// auth-type | authentication method, see above | -
 /// default-service-config | default service config, see above | -
 /// channel-count | Number of underlying grpc::Channel objects | 1
+/// completion-queue-count | Number of completion queues, see above | 1
+/// queue-distribution | `round-robin` or `by-channel`, see above | round-robin
 ///
 /// @see https://grpc.github.io/grpc/core/group__grpc__arg__keys.html
 class ClientFactoryComponent final : public components::LoggableComponentBase {
@@ -59,7 +68,6 @@ class ClientFactoryComponent final : public components::LoggableComponentBase {
   static yaml_config::Schema GetStaticConfigSchema();
 
  private:
-  std::optional<QueueHolder> queue_;
   std::optional<ClientFactory> factory_;
 };
 
@@ -8,6 +8,7 @@
 #include <grpcpp/completion_queue.h>
 
 #include <userver/ugrpc/client/impl/channel_cache.hpp>
+#include <userver/ugrpc/client/impl/completion_queues.hpp>
 #include <userver/ugrpc/impl/statistics.hpp>
 #include <userver/utils/fixed_array.hpp>
 #include <userver/utils/rand.hpp>
@@ -26,11 +27,11 @@ class ClientData final {
 
   template <typename Service>
   ClientData(impl::ChannelCache::Token channel_token,
-             grpc::CompletionQueue& queue,
+             CompletionQueues& queues,
              ugrpc::impl::ServiceStatistics& statistics,
              std::in_place_type_t<Service>)
       : channel_token_(std::move(channel_token)),
-        queue_(&queue),
+        queues_(&queues),
         statistics_(&statistics) {
     const std::size_t channel_count = channel_token_.GetChannelCount();
     stubs_ = utils::GenerateFixedArray(channel_count, [&](std::size_t index) {
@@ -52,7 +53,15 @@ class ClientData final {
         stubs_[utils::RandRange(stubs_.size())].get());
   }
 
-  grpc::CompletionQueue& GetQueue() { return *queue_; }
+  /// Picks a stub and the completion queue for an RPC over its channel
+  template <typename Service>
+  std::pair<Stub<Service>&, grpc::CompletionQueue&> NextStubAndQueue() {
+    const auto index = utils::RandRange(stubs_.size());
+    return {*static_cast<Stub<Service>*>(stubs_[index].get()),
+            queues_->NextQueue(index)};
+  }
+
+  grpc::CompletionQueue& GetQueue() { return queues_->GetQueue(); }
 
   ugrpc::impl::MethodStatistics& GetStatistics(std::size_t method_id) {
     return statistics_->GetMethodStatistics(method_id);
@@ -71,7 +80,7 @@ class ClientData final {
 
   impl::ChannelCache::Token channel_token_;
   utils::FixedArray<StubPtr> stubs_;
-  grpc::CompletionQueue* queue_;
+  CompletionQueues* queues_;
   ugrpc::impl::ServiceStatistics* statistics_;
 };
 
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include <grpcpp/completion_queue.h>
+
+#include <userver/ugrpc/client/queue_distribution.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client::impl {
+
+/// The completion queues shared by the clients of a ClientFactory
+class CompletionQueues final {
+ public:
+  CompletionQueues(std::vector<grpc::CompletionQueue*>&& queues,
+                   QueueDistribution distribution);
+
+  CompletionQueues(CompletionQueues&&) = delete;
+  CompletionQueues& operator=(CompletionQueues&&) = delete;
+
+  /// The first queue, used for the operations that are not RPCs
+  grpc::CompletionQueue& GetQueue() const noexcept { return *queues_.front(); }
+
+  /// The queue for an RPC over the channel with the index
+  grpc::CompletionQueue& NextQueue(std::size_t channel_index) noexcept {
+    if (queues_.size() == 1) return *queues_.front();
+    const auto index = distribution_ == QueueDistribution::kByChannel
+                           ? channel_index
+                           : next_.fetch_add(1, std::memory_order_relaxed);
+    return *queues_[index % queues_.size()];
+  }
+
+ private:
+  const std::vector<grpc::CompletionQueue*> queues_;
+  const QueueDistribution distribution_;
+  std::atomic<std::size_t> next_{0};
+};
+
+}  // namespace ugrpc::client::impl
+
+USERVER_NAMESPACE_END
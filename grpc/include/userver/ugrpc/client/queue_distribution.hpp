@@ -0,0 +1,27 @@
+#pragma once
+
+/// @file userver/ugrpc/client/queue_distribution.hpp
+/// @brief @copybrief ugrpc::client::QueueDistribution
+
+#include <userver/formats/parse/to.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client {
+
+/// @brief How the RPCs of the clients are spread over the completion queues
+enum class QueueDistribution {
+  /// Each RPC uses the next queue, the load is even regardless of the channels
+  kRoundRobin,
+  /// All the RPCs of a channel use the same queue, the events of a connection
+  /// are processed by a single thread
+  kByChannel,
+};
+
+QueueDistribution Parse(const yaml_config::YamlConfig& value,
+                        formats::parse::To<QueueDistribution>);
+
+}  // namespace ugrpc::client
+
+USERVER_NAMESPACE_END
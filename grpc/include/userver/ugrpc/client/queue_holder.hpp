@@ -9,6 +9,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace ugrpc::impl {
+class QueueStatistics;
+}  // namespace ugrpc::impl
+
 namespace ugrpc::client {
 
 /// @brief Manages a gRPC completion queue, usable only in clients
@@ -16,6 +20,9 @@ class QueueHolder final {
  public:
   QueueHolder();
 
+  /// Accounts the completion queue events into the statistics
+  explicit QueueHolder(ugrpc::impl::QueueStatistics& statistics);
+
   QueueHolder(QueueHolder&&) = delete;
   QueueHolder& operator=(QueueHolder&&) = delete;
   ~QueueHolder();
@@ -24,7 +31,7 @@ class QueueHolder final {
 
  private:
   struct Impl;
-  utils::FastPimpl<Impl, 136, 8> impl_;
+  utils::FastPimpl<Impl, 144, 8> impl_;
 };
 
 }  // namespace ugrpc::client
@@ -8,13 +8,19 @@ USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::impl {
 
+class QueueStatistics;
+
 class QueueRunner final {
  public:
-  explicit QueueRunner(grpc::CompletionQueue& queue);
+  /// @param statistics if not null, the runner drains all the ready events at
+  /// each wakeup and accounts the batches into the statistics
+  explicit QueueRunner(grpc::CompletionQueue& queue,
+                       QueueStatistics* statistics = nullptr);
   ~QueueRunner();
 
  private:
   grpc::CompletionQueue& queue_;
+  QueueStatistics* const statistics_;
   engine::SingleUseEvent completion_;
 };
 
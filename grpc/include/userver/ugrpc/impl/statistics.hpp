@@ -58,6 +58,25 @@ class MethodStatistics final {
   Counter internal_errors_{0};
 };
 
+/// Statistics of a completion queue and its runner thread
+class QueueStatistics final {
+ public:
+  /// Accounts the events that were ready at a single wakeup of the runner
+  /// and the time it took to dispatch them
+  void AccountBatch(std::size_t events,
+                    std::chrono::microseconds timing) noexcept;
+
+  formats::json::Value ExtendStatistics() const;
+
+ private:
+  using Percentile =
+      utils::statistics::Percentile<2000, std::uint32_t, 256, 100>;
+
+  std::atomic<std::uint64_t> events_{0};
+  utils::statistics::RecentPeriod<Percentile, Percentile> batch_sizes_;
+  utils::statistics::RecentPeriod<Percentile, Percentile> timings_;
+};
+
 class ServiceStatistics final {
  public:
   explicit ServiceStatistics(const StaticServiceMetadata& metadata);
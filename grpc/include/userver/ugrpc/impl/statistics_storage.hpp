@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string_view>
 #include <unordered_map>
 
@@ -28,6 +29,10 @@ class StatisticsStorage final {
   ugrpc::impl::ServiceStatistics& GetServiceStatistics(
       const ugrpc::impl::StaticServiceMetadata& metadata);
 
+  /// Statistics of the completion queue with the index, the returned
+  /// reference stays valid while the storage is alive
+  ugrpc::impl::QueueStatistics& GetQueueStatistics(std::size_t queue_index);
+
  private:
   // Pointer to service name from its metadata is used as a unique service ID
   using ServiceId = const char*;
@@ -36,6 +41,8 @@ class StatisticsStorage final {
 
   std::unordered_map<ServiceId, ugrpc::impl::ServiceStatistics>
       service_statistics_;
+  std::unordered_map<std::size_t, ugrpc::impl::QueueStatistics>
+      queue_statistics_;
   engine::SharedMutex mutex_;
 
   utils::statistics::Entry statistics_holder_;
@@ -71,6 +71,7 @@ struct MethodData final {
   const std::size_t method_id{};
   typename CallTraits::ServiceBase& service;
   const typename CallTraits::ServiceMethod service_method;
+  grpc::ServerCompletionQueue& queue;
 
   std::string_view call_name{
       service_data.metadata.method_full_names[method_id]};
@@ -88,7 +89,7 @@ class CallData final {
             method_data.service_data.metadata.method_count);
 
     // the request for an incoming RPC must be performed synchronously
-    auto& queue = method_data_.service_data.settings.queue;
+    auto& queue = method_data_.queue;
     method_data_.service_data.async_service.template Prepare<CallTraits>(
         method_data_.method_id, context_, initial_request_, raw_responder_,
         queue, queue, prepare_.GetTag());
@@ -168,10 +169,16 @@ class ServiceWorkerImpl final : public ServiceWorker {
                     Service& service, ServiceMethods... service_methods)
       : service_data_(settings, metadata),
         start_{[this, &service, service_methods...] {
-          std::size_t method_id = 0;
-          (CallData<GrpcppService, CallTraits<ServiceMethods>>::ListenAsync(
-               {service_data_, method_id++, service, service_methods}),
-           ...);
+          // grpc-core matches an incoming call with a pending request of one
+          // of the queues, starting from the queue assigned to the
+          // connection, so listening on every queue spreads the connections
+          for (auto* queue : service_data_.settings.queues) {
+            std::size_t method_id = 0;
+            (CallData<GrpcppService, CallTraits<ServiceMethods>>::ListenAsync(
+                 {service_data_, method_id++, service, service_methods,
+                  *queue}),
+             ...);
+          }
         }} {}
 
   ~ServiceWorkerImpl() override {
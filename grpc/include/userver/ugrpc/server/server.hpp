@@ -3,8 +3,10 @@
 /// @file userver/ugrpc/server/server.hpp
 /// @brief @copybrief ugrpc::server::Server
 
+#include <cstddef>
 #include <functional>
 #include <unordered_map>
+#include <vector>
 
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/server_builder.h>
@@ -39,6 +41,10 @@ struct ServerConfig final {
 
   /// Serve a web page with runtime info about gRPC connections
   bool enable_channelz{false};
+
+  /// The number of completion queues, each one is served by its own thread.
+  /// Incoming connections are spread over the queues.
+  std::size_t completion_queue_count{1};
 };
 
 ServerConfig Parse(const yaml_config::YamlConfig& value,
@@ -75,6 +81,10 @@ class Server final {
   /// usually no more than one instance per program.
   grpc::CompletionQueue& GetCompletionQueue() noexcept;
 
+  /// @returns all the completion queues of the server, the first one is
+  /// returned by GetCompletionQueue
+  std::vector<grpc::CompletionQueue*> GetCompletionQueues();
+
   /// @brief Start accepting requests
   /// @note Must be called at most once after all the services are registered
   void Start();
@@ -41,4 +41,36 @@ UTEST(GrpcClient, ChannelsCount) {
   ASSERT_EQ(kChannelsCount, data.GetChannelToken().GetChannelCount());
 }
 
+UTEST(GrpcClient, OwnCompletionQueues) {
+  constexpr int kQueuesCount = 3;
+  formats::yaml::ValueBuilder builder(formats::common::Type::kObject);
+  builder["channel-count"] = kQueuesCount;
+  builder["completion-queue-count"] = kQueuesCount;
+  builder["queue-distribution"] = "by-channel";
+
+  const auto yaml_data = builder.ExtractValue();
+  yaml_config::YamlConfig yaml_config(yaml_data, formats::yaml::Value());
+
+  auto config = yaml_config.As<ugrpc::client::ClientFactoryConfig>();
+  EXPECT_EQ(config.completion_queue_count, kQueuesCount);
+  EXPECT_EQ(config.queue_distribution,
+            ugrpc::client::QueueDistribution::kByChannel);
+  utils::statistics::Storage statistics_storage;
+
+  ugrpc::client::ClientFactory client_factory(
+      std::move(config), engine::current_task::GetTaskProcessor(),
+      statistics_storage);
+
+  const auto statistics =
+      statistics_storage.GetAsJson(utils::statistics::StatisticsRequest{""})
+          .ExtractValue();
+  const auto by_queue = statistics["grpc"]["client"]["by-queue"];
+  EXPECT_EQ(by_queue["$meta"]["solomon_children_labels"].As<std::string>(),
+            "grpc_queue");
+  for (int i = 0; i < kQueuesCount; ++i) {
+    EXPECT_EQ(by_queue[std::to_string(i)]["events"].As<int>(), 0)
+        << formats::json::ToString(by_queue);
+  }
+}
+
 USERVER_NAMESPACE_END
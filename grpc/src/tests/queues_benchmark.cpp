@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+#include <userver/ugrpc/client/client_factory.hpp>
+#include <userver/ugrpc/server/server.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kThreads = 4;
+constexpr std::size_t kConcurrentRequests = 64;
+
+class UnitTestServiceEcho final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    sample::ugrpc::GreetingResponse response;
+    response.set_name(std::move(*request.mutable_name()));
+    call.Finish(response);
+  }
+};
+
+}  // namespace
+
+// Unary RPCs over the loopback, the client shares the queues of the server
+void GrpcUnaryRps(benchmark::State& state) {
+  engine::RunStandalone(kThreads, [&] {
+    utils::statistics::Storage statistics_storage;
+    UnitTestServiceEcho service;
+
+    ugrpc::server::ServerConfig server_config;
+    server_config.port = 0;
+    server_config.completion_queue_count = state.range(0);
+    ugrpc::server::Server server(std::move(server_config), statistics_storage);
+    server.AddService(service, engine::current_task::GetTaskProcessor());
+    server.Start();
+
+    {
+      // Clients must be destroyed before the server queues
+      ugrpc::client::ClientFactoryConfig client_config;
+      client_config.channel_count = state.range(0);
+      ugrpc::client::ClientFactory client_factory(
+          std::move(client_config), engine::current_task::GetTaskProcessor(),
+          server.GetCompletionQueues(), statistics_storage);
+      auto client =
+          client_factory.MakeClient<sample::ugrpc::UnitTestServiceClient>(
+              fmt::format("[::1]:{}", server.GetPort()));
+
+      sample::ugrpc::GreetingRequest request;
+      request.set_name("userver");
+
+      std::vector<engine::TaskWithResult<void>> requests;
+      requests.reserve(kConcurrentRequests);
+      for (auto _ : state) {
+        for (std::size_t i = 0; i < kConcurrentRequests; ++i) {
+          requests.push_back(engine::AsyncNoSpan([&client, &request] {
+            benchmark::DoNotOptimize(client.SayHello(request).Finish());
+          }));
+        }
+        for (auto& task : requests) task.Get();
+        requests.clear();
+      }
+      state.SetItemsProcessed(state.iterations() * kConcurrentRequests);
+    }
+
+    server.Stop();
+  });
+}
+// {completion-queue-count}
+BENCHMARK(GrpcUnaryRps)->Arg(1)->Arg(2)->Arg(kThreads)->UseRealTime();
+
+USERVER_NAMESPACE_END
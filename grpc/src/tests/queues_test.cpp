@@ -0,0 +1,81 @@
+#include <userver/utest/utest.hpp>
+
+#include <string>
+#include <vector>
+
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/utils/async.hpp>
+
+#include <tests/service_fixture_test.hpp>
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kQueuesCount = 3;
+
+class UnitTestServiceEcho final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    sample::ugrpc::GreetingResponse response;
+    response.set_name("Hello " + request.name());
+    call.Finish(response);
+  }
+};
+
+ugrpc::server::ServerConfig MakeServerConfig() {
+  ugrpc::server::ServerConfig config;
+  config.port = 0;
+  config.completion_queue_count = kQueuesCount;
+  return config;
+}
+
+class GrpcQueues : public GrpcServiceFixture {
+ protected:
+  GrpcQueues() : GrpcServiceFixture(MakeServerConfig()) {
+    RegisterService(service_);
+    ugrpc::client::ClientFactoryConfig client_factory_config{};
+    client_factory_config.channel_count = kQueuesCount;
+    StartServer(std::move(client_factory_config));
+  }
+
+  ~GrpcQueues() override { StopServer(); }
+
+ private:
+  UnitTestServiceEcho service_;
+};
+
+}  // namespace
+
+UTEST_F_MT(GrpcQueues, SpreadOverQueues, 2) {
+  constexpr int kRequestsPerTask = 20;
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < kQueuesCount; ++i) {
+    tasks.push_back(utils::Async("say-hello", [&client] {
+      for (int request = 0; request < kRequestsPerTask; ++request) {
+        sample::ugrpc::GreetingRequest out;
+        out.set_name("userver");
+        EXPECT_EQ(client.SayHello(out).Finish().name(), "Hello userver");
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  const auto statistics = GetStatistics();
+  const auto by_queue = statistics["grpc"]["server"]["by-queue"];
+  EXPECT_EQ(by_queue["$meta"]["solomon_children_labels"].As<std::string>(),
+            "grpc_queue");
+  for (std::size_t i = 0; i < kQueuesCount; ++i) {
+    // The client RPCs are spread round-robin over the server queues
+    EXPECT_GT(by_queue[std::to_string(i)]["events"].As<int>(), 0)
+        << formats::json::ToString(by_queue);
+  }
+}
+
+USERVER_NAMESPACE_END
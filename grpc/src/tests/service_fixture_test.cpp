@@ -1,5 +1,7 @@
 #include <tests/service_fixture_test.hpp>
 
+#include <utility>
+
 #include <fmt/format.h>
 
 #include <userver/engine/task/task.hpp>
@@ -19,7 +21,11 @@ ugrpc::server::ServerConfig MakeServerConfig() {
 }  // namespace
 
 GrpcServiceFixture::GrpcServiceFixture()
-    : server_(MakeServerConfig(), statistics_storage_) {}
+    : GrpcServiceFixture(MakeServerConfig()) {}
+
+GrpcServiceFixture::GrpcServiceFixture(
+    ugrpc::server::ServerConfig&& server_config)
+    : server_(std::move(server_config), statistics_storage_) {}
 
 GrpcServiceFixture::~GrpcServiceFixture() = default;
 
@@ -33,7 +39,7 @@ void GrpcServiceFixture::StartServer(
   endpoint_ = fmt::format("[::1]:{}", server_.GetPort());
   client_factory_.emplace(std::move(client_factory_config),
                           engine::current_task::GetTaskProcessor(),
-                          server_.GetCompletionQueue(), statistics_storage_);
+                          server_.GetCompletionQueues(), statistics_storage_);
 }
 
 void GrpcServiceFixture::StopServer() noexcept {
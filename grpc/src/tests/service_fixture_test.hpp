@@ -18,6 +18,7 @@ USERVER_NAMESPACE_BEGIN
 class GrpcServiceFixture : public ::testing::Test {
  protected:
   GrpcServiceFixture();
+  explicit GrpcServiceFixture(ugrpc::server::ServerConfig&& server_config);
   ~GrpcServiceFixture() override;
 
   void RegisterService(ugrpc::server::ServiceBase& service);
@@ -1,5 +1,6 @@
 #include <userver/ugrpc/client/client_factory.hpp>
 
+#include <memory>
 #include <optional>
 #include <stdexcept>
 
@@ -7,6 +8,7 @@
 
 #include <userver/engine/async.hpp>
 #include <userver/logging/level_serialization.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
 #include <ugrpc/impl/logging.hpp>
@@ -66,8 +68,40 @@ std::shared_ptr<grpc::ChannelCredentials> MakeDefaultCredentials(
   UINVARIANT(false, "Invalid AuthType");
 }
 
+std::vector<std::unique_ptr<QueueHolder>> MakeQueues(
+    std::size_t count, ugrpc::impl::StatisticsStorage& statistics_storage) {
+  UINVARIANT(count > 0, "At least one completion queue is required");
+  std::vector<std::unique_ptr<QueueHolder>> queues;
+  queues.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    queues.push_back(std::make_unique<QueueHolder>(
+        statistics_storage.GetQueueStatistics(i)));
+  }
+  return queues;
+}
+
+std::vector<grpc::CompletionQueue*> GetQueues(
+    const std::vector<std::unique_ptr<QueueHolder>>& holders) {
+  std::vector<grpc::CompletionQueue*> queues;
+  queues.reserve(holders.size());
+  for (const auto& holder : holders) queues.push_back(&holder->GetQueue());
+  return queues;
+}
+
 }  // namespace
 
+QueueDistribution Parse(const yaml_config::YamlConfig& value,
+                        formats::parse::To<QueueDistribution>) {
+  const auto string = value.As<std::string>();
+
+  if (string == "round-robin") return QueueDistribution::kRoundRobin;
+  if (string == "by-channel") return QueueDistribution::kByChannel;
+
+  throw std::runtime_error(
+      fmt::format("Failed to parse QueueDistribution from '{}' at path '{}'",
+                  string, value.GetPath()));
+}
+
 ClientFactoryConfig Parse(const yaml_config::YamlConfig& value,
                           formats::parse::To<ClientFactoryConfig>) {
   ClientFactoryConfig config;
@@ -80,6 +114,12 @@ ClientFactoryConfig Parse(const yaml_config::YamlConfig& value,
       value["native-log-level"].As<logging::Level>(config.native_log_level);
   config.channel_count =
       value["channel-count"].As<std::size_t>(config.channel_count);
+  config.completion_queue_count =
+      value["completion-queue-count"].As<std::size_t>(
+          config.completion_queue_count);
+  config.queue_distribution =
+      value["queue-distribution"].As<QueueDistribution>(
+          config.queue_distribution);
 
   return config;
 }
@@ -88,11 +128,32 @@ ClientFactory::ClientFactory(ClientFactoryConfig&& config,
                              engine::TaskProcessor& channel_task_processor,
                              grpc::CompletionQueue& queue,
                              utils::statistics::Storage& statistics_storage)
+    : ClientFactory(std::move(config), channel_task_processor, {&queue},
+                    statistics_storage) {}
+
+ClientFactory::ClientFactory(ClientFactoryConfig&& config,
+                             engine::TaskProcessor& channel_task_processor,
+                             std::vector<grpc::CompletionQueue*> queues,
+                             utils::statistics::Storage& statistics_storage)
+    : channel_task_processor_(channel_task_processor),
+      client_statistics_storage_(statistics_storage, "client"),
+      queues_(std::move(queues), config.queue_distribution),
+      channel_cache_(std::move(config.credentials), config.channel_args,
+                     config.channel_count) {
+  ugrpc::impl::SetupNativeLogging();
+  ugrpc::impl::UpdateNativeLogLevel(config.native_log_level);
+}
+
+ClientFactory::ClientFactory(ClientFactoryConfig&& config,
+                             engine::TaskProcessor& channel_task_processor,
+                             utils::statistics::Storage& statistics_storage)
     : channel_task_processor_(channel_task_processor),
-      queue_(queue),
+      client_statistics_storage_(statistics_storage, "client"),
+      own_queues_(MakeQueues(config.completion_queue_count,
+                             client_statistics_storage_)),
+      queues_(GetQueues(own_queues_), config.queue_distribution),
       channel_cache_(std::move(config.credentials), config.channel_args,
-                     config.channel_count),
-      client_statistics_storage_(statistics_storage, "client") {
+                     config.channel_count) {
   ugrpc::impl::SetupNativeLogging();
   ugrpc::impl::UpdateNativeLogLevel(config.native_log_level);
 }
@@ -18,20 +18,20 @@ ClientFactoryComponent::ClientFactoryComponent(
   auto& task_processor =
       context.GetTaskProcessor(config["task-processor"].As<std::string>());
 
-  grpc::CompletionQueue* queue = nullptr;
+  auto& statistics_storage =
+      context.FindComponent<components::StatisticsStorage>().GetStorage();
+
+  auto factory_config = config.As<ClientFactoryConfig>();
   if (auto* const server =
           context.FindComponentOptional<ugrpc::server::ServerComponent>()) {
-    queue = &server->GetServer().GetCompletionQueue();
+    // The server queues are shared with the clients
+    factory_.emplace(std::move(factory_config), task_processor,
+                     server->GetServer().GetCompletionQueues(),
+                     statistics_storage);
   } else {
-    queue_.emplace();
-    queue = &queue_->GetQueue();
+    factory_.emplace(std::move(factory_config), task_processor,
+                     statistics_storage);
   }
-
-  auto& statistics_storage =
-      context.FindComponent<components::StatisticsStorage>().GetStorage();
-
-  factory_.emplace(config.As<ClientFactoryConfig>(), task_processor, *queue,
-                   statistics_storage);
 }
 
 ClientFactory& ClientFactoryComponent::GetFactory() { return *factory_; }
@@ -81,6 +81,19 @@ properties:
         description: |
             Number of channels created for each endpoint.
         defaultDescription: 1
+    completion-queue-count:
+        type: integer
+        description: |
+            Number of completion queues, each one has its own thread. Ignored
+            if the gRPC server exists, the server queues are used then.
+        defaultDescription: 1
+    queue-distribution:
+        type: string
+        description: how the RPCs are spread over the completion queues
+        defaultDescription: round-robin
+        enum:
+          - round-robin
+          - by-channel
 )");
 }
 
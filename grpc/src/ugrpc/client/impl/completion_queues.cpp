@@ -0,0 +1,19 @@
+#include <userver/ugrpc/client/impl/completion_queues.hpp>
+
+#include <utility>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client::impl {
+
+CompletionQueues::CompletionQueues(std::vector<grpc::CompletionQueue*>&& queues,
+                                   QueueDistribution distribution)
+    : queues_(std::move(queues)), distribution_(distribution) {
+  UINVARIANT(!queues_.empty(), "At least one completion queue is required");
+}
+
+}  // namespace ugrpc::client::impl
+
+USERVER_NAMESPACE_END
@@ -7,11 +7,17 @@ USERVER_NAMESPACE_BEGIN
 namespace ugrpc::client {
 
 struct QueueHolder::Impl final {
+  explicit Impl(ugrpc::impl::QueueStatistics* statistics)
+      : queue_runner(queue, statistics) {}
+
   grpc::CompletionQueue queue;
-  ugrpc::impl::QueueRunner queue_runner{queue};
+  ugrpc::impl::QueueRunner queue_runner;
 };
 
-QueueHolder::QueueHolder() = default;
+QueueHolder::QueueHolder() : impl_(nullptr) {}
+
+QueueHolder::QueueHolder(ugrpc::impl::QueueStatistics& statistics)
+    : impl_(&statistics) {}
 
 QueueHolder::~QueueHolder() = default;
 
@@ -1,11 +1,15 @@
 #include <userver/ugrpc/impl/queue_runner.hpp>
 
+#include <chrono>
 #include <thread>
 
+#include <grpc/support/time.h>
+
 #include <userver/utils/assert.hpp>
 #include <userver/utils/thread_name.hpp>
 
 #include <userver/ugrpc/impl/async_method_invocation.hpp>
+#include <userver/ugrpc/impl/statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -13,26 +17,60 @@ namespace ugrpc::impl {
 
 namespace {
 
-void ProcessQueue(grpc::CompletionQueue& queue,
-                  engine::SingleUseEvent& completion) noexcept {
-  utils::SetCurrentThreadName("grpc-queue");
+void Notify(void* tag, bool ok) noexcept {
+  auto* call = static_cast<AsyncMethodInvocation*>(tag);
+  UASSERT(call != nullptr);
+  call->Notify(ok);
+}
+
+void ProcessQueue(grpc::CompletionQueue& queue) noexcept {
+  void* tag = nullptr;
+  bool ok = false;
+
+  while (queue.Next(&tag, &ok)) Notify(tag, ok);
+}
 
+void ProcessQueueWithStatistics(grpc::CompletionQueue& queue,
+                                QueueStatistics& statistics) noexcept {
   void* tag = nullptr;
   bool ok = false;
 
   while (queue.Next(&tag, &ok)) {
-    auto* call = static_cast<AsyncMethodInvocation*>(tag);
-    UASSERT(call != nullptr);
-    call->Notify(ok);
-  }
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t events = 1;
+    Notify(tag, ok);
 
-  completion.Send();
+    // Drain the events that are already there, so that the batch size shows
+    // how much the runner lags behind the queue
+    auto status = grpc::CompletionQueue::GOT_EVENT;
+    while ((status = queue.AsyncNext(&tag, &ok,
+                                     gpr_time_0(GPR_CLOCK_MONOTONIC))) ==
+           grpc::CompletionQueue::GOT_EVENT) {
+      ++events;
+      Notify(tag, ok);
+    }
+
+    statistics.AccountBatch(
+        events, std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start));
+    if (status == grpc::CompletionQueue::SHUTDOWN) break;
+  }
 }
 
 }  // namespace
 
-QueueRunner::QueueRunner(grpc::CompletionQueue& queue) : queue_(queue) {
-  std::thread([this] { ProcessQueue(queue_, completion_); }).detach();
+QueueRunner::QueueRunner(grpc::CompletionQueue& queue,
+                         QueueStatistics* statistics)
+    : queue_(queue), statistics_(statistics) {
+  std::thread([this] {
+    utils::SetCurrentThreadName("grpc-queue");
+    if (statistics_) {
+      ProcessQueueWithStatistics(queue_, *statistics_);
+    } else {
+      ProcessQueue(queue_);
+    }
+    completion_.Send();
+  }).detach();
 }
 
 QueueRunner::~QueueRunner() {
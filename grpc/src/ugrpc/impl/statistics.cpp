@@ -80,6 +80,25 @@ formats::json::Value MethodStatistics::ExtendStatistics() const {
   return result.ExtractValue();
 }
 
+void QueueStatistics::AccountBatch(std::size_t events,
+                                   std::chrono::microseconds timing) noexcept {
+  events_ += events;
+  batch_sizes_.GetCurrentCounter().Account(events);
+  timings_.GetCurrentCounter().Account(timing.count());
+}
+
+formats::json::Value QueueStatistics::ExtendStatistics() const {
+  formats::json::ValueBuilder result(formats::json::Type::kObject);
+  result["events"] = events_.load();
+  result["batch-size"]["1min"] =
+      utils::statistics::PercentileToJson(batch_sizes_.GetStatsForPeriod());
+  utils::statistics::SolomonSkip(result["batch-size"]["1min"]);
+  result["timings-us"]["1min"] =
+      utils::statistics::PercentileToJson(timings_.GetStatsForPeriod());
+  utils::statistics::SolomonSkip(result["timings-us"]["1min"]);
+  return result.ExtractValue();
+}
+
 ServiceStatistics::~ServiceStatistics() = default;
 
 ServiceStatistics::ServiceStatistics(const StaticServiceMetadata& metadata)
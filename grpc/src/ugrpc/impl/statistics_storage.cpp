@@ -1,5 +1,7 @@
 #include <userver/ugrpc/impl/statistics_storage.hpp>
 
+#include <string>
+
 #include <fmt/format.h>
 
 #include <userver/utils/algo.hpp>
@@ -46,6 +48,13 @@ ugrpc::impl::ServiceStatistics& StatisticsStorage::GetServiceStatistics(
   return iter->second;
 }
 
+ugrpc::impl::QueueStatistics& StatisticsStorage::GetQueueStatistics(
+    std::size_t queue_index) {
+  // Queues are only created during startup
+  std::lock_guard lock(mutex_);
+  return queue_statistics_[queue_index];
+}
+
 formats::json::Value StatisticsStorage::ExtendStatistics(
     std::string_view prefix) {
   const auto cut_prefix = prefix.size() >= client_prefix_.size()
@@ -71,6 +80,15 @@ formats::json::Value StatisticsStorage::ExtendStatistics(
   utils::statistics::SolomonChildrenAreLabelValues(by_destination,
                                                    "grpc_destination");
   result["by-destination"] = std::move(by_destination);
+
+  if (!queue_statistics_.empty()) {
+    formats::json::ValueBuilder by_queue(formats::json::Type::kObject);
+    for (const auto& [queue_index, queue_stats] : queue_statistics_) {
+      by_queue[std::to_string(queue_index)] = queue_stats.ExtendStatistics();
+    }
+    utils::statistics::SolomonChildrenAreLabelValues(by_queue, "grpc_queue");
+    result["by-queue"] = std::move(by_queue);
+  }
   return result.ExtractValue();
 }
 
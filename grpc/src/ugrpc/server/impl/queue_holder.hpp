@@ -8,6 +8,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace ugrpc::impl {
+class QueueStatistics;
+}  // namespace ugrpc::impl
+
 namespace ugrpc::server::impl {
 
 /// @brief Manages a gRPC completion queue, usable in services and clients.
@@ -16,7 +20,9 @@ namespace ugrpc::server::impl {
 /// instances are destroyed.
 class QueueHolder final {
  public:
-  explicit QueueHolder(std::unique_ptr<grpc::ServerCompletionQueue>&& queue);
+  /// @param statistics if not null, the queue events are accounted into it
+  explicit QueueHolder(std::unique_ptr<grpc::ServerCompletionQueue>&& queue,
+                       ugrpc::impl::QueueStatistics* statistics = nullptr);
 
   QueueHolder(QueueHolder&&) = delete;
   QueueHolder& operator=(QueueHolder&&) = delete;
@@ -26,7 +32,7 @@ class QueueHolder final {
 
  private:
   struct Impl;
-  utils::FastPimpl<Impl, 32, 8> impl_;
+  utils::FastPimpl<Impl, 40, 8> impl_;
 };
 
 }  // namespace ugrpc::server::impl
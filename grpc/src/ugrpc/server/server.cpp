@@ -77,6 +77,8 @@ ServerConfig Parse(const yaml_config::YamlConfig& value,
   config.native_log_level =
       value["native-log-level"].As<logging::Level>(logging::Level::kError);
   config.enable_channelz = value["enable-channelz"].As<bool>(false);
+  config.completion_queue_count =
+      value["completion-queue-count"].As<std::size_t>(1);
   return config;
 }
 
@@ -92,6 +94,8 @@ class Server::Impl final {
 
   grpc::CompletionQueue& GetCompletionQueue() noexcept;
 
+  std::vector<grpc::CompletionQueue*> GetCompletionQueues();
+
   void Start();
 
   int GetPort() const noexcept;
@@ -111,15 +115,16 @@ class Server::Impl final {
 
   void DoStart();
 
+  // Queue runners account into the statistics until the queues are destroyed
+  ugrpc::impl::StatisticsStorage statistics_storage_;
+
   State state_{State::kConfiguration};
   std::optional<grpc::ServerBuilder> server_builder_;
   std::optional<int> port_;
   std::vector<std::unique_ptr<impl::ServiceWorker>> service_workers_;
-  std::optional<impl::QueueHolder> queue_;
+  std::vector<std::unique_ptr<impl::QueueHolder>> queues_;
   std::unique_ptr<grpc::Server> server_;
   engine::Mutex configuration_mutex_;
-
-  ugrpc::impl::StatisticsStorage statistics_storage_;
 };
 
 Server::Impl::Impl(ServerConfig&& config,
@@ -137,7 +142,14 @@ Server::Impl::Impl(ServerConfig&& config,
   }
   server_builder_.emplace();
   ApplyChannelArgs(*server_builder_, config);
-  queue_.emplace(server_builder_->AddCompletionQueue());
+  UINVARIANT(config.completion_queue_count > 0,
+             "At least one completion queue is required");
+  queues_.reserve(config.completion_queue_count);
+  for (std::size_t i = 0; i < config.completion_queue_count; ++i) {
+    queues_.push_back(std::make_unique<impl::QueueHolder>(
+        server_builder_->AddCompletionQueue(),
+        &statistics_storage_.GetQueueStatistics(i)));
+  }
   if (config.port) AddListeningPort(*config.port);
 }
 
@@ -169,8 +181,12 @@ void Server::Impl::AddService(ServiceBase& service,
   std::lock_guard lock(configuration_mutex_);
   UASSERT(state_ == State::kConfiguration);
 
+  std::vector<grpc::ServerCompletionQueue*> queues;
+  queues.reserve(queues_.size());
+  for (auto& queue : queues_) queues.push_back(&queue->GetQueue());
+
   service_workers_.push_back(service.MakeWorker(impl::ServiceSettings{
-      queue_->GetQueue(), task_processor, statistics_storage_}));
+      std::move(queues), task_processor, statistics_storage_}));
 }
 
 void Server::Impl::WithServerBuilder(SetupHook&& setup) {
@@ -182,7 +198,16 @@ void Server::Impl::WithServerBuilder(SetupHook&& setup) {
 
 grpc::CompletionQueue& Server::Impl::GetCompletionQueue() noexcept {
   UASSERT(state_ == State::kConfiguration || state_ == State::kActive);
-  return queue_->GetQueue();
+  UASSERT(!queues_.empty());
+  return queues_.front()->GetQueue();
+}
+
+std::vector<grpc::CompletionQueue*> Server::Impl::GetCompletionQueues() {
+  UASSERT(state_ == State::kConfiguration || state_ == State::kActive);
+  std::vector<grpc::CompletionQueue*> queues;
+  queues.reserve(queues_.size());
+  for (auto& queue : queues_) queues.push_back(&queue->GetQueue());
+  return queues;
 }
 
 void Server::Impl::Start() {
@@ -209,7 +234,7 @@ void Server::Impl::Stop() noexcept {
   // Note 1: Stop must be idempotent, so that the 'Stop' invocation after a
   // 'Start' failure is optional.
   // Note 2: 'state_' remains 'kActive' while stopping, which allows clients to
-  // finish their requests using 'queue_'.
+  // finish their requests using 'queues_'.
 
   // Must shutdown server, then ServiceWorkers, then queues before anything else
   if (server_) {
@@ -217,7 +242,7 @@ void Server::Impl::Stop() noexcept {
     server_->Shutdown();
   }
   service_workers_.clear();
-  queue_.reset();
+  queues_.clear();
   server_.reset();
 
   state_ = State::kStopped;
@@ -272,6 +297,10 @@ grpc::CompletionQueue& Server::GetCompletionQueue() noexcept {
   return impl_->GetCompletionQueue();
 }
 
+std::vector<grpc::CompletionQueue*> Server::GetCompletionQueues() {
+  return impl_->GetCompletionQueues();
+}
+
 void Server::Start() { return impl_->Start(); }
 
 int Server::GetPort() const noexcept { return impl_->GetPort(); }
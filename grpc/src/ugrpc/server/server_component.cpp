@@ -54,6 +54,10 @@ properties:
     enable-channelz:
         type: boolean
         description: enable channelz
+    completion-queue-count:
+        type: integer
+        description: number of completion queues, each one has its own thread
+        defaultDescription: 1
 )");
 }
 
@@ -3,6 +3,7 @@
 /// @file userver/storages/mongo/cursor.hpp
 /// @brief @copybrief storages::mongo::Cursor
 
+#include <functional>
 #include <iterator>
 #include <memory>
 
@@ -61,6 +62,15 @@ class Cursor {
   Iterator begin();
   Iterator end();
 
+  using BorrowedCallback = std::function<void(const formats::bson::Document&)>;
+
+  /// @brief Visits the remaining documents without copying them out of the
+  /// cursor batches, e.g. for the large scans in cache updates.
+  /// @warning The document passed to the callback points into the current
+  /// batch and is only valid during the call, neither it nor its subvalues
+  /// may be stored. Parse the needed data out of it instead.
+  void ForEachBorrowed(const BorrowedCallback& callback);
+
  private:
   std::unique_ptr<impl::CursorImpl> impl_;
 };
@@ -88,6 +88,7 @@ class Find {
   void SetOption(options::ReadConcern);
   void SetOption(options::Skip);
   void SetOption(options::Limit);
+  void SetOption(options::BatchSize);
   void SetOption(options::Projection);
   void SetOption(const options::Sort&);
   void SetOption(const options::Hint&);
@@ -319,6 +320,7 @@ class Aggregate {
   void SetOption(const options::WriteConcern&);
   void SetOption(options::WriteConcern::Level);
   void SetOption(const options::Hint&);
+  void SetOption(options::BatchSize);
   void SetOption(const options::Comment&);
   void SetOption(const options::MaxServerTime&);
 
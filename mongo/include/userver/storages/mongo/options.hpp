@@ -151,6 +151,19 @@ class Limit {
   size_t value_;
 };
 
+/// @brief Specifies the number of documents to return in each cursor batch
+/// @note The value of `0` means the server default. Larger batches take fewer
+/// round trips for long scans at the cost of the cursor memory.
+class BatchSize {
+ public:
+  explicit BatchSize(size_t value) : value_(value) {}
+
+  size_t Value() const { return value_; }
+
+ private:
+  size_t value_;
+};
+
 /// @brief Selects fields to be returned
 /// @note `_id` field is always included by default, order might be significant
 /// @see
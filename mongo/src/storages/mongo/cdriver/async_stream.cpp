@@ -654,9 +654,7 @@ ssize_t AsyncStream::Poll(mongoc_stream_poll_t* streams, size_t nstreams,
 
   ssize_t ready = 0;
   try {
-    AsyncStreamPoller::Event poller_event;
-    for (bool has_more = poller.NextEvent(poller_event, deadline); has_more;
-         has_more = poller.NextEventNoblock(poller_event)) {
+    for (const auto& poller_event : poller.NextEvents(deadline)) {
       for (size_t i = 0; i < nstreams; ++i) {
         if (stream_fds[i] == poller_event.fd) {
           ready += !streams[i].revents;
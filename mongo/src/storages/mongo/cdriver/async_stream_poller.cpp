@@ -1,7 +1,5 @@
 #include <storages/mongo/cdriver/async_stream_poller.hpp>
 
-#include <poll.h>
-
 #include <userver/engine/task/task.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
@@ -12,143 +10,128 @@ namespace storages::mongo::impl::cdriver {
 
 namespace {
 
-void ConcurrentStop(int fd, std::mutex& mutex,
-                    AsyncStreamPoller::WatchersMap& watchers) {
-  std::unique_lock lock(mutex);
-  const auto it = watchers.find(fd);
-  if (it == watchers.end()) return;
-  auto watcher = it->second.lock();
-  lock.unlock();
-
-  // After `watcher.Stop();` mutexes, watchers and AsyncStreamPoller may be
-  // destroyed. But not before the Stop() call!
-  if (watcher) watcher->Stop();
-}
-
 void StopWatchers(AsyncStreamPoller::WatchersMap& watchers) {
-  for (auto& watcher_it : watchers) {
-    auto watcher = watcher_it.second.lock();
-    if (watcher) watcher->Stop();
-  }
+  for (auto& [fd, watcher] : watchers) watcher->Stop();
 }
 
 }  // namespace
 
-AsyncStreamPoller::AsyncStreamPoller()
-    : AsyncStreamPoller(engine::MpscQueue<Event>::Create()) {}
+AsyncStreamPoller::Watcher::Watcher(AsyncStreamPoller& poller, int fd,
+                                    int events)
+    : poller_(poller),
+      fd_(fd),
+      ev_watcher_(engine::current_task::GetEventThread(), this) {
+  ev_watcher_.Init(&IoEventCb, fd, events);
+}
+
+void AsyncStreamPoller::Watcher::Stop() { ev_watcher_.Stop(); }
+
+AsyncStreamPoller::AsyncStreamPoller() = default;
 
 AsyncStreamPoller::~AsyncStreamPoller() {
-  // ResetWatchers() acquires a lock and avoids race between watchers.find(fd);
-  // and WatchersMap destruction.
+  // Watchers may outlive the poller in the streams, they must not fire after
+  // this point
   ResetWatchers();
 }
 
-AsyncStreamPoller::AsyncStreamPoller(
-    const std::shared_ptr<engine::MpscQueue<Event>>& queue)
-    : event_consumer_(queue->GetConsumer()),
-      event_producer_(queue->GetProducer()) {}
-
 AsyncStreamPoller::WatcherPtr AsyncStreamPoller::AddRead(int fd) {
-  std::unique_lock lock(read_watchers_mutex_);
-  auto& watcher_ptr = read_watchers_[fd];
-  auto watcher = watcher_ptr.lock();
-  if (!watcher) {
-    watcher = std::make_shared<engine::ev::Watcher<ev_io>>(
-        engine::current_task::GetEventThread(), this);
-    watcher->Init(&IoEventCb, fd, EV_READ);
-    watcher_ptr = watcher;
-  }
-  lock.unlock();
-  watcher->StartAsync();
-  return watcher;
+  return Add(read_watchers_, fd, EV_READ);
 }
 
 AsyncStreamPoller::WatcherPtr AsyncStreamPoller::AddWrite(int fd) {
-  std::unique_lock lock(write_watchers_mutex_);
-  auto& watcher_ptr = write_watchers_[fd];
-  auto watcher = watcher_ptr.lock();
-  if (!watcher) {
-    watcher = std::make_shared<engine::ev::Watcher<ev_io>>(
-        engine::current_task::GetEventThread(), this);
-    watcher->Init(&IoEventCb, fd, EV_WRITE);
-    watcher_ptr = watcher;
-  }
-  lock.unlock();
-  watcher->StartAsync();
-  return watcher;
+  return Add(write_watchers_, fd, EV_WRITE);
 }
 
 void AsyncStreamPoller::Reset() {
   ResetWatchers();
 
-  Event buf;
-  while (event_consumer_.PopNoblock(buf))
-    ;  // discard
+  // discard
+  events_.clear();
+  ready_event_.Reset();
 }
 
-bool AsyncStreamPoller::NextEvent(Event& buf, engine::Deadline deadline) {
-  return event_consumer_.Pop(buf, deadline);
+const std::vector<AsyncStreamPoller::Event>& AsyncStreamPoller::NextEvents(
+    engine::Deadline deadline) {
+  events_.clear();
+  TakeReady();
+  // The event may be left signaled by an already taken batch
+  while (events_.empty() && ready_event_.WaitForEventUntil(deadline)) {
+    TakeReady();
+  }
+  return events_;
 }
 
-bool AsyncStreamPoller::NextEventNoblock(Event& buf) {
-  return event_consumer_.PopNoblock(buf);
+AsyncStreamPoller::WatcherPtr AsyncStreamPoller::Add(WatchersMap& watchers,
+                                                     int fd, int events) {
+  auto& watcher = watchers[fd];
+  if (!watcher) watcher = std::make_shared<Watcher>(*this, fd, events);
+  watcher->ev_watcher_.StartAsync();
+  return watcher;
 }
 
-void AsyncStreamPoller::StopRead(int fd) {
-  ConcurrentStop(fd, read_watchers_mutex_, read_watchers_);
+void AsyncStreamPoller::PushReady(Watcher& watcher, int revents) noexcept {
+  // Already in the list, the events are merged
+  if (watcher.ready_revents_.fetch_or(revents)) return;
+
+  auto* head = ready_head_.load();
+  do {
+    watcher.next_ready_ = head;
+  } while (!ready_head_.compare_exchange_weak(head, &watcher));
+
+  if (!head) ready_event_.Send();
 }
 
-void AsyncStreamPoller::StopWrite(int fd) {
-  ConcurrentStop(fd, write_watchers_mutex_, write_watchers_);
+void AsyncStreamPoller::TakeReady() {
+  // The consumer takes the whole list, so there is no ABA problem
+  auto* watcher = ready_head_.exchange(nullptr);
+  while (watcher) {
+    // May be pushed again as soon as the revents are cleared
+    auto* next = watcher->next_ready_;
+    const auto revents = watcher->ready_revents_.exchange(0);
+
+    auto event_type = Event::kError;
+    if (revents & EV_ERROR) {
+      // highest priority, can be mixed with dummy events
+      event_type = Event::kError;
+    } else if (revents & EV_READ) {
+      event_type = Event::kRead;
+    } else if (revents & EV_WRITE) {
+      event_type = Event::kWrite;
+    }
+    // NOTE: it might be better to poll() here to get POLLERR/POLLHUP as well
+    events_.push_back({watcher->fd_, event_type});
+
+    watcher = next;
+  }
 }
 
 void AsyncStreamPoller::ResetWatchers() {
-  // destroy watchers without lock to avoid deadlocking with callback
-  WatchersMap watchers_buffer;
-  {
-    std::lock_guard read_lock(read_watchers_mutex_);
-    read_watchers_.swap(watchers_buffer);
-  }
-  StopWatchers(watchers_buffer);
-  watchers_buffer.clear();
-  {
-    std::lock_guard write_lock(write_watchers_mutex_);
-    write_watchers_.swap(watchers_buffer);
-  }
-  StopWatchers(watchers_buffer);
-  watchers_buffer.clear();
+  // Synchronous stops, no callback runs after them
+  StopWatchers(read_watchers_);
+  StopWatchers(write_watchers_);
+  // The ready list must be drained before the maps are cleared, as they may
+  // hold the last references to the listed watchers. Draining also clears
+  // the ready revents of the watchers that outlive the poller maps.
+  TakeReady();
+  read_watchers_.clear();
+  write_watchers_.clear();
 }
 
-void AsyncStreamPoller::IoEventCb(struct ev_loop*, ev_io* watcher,
+void AsyncStreamPoller::IoEventCb(struct ev_loop*, ev_io* ev_watcher,
                                   int revents) noexcept {
-  UASSERT(watcher->active);
-  UASSERT((watcher->events & ~(EV_READ | EV_WRITE)) == 0);
-
-  auto* poller = static_cast<AsyncStreamPoller*>(watcher->data);
-  auto event_type = Event::kError;
-  if (revents & EV_ERROR) {
-    // highest priority, can be mixed with dummy events
-    event_type = Event::kError;
-  } else if (revents & EV_READ) {
-    event_type = Event::kRead;
-  } else if (revents & EV_WRITE) {
-    event_type = Event::kWrite;
-  }
-  // NOTE: it might be better to poll() here to get POLLERR/POLLHUP as well
-  [[maybe_unused]] bool is_sent =
-      poller->event_producer_.PushNoblock({watcher->fd, event_type});
-  UASSERT(is_sent);
-
-  if (watcher->events & EV_READ) {
-    UASSERT(!(watcher->events & EV_WRITE));
-    poller->StopRead(watcher->fd);
-  } else if (watcher->events & EV_WRITE) {
-    poller->StopWrite(watcher->fd);
-  } else {
-    LOG_LIMITED_ERROR() << "Watcher is neither read nor write watcher, events="
-                        << watcher->events;
-    UASSERT_MSG(false, "Watcher is neither read nor write watcher");
+  UASSERT(ev_watcher->active);
+  UASSERT((ev_watcher->events & ~(EV_READ | EV_WRITE)) == 0);
+
+  auto* watcher = static_cast<Watcher*>(ev_watcher->data);
+  // One-shot, runs synchronously in the ev thread
+  watcher->Stop();
+
+  if (!(revents & (EV_ERROR | EV_READ | EV_WRITE))) {
+    LOG_LIMITED_ERROR() << "Unexpected io watcher events, revents="
+                        << revents;
+    revents = EV_ERROR;
   }
+  watcher->poller_.PushReady(*watcher, revents);
 }
 
 }  // namespace storages::mongo::impl::cdriver
@@ -1,11 +1,13 @@
 #pragma once
 
-#include <mutex>
+#include <atomic>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/io/common.hpp>
-#include <userver/engine/mpsc_queue.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 
 #include <engine/ev/watcher.hpp>
 
@@ -14,13 +16,16 @@ USERVER_NAMESPACE_BEGIN
 namespace storages::mongo::impl::cdriver {
 
 // AsyncStream-specific implementation of global poller object
-// Not thread-safe
+// Not thread-safe, only the ev callbacks may run concurrently
 // Reports HUP as readiness (libev limitation)
+//
+// Watchers are one-shot, a fired watcher is pushed to the lock-free list of
+// the ready ones and only the first one of a batch wakes the polling task up.
 class AsyncStreamPoller final {
  public:
-  using WatcherPtr = std::shared_ptr<engine::ev::Watcher<ev_io>>;
-  using WatcherWeakPtr = std::weak_ptr<engine::ev::Watcher<ev_io>>;
-  using WatchersMap = std::unordered_map<int, WatcherWeakPtr>;
+  class Watcher;
+  using WatcherPtr = std::shared_ptr<Watcher>;
+  using WatchersMap = std::unordered_map<int, WatcherPtr>;
 
   struct Event {
     int fd{engine::io::kInvalidFd};
@@ -38,26 +43,42 @@ class AsyncStreamPoller final {
   [[nodiscard]] WatcherPtr AddRead(int fd);
   [[nodiscard]] WatcherPtr AddWrite(int fd);
 
-  bool NextEvent(Event&, engine::Deadline);
-  bool NextEventNoblock(Event&);
+  /// Waits for the events until the deadline and takes all the ready ones,
+  /// the result is valid until the next call
+  const std::vector<Event>& NextEvents(engine::Deadline);
 
  private:
-  explicit AsyncStreamPoller(const std::shared_ptr<engine::MpscQueue<Event>>&);
-
-  void StopRead(int fd);
-  void StopWrite(int fd);
+  WatcherPtr Add(WatchersMap& watchers, int fd, int events);
+  void PushReady(Watcher& watcher, int revents) noexcept;
+  void TakeReady();
   void ResetWatchers();
 
   static void IoEventCb(struct ev_loop*, ev_io*, int) noexcept;
 
-  engine::MpscQueue<Event>::Consumer event_consumer_;
-  engine::MpscQueue<Event>::Producer event_producer_;
-  std::mutex read_watchers_mutex_;
+  engine::SingleConsumerEvent ready_event_;
+  std::atomic<Watcher*> ready_head_{nullptr};
+  std::vector<Event> events_;
   WatchersMap read_watchers_;
-  std::mutex write_watchers_mutex_;
   WatchersMap write_watchers_;
 };
 
+class AsyncStreamPoller::Watcher final {
+ public:
+  Watcher(AsyncStreamPoller& poller, int fd, int events);
+
+  void Stop();
+
+ private:
+  friend class AsyncStreamPoller;
+
+  AsyncStreamPoller& poller_;
+  const int fd_;
+  engine::ev::Watcher<ev_io> ev_watcher_;
+  // Not zero while in the ready list
+  std::atomic<int> ready_revents_{0};
+  Watcher* next_ready_{nullptr};
+};
+
 }  // namespace storages::mongo::impl::cdriver
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,77 @@
+#include <storages/mongo/cdriver/async_stream_poller.hpp>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using storages::mongo::impl::cdriver::AsyncStreamPoller;
+
+constexpr std::chrono::milliseconds kMaxTestWaitTime{5000};
+constexpr std::chrono::milliseconds kNoEventsWaitTime{10};
+
+class SocketPair final {
+ public:
+  SocketPair() {
+    EXPECT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds_.data()), 0);
+  }
+  ~SocketPair() {
+    ::close(fds_[0]);
+    ::close(fds_[1]);
+  }
+
+  SocketPair(const SocketPair&) = delete;
+  SocketPair& operator=(const SocketPair&) = delete;
+
+  int Reader() const { return fds_[0]; }
+
+  void MakeReadable() const { EXPECT_EQ(::write(fds_[1], "x", 1), 1); }
+
+ private:
+  std::array<int, 2> fds_{-1, -1};
+};
+
+}  // namespace
+
+UTEST(AsyncStreamPoller, ResetWithDestroyedReadyWatcher) {
+  SocketPair sockets;
+  sockets.MakeReadable();
+
+  AsyncStreamPoller poller;
+  auto watcher = poller.AddRead(sockets.Reader());
+
+  // Watchers of the same fd are invoked in the reverse order of their start,
+  // so the watcher of the poller fires before this one is reported
+  AsyncStreamPoller sentinel_poller;
+  auto sentinel = sentinel_poller.AddRead(sockets.Reader());
+  ASSERT_EQ(sentinel_poller.NextEvents(engine::Deadline::FromDuration(
+                                           kMaxTestWaitTime))
+                .size(),
+            1);
+
+  // The stream is destroyed, the ready list of the poller holds the watcher
+  watcher->Stop();
+  watcher.reset();
+  poller.Reset();
+
+  EXPECT_TRUE(
+      poller.NextEvents(engine::Deadline::FromDuration(kNoEventsWaitTime))
+          .empty());
+
+  // The poller still reports the events after the reset
+  watcher = poller.AddRead(sockets.Reader());
+  const auto& events =
+      poller.NextEvents(engine::Deadline::FromDuration(kMaxTestWaitTime));
+  ASSERT_EQ(events.size(), 1);
+  EXPECT_EQ(events[0].fd, sockets.Reader());
+  EXPECT_EQ(events[0].type, AsyncStreamPoller::Event::kRead);
+}
+
+USERVER_NAMESPACE_END
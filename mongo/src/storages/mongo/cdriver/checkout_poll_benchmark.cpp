@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <storages/mongo/cdriver/async_stream_poller.hpp>
+#include <storages/mongo/cdriver/checkout_queue.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kThreads = 4;
+constexpr std::size_t kPoolSize = 16;
+
+using storages::mongo::impl::cdriver::AsyncStreamPoller;
+using storages::mongo::impl::cdriver::CheckoutQueue;
+
+struct Client {};
+
+}  // namespace
+
+// `coroutines` tasks check out one of kPoolSize clients and return it
+void MongoPoolCheckout(benchmark::State& state) {
+  engine::RunStandalone(kThreads, [&] {
+    CheckoutQueue<Client> queue(kPoolSize);
+    std::array<Client, kPoolSize> clients{};
+    std::atomic<std::size_t> created{0};
+
+    const auto coroutines = static_cast<std::size_t>(state.range(0));
+    std::atomic<std::size_t> checkouts{0};
+    for (auto _ : state) {
+      std::vector<engine::TaskWithResult<void>> tasks;
+      tasks.reserve(coroutines);
+      for (std::size_t i = 0; i < coroutines; ++i) {
+        tasks.push_back(engine::AsyncNoSpan([&] {
+          for (int j = 0; j < 100; ++j) {
+            auto client = queue.Acquire({});
+            UASSERT(client);
+            // Clients are never dropped, at most kPoolSize are created
+            if (!*client) *client = &clients[created++];
+            engine::Yield();
+            queue.Release(*client);
+            ++checkouts;
+          }
+        }));
+      }
+      for (auto& task : tasks) task.Get();
+    }
+    state.SetItemsProcessed(checkouts.load());
+  });
+}
+// {coroutines}
+BENCHMARK(MongoPoolCheckout)->Arg(16)->Arg(256)->Arg(4096)->UseRealTime();
+
+// `coroutines` tasks wait for the readability of their own sockets, the way
+// mongoc polls its streams
+void MongoAsyncStreamPoll(benchmark::State& state) {
+  engine::RunStandalone(kThreads, [&] {
+    const auto coroutines = static_cast<std::size_t>(state.range(0));
+    std::atomic<std::size_t> polls{0};
+    for (auto _ : state) {
+      std::vector<engine::TaskWithResult<void>> tasks;
+      tasks.reserve(coroutines);
+      for (std::size_t i = 0; i < coroutines; ++i) {
+        tasks.push_back(engine::AsyncNoSpan([&] {
+          int fds[2];
+          ::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds);
+          {
+            AsyncStreamPoller poller;
+            char byte = 0;
+            for (int j = 0; j < 100; ++j) {
+              [[maybe_unused]] auto written = ::write(fds[1], &byte, 1);
+              auto watcher = poller.AddRead(fds[0]);
+              benchmark::DoNotOptimize(poller.NextEvents({}));
+              [[maybe_unused]] auto read = ::read(fds[0], &byte, 1);
+              ++polls;
+            }
+          }
+          ::close(fds[0]);
+          ::close(fds[1]);
+        }));
+      }
+      for (auto& task : tasks) task.Get();
+    }
+    state.SetItemsProcessed(polls.load());
+  });
+}
+// {coroutines}
+BENCHMARK(MongoAsyncStreamPoll)->Arg(16)->Arg(256)->UseRealTime();
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo::impl::cdriver {
+
+/// @brief Bounded set of pooled objects with the FIFO fair checkout.
+///
+/// A returned object (or a freed slot) is handed to the longest waiting
+/// checkout directly, a new checkout never overtakes the waiting ones.
+/// Idle objects are reused in the FIFO order as well.
+template <typename T>
+class CheckoutQueue final {
+ public:
+  explicit CheckoutQueue(std::size_t max_size) : max_size_(max_size) {}
+
+  CheckoutQueue(const CheckoutQueue&) = delete;
+  CheckoutQueue& operator=(const CheckoutQueue&) = delete;
+
+  /// @brief Takes a slot, waits for one until the deadline if none is free.
+  /// @returns an idle object or nullptr if the caller is to create one for
+  /// the slot, std::nullopt on timeout
+  std::optional<T*> Acquire(engine::Deadline deadline);
+
+  /// Returns the object taken with Acquire() and frees its slot
+  void Release(T* object) noexcept;
+
+  /// Frees the slot taken with Acquire() without an object
+  void ReleaseSlot() noexcept;
+
+  /// Takes an idle object without a slot, e.g. to close it
+  T* TryPopIdle() noexcept;
+
+  std::size_t InUseApprox() const noexcept { return in_use_.load(); }
+  std::size_t WaitingApprox() const noexcept { return waiting_.load(); }
+
+ private:
+  struct Waiter {
+    engine::SingleConsumerEvent event;
+    bool is_granted{false};
+    T* object{nullptr};
+  };
+
+  // Hands the slot over to the first waiter if any, must be called under lock
+  bool TryHandOver(T* object) noexcept;
+
+  const std::size_t max_size_;
+  std::mutex mutex_;
+  std::deque<Waiter*> waiters_;
+  std::deque<T*> idle_;
+  std::atomic<std::size_t> in_use_{0};
+  std::atomic<std::size_t> waiting_{0};
+};
+
+template <typename T>
+std::optional<T*> CheckoutQueue<T>::Acquire(engine::Deadline deadline) {
+  Waiter waiter;
+  {
+    std::lock_guard lock(mutex_);
+    if (waiters_.empty() && in_use_.load() < max_size_) {
+      ++in_use_;
+      if (idle_.empty()) return nullptr;
+      auto* object = idle_.front();
+      idle_.pop_front();
+      return object;
+    }
+    waiters_.push_back(&waiter);
+    ++waiting_;
+  }
+
+  [[maybe_unused]] const bool is_signaled =
+      waiter.event.WaitForEventUntil(deadline);
+
+  std::lock_guard lock(mutex_);
+  // The slot may be handed over after the deadline, it is taken anyway
+  if (waiter.is_granted) return waiter.object;
+
+  const auto it = std::find(waiters_.begin(), waiters_.end(), &waiter);
+  UASSERT(it != waiters_.end());
+  waiters_.erase(it);
+  --waiting_;
+  return std::nullopt;
+}
+
+template <typename T>
+void CheckoutQueue<T>::Release(T* object) noexcept {
+  UASSERT(object);
+  std::lock_guard lock(mutex_);
+  if (TryHandOver(object)) return;
+  idle_.push_back(object);
+  --in_use_;
+}
+
+template <typename T>
+void CheckoutQueue<T>::ReleaseSlot() noexcept {
+  std::lock_guard lock(mutex_);
+  if (TryHandOver(nullptr)) return;
+  --in_use_;
+}
+
+template <typename T>
+T* CheckoutQueue<T>::TryPopIdle() noexcept {
+  std::lock_guard lock(mutex_);
+  if (idle_.empty()) return nullptr;
+  auto* object = idle_.front();
+  idle_.pop_front();
+  return object;
+}
+
+template <typename T>
+bool CheckoutQueue<T>::TryHandOver(T* object) noexcept {
+  if (waiters_.empty()) return false;
+
+  auto* waiter = waiters_.front();
+  waiters_.pop_front();
+  --waiting_;
+  waiter->is_granted = true;
+  waiter->object = object;
+  // Under the lock, the waiter is destroyed right after it sees is_granted
+  waiter->event.Send();
+  return true;
+}
+
+}  // namespace storages::mongo::impl::cdriver
+
+USERVER_NAMESPACE_END
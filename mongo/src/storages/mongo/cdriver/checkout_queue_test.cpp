@@ -0,0 +1,91 @@
+#include <storages/mongo/cdriver/checkout_queue.hpp>
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using storages::mongo::impl::cdriver::CheckoutQueue;
+
+template <typename T>
+void WaitForWaiters(const CheckoutQueue<T>& queue, std::size_t count) {
+  while (queue.WaitingApprox() != count) engine::Yield();
+}
+
+}  // namespace
+
+UTEST(CheckoutQueue, IdleReuse) {
+  CheckoutQueue<int> queue(2);
+  int object = 0;
+
+  EXPECT_EQ(queue.Acquire({}), std::optional<int*>{nullptr});
+  EXPECT_EQ(queue.InUseApprox(), 1);
+  queue.Release(&object);
+  EXPECT_EQ(queue.InUseApprox(), 0);
+
+  EXPECT_EQ(queue.Acquire({}), std::optional<int*>{&object});
+  queue.Release(&object);
+  EXPECT_EQ(queue.TryPopIdle(), &object);
+  EXPECT_EQ(queue.TryPopIdle(), nullptr);
+}
+
+UTEST(CheckoutQueue, Fifo) {
+  CheckoutQueue<int> queue(1);
+  int object = 0;
+  ASSERT_EQ(queue.Acquire({}), std::optional<int*>{nullptr});
+
+  std::vector<int> order;
+  auto checkout = [&](int id) {
+    return engine::AsyncNoSpan([&, id] {
+      const auto acquired = queue.Acquire({});
+      ASSERT_TRUE(acquired);
+      EXPECT_EQ(*acquired, &object);
+      order.push_back(id);
+      queue.Release(*acquired);
+    });
+  };
+  auto first = checkout(1);
+  WaitForWaiters(queue, 1);
+  auto second = checkout(2);
+  WaitForWaiters(queue, 2);
+
+  queue.Release(&object);
+  // A new checkout does not overtake the waiting ones
+  const auto third = queue.Acquire({});
+  first.Get();
+  second.Get();
+  EXPECT_EQ(order, (std::vector<int>{1, 2}));
+  EXPECT_EQ(third, std::optional<int*>{&object});
+}
+
+UTEST(CheckoutQueue, Timeout) {
+  CheckoutQueue<int> queue(1);
+  ASSERT_EQ(queue.Acquire({}), std::optional<int*>{nullptr});
+
+  EXPECT_FALSE(queue.Acquire(
+      engine::Deadline::FromDuration(std::chrono::milliseconds{10})));
+  EXPECT_EQ(queue.WaitingApprox(), 0);
+  EXPECT_EQ(queue.InUseApprox(), 1);
+}
+
+UTEST(CheckoutQueue, ReleaseSlot) {
+  CheckoutQueue<int> queue(1);
+  ASSERT_EQ(queue.Acquire({}), std::optional<int*>{nullptr});
+
+  auto waiter = engine::AsyncNoSpan([&] { return queue.Acquire({}); });
+  WaitForWaiters(queue, 1);
+
+  // The slot of a dropped object goes to the waiter to create a new one
+  queue.ReleaseSlot();
+  EXPECT_EQ(waiter.Get(), std::optional<int*>{nullptr});
+  EXPECT_EQ(queue.InUseApprox(), 1);
+}
+
+USERVER_NAMESPACE_END
@@ -34,7 +34,7 @@ CDriverCursorImpl::CDriverCursorImpl(
   Next();  // prime the cursor
 }
 
-bool CDriverCursorImpl::IsValid() const { return cursor_ || current_; }
+bool CDriverCursorImpl::IsValid() const { return cursor_ || current_bson_; }
 
 bool CDriverCursorImpl::HasMore() const {
   return cursor_ && mongoc_cursor_more(cursor_.get());
@@ -42,12 +42,26 @@ bool CDriverCursorImpl::HasMore() const {
 
 const formats::bson::Document& CDriverCursorImpl::Current() const {
   if (!IsValid()) throw std::logic_error("Reading from invalid cursor");
+  if (!current_) {
+    current_ = formats::bson::Document(
+        formats::bson::impl::MutableBson::CopyNative(current_bson_).Extract());
+  }
   return *current_;
 }
 
+formats::bson::Document CDriverCursorImpl::CurrentBorrowed() const {
+  if (!IsValid()) throw std::logic_error("Reading from invalid cursor");
+  if (current_) return *current_;
+  // Aliasing an empty holder, the batch stays owned by the cursor
+  return formats::bson::Document(
+      formats::bson::impl::BsonHolder(formats::bson::impl::BsonHolder{},
+                                      current_bson_));
+}
+
 void CDriverCursorImpl::Next() {
   if (!IsValid()) throw std::logic_error("Advancing cursor past the end");
 
+  current_bson_ = nullptr;
   current_ = std::nullopt;
   if (!HasMore()) {
     UASSERT(!cursor_ && !client_);
@@ -65,8 +79,7 @@ void CDriverCursorImpl::Next() {
   MongoError error;
   while (!mongoc_cursor_error(cursor_.get(), error.GetNative()) && HasMore()) {
     if (mongoc_cursor_next(cursor_.get(), &current_bson)) {
-      current_ = formats::bson::Document(
-          formats::bson::impl::MutableBson::CopyNative(current_bson).Extract());
+      current_bson_ = current_bson;
       break;
     }
   }
@@ -78,6 +91,8 @@ void CDriverCursorImpl::Next() {
     cursor_next_sw.AccountError(error.GetKind());
   }
   if (!HasMore()) {
+    // The last document outlives its batch
+    if (current_bson_) current_bson_ = Current().GetBson().get();
     cursor_.reset();
     client_.reset();
   }
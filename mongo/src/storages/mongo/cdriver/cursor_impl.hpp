@@ -25,10 +25,13 @@ class CDriverCursorImpl : public CursorImpl {
   bool HasMore() const override;
 
   const formats::bson::Document& Current() const override;
+  formats::bson::Document CurrentBorrowed() const override;
   void Next() override;
 
  private:
-  std::optional<formats::bson::Document> current_;
+  // Points into the current batch, copied out only when asked for
+  const bson_t* current_bson_{nullptr};
+  mutable std::optional<formats::bson::Document> current_;
   cdriver::CDriverPoolImpl::BoundClientPtr client_;
   cdriver::CursorPtr cursor_;
   std::shared_ptr<stats::ReadOperationStatistics> stats_ptr_;
@@ -11,6 +11,7 @@
 #include <userver/storages/mongo/exception.hpp>
 #include <userver/storages/mongo/mongo_error.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
 #include <userver/utils/traceful_exception.hpp>
 
 #include <storages/mongo/cdriver/async_stream.hpp>
@@ -129,11 +130,8 @@ CDriverPoolImpl::CDriverPoolImpl(std::string id, const std::string& uri_string,
       idle_limit_(config.idle_limit),
       queue_timeout_(config.queue_timeout),
       size_(0),
-      in_use_semaphore_(config.max_size),
-      connecting_semaphore_(config.connecting_limit),
-      // FP?: pointer magic in boost.lockfree
-      // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
-      queue_(config.max_size) {
+      queue_(config.max_size),
+      connecting_semaphore_(config.connecting_limit) {
   static const GlobalInitializer kInitMongoc;
   GlobalInitializer::LogInitWarningsOnce();
   CheckAsyncStreamCompatible();
@@ -151,9 +149,13 @@ CDriverPoolImpl::CDriverPoolImpl(std::string id, const std::string& uri_string,
   try {
     LOG_INFO() << "Creating " << config.initial_size << " mongo connections";
     for (size_t i = 0; i < config.initial_size; ++i) {
-      engine::SemaphoreLock lock(in_use_semaphore_);
-      Push(Create());
-      lock.Release();
+      [[maybe_unused]] const auto idle = queue_.Acquire({});
+      UASSERT(idle && !*idle);
+      utils::FastScopeGuard release_slot(
+          [this]() noexcept { queue_.ReleaseSlot(); });
+      auto* client = Create();
+      release_slot.Release();
+      Push(client);
     }
   } catch (const std::exception& ex) {
     LOG_ERROR() << "Mongo pool was not fully prepopulated: " << ex;
@@ -170,18 +172,19 @@ CDriverPoolImpl::~CDriverPoolImpl() {
   maintenance_task_.Stop();
 
   const ClientDeleter deleter;
-  mongoc_client_t* client = nullptr;
-  while (queue_.pop(client)) deleter(client);
+  while (auto* client = queue_.TryPopIdle()) deleter(client);
 }
 
-size_t CDriverPoolImpl::InUseApprox() const {
-  return max_size_ - in_use_semaphore_.RemainingApprox();
-}
+size_t CDriverPoolImpl::InUseApprox() const { return queue_.InUseApprox(); }
 
 size_t CDriverPoolImpl::SizeApprox() const { return size_.load(); }
 
 size_t CDriverPoolImpl::MaxSize() const { return max_size_; }
 
+size_t CDriverPoolImpl::WaitingApprox() const {
+  return queue_.WaitingApprox();
+}
+
 const std::string& CDriverPoolImpl::DefaultDatabaseName() const {
   return default_database_;
 }
@@ -195,21 +198,24 @@ mongoc_client_t* CDriverPoolImpl::Pop() {
   stats::ConnectionThrottleStopwatch queue_sw(GetStatistics().pool);
   const auto queue_deadline = engine::Deadline::FromDuration(queue_timeout_);
 
-  engine::SemaphoreLock in_use_lock(in_use_semaphore_, queue_deadline);
-  if (!in_use_lock) {
+  // FIFO, the checkouts are served in the order they came in
+  const auto idle_client = queue_.Acquire(queue_deadline);
+  if (!idle_client) {
     ++GetStatistics().pool->overload;
     throw PoolOverloadException("Mongo pool '")
         << Id() << "' has reached size limit: " << max_size_;
   }
 
-  auto* client = TryGetIdle();
+  auto* client = *idle_client;
   if (!client) {
+    utils::FastScopeGuard release_slot(
+        [this]() noexcept { queue_.ReleaseSlot(); });
     engine::SemaphoreLock connecting_lock(connecting_semaphore_,
                                           queue_deadline);
     queue_sw.Stop();
 
     // retry getting idle connection after the wait
-    client = TryGetIdle();
+    client = queue_.TryPopIdle();
     if (!client) {
       if (!connecting_lock) {
         ++GetStatistics().pool->overload;
@@ -219,17 +225,16 @@ mongoc_client_t* CDriverPoolImpl::Pop() {
       }
       client = Create();
     }
+    release_slot.Release();
   }
 
   UASSERT(client);
-  in_use_lock.Release();
   return client;
 }
 
 void CDriverPoolImpl::Push(mongoc_client_t* client) noexcept {
   UASSERT(client);
-  if (!queue_.bounded_push(client)) Drop(client);
-  in_use_semaphore_.unlock_shared();
+  queue_.Release(client);
 }
 
 void CDriverPoolImpl::Drop(mongoc_client_t* client) noexcept {
@@ -240,12 +245,6 @@ void CDriverPoolImpl::Drop(mongoc_client_t* client) noexcept {
   ++GetStatistics().pool->closed;
 }
 
-mongoc_client_t* CDriverPoolImpl::TryGetIdle() {
-  mongoc_client_t* client = nullptr;
-  if (queue_.pop(client)) return client;
-  return nullptr;
-}
-
 mongoc_client_t* CDriverPoolImpl::Create() {
   // "admin" is an internal mongodb database and always exists/accessible
   static const char* kPingDatabase = "admin";
@@ -287,7 +286,7 @@ void CDriverPoolImpl::DoMaintenance() {
   for (auto idle_drop_left = kIdleConnectionDropRate;
        idle_drop_left && size_.load() > idle_limit_; --idle_drop_left) {
     LOG_TRACE() << "Trying to drop idle connection";
-    Drop(TryGetIdle());
+    Drop(queue_.TryPopIdle());
   }
   LOG_DEBUG() << "Finished mongo pool '" << Id() << "' maintenance";
 }
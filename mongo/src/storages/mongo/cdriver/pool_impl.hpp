@@ -3,9 +3,8 @@
 #include <chrono>
 
 #include <mongoc/mongoc.h>
-#include <boost/lockfree/queue.hpp>
-
 #include <storages/mongo/cdriver/async_stream.hpp>
+#include <storages/mongo/cdriver/checkout_queue.hpp>
 #include <storages/mongo/cdriver/wrappers.hpp>
 #include <storages/mongo/mongo_config.hpp>
 #include <storages/mongo/pool_impl.hpp>
@@ -46,6 +45,7 @@ class CDriverPoolImpl final : public PoolImpl {
   size_t InUseApprox() const override;
   size_t SizeApprox() const override;
   size_t MaxSize() const override;
+  size_t WaitingApprox() const override;
 
   BoundClientPtr Acquire();
 
@@ -54,7 +54,6 @@ class CDriverPoolImpl final : public PoolImpl {
   void Push(mongoc_client_t*) noexcept;
   void Drop(mongoc_client_t*) noexcept;
 
-  mongoc_client_t* TryGetIdle();
   mongoc_client_t* Create();
 
   void DoMaintenance();
@@ -68,9 +67,8 @@ class CDriverPoolImpl final : public PoolImpl {
   const size_t idle_limit_;
   const std::chrono::milliseconds queue_timeout_;
   std::atomic<size_t> size_;
-  engine::Semaphore in_use_semaphore_;
+  CheckoutQueue<mongoc_client_t> queue_;
   engine::Semaphore connecting_semaphore_;
-  boost::lockfree::queue<mongoc_client_t*> queue_;
   utils::PeriodicTask maintenance_task_;
 };
 
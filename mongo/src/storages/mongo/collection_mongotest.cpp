@@ -536,6 +536,33 @@ UTEST(Collection, LargeDocRoundtrip) {
   EXPECT_EQ(large_string, (*result)["s"].As<std::string>());
 }
 
+UTEST(Collection, ForEachBorrowed) {
+  auto dns_resolver = MakeDnsResolver();
+  auto pool = MakeTestPool(&dns_resolver);
+  auto coll = pool.GetCollection("for_each_borrowed");
+
+  constexpr int kDocsCount = 10;
+  for (int i = 0; i < kDocsCount; ++i) {
+    coll.InsertOne(bson::MakeDoc("_id", i, "s", std::to_string(i)));
+  }
+
+  auto cursor = coll.Find(
+      {}, mongo::options::Sort{{"_id", mongo::options::Sort::kAscending}},
+      mongo::options::BatchSize{3});
+  ASSERT_TRUE(cursor);
+  // Iteration and borrowing can be mixed
+  EXPECT_EQ(0, (*cursor.begin())["_id"].As<int>());
+
+  int expected_id = 0;
+  cursor.ForEachBorrowed([&expected_id](const bson::Document& doc) {
+    EXPECT_EQ(expected_id, doc["_id"].As<int>());
+    EXPECT_EQ(std::to_string(expected_id), doc["s"].As<std::string>());
+    ++expected_id;
+  });
+  EXPECT_EQ(kDocsCount, expected_id);
+  EXPECT_FALSE(cursor);
+}
+
 UTEST(Collection, ExecuteOps) {
   auto dns_resolver = MakeDnsResolver();
   auto pool = MakeTestPool(&dns_resolver);
@@ -21,6 +21,13 @@ Cursor::Iterator Cursor::begin() { return Iterator(this); }
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 Cursor::Iterator Cursor::end() { return Iterator(nullptr); }
 
+void Cursor::ForEachBorrowed(const BorrowedCallback& callback) {
+  while (impl_->IsValid()) {
+    callback(impl_->CurrentBorrowed());
+    impl_->Next();
+  }
+}
+
 Cursor::Iterator::Iterator(Cursor* cursor) : cursor_(cursor) {
   if (cursor_ && !cursor_->impl_->IsValid()) cursor_ = nullptr;
 }
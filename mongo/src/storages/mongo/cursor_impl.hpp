@@ -14,6 +14,8 @@ class CursorImpl {
   virtual bool HasMore() const = 0;
 
   virtual const formats::bson::Document& Current() const = 0;
+  /// Current document that is only valid until the next Next() call
+  virtual formats::bson::Document CurrentBorrowed() const = 0;
   virtual void Next() = 0;
 };
 
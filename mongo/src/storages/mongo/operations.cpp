@@ -133,6 +133,14 @@ void AppendLimit(formats::bson::impl::BsonBuilder& builder,
   AppendUint64Option(builder, kOptionName, limit.Value());
 }
 
+void AppendBatchSize(formats::bson::impl::BsonBuilder& builder,
+                     options::BatchSize batch_size) {
+  if (!batch_size.Value()) return;
+
+  static const std::string kOptionName = "batchSize";
+  AppendUint64Option(builder, kOptionName, batch_size.Value());
+}
+
 void AppendHint(formats::bson::impl::BsonBuilder& builder,
                 const options::Hint& hint) {
   static const std::string kOptionName = "hint";
@@ -317,6 +325,10 @@ void Find::SetOption(options::Limit limit) {
   AppendLimit(impl::EnsureBuilder(impl_->options), limit);
 }
 
+void Find::SetOption(options::BatchSize batch_size) {
+  AppendBatchSize(impl::EnsureBuilder(impl_->options), batch_size);
+}
+
 void Find::SetOption(options::Projection projection) {
   const bson_t* projection_bson = projection.GetProjectionBson();
   if (bson_empty0(projection_bson)) return;
@@ -704,6 +716,10 @@ void Aggregate::SetOption(const options::Hint& hint) {
   AppendHint(impl::EnsureBuilder(impl_->options), hint);
 }
 
+void Aggregate::SetOption(options::BatchSize batch_size) {
+  AppendBatchSize(impl::EnsureBuilder(impl_->options), batch_size);
+}
+
 void Aggregate::SetOption(const options::Comment& comment) {
   AppendComment(impl::EnsureBuilder(impl_->options), impl_->has_comment_option,
                 comment);
@@ -22,6 +22,7 @@ formats::json::Value GetPoolStatistics(const impl::PoolImpl& pool_impl,
   builder["pool"]["current-size"] = pool_impl.SizeApprox();
   builder["pool"]["current-in-use"] = pool_impl.InUseApprox();
   builder["pool"]["max-size"] = pool_impl.MaxSize();
+  builder["pool"]["current-waiting"] = pool_impl.WaitingApprox();
 
   utils::statistics::SolomonLabelValue(builder, "mongo_database");
   return builder.ExtractValue();
@@ -28,6 +28,8 @@ class PoolImpl {
   virtual size_t InUseApprox() const = 0;
   virtual size_t SizeApprox() const = 0;
   virtual size_t MaxSize() const = 0;
+  /// Checkouts waiting for a free connection slot
+  virtual size_t WaitingApprox() const = 0;
 
  protected:
   PoolImpl(std::string&& id, Config config);
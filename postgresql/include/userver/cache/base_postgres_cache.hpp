@@ -93,6 +93,14 @@ namespace components {
 ///
 /// @snippet cache/postgres_cache_test.cpp Pg Cache Policy Custom Container With Write Notification Example
 ///
+/// Incremental update copies the current cache data before applying the
+/// changes. For big caches consider cache::PersistentHashMap as the
+/// CacheContainer: its copies share the data, so the update cost and the
+/// memory overhead depend on the number of changes rather than on the cache
+/// size.
+///
+/// @snippet cache/postgres_cache_test.cpp Pg Cache Policy Persistent Container Example
+///
 /// @section pg_cc_forward_declaration Forward Declaration
 ///
 /// To forward declare a cache you can forward declare a trait and
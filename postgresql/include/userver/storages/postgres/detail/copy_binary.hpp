@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <boost/pfr/core.hpp>
+
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/io/field_buffer.hpp>
+#include <userver/storages/postgres/io/row_types.hpp>
+#include <userver/storages/postgres/io/traits.hpp>
+#include <userver/storages/postgres/io/user_types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// Approximate size of the data sent with a single CopyData message
+inline constexpr std::size_t kCopyChunkSize = 64 * 1024;
+
+using CopyBuffer = std::vector<char>;
+
+/// Appends the next portion of COPY data to the buffer, returns false after
+/// the last portion was appended
+using CopyInProducer = std::function<bool(CopyBuffer&)>;
+
+/// Consumes the payload of a single CopyData message received from the server
+using CopyOutConsumer = std::function<void(std::string_view)>;
+
+/// Signature that starts the binary COPY data
+/// https://www.postgresql.org/docs/current/sql-copy.html#id-1.9.3.55.9.4.5
+inline constexpr std::string_view kCopySignature{"PGCOPY\n\377\r\n\0", 11};
+/// Field count value that marks the end of the binary COPY data
+inline constexpr Smallint kCopyTrailer = -1;
+/// Header flag bit signalling that tuples contain OIDs
+inline constexpr Integer kCopyHasOidsFlag = 1 << 16;
+
+inline void WriteCopyHeader(const UserTypes& types, CopyBuffer& buffer) {
+  buffer.insert(buffer.end(), kCopySignature.begin(), kCopySignature.end());
+  // Flags
+  io::WriteBuffer(types, buffer, Integer{0});
+  // Header extension area length
+  io::WriteBuffer(types, buffer, Integer{0});
+}
+
+inline void WriteCopyTrailer(const UserTypes& types, CopyBuffer& buffer) {
+  io::WriteBuffer(types, buffer, kCopyTrailer);
+}
+
+template <typename Row>
+decltype(auto) GetCopyRowTuple(const Row& row) {
+  if constexpr (io::traits::kRowCategory<Row> ==
+                io::traits::RowCategoryType::kAggregate) {
+    // RowType::GetTuple() copies the members of a const aggregate
+    return boost::pfr::structure_tie(row);
+  } else {
+    return io::RowType<Row>::GetTuple(row);
+  }
+}
+
+/// Appends a tuple of binary COPY data. Members of a row type are written as
+/// separate columns, any other type is written as a single column.
+template <typename Row>
+void WriteCopyRow(const UserTypes& types, CopyBuffer& buffer, const Row& row) {
+  if constexpr (io::traits::kIsRowType<Row>) {
+    io::WriteBuffer(types, buffer,
+                    static_cast<Smallint>(io::RowType<Row>::size));
+    std::apply(
+        [&types, &buffer](const auto&... fields) {
+          (io::WriteRawBinary(types, buffer, fields), ...);
+        },
+        GetCopyRowTuple(row));
+  } else {
+    io::WriteBuffer(types, buffer, Smallint{1});
+    io::WriteRawBinary(types, buffer, row);
+  }
+}
+
+/// Makes a producer that streams the rows of the container as binary COPY
+/// data in chunks of about kCopyChunkSize bytes. The container must outlive
+/// the producer.
+template <typename Container>
+CopyInProducer MakeCopyInProducer(const UserTypes& types,
+                                  const Container& rows) {
+  return [&types, it = std::begin(rows), end = std::end(rows),
+          is_header_written = false](CopyBuffer& buffer) mutable {
+    if (!is_header_written) {
+      WriteCopyHeader(types, buffer);
+      is_header_written = true;
+    }
+    for (; it != end && buffer.size() < kCopyChunkSize; ++it) {
+      WriteCopyRow(types, buffer, *it);
+    }
+    if (it != end) return true;
+    WriteCopyTrailer(types, buffer);
+    return false;
+  };
+}
+
+/// Parses binary COPY data received from the server into rows. Members of a
+/// row type are read from separate columns, any other type is read from
+/// a single column.
+template <typename Row>
+class CopyOutParser {
+ public:
+  explicit CopyOutParser(const UserTypes& types)
+      : categories_{types.GetTypeBufferCategories()} {}
+
+  /// Parses the payload of a CopyData message and calls consumer(Row&&) for
+  /// every row in it
+  template <typename Consumer>
+  void Parse(std::string_view data, Consumer& consumer) {
+    io::FieldBuffer buffer{false, io::BufferCategory::kPlainBuffer,
+                           data.size(),
+                           reinterpret_cast<const std::uint8_t*>(data.data())};
+    if (!is_header_read_) {
+      ReadHeader(buffer);
+      is_header_read_ = true;
+    }
+    while (buffer.length) {
+      if (is_finished_) {
+        throw InvalidBinaryBuffer("COPY data after the trailer");
+      }
+      Smallint field_count{0};
+      buffer.Read(field_count, io::BufferCategory::kPlainBuffer);
+      if (field_count == kCopyTrailer) {
+        is_finished_ = true;
+        continue;
+      }
+      if (static_cast<std::size_t>(field_count) != kFieldCount) {
+        throw FieldTupleMismatch(field_count, kFieldCount);
+      }
+      Row row{};
+      ReadRow(buffer, row);
+      consumer(std::move(row));
+    }
+  }
+
+ private:
+  static constexpr std::size_t kFieldCount = [] {
+    if constexpr (io::traits::kIsRowType<Row>) {
+      return io::RowType<Row>::size;
+    } else {
+      return std::size_t{1};
+    }
+  }();
+
+  static void ReadHeader(io::FieldBuffer& buffer) {
+    if (buffer.length < kCopySignature.size() ||
+        std::memcmp(buffer.buffer, kCopySignature.data(),
+                    kCopySignature.size()) != 0) {
+      throw InvalidBinaryBuffer("COPY data has no binary format signature");
+    }
+    buffer = buffer.GetSubBuffer(kCopySignature.size());
+
+    Integer flags{0};
+    buffer.Read(flags, io::BufferCategory::kPlainBuffer);
+    if (flags & kCopyHasOidsFlag) {
+      throw InvalidBinaryBuffer("COPY data WITH OIDS is not supported");
+    }
+    Integer extension_length{0};
+    buffer.Read(extension_length, io::BufferCategory::kPlainBuffer);
+    if (extension_length < 0) {
+      throw InvalidBinaryBuffer("Negative COPY header extension length");
+    }
+    buffer = buffer.GetSubBuffer(extension_length);
+  }
+
+  template <typename T>
+  void ReadField(io::FieldBuffer& buffer, T& value) const {
+    buffer.ReadRaw(value, categories_, io::traits::kTypeBufferCategory<T>);
+  }
+
+  void ReadRow(io::FieldBuffer& buffer, Row& row) const {
+    if constexpr (io::traits::kIsRowType<Row>) {
+      std::apply(
+          [this, &buffer](auto&... fields) {
+            (ReadField(buffer, fields), ...);
+          },
+          io::RowType<Row>::GetTuple(row));
+    } else {
+      ReadField(buffer, row);
+    }
+  }
+
+  const io::TypeBufferCategory& categories_;
+  bool is_header_read_{false};
+  bool is_finished_{false};
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,73 @@
+#pragma once
+
+/// @file userver/storages/postgres/query_batch.hpp
+/// @brief @copybrief storages::postgres::QueryBatch
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <userver/storages/postgres/parameter_store.hpp>
+#include <userver/storages/postgres/query.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+/// @ingroup userver_containers
+///
+/// @brief A list of statements to be sent to the server in a single network
+/// roundtrip with storages::postgres::Transaction::ExecuteBatch.
+///
+/// Statements are executed in the order they were added. Parameters are
+/// stored the same way as in storages::postgres::ParameterStore.
+///
+/// @code
+/// pg::QueryBatch batch;
+/// batch.Add("select name from users where id = $1", user_id)
+///     .Add("select count(*) from orders where user_id = $1", user_id);
+/// auto results = trx.ExecuteBatch(batch);
+/// @endcode
+class QueryBatch {
+ public:
+  /// @cond
+  struct Statement {
+    Query query;
+    ParameterStore params;
+  };
+  /// @endcond
+
+  /// @brief Adds a statement with arbitrary parameters to the end of the batch
+  /// @note Currently only built-in/system types are supported.
+  template <typename... Args>
+  QueryBatch& Add(const Query& query, const Args&... args) {
+    ParameterStore params;
+    (params.PushBack(args), ...);
+    return Add(query, std::move(params));
+  }
+
+  /// @brief Adds a statement with stored parameters to the end of the batch
+  /// @note The store is moved into the batch, as the parameter buffers must
+  /// stay where they were written.
+  QueryBatch& Add(const Query& query, ParameterStore&& params) {
+    statements_.push_back({query, std::move(params)});
+    return *this;
+  }
+
+  /// Returns whether the batch is empty.
+  bool IsEmpty() const { return statements_.empty(); }
+
+  /// Returns the number of statements in the batch.
+  std::size_t Size() const { return statements_.size(); }
+
+  /// @cond
+  const std::vector<Statement>& GetStatements() const { return statements_; }
+  /// @endcond
+
+ private:
+  std::vector<Statement> statements_;
+};
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
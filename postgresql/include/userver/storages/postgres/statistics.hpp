@@ -30,6 +30,15 @@ struct TransactionStatistics {
   Counter out_of_trx_total = 0;
   /// Number of parsed queries
   Counter parse_total = 0;
+  /// Number of executions of statements already prepared on the connection,
+  /// parse_total / (parse_total + prepared_cache_hit_total) is the prepare
+  /// miss rate
+  Counter prepared_cache_hit_total = 0;
+  /// Number of parsed queries with a result description shared by other
+  /// connections of the cluster
+  Counter shared_description_total = 0;
+  /// Number of statements prepared eagerly by new connections
+  Counter prepared_on_connect_total = 0;
   /// Number of query executions
   Counter execute_total = 0;
   /// Total number of replies
@@ -161,6 +170,12 @@ struct InstanceStatisticsNonatomic : InstanceStatisticsNonatomicBase {
     transaction.rollback_total = stats.transaction.rollback_total;
     transaction.out_of_trx_total = stats.transaction.out_of_trx_total;
     transaction.parse_total = stats.transaction.parse_total;
+    transaction.prepared_cache_hit_total =
+        stats.transaction.prepared_cache_hit_total;
+    transaction.shared_description_total =
+        stats.transaction.shared_description_total;
+    transaction.prepared_on_connect_total =
+        stats.transaction.prepared_on_connect_total;
     transaction.execute_total = stats.transaction.execute_total;
     transaction.reply_total = stats.transaction.reply_total;
     transaction.portal_bind_total = stats.transaction.portal_bind_total;
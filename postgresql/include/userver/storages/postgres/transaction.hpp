@@ -5,8 +5,10 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <userver/storages/postgres/detail/connection_ptr.hpp>
+#include <userver/storages/postgres/detail/copy_binary.hpp>
 #include <userver/storages/postgres/detail/query_parameters.hpp>
 #include <userver/storages/postgres/detail/time_types.hpp>
 #include <userver/storages/postgres/options.hpp>
@@ -14,6 +16,7 @@
 #include <userver/storages/postgres/portal.hpp>
 #include <userver/storages/postgres/postgres_fwd.hpp>
 #include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/query_batch.hpp>
 #include <userver/storages/postgres/result_set.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -101,6 +104,42 @@ namespace storages::postgres {
 /// trx.Commit();
 /// @endcode
 ///
+/// @par Batches of independent queries
+///
+/// Every Execute waits for the result of its statement before the next one
+/// can be sent. Independent statements can be collected into a QueryBatch and
+/// sent at once using PostgreSQL pipeline mode, paying for a single network
+/// roundtrip instead of one per statement.
+///
+/// @code
+/// auto trx = cluster->Begin(/* transaction options */);
+/// pg::QueryBatch batch;
+/// batch.Add("select name from users where id = $1", user_id)
+///     .Add("select count(*) from orders where user_id = $1", user_id);
+/// auto results = trx.ExecuteBatch(batch);
+/// auto name = results[0].AsSingleRow<std::string>();
+/// trx.Commit();
+/// @endcode
+///
+/// @par Bulk loading and unloading with COPY
+///
+/// Large amounts of rows are faster to transfer with a binary COPY statement
+/// than with multi-row INSERTs or SELECTs. Rows are streamed in chunks, the
+/// driver doesn't produce the next chunk until the previous one is accepted
+/// by the connection socket. Columns are formatted and parsed with the same
+/// type mappings as query parameters and results.
+///
+/// @code
+/// struct Row { int id; std::string name; };
+///
+/// auto trx = cluster->Begin(/* transaction options */);
+/// std::vector<Row> rows = /* ... */;
+/// trx.CopyIn("COPY foobar (id, name) FROM STDIN (FORMAT binary)", rows);
+/// trx.CopyOut<Row>("COPY foobar (id, name) TO STDOUT (FORMAT binary)",
+///                  [](Row&& row) { /* ... */ });
+/// trx.Commit();
+/// @endcode
+///
 /// @see Transaction
 /// @see ResultSet
 ///
@@ -257,6 +296,93 @@ class Transaction {
   Portal MakePortal(OptionalCommandControl statement_cmd_ctl,
                     const Query& query, const ParameterStore& store);
 
+  /// Execute all the statements of the batch in a single network roundtrip
+  /// using PostgreSQL pipeline mode.
+  ///
+  /// Suspends coroutine for execution.
+  ///
+  /// @returns a result set per statement, in the order of the batch
+  /// @throws the error of the first failed statement; the statements after
+  /// it are not executed and the transaction is aborted. The index of the
+  /// failed statement is logged and added to the span.
+  /// @warning If the execution is interrupted by a network error or a timeout
+  /// on a connection that is not in pipeline mode, the connection is closed.
+  std::vector<ResultSet> ExecuteBatch(const QueryBatch& batch) {
+    return ExecuteBatch(OptionalCommandControl{}, batch);
+  }
+
+  /// Execute all the statements of the batch in a single network roundtrip
+  /// with per-batch command control. The execute timeout limits the whole
+  /// batch, the statement timeout limits every statement.
+  ///
+  /// Suspends coroutine for execution.
+  std::vector<ResultSet> ExecuteBatch(OptionalCommandControl statement_cmd_ctl,
+                                      const QueryBatch& batch);
+
+  /// Stream rows of the container to the server with a
+  /// `COPY ... FROM STDIN (FORMAT binary)` statement.
+  ///
+  /// Members of a row type are written as separate columns, any other type
+  /// is written as a single column. The whole transfer is limited by the
+  /// execute timeout of the command control.
+  ///
+  /// Suspends coroutine for execution.
+  ///
+  /// @returns the number of copied rows
+  /// @warning If the transfer is interrupted by a network error or a timeout,
+  /// the connection is closed.
+  template <typename Container>
+  std::size_t CopyIn(const Query& query, const Container& rows) {
+    return CopyIn(OptionalCommandControl{}, query, rows);
+  }
+
+  /// Stream rows of the container to the server with a
+  /// `COPY ... FROM STDIN (FORMAT binary)` statement and per-statement
+  /// command control.
+  ///
+  /// Suspends coroutine for execution.
+  template <typename Container>
+  std::size_t CopyIn(OptionalCommandControl statement_cmd_ctl,
+                     const Query& query, const Container& rows) {
+    return DoCopyIn(
+        query, detail::MakeCopyInProducer(GetConnectionUserTypes(), rows),
+        statement_cmd_ctl);
+  }
+
+  /// Stream rows from the server with a `COPY ... TO STDOUT (FORMAT binary)`
+  /// statement, calling `consumer(Row&&)` for every received row.
+  ///
+  /// Members of a row type are read from separate columns, any other type is
+  /// read from a single column. The whole transfer is limited by the execute
+  /// timeout of the command control.
+  ///
+  /// Suspends coroutine for execution.
+  ///
+  /// @returns the number of copied rows
+  /// @warning If the transfer is interrupted by an exception from the
+  /// consumer, a network error or a timeout, the connection is closed.
+  template <typename Row, typename Consumer>
+  std::size_t CopyOut(const Query& query, Consumer&& consumer) {
+    return CopyOut<Row>(OptionalCommandControl{}, query,
+                        std::forward<Consumer>(consumer));
+  }
+
+  /// Stream rows from the server with a `COPY ... TO STDOUT (FORMAT binary)`
+  /// statement and per-statement command control.
+  ///
+  /// Suspends coroutine for execution.
+  template <typename Row, typename Consumer>
+  std::size_t CopyOut(OptionalCommandControl statement_cmd_ctl,
+                      const Query& query, Consumer&& consumer) {
+    detail::CopyOutParser<Row> parser{GetConnectionUserTypes()};
+    return DoCopyOut(
+        query,
+        [&parser, &consumer](std::string_view data) {
+          parser.Parse(data, consumer);
+        },
+        statement_cmd_ctl);
+  }
+
   /// Set a connection parameter
   /// https://www.postgresql.org/docs/current/sql-set.html
   /// The parameter is set for this transaction only
@@ -285,6 +411,14 @@ class Transaction {
                     const detail::QueryParameters& params,
                     OptionalCommandControl statement_cmd_ctl);
 
+  std::size_t DoCopyIn(const Query& query,
+                       const detail::CopyInProducer& producer,
+                       OptionalCommandControl statement_cmd_ctl);
+
+  std::size_t DoCopyOut(const Query& query,
+                        const detail::CopyOutConsumer& consumer,
+                        OptionalCommandControl statement_cmd_ctl);
+
   const UserTypes& GetConnectionUserTypes() const;
 
   detail::ConnectionPtr conn_;
@@ -1,6 +1,7 @@
 #include "postgres_cache_test_fwd.hpp"
 
 #include <userver/cache/base_postgres_cache.hpp>
+#include <userver/cache/persistent_hash_map.hpp>
 
 #include <boost/functional/hash.hpp>
 
@@ -281,6 +282,20 @@ struct PostgresExamplePolicy6 {
   using CacheContainer = UserSpecificCacheWithWriteNotification;
 };
 
+/*! [Pg Cache Policy Persistent Container Example] */
+struct PostgresExamplePolicy7 {
+  static constexpr std::string_view kName = "my-pg-cache";
+  using ValueType = MyStructure;
+  static constexpr auto kKeyMember = &MyStructure::id;
+  static constexpr const char* kQuery =
+      "select id, bar, updated from test.my_data";
+  static constexpr const char* kUpdatedField = "updated";
+  using UpdatedFieldType = storages::postgres::TimePointTz;
+  // Incremental updates do not copy the whole container
+  using CacheContainer = cache::PersistentHashMap<int, MyStructure>;
+};
+/*! [Pg Cache Policy Persistent Container Example] */
+
 // Instantiation test
 using MyCache1 = PostgreCache<PostgresExamplePolicy>;
 using MyCache2 = PostgreCache<PostgresExamplePolicy2>;
@@ -289,6 +304,7 @@ using MyCache4 = PostgreCache<PostgresExamplePolicy4>;
 using MyTrivialCache = PostgreCache<PostgresTrivialPolicy>;
 using MyCache5 = PostgreCache<PostgresExamplePolicy5>;
 using MyCache6 = PostgreCache<PostgresExamplePolicy6>;
+using MyCache7 = PostgreCache<PostgresExamplePolicy7>;
 
 // NB: field access required for actual instantiation
 static_assert(MyCache1::kIncrementalUpdates);
@@ -297,6 +313,7 @@ static_assert(MyCache3::kIncrementalUpdates);
 static_assert(MyCache4::kIncrementalUpdates);
 static_assert(MyCache5::kIncrementalUpdates);
 static_assert(MyCache6::kIncrementalUpdates);
+static_assert(MyCache7::kIncrementalUpdates);
 
 namespace pg = storages::postgres;
 static_assert(MyCache1::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
@@ -305,6 +322,7 @@ static_assert(MyCache3::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache4::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache5::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache6::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
+static_assert(MyCache7::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 
 // Update() instantiation test
 [[maybe_unused]] void VerifyUpdateCompiles(
@@ -316,6 +334,7 @@ static_assert(MyCache6::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
   MyCache4 cache4{config, context};
   MyCache5 cache5{config, context};
   MyCache6 cache6{config, context};
+  MyCache7 cache7{config, context};
 }
 
 inline auto SampleOfComponentRegistration() {
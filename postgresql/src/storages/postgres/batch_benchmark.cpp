@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/query_batch.hpp>
+
+#include <storages/postgres/util_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+using namespace pg::bench;
+
+const pg::Query kSelect{"select $1::integer, $2::text"};
+const std::string kText = "text";
+
+}  // namespace
+
+BENCHMARK_DEFINE_F(PgConnection, SequentialSelects)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    auto& conn = GetConnection();
+    conn.Begin({}, {});
+    for (auto _ : state) {
+      for (int i = 0; i < state.range(0); ++i) {
+        benchmark::DoNotOptimize(conn.Execute(kSelect, i, kText));
+      }
+    }
+    conn.Rollback();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, SequentialSelects)
+    ->RangeMultiplier(4)
+    ->Range(1, 64);
+
+BENCHMARK_DEFINE_F(PgConnection, BatchSelects)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    auto& conn = GetConnection();
+    conn.Begin({}, {});
+    for (auto _ : state) {
+      pg::QueryBatch batch;
+      for (int i = 0; i < state.range(0); ++i) {
+        batch.Add(kSelect, i, kText);
+      }
+      benchmark::DoNotOptimize(conn.ExecuteBatch(batch));
+    }
+    conn.Rollback();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, BatchSelects)
+    ->RangeMultiplier(4)
+    ->Range(1, 64);
+
+USERVER_NAMESPACE_END
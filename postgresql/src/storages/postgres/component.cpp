@@ -78,6 +78,9 @@ formats::json::ValueBuilder InstanceStatisticsToJson(
 
   auto query = instance["queries"];
   query["parsed"] = stats.transaction.parse_total;
+  query["prepared-cache-hits"] = stats.transaction.prepared_cache_hit_total;
+  query["shared-descriptions"] = stats.transaction.shared_description_total;
+  query["prepared-on-connect"] = stats.transaction.prepared_on_connect_total;
   query["portals-bound"] = stats.transaction.portal_bind_total;
   query["executed"] = stats.transaction.execute_total;
   query["replies"] = stats.transaction.reply_total;
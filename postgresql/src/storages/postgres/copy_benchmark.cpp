@@ -0,0 +1,168 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/parameter_store.hpp>
+
+#include <storages/postgres/util_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+using namespace pg::bench;
+
+// Rows of a multi-row INSERT, as bulk loaders usually build them
+constexpr std::size_t kInsertChunkRows = 1000;
+
+constexpr pg::CommandControl kBulkCmdCtl{std::chrono::seconds{10},
+                                         std::chrono::seconds{10}};
+
+const std::string kCopyIn =
+    "copy copy_bench (id, name, value) from stdin (format binary)";
+
+const std::string kCreateTable = R"~(
+create temporary table copy_bench(
+  id integer,
+  name text,
+  value double precision
+))~";
+
+struct BenchRow {
+  int id{};
+  std::string name;
+  double value{};
+};
+
+std::vector<BenchRow> MakeRows(std::size_t count) {
+  std::vector<BenchRow> rows;
+  rows.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto id = static_cast<int>(i);
+    rows.push_back({id, "name " + std::to_string(id), id * 0.5});
+  }
+  return rows;
+}
+
+std::string MakeInsertStatement(std::size_t rows) {
+  std::string statement = "insert into copy_bench (id, name, value) values ";
+  for (std::size_t i = 0; i < rows; ++i) {
+    if (i) statement += ',';
+    statement += fmt::format("(${},${},${})", i * 3 + 1, i * 3 + 2, i * 3 + 3);
+  }
+  return statement;
+}
+
+void TruncateTable(benchmark::State& state, pg::detail::Connection& conn) {
+  state.PauseTiming();
+  conn.Execute("truncate copy_bench");
+  state.ResumeTiming();
+}
+
+}  // namespace
+
+BENCHMARK_DEFINE_F(PgConnection, BulkInsertMultiRow)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    auto& conn = GetConnection();
+    conn.Execute(kCreateTable);
+    const auto rows = MakeRows(state.range(0));
+    const auto chunk_statement = MakeInsertStatement(kInsertChunkRows);
+
+    for (auto _ : state) {
+      for (auto it = rows.begin(); it != rows.end();) {
+        const auto chunk_size = std::min<std::size_t>(
+            kInsertChunkRows, std::distance(it, rows.end()));
+        pg::ParameterStore params;
+        for (const auto end = it + chunk_size; it != end; ++it) {
+          params.PushBack(it->id).PushBack(it->name).PushBack(it->value);
+        }
+        conn.Execute(kBulkCmdCtl,
+                     chunk_size == kInsertChunkRows
+                         ? chunk_statement
+                         : MakeInsertStatement(chunk_size),
+                     params);
+      }
+      TruncateTable(state, conn);
+    }
+    state.SetItemsProcessed(state.iterations() * rows.size());
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, BulkInsertMultiRow)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100'000);
+
+BENCHMARK_DEFINE_F(PgConnection, BulkCopyIn)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    auto& conn = GetConnection();
+    conn.Execute(kCreateTable);
+    const auto rows = MakeRows(state.range(0));
+
+    for (auto _ : state) {
+      conn.CopyIn(kCopyIn,
+                  pg::detail::MakeCopyInProducer(conn.GetUserTypes(), rows),
+                  kBulkCmdCtl);
+      TruncateTable(state, conn);
+    }
+    state.SetItemsProcessed(state.iterations() * rows.size());
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, BulkCopyIn)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100'000);
+
+BENCHMARK_DEFINE_F(PgConnection, BulkCopyOut)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    auto& conn = GetConnection();
+    conn.Execute(kCreateTable);
+    const auto rows = MakeRows(state.range(0));
+    conn.CopyIn(kCopyIn,
+                pg::detail::MakeCopyInProducer(conn.GetUserTypes(), rows),
+                kBulkCmdCtl);
+
+    for (auto _ : state) {
+      pg::detail::CopyOutParser<BenchRow> parser{conn.GetUserTypes()};
+      auto consumer = [](BenchRow&& row) { benchmark::DoNotOptimize(row); };
+      conn.CopyOut(
+          "copy copy_bench (id, name, value) to stdout (format binary)",
+          [&parser, &consumer](std::string_view data) {
+            parser.Parse(data, consumer);
+          },
+          kBulkCmdCtl);
+    }
+    state.SetItemsProcessed(state.iterations() * rows.size());
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, BulkCopyOut)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100'000);
+
+BENCHMARK_DEFINE_F(PgConnection, BulkSelect)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    auto& conn = GetConnection();
+    conn.Execute(kCreateTable);
+    const auto rows = MakeRows(state.range(0));
+    conn.CopyIn(kCopyIn,
+                pg::detail::MakeCopyInProducer(conn.GetUserTypes(), rows),
+                kBulkCmdCtl);
+
+    for (auto _ : state) {
+      auto res = conn.Execute("select id, name, value from copy_bench", {},
+                              kBulkCmdCtl);
+      for (auto row : res.AsSetOf<BenchRow>(pg::kRowTag)) {
+        benchmark::DoNotOptimize(row);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * rows.size());
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, BulkSelect)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100'000);
+
+USERVER_NAMESPACE_END
@@ -68,6 +68,8 @@ ClusterImpl::ClusterImpl(DsnList dsns, clients::dns::Resolver* resolver,
                          const error_injection::Settings& ei_settings)
     : default_cmd_ctls_(default_cmd_ctls),
       bg_task_processor_(bg_task_processor),
+      statements_registry_(std::make_shared<PreparedStatementsRegistry>(
+          cluster_settings.conn_settings.max_prepared_cache_size)),
       rr_host_idx_(0) {
   if (dsns.empty()) {
     throw ClusterError("Cannot create a cluster from an empty DSN list");
@@ -97,7 +99,7 @@ ClusterImpl::ClusterImpl(DsnList dsns, clients::dns::Resolver* resolver,
         cluster_settings.init_mode, cluster_settings.pool_settings,
         cluster_settings.conn_settings,
         cluster_settings.statement_metrics_settings, default_cmd_ctls_,
-        testsuite_pg_ctl, ei_settings));
+        testsuite_pg_ctl, ei_settings, statements_registry_));
   }
   LOG_DEBUG() << "Pools initialized";
 }
@@ -283,6 +285,7 @@ void ClusterImpl::SetQueriesCommandControl(
 }
 
 void ClusterImpl::SetConnectionSettings(const ConnectionSettings& settings) {
+  statements_registry_->SetMaxSize(settings.max_prepared_cache_size);
   for (const auto& pool : host_pools_) {
     pool->SetConnectionSettings(settings);
   }
@@ -11,6 +11,7 @@
 
 #include <storages/postgres/detail/pg_impl_types.hpp>
 #include <storages/postgres/detail/pool.hpp>
+#include <storages/postgres/detail/prepared_statements_registry.hpp>
 #include <storages/postgres/detail/statement_timings_storage.hpp>
 #include <storages/postgres/detail/topology/base.hpp>
 #include <userver/storages/postgres/cluster_types.hpp>
@@ -69,6 +70,7 @@ class ClusterImpl {
   DefaultCommandControls default_cmd_ctls_;
   std::unique_ptr<topology::TopologyBase> topology_;
   engine::TaskProcessor& bg_task_processor_;
+  std::shared_ptr<PreparedStatementsRegistry> statements_registry_;
   std::vector<ConnectionPoolPtr> host_pools_;
   std::atomic<uint32_t> rr_host_idx_;
 };
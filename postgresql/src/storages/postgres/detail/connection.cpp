@@ -21,13 +21,14 @@ std::unique_ptr<Connection> Connection::Connect(
     engine::TaskProcessor& bg_task_processor, uint32_t id,
     ConnectionSettings settings, const DefaultCommandControls& default_cmd_ctls,
     const testsuite::PostgresControl& testsuite_pg_ctl,
-    const error_injection::Settings& ei_settings, SizeGuard&& size_guard) {
+    const error_injection::Settings& ei_settings, SizeGuard&& size_guard,
+    std::shared_ptr<PreparedStatementsRegistry> statements_registry) {
   std::unique_ptr<Connection> conn(new Connection());
 
   const auto deadline = engine::Deadline::FromDuration(kConnectTimeout);
   conn->pimpl_ = std::make_unique<ConnectionImpl>(
       bg_task_processor, id, settings, default_cmd_ctls, testsuite_pg_ctl,
-      ei_settings, std::move(size_guard));
+      ei_settings, std::move(size_guard), std::move(statements_registry));
   if (resolver) {
     try {
       conn->pimpl_->AsyncConnect(ResolveDsnHostaddrs(dsn, *resolver, deadline),
@@ -128,6 +129,23 @@ ResultSet Connection::PortalExecute(StatementId statement_id,
                                std::move(statement_cmd_ctl));
 }
 
+std::vector<ResultSet> Connection::ExecuteBatch(
+    const QueryBatch& batch, OptionalCommandControl statement_cmd_ctl) {
+  return pimpl_->ExecuteBatch(batch, std::move(statement_cmd_ctl));
+}
+
+std::size_t Connection::CopyIn(const Query& query,
+                               const CopyInProducer& producer,
+                               OptionalCommandControl statement_cmd_ctl) {
+  return pimpl_->CopyIn(query, producer, std::move(statement_cmd_ctl));
+}
+
+std::size_t Connection::CopyOut(const Query& query,
+                                const CopyOutConsumer& consumer,
+                                OptionalCommandControl statement_cmd_ctl) {
+  return pimpl_->CopyOut(query, consumer, std::move(statement_cmd_ctl));
+}
+
 void Connection::CancelAndCleanup(TimeoutDuration timeout) {
   pimpl_->CancelAndCleanup(timeout);
 }
@@ -2,7 +2,9 @@
 
 #include <atomic>
 #include <chrono>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
@@ -12,11 +14,13 @@
 #include <userver/utils/strong_typedef.hpp>
 #include <utils/size_guard.hpp>
 
+#include <userver/storages/postgres/detail/copy_binary.hpp>
 #include <userver/storages/postgres/detail/query_parameters.hpp>
 #include <userver/storages/postgres/detail/time_types.hpp>
 #include <userver/storages/postgres/dsn.hpp>
 #include <userver/storages/postgres/options.hpp>
 #include <userver/storages/postgres/parameter_store.hpp>
+#include <userver/storages/postgres/query_batch.hpp>
 #include <userver/storages/postgres/result_set.hpp>
 #include <userver/storages/postgres/transaction.hpp>
 
@@ -35,6 +39,7 @@ enum class ConnectionState {
 namespace detail {
 
 class ConnectionImpl;
+class PreparedStatementsRegistry;
 
 /// @brief PostreSQL connection class
 /// Handles connecting to Postgres, sending commands, processing command results
@@ -77,6 +82,14 @@ class Connection {
     SmallCounter out_of_trx : 1;
     /// Number of parsed queries
     Counter parse_total{0};
+    /// Number of executions of the statements already prepared on the
+    /// connection
+    Counter prepared_cache_hit_total{0};
+    /// Number of statements prepared with a result description shared by
+    /// other connections of the cluster
+    Counter shared_description_total{0};
+    /// Number of statements prepared eagerly while connecting
+    Counter prepared_on_connect_total{0};
     /// Number of query executions (calls to `Execute`)
     Counter execute_total{0};
     /// Total number of replies
@@ -127,6 +140,8 @@ class Connection {
   /// @param testsuite_pg_ctl operation parameters customizer for testsuite
   /// @param ei_settings error injection settings
   /// @param size_guard structure to track the size of owning connection pool
+  /// @param statements_registry registry of the statements shared by the
+  ///        connections of a cluster, may be null
   /// @throws ConnectionFailed, ConnectionTimeoutError
   // clang-format on
   static std::unique_ptr<Connection> Connect(
@@ -136,7 +151,8 @@ class Connection {
       const DefaultCommandControls& default_cmd_ctls,
       const testsuite::PostgresControl& testsuite_pg_ctl,
       const error_injection::Settings& ei_settings,
-      SizeGuard&& size_guard = SizeGuard{});
+      SizeGuard&& size_guard = SizeGuard{},
+      std::shared_ptr<PreparedStatementsRegistry> statements_registry = {});
 
   /// Close the connection
   /// TODO When called from another thread/coroutine will wait for current
@@ -225,6 +241,26 @@ class Connection {
   ResultSet PortalExecute(StatementId, const std::string& portal_name,
                           std::uint32_t n_rows, OptionalCommandControl);
 
+  /// Send all the statements of the batch in pipeline mode and wait for their
+  /// results in a single roundtrip. Returns a result set per statement.
+  /// Throws the error of the first failed statement, the statements after it
+  /// are not executed.
+  std::vector<ResultSet> ExecuteBatch(
+      const QueryBatch& batch, OptionalCommandControl statement_cmd_ctl = {});
+
+  /// Run a `COPY ... FROM STDIN (FORMAT binary)` statement streaming the data
+  /// of the producer. Returns the number of copied rows.
+  /// @throws LogicError if the statement is not a binary COPY FROM STDIN
+  std::size_t CopyIn(const Query& query, const CopyInProducer& producer,
+                     OptionalCommandControl statement_cmd_ctl = {});
+
+  /// Run a `COPY ... TO STDOUT (FORMAT binary)` statement passing every
+  /// received CopyData message to the consumer. Returns the number of copied
+  /// rows.
+  /// @throws LogicError if the statement is not a binary COPY TO STDOUT
+  std::size_t CopyOut(const Query& query, const CopyOutConsumer& consumer,
+                      OptionalCommandControl statement_cmd_ctl = {});
+
   /// Send cancel to the database backend
   /// Try to return connection to idle state discarding all results.
   /// If there is a transaction in progress - roll it back.
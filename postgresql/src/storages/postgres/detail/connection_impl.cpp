@@ -1,5 +1,7 @@
 #include <storages/postgres/detail/connection_impl.hpp>
 
+#include <algorithm>
+
 #include <boost/functional/hash.hpp>
 
 #include <userver/error_injection/hook.hpp>
@@ -32,6 +34,21 @@ std::size_t QueryHash(const std::string& statement,
   return res;
 }
 
+/// Parameter types of a statement, to prepare it without the parameters
+class StatementParamTypes {
+ public:
+  explicit StatementParamTypes(const std::vector<Oid>& types) : types_(types) {}
+
+  std::size_t Size() const { return types_.size(); }
+  const Oid* ParamTypesBuffer() const { return types_.data(); }
+  const char* const* ParamBuffers() const { return nullptr; }
+  const int* ParamLengthsBuffer() const { return nullptr; }
+  const int* ParamFormatsBuffer() const { return nullptr; }
+
+ private:
+  const std::vector<Oid>& types_;
+};
+
 class CountExecute {
  public:
   CountExecute(Connection::Statistics& stats) : stats_(stats) {
@@ -59,6 +76,33 @@ class CountExecute {
   SteadyClock::time_point exec_begin_time;
 };
 
+class CountBatchExecute {
+ public:
+  CountBatchExecute(Connection::Statistics& stats, std::size_t size)
+      : stats_(stats), size_(size) {
+    stats_.execute_total += size_;
+    exec_begin_time = SteadyClock::now();
+  }
+
+  ~CountBatchExecute() {
+    auto now = SteadyClock::now();
+    stats_.error_execute_total += size_ - completed_;
+    stats_.sum_query_duration += now - exec_begin_time;
+    stats_.last_execute_finish = now;
+  }
+
+  void AccountResult(ResultSet& result) {
+    if (result.FieldCount()) ++stats_.reply_total;
+    ++completed_;
+  }
+
+ private:
+  Connection::Statistics& stats_;
+  const std::size_t size_;
+  std::size_t completed_{0};
+  SteadyClock::time_point exec_begin_time;
+};
+
 class CountPortalBind {
  public:
   CountPortalBind(Connection::Statistics& stats) : stats_(stats) {
@@ -131,6 +175,28 @@ ORDER BY c.reltype, a.attnum)~";
 
 const std::string kPingStatement = "SELECT 1 AS ping";
 
+const std::string kBatchSizeTag = "pg_batch_size";
+const std::string kBatchStatementIndexTag = "pg_batch_statement_index";
+
+struct BatchCommand {
+  enum class Kind { kDeallocate, kPrepare, kDescribe, kExecute };
+
+  Kind kind;
+  /// Index of the batch statement the command was sent for
+  std::size_t statement_index;
+};
+
+struct BatchStatement {
+  Connection::StatementId id{};
+  /// Index of the batch statement that has prepared this statement, if it was
+  /// not prepared before the batch
+  std::optional<std::size_t> prepared_by;
+  /// Description of the prepared statement
+  ResultSet description{nullptr};
+  /// The statement is known to be prepared on the server
+  bool is_prepared{false};
+};
+
 void CheckQueryParameters(const std::string& statement,
                           const QueryParameters& params) {
   for (std::size_t i = 1; i <= params.Size(); ++i) {
@@ -149,6 +215,11 @@ void CheckQueryParameters(const std::string& statement,
 
 }  // namespace
 
+struct ConnectionImpl::BatchPlan {
+  std::vector<BatchCommand> commands;
+  std::vector<BatchStatement> statements;
+};
+
 struct ConnectionImpl::ResetTransactionCommandControl {
   ConnectionImpl& connection;
 
@@ -165,10 +236,12 @@ ConnectionImpl::ConnectionImpl(
     ConnectionSettings settings, const DefaultCommandControls& default_cmd_ctls,
     const testsuite::PostgresControl& testsuite_pg_ctl,
     const error_injection::Settings& ei_settings,
-    Connection::SizeGuard&& size_guard)
+    Connection::SizeGuard&& size_guard,
+    std::shared_ptr<PreparedStatementsRegistry> statements_registry)
     : uuid_{USERVER_NAMESPACE::utils::generators::GenerateUuid()},
       conn_wrapper_{bg_task_processor, id, std::move(size_guard)},
       prepared_{settings.max_prepared_cache_size},
+      statements_registry_{std::move(statements_registry)},
       settings_{settings},
       default_cmd_ctls_(default_cmd_ctls),
       testsuite_pg_ctl_{testsuite_pg_ctl},
@@ -207,6 +280,7 @@ void ConnectionImpl::AsyncConnect(const Dsn& dsn, engine::Deadline deadline) {
   if (settings_.user_types == ConnectionSettings::kUserTypesEnabled) {
     LoadUserTypes(deadline);
   }
+  PrepareRegisteredStatements(deadline, scope);
 }
 
 void ConnectionImpl::Close() { conn_wrapper_.Close().Wait(); }
@@ -477,6 +551,261 @@ ResultSet ConnectionImpl::PortalExecute(
                     count_execute, span, scope, &prepared_info->description);
 }
 
+std::vector<ResultSet> ConnectionImpl::ExecuteBatch(
+    const QueryBatch& batch, OptionalCommandControl statement_cmd_ctl) {
+  if (batch.IsEmpty()) return {};
+
+  CheckBusy();
+  TimeoutDuration network_timeout = !!statement_cmd_ctl
+                                        ? statement_cmd_ctl->execute
+                                        : CurrentExecuteTimeout();
+  auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(network_timeout);
+  SetStatementTimeout(std::move(statement_cmd_ctl));
+
+#if !LIBPQ_HAS_PIPELINING
+  // Without pipelining the statements are executed one by one
+  std::vector<ResultSet> results;
+  results.reserve(batch.Size());
+  for (const auto& [query, params] : batch.GetStatements()) {
+    results.push_back(ExecuteCommand(
+        query, QueryParameters{params.GetInternalData()}, deadline));
+  }
+  return results;
+#else
+  DiscardOldPreparedStatements(deadline);
+  CheckDeadlineReached(deadline);
+  tracing::Span span{scopes::kBatch};
+  conn_wrapper_.FillSpanTags(span);
+  span.AddTag(kBatchSizeTag, batch.Size());
+  auto scope = span.CreateScopeTime();
+  CountBatchExecute count_execute(stats_, batch.Size());
+
+  // A connection that is not in pipeline mode enters it for the batch only
+  const bool is_pipeline_temporary = !IsPipelineActive();
+  if (is_pipeline_temporary) {
+    conn_wrapper_.EnterPipelineMode();
+  }
+
+  BatchPlan plan;
+  const auto interrupt_batch = [&] {
+    span.AddTag(tracing::kErrorFlag, true);
+    ForgetBatchStatements(plan);
+    if (is_pipeline_temporary && IsPipelineActive()) {
+      // The results of the batch are still pending, there is no way to leave
+      // the pipeline mode without reading them
+      LOG_LIMITED_WARNING() << "Batch execution was interrupted, closing "
+                               "the connection";
+      Close();
+    }
+  };
+
+  std::vector<PGConnectionWrapper::ResultHandle> handles;
+  try {
+    plan = SendBatch(batch, scope);
+    handles = conn_wrapper_.WaitPipelineResults(deadline, scope);
+    if (is_pipeline_temporary) {
+      conn_wrapper_.ExitPipelineMode();
+    }
+  } catch (const ConnectionTimeoutError& e) {
+    ++stats_.execute_timeout;
+    LOG_LIMITED_WARNING() << "Batch of " << batch.Size()
+                          << " statements network timeout error: " << e
+                          << ". Network timeout was "
+                          << network_timeout.count() << "ms";
+    interrupt_batch();
+    throw;
+  } catch (const std::exception&) {
+    interrupt_batch();
+    throw;
+  }
+
+  const auto& commands = plan.commands;
+  if (handles.size() < commands.size()) {
+    LOG_LIMITED_ERROR() << "Got " << handles.size() << " results for "
+                        << commands.size() << " pipelined commands";
+    span.AddTag(tracing::kErrorFlag, true);
+    ForgetBatchStatements(plan);
+    throw ConnectionError{"Pipeline results don't match the sent commands"};
+  }
+  // In pipeline mode the results of previously sent commands come first
+  const auto offset = handles.size() - commands.size();
+
+  std::vector<ResultSet> results;
+  results.reserve(batch.Size());
+  std::size_t pos = 0;
+  const auto fail_batch = [&] {
+    span.AddTag(tracing::kErrorFlag, true);
+    ForgetBatchStatements(plan);
+    if (pos < offset) {
+      LOG_LIMITED_WARNING() << "A command sent before the batch has failed";
+      return;
+    }
+    const auto index = commands[pos - offset].statement_index;
+    span.AddTag(kBatchStatementIndexTag, index);
+    batch.GetStatements()[index].query.FillSpanTags(span);
+    LOG_LIMITED_WARNING() << "Statement #" << index << " of the batch of "
+                          << batch.Size() << " statements has failed";
+  };
+
+  try {
+    for (; pos < offset; ++pos) {
+      conn_wrapper_.MakeResult(std::move(handles[pos]));
+    }
+    for (; pos < handles.size(); ++pos) {
+      const auto& command = commands[pos - offset];
+      auto& statement = plan.statements[command.statement_index];
+      auto res = conn_wrapper_.MakeResult(std::move(handles[pos]));
+      switch (command.kind) {
+        case BatchCommand::Kind::kDeallocate:
+          break;
+        case BatchCommand::Kind::kPrepare:
+          statement.is_prepared = true;
+          ++stats_.parse_total;
+          break;
+        case BatchCommand::Kind::kDescribe:
+          FillBufferCategories(res);
+          // Ensure we've got binary format established
+          res.GetRowDescription().CheckBinaryFormat(db_types_);
+          {
+            const auto& [query, params] =
+                batch.GetStatements()[command.statement_index];
+            ShareDescription(statement.id, query.Statement(),
+                             QueryParameters{params.GetInternalData()}, res);
+          }
+          if (auto* info = prepared_.Get(statement.id)) {
+            info->description = res;
+          }
+          statement.description = std::move(res);
+          break;
+        case BatchCommand::Kind::kExecute: {
+          const auto& description =
+              statement.prepared_by
+                  ? plan.statements[*statement.prepared_by].description
+                  : statement.description;
+          if (!description.IsEmpty()) {
+            res.SetBufferCategoriesFrom(description);
+          } else if (!res.IsEmpty()) {
+            FillBufferCategories(res);
+          }
+          count_execute.AccountResult(res);
+          results.push_back(std::move(res));
+          break;
+        }
+      }
+    }
+  } catch (const DuplicatePreparedStatement&) {
+    // The statement is known to the server, keep it in the cache
+    if (pos >= offset) {
+      plan.statements[commands[pos - offset].statement_index].is_prepared =
+          true;
+    }
+    ++stats_.duplicate_prepared_statements;
+    fail_batch();
+    throw;
+  } catch (const InvalidSqlStatementName&) {
+    LOG_LIMITED_ERROR()
+        << "Looks like your pg_bouncer is not in 'session' mode. "
+           "Please switch pg_bouncers's pooling mode to 'session'.";
+    // reset prepared cache in case they just magically vanished
+    is_discard_prepared_pending_ = true;
+    fail_batch();
+    throw;
+  } catch (const FeatureNotSupported& e) {
+    if (e.GetServerMessage().GetPrimary() == kBadCachedPlanErrorMessage) {
+      LOG_LIMITED_WARNING()
+          << "Scheduling prepared statements invalidation due to "
+             "cached plan change";
+      is_discard_prepared_pending_ = true;
+      if (statements_registry_) statements_registry_->Clear();
+    }
+    fail_batch();
+    throw;
+  } catch (const std::exception&) {
+    fail_batch();
+    throw;
+  }
+  return results;
+#endif
+}
+
+std::size_t ConnectionImpl::CopyIn(const Query& query,
+                                   const CopyInProducer& producer,
+                                   OptionalCommandControl statement_cmd_ctl) {
+  const auto deadline = StartCopy(std::move(statement_cmd_ctl));
+  const auto& statement = query.Statement();
+  auto span = MakeQuerySpan(query);
+  auto scope = span.CreateScopeTime();
+  TimeoutDuration network_timeout =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          deadline.TimeLeft());
+  CountExecute count_execute(stats_);
+  conn_wrapper_.SendQuery(statement, scope);
+
+  try {
+    conn_wrapper_.WaitCopyStart(PGRES_COPY_IN, deadline, scope);
+    scope.Reset(scopes::kCopyData);
+    CopyBuffer buffer;
+    buffer.reserve(kCopyChunkSize);
+    for (bool has_more = true; has_more;) {
+      buffer.clear();
+      try {
+        has_more = producer(buffer);
+      } catch (const std::exception& e) {
+        AbortCopyIn(e.what(), deadline, scope);
+        throw;
+      }
+      if (!buffer.empty()) {
+        conn_wrapper_.PutCopyData({buffer.data(), buffer.size()}, deadline);
+      }
+    }
+    conn_wrapper_.PutCopyEnd(nullptr, deadline);
+  } catch (const ConnectionTimeoutError&) {
+    ++stats_.execute_timeout;
+    CloseInterruptedCopy(span);
+    throw;
+  } catch (const std::exception&) {
+    CloseInterruptedCopy(span);
+    throw;
+  }
+
+  return WaitResult(statement, deadline, network_timeout, count_execute, span,
+                    scope, nullptr)
+      .RowsAffected();
+}
+
+std::size_t ConnectionImpl::CopyOut(const Query& query,
+                                    const CopyOutConsumer& consumer,
+                                    OptionalCommandControl statement_cmd_ctl) {
+  const auto deadline = StartCopy(std::move(statement_cmd_ctl));
+  const auto& statement = query.Statement();
+  auto span = MakeQuerySpan(query);
+  auto scope = span.CreateScopeTime();
+  TimeoutDuration network_timeout =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          deadline.TimeLeft());
+  CountExecute count_execute(stats_);
+  conn_wrapper_.SendQuery(statement, scope);
+
+  try {
+    conn_wrapper_.WaitCopyStart(PGRES_COPY_OUT, deadline, scope);
+    scope.Reset(scopes::kCopyData);
+    while (const auto data = conn_wrapper_.GetCopyData(deadline)) {
+      consumer(*data);
+    }
+  } catch (const ConnectionTimeoutError&) {
+    ++stats_.execute_timeout;
+    CloseInterruptedCopy(span);
+    throw;
+  } catch (const std::exception&) {
+    CloseInterruptedCopy(span);
+    throw;
+  }
+
+  return WaitResult(statement, deadline, network_timeout, count_execute, span,
+                    scope, nullptr)
+      .RowsAffected();
+}
+
 void ConnectionImpl::CancelAndCleanup(TimeoutDuration timeout) {
   auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(timeout);
 
@@ -638,7 +967,7 @@ const ConnectionImpl::PreparedStatementInfo& ConnectionImpl::PrepareStatement(
     engine::Deadline deadline, tracing::Span& span, tracing::ScopeTime& scope) {
   auto query_hash = QueryHash(statement, params);
   Connection::StatementId query_id{query_hash};
-  std::string statement_name = "q" + std::to_string(query_hash) + "_" + uuid_;
+  std::string statement_name = MakePreparedStatementName(query_hash);
 
   error_injection::Hook ei_hook(ei_settings_, deadline);
   ei_hook.PreHook<ConnectionTimeoutError, CommandError>();
@@ -646,6 +975,7 @@ const ConnectionImpl::PreparedStatementInfo& ConnectionImpl::PrepareStatement(
   auto* statement_info = prepared_.Get(query_id);
   if (statement_info) {
     LOG_TRACE() << "Query " << statement << " is already prepared.";
+    ++stats_.prepared_cache_hit_total;
     return *statement_info;
   } else {
     if (prepared_.GetSize() >= settings_.max_prepared_cache_size) {
@@ -676,18 +1006,146 @@ const ConnectionImpl::PreparedStatementInfo& ConnectionImpl::PrepareStatement(
       throw;
     }
 
-    conn_wrapper_.SendDescribePrepared(statement_name, scope);
     statement_info = prepared_.Get(query_id);
+    conn_wrapper_.SendDescribePrepared(statement_name, scope);
     auto res = conn_wrapper_.WaitResult(deadline, scope);
     FillBufferCategories(res);
     statement_info->description = res;
     // Ensure we've got binary format established
     res.GetRowDescription().CheckBinaryFormat(db_types_);
+    ShareDescription(query_id, statement, params, statement_info->description);
     ++stats_.parse_total;
     return *statement_info;
   }
 }
 
+std::string ConnectionImpl::MakePreparedStatementName(
+    std::size_t query_hash) const {
+  return "q" + std::to_string(query_hash) + "_" + uuid_;
+}
+
+bool ConnectionImpl::IsSameDescription(const ResultSet& lhs,
+                                       const ResultSet& rhs) {
+  const auto field_count = lhs.FieldCount();
+  if (field_count != rhs.FieldCount()) return false;
+  for (std::size_t i = 0; i < field_count; ++i) {
+    const auto lhs_field = lhs.pimpl_->GetFieldDescription(i);
+    const auto rhs_field = rhs.pimpl_->GetFieldDescription(i);
+    if (lhs_field.type_oid != rhs_field.type_oid ||
+        lhs_field.type_modifier != rhs_field.type_modifier ||
+        lhs_field.name != rhs_field.name) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ConnectionImpl::ShareDescription(Connection::StatementId id,
+                                      const std::string& statement,
+                                      const QueryParameters& params,
+                                      ResultSet& description) {
+  if (!statements_registry_) return;
+  if (auto shared = statements_registry_->GetDescription(id)) {
+    if (IsSameDescription(*shared, description)) {
+      ++stats_.shared_description_total;
+      description = std::move(*shared);
+      return;
+    }
+    // The schema has changed since the statement was registered
+    LOG_INFO() << "Result description of the registered statement `"
+               << statement << "` has changed";
+  }
+
+  const auto* types = params.ParamTypesBuffer();
+  statements_registry_->Register(
+      {id, statement,
+       types ? std::vector<Oid>(types, types + params.Size())
+             : std::vector<Oid>{},
+       description});
+}
+
+void ConnectionImpl::PrepareRegisteredStatements(engine::Deadline deadline,
+                                                 tracing::ScopeTime& scope) {
+  if (!statements_registry_ || settings_.prepared_statements ==
+                                   ConnectionSettings::kNoPreparedStatements) {
+    return;
+  }
+#if LIBPQ_HAS_PIPELINING
+  auto statements = statements_registry_->GetStatements();
+  // Statements used while connecting are already prepared
+  statements.erase(std::remove_if(statements.begin(), statements.end(),
+                                  [this](const auto& registered) {
+                                    return prepared_.Get(registered.id) !=
+                                           nullptr;
+                                  }),
+                   statements.end());
+  const auto cache_room =
+      settings_.max_prepared_cache_size -
+      std::min(prepared_.GetSize(), settings_.max_prepared_cache_size);
+  if (statements.size() > cache_room) {
+    statements.resize(cache_room);
+  }
+  if (statements.empty()) return;
+
+  LOG_DEBUG() << "Preparing " << statements.size()
+              << " statements registered by other connections";
+  // All the statements are prepared and described in a single roundtrip.
+  // The descriptions are requested by every connection as the schema might
+  // have changed since the statements were registered.
+  const bool is_pipeline_temporary = !IsPipelineActive();
+  if (is_pipeline_temporary) {
+    conn_wrapper_.EnterPipelineMode();
+  }
+  scope.Reset(scopes::kPrepare);
+  for (const auto& registered : statements) {
+    const auto statement_name =
+        MakePreparedStatementName(registered.id.GetUnderlying());
+    StatementParamTypes param_types{registered.param_types};
+    conn_wrapper_.SendPrepare(statement_name, registered.statement,
+                              QueryParameters{param_types}, scope);
+    conn_wrapper_.SendDescribePrepared(statement_name, scope);
+  }
+  auto handles = conn_wrapper_.WaitPipelineResults(deadline, scope);
+  if (is_pipeline_temporary) {
+    conn_wrapper_.ExitPipelineMode();
+  }
+
+  // Preparing is an optimization, a failure does not fail the connection
+  const auto count = std::min(handles.size() / 2, statements.size());
+  for (std::size_t i = 0; i < count; ++i) {
+    auto& registered = statements[i];
+    ResultSet description{nullptr};
+    try {
+      conn_wrapper_.MakeResult(std::move(handles[2 * i]));
+      description = conn_wrapper_.MakeResult(std::move(handles[2 * i + 1]));
+      FillBufferCategories(description);
+      description.GetRowDescription().CheckBinaryFormat(db_types_);
+    } catch (const ConnectionError&) {
+      throw;
+    } catch (const Error& e) {
+      // A server error (e.g. a statement timeout) aborts the rest of the
+      // pipeline, those statements will be prepared on first use
+      LOG_LIMITED_WARNING() << "Failed to prepare the registered statement `"
+                            << registered.statement << "`: " << e;
+      statements_registry_->Erase(registered.id);
+      break;
+    }
+    StatementParamTypes param_types{registered.param_types};
+    ShareDescription(registered.id, registered.statement,
+                     QueryParameters{param_types}, description);
+    prepared_.Put(registered.id,
+                  {registered.id, std::move(registered.statement),
+                   MakePreparedStatementName(registered.id.GetUnderlying()),
+                   std::move(description)});
+    ++stats_.prepared_on_connect_total;
+  }
+#else
+  // Preparing the statements one by one would slow down connecting
+  static_cast<void>(deadline);
+  static_cast<void>(scope);
+#endif
+}
+
 void ConnectionImpl::DiscardOldPreparedStatements(engine::Deadline deadline) {
   // do not try to do anything in transaction as it may already be broken
   if (is_discard_prepared_pending_ && !IsInTransaction()) {
@@ -800,6 +1258,124 @@ void ConnectionImpl::SetParameter(std::string_view name, std::string_view value,
   }
 }
 
+ConnectionImpl::BatchPlan ConnectionImpl::SendBatch(
+    const QueryBatch& batch, tracing::ScopeTime& scope) {
+  const auto& statements = batch.GetStatements();
+  BatchPlan plan;
+  plan.statements.resize(statements.size());
+  plan.commands.reserve(statements.size());
+  const bool use_prepared = settings_.prepared_statements !=
+                            ConnectionSettings::kNoPreparedStatements;
+  // Statements prepared by the batch itself, to prepare them only once
+  std::unordered_map<Connection::StatementId, std::size_t> prepared_in_batch;
+
+  try {
+    for (std::size_t i = 0; i < statements.size(); ++i) {
+      const auto& statement = statements[i].query.Statement();
+      const QueryParameters params{statements[i].params.GetInternalData()};
+      if (!use_prepared) {
+        conn_wrapper_.SendQuery(statement, params, scope);
+        plan.commands.push_back({BatchCommand::Kind::kExecute, i});
+        continue;
+      }
+      if (settings_.ignore_unused_query_params ==
+          ConnectionSettings::kCheckUnused) {
+        CheckQueryParameters(statement, params);
+      }
+
+      const auto query_hash = QueryHash(statement, params);
+      auto& sent = plan.statements[i];
+      sent.id = Connection::StatementId{query_hash};
+      const auto statement_name = MakePreparedStatementName(query_hash);
+      if (const auto* info = prepared_.Get(sent.id)) {
+        ++stats_.prepared_cache_hit_total;
+        const auto it = prepared_in_batch.find(sent.id);
+        if (it != prepared_in_batch.end()) {
+          sent.prepared_by = it->second;
+        } else {
+          sent.description = info->description;
+        }
+      } else {
+        if (prepared_.GetSize() >= settings_.max_prepared_cache_size) {
+          const auto* least_used = prepared_.GetLeastUsed();
+          UASSERT(least_used);
+          LOG_DEBUG() << "Discarding prepared statement "
+                      << least_used->statement_name;
+          conn_wrapper_.SendQuery("DEALLOCATE " + least_used->statement_name,
+                                  scope);
+          plan.commands.push_back({BatchCommand::Kind::kDeallocate, i});
+          const auto least_used_id = least_used->id;
+          prepared_in_batch.erase(least_used_id);
+          prepared_.Erase(least_used_id);
+        }
+        scope.Reset(scopes::kPrepare);
+        conn_wrapper_.SendPrepare(statement_name, statement, params, scope);
+        plan.commands.push_back({BatchCommand::Kind::kPrepare, i});
+        conn_wrapper_.SendDescribePrepared(statement_name, scope);
+        plan.commands.push_back({BatchCommand::Kind::kDescribe, i});
+        // Mark the statement prepared as soon as the send works correctly
+        prepared_.Put(sent.id,
+                      {sent.id, statement, statement_name, sent.description});
+        prepared_in_batch[sent.id] = i;
+        sent.prepared_by = i;
+      }
+      scope.Reset(scopes::kExec);
+      conn_wrapper_.SendPreparedQuery(statement_name, params, scope);
+      plan.commands.push_back({BatchCommand::Kind::kExecute, i});
+    }
+  } catch (const std::exception&) {
+    ForgetBatchStatements(plan);
+    throw;
+  }
+  return plan;
+}
+
+void ConnectionImpl::ForgetBatchStatements(const BatchPlan& plan) {
+  for (std::size_t i = 0; i < plan.statements.size(); ++i) {
+    const auto& statement = plan.statements[i];
+    if (statement.prepared_by == i && !statement.is_prepared) {
+      prepared_.Erase(statement.id);
+    }
+  }
+}
+
+engine::Deadline ConnectionImpl::StartCopy(
+    OptionalCommandControl statement_cmd_ctl) {
+  if (IsPipelineActive()) {
+    LOG_LIMITED_WARNING() << "COPY is not allowed in pipeline mode";
+    throw NotImplemented{"COPY is not supported in pipeline mode"};
+  }
+  CheckBusy();
+  TimeoutDuration network_timeout = !!statement_cmd_ctl
+                                        ? statement_cmd_ctl->execute
+                                        : CurrentExecuteTimeout();
+  auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(network_timeout);
+  SetStatementTimeout(std::move(statement_cmd_ctl));
+  CheckDeadlineReached(deadline);
+  return deadline;
+}
+
+void ConnectionImpl::AbortCopyIn(const char* reason, engine::Deadline deadline,
+                                 tracing::ScopeTime& scope) {
+  LOG_LIMITED_WARNING() << "Aborting COPY: " << reason;
+  conn_wrapper_.PutCopyEnd(reason, deadline);
+  try {
+    conn_wrapper_.WaitResult(deadline, scope);
+  } catch (const QueryCancelled&) {
+    // The server reports the COPY failure we have requested
+  }
+}
+
+void ConnectionImpl::CloseInterruptedCopy(tracing::Span& span) {
+  span.AddTag(tracing::kErrorFlag, true);
+  if (conn_wrapper_.IsInCopy()) {
+    // libpq can only leave the COPY mode by transferring all the data
+    LOG_LIMITED_WARNING() << "COPY data transfer was interrupted, closing "
+                             "the connection";
+    Close();
+  }
+}
+
 void ConnectionImpl::LoadUserTypes(engine::Deadline deadline) {
   UASSERT(settings_.user_types == ConnectionSettings::kUserTypesEnabled);
   try {
@@ -884,6 +1460,8 @@ ResultSet ConnectionImpl::WaitResult(const std::string& statement,
           << "Scheduling prepared statements invalidation due to "
              "cached plan change";
       is_discard_prepared_pending_ = true;
+      // The result descriptions known to other connections are stale too
+      if (statements_registry_) statements_registry_->Clear();
     }
     span.AddTag(tracing::kErrorFlag, true);
     throw;
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <userver/cache/lru_map.hpp>
 #include <userver/engine/deadline.hpp>
@@ -16,10 +18,12 @@
 #include <storages/postgres/default_command_controls.hpp>
 #include <storages/postgres/detail/connection.hpp>
 #include <storages/postgres/detail/pg_connection_wrapper.hpp>
+#include <storages/postgres/detail/prepared_statements_registry.hpp>
 #include <userver/storages/postgres/detail/query_parameters.hpp>
 #include <userver/storages/postgres/detail/time_types.hpp>
 #include <userver/storages/postgres/options.hpp>
 #include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/query_batch.hpp>
 #include <userver/storages/postgres/result_set.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -33,7 +37,9 @@ class ConnectionImpl {
                  const DefaultCommandControls& default_cmd_ctls,
                  const testsuite::PostgresControl& testsuite_pg_ctl,
                  const error_injection::Settings& ei_settings,
-                 Connection::SizeGuard&& size_guard);
+                 Connection::SizeGuard&& size_guard,
+                 std::shared_ptr<PreparedStatementsRegistry>
+                     statements_registry = {});
 
   void AsyncConnect(const Dsn& dsn, engine::Deadline deadline);
   void Close();
@@ -81,6 +87,15 @@ class ConnectionImpl {
                           const std::string& portal_name, std::uint32_t n_rows,
                           OptionalCommandControl statement_cmd_ctl);
 
+  std::vector<ResultSet> ExecuteBatch(const QueryBatch& batch,
+                                     OptionalCommandControl statement_cmd_ctl);
+
+  std::size_t CopyIn(const Query& query, const CopyInProducer& producer,
+                     OptionalCommandControl statement_cmd_ctl);
+
+  std::size_t CopyOut(const Query& query, const CopyOutConsumer& consumer,
+                      OptionalCommandControl statement_cmd_ctl);
+
   void CancelAndCleanup(TimeoutDuration timeout);
   bool Cleanup(TimeoutDuration timeout);
 
@@ -108,6 +123,7 @@ class ConnectionImpl {
       cache::LruMap<Connection::StatementId, PreparedStatementInfo>;
 
   struct ResetTransactionCommandControl;
+  struct BatchPlan;
 
   void CheckBusy() const;
   void CheckDeadlineReached(const engine::Deadline& deadline);
@@ -129,6 +145,16 @@ class ConnectionImpl {
       const std::string& statement, const detail::QueryParameters& params,
       engine::Deadline deadline, tracing::Span& span,
       tracing::ScopeTime& scope);
+  std::string MakePreparedStatementName(std::size_t query_hash) const;
+  static bool IsSameDescription(const ResultSet& lhs, const ResultSet& rhs);
+  /// Replaces the description with the equal one registered by the other
+  /// connections, registers the statement with the description otherwise
+  void ShareDescription(Connection::StatementId id,
+                        const std::string& statement,
+                        const detail::QueryParameters& params,
+                        ResultSet& description);
+  void PrepareRegisteredStatements(engine::Deadline deadline,
+                                   tracing::ScopeTime& scope);
   void DiscardOldPreparedStatements(engine::Deadline deadline);
   void DiscardPreparedStatement(const PreparedStatementInfo& info,
                                 engine::Deadline deadline);
@@ -155,6 +181,14 @@ class ConnectionImpl {
                     Connection::ParameterScope scope,
                     engine::Deadline deadline);
 
+  BatchPlan SendBatch(const QueryBatch& batch, tracing::ScopeTime& scope);
+  void ForgetBatchStatements(const BatchPlan& plan);
+
+  engine::Deadline StartCopy(OptionalCommandControl statement_cmd_ctl);
+  void AbortCopyIn(const char* reason, engine::Deadline deadline,
+                   tracing::ScopeTime& scope);
+  void CloseInterruptedCopy(tracing::Span& span);
+
   void LoadUserTypes(engine::Deadline deadline);
   void FillBufferCategories(ResultSet& res);
 
@@ -170,6 +204,7 @@ class ConnectionImpl {
   Connection::Statistics stats_;
   PGConnectionWrapper conn_wrapper_;
   PreparedStatements prepared_;
+  std::shared_ptr<PreparedStatementsRegistry> statements_registry_;
   UserTypes db_types_;
   bool is_in_recovery_ = true;
   bool is_read_only_ = true;
@@ -373,6 +373,20 @@ void PGConnectionWrapper::EnterPipelineMode() {
 #endif
 }
 
+void PGConnectionWrapper::ExitPipelineMode() {
+#if LIBPQ_HAS_PIPELINING
+  if (!PQexitPipelineMode(conn_)) {
+    PGCW_LOG_LIMITED_ERROR()
+        << "libpq failed to exit pipeline connection mode: "
+        << PQerrorMessage(conn_);
+    throw ConnectionError{"Failed to exit pipeline connection mode"};
+  }
+  PGCW_LOG_DEBUG() << "Exited pipeline mode";
+#else
+  UINVARIANT(false, "Pipeline mode is not supported");
+#endif
+}
+
 bool PGConnectionWrapper::IsSyncingPipeline() const {
   return is_syncing_pipeline_;
 }
@@ -505,6 +519,159 @@ void PGConnectionWrapper::DiscardInput(Deadline deadline) {
   } while (is_syncing_pipeline_);
 }
 
+std::vector<PGConnectionWrapper::ResultHandle>
+PGConnectionWrapper::WaitPipelineResults(Deadline deadline,
+                                         tracing::ScopeTime& scope) {
+  std::vector<ResultHandle> results;
+#if LIBPQ_HAS_PIPELINING
+  UASSERT(IsPipelineActive());
+  scope.Reset(scopes::kLibpqWaitResult);
+  Flush(deadline);
+  auto handle = MakeResultHandle(nullptr);
+  while (is_syncing_pipeline_ && PQstatus(conn_) != CONNECTION_BAD) {
+    ConsumeInput(deadline);
+    auto* pg_res = PQXgetResult(conn_);
+    if (!pg_res) {
+      // No more results of the current command
+      results.push_back(std::move(handle));
+      handle = MakeResultHandle(nullptr);
+      continue;
+    }
+    if (PQresultStatus(pg_res) == PGRES_PIPELINE_SYNC) {
+      // libpq doesn't return a null result after the sync
+      MakeResultHandle(pg_res);
+      is_syncing_pipeline_ = false;
+      break;
+    }
+    handle = MakeResultHandle(pg_res);
+  }
+  if (is_syncing_pipeline_) {
+    PGCW_LOG_LIMITED_WARNING()
+        << "Connection was lost while waiting for pipeline results";
+    // The last received result is likely to describe the failure
+    if (handle) MakeResult(std::move(handle));
+    throw ConnectionError{"Connection was lost while waiting for pipeline "
+                          "results"};
+  }
+#else
+  UINVARIANT(false, "Pipeline mode is not supported");
+#endif
+  return results;
+}
+
+void PGConnectionWrapper::WaitCopyStart(ExecStatusType copy_status,
+                                        Deadline deadline,
+                                        tracing::ScopeTime& scope) {
+  UASSERT(copy_status == PGRES_COPY_IN || copy_status == PGRES_COPY_OUT);
+  scope.Reset(scopes::kLibpqWaitResult);
+  Flush(deadline);
+  ConsumeInput(deadline);
+  auto handle = MakeResultHandle(PQXgetResult(conn_));
+  const auto status = PQresultStatus(handle.get());
+  switch (status) {
+    case PGRES_COPY_IN:
+    case PGRES_COPY_OUT:
+    case PGRES_COPY_BOTH:
+      // Leaving the COPY mode requires the data transfer, so the connection
+      // can not be reused after a misuse
+      if (status != copy_status) {
+        PGCW_LOG_LIMITED_ERROR() << "COPY statement direction mismatch";
+        CloseWithError(LogicError{
+            "COPY statement direction doesn't match the requested one"});
+      }
+      if (!PQbinaryTuples(handle.get())) {
+        PGCW_LOG_LIMITED_ERROR() << "COPY statement is not in binary format";
+        CloseWithError(LogicError{
+            "Only binary COPY format is supported, add `(FORMAT binary)` to "
+            "the COPY statement"});
+      }
+      is_in_copy_ = true;
+      return;
+    default:
+      break;
+  }
+
+  // The statement has failed or is not a COPY statement
+  ConsumeInput(deadline);
+  while (auto* pg_res = PQXgetResult(conn_)) {
+    MakeResultHandle(pg_res);
+    ConsumeInput(deadline);
+  }
+  MakeResult(std::move(handle));
+  throw LogicError{"Statement is not a COPY statement"};
+}
+
+void PGConnectionWrapper::PutCopyData(std::string_view data,
+                                      Deadline deadline) {
+  UASSERT(is_in_copy_);
+  while (true) {
+    const auto res = PQputCopyData(conn_, data.data(), data.size());
+    if (res > 0) break;
+    if (res < 0) {
+      auto* msg = PQerrorMessage(conn_);
+      PGCW_LOG_WARNING() << "libpq PQputCopyData error: " << msg;
+      throw CommandError(std::string{"PQputCopyData execution error: "} + msg);
+    }
+    // libpq output buffer is full, wait for it to drain
+    Flush(deadline);
+  }
+  // Backpressure: do not produce more data until the server accepts this one
+  Flush(deadline);
+}
+
+void PGConnectionWrapper::PutCopyEnd(const char* error_message,
+                                     Deadline deadline) {
+  UASSERT(is_in_copy_);
+  while (true) {
+    const auto res = PQputCopyEnd(conn_, error_message);
+    if (res > 0) break;
+    if (res < 0) {
+      auto* msg = PQerrorMessage(conn_);
+      PGCW_LOG_WARNING() << "libpq PQputCopyEnd error: " << msg;
+      throw CommandError(std::string{"PQputCopyEnd execution error: "} + msg);
+    }
+    Flush(deadline);
+  }
+  is_in_copy_ = false;
+}
+
+std::optional<std::string_view> PGConnectionWrapper::GetCopyData(
+    Deadline deadline) {
+  UASSERT(is_in_copy_);
+  copy_data_.reset();
+  while (true) {
+    char* buffer = nullptr;
+    const auto res = PQgetCopyData(conn_, &buffer, /*async=*/1);
+    if (res > 0) {
+      copy_data_.reset(buffer);
+      return std::string_view{buffer, static_cast<std::size_t>(res)};
+    }
+    if (res == -1) {
+      is_in_copy_ = false;
+      return std::nullopt;
+    }
+    if (res < 0) {
+      auto* msg = PQerrorMessage(conn_);
+      PGCW_LOG_WARNING() << "libpq PQgetCopyData error: " << msg;
+      throw CommandError(std::string{"PQgetCopyData execution error: "} + msg);
+    }
+    // A complete row is not available yet
+    if (!WaitSocketReadable(deadline)) {
+      if (engine::current_task::ShouldCancel()) {
+        throw ConnectionInterrupted("Task cancelled while receiving COPY data");
+      }
+      PGCW_LOG_LIMITED_WARNING()
+          << "Timeout while receiving COPY data from PostgreSQL connection "
+             "socket";
+      throw ConnectionTimeoutError("Timed out while receiving COPY data");
+    }
+    CheckError<CommandError>("PQconsumeInput", PQconsumeInput(conn_));
+    UpdateLastUse();
+  }
+}
+
+bool PGConnectionWrapper::IsInCopy() const { return is_in_copy_; }
+
 void PGConnectionWrapper::FillSpanTags(tracing::Span& span) const {
   span.AddTags(log_extra_, USERVER_NAMESPACE::utils::InternalTag{});
 }
@@ -535,9 +702,10 @@ ResultSet PGConnectionWrapper::MakeResult(ResultHandle&& handle) {
     case PGRES_COPY_OUT:
     case PGRES_COPY_BOTH:
       PGCW_LOG_LIMITED_ERROR()
-          << "PostgreSQL COPY command invoked which is not implemented"
+          << "PostgreSQL COPY command invoked outside of CopyIn/CopyOut"
           << logging::LogExtra::Stacktrace();
-      CloseWithError(NotImplemented{"Copy is not implemented"});
+      CloseWithError(NotImplemented{
+          "COPY is supported only via Transaction::CopyIn/CopyOut"});
     case PGRES_BAD_RESPONSE:
       CloseWithError(ConnectionError{"Failed to parse server response"});
     case PGRES_NONFATAL_ERROR: {
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <chrono>
+#include <memory>
+#include <optional>
 #include <string_view>
+#include <vector>
 
 #include <libpq-fe.h>
 
@@ -57,6 +60,11 @@ class PGConnectionWrapper {
   /// Requires libpq >= 14.
   void EnterPipelineMode();
 
+  /// @brief Causes a connection to exit pipeline mode.
+  ///
+  /// Requires all the results of the sent commands to be received.
+  void ExitPipelineMode();
+
   /// @brief Returns true if command send queue is empty.
   ///
   /// Normally command queue is flushed after any Send* call, but in pipeline
@@ -103,6 +111,38 @@ class PGConnectionWrapper {
   /// Will return result or throw an exception
   ResultSet WaitResult(Deadline deadline, tracing::ScopeTime&);
 
+  /// @brief Sync the pipeline and wait for the results of all the commands
+  /// sent since the previous sync.
+  /// Returns the last result of every command in the order they were sent,
+  /// the commands skipped after a failure have PGRES_PIPELINE_ABORTED status.
+  /// Results are not checked for errors, see MakeResult.
+  std::vector<ResultHandle> WaitPipelineResults(Deadline deadline,
+                                                tracing::ScopeTime&);
+
+  /// @brief Wait for the server to enter the COPY mode after a COPY statement
+  /// was sent. Throws the server error if the statement has failed.
+  /// @param copy_status PGRES_COPY_IN or PGRES_COPY_OUT
+  void WaitCopyStart(ExecStatusType copy_status, Deadline deadline,
+                     tracing::ScopeTime&);
+
+  /// @brief Wrapper for PQputCopyData
+  /// Waits for the data to be flushed to the socket
+  void PutCopyData(std::string_view data, Deadline deadline);
+
+  /// @brief Wrapper for PQputCopyEnd
+  /// The result of the COPY statement should be received with WaitResult
+  /// @param error_message if not null, the server fails the COPY with it
+  void PutCopyEnd(const char* error_message, Deadline deadline);
+
+  /// @brief Wrapper for PQgetCopyData
+  /// Returns a CopyData message payload or std::nullopt after the last one.
+  /// The data is valid until the next call. The result of the COPY statement
+  /// should be received with WaitResult after the last message.
+  std::optional<std::string_view> GetCopyData(Deadline deadline);
+
+  /// Check if the connection is in the middle of COPY data transfer
+  bool IsInCopy() const;
+
   /// Consume input from connection
   void ConsumeInput(Deadline deadline);
   /// Consume all input discarding all result sets
@@ -112,6 +152,10 @@ class PGConnectionWrapper {
   /// If the connection still busy, return false
   bool TryConsumeInput(Deadline deadline);
 
+  /// @brief Check the status of a result and make a result set of it
+  /// Throws the server error if the result is an error
+  ResultSet MakeResult(ResultHandle&& handle);
+
   /// @brief Fills current span with connection info
   void FillSpanTags(tracing::Span&) const;
 
@@ -141,8 +185,6 @@ class PGConnectionWrapper {
 
   void Flush(Deadline deadline);
 
-  ResultSet MakeResult(ResultHandle&& handle);
-
   template <typename ExceptionType>
   void CheckError(const std::string& cmd, int pg_dispatch_result);
 
@@ -155,11 +197,13 @@ class PGConnectionWrapper {
 
   PGconn* conn_{nullptr};
   engine::io::Socket socket_;
+  std::unique_ptr<char, decltype(&PQfreemem)> copy_data_{nullptr, &PQfreemem};
   logging::LogExtra log_extra_;
   SizeGuard size_guard_;
   std::chrono::steady_clock::time_point last_use_;
   bool is_broken_{false};
   bool is_syncing_pipeline_{false};
+  bool is_in_copy_{false};
 };
 
 }  // namespace storages::postgres::detail
@@ -66,7 +66,8 @@ ConnectionPool::ConnectionPool(
     const StatementMetricsSettings& statement_metrics_settings,
     const DefaultCommandControls& default_cmd_ctls,
     const testsuite::PostgresControl& testsuite_pg_ctl,
-    error_injection::Settings ei_settings)
+    error_injection::Settings ei_settings,
+    std::shared_ptr<PreparedStatementsRegistry> statements_registry)
     : dsn_{std::move(dsn)},
       resolver_{resolver},
       db_name_{db_name},
@@ -84,7 +85,8 @@ ConnectionPool::ConnectionPool(
       ei_settings_(std::move(ei_settings)),
       cancel_limit_{std::max(std::size_t{1}, settings.max_size / kCancelRatio),
                     {1, kCancelPeriod}},
-      sts_{statement_metrics_settings} {}
+      sts_{statement_metrics_settings},
+      statements_registry_{std::move(statements_registry)} {}
 
 ConnectionPool::~ConnectionPool() {
   StopMaintainTask();
@@ -99,13 +101,15 @@ std::shared_ptr<ConnectionPool> ConnectionPool::Create(
     const StatementMetricsSettings& statement_metrics_settings,
     const DefaultCommandControls& default_cmd_ctls,
     const testsuite::PostgresControl& testsuite_pg_ctl,
-    error_injection::Settings ei_settings) {
+    error_injection::Settings ei_settings,
+    std::shared_ptr<PreparedStatementsRegistry> statements_registry) {
   // FP?: pointer magic in boost.lockfree
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
   auto impl = std::make_shared<ConnectionPool>(
       EmplaceEnabler{}, std::move(dsn), resolver, bg_task_processor, db_name,
       pool_settings, conn_settings, statement_metrics_settings,
-      default_cmd_ctls, testsuite_pg_ctl, std::move(ei_settings));
+      default_cmd_ctls, testsuite_pg_ctl, std::move(ei_settings),
+      std::move(statements_registry));
   // Init() uses shared_from_this for connections and cannot be called from ctor
   impl->Init(init_mode);
   return impl;
@@ -169,6 +173,12 @@ void ConnectionPool::AccountConnectionStats(Connection::Statistics conn_stats) {
   stats_.transaction.rollback_total += conn_stats.rollback_total;
   stats_.transaction.out_of_trx_total += conn_stats.out_of_trx;
   stats_.transaction.parse_total += conn_stats.parse_total;
+  stats_.transaction.prepared_cache_hit_total +=
+      conn_stats.prepared_cache_hit_total;
+  stats_.transaction.shared_description_total +=
+      conn_stats.shared_description_total;
+  stats_.transaction.prepared_on_connect_total +=
+      conn_stats.prepared_on_connect_total;
   stats_.transaction.execute_total += conn_stats.execute_total;
   stats_.transaction.reply_total += conn_stats.reply_total;
   stats_.transaction.portal_bind_total += conn_stats.portal_bind_total;
@@ -361,7 +371,8 @@ engine::TaskWithResult<bool> ConnectionPool::Connect(
           shared_this->dsn_, shared_this->resolver_,
           shared_this->bg_task_processor_, conn_id, *conn_settings,
           shared_this->default_cmd_ctls_, shared_this->testsuite_pg_ctl_,
-          shared_this->ei_settings_, std::move(sg));
+          shared_this->ei_settings_, std::move(sg),
+          shared_this->statements_registry_);
     } catch (const ConnectionTimeoutError&) {
       // No problem if it's connection error
       ++shared_this->stats_.connection.error_timeout;
@@ -44,7 +44,9 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
                  const StatementMetricsSettings& statement_metrics_settings,
                  const DefaultCommandControls& default_cmd_ctls,
                  const testsuite::PostgresControl& testsuite_pg_ctl,
-                 error_injection::Settings ei_settings);
+                 error_injection::Settings ei_settings,
+                 std::shared_ptr<PreparedStatementsRegistry>
+                     statements_registry);
 
   ~ConnectionPool();
 
@@ -56,7 +58,8 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
       const StatementMetricsSettings& statement_metrics_settings,
       const DefaultCommandControls& default_cmd_ctls,
       const testsuite::PostgresControl& testsuite_pg_ctl,
-      error_injection::Settings ei_settings);
+      error_injection::Settings ei_settings,
+      std::shared_ptr<PreparedStatementsRegistry> statements_registry = {});
 
   [[nodiscard]] ConnectionPtr Acquire(engine::Deadline);
   void Release(Connection* connection);
@@ -137,6 +140,7 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   RecentCounter recent_conn_errors_;
   USERVER_NAMESPACE::utils::TokenBucket cancel_limit_;
   detail::StatementTimingsStorage sts_;
+  std::shared_ptr<PreparedStatementsRegistry> statements_registry_;
 };
 
 }  // namespace storages::postgres::detail
@@ -0,0 +1,65 @@
+#include <storages/postgres/detail/prepared_statements_registry.hpp>
+
+#include <algorithm>
+#include <utility>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+namespace {
+
+// Zero cache size is reported by the connections as InvalidConfig
+std::size_t ValidMaxSize(std::size_t max_size) {
+  return std::max<std::size_t>(max_size, 1);
+}
+
+}  // namespace
+
+PreparedStatementsRegistry::PreparedStatementsRegistry(std::size_t max_size)
+    : statements_{ValidMaxSize(max_size)} {}
+
+std::optional<ResultSet> PreparedStatementsRegistry::GetDescription(
+    Connection::StatementId id) {
+  auto statements = statements_.UniqueLock();
+  const auto* statement = statements->Get(id);
+  if (!statement) return std::nullopt;
+  return statement->description;
+}
+
+void PreparedStatementsRegistry::Register(Statement statement) {
+  auto statements = statements_.UniqueLock();
+  const auto id = statement.id;
+  statements->Put(id, std::move(statement));
+}
+
+void PreparedStatementsRegistry::Erase(Connection::StatementId id) {
+  auto statements = statements_.UniqueLock();
+  statements->Erase(id);
+}
+
+void PreparedStatementsRegistry::Clear() {
+  auto statements = statements_.UniqueLock();
+  statements->Clear();
+}
+
+std::vector<PreparedStatementsRegistry::Statement>
+PreparedStatementsRegistry::GetStatements() const {
+  const auto statements = statements_.UniqueLock();
+  std::vector<Statement> result;
+  result.reserve(statements->GetSize());
+  statements->VisitAll(
+      [&result](const Connection::StatementId&, const Statement& statement) {
+        result.push_back(statement);
+      });
+  return result;
+}
+
+void PreparedStatementsRegistry::SetMaxSize(std::size_t max_size) {
+  auto statements = statements_.UniqueLock();
+  statements->SetMaxSize(ValidMaxSize(max_size));
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/engine/mutex.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/io/pg_types.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// @brief Cluster-wide registry of the recently prepared statements.
+///
+/// Connections register the statements they prepare, so that the statements
+/// are prepared eagerly by new connections and the result descriptions are
+/// not requested from the server by every connection.
+class PreparedStatementsRegistry final {
+ public:
+  struct Statement {
+    Connection::StatementId id{};
+    std::string statement;
+    std::vector<Oid> param_types;
+    /// Result description with the buffer categories filled, immutable
+    ResultSet description{nullptr};
+  };
+
+  explicit PreparedStatementsRegistry(std::size_t max_size);
+
+  /// Returns the description of a registered statement and marks the
+  /// statement as recently used
+  std::optional<ResultSet> GetDescription(Connection::StatementId id);
+
+  void Register(Statement statement);
+  void Erase(Connection::StatementId id);
+  void Clear();
+
+  /// Returns a snapshot of all the registered statements
+  std::vector<Statement> GetStatements() const;
+
+  void SetMaxSize(std::size_t max_size);
+
+ private:
+  using Statements =
+      USERVER_NAMESPACE::cache::LruMap<Connection::StatementId, Statement>;
+
+  USERVER_NAMESPACE::concurrent::Variable<Statements, engine::Mutex>
+      statements_;
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
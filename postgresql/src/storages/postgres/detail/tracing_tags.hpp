@@ -14,12 +14,16 @@ const std::string kConnect = "pg_connect";
 const std::string kGetConnectData = "pg_get_conn_data";
 /// Execute query, top driver level
 const std::string kQuery = "pg_query";
+/// Execute a batch of queries in a single roundtrip, top driver level
+const std::string kBatch = "pg_batch";
 /// Prepare query, driver level
 const std::string kPrepare = "pg_prepare";
 /// Bind portal, driver level
 const std::string kBind = "pg_bind";
 /// Execute query, driver level
 const std::string kExec = "pg_exec";
+/// Transfer COPY data, driver level
+const std::string kCopyData = "pg_copy_data";
 
 // libpq stages
 /// libpq async connect stage
@@ -0,0 +1,122 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/query_batch.hpp>
+#include <userver/storages/postgres/transaction.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+const std::string kCreateTable = R"~(
+create temporary table batch_test(
+  id integer primary key,
+  name text not null
+))~";
+
+pg::QueryBatch MakeSelectBatch() {
+  pg::QueryBatch batch;
+  batch.Add("select $1::integer", 1)
+      .Add("select $1::text, $2::integer", std::string{"two"}, 2)
+      .Add("select $1::integer", 3)
+      .Add("select generate_series(1, $1)", 4);
+  return batch;
+}
+
+void CheckSelectBatchResults(const std::vector<pg::ResultSet>& results) {
+  ASSERT_EQ(results.size(), 4);
+  EXPECT_EQ(1, results[0].AsSingleRow<int>());
+  using TextInt = std::tuple<std::string, int>;
+  EXPECT_EQ(TextInt("two", 2),
+            results[1].AsSingleRow<TextInt>(pg::kRowTag));
+  EXPECT_EQ(3, results[2].AsSingleRow<int>());
+  EXPECT_EQ(4, results[3].Size());
+}
+
+UTEST_P(PostgreConnection, ExecuteBatch) {
+  CheckConnection(GetConn());
+
+  // Outside of a transaction
+  CheckSelectBatchResults(GetConn()->ExecuteBatch(MakeSelectBatch()));
+  // Prepared statements are already cached
+  CheckSelectBatchResults(GetConn()->ExecuteBatch(MakeSelectBatch()));
+  EXPECT_TRUE(GetConn()->ExecuteBatch(pg::QueryBatch{}).empty());
+  EXPECT_FALSE(GetConn()->IsInTransaction());
+  EXPECT_EQ(1, GetConn()->Execute("select 1").AsSingleRow<int>());
+}
+
+UTEST_P(PostgreConnection, ExecuteBatchInTransaction) {
+  CheckConnection(GetConn());
+  GetConn()->Execute(kCreateTable);
+
+  pg::Transaction trx(std::move(GetConn()), pg::TransactionOptions{});
+  pg::QueryBatch batch;
+  batch.Add("insert into batch_test(id, name) values($1, $2)", 1,
+            std::string{"one"})
+      .Add("insert into batch_test(id, name) values($1, $2)", 2,
+           std::string{"two"})
+      .Add("select count(*) from batch_test");
+  auto results = trx.ExecuteBatch(batch);
+  ASSERT_EQ(results.size(), 3);
+  EXPECT_EQ(1, results[0].RowsAffected());
+  EXPECT_EQ(1, results[1].RowsAffected());
+  EXPECT_EQ(2, results[2].AsSingleRow<pg::Bigint>());
+
+  CheckSelectBatchResults(trx.ExecuteBatch(MakeSelectBatch()));
+  trx.Commit();
+}
+
+UTEST_P(PostgreConnection, ExecuteBatchErrors) {
+  CheckConnection(GetConn());
+  GetConn()->Execute(kCreateTable);
+
+  // The statement after the failed one is not executed
+  pg::QueryBatch batch;
+  batch.Add("insert into batch_test(id, name) values($1, $2)", 1,
+            std::string{"one"})
+      .Add("select 1 / $1", 0)
+      .Add("insert into batch_test(id, name) values($1, $2)", 2,
+           std::string{"two"});
+  {
+    pg::Transaction trx(std::move(GetConn()), pg::TransactionOptions{});
+    UEXPECT_THROW(trx.ExecuteBatch(batch), pg::DataException);
+    UEXPECT_NO_THROW(trx.Rollback());
+  }
+}
+
+UTEST_P(PostgreConnection, ExecuteBatchRecovers) {
+  CheckConnection(GetConn());
+  GetConn()->Execute(kCreateTable);
+
+  pg::QueryBatch batch;
+  batch.Add("insert into batch_test(id, name) values($1, $2)", 1,
+            std::string{"one"})
+      .Add("insert into batch_test(id, name) values($1, $2)", 1,
+           std::string{"duplicate"})
+      .Add("insert into batch_test(id, name) values($1, $2)", 2,
+           std::string{"two"});
+  // The implicit transaction of the batch is rolled back
+  UEXPECT_THROW(GetConn()->ExecuteBatch(batch), pg::UniqueViolation);
+  EXPECT_FALSE(GetConn()->IsInTransaction());
+  EXPECT_EQ(0, GetConn()
+                   ->Execute("select count(*) from batch_test")
+                   .AsSingleRow<pg::Bigint>());
+
+  // A syntax error in a statement that is not prepared yet
+  pg::QueryBatch invalid;
+  invalid.Add("select $1::integer", 1).Add("selec 2");
+  UEXPECT_THROW(GetConn()->ExecuteBatch(invalid), pg::SyntaxError);
+
+  // Both the connection and the prepared statements are still usable
+  CheckSelectBatchResults(GetConn()->ExecuteBatch(MakeSelectBatch()));
+}
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <userver/storages/postgres/detail/copy_binary.hpp>
+#include <userver/storages/postgres/io/optional.hpp>
+#include <userver/storages/postgres/io/string_types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+const pg::UserTypes types;
+
+struct CopyRow {
+  pg::Integer id{};
+  std::string name;
+  std::optional<pg::Bigint> value;
+};
+
+using CopyTuple = std::tuple<pg::Integer, std::string>;
+
+std::string_view AsStringView(const pg::detail::CopyBuffer& buffer) {
+  return {buffer.data(), buffer.size()};
+}
+
+template <typename Row, typename Container>
+std::vector<Row> RoundTrip(const Container& rows) {
+  auto producer = pg::detail::MakeCopyInProducer(types, rows);
+  pg::detail::CopyBuffer buffer;
+  while (producer(buffer)) {
+  }
+
+  std::vector<Row> result;
+  auto consumer = [&result](Row&& row) { result.push_back(std::move(row)); };
+  pg::detail::CopyOutParser<Row> parser{types};
+  parser.Parse(AsStringView(buffer), consumer);
+  return result;
+}
+
+}  // namespace
+
+TEST(PostgreCopyBinary, HeaderAndTrailer) {
+  auto producer = pg::detail::MakeCopyInProducer(types, std::vector<int>{});
+  pg::detail::CopyBuffer buffer;
+  EXPECT_FALSE(producer(buffer));
+
+  const std::string_view kExpected{
+      "PGCOPY\n\377\r\n\0"
+      "\0\0\0\0"
+      "\0\0\0\0"
+      "\377\377",
+      21};
+  EXPECT_EQ(AsStringView(buffer), kExpected);
+}
+
+TEST(PostgreCopyBinary, SingleColumnRow) {
+  pg::detail::CopyBuffer buffer;
+  pg::detail::WriteCopyRow(types, buffer, pg::Integer{42});
+
+  const std::string_view kExpected{
+      "\0\1"
+      "\0\0\0\4"
+      "\0\0\0\x2a",
+      10};
+  EXPECT_EQ(AsStringView(buffer), kExpected);
+}
+
+TEST(PostgreCopyBinary, NullField) {
+  pg::detail::CopyBuffer buffer;
+  pg::detail::WriteCopyRow(types, buffer, std::optional<pg::Integer>{});
+
+  const std::string_view kExpected{"\0\1\377\377\377\377", 6};
+  EXPECT_EQ(AsStringView(buffer), kExpected);
+}
+
+TEST(PostgreCopyBinary, RoundTripAggregate) {
+  const std::vector<CopyRow> rows{{1, "one", 100}, {2, "", std::nullopt}};
+  const auto result = RoundTrip<CopyRow>(rows);
+  ASSERT_EQ(result.size(), rows.size());
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    EXPECT_EQ(result[i].id, rows[i].id);
+    EXPECT_EQ(result[i].name, rows[i].name);
+    EXPECT_EQ(result[i].value, rows[i].value);
+  }
+}
+
+TEST(PostgreCopyBinary, RoundTripTuple) {
+  const std::vector<CopyTuple> rows{{1, "one"}, {2, "two"}};
+  EXPECT_EQ(RoundTrip<CopyTuple>(rows), rows);
+}
+
+TEST(PostgreCopyBinary, ChunkedProducer) {
+  const std::string kValue(1024, 'a');
+  const std::vector<std::string> rows(pg::detail::kCopyChunkSize / 256,
+                                      kValue);
+  auto producer = pg::detail::MakeCopyInProducer(types, rows);
+
+  std::vector<std::string> result;
+  auto consumer = [&result](std::string&& row) {
+    result.push_back(std::move(row));
+  };
+  pg::detail::CopyOutParser<std::string> parser{types};
+
+  std::size_t chunks = 0;
+  pg::detail::CopyBuffer buffer;
+  for (bool has_more = true; has_more; ++chunks) {
+    buffer.clear();
+    has_more = producer(buffer);
+    parser.Parse(AsStringView(buffer), consumer);
+  }
+  EXPECT_GT(chunks, 1);
+  EXPECT_EQ(result, rows);
+}
+
+TEST(PostgreCopyBinary, InvalidData) {
+  std::vector<int> result;
+  auto consumer = [&result](int row) { result.push_back(row); };
+
+  pg::detail::CopyOutParser<int> no_signature{types};
+  EXPECT_THROW(no_signature.Parse("PGCOPY", consumer),
+               pg::InvalidBinaryBuffer);
+
+  pg::detail::CopyBuffer buffer;
+  pg::detail::WriteCopyHeader(types, buffer);
+  pg::detail::WriteCopyRow(types, buffer, CopyTuple{1, "one"});
+  pg::detail::CopyOutParser<int> wrong_row{types};
+  EXPECT_THROW(wrong_row.Parse(AsStringView(buffer), consumer),
+               pg::FieldTupleMismatch);
+  EXPECT_TRUE(result.empty());
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,170 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/io/optional.hpp>
+#include <userver/storages/postgres/transaction.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+struct CopyRow {
+  int id{};
+  std::string name;
+  std::optional<double> value;
+};
+
+const std::string kCreateTable = R"~(
+create temporary table copy_test(
+  id integer primary key,
+  name text not null,
+  value double precision
+))~";
+
+// COPY is not supported in pipeline mode, see CopyPipelineMode
+bool IsPipelineEnabled(const pg::detail::ConnectionPtr& conn) {
+  return conn->GetSettings().pipeline_mode == pg::PipelineMode::kEnabled;
+}
+
+std::vector<CopyRow> MakeRows(std::size_t count) {
+  std::vector<CopyRow> rows;
+  rows.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto id = static_cast<int>(i);
+    rows.push_back({id, "name " + std::to_string(id),
+                    i % 2 ? std::optional<double>{i * 0.5} : std::nullopt});
+  }
+  return rows;
+}
+
+UTEST_P(PostgreConnection, CopyInOut) {
+  CheckConnection(GetConn());
+  if (IsPipelineEnabled(GetConn())) return;
+  GetConn()->Execute(kCreateTable);
+
+  // Several CopyData chunks
+  const auto rows = MakeRows(10'000);
+
+  pg::Transaction trx(std::move(GetConn()), pg::TransactionOptions{});
+  EXPECT_EQ(
+      trx.CopyIn("copy copy_test (id, name, value) from stdin (format binary)",
+                 rows),
+      rows.size());
+
+  auto res = trx.Execute("select count(*) from copy_test");
+  EXPECT_EQ(rows.size(), res.Front().As<pg::Bigint>(pg::kFieldTag));
+
+  std::vector<CopyRow> copied;
+  EXPECT_EQ(trx.CopyOut<CopyRow>(
+                "copy (select id, name, value from copy_test order by id) "
+                "to stdout (format binary)",
+                [&copied](CopyRow&& row) { copied.push_back(std::move(row)); }),
+            rows.size());
+  ASSERT_EQ(copied.size(), rows.size());
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    EXPECT_EQ(copied[i].id, rows[i].id);
+    EXPECT_EQ(copied[i].name, rows[i].name);
+    EXPECT_EQ(copied[i].value, rows[i].value);
+  }
+
+  std::vector<std::string> names;
+  trx.CopyOut<std::string>(
+      "copy (select name from copy_test where id < 3 order by id) "
+      "to stdout (format binary)",
+      [&names](std::string&& name) { names.push_back(std::move(name)); });
+  EXPECT_EQ(names,
+            (std::vector<std::string>{"name 0", "name 1", "name 2"}));
+
+  trx.Commit();
+}
+
+UTEST_P(PostgreConnection, CopyInEmpty) {
+  CheckConnection(GetConn());
+  if (IsPipelineEnabled(GetConn())) return;
+  GetConn()->Execute(kCreateTable);
+
+  pg::Transaction trx(std::move(GetConn()), pg::TransactionOptions{});
+  EXPECT_EQ(trx.CopyIn("copy copy_test from stdin (format binary)",
+                       std::vector<CopyRow>{}),
+            0);
+  std::size_t count = 0;
+  EXPECT_EQ(trx.CopyOut<CopyRow>("copy copy_test to stdout (format binary)",
+                                 [&count](CopyRow&&) { ++count; }),
+            0);
+  EXPECT_EQ(count, 0);
+  trx.Commit();
+}
+
+UTEST_P(PostgreConnection, CopyErrors) {
+  CheckConnection(GetConn());
+  if (IsPipelineEnabled(GetConn())) return;
+  GetConn()->Execute(kCreateTable);
+
+  // Server error, the connection stays usable
+  UEXPECT_THROW(GetConn()->CopyIn("copy no_such_table from stdin "
+                                  "(format binary)",
+                                  pg::detail::MakeCopyInProducer(
+                                      GetConn()->GetUserTypes(),
+                                      std::vector<CopyRow>{})),
+                pg::Error);
+  EXPECT_FALSE(GetConn()->IsInTransaction());
+
+  // Not a COPY statement
+  UEXPECT_THROW(GetConn()->CopyOut("select 1", [](std::string_view) {}),
+                pg::LogicError);
+  EXPECT_FALSE(GetConn()->IsInTransaction());
+
+  // Duplicate key, the server fails the COPY
+  const auto rows = MakeRows(2);
+  const std::vector<CopyRow> duplicates{rows[0], rows[1], rows[0]};
+  UEXPECT_THROW(
+      GetConn()->CopyIn("copy copy_test from stdin (format binary)",
+                        pg::detail::MakeCopyInProducer(
+                            GetConn()->GetUserTypes(), duplicates)),
+      pg::UniqueViolation);
+  EXPECT_FALSE(GetConn()->IsInTransaction());
+
+  // Producer error, the COPY is aborted and the connection stays usable
+  UEXPECT_THROW(GetConn()->CopyIn("copy copy_test from stdin (format binary)",
+                                  [](pg::detail::CopyBuffer&) -> bool {
+                                    throw std::runtime_error{"producer"};
+                                  }),
+                std::runtime_error);
+  EXPECT_FALSE(GetConn()->IsInTransaction());
+  EXPECT_EQ(0, GetConn()
+                   ->Execute("select count(*) from copy_test")
+                   .Front()
+                   .As<pg::Bigint>(pg::kFieldTag));
+
+  // Text format is not supported
+  UEXPECT_THROW(GetConn()->CopyOut("copy copy_test to stdout",
+                                   [](std::string_view) {}),
+                pg::LogicError);
+}
+
+UTEST_P(PostgreConnection, CopyPipelineMode) {
+  CheckConnection(GetConn());
+  if (!IsPipelineEnabled(GetConn())) return;
+  GetConn()->Execute(kCreateTable);
+
+  UEXPECT_THROW(GetConn()->CopyIn("copy copy_test from stdin (format binary)",
+                                  pg::detail::MakeCopyInProducer(
+                                      GetConn()->GetUserTypes(),
+                                      std::vector<CopyRow>{})),
+                pg::NotImplemented);
+  UEXPECT_THROW(GetConn()->CopyOut("copy copy_test to stdout (format binary)",
+                                   [](std::string_view) {}),
+                pg::NotImplemented);
+  // The connection is still usable
+  UEXPECT_NO_THROW(GetConn()->Execute("select 1"));
+}
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,129 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <storages/postgres/detail/prepared_statements_registry.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+using RegistryPtr = std::shared_ptr<pg::detail::PreparedStatementsRegistry>;
+
+const std::string kSelect = "select $1::integer";
+
+bool IsRegistered(const RegistryPtr& registry, const std::string& statement) {
+  const auto statements = registry->GetStatements();
+  return std::any_of(statements.begin(), statements.end(),
+                     [&statement](const auto& registered) {
+                       return registered.statement == statement;
+                     });
+}
+
+class PostgreStatementsRegistry : public PostgreConnection {
+ protected:
+  pg::detail::ConnectionPtr MakeSharedConnection(const RegistryPtr& registry) {
+    std::unique_ptr<pg::detail::Connection> conn;
+    UEXPECT_NO_THROW(conn = pg::detail::Connection::Connect(
+                         GetDsnFromEnv(), nullptr, GetTaskProcessor(),
+                         kConnectionId, GetParam(), GetTestCmdCtls(), {}, {},
+                         {}, registry));
+    pg::detail::ConnectionPtr conn_ptr{std::move(conn)};
+    CheckConnection(conn_ptr);
+    return conn_ptr;
+  }
+};
+
+INSTANTIATE_UTEST_SUITE_P(
+    StatementsRegistrySettings, PostgreStatementsRegistry,
+    ::testing::Values<storages::postgres::ConnectionSettings>(
+        kCachePreparedStatements, kPipelineEnabled));
+
+UTEST_P(PostgreStatementsRegistry, SharedStatements) {
+  const auto registry =
+      std::make_shared<pg::detail::PreparedStatementsRegistry>(100);
+
+  auto first = MakeSharedConnection(registry);
+  [[maybe_unused]] const auto first_connect_stats = first->GetStatsAndReset();
+  EXPECT_EQ(1, first->Execute(kSelect, 1).AsSingleRow<int>());
+  auto stats = first->GetStatsAndReset();
+  EXPECT_EQ(1, stats.parse_total);
+  EXPECT_EQ(0, stats.shared_description_total);
+  EXPECT_TRUE(IsRegistered(registry, kSelect));
+
+  // The statement is prepared while connecting
+  auto second = MakeSharedConnection(registry);
+  stats = second->GetStatsAndReset();
+  EXPECT_GT(stats.prepared_on_connect_total, 0);
+  EXPECT_EQ(2, second->Execute(kSelect, 2).AsSingleRow<int>());
+  stats = second->GetStatsAndReset();
+  EXPECT_EQ(0, stats.parse_total);
+  EXPECT_EQ(1, stats.prepared_cache_hit_total);
+}
+
+UTEST_P(PostgreStatementsRegistry, SharedDescriptions) {
+  const auto registry =
+      std::make_shared<pg::detail::PreparedStatementsRegistry>(100);
+
+  auto first = MakeSharedConnection(registry);
+  auto second = MakeSharedConnection(registry);
+  [[maybe_unused]] const auto old_stats = second->GetStatsAndReset();
+
+  // The statement is not known to the second connection, the description it
+  // gets is the same and is shared with the first connection
+  EXPECT_EQ(1, first->Execute(kSelect, 1).AsSingleRow<int>());
+  EXPECT_EQ(2, second->Execute(kSelect, 2).AsSingleRow<int>());
+  const auto stats = second->GetStatsAndReset();
+  EXPECT_EQ(1, stats.parse_total);
+  EXPECT_EQ(1, stats.shared_description_total);
+}
+
+UTEST_P(PostgreStatementsRegistry, ChangedDescription) {
+  const auto registry =
+      std::make_shared<pg::detail::PreparedStatementsRegistry>(100);
+
+  auto first = MakeSharedConnection(registry);
+  first->Execute("drop table if exists registry_schema_test");
+  first->Execute("create table registry_schema_test(id integer)");
+  const std::string kSelectAll = "select * from registry_schema_test";
+  EXPECT_EQ(1, first->Execute(kSelectAll).FieldCount());
+  first->Execute("alter table registry_schema_test add column value text");
+
+  // The new connection does not trust the registered description
+  auto second = MakeSharedConnection(registry);
+  const auto stats = second->GetStatsAndReset();
+  EXPECT_EQ(0, stats.shared_description_total);
+  EXPECT_EQ(2, second->Execute(kSelectAll).FieldCount());
+
+  // The registered description is replaced with the actual one
+  auto third = MakeSharedConnection(registry);
+  EXPECT_EQ(2, third->Execute(kSelectAll).FieldCount());
+
+  second->Execute("drop table registry_schema_test");
+}
+
+UTEST_P(PostgreStatementsRegistry, InvalidStatement) {
+  const auto registry =
+      std::make_shared<pg::detail::PreparedStatementsRegistry>(100);
+
+  auto first = MakeSharedConnection(registry);
+  first->Execute("create temporary table registry_test(id integer)");
+  const std::string kSelectTemporary = "select count(*) from registry_test";
+  first->Execute(kSelectTemporary);
+  EXPECT_TRUE(IsRegistered(registry, kSelectTemporary));
+
+  // The temporary table is not visible to the other sessions, the statement
+  // fails to prepare and is forgotten
+  auto second = MakeSharedConnection(registry);
+  EXPECT_FALSE(IsRegistered(registry, kSelectTemporary));
+  UEXPECT_NO_THROW(second->Execute("select 1"));
+}
+
+}  // namespace
+
+USERVER_NAMESPACE_END
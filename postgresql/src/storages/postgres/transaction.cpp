@@ -92,6 +92,54 @@ Portal Transaction::MakePortal(const PortalName& portal_name,
                 std::move(statement_cmd_ctl)};
 }
 
+std::vector<ResultSet> Transaction::ExecuteBatch(
+    OptionalCommandControl statement_cmd_ctl, const QueryBatch& batch) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "Execute batch called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  return conn_->ExecuteBatch(batch, std::move(statement_cmd_ctl));
+}
+
+std::size_t Transaction::DoCopyIn(const Query& query,
+                                  const detail::CopyInProducer& producer,
+                                  OptionalCommandControl statement_cmd_ctl) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "Copy in called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  if (!statement_cmd_ctl) {
+    statement_cmd_ctl = conn_->GetQueryCmdCtl(query.GetName());
+  }
+
+  detail::StatementTimer timer{query, conn_};
+  const auto rows =
+      conn_->CopyIn(query, producer, std::move(statement_cmd_ctl));
+  timer.Account();
+  return rows;
+}
+
+std::size_t Transaction::DoCopyOut(const Query& query,
+                                   const detail::CopyOutConsumer& consumer,
+                                   OptionalCommandControl statement_cmd_ctl) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "Copy out called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  if (!statement_cmd_ctl) {
+    statement_cmd_ctl = conn_->GetQueryCmdCtl(query.GetName());
+  }
+
+  detail::StatementTimer timer{query, conn_};
+  const auto rows =
+      conn_->CopyOut(query, consumer, std::move(statement_cmd_ctl));
+  timer.Account();
+  return rows;
+}
+
 void Transaction::SetParameter(const std::string& param_name,
                                const std::string& value) {
   if (!conn_) {
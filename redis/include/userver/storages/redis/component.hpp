@@ -27,6 +27,7 @@ namespace storages {}
 /// Redis client
 namespace storages::redis {
 class Client;
+class NearCache;
 class SubscribeClient;
 class SubscribeClientImpl;
 }  // namespace storages::redis
@@ -51,6 +52,11 @@ namespace components {
 /// groups.[].db | name to refer to the cluster in components::Redis::GetClient() | -
 /// groups.[].sharding_strategy | one of RedisCluster, KeyShardCrc32, KeyShardTaximeterCrc32 or KeyShardGpsStorageDriver | "KeyShardTaximeterCrc32"
 /// groups.[].allow_reads_from_master | allows read requests from master instance | false
+/// groups.[].near_cache.max_size | max count of the keys cached on the client side for GET, HGET and MGET, the cache is invalidated with CLIENT TRACKING (Redis 6+, each connection gets a companion subscriber connection for the invalidations); disabled if 0 | 0
+/// groups.[].near_cache.max_value_size | longer values are not cached | 4096
+/// groups.[].near_cache.max_fields_per_key | max count of the cached HGET fields of a key | 64
+/// groups.[].near_cache.ttl | cached values are re-read after the TTL even without an invalidation | 60s
+/// groups.[].near_cache.prefixes | track only the keys with the prefixes (BCAST mode), tracks the keys read by the client if empty | []
 /// subscribe_groups | array of redis clusters to work with in subscribe mode | -
 /// subscribe_groups.[].config_name | key name in secdist with options for this cluster | -
 /// subscribe_groups.[].db | name to refer to the cluster in components::Redis::GetSubscribeClient() | -
@@ -112,6 +118,8 @@ class Redis : public LoggableComponentBase {
   std::unordered_map<std::string, std::shared_ptr<redis::Sentinel>> sentinels_;
   std::unordered_map<std::string, std::shared_ptr<storages::redis::Client>>
       clients_;
+  std::unordered_map<std::string, std::shared_ptr<storages::redis::NearCache>>
+      near_caches_;
   std::unordered_map<std::string,
                      std::shared_ptr<storages::redis::SubscribeClientImpl>>
       subscribe_clients_;
@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <optional>
 #include <string>
 #include <vector>
@@ -193,6 +194,11 @@ struct CommandControl {
   bool allow_reads_from_master = false;
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
   bool account_in_statistics = true;
+  /* Internal: the caller parses the reply with ParseReply() and accepts it
+   * as a view of the reader buffer, see Reply::GetView().
+   */
+  // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
+  bool reply_as_view = false;
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
   std::optional<size_t> force_shard_idx;
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
@@ -238,14 +244,39 @@ struct CommandsBufferingSettings {
   bool buffering_enabled{false};
   size_t commands_buffering_threshold{0};
   std::chrono::microseconds watch_command_timer_interval{0};
+  /// The buffering window follows the command rate of the connection:
+  /// commands are sent right away if even the whole
+  /// watch_command_timer_interval would not gather a batch, otherwise the
+  /// window is the time to gather commands_buffering_threshold (or 16)
+  /// commands capped by watch_command_timer_interval
+  bool adaptive_buffering{false};
+  /// Identical read commands in flight on a connection are sent once and
+  /// the reply is handed to all of them
+  bool single_flight{false};
 
   constexpr bool operator==(const CommandsBufferingSettings& o) const {
     return buffering_enabled == o.buffering_enabled &&
            commands_buffering_threshold == o.commands_buffering_threshold &&
-           watch_command_timer_interval == o.watch_command_timer_interval;
+           watch_command_timer_interval == o.watch_command_timer_interval &&
+           adaptive_buffering == o.adaptive_buffering &&
+           single_flight == o.single_flight;
   }
 };
 
+/// Server-assisted client side caching, see
+/// https://redis.io/docs/manual/client-side-caching/
+struct ClientTrackingSettings {
+  /// Key prefixes for the BCAST mode, the keys read by the connection are
+  /// tracked if empty
+  std::vector<std::string> prefixes;
+};
+
+/// Called from the ev threads with the keys invalidated by the server. An
+/// empty vector means that all the keys must be invalidated, e.g. when the
+/// tracking is (re)enabled or the connection is lost.
+using ClientTrackingCallback =
+    std::function<void(const std::vector<std::string>& keys)>;
+
 enum class ConnectionMode {
   kCommands,
   kSubscriber,
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <cassert>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <userver/logging/log_extra.hpp>
@@ -236,11 +238,75 @@ class ReplyData final {
   std::string string_;
 };
 
+/// @brief Non-owning view of a parsed reply that is still in the reader
+/// buffer, see Reply::GetView(). The strings are NUL-terminated.
+class ReplyDataView final {
+ public:
+  explicit ReplyDataView(const redisReply* reply = nullptr) : reply_(reply) {}
+
+  explicit operator bool() const {
+    return GetType() != ReplyData::Type::kNoReply;
+  }
+
+  ReplyData::Type GetType() const;
+  std::string GetTypeString() const;
+
+  bool IsString() const { return GetType() == ReplyData::Type::kString; }
+  bool IsArray() const { return GetType() == ReplyData::Type::kArray; }
+  bool IsInt() const { return GetType() == ReplyData::Type::kInteger; }
+  bool IsNil() const { return GetType() == ReplyData::Type::kNil; }
+  bool IsStatus() const { return GetType() == ReplyData::Type::kStatus; }
+  bool IsError() const { return GetType() == ReplyData::Type::kError; }
+
+  std::string_view GetString() const {
+    UASSERT(IsString());
+    return GetStringUnchecked();
+  }
+
+  std::string_view GetStatus() const {
+    UASSERT(IsStatus());
+    return GetStringUnchecked();
+  }
+
+  std::string_view GetError() const {
+    UASSERT(IsError());
+    return GetStringUnchecked();
+  }
+
+  int64_t GetInt() const;
+
+  /// Number of the array elements
+  size_t GetArraySize() const;
+
+  ReplyDataView operator[](size_t idx) const;
+
+  /// Same as ReplyData::GetSize()
+  size_t GetSize() const;
+
+  std::string ToDebugString() const;
+
+  /// Copies the reply into the owning representation
+  ReplyData ToReplyData() const { return ReplyData(reply_); }
+
+  void ExpectType(ReplyData::Type type,
+                  const std::string& request_description = {}) const;
+
+  void ExpectString(const std::string& request_description = {}) const;
+  void ExpectArray(const std::string& request_description = {}) const;
+
+ private:
+  std::string_view GetStringUnchecked() const;
+
+  const redisReply* reply_;
+};
+
 class Reply final {
  public:
   Reply(std::string cmd, redisReply* redis_reply, int status)
       : cmd(std::move(cmd)), data(redis_reply), status(status) {}
   Reply(std::string cmd, ReplyData&& data);
+  /// Reply that keeps the parsed `buffer` instead of copying it into `data`
+  Reply(std::string cmd, std::shared_ptr<const redisReply> buffer);
 
   std::string server;
   ServerId server_id;
@@ -277,6 +343,16 @@ class Reply final {
 
   const std::string& GetRequestDescription(
       const std::string& request_description) const;
+
+  /// Returns the view of the reply buffer, or an empty view if the reply
+  /// is stored in `data`
+  ReplyDataView GetView() const { return ReplyDataView(buffer_.get()); }
+
+  /// Moves the reply from the buffer into `data`, if it is not there yet
+  void ConvertViewToData();
+
+ private:
+  std::shared_ptr<const redisReply> buffer_;
 };
 
 }  // namespace redis
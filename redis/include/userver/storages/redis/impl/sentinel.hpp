@@ -114,6 +114,11 @@ class Sentinel {
   void SetCommandsBufferingSettings(
       CommandsBufferingSettings commands_buffering_settings);
 
+  /// Enables the server-assisted client side caching on all the connections
+  /// except the ones to the sentinels, see redis::Redis::EnableClientTracking
+  void EnableClientTracking(const ClientTrackingSettings& settings,
+                            const ClientTrackingCallback& callback);
+
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
   boost::signals2::signal<void(size_t shard)> signal_instances_changed;
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
@@ -6,6 +6,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include <userver/storages/redis/impl/reply.hpp>
 #include <userver/storages/redis/impl/types.hpp>
 #include <userver/utils/void_t.hpp>
 
@@ -18,6 +19,8 @@ namespace impl {
 
 ReplyData&& ExtractData(ReplyPtr& reply);
 
+ReplyDataView GetView(const ReplyPtr& reply);
+
 template <typename Result, typename ReplyType, typename = utils::void_t<>>
 struct HasParseFunctionFromRedisReply {
   static constexpr bool value = false;
@@ -122,6 +125,35 @@ std::unordered_map<std::string, std::string> Parse(
 ReplyData Parse(ReplyData&& reply_data, const std::string& request_description,
                 To<ReplyData>);
 
+/// @name Parsing straight from the reader buffer
+/// Used by ParseReply() for the replies received as a view, see
+/// Reply::GetView(). The strings are copied from the buffer once, without
+/// the intermediate ReplyData.
+/// @{
+std::string Parse(ReplyDataView reply_data,
+                  const std::string& request_description, To<std::string>);
+
+std::optional<std::string> Parse(ReplyDataView reply_data,
+                                 const std::string& request_description,
+                                 To<std::optional<std::string>>);
+
+std::vector<std::string> Parse(ReplyDataView reply_data,
+                               const std::string& request_description,
+                               To<std::vector<std::string>>);
+
+std::vector<std::optional<std::string>> Parse(
+    ReplyDataView reply_data, const std::string& request_description,
+    To<std::vector<std::optional<std::string>>>);
+
+std::vector<MemberScore> Parse(ReplyDataView reply_data,
+                               const std::string& request_description,
+                               To<std::vector<MemberScore>>);
+
+std::unordered_map<std::string, std::string> Parse(
+    ReplyDataView reply_data, const std::string& request_description,
+    To<std::unordered_map<std::string, std::string>>);
+/// @}
+
 template <typename Result, typename ReplyType = impl::DefaultReplyType<Result>>
 std::enable_if_t<impl::HasParseFunctionFromRedisReply<Result, ReplyType>::value,
                  ReplyType>
@@ -147,12 +179,35 @@ std::optional<T> Parse(ReplyData&& reply_data,
   return Parse(std::move(reply_data), request_description, To<T>{});
 }
 
+namespace impl {
+
+template <typename Result, typename ReplyType, typename = utils::void_t<>>
+struct HasParseFunctionFromReplyView {
+  static constexpr bool value = false;
+};
+
+template <typename Result, typename ReplyType>
+struct HasParseFunctionFromReplyView<
+    Result, ReplyType,
+    utils::void_t<decltype(Parse(std::declval<ReplyDataView>(),
+                                 std::declval<const std::string&>(),
+                                 To<Result, ReplyType>{}))>> {
+  static constexpr bool value = true;
+};
+
+}  // namespace impl
+
 template <typename Result, typename ReplyType = impl::DefaultReplyType<Result>>
 ReplyType ParseReply(ReplyPtr reply,
                      const std::string& request_description = {}) {
   const auto& description =
       impl::RequestDescription(reply, request_description);
   impl::ExpectIsOk(reply, description);
+  if constexpr (impl::HasParseFunctionFromReplyView<Result, ReplyType>::value) {
+    if (const auto view = impl::GetView(reply)) {
+      return Parse(view, description, To<Result, ReplyType>{});
+    }
+  }
   return Parse(impl::ExtractData(reply), description, To<Result, ReplyType>{});
 }
 
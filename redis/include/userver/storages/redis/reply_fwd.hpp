@@ -6,12 +6,14 @@ USERVER_NAMESPACE_BEGIN
 
 namespace redis {
 class ReplyData;
+class ReplyDataView;
 class Reply;
 }  // namespace redis
 
 namespace storages::redis {
 
 using ReplyData = USERVER_NAMESPACE::redis::ReplyData;
+using ReplyDataView = USERVER_NAMESPACE::redis::ReplyDataView;
 using Reply = USERVER_NAMESPACE::redis::Reply;
 
 using ReplyPtr = std::shared_ptr<Reply>;
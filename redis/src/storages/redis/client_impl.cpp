@@ -3,6 +3,7 @@
 #include <userver/storages/redis/impl/sentinel.hpp>
 #include <userver/utils/assert.hpp>
 
+#include "near_cache.hpp"
 #include "request_impl.hpp"
 #include "transaction_impl.hpp"
 
@@ -35,8 +36,11 @@ void DoCheckShard(size_t shard, std::optional<size_t> force_shard_idx) {
 
 ClientImpl::ClientImpl(
     std::shared_ptr<USERVER_NAMESPACE::redis::Sentinel> sentinel,
-    std::optional<size_t> force_shard_idx)
-    : redis_client_(std::move(sentinel)), force_shard_idx_(force_shard_idx) {}
+    std::optional<size_t> force_shard_idx,
+    std::shared_ptr<NearCache> near_cache)
+    : redis_client_(std::move(sentinel)),
+      force_shard_idx_(force_shard_idx),
+      near_cache_(std::move(near_cache)) {}
 
 void ClientImpl::WaitConnectedOnce(
     USERVER_NAMESPACE::redis::RedisWaitConnected wait_connected) {
@@ -54,7 +58,7 @@ const std::string& ClientImpl::GetAnyKeyForShard(size_t shard_idx) const {
 }
 
 std::shared_ptr<Client> ClientImpl::GetClientForShard(size_t shard_idx) {
-  return std::make_shared<ClientImpl>(redis_client_, shard_idx);
+  return std::make_shared<ClientImpl>(redis_client_, shard_idx, near_cache_);
 }
 
 std::optional<size_t> ClientImpl::GetForcedShardIdx() const {
@@ -206,9 +210,26 @@ RequestGeoradius ClientImpl::Georadius(
 RequestGet ClientImpl::Get(std::string key,
                            const CommandControl& command_control) {
   auto shard = ShardByKey(key, command_control);
-  return CreateRequest<RequestGet>(
+  auto* near_cache = GetNearCache(command_control);
+  if (!near_cache) {
+    return CreateRequest<RequestGet>(
+        MakeRequest(CmdArgs{"get", std::move(key)}, shard, false,
+                    GetViewCommandControl(command_control)));
+  }
+
+  if (auto cached = near_cache->GetValue(key)) {
+    return CreateDummyRequest<RequestGet>(
+        std::make_shared<Reply>("get", std::move(*cached)));
+  }
+  const auto generation = near_cache->GetGeneration();
+  auto store = [near_cache = near_cache_, key, generation](
+                   const ReplyData& data) {
+    near_cache->PutValue(key, data, generation);
+  };
+  return CreateCachingRequest<RequestGet>(
       MakeRequest(CmdArgs{"get", std::move(key)}, shard, false,
-                  GetCommandControl(command_control)));
+                  GetViewCommandControl(command_control)),
+      std::move(store));
 }
 
 RequestGetset ClientImpl::Getset(std::string key, std::string value,
@@ -248,9 +269,26 @@ RequestHexists ClientImpl::Hexists(std::string key, std::string field,
 RequestHget ClientImpl::Hget(std::string key, std::string field,
                              const CommandControl& command_control) {
   auto shard = ShardByKey(key, command_control);
-  return CreateRequest<RequestHget>(
+  auto* near_cache = GetNearCache(command_control);
+  if (!near_cache) {
+    return CreateRequest<RequestHget>(
+        MakeRequest(CmdArgs{"hget", std::move(key), std::move(field)}, shard,
+                    false, GetCommandControl(command_control)));
+  }
+
+  if (auto cached = near_cache->GetField(key, field)) {
+    return CreateDummyRequest<RequestHget>(
+        std::make_shared<Reply>("hget", std::move(*cached)));
+  }
+  const auto generation = near_cache->GetGeneration();
+  auto store = [near_cache = near_cache_, key, field, generation](
+                   const ReplyData& data) {
+    near_cache->PutField(key, field, data, generation);
+  };
+  return CreateCachingRequest<RequestHget>(
       MakeRequest(CmdArgs{"hget", std::move(key), std::move(field)}, shard,
-                  false, GetCommandControl(command_control)));
+                  false, GetCommandControl(command_control)),
+      std::move(store));
 }
 
 RequestHgetall ClientImpl::Hgetall(std::string key,
@@ -258,7 +296,7 @@ RequestHgetall ClientImpl::Hgetall(std::string key,
   auto shard = ShardByKey(key, command_control);
   return CreateRequest<RequestHgetall>(
       MakeRequest(CmdArgs{"hgetall", std::move(key)}, shard, false,
-                  GetCommandControl(command_control)));
+                  GetViewCommandControl(command_control)));
 }
 
 RequestHincrby ClientImpl::Hincrby(std::string key, std::string field,
@@ -284,7 +322,7 @@ RequestHkeys ClientImpl::Hkeys(std::string key,
   auto shard = ShardByKey(key, command_control);
   return CreateRequest<RequestHkeys>(
       MakeRequest(CmdArgs{"hkeys", std::move(key)}, shard, false,
-                  GetCommandControl(command_control)));
+                  GetViewCommandControl(command_control)));
 }
 
 RequestHlen ClientImpl::Hlen(std::string key,
@@ -303,7 +341,7 @@ RequestHmget ClientImpl::Hmget(std::string key, std::vector<std::string> fields,
   auto shard = ShardByKey(key, command_control);
   return CreateRequest<RequestHmget>(
       MakeRequest(CmdArgs{"hmget", std::move(key), std::move(fields)}, shard,
-                  false, GetCommandControl(command_control)));
+                  false, GetViewCommandControl(command_control)));
 }
 
 RequestHmset ClientImpl::Hmset(
@@ -349,7 +387,7 @@ RequestHvals ClientImpl::Hvals(std::string key,
   auto shard = ShardByKey(key, command_control);
   return CreateRequest<RequestHvals>(
       MakeRequest(CmdArgs{"hvals", std::move(key)}, shard, false,
-                  GetCommandControl(command_control)));
+                  GetViewCommandControl(command_control)));
 }
 
 RequestIncr ClientImpl::Incr(std::string key,
@@ -422,7 +460,7 @@ RequestLrange ClientImpl::Lrange(std::string key, int64_t start, int64_t stop,
   auto shard = ShardByKey(key, command_control);
   return CreateRequest<RequestLrange>(
       MakeRequest(CmdArgs{"lrange", std::move(key), start, stop}, shard, false,
-                  GetCommandControl(command_control)));
+                  GetViewCommandControl(command_control)));
 }
 
 RequestLrem ClientImpl::Lrem(std::string key, int64_t count,
@@ -451,9 +489,36 @@ RequestMget ClientImpl::Mget(std::vector<std::string> keys,
   const auto max_chunk_size =
       command_control.chunk_size ? command_control.chunk_size : keys.size();
   auto make_request = [this, shard,
-                       cc = GetCommandControl(command_control)](auto keys) {
+                       cc = GetViewCommandControl(command_control)](auto keys) {
     return MakeRequest(CmdArgs{"mget", std::move(keys)}, shard, false, cc);
   };
+  auto* near_cache = GetNearCache(command_control);
+  if (near_cache && max_chunk_size >= keys.size()) {
+    // Served from the cache only if all the keys are there, a partial hit
+    // still costs a roundtrip
+    ReplyData::Array cached_values;
+    cached_values.reserve(keys.size());
+    for (const auto& key : keys) {
+      auto cached = near_cache->GetValue(key);
+      if (!cached) break;
+      cached_values.push_back(std::move(*cached));
+    }
+    if (cached_values.size() == keys.size()) {
+      return CreateDummyRequest<RequestMget>(
+          std::make_shared<Reply>("mget", std::move(cached_values)));
+    }
+
+    const auto generation = near_cache->GetGeneration();
+    auto store = [near_cache = near_cache_, keys, generation](
+                     const ReplyData& data) {
+      if (!data.IsArray() || data.GetArray().size() != keys.size()) return;
+      for (size_t i = 0; i < keys.size(); ++i) {
+        near_cache->PutValue(keys[i], data.GetArray()[i], generation);
+      }
+    };
+    return CreateCachingRequest<RequestMget>(make_request(std::move(keys)),
+                                             std::move(store));
+  }
   if (max_chunk_size >= keys.size()) {
     return CreateRequest<RequestMget>(make_request(std::move(keys)));
   }
@@ -834,7 +899,7 @@ RequestZrange ClientImpl::Zrange(std::string key, int64_t start, int64_t stop,
   auto shard = ShardByKey(key, command_control);
   return CreateRequest<RequestZrange>(
       MakeRequest(CmdArgs{"zrange", std::move(key), start, stop}, shard, false,
-                  GetCommandControl(command_control)));
+                  GetViewCommandControl(command_control)));
 }
 
 RequestZrangeWithScores ClientImpl::ZrangeWithScores(
@@ -844,7 +909,7 @@ RequestZrangeWithScores ClientImpl::ZrangeWithScores(
   USERVER_NAMESPACE::redis::ScoreOptions with_scores{true};
   return CreateRequest<RequestZrangeWithScores>(
       MakeRequest(CmdArgs{"zrange", std::move(key), start, stop, with_scores},
-                  shard, false, GetCommandControl(command_control)));
+                  shard, false, GetViewCommandControl(command_control)));
 }
 
 RequestZrangebyscore ClientImpl::Zrangebyscore(
@@ -853,7 +918,7 @@ RequestZrangebyscore ClientImpl::Zrangebyscore(
   auto shard = ShardByKey(key, command_control);
   return CreateRequest<RequestZrangebyscore>(
       MakeRequest(CmdArgs{"zrangebyscore", std::move(key), min, max}, shard,
-                  false, GetCommandControl(command_control)));
+                  false, GetViewCommandControl(command_control)));
 }
 
 RequestZrangebyscore ClientImpl::Zrangebyscore(
@@ -862,7 +927,7 @@ RequestZrangebyscore ClientImpl::Zrangebyscore(
   auto shard = ShardByKey(key, command_control);
   return CreateRequest<RequestZrangebyscore>(MakeRequest(
       CmdArgs{"zrangebyscore", std::move(key), std::move(min), std::move(max)},
-      shard, false, GetCommandControl(command_control)));
+      shard, false, GetViewCommandControl(command_control)));
 }
 
 RequestZrangebyscore ClientImpl::Zrangebyscore(
@@ -873,7 +938,7 @@ RequestZrangebyscore ClientImpl::Zrangebyscore(
       {false}, range_options};
   return CreateRequest<RequestZrangebyscore>(MakeRequest(
       CmdArgs{"zrangebyscore", std::move(key), min, max, range_score_options},
-      shard, false, GetCommandControl(command_control)));
+      shard, false, GetViewCommandControl(command_control)));
 }
 
 RequestZrangebyscore ClientImpl::Zrangebyscore(
@@ -885,7 +950,7 @@ RequestZrangebyscore ClientImpl::Zrangebyscore(
   return CreateRequest<RequestZrangebyscore>(
       MakeRequest(CmdArgs{"zrangebyscore", std::move(key), std::move(min),
                           std::move(max), range_score_options},
-                  shard, false, GetCommandControl(command_control)));
+                  shard, false, GetViewCommandControl(command_control)));
 }
 
 RequestZrangebyscoreWithScores ClientImpl::ZrangebyscoreWithScores(
@@ -895,7 +960,7 @@ RequestZrangebyscoreWithScores ClientImpl::ZrangebyscoreWithScores(
   USERVER_NAMESPACE::redis::RangeScoreOptions range_score_options{{true}, {}};
   return CreateRequest<RequestZrangebyscoreWithScores>(MakeRequest(
       CmdArgs{"zrangebyscore", std::move(key), min, max, range_score_options},
-      shard, false, GetCommandControl(command_control)));
+      shard, false, GetViewCommandControl(command_control)));
 }
 
 RequestZrangebyscoreWithScores ClientImpl::ZrangebyscoreWithScores(
@@ -906,7 +971,7 @@ RequestZrangebyscoreWithScores ClientImpl::ZrangebyscoreWithScores(
   return CreateRequest<RequestZrangebyscoreWithScores>(
       MakeRequest(CmdArgs{"zrangebyscore", std::move(key), std::move(min),
                           std::move(max), range_score_options},
-                  shard, false, GetCommandControl(command_control)));
+                  shard, false, GetViewCommandControl(command_control)));
 }
 
 RequestZrangebyscoreWithScores ClientImpl::ZrangebyscoreWithScores(
@@ -917,7 +982,7 @@ RequestZrangebyscoreWithScores ClientImpl::ZrangebyscoreWithScores(
       {true}, range_options};
   return CreateRequest<RequestZrangebyscoreWithScores>(MakeRequest(
       CmdArgs{"zrangebyscore", std::move(key), min, max, range_score_options},
-      shard, false, GetCommandControl(command_control)));
+      shard, false, GetViewCommandControl(command_control)));
 }
 
 RequestZrangebyscoreWithScores ClientImpl::ZrangebyscoreWithScores(
@@ -929,7 +994,7 @@ RequestZrangebyscoreWithScores ClientImpl::ZrangebyscoreWithScores(
   return CreateRequest<RequestZrangebyscoreWithScores>(
       MakeRequest(CmdArgs{"zrangebyscore", std::move(key), std::move(min),
                           std::move(max), range_score_options},
-                  shard, false, GetCommandControl(command_control)));
+                  shard, false, GetViewCommandControl(command_control)));
 }
 
 RequestZrem ClientImpl::Zrem(std::string key, std::string member,
@@ -1006,6 +1071,13 @@ CommandControl ClientImpl::GetCommandControl(const CommandControl& cc) const {
   return redis_client_->GetCommandControl(cc);
 }
 
+CommandControl ClientImpl::GetViewCommandControl(
+    const CommandControl& cc) const {
+  auto result = GetCommandControl(cc);
+  result.reply_as_view = true;
+  return result;
+}
+
 size_t ClientImpl::GetPublishShard(PubShard policy) {
   switch (policy) {
     case PubShard::kZeroShard:
@@ -1032,6 +1104,13 @@ size_t ClientImpl::ShardByKey(const std::string& key,
   return ShardByKey(key);
 }
 
+NearCache* ClientImpl::GetNearCache(const CommandControl& cc) const {
+  // Reads from the master are requested for the read-your-writes
+  // consistency which the cache does not provide
+  if (cc.force_request_to_master) return nullptr;
+  return near_cache_.get();
+}
+
 void ClientImpl::CheckShard(size_t shard, const CommandControl& cc) const {
   DoCheckShard(shard, force_shard_idx_);
   DoCheckShard(shard, cc.force_shard_idx);
@@ -21,6 +21,7 @@ class Sentinel;
 
 namespace storages::redis {
 
+class NearCache;
 class TransactionImpl;
 
 // NOLINTNEXTLINE(fuchsia-multiple-inheritance)
@@ -29,7 +30,8 @@ class ClientImpl final : public Client,
  public:
   explicit ClientImpl(
       std::shared_ptr<USERVER_NAMESPACE::redis::Sentinel> sentinel,
-      std::optional<size_t> force_shard_idx = std::nullopt);
+      std::optional<size_t> force_shard_idx = std::nullopt,
+      std::shared_ptr<NearCache> near_cache = nullptr);
 
   void WaitConnectedOnce(
       USERVER_NAMESPACE::redis::RedisWaitConnected wait_connected) override;
@@ -430,16 +432,21 @@ class ClientImpl final : public Client,
   }
 
   CommandControl GetCommandControl(const CommandControl& cc) const;
+  // For the commands parsed from the reply buffer, see Reply::GetView()
+  CommandControl GetViewCommandControl(const CommandControl& cc) const;
 
   size_t GetPublishShard(PubShard policy);
 
   size_t ShardByKey(const std::string& key, const CommandControl& cc) const;
 
+  NearCache* GetNearCache(const CommandControl& cc) const;
+
   void CheckShard(size_t shard, const CommandControl& cc) const;
 
   std::shared_ptr<USERVER_NAMESPACE::redis::Sentinel> redis_client_;
   std::atomic<int> publish_shard_{0};
   const std::optional<size_t> force_shard_idx_;
+  const std::shared_ptr<NearCache> near_cache_;
 };
 
 }  // namespace storages::redis
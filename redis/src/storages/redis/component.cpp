@@ -4,6 +4,7 @@
 #include <vector>
 
 #include <storages/redis/impl/keyshard_impl.hpp>
+#include <storages/redis/impl/redis.hpp>
 #include <storages/redis/impl/subscribe_sentinel.hpp>
 #include <userver/components/component.hpp>
 #include <userver/components/statistics_storage.hpp>
@@ -27,6 +28,7 @@
 #include <userver/storages/redis/subscribe_client.hpp>
 
 #include "client_impl.hpp"
+#include "near_cache.hpp"
 #include "redis_secdist.hpp"
 #include "subscribe_client_impl.hpp"
 
@@ -118,6 +120,17 @@ formats::json::ValueBuilder ShardStatisticsToJson(
   return result;
 }
 
+formats::json::ValueBuilder NearCacheStatisticsToJson(
+    const storages::redis::NearCacheStatistics& stats) {
+  formats::json::ValueBuilder result(formats::json::Type::kObject);
+  result["hits"] = stats.hits;
+  result["misses"] = stats.misses;
+  result["invalidations"] = stats.invalidations;
+  result["flushes"] = stats.flushes;
+  result["size"] = stats.size;
+  return result;
+}
+
 formats::json::ValueBuilder RedisStatisticsToJson(
     const std::shared_ptr<redis::Sentinel>& redis) {
   formats::json::ValueBuilder result(formats::json::Type::kObject);
@@ -232,6 +245,7 @@ struct RedisGroup {
   std::string config_name;
   std::string sharding_strategy;
   bool allow_reads_from_master{false};
+  storages::redis::NearCacheSettings near_cache;
 };
 
 RedisGroup Parse(const yaml_config::YamlConfig& value,
@@ -242,9 +256,24 @@ RedisGroup Parse(const yaml_config::YamlConfig& value,
   config.sharding_strategy = value["sharding_strategy"].As<std::string>("");
   config.allow_reads_from_master =
       value["allow_reads_from_master"].As<bool>(false);
+  config.near_cache =
+      value["near_cache"].As<storages::redis::NearCacheSettings>({});
   return config;
 }
 
+std::shared_ptr<storages::redis::NearCache> MakeNearCache(
+    redis::Sentinel& sentinel, const RedisGroup& redis_group) {
+  if (!redis_group.near_cache.max_size) return nullptr;
+  auto near_cache =
+      std::make_shared<storages::redis::NearCache>(redis_group.near_cache);
+  sentinel.EnableClientTracking(
+      near_cache->GetTrackingSettings(),
+      [near_cache](const std::vector<std::string>& keys) {
+        near_cache->Invalidate(keys);
+      });
+  return near_cache;
+}
+
 struct SubscribeRedisGroup {
   std::string db;
   std::string config_name;
@@ -355,8 +384,10 @@ void Redis::Connect(const ComponentConfig& config,
         testsuite_redis_control);
     if (sentinel) {
       sentinels_.emplace(redis_group.db, sentinel);
-      const auto& client =
-          std::make_shared<storages::redis::ClientImpl>(sentinel);
+      auto near_cache = MakeNearCache(*sentinel, redis_group);
+      if (near_cache) near_caches_.emplace(redis_group.db, near_cache);
+      const auto& client = std::make_shared<storages::redis::ClientImpl>(
+          sentinel, std::nullopt, std::move(near_cache));
       clients_.emplace(redis_group.db, client);
     } else {
       LOG_WARNING() << "skip redis client for " << redis_group.db;
@@ -420,6 +451,11 @@ formats::json::Value Redis::ExtendStatisticsRedis(
     const auto& name = client.first;
     const auto& redis = client.second;
     json[name] = RedisStatisticsToJson(redis);
+    const auto near_cache = near_caches_.find(name);
+    if (near_cache != near_caches_.end()) {
+      json[name]["near-cache"] =
+          NearCacheStatisticsToJson(near_cache->second->GetStatistics());
+    }
   }
   utils::statistics::SolomonChildrenAreLabelValues(json, "redis_database");
   return json.ExtractValue();
@@ -507,6 +543,34 @@ properties:
                     type: boolean
                     description: allows read requests from master instance
                     defaultDescription: false
+                near_cache:
+                    type: object
+                    description: client side cache of GET, HGET and MGET invalidated with CLIENT TRACKING
+                    additionalProperties: false
+                    properties:
+                        max_size:
+                            type: integer
+                            description: max count of the cached keys, the cache is disabled if 0
+                            defaultDescription: 0
+                        max_value_size:
+                            type: integer
+                            description: longer values are not cached
+                            defaultDescription: 4096
+                        max_fields_per_key:
+                            type: integer
+                            description: max count of the cached HGET fields of a key
+                            defaultDescription: 64
+                        ttl:
+                            type: string
+                            description: cached values are re-read after the TTL even without an invalidation
+                            defaultDescription: 60s
+                        prefixes:
+                            type: array
+                            description: track only the keys with the prefixes (BCAST mode), tracks the keys read by the client if empty
+                            defaultDescription: '[]'
+                            items:
+                                type: string
+                                description: key prefix
     subscribe_groups:
         type: array
         description: array of redis clusters to work with in subscribe mode
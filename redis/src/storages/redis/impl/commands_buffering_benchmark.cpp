@@ -0,0 +1,114 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <storages/redis/impl/mock_server_test.hpp>
+#include <storages/redis/impl/redis.hpp>
+#include <userver/storages/redis/impl/command.hpp>
+#include <userver/storages/redis/impl/thread_pools.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kHotKeys = 4;
+constexpr std::chrono::microseconds kBufferingInterval{200};
+
+enum class BufferingMode { kNone, kFixed, kAdaptive };
+
+redis::CommandsBufferingSettings MakeSettings(BufferingMode mode,
+                                              bool single_flight) {
+  redis::CommandsBufferingSettings settings;
+  settings.buffering_enabled = mode != BufferingMode::kNone;
+  settings.watch_command_timer_interval = kBufferingInterval;
+  settings.adaptive_buffering = mode == BufferingMode::kAdaptive;
+  settings.single_flight = single_flight;
+  return settings;
+}
+
+// Waits for the replies of a burst of commands
+class Burst final {
+ public:
+  explicit Burst(std::size_t size) : remaining_(size) {}
+
+  redis::ReplyCallback GetCallback() {
+    return [this, start = std::chrono::steady_clock::now()](
+               const redis::CommandPtr&, redis::ReplyPtr) {
+      const auto latency = std::chrono::steady_clock::now() - start;
+      std::lock_guard lock(mutex_);
+      latencies_.push_back(latency);
+      if (--remaining_ == 0) cv_.notify_one();
+    };
+  }
+
+  std::vector<std::chrono::steady_clock::duration> Wait() {
+    std::unique_lock lock(mutex_);
+    cv_.wait(lock, [this] { return remaining_ == 0; });
+    return std::move(latencies_);
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::size_t remaining_;
+  std::vector<std::chrono::steady_clock::duration> latencies_;
+};
+
+}  // namespace
+
+// GETs of a few hot keys, `burst` commands are sent at once
+void RedisCommandsBuffering(benchmark::State& state) {
+  const auto mode = static_cast<BufferingMode>(state.range(0));
+  const auto burst_size = static_cast<std::size_t>(state.range(2));
+
+  MockRedisServer server;
+  auto ping_handler = server.RegisterPingHandler();
+  auto get_handler = server.RegisterHandlerWithConstReply(
+      "GET", redis::ReplyData{std::string(64, 'v')});
+
+  auto pool = std::make_shared<redis::ThreadPools>(1, 1);
+  auto redis =
+      std::make_shared<redis::Redis>(pool->GetRedisThreadPool(), false);
+  redis->SetCommandsBufferingSettings(MakeSettings(mode, state.range(1)));
+  redis->Connect("127.0.0.1", server.GetPort(), redis::Password(""));
+  while (redis->GetState() != redis::RedisState::kConnected) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+
+  std::vector<std::chrono::steady_clock::duration> latencies;
+  for (auto _ : state) {
+    Burst burst(burst_size);
+    for (std::size_t i = 0; i < burst_size; ++i) {
+      redis->AsyncCommand(redis::PrepareCommand(
+          {"GET", "key" + std::to_string(i % kHotKeys)}, burst.GetCallback()));
+    }
+    auto burst_latencies = burst.Wait();
+    latencies.insert(latencies.end(), burst_latencies.begin(),
+                     burst_latencies.end());
+  }
+
+  const auto commands = state.iterations() * burst_size;
+  state.SetItemsProcessed(commands);
+  state.counters["server_gets_per_command"] =
+      static_cast<double>(get_handler->GetReplyCount()) / commands;
+  if (!latencies.empty()) {
+    const auto p99 = latencies.begin() + latencies.size() * 99 / 100;
+    std::nth_element(latencies.begin(), p99, latencies.end());
+    state.counters["p99_us"] =
+        std::chrono::duration<double, std::micro>(*p99).count();
+  }
+}
+// {buffering-mode: none/fixed/adaptive, single-flight, burst}
+BENCHMARK(RedisCommandsBuffering)
+    ->ArgsProduct({{0, 1, 2}, {0, 1}, {1, 64}})
+    ->UseRealTime();
+
+USERVER_NAMESPACE_END
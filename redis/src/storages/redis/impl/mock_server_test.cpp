@@ -1,5 +1,6 @@
 #include "mock_server_test.hpp"
 
+#include <algorithm>
 #include <sstream>
 #include <thread>
 
@@ -30,10 +31,10 @@ void HandlerHotFound(const std::string& command,
 
 }  // namespace
 
-MockRedisServerBase::MockRedisServerBase(int port)
-    : acceptor_(io_service_),
-      socket_(io_service_),
-      reader_(redisReaderCreate(), &redisReaderFree) {
+MockRedisServerBase::Session::Session(io::io_service& io_service)
+    : socket(io_service), reader(redisReaderCreate(), &redisReaderFree) {}
+
+MockRedisServerBase::MockRedisServerBase(int port) : acceptor_(io_service_) {
   acceptor_.open(io::ip::tcp::v4());
   boost::asio::ip::tcp::acceptor::reuse_address option(true);
   acceptor_.set_option(option);
@@ -57,6 +58,22 @@ void MockRedisServerBase::SendReplyData(const redis::ReplyData& reply_data) {
   SendReply(ReplyDataToRedisProto(reply_data));
 }
 
+void MockRedisServerBase::Publish(const std::string& channel,
+                                  const redis::ReplyData& message) {
+  auto reply = ReplyDataToRedisProto(redis::ReplyData::Array{
+      redis::ReplyData{"message"}, redis::ReplyData{channel}, message});
+  io_service_.post([this, channel, reply = std::move(reply)] {
+    for (const auto& session : sessions_) {
+      const auto& channels = session->channels;
+      if (std::find(channels.begin(), channels.end(), channel) ==
+          channels.end()) {
+        continue;
+      }
+      io::write(session->socket, io::buffer(reply.c_str(), reply.size()));
+    }
+  });
+}
+
 int MockRedisServerBase::GetPort() const {
   return acceptor_.local_endpoint().port();
 }
@@ -69,7 +86,7 @@ void MockRedisServerBase::Stop() {
 void MockRedisServerBase::SendReply(const std::string& reply) {
   LOG_DEBUG() << "reply: " << reply;
   // TODO: async?
-  io::write(socket_, io::buffer(reply.c_str(), reply.size()));
+  io::write(current_session_->socket, io::buffer(reply.c_str(), reply.size()));
 }
 
 std::string MockRedisServerBase::ReplyDataToRedisProto(
@@ -100,8 +117,9 @@ std::string MockRedisServerBase::ReplyDataToRedisProto(
 }
 
 void MockRedisServerBase::Accept() {
-  acceptor_.async_accept(socket_, [this](auto&& item) {
-    OnAccept(std::forward<decltype(item)>(item));
+  auto session = std::make_shared<Session>(io_service_);
+  acceptor_.async_accept(session->socket, [this, session](auto&& item) {
+    OnAccept(session, std::forward<decltype(item)>(item));
   });
 }
 
@@ -110,47 +128,63 @@ void MockRedisServerBase::Work() {
   UEXPECT_NO_THROW(io_service_.run());
 }
 
-void MockRedisServerBase::OnAccept(boost::system::error_code ec) {
+void MockRedisServerBase::OnAccept(const SessionPtr& session,
+                                   boost::system::error_code ec) {
   LOG_DEBUG() << "accept(2): " << ec;
+  if (ec) return;
+  sessions_.push_back(session);
   OnConnected();
-  DoRead();
+  DoRead(session);
+  // allow several connections at once
+  Accept();
 }
 
-void MockRedisServerBase::OnRead(boost::system::error_code ec, size_t count) {
+void MockRedisServerBase::OnRead(const SessionPtr& session,
+                                 boost::system::error_code ec, size_t count) {
   LOG_DEBUG() << "read " << ec << " count=" << count;
   if (ec) {
     LOG_DEBUG() << "read(2) error: " << ec;
     OnDisconnected();
-    socket_.close();
-    // allow reconnection after previous connection is closed
-    Accept();
+    session->socket.close();
+    sessions_.erase(std::find(sessions_.begin(), sessions_.end(), session));
     return;
   }
 
-  auto ret = redisReaderFeed(reader_.get(), data_.data(), count);
+  auto ret = redisReaderFeed(session->reader.get(), session->data.data(), count);
   if (ret != REDIS_OK)
     throw std::runtime_error("redisReaderFeed() returned error: " +
-                             std::string(reader_->errstr));
+                             std::string(session->reader->errstr));
 
   void* hiredis_reply = nullptr;
-  while (redisReaderGetReply(reader_.get(), &hiredis_reply) == REDIS_OK &&
+  while (redisReaderGetReply(session->reader.get(), &hiredis_reply) ==
+             REDIS_OK &&
          hiredis_reply) {
     auto reply = std::make_shared<redis::Reply>(
         "", static_cast<redisReply*>(hiredis_reply), REDIS_OK);
     LOG_DEBUG() << "command: " << reply->data.ToDebugString();
 
+    if (reply->data.IsArray() && reply->data.GetArray().size() == 2 &&
+        boost::algorithm::iequals(reply->data.GetArray()[0].GetString(),
+                                  "SUBSCRIBE")) {
+      session->channels.push_back(reply->data.GetArray()[1].GetString());
+    }
+
+    current_session_ = session;
     OnCommand(reply);
+    current_session_.reset();
     freeReplyObject(hiredis_reply);
     hiredis_reply = nullptr;
   }
 
-  DoRead();
+  DoRead(session);
 }
 
-void MockRedisServerBase::DoRead() {
-  socket_.async_read_some(io::buffer(data_),
-                          [this](boost::system::error_code error_code,
-                                 size_t count) { OnRead(error_code, count); });
+void MockRedisServerBase::DoRead(const SessionPtr& session) {
+  session->socket.async_read_some(
+      io::buffer(session->data),
+      [this, session](boost::system::error_code error_code, size_t count) {
+        OnRead(session, error_code, count);
+      });
 }
 
 MockRedisServer::~MockRedisServer() { Stop(); }
@@ -7,6 +7,7 @@
 #include <mutex>
 #include <stdexcept>
 #include <unordered_map>
+#include <vector>
 
 #include <hiredis/hiredis.h>
 
@@ -30,6 +31,8 @@ class MockRedisServerBase {
   void SendReplyOk(const std::string& reply);
   void SendReplyError(const std::string& reply);
   void SendReplyData(const redis::ReplyData& reply_data);
+  /// Sends a message to the connections subscribed to the channel
+  void Publish(const std::string& channel, const redis::ReplyData& message);
   int GetPort() const;
 
  protected:
@@ -47,19 +50,30 @@ class MockRedisServerBase {
   void Accept();
 
  private:
+  struct Session {
+    explicit Session(io::io_service& io_service);
+
+    io::ip::tcp::socket socket;
+    std::array<char, 1024> data{};
+    std::unique_ptr<redisReader, decltype(&redisReaderFree)> reader;
+    std::vector<std::string> channels;
+  };
+  using SessionPtr = std::shared_ptr<Session>;
+
   static std::string ReplyDataToRedisProto(const redis::ReplyData& reply_data);
   void Work();
-  void OnAccept(boost::system::error_code ec);
-  void OnRead(boost::system::error_code ec, size_t count);
-  void DoRead();
+  void OnAccept(const SessionPtr& session, boost::system::error_code ec);
+  void OnRead(const SessionPtr& session, boost::system::error_code ec,
+              size_t count);
+  void DoRead(const SessionPtr& session);
 
   io::io_service io_service_;
   io::ip::tcp::acceptor acceptor_;
   std::thread thread_;
 
-  io::ip::tcp::socket socket_;
-  std::array<char, 1024> data_{};
-  std::unique_ptr<redisReader, decltype(&redisReaderFree)> reader_;
+  std::vector<SessionPtr> sessions_;
+  // Replies of the command handlers go to the connection of the command
+  SessionPtr current_session_;
 };
 
 class MockRedisServer : public MockRedisServerBase {
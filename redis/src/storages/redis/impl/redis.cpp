@@ -2,11 +2,14 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <deque>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <hiredis/adapters/libev.h>
@@ -19,6 +22,7 @@
 #include <userver/utils/swappingsmart.hpp>
 
 #include <storages/redis/impl/ev_wrapper.hpp>
+#include <storages/redis/impl/reply_reader.hpp>
 #include <storages/redis/impl/tcp_socket.hpp>
 #include <userver/storages/redis/impl/redis_stats.hpp>
 #include <userver/storages/redis/impl/reply.hpp>
@@ -29,6 +33,8 @@ namespace redis {
 namespace {
 
 const auto kPingLatencyExp = 0.7;
+const auto kCommandRateExp = 0.8;
+const size_t kAdaptiveBatchSizeDefault = 16;
 const auto kInitialPingLatencyMs = 1000;
 const size_t kMissedPingStreakThresholdDefault = 3;
 
@@ -37,6 +43,9 @@ const size_t kMissedPingStreakThresholdDefault = 3;
 // subscriber mode
 const std::string kSubscriberPingChannelName = "_ping_dummy_ch";
 
+// CLIENT TRACKING REDIRECT sends the invalidations of RESP2 clients here
+const std::string kInvalidationChannelName = "__redis__:invalidate";
+
 inline bool AreStringsEqualIgnoreCase(const std::string& l,
                                       const std::string& r) {
   return l.size() == r.size() && !strcasecmp(l.c_str(), r.c_str());
@@ -74,6 +83,26 @@ inline bool IsExecCommand(const CmdArgs::CmdArgsArray& args) {
   return AreStringsEqualIgnoreCase(args[0], exec_command);
 }
 
+// Commands without side effects, safe to share a reply between the callers
+bool IsSingleFlightCommand(const std::string& command) {
+  static const std::unordered_set<std::string> kCommands{
+      "exists", "get", "getrange", "hexists", "hget", "hgetall", "hkeys",
+      "hlen", "hmget", "hvals", "lindex", "llen", "lrange", "mget", "scard",
+      "sismember", "smembers", "strlen", "ttl", "type", "zcard", "zrange",
+      "zrangebyscore", "zscore"};
+  return kCommands.count(boost::algorithm::to_lower_copy(command)) != 0;
+}
+
+std::string MakeSingleFlightKey(const CmdArgs::CmdArgsArray& args) {
+  std::string key;
+  for (const auto& arg : args) {
+    key += std::to_string(arg.size());
+    key += ':';
+    key += arg;
+  }
+  return key;
+}
+
 bool IsFinalState(Redis::State state) {
   return state == Redis::State::kDisconnected ||
          state == Redis::State::kDisconnectError;
@@ -116,6 +145,8 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
   }
   void SetCommandsBufferingSettings(
       CommandsBufferingSettings commands_buffering_settings);
+  void EnableClientTracking(ClientTrackingSettings settings,
+                            ClientTrackingCallback callback);
 
   void ResetRedisObj() { redis_obj_ = nullptr; }
 
@@ -157,11 +188,21 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
   void OnConnectTimeoutImpl();
   void OnCommandTimeoutImpl(ev_timer* w);
 
+  void AccountCommandRate(size_t commands);
+  std::chrono::microseconds GetBufferingInterval(
+      const CommandsBufferingSettings& commands_buffering_settings) const;
+
   void SetState(State state);
   void ProcessCommand(const CommandPtr& command);
 
   void Authenticate();
   void SendReadOnly();
+  void SendClientTracking();
+  void OnTrackingStateChange(State state);
+  void SubscribeToInvalidations();
+  void OnInvalidationMessage(std::int64_t client_id, const ReplyPtr& reply);
+  void SendClientTrackingRedirect(std::int64_t client_id);
+  void InvalidateAllTracked();
   void FreeCommands();
 
   void RunEvLoop();
@@ -176,8 +217,18 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
     ev_timer timer{};
     std::shared_ptr<RedisImpl> redis_impl;
     bool invoke_disabled = false;
+    // Identical commands waiting for the reply to this one
+    std::string single_flight_key;
+    std::vector<CommandPtr> followers;
   };
 
+  bool JoinSingleFlight(const CommandPtr& command,
+                        const CmdArgs::CmdArgsArray& args,
+                        std::string& single_flight_key);
+  void FinishSingleFlight(SingleCommand& command, const ReplyPtr& reply);
+  ReplyPtr MakeReply(const SingleCommand& command,
+                     redisReply* redis_reply) const;
+
   bool SetDestroying() {
     std::lock_guard<std::mutex> lock(command_mutex_);
     if (destroying_) return false;
@@ -201,6 +252,7 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
   redisAsyncContext* context_ = nullptr;
   std::atomic<State> state_{State::kInit};
   std::string host_;
+  int port_ = 0;
   std::string server_;
   Password password_{std::string()};
   std::atomic<size_t> commands_size_ = 0;
@@ -217,6 +269,9 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
   ev_timer watch_command_timer_{};
   ev_async watch_command_{};
   utils::SwappingSmart<CommandsBufferingSettings> commands_buffering_settings_;
+  std::unordered_map<std::string, SingleCommand*> single_flight_leaders_;
+  double command_rate_{0.0};
+  std::chrono::steady_clock::time_point last_command_loop_time_{};
   std::chrono::milliseconds ping_interval_{2000};
   std::chrono::milliseconds ping_timeout_{4000};
   std::atomic<double> ping_latency_ms_{kInitialPingLatencyMs};
@@ -226,6 +281,12 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
   Statistics statistics_;
   ServerId server_id_;
   bool attached_ = false;
+  std::optional<ClientTrackingSettings> client_tracking_settings_;
+  ClientTrackingCallback client_tracking_callback_;
+  bool is_tracking_enabled_ = false;
+  // Subscriber connection in the same ev thread receiving the invalidations
+  std::unique_ptr<Redis> tracking_redis_;
+  boost::signals2::scoped_connection tracking_state_connection_;
   std::shared_ptr<RedisImpl> self_;
 };
 
@@ -264,6 +325,16 @@ Redis::Redis(const std::shared_ptr<engine::ev::ThreadPool>& thread_pool,
   });
 }
 
+Redis::Redis(const std::shared_ptr<engine::ev::ThreadPool>& thread_pool,
+             const engine::ev::ThreadControl& thread_control,
+             bool send_readonly)
+    : thread_control_(thread_control) {
+  thread_control_.RunInEvLoopBlocking([&]() {
+    impl_ = std::make_shared<RedisImpl>(thread_pool, thread_control_, *this,
+                                        send_readonly);
+  });
+}
+
 Redis::~Redis() {
   thread_control_.RunInEvLoopBlocking([this]() {
     impl_->Disconnect();
@@ -304,6 +375,11 @@ void Redis::SetCommandsBufferingSettings(
   impl_->SetCommandsBufferingSettings(commands_buffering_settings);
 }
 
+void Redis::EnableClientTracking(ClientTrackingSettings settings,
+                                 ClientTrackingCallback callback) {
+  impl_->EnableClientTracking(std::move(settings), std::move(callback));
+}
+
 Redis::RedisImpl::RedisImpl(
     const std::shared_ptr<engine::ev::ThreadPool>& thread_pool,
     const engine::ev::ThreadControl& thread_control, Redis& redis_obj,
@@ -320,6 +396,10 @@ Redis::RedisImpl::RedisImpl(
 Redis::RedisImpl::~RedisImpl() {
   LOG_DEBUG() << "~RedisImpl() server_id=" << GetServerId().GetId()
               << " server=" << GetServer();
+  // Commands of the tracking connection fail on its destruction, their
+  // callbacks see the reset pointer and do not touch this object
+  tracking_state_connection_.disconnect();
+  tracking_redis_.reset();
   server_id_.RemoveDescription();
 }
 
@@ -365,6 +445,7 @@ void Redis::RedisImpl::Connect(const std::string& host, int port,
   server_ = host + ":" + std::to_string(port);
   server_id_.SetDescription(server_);
   host_ = host;
+  port_ = port;
   log_extra_.Extend("redis_server", GetServer());
   log_extra_.Extend("server_id", GetServerId().GetId());
   password_ = password;
@@ -382,6 +463,7 @@ void Redis::RedisImpl::Connect(const std::string& host, int port,
     context_ = nullptr;
     SetState(State::kInitError);
   } else {
+    UseArenaReplies(*context_->c.reader);
     ev_thread_control_.RunInEvLoopBlocking([this]() {
       bool err = false;
       auto CheckError = [&err](bool err_now, const std::string& msg) {
@@ -544,6 +626,8 @@ void Redis::RedisImpl::OnCommandTimeoutImpl(ev_timer* w) {
     reply_privdata_rev_.erase(&command.timer);
     command.invoke_disabled = true;
     InvokeCommandError(command.meta, command.cmd, REDIS_ERR_TIMEOUT);
+    FinishSingleFlight(command, std::make_shared<Reply>(command.cmd, nullptr,
+                                                        REDIS_ERR_TIMEOUT));
   }
 }
 
@@ -690,6 +774,8 @@ void Redis::RedisImpl::SetState(State state) {
       << StateToString(state_) << " to " << StateToString(state);
   state_ = state;
   statistics_.AccountStateChanged(state);
+  // Invalidations are lost with the connection
+  if (state != State::kConnected) InvalidateAllTracked();
 
   auto self = shared_from_this();  // prevents deleting this in Disconnect()
   if (state == State::kConnected) {
@@ -720,9 +806,13 @@ void Redis::RedisImpl::FreeCommands() {
       info.second->invoke_disabled = true;
       InvokeCommandError(info.second->meta, info.second->cmd,
                          REDIS_ERR_NOT_READY);
+      FinishSingleFlight(*info.second,
+                         std::make_shared<Reply>(info.second->cmd, nullptr,
+                                                 REDIS_ERR_NOT_READY));
     }
   }
   reply_privdata_.clear();
+  single_flight_leaders_.clear();
 }
 
 void Redis::RedisImpl::OnNewCommand(struct ev_loop*, ev_async* w,
@@ -738,17 +828,17 @@ void Redis::RedisImpl::OnNewCommand(struct ev_loop*, ev_async* w,
 
 void Redis::RedisImpl::OnNewCommandImpl() {
   auto commands_buffering_settings = commands_buffering_settings_.Get();
+  const auto buffering_interval =
+      GetBufferingInterval(*commands_buffering_settings);
   if (WatchCommandTimerEnabled(*commands_buffering_settings) &&
+      buffering_interval != std::chrono::microseconds::zero() &&
       (!commands_buffering_settings->commands_buffering_threshold ||
        commands_size_.load() <
            commands_buffering_settings->commands_buffering_threshold)) {
     if (!std::exchange(watch_command_timer_started_, true)) {
       // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
-      ev_timer_set(
-          &watch_command_timer_,
-          ToEvDuration(
-              commands_buffering_settings->watch_command_timer_interval),
-          0.0);
+      ev_timer_set(&watch_command_timer_, ToEvDuration(buffering_interval),
+                   0.0);
       ev_thread_control_.Start(watch_command_timer_);
     }
   } else {
@@ -756,6 +846,38 @@ void Redis::RedisImpl::OnNewCommandImpl() {
   }
 }
 
+std::chrono::microseconds Redis::RedisImpl::GetBufferingInterval(
+    const CommandsBufferingSettings& commands_buffering_settings) const {
+  const auto max_interval =
+      commands_buffering_settings.watch_command_timer_interval;
+  if (!commands_buffering_settings.adaptive_buffering) return max_interval;
+
+  // Buffering only adds latency if there is nothing to batch the command with
+  const auto max_batch_size =
+      command_rate_ * std::chrono::duration<double>(max_interval).count();
+  if (max_batch_size < 2) return std::chrono::microseconds::zero();
+
+  const auto batch_size =
+      commands_buffering_settings.commands_buffering_threshold
+          ? commands_buffering_settings.commands_buffering_threshold
+          : kAdaptiveBatchSizeDefault;
+  return std::min(max_interval,
+                  std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::duration<double>(batch_size /
+                                                    command_rate_)));
+}
+
+void Redis::RedisImpl::AccountCommandRate(size_t commands) {
+  const auto now = std::chrono::steady_clock::now();
+  const auto elapsed =
+      std::chrono::duration<double>(now - last_command_loop_time_).count();
+  last_command_loop_time_ = now;
+  if (elapsed <= 0) return;
+
+  command_rate_ = command_rate_ * kCommandRateExp +
+                  commands / elapsed * (1 - kCommandRateExp);
+}
+
 void Redis::RedisImpl::CommandLoopOnTimer(struct ev_loop*, ev_timer* w,
                                           int) noexcept {
   auto* impl = static_cast<Redis::RedisImpl*>(w->data);
@@ -768,7 +890,8 @@ void Redis::RedisImpl::CommandLoopOnTimer(struct ev_loop*, ev_timer* w,
 }
 
 void Redis::RedisImpl::CommandLoopImpl() {
-  if (WatchCommandTimerEnabled(*commands_buffering_settings_.Get())) {
+  const auto commands_buffering_settings = commands_buffering_settings_.Get();
+  if (WatchCommandTimerEnabled(*commands_buffering_settings)) {
     if (std::exchange(watch_command_timer_started_, false)) {
       ev_thread_control_.Stop(watch_command_timer_);
     }
@@ -779,6 +902,9 @@ void Redis::RedisImpl::CommandLoopImpl() {
     commands_size_ -= commands_.size();
     std::swap(commands_, commands);
   }
+  if (commands_buffering_settings->adaptive_buffering) {
+    AccountCommandRate(commands.size());
+  }
   LOG_TRACE() << "commands size=" << commands.size();
   for (auto& command : commands) {
     ProcessCommand(command);
@@ -852,7 +978,7 @@ void Redis::RedisImpl::Authenticate() {
     if (send_readonly_)
       SendReadOnly();
     else
-      SetState(State::kConnected);
+      SendClientTracking();
   } else {
     ProcessCommand(PrepareCommand(
         CmdArgs{"AUTH", password_.GetUnderlying()},
@@ -861,7 +987,7 @@ void Redis::RedisImpl::Authenticate() {
             if (send_readonly_)
               SendReadOnly();
             else
-              SetState(State::kConnected);
+              SendClientTracking();
           } else {
             if (*reply) {
               if (reply->IsUnknownCommandError()) {
@@ -893,7 +1019,7 @@ void Redis::RedisImpl::SendReadOnly() {
   ProcessCommand(PrepareCommand(
       CmdArgs{"READONLY"}, [this](const CommandPtr&, ReplyPtr reply) {
         if (*reply && reply->data.IsStatus()) {
-          SetState(State::kConnected);
+          SendClientTracking();
         } else {
           if (*reply) {
             LOG_LIMITED_ERROR()
@@ -909,6 +1035,131 @@ void Redis::RedisImpl::SendReadOnly() {
       }));
 }
 
+void Redis::RedisImpl::SendClientTracking() {
+  if (!client_tracking_settings_ || subscriber_) {
+    SetState(State::kConnected);
+    return;
+  }
+
+  // Keeps this connection in RESP2, the invalidations of the keys read here
+  // are redirected to a subscriber connection. It runs in the same ev thread,
+  // so its callbacks are serialized with the ones of this connection.
+  tracking_redis_ = std::make_unique<Redis>(thread_pool_, ev_thread_control_);
+  tracking_state_connection_ = tracking_redis_->signal_state_change.connect(
+      [this](State state) { OnTrackingStateChange(state); });
+  tracking_redis_->Connect(host_, port_, password_);
+}
+
+void Redis::RedisImpl::OnTrackingStateChange(State state) {
+  if (state == State::kInit || destroying_) return;
+  if (state == State::kConnected) {
+    SubscribeToInvalidations();
+    return;
+  }
+
+  if (is_tracking_enabled_) {
+    LOG_WARNING() << log_extra_
+                  << "Connection for the invalidations is lost, reconnecting";
+    Disconnect();
+  } else if (state_ == State::kInit) {
+    LOG_LIMITED_ERROR() << log_extra_
+                        << "Connection for the invalidations failed, the "
+                           "client tracking is disabled";
+    SetState(State::kConnected);
+  }
+}
+
+void Redis::RedisImpl::SubscribeToInvalidations() {
+  tracking_redis_->AsyncCommand(PrepareCommand(
+      CmdArgs{"CLIENT", "ID"}, [this](const CommandPtr&, ReplyPtr reply) {
+        if (!tracking_redis_ || destroying_) return;
+        if (!*reply || !reply->data.IsInt()) {
+          LOG_LIMITED_ERROR() << log_extra_
+                              << "CLIENT ID failed, the client tracking is "
+                                 "disabled: "
+                              << (*reply ? reply->data.ToDebugString()
+                                         : reply->StatusString());
+          if (state_ == State::kInit) SetState(State::kConnected);
+          return;
+        }
+        tracking_redis_->AsyncCommand(PrepareCommand(
+            CmdArgs{"SUBSCRIBE", kInvalidationChannelName},
+            [this, client_id = reply->data.GetInt()](const CommandPtr&,
+                                                     ReplyPtr reply) {
+              if (!tracking_redis_ || destroying_) return;
+              OnInvalidationMessage(client_id, reply);
+            }));
+      }));
+}
+
+void Redis::RedisImpl::OnInvalidationMessage(std::int64_t client_id,
+                                             const ReplyPtr& reply) {
+  // Lost subscriptions are handled in OnTrackingStateChange()
+  if (!*reply || !reply->data.IsArray()) return;
+  const auto& message = reply->data.GetArray();
+  if (message.size() != 3 || !message[0].IsString()) return;
+
+  if (message[0].GetString() == "subscribe") {
+    SendClientTrackingRedirect(client_id);
+    return;
+  }
+  if (message[0].GetString() != "message" || !is_tracking_enabled_) return;
+
+  // Nil instead of the keys on FLUSHDB/FLUSHALL
+  std::vector<std::string> keys;
+  const auto& invalidated = message[2];
+  if (invalidated.IsArray()) {
+    keys.reserve(invalidated.GetArray().size());
+    for (const auto& key : invalidated.GetArray()) {
+      if (key.IsString()) keys.push_back(key.GetString());
+    }
+    if (keys.empty()) return;
+  }
+  client_tracking_callback_(keys);
+}
+
+void Redis::RedisImpl::SendClientTrackingRedirect(std::int64_t client_id) {
+  std::vector<std::string> tracking_options;
+  if (!client_tracking_settings_->prefixes.empty()) {
+    tracking_options.emplace_back("BCAST");
+    for (const auto& prefix : client_tracking_settings_->prefixes) {
+      tracking_options.emplace_back("PREFIX");
+      tracking_options.push_back(prefix);
+    }
+  }
+
+  ProcessCommand(PrepareCommand(
+      CmdArgs{"CLIENT", "TRACKING", "ON", "REDIRECT", std::to_string(client_id),
+              tracking_options},
+      [this](const CommandPtr&, ReplyPtr reply) {
+        if (*reply && reply->data.IsStatus()) {
+          if (!tracking_redis_ ||
+              tracking_redis_->GetState() != State::kConnected) {
+            // Nobody receives the invalidations of this connection
+            Disconnect();
+            return;
+          }
+          is_tracking_enabled_ = true;
+          // Nothing read before could be tracked
+          client_tracking_callback_({});
+        } else {
+          LOG_LIMITED_ERROR() << log_extra_ << "CLIENT TRACKING failed: "
+                              << (*reply ? reply->data.ToDebugString()
+                                         : reply->StatusString());
+        }
+        if (state_ == State::kInit) SetState(State::kConnected);
+      }));
+}
+
+void Redis::RedisImpl::InvalidateAllTracked() {
+  if (!std::exchange(is_tracking_enabled_, false)) return;
+  try {
+    client_tracking_callback_({});
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Client tracking callback failed: " << ex;
+  }
+}
+
 void Redis::RedisImpl::OnRedisReply(redisAsyncContext* c, void* r,
                                     void* privdata) noexcept {
   auto* impl = static_cast<Redis::RedisImpl*>(c->data);
@@ -929,9 +1180,7 @@ void Redis::RedisImpl::OnRedisReplyImpl(redisReply* redis_reply,
 
     ev_thread_control_.Stop(data->second->timer);
     pcommand = data->second.get();
-    auto reply =
-        std::make_shared<Reply>(pcommand->cmd, redis_reply,
-                                redis_reply ? REDIS_OK : REDIS_ERR_NOT_READY);
+    auto reply = MakeReply(*pcommand, redis_reply);
 
     // After 'subscribe x' + 'unsubscribe x' + 'subscribe x' requests
     // 'unsubscribe' reply can be received as a reply to the second subscribe
@@ -965,11 +1214,28 @@ void Redis::RedisImpl::OnRedisReplyImpl(redisReply* redis_reply,
       if (subscriber_ &&
           (!reply->IsOk() || !reply->data || !reply->data.IsArray()))
         pcommand->invoke_disabled = true;
+      FinishSingleFlight(*pcommand, reply);
       InvokeCommand(pcommand->meta, std::move(reply));
     }
   }
 }
 
+ReplyPtr Redis::RedisImpl::MakeReply(const SingleCommand& command,
+                                     redisReply* redis_reply) const {
+  if (!redis_reply) {
+    return std::make_shared<Reply>(command.cmd, nullptr, REDIS_ERR_NOT_READY);
+  }
+
+  // The parsed strings and arrays are handed over as is, the tree stays
+  // alive after hiredis frees its reply
+  if (!subscriber_ && command.meta->control.reply_as_view &&
+      (redis_reply->type == REDIS_REPLY_STRING ||
+       redis_reply->type == REDIS_REPLY_ARRAY)) {
+    return std::make_shared<Reply>(command.cmd, TakeArenaReply(redis_reply));
+  }
+  return std::make_shared<Reply>(command.cmd, ExtractArenaReply(redis_reply));
+}
+
 void Redis::RedisImpl::ProcessCommand(const CommandPtr& command) {
   command->ResetStartHandlingTime();
   statistics_.AccountCommandSent(command);
@@ -1005,6 +1271,9 @@ void Redis::RedisImpl::ProcessCommand(const CommandPtr& command) {
                  << log_extra_;
     }
 
+    std::string single_flight_key;
+    if (JoinSingleFlight(command, args, single_flight_key)) continue;
+
     std::vector<const char*> argv;
     std::vector<size_t> argv_len;
 
@@ -1041,6 +1310,10 @@ void Redis::RedisImpl::ProcessCommand(const CommandPtr& command) {
       entry->meta = command;
       entry->timer.data = this;
       entry->redis_impl = shared_from_this();
+      if (!single_flight_key.empty()) {
+        single_flight_leaders_[single_flight_key] = entry.get();
+        entry->single_flight_key = std::move(single_flight_key);
+      }
       // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
       ev_timer_init(&entry->timer, OnCommandTimeout,
                     ToEvDuration(command->control.timeout_single), 0.0);
@@ -1058,12 +1331,67 @@ void Redis::RedisImpl::ProcessCommand(const CommandPtr& command) {
   }
 }
 
+bool Redis::RedisImpl::JoinSingleFlight(const CommandPtr& command,
+                                        const CmdArgs::CmdArgsArray& args,
+                                        std::string& single_flight_key) {
+  if (subscriber_ || command->asking || command->args.args.size() != 1 ||
+      !commands_buffering_settings_.Get()->single_flight ||
+      !IsSingleFlightCommand(args[0])) {
+    return false;
+  }
+
+  single_flight_key = MakeSingleFlightKey(args);
+  const auto leader_it = single_flight_leaders_.find(single_flight_key);
+  if (leader_it == single_flight_leaders_.end()) return false;
+  auto& leader = *leader_it->second;
+  // The command must not wait for the reply longer than it would on its own,
+  // otherwise it becomes the leader for the subsequent ones
+  if (leader.meta->control.timeout_single > command->control.timeout_single) {
+    return false;
+  }
+
+  leader.followers.push_back(command);
+  single_flight_key.clear();
+  return true;
+}
+
+void Redis::RedisImpl::FinishSingleFlight(SingleCommand& command,
+                                          const ReplyPtr& reply) {
+  if (command.single_flight_key.empty()) return;
+  const auto leader_it = single_flight_leaders_.find(command.single_flight_key);
+  if (leader_it != single_flight_leaders_.end() &&
+      leader_it->second == &command) {
+    single_flight_leaders_.erase(leader_it);
+  }
+  command.single_flight_key.clear();
+
+  // Callbacks may take the reply data away, each follower gets its own copy
+  const auto followers = std::move(command.followers);
+  for (const auto& follower : followers) {
+    auto follower_reply = std::make_shared<Reply>(*reply);
+    if (!follower->control.reply_as_view) follower_reply->ConvertViewToData();
+    InvokeCommand(follower, std::move(follower_reply));
+  }
+}
+
 void Redis::RedisImpl::SetCommandsBufferingSettings(
     CommandsBufferingSettings commands_buffering_settings) {
   commands_buffering_settings_.Set(
       std::make_shared<CommandsBufferingSettings>(commands_buffering_settings));
 }
 
+void Redis::RedisImpl::EnableClientTracking(ClientTrackingSettings settings,
+                                            ClientTrackingCallback callback) {
+  UASSERT(callback);
+  ev_thread_control_.RunInEvLoopBlocking([&] {
+    if (client_tracking_settings_) return;
+    client_tracking_settings_ = std::move(settings);
+    client_tracking_callback_ = std::move(callback);
+    // New connections enable the tracking after the authentication
+    if (state_ == State::kConnected) SendClientTracking();
+  });
+}
+
 }  // namespace redis
 
 USERVER_NAMESPACE_END
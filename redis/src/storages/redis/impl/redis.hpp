@@ -28,6 +28,10 @@ class Redis {
 
   Redis(const std::shared_ptr<engine::ev::ThreadPool>& thread_pool,
         bool send_readonly = false);
+  /// Runs the connection in the given thread of the pool
+  Redis(const std::shared_ptr<engine::ev::ThreadPool>& thread_pool,
+        const engine::ev::ThreadControl& thread_control,
+        bool send_readonly = false);
   ~Redis();
 
   Redis(Redis&& o) = delete;
@@ -47,6 +51,12 @@ class Redis {
   void SetCommandsBufferingSettings(
       CommandsBufferingSettings commands_buffering_settings);
 
+  /// Enables CLIENT TRACKING on the connection, now if connected or right
+  /// after the authentication otherwise. The connection stays in RESP2, the
+  /// invalidations are redirected to a separate subscriber connection.
+  void EnableClientTracking(ClientTrackingSettings settings,
+                            ClientTrackingCallback callback);
+
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
   boost::signals2::signal<void(State)> signal_state_change;
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
@@ -29,7 +29,9 @@ void Statistics::AccountCommandSent(const CommandPtr& cmd) {
 
 void Statistics::AccountReplyReceived(const ReplyPtr& reply,
                                       const CommandPtr& cmd) {
-  reply_size_percentile.GetCurrentCounter().Account(reply->data.GetSize());
+  const auto view = reply->GetView();
+  reply_size_percentile.GetCurrentCounter().Account(
+      view ? view.GetSize() : reply->data.GetSize());
   auto start = cmd->GetStartHandlingTime();
   auto delta = std::chrono::steady_clock::now() - start;
   auto ms =
@@ -1,6 +1,7 @@
 #include <userver/storages/redis/impl/reply.hpp>
 
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
 #include <hiredis/hiredis.h>
@@ -260,9 +261,133 @@ void ReplyData::ExpectError(const std::string& request_description) const {
       ", got type=" + GetTypeString() + " data=" + ToDebugString());
 }
 
+ReplyData::Type ReplyDataView::GetType() const {
+  if (!reply_) return ReplyData::Type::kNoReply;
+
+  switch (reply_->type) {
+    case REDIS_REPLY_STRING:
+      return ReplyData::Type::kString;
+    case REDIS_REPLY_ARRAY:
+      return ReplyData::Type::kArray;
+    case REDIS_REPLY_INTEGER:
+      return ReplyData::Type::kInteger;
+    case REDIS_REPLY_NIL:
+      return ReplyData::Type::kNil;
+    case REDIS_REPLY_STATUS:
+      return ReplyData::Type::kStatus;
+    case REDIS_REPLY_ERROR:
+      return ReplyData::Type::kError;
+    default:
+      return ReplyData::Type::kNoReply;
+  }
+}
+
+std::string ReplyDataView::GetTypeString() const {
+  return ReplyData::TypeToString(GetType());
+}
+
+int64_t ReplyDataView::GetInt() const {
+  UASSERT(IsInt());
+  return reply_->integer;
+}
+
+size_t ReplyDataView::GetArraySize() const {
+  UASSERT(IsArray());
+  return reply_->elements;
+}
+
+ReplyDataView ReplyDataView::operator[](size_t idx) const {
+  UASSERT(IsArray());
+  if (idx >= reply_->elements)
+    throw std::out_of_range("ReplyDataView index " + std::to_string(idx) +
+                            " is out of range");
+  return ReplyDataView(reply_->element[idx]);
+}
+
+size_t ReplyDataView::GetSize() const {
+  switch (GetType()) {
+    case ReplyData::Type::kArray: {
+      size_t sum = 0;
+      for (size_t i = 0; i < reply_->elements; i++)
+        sum += ReplyDataView(reply_->element[i]).GetSize();
+      return sum;
+    }
+    case ReplyData::Type::kInteger:
+      return sizeof(int64_t);
+    case ReplyData::Type::kString:
+    case ReplyData::Type::kStatus:
+    case ReplyData::Type::kError:
+      return reply_->len;
+    case ReplyData::Type::kNoReply:
+    case ReplyData::Type::kNil:
+      return 1;
+  }
+  return 1;
+}
+
+std::string ReplyDataView::ToDebugString() const {
+  switch (GetType()) {
+    case ReplyData::Type::kNoReply:
+      return {};
+    case ReplyData::Type::kNil:
+      return "(nil)";
+    case ReplyData::Type::kString:
+    case ReplyData::Type::kStatus:
+    case ReplyData::Type::kError:
+      return std::string{GetStringUnchecked()};
+    case ReplyData::Type::kInteger:
+      return std::to_string(reply_->integer);
+    case ReplyData::Type::kArray: {
+      std::ostringstream os;
+      os << "[";
+      for (size_t i = 0; i < reply_->elements; i++) {
+        if (i) os << ", ";
+        os << ReplyDataView(reply_->element[i]).ToDebugString();
+      }
+      os << "]";
+      return os.str();
+    }
+  }
+  return "(unknown type)";
+}
+
+void ReplyDataView::ExpectType(ReplyData::Type type,
+                               const std::string& request_description) const {
+  if (GetType() != type) {
+    throw ParseReplyException(
+        "Unexpected redis reply type to '" + request_description +
+        "' request: expected " + ReplyData::TypeToString(type) +
+        ", got type=" + GetTypeString() + " data=" + ToDebugString());
+  }
+}
+
+void ReplyDataView::ExpectString(const std::string& request_description) const {
+  ExpectType(ReplyData::Type::kString, request_description);
+}
+
+void ReplyDataView::ExpectArray(const std::string& request_description) const {
+  ExpectType(ReplyData::Type::kArray, request_description);
+}
+
+std::string_view ReplyDataView::GetStringUnchecked() const {
+  return {reply_->str, reply_->len};
+}
+
 Reply::Reply(std::string cmd, ReplyData&& data)
     : cmd(std::move(cmd)), data(std::move(data)), status(REDIS_OK) {}
 
+Reply::Reply(std::string cmd, std::shared_ptr<const redisReply> buffer)
+    : cmd(std::move(cmd)),
+      data(static_cast<const redisReply*>(nullptr)),
+      status(REDIS_OK),
+      buffer_(std::move(buffer)) {}
+
+void Reply::ConvertViewToData() {
+  if (!buffer_) return;
+  data = GetView().ToReplyData();
+  buffer_.reset();
+}
+
 bool Reply::IsOk() const { return status == REDIS_OK; }
 
 bool Reply::IsLoggableError() const {
@@ -337,44 +462,42 @@ void Reply::ExpectIsOk(const std::string& request_description) const {
 void Reply::ExpectType(ReplyData::Type type,
                        const std::string& request_description) const {
   ExpectIsOk(request_description);
-  data.ExpectType(type, GetRequestDescription(request_description));
+  if (buffer_) {
+    GetView().ExpectType(type, GetRequestDescription(request_description));
+  } else {
+    data.ExpectType(type, GetRequestDescription(request_description));
+  }
 }
 
 void Reply::ExpectString(const std::string& request_description) const {
-  ExpectIsOk(request_description);
-  data.ExpectString(GetRequestDescription(request_description));
+  ExpectType(ReplyData::Type::kString, request_description);
 }
 
 void Reply::ExpectArray(const std::string& request_description) const {
-  ExpectIsOk(request_description);
-  data.ExpectArray(GetRequestDescription(request_description));
+  ExpectType(ReplyData::Type::kArray, request_description);
 }
 
 void Reply::ExpectInt(const std::string& request_description) const {
-  ExpectIsOk(request_description);
-  data.ExpectInt(GetRequestDescription(request_description));
+  ExpectType(ReplyData::Type::kInteger, request_description);
 }
 
 void Reply::ExpectNil(const std::string& request_description) const {
-  ExpectIsOk(request_description);
-  data.ExpectNil(GetRequestDescription(request_description));
+  ExpectType(ReplyData::Type::kNil, request_description);
 }
 
 void Reply::ExpectStatus(const std::string& request_description) const {
-  ExpectIsOk(request_description);
-  data.ExpectStatus(GetRequestDescription(request_description));
+  ExpectType(ReplyData::Type::kStatus, request_description);
 }
 
 void Reply::ExpectStatusEqualTo(const std::string& expected_status_str,
                                 const std::string& request_description) const {
-  ExpectIsOk(request_description);
+  ExpectStatus(request_description);
   data.ExpectStatusEqualTo(expected_status_str,
                            GetRequestDescription(request_description));
 }
 
 void Reply::ExpectError(const std::string& request_description) const {
-  ExpectIsOk(request_description);
-  data.ExpectError(GetRequestDescription(request_description));
+  ExpectType(ReplyData::Type::kError, request_description);
 }
 
 const std::string& Reply::GetRequestDescription(
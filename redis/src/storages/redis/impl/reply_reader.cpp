@@ -0,0 +1,272 @@
+#include "reply_reader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <hiredis/hiredis.h>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+namespace {
+
+constexpr std::size_t kInitialBlockSize = 512;
+constexpr std::size_t kMinBlockSize = 4 * 1024;
+constexpr std::size_t kMaxBlockSize = 1024 * 1024;
+// Longer strings get their own buffer, ExtractArenaReply() moves it out
+constexpr std::size_t kMaxArenaStringSize = 1024;
+
+// Bump allocator, everything is freed at once with the reply
+class Arena final {
+ public:
+  Arena() = default;
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  void* Allocate(std::size_t size, std::size_t alignment) {
+    auto padding =
+        -reinterpret_cast<std::uintptr_t>(current_) & (alignment - 1);
+    if (padding + size > free_) {
+      Grow(size);
+      // New blocks are aligned for any type
+      padding = 0;
+    }
+    current_ += padding;
+    void* result = current_;
+    current_ += size;
+    free_ -= padding + size;
+    return result;
+  }
+
+  // NUL-terminated the same way hiredis strings are
+  char* CopyString(const char* str, std::size_t len) {
+    auto* result = static_cast<char*>(Allocate(len + 1, 1));
+    std::memcpy(result, str, len);
+    result[len] = '\0';
+    return result;
+  }
+
+ private:
+  void Grow(std::size_t size) {
+    block_size_ = std::clamp(block_size_ * 2, kMinBlockSize, kMaxBlockSize);
+    const auto new_block_size = std::max(size, block_size_);
+    blocks_.push_back(std::make_unique<std::byte[]>(new_block_size));
+    current_ = blocks_.back().get();
+    free_ = new_block_size;
+  }
+
+  alignas(std::max_align_t) std::byte initial_block_[kInitialBlockSize];
+  std::byte* current_{initial_block_};
+  std::size_t free_{kInitialBlockSize};
+  std::size_t block_size_{0};
+  std::vector<std::unique_ptr<std::byte[]>> blocks_;
+};
+
+// Derived from redisReply to stay readable by hiredis: it looks into the
+// replies to handle the errors, the push messages and the subscriptions
+struct Node : redisReply {
+  Node() : redisReply{} {}
+
+  // Owns the bytes `str` points to if they are not in the arena
+  std::string string;
+};
+
+struct RootNode final : Node {
+  Arena arena;
+  // hiredis and the TakeArenaReply() results, the tree may outlive either
+  std::atomic<std::size_t> owners{1};
+};
+
+Node* AsNode(void* obj) {
+  return static_cast<Node*>(static_cast<redisReply*>(obj));
+}
+
+void* AsObject(Node* node) {
+  return static_cast<void*>(static_cast<redisReply*>(node));
+}
+
+RootNode& GetRoot(const redisReadTask* task) {
+  while (task->parent) task = task->parent;
+  return static_cast<RootNode&>(*AsNode(task->obj));
+}
+
+// The same way the default hiredis functions do, the node is linked to its
+// parent right away to be freed with the root on a protocol error
+template <typename Func>
+void* CreateObject(const redisReadTask* task, Func&& init) noexcept {
+  try {
+    if (!task->parent) {
+      // Default-initialized, the inline arena block is left as is
+      std::unique_ptr<RootNode> root{new RootNode};
+      root->type = task->type;
+      init(*root, root->arena);
+      return AsObject(root.release());
+    }
+
+    auto& arena = GetRoot(task).arena;
+    auto* node = new (arena.Allocate(sizeof(Node), alignof(Node))) Node;
+    node->type = task->type;
+    auto* parent = static_cast<redisReply*>(task->parent->obj);
+    parent->element[task->idx] = node;
+    init(*node, arena);
+    return AsObject(node);
+  } catch (const std::exception&) {
+    // hiredis reports the out of memory error on nullptr
+    return nullptr;
+  }
+}
+
+void SetString(Node& node, Arena& arena, const char* str, size_t len) {
+  if (len <= kMaxArenaStringSize) {
+    node.str = arena.CopyString(str, len);
+  } else {
+    node.string.assign(str, len);
+    node.str = node.string.data();
+  }
+  node.len = len;
+}
+
+void* CreateString(const redisReadTask* task, char* str, size_t len) {
+  return CreateObject(task, [str, len](Node& node, Arena& arena) mutable {
+#ifdef REDIS_REPLY_PUSH
+    if (node.type == REDIS_REPLY_VERB) {
+      // Skips the "txt:" format prefix
+      if (len < 4) throw std::length_error("Verbatim string is too short");
+      std::memcpy(node.vtype, str, 3);
+      str += 4;
+      len -= 4;
+    }
+#endif
+    SetString(node, arena, str, len);
+  });
+}
+
+// The count is an int in hiredis 0.x and a size_t in 1.x
+template <typename Size>
+void* CreateArray(const redisReadTask* task, Size elements) {
+  return CreateObject(task, [elements](Node& node, Arena& arena) {
+    if (elements <= 0) return;
+    node.elements = elements;
+    node.element = static_cast<redisReply**>(
+        arena.Allocate(sizeof(redisReply*) * node.elements,
+                       alignof(redisReply*)));
+    std::fill_n(node.element, node.elements, nullptr);
+  });
+}
+
+void* CreateInteger(const redisReadTask* task, long long value) {
+  return CreateObject(task,
+                      [value](Node& node, Arena&) { node.integer = value; });
+}
+
+#ifdef REDIS_REPLY_PUSH
+void* CreateDouble(const redisReadTask* task, double value, char* str,
+                   size_t len) {
+  return CreateObject(task, [value, str, len](Node& node, Arena& arena) {
+    node.dval = value;
+    SetString(node, arena, str, len);
+  });
+}
+
+void* CreateBool(const redisReadTask* task, int value) {
+  return CreateObject(task,
+                      [value](Node& node, Arena&) { node.integer = value; });
+}
+#endif
+
+void* CreateNil(const redisReadTask* task) {
+  return CreateObject(task, [](Node&, Arena&) {});
+}
+
+void DestroyElements(Node& node) {
+  for (size_t i = 0; i < node.elements; ++i) {
+    if (!node.element[i]) continue;
+    auto& element = static_cast<Node&>(*node.element[i]);
+    DestroyElements(element);
+    element.~Node();
+  }
+}
+
+void Release(RootNode* root) {
+  if (root->owners.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+  DestroyElements(*root);
+  delete root;
+}
+
+// hiredis frees only the roots
+void FreeObject(void* obj) { Release(static_cast<RootNode*>(AsNode(obj))); }
+
+redisReplyObjectFunctions MakeArenaReplyFunctions() {
+  redisReplyObjectFunctions functions{};
+  functions.createString = &CreateString;
+  functions.createArray = &CreateArray;
+  functions.createInteger = &CreateInteger;
+#ifdef REDIS_REPLY_PUSH
+  functions.createDouble = &CreateDouble;
+  functions.createBool = &CreateBool;
+#endif
+  functions.createNil = &CreateNil;
+  functions.freeObject = &FreeObject;
+  return functions;
+}
+
+// Not const, redisReader holds a non-const pointer
+redisReplyObjectFunctions kArenaReplyFunctions = MakeArenaReplyFunctions();
+
+}  // namespace
+
+void UseArenaReplies(redisReader& reader) {
+  UASSERT(!reader.reply);
+  reader.fn = &kArenaReplyFunctions;
+}
+
+ReplyData ExtractArenaReply(redisReply* reply) {
+  if (!reply) return ReplyData{static_cast<const redisReply*>(nullptr)};
+
+  auto& node = *AsNode(reply);
+  // Short strings are copied out of the arena, long ones are moved
+  auto take_string = [&node] {
+    return node.string.empty() ? std::string(node.str, node.len)
+                               : std::move(node.string);
+  };
+  switch (node.type) {
+    case REDIS_REPLY_STRING:
+      return ReplyData{take_string()};
+    case REDIS_REPLY_STATUS:
+      return ReplyData::CreateStatus(take_string());
+    case REDIS_REPLY_ERROR:
+      return ReplyData::CreateError(take_string());
+    case REDIS_REPLY_ARRAY: {
+      ReplyData::Array array;
+      array.reserve(node.elements);
+      for (size_t i = 0; i < node.elements; ++i) {
+        array.push_back(ExtractArenaReply(node.element[i]));
+      }
+      return ReplyData{std::move(array)};
+    }
+    default:
+      // Nothing to move out of the integers and the nils
+      return ReplyData{static_cast<const redisReply*>(reply)};
+  }
+}
+
+std::shared_ptr<const redisReply> TakeArenaReply(redisReply* reply) {
+  UASSERT(reply);
+  auto* root = static_cast<RootNode*>(AsNode(reply));
+  root->owners.fetch_add(1, std::memory_order_relaxed);
+  return {reply, [root](const redisReply*) { Release(root); }};
+}
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
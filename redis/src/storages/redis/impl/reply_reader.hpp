@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+
+#include <userver/storages/redis/impl/reply.hpp>
+
+struct redisReader;
+struct redisReply;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+
+/// @brief Makes the reader build the replies in a per-reply arena.
+///
+/// Every reply tree takes a few arena blocks instead of a couple of
+/// allocations per element, strings up to 1KiB are stored in the arena too.
+/// The nodes keep the `redisReply` layout, so hiredis, ReplyData(const
+/// redisReply*) and ReplyDataView work with them. Must be called before the
+/// reader gets any data.
+void UseArenaReplies(redisReader& reader);
+
+/// Converts a reply built by the arena reader to ReplyData. A string element
+/// is allocated once on its way from the socket to the caller: the long
+/// strings are moved out of the tree, the short ones are copied.
+ReplyData ExtractArenaReply(redisReply* reply);
+
+/// Shares the ownership of a reply tree built by the arena reader: the tree
+/// is freed when both hiredis and the result let it go, in any order.
+/// `reply` must be the root of the tree.
+std::shared_ptr<const redisReply> TakeArenaReply(redisReply* reply);
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <hiredis/hiredis.h>
+
+#include <storages/redis/impl/reply_reader.hpp>
+#include <userver/storages/redis/parse_reply.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kElements = 10000;
+
+// MGET-like reply of `value_size` byte strings
+std::string MakeArrayReply(std::size_t value_size) {
+  const std::string value(value_size, 'v');
+  std::string result = "*" + std::to_string(kElements) + "\r\n";
+  for (std::size_t i = 0; i < kElements; ++i) {
+    result += "$" + std::to_string(value.size()) + "\r\n" + value + "\r\n";
+  }
+  return result;
+}
+
+template <typename Convert>
+void ParseReplies(benchmark::State& state, bool arena, Convert convert) {
+  const auto data = MakeArrayReply(state.range(0));
+  std::unique_ptr<redisReader, decltype(&redisReaderFree)> reader{
+      redisReaderCreate(), &redisReaderFree};
+  if (arena) redis::UseArenaReplies(*reader);
+
+  for (auto _ : state) {
+    redisReaderFeed(reader.get(), data.data(), data.size());
+    void* reply = nullptr;
+    redisReaderGetReply(reader.get(), &reply);
+    benchmark::DoNotOptimize(convert(static_cast<redisReply*>(reply)));
+    reader->fn->freeObject(reply);
+  }
+  state.SetItemsProcessed(state.iterations() * kElements);
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+}  // namespace
+
+void RedisReplyParseDefault(benchmark::State& state) {
+  ParseReplies(state, false,
+               [](const redisReply* reply) { return redis::ReplyData{reply}; });
+}
+// {value-size}
+BENCHMARK(RedisReplyParseDefault)->Arg(8)->Arg(64)->Arg(1024);
+
+void RedisReplyParseArena(benchmark::State& state) {
+  ParseReplies(state, true, [](redisReply* reply) {
+    return redis::ExtractArenaReply(reply);
+  });
+}
+// {value-size}
+BENCHMARK(RedisReplyParseArena)->Arg(8)->Arg(64)->Arg(1024);
+
+using MgetResult = std::vector<std::optional<std::string>>;
+
+// What ParseReply() does for a regular reply
+void RedisReplyParseMgetData(benchmark::State& state) {
+  ParseReplies(state, true, [](redisReply* reply) {
+    return storages::redis::Parse(redis::ExtractArenaReply(reply), "mget",
+                                  storages::redis::To<MgetResult>{});
+  });
+}
+// {value-size}
+BENCHMARK(RedisReplyParseMgetData)->Arg(8)->Arg(64)->Arg(1024);
+
+// What ParseReply() does for a reply received as a view
+void RedisReplyParseMgetView(benchmark::State& state) {
+  ParseReplies(state, true, [](redisReply* reply) {
+    const auto buffer = redis::TakeArenaReply(reply);
+    return storages::redis::Parse(redis::ReplyDataView{buffer.get()}, "mget",
+                                  storages::redis::To<MgetResult>{});
+  });
+}
+// {value-size}
+BENCHMARK(RedisReplyParseMgetView)->Arg(8)->Arg(64)->Arg(1024);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,254 @@
+#include <storages/redis/impl/reply_reader.hpp>
+
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <hiredis/hiredis.h>
+
+#include <userver/storages/redis/impl/exception.hpp>
+#include <userver/storages/redis/parse_reply.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using ReaderPtr = std::unique_ptr<redisReader, decltype(&redisReaderFree)>;
+
+ReaderPtr MakeArenaReader() {
+  ReaderPtr reader{redisReaderCreate(), &redisReaderFree};
+  redis::UseArenaReplies(*reader);
+  return reader;
+}
+
+// Frees the reply with the functions of the reader that built it
+class ReaderReply final {
+ public:
+  ReaderReply(redisReader& reader, const std::string& data) : reader_(reader) {
+    EXPECT_EQ(redisReaderFeed(&reader_, data.data(), data.size()), REDIS_OK);
+    EXPECT_EQ(redisReaderGetReply(&reader_, &reply_), REDIS_OK);
+  }
+
+  ~ReaderReply() {
+    if (reply_) reader_.fn->freeObject(reply_);
+  }
+
+  redisReply* Get() const { return static_cast<redisReply*>(reply_); }
+
+  // As the reply callback of RedisImpl does
+  redis::ReplyPtr Take(const std::string& cmd) const {
+    return std::make_shared<redis::Reply>(cmd, redis::TakeArenaReply(Get()));
+  }
+
+ private:
+  redisReader& reader_;
+  void* reply_{nullptr};
+};
+
+using StringMap = std::unordered_map<std::string, std::string>;
+
+}  // namespace
+
+TEST(ReplyReader, String) {
+  auto reader = MakeArenaReader();
+  const std::string value(100, 'x');
+  ReaderReply reply(*reader, "$100\r\n" + value + "\r\n");
+  ASSERT_TRUE(reply.Get());
+
+  // hiredis and the copying conversion still see a regular redisReply
+  EXPECT_EQ(reply.Get()->type, REDIS_REPLY_STRING);
+  EXPECT_EQ(std::string(reply.Get()->str, reply.Get()->len), value);
+  EXPECT_EQ(redis::ReplyData(reply.Get()).GetString(), value);
+
+  const auto data = redis::ExtractArenaReply(reply.Get());
+  ASSERT_TRUE(data.IsString());
+  EXPECT_EQ(data.GetString(), value);
+}
+
+TEST(ReplyReader, Scalars) {
+  auto reader = MakeArenaReader();
+  {
+    ReaderReply reply(*reader, ":-42\r\n");
+    const auto data = redis::ExtractArenaReply(reply.Get());
+    ASSERT_TRUE(data.IsInt());
+    EXPECT_EQ(data.GetInt(), -42);
+  }
+  {
+    ReaderReply reply(*reader, "$-1\r\n");
+    EXPECT_TRUE(redis::ExtractArenaReply(reply.Get()).IsNil());
+  }
+  {
+    ReaderReply reply(*reader, "+OK\r\n");
+    const auto data = redis::ExtractArenaReply(reply.Get());
+    ASSERT_TRUE(data.IsStatus());
+    EXPECT_EQ(data.GetStatus(), "OK");
+  }
+  {
+    ReaderReply reply(*reader, "-ERR unknown command\r\n");
+    const auto data = redis::ExtractArenaReply(reply.Get());
+    ASSERT_TRUE(data.IsError());
+    EXPECT_EQ(data.GetError(), "ERR unknown command");
+  }
+}
+
+TEST(ReplyReader, NestedArrays) {
+  auto reader = MakeArenaReader();
+  ReaderReply reply(*reader,
+                    "*3\r\n$1\r\na\r\n*2\r\n:1\r\n$-1\r\n*0\r\n");
+  ASSERT_TRUE(reply.Get());
+  ASSERT_EQ(reply.Get()->elements, 3);
+  EXPECT_EQ(reply.Get()->element[1]->element[0]->integer, 1);
+
+  const auto data = redis::ExtractArenaReply(reply.Get());
+  ASSERT_TRUE(data.IsArray());
+  ASSERT_EQ(data.GetSize(), 3);
+  EXPECT_EQ(data[0].GetString(), "a");
+  ASSERT_TRUE(data[1].IsArray());
+  EXPECT_EQ(data[1][0].GetInt(), 1);
+  EXPECT_TRUE(data[1][1].IsNil());
+  ASSERT_TRUE(data[2].IsArray());
+  EXPECT_EQ(data[2].GetSize(), 0);
+}
+
+TEST(ReplyReader, LargeArray) {
+  constexpr std::size_t kSize = 10000;
+  std::string resp = "*" + std::to_string(kSize) + "\r\n";
+  for (std::size_t i = 0; i < kSize; ++i) {
+    const auto value = "value" + std::to_string(i);
+    resp += "$" + std::to_string(value.size()) + "\r\n" + value + "\r\n";
+  }
+
+  auto reader = MakeArenaReader();
+  ReaderReply reply(*reader, resp);
+  const auto data = redis::ExtractArenaReply(reply.Get());
+  ASSERT_EQ(data.GetSize(), kSize);
+  EXPECT_EQ(data[0].GetString(), "value0");
+  EXPECT_EQ(data[kSize - 1].GetString(), "value" + std::to_string(kSize - 1));
+}
+
+TEST(ReplyReader, PartialReplyIsFreed) {
+  auto reader = MakeArenaReader();
+  const std::string partial = "*3\r\n$5\r\nhello\r\n*2\r\n:1\r\n";
+  ASSERT_EQ(redisReaderFeed(reader.get(), partial.data(), partial.size()),
+            REDIS_OK);
+  void* reply = nullptr;
+  ASSERT_EQ(redisReaderGetReply(reader.get(), &reply), REDIS_OK);
+  EXPECT_EQ(reply, nullptr);
+
+  // The reader frees the unfinished tree on a protocol error or on
+  // destruction, the sanitizers check it
+  const std::string garbage = "?\r\n";
+  redisReaderFeed(reader.get(), garbage.data(), garbage.size());
+  EXPECT_EQ(redisReaderGetReply(reader.get(), &reply), REDIS_ERR);
+}
+
+TEST(ReplyReader, ViewOutlivesReader) {
+  const std::string long_value(2000, 'l');
+  redis::ReplyPtr reply;
+  {
+    auto reader = MakeArenaReader();
+    ReaderReply reader_reply(
+        *reader, "*3\r\n$5\r\nshort\r\n$2000\r\n" + long_value +
+                     "\r\n*2\r\n:7\r\n$-1\r\n");
+    reply = reader_reply.Take("mget");
+  }
+
+  const auto view = reply->GetView();
+  ASSERT_TRUE(view.IsArray());
+  ASSERT_EQ(view.GetArraySize(), 3u);
+  EXPECT_EQ(view[0].GetString(), "short");
+  // NUL-terminated as the hiredis strings
+  EXPECT_EQ(view[0].GetString().data()[5], '\0');
+  EXPECT_EQ(view[1].GetString(), long_value);
+  ASSERT_TRUE(view[2].IsArray());
+  EXPECT_EQ(view[2][0].GetInt(), 7);
+  EXPECT_TRUE(view[2][1].IsNil());
+  EXPECT_THROW(view[3], std::out_of_range);
+  EXPECT_EQ(view.GetSize(), 5 + long_value.size() + sizeof(int64_t) + 1);
+
+  // The same as the copying conversion
+  EXPECT_EQ(view.GetSize(), view.ToReplyData().GetSize());
+  EXPECT_EQ(view.ToDebugString(), view.ToReplyData().ToDebugString());
+  EXPECT_FALSE(reply->data);
+  reply->ConvertViewToData();
+  EXPECT_FALSE(reply->GetView());
+  ASSERT_TRUE(reply->data.IsArray());
+  EXPECT_EQ(reply->data[1].GetString(), long_value);
+}
+
+TEST(ReplyReader, ParseView) {
+  namespace sr = storages::redis;
+  auto reader = MakeArenaReader();
+  {
+    ReaderReply reader_reply(*reader,
+                             "*3\r\n$1\r\na\r\n$-1\r\n$1\r\nc\r\n");
+    const auto result =
+        sr::ParseReply<std::vector<std::optional<std::string>>>(
+            reader_reply.Take("mget"));
+    const std::vector<std::optional<std::string>> expected{"a", std::nullopt,
+                                                           "c"};
+    EXPECT_EQ(result, expected);
+  }
+  {
+    ReaderReply reader_reply(*reader,
+                             "*4\r\n$1\r\na\r\n$3\r\n1.5\r\n"
+                             "$1\r\nb\r\n$4\r\n-inf\r\n");
+    const auto result = sr::ParseReply<std::vector<sr::MemberScore>>(
+        reader_reply.Take("zrange"));
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].member, "a");
+    EXPECT_EQ(result[0].score, 1.5);
+    EXPECT_EQ(result[1].member, "b");
+    EXPECT_EQ(result[1].score, -std::numeric_limits<double>::infinity());
+  }
+  {
+    ReaderReply reader_reply(*reader,
+                             "*4\r\n$1\r\nk\r\n$1\r\nv\r\n"
+                             "$1\r\nx\r\n$1\r\ny\r\n");
+    const auto result =
+        sr::ParseReply<StringMap>(reader_reply.Take("hgetall"));
+    const StringMap expected{{"k", "v"}, {"x", "y"}};
+    EXPECT_EQ(result, expected);
+  }
+  {
+    ReaderReply reader_reply(*reader, "$5\r\nvalue\r\n");
+    EXPECT_EQ(
+        sr::ParseReply<std::optional<std::string>>(reader_reply.Take("get")),
+        "value");
+  }
+}
+
+TEST(ReplyReader, ParseViewErrors) {
+  namespace sr = storages::redis;
+  auto reader = MakeArenaReader();
+  {
+    ReaderReply reader_reply(*reader, "*2\r\n$1\r\na\r\n:1\r\n");
+    EXPECT_THROW(
+        sr::ParseReply<std::vector<std::string>>(reader_reply.Take("lrange")),
+        redis::ParseReplyException);
+  }
+  {
+    ReaderReply reader_reply(*reader,
+                             "*2\r\n$1\r\na\r\n$3\r\nabc\r\n");
+    EXPECT_THROW(sr::ParseReply<std::vector<sr::MemberScore>>(
+                     reader_reply.Take("zrange")),
+                 redis::ParseReplyException);
+  }
+  {
+    ReaderReply reader_reply(*reader, "*1\r\n$1\r\na\r\n");
+    EXPECT_THROW(sr::ParseReply<StringMap>(reader_reply.Take("hgetall")),
+                 redis::ParseReplyException);
+  }
+  {
+    ReaderReply reader_reply(*reader, "*0\r\n");
+    EXPECT_THROW(sr::ParseReply<std::string>(reader_reply.Take("get")),
+                 redis::ParseReplyException);
+  }
+}
+
+USERVER_NAMESPACE_END
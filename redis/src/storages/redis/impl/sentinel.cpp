@@ -262,6 +262,11 @@ void Sentinel::SetCommandsBufferingSettings(
   return impl_->SetCommandsBufferingSettings(commands_buffering_settings);
 }
 
+void Sentinel::EnableClientTracking(const ClientTrackingSettings& settings,
+                                    const ClientTrackingCallback& callback) {
+  impl_->EnableClientTracking(settings, callback);
+}
+
 std::vector<Request> Sentinel::MakeRequests(
     CmdArgs&& args, bool master, const CommandControl& command_control,
     size_t replies_to_skip) {
@@ -486,6 +486,13 @@ void SentinelImpl::SetCommandsBufferingSettings(
     shard->SetCommandsBufferingSettings(commands_buffering_settings);
 }
 
+void SentinelImpl::EnableClientTracking(
+    const ClientTrackingSettings& settings,
+    const ClientTrackingCallback& callback) {
+  for (auto& shard : master_shards_)
+    shard->EnableClientTracking(settings, callback);
+}
+
 void SentinelImpl::RequestUpdateClusterSlots(size_t shard) {
   current_slots_shard_ = shard;
   ev_thread_.Send(watch_cluster_slots_);
@@ -90,6 +90,8 @@ class SentinelImpl {
 
   void SetCommandsBufferingSettings(
       CommandsBufferingSettings commands_buffering_settings);
+  void EnableClientTracking(const ClientTrackingSettings& settings,
+                            const ClientTrackingCallback& callback);
 
  private:
   static constexpr const std::chrono::milliseconds cluster_slots_timeout_ =
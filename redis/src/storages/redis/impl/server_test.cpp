@@ -1,10 +1,16 @@
 #include "mock_server_test.hpp"
 
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 #include <userver/storages/redis/impl/secdist_redis.hpp>
 #include <userver/storages/redis/impl/sentinel.hpp>
 #include <userver/storages/redis/impl/thread_pools.hpp>
+#include <userver/storages/redis/parse_reply.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -138,6 +144,223 @@ TEST(Redis, PingFail) {
   PeriodicWait([&] { return !IsConnected(*redis); });
 }
 
+class ClientTrackingInvalidations final {
+ public:
+  redis::ClientTrackingCallback GetCallback() {
+    return [this](const std::vector<std::string>& keys) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      invalidations_.push_back(keys);
+    };
+  }
+
+  std::vector<std::vector<std::string>> Get() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return invalidations_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<std::vector<std::string>> invalidations_;
+};
+
+namespace {
+
+// The invalidations are redirected to the subscriber connection with the id
+// 42. HELLO has no handler, so the connections must stay in RESP2.
+MockRedisServer::HandlerPtr RegisterClientTrackingHandlers(
+    MockRedisServer& server, const std::vector<std::string>& tracking_options,
+    redis::ReplyData tracking_reply) {
+  static const std::string kChannel = "__redis__:invalidate";
+  server.RegisterPingHandler();
+  server.RegisterHandlerWithConstReply("CLIENT", {"ID"}, redis::ReplyData{42});
+  server.RegisterHandlerWithConstReply(
+      "SUBSCRIBE", {kChannel},
+      redis::ReplyData::Array{redis::ReplyData{"subscribe"},
+                              redis::ReplyData{kChannel}, redis::ReplyData{1}});
+  // Pings of the subscriber connection
+  server.RegisterHandlerWithConstReply(
+      "SUBSCRIBE", {"_ping_dummy_ch"},
+      redis::ReplyData::Array{redis::ReplyData{"subscribe"},
+                              redis::ReplyData{"_ping_dummy_ch"},
+                              redis::ReplyData{2}});
+  server.RegisterHandlerWithConstReply(
+      "UNSUBSCRIBE", {"_ping_dummy_ch"},
+      redis::ReplyData::Array{redis::ReplyData{"unsubscribe"},
+                              redis::ReplyData{"_ping_dummy_ch"},
+                              redis::ReplyData{1}});
+
+  std::vector<std::string> tracking_args{"TRACKING", "ON", "REDIRECT", "42"};
+  tracking_args.insert(tracking_args.end(), tracking_options.begin(),
+                       tracking_options.end());
+  return server.RegisterHandlerWithConstReply("CLIENT", tracking_args,
+                                              std::move(tracking_reply));
+}
+
+redis::ReplyPtr RequestReply(redis::Redis& redis, redis::CmdArgs&& args) {
+  std::promise<redis::ReplyPtr> promise;
+  auto future = promise.get_future();
+  redis.AsyncCommand(redis::PrepareCommand(
+      std::move(args),
+      [&promise](const redis::CommandPtr&, redis::ReplyPtr reply) {
+        promise.set_value(std::move(reply));
+      }));
+  EXPECT_EQ(future.wait_for(kSmallPeriod), std::future_status::ready);
+  return future.get();
+}
+
+}  // namespace
+
+TEST(Redis, ClientTracking) {
+  MockRedisServer server;
+  auto tracking_handler = RegisterClientTrackingHandlers(
+      server, {"BCAST", "PREFIX", "user:"},
+      redis::ReplyData::CreateStatus("OK"));
+
+  ClientTrackingInvalidations invalidations;
+  auto pool = std::make_shared<redis::ThreadPools>(1, 1);
+  auto redis =
+      std::make_shared<redis::Redis>(pool->GetRedisThreadPool(), false);
+  redis->EnableClientTracking({{"user:"}}, invalidations.GetCallback());
+  redis->Connect(kLocalhost, server.GetPort(), redis::Password(""));
+
+  EXPECT_TRUE(tracking_handler->WaitForFirstReply(kSmallPeriod));
+  PeriodicWait([&] { return IsConnected(*redis); });
+
+  redis::ReplyData::Array keys{redis::ReplyData{"user:1"},
+                               redis::ReplyData{"user:2"}};
+  server.Publish("__redis__:invalidate", redis::ReplyData{std::move(keys)});
+  // FLUSHALL
+  server.Publish("__redis__:invalidate", redis::ReplyData::CreateNil());
+
+  // Everything is invalidated when the tracking is enabled
+  const std::vector<std::vector<std::string>> expected{
+      {}, {"user:1", "user:2"}, {}};
+  PeriodicWait([&] { return invalidations.Get().size() == expected.size(); });
+  EXPECT_EQ(invalidations.Get(), expected);
+  EXPECT_TRUE(IsConnected(*redis));
+}
+
+TEST(Redis, ClientTrackingUnsupported) {
+  MockRedisServer server;
+  auto tracking_handler = RegisterClientTrackingHandlers(
+      server, {},
+      redis::ReplyData::CreateError("ERR Unknown subcommand 'TRACKING'"));
+
+  ClientTrackingInvalidations invalidations;
+  auto pool = std::make_shared<redis::ThreadPools>(1, 1);
+  auto redis =
+      std::make_shared<redis::Redis>(pool->GetRedisThreadPool(), false);
+  redis->EnableClientTracking({}, invalidations.GetCallback());
+  redis->Connect(kLocalhost, server.GetPort(), redis::Password(""));
+
+  // Old servers are still usable without the tracking
+  EXPECT_TRUE(tracking_handler->WaitForFirstReply(kSmallPeriod));
+  PeriodicWait([&] { return IsConnected(*redis); });
+  EXPECT_TRUE(invalidations.Get().empty());
+}
+
+TEST(Redis, ClientTrackingWithScores) {
+  MockRedisServer server;
+  auto tracking_handler = RegisterClientTrackingHandlers(
+      server, {}, redis::ReplyData::CreateStatus("OK"));
+  server.RegisterHandlerWithConstReply(
+      "ZRANGE", {"key", "0", "-1", "WITHSCORES"},
+      redis::ReplyData::Array{redis::ReplyData{"one"}, redis::ReplyData{"1"},
+                              redis::ReplyData{"two"},
+                              redis::ReplyData{"2.5"}});
+
+  ClientTrackingInvalidations invalidations;
+  auto pool = std::make_shared<redis::ThreadPools>(1, 1);
+  auto redis =
+      std::make_shared<redis::Redis>(pool->GetRedisThreadPool(), false);
+  redis->EnableClientTracking({}, invalidations.GetCallback());
+  redis->Connect(kLocalhost, server.GetPort(), redis::Password(""));
+
+  EXPECT_TRUE(tracking_handler->WaitForFirstReply(kSmallPeriod));
+  PeriodicWait([&] { return IsConnected(*redis); });
+
+  // RESP3 would reply with [member, score] pairs
+  auto reply =
+      RequestReply(*redis, {"ZRANGE", "key", "0", "-1", "WITHSCORES"});
+  const std::vector<storages::redis::MemberScore> expected{{"one", 1.0},
+                                                           {"two", 2.5}};
+  EXPECT_EQ(
+      storages::redis::ParseReply<std::vector<storages::redis::MemberScore>>(
+          reply),
+      expected);
+}
+
+TEST(Redis, ClientTrackingXread) {
+  MockRedisServer server;
+  auto tracking_handler = RegisterClientTrackingHandlers(
+      server, {}, redis::ReplyData::CreateStatus("OK"));
+  redis::ReplyData::Array entry{
+      redis::ReplyData{"1-0"},
+      redis::ReplyData{redis::ReplyData::Array{redis::ReplyData{"field"},
+                                               redis::ReplyData{"value"}}}};
+  redis::ReplyData::Array stream{
+      redis::ReplyData{"stream"},
+      redis::ReplyData{redis::ReplyData::Array{
+          redis::ReplyData{std::move(entry)}}}};
+  server.RegisterHandlerWithConstReply(
+      "XREAD", {"STREAMS", "stream", "0"},
+      redis::ReplyData::Array{redis::ReplyData{std::move(stream)}});
+
+  ClientTrackingInvalidations invalidations;
+  auto pool = std::make_shared<redis::ThreadPools>(1, 1);
+  auto redis =
+      std::make_shared<redis::Redis>(pool->GetRedisThreadPool(), false);
+  redis->EnableClientTracking({}, invalidations.GetCallback());
+  redis->Connect(kLocalhost, server.GetPort(), redis::Password(""));
+
+  EXPECT_TRUE(tracking_handler->WaitForFirstReply(kSmallPeriod));
+  PeriodicWait([&] { return IsConnected(*redis); });
+
+  // RESP3 would reply with a map of the streams
+  auto reply = RequestReply(*redis, {"XREAD", "STREAMS", "stream", "0"});
+  ASSERT_TRUE(reply->IsOk());
+  ASSERT_TRUE(reply->data.IsArray());
+  const auto& streams = reply->data.GetArray();
+  ASSERT_EQ(streams.size(), 1u);
+  ASSERT_TRUE(streams[0].IsArray());
+  ASSERT_EQ(streams[0].GetArray().size(), 2u);
+  EXPECT_EQ(streams[0].GetArray()[0].GetString(), "stream");
+  const auto& entries = streams[0].GetArray()[1];
+  ASSERT_TRUE(entries.IsArray());
+  ASSERT_EQ(entries.GetArray().size(), 1u);
+  EXPECT_EQ(entries.GetArray()[0].GetArray()[0].GetString(), "1-0");
+}
+
+TEST(Redis, SingleFlight) {
+  MockRedisServer server;
+  auto ping_handler = server.RegisterPingHandler();
+  // Keeps the first GET in flight while the second one is sent
+  auto get_handler = server.RegisterTimeoutHandler("GET", kWaitPeriod * 10);
+
+  auto pool = std::make_shared<redis::ThreadPools>(1, 1);
+  auto redis =
+      std::make_shared<redis::Redis>(pool->GetRedisThreadPool(), false);
+  redis::CommandsBufferingSettings buffering_settings;
+  buffering_settings.single_flight = true;
+  redis->SetCommandsBufferingSettings(buffering_settings);
+  redis->Connect(kLocalhost, server.GetPort(), redis::Password(""));
+
+  EXPECT_TRUE(ping_handler->WaitForFirstReply(kSmallPeriod));
+  PeriodicWait([&] { return IsConnected(*redis); });
+
+  std::atomic<int> replies{0};
+  for (int i = 0; i < 2; ++i) {
+    redis->AsyncCommand(redis::PrepareCommand(
+        {"GET", "key"}, [&replies](const redis::CommandPtr&,
+                                   redis::ReplyPtr reply) {
+          if (reply->IsOk()) ++replies;
+        }));
+  }
+
+  PeriodicWait([&] { return replies.load() == 2; });
+  EXPECT_EQ(get_handler->GetReplyCount(), 1);
+}
+
 class RedisDisconnectingReplies : public ::testing::TestWithParam<const char*> {
 };
 
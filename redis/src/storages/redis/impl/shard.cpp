@@ -284,6 +284,9 @@ bool Shard::ProcessCreation(
     if (auto commands_buffering_settings = commands_buffering_settings_.Get())
       entry.instance->SetCommandsBufferingSettings(
           *commands_buffering_settings);
+    if (auto client_tracking = client_tracking_.Get())
+      entry.instance->EnableClientTracking(client_tracking->settings,
+                                           client_tracking->callback);
     auto server_id = entry.instance->GetServerId();
     entry.instance->signal_state_change.connect(
         [this, server_id](Redis::State state) {
@@ -426,6 +429,22 @@ void Shard::SetCommandsBufferingSettings(
       std::make_shared<CommandsBufferingSettings>(commands_buffering_settings));
 }
 
+void Shard::EnableClientTracking(const ClientTrackingSettings& settings,
+                                 const ClientTrackingCallback& callback) {
+  // Set before walking the instances for the ones being created right now,
+  // enabling the tracking twice is a no-op
+  client_tracking_.Set(
+      std::make_shared<ClientTracking>(ClientTracking{settings, callback}));
+
+  std::shared_lock lock(mutex_);
+  for (const auto& instance : instances_) {
+    instance.instance->EnableClientTracking(settings, callback);
+  }
+  for (const auto& instance : clean_wait_) {
+    instance.instance->EnableClientTracking(settings, callback);
+  }
+}
+
 std::vector<ConnectionInfoInt> Shard::GetConnectionInfosToCreate() const {
   std::shared_lock lock(mutex_);
 
@@ -94,7 +94,15 @@ class Shard {
   void SetCommandsBufferingSettings(
       CommandsBufferingSettings commands_buffering_settings);
 
+  void EnableClientTracking(const ClientTrackingSettings& settings,
+                            const ClientTrackingCallback& callback);
+
  private:
+  struct ClientTracking {
+    ClientTrackingSettings settings;
+    ClientTrackingCallback callback;
+  };
+
   std::vector<unsigned char> GetAvailableServers(
       const CommandControl& command_control, bool with_masters,
       bool with_slaves) const;
@@ -126,6 +134,7 @@ class Shard {
   boost::signals2::signal<void(ServerId, bool)> signal_instance_ready_;
 
   utils::SwappingSmart<CommandsBufferingSettings> commands_buffering_settings_;
+  utils::SwappingSmart<ClientTracking> client_tracking_;
 
   bool prev_connected_ = false;
   const bool cluster_mode_ = false;
@@ -0,0 +1,154 @@
+#include "near_cache.hpp"
+
+#include <algorithm>
+#include <functional>
+
+#include <userver/utils/assert.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+namespace {
+
+// Spreads the lock contention of the hot keys
+constexpr std::size_t kWays = 16;
+
+}  // namespace
+
+NearCacheSettings Parse(const yaml_config::YamlConfig& value,
+                        formats::parse::To<NearCacheSettings>) {
+  NearCacheSettings settings;
+  settings.max_size = value["max_size"].As<std::size_t>(settings.max_size);
+  settings.max_value_size =
+      value["max_value_size"].As<std::size_t>(settings.max_value_size);
+  settings.max_fields_per_key =
+      value["max_fields_per_key"].As<std::size_t>(settings.max_fields_per_key);
+  settings.ttl = value["ttl"].As<std::chrono::milliseconds>(settings.ttl);
+  settings.prefixes = value["prefixes"].As<std::vector<std::string>>({});
+  return settings;
+}
+
+NearCache::NearCache(const NearCacheSettings& settings) : settings_(settings) {
+  UASSERT(settings_.max_size > 0);
+  const auto way_size = std::max<std::size_t>(settings_.max_size / kWays, 1);
+  ways_.reserve(kWays);
+  for (std::size_t i = 0; i < kWays; ++i) {
+    ways_.push_back(std::make_unique<Way>(way_size));
+  }
+}
+
+NearCache::Generation NearCache::GetGeneration() const noexcept {
+  return generation_.load();
+}
+
+std::optional<USERVER_NAMESPACE::redis::ReplyData> NearCache::GetValue(
+    const std::string& key) {
+  auto& way = GetWay(key);
+  std::lock_guard lock(way.mutex);
+  auto* entry = way.entries.Get(key);
+  return AccountLookup(entry && entry->value ? &*entry->value : nullptr);
+}
+
+std::optional<USERVER_NAMESPACE::redis::ReplyData> NearCache::GetField(
+    const std::string& key, const std::string& field) {
+  auto& way = GetWay(key);
+  std::lock_guard lock(way.mutex);
+  auto* entry = way.entries.Get(key);
+  if (!entry) return AccountLookup(nullptr);
+  const auto it = entry->fields.find(field);
+  return AccountLookup(it == entry->fields.end() ? nullptr : &it->second);
+}
+
+void NearCache::PutValue(const std::string& key,
+                         const USERVER_NAMESPACE::redis::ReplyData& value,
+                         Generation generation) {
+  if (!IsCacheable(value)) return;
+
+  auto& way = GetWay(key);
+  std::lock_guard lock(way.mutex);
+  // Invalidate() bumps the generation before taking the lock, so the stale
+  // value is either rejected here or dropped by the invalidation afterwards
+  if (generation != generation_.load()) return;
+  way.entries.Emplace(key)->value =
+      CachedReply{value, Clock::now() + settings_.ttl};
+}
+
+void NearCache::PutField(const std::string& key, const std::string& field,
+                         const USERVER_NAMESPACE::redis::ReplyData& value,
+                         Generation generation) {
+  if (!IsCacheable(value)) return;
+
+  auto& way = GetWay(key);
+  std::lock_guard lock(way.mutex);
+  if (generation != generation_.load()) return;
+  auto& fields = way.entries.Emplace(key)->fields;
+  if (fields.size() >= settings_.max_fields_per_key && !fields.count(field)) {
+    return;
+  }
+  fields.insert_or_assign(field,
+                          CachedReply{value, Clock::now() + settings_.ttl});
+}
+
+void NearCache::Invalidate(const std::vector<std::string>& keys) {
+  ++generation_;
+
+  if (keys.empty()) {
+    ++flushes_;
+    for (auto& way : ways_) {
+      std::lock_guard lock(way->mutex);
+      way->entries.Clear();
+    }
+    return;
+  }
+
+  invalidations_ += keys.size();
+  for (const auto& key : keys) {
+    auto& way = GetWay(key);
+    std::lock_guard lock(way.mutex);
+    way.entries.Erase(key);
+  }
+}
+
+USERVER_NAMESPACE::redis::ClientTrackingSettings
+NearCache::GetTrackingSettings() const {
+  return {settings_.prefixes};
+}
+
+NearCacheStatistics NearCache::GetStatistics() const {
+  NearCacheStatistics stats;
+  stats.hits = hits_.load();
+  stats.misses = misses_.load();
+  stats.invalidations = invalidations_.load();
+  stats.flushes = flushes_.load();
+  for (const auto& way : ways_) {
+    std::lock_guard lock(way->mutex);
+    stats.size += way->entries.GetSize();
+  }
+  return stats;
+}
+
+NearCache::Way& NearCache::GetWay(const std::string& key) {
+  return *ways_[std::hash<std::string>{}(key) % ways_.size()];
+}
+
+bool NearCache::IsCacheable(
+    const USERVER_NAMESPACE::redis::ReplyData& value) const {
+  return value.IsNil() ||
+         (value.IsString() &&
+          value.GetString().size() <= settings_.max_value_size);
+}
+
+std::optional<USERVER_NAMESPACE::redis::ReplyData> NearCache::AccountLookup(
+    const CachedReply* cached) {
+  if (!cached || cached->expires_at <= Clock::now()) {
+    ++misses_;
+    return std::nullopt;
+  }
+  ++hits_;
+  return cached->data;
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
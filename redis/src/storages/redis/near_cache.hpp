@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/formats/parse/to.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+#include <userver/storages/redis/impl/base.hpp>
+#include <userver/storages/redis/impl/reply.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+struct NearCacheSettings {
+  /// Max count of the cached keys, the cache is disabled if 0
+  std::size_t max_size{0};
+  /// Longer values are not cached
+  std::size_t max_value_size{4096};
+  /// Max count of the cached HGET fields of a key
+  std::size_t max_fields_per_key{64};
+  /// Entries are re-read from Redis after the TTL even if no invalidation
+  /// came, bounds the staleness if an invalidation is lost
+  std::chrono::milliseconds ttl{std::chrono::seconds{60}};
+  /// Tracked key prefixes (BCAST mode), the keys read by the connections are
+  /// tracked if empty
+  std::vector<std::string> prefixes;
+};
+
+NearCacheSettings Parse(const yaml_config::YamlConfig& value,
+                        formats::parse::To<NearCacheSettings>);
+
+struct NearCacheStatistics {
+  std::uint64_t hits{0};
+  std::uint64_t misses{0};
+  std::uint64_t invalidations{0};
+  std::uint64_t flushes{0};
+  std::size_t size{0};
+};
+
+/// @brief Client side cache of the GET and HGET replies, invalidated by the
+/// server with CLIENT TRACKING.
+///
+/// A reply is stored only if no invalidation happened since the request was
+/// sent, see GetGeneration(). Thread safe, invalidations come from the ev
+/// threads.
+class NearCache final {
+ public:
+  using Generation = std::uint64_t;
+
+  explicit NearCache(const NearCacheSettings& settings);
+
+  NearCache(const NearCache&) = delete;
+  NearCache& operator=(const NearCache&) = delete;
+
+  /// Must be taken before sending the request which reply is stored
+  Generation GetGeneration() const noexcept;
+
+  /// Cached GET reply (a string or a nil), std::nullopt on a miss
+  std::optional<USERVER_NAMESPACE::redis::ReplyData> GetValue(
+      const std::string& key);
+
+  /// Cached HGET reply (a string or a nil), std::nullopt on a miss
+  std::optional<USERVER_NAMESPACE::redis::ReplyData> GetField(
+      const std::string& key, const std::string& field);
+
+  void PutValue(const std::string& key,
+                const USERVER_NAMESPACE::redis::ReplyData& value,
+                Generation generation);
+
+  void PutField(const std::string& key, const std::string& field,
+                const USERVER_NAMESPACE::redis::ReplyData& value,
+                Generation generation);
+
+  /// Drops the keys, drops everything if the keys are empty
+  void Invalidate(const std::vector<std::string>& keys);
+
+  /// Settings to enable the tracking with
+  USERVER_NAMESPACE::redis::ClientTrackingSettings GetTrackingSettings() const;
+
+  NearCacheStatistics GetStatistics() const;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct CachedReply {
+    USERVER_NAMESPACE::redis::ReplyData data;
+    Clock::time_point expires_at;
+  };
+
+  struct Entry {
+    std::optional<CachedReply> value;
+    std::unordered_map<std::string, CachedReply> fields;
+  };
+
+  struct Way {
+    explicit Way(std::size_t max_size) : entries(max_size) {}
+
+    std::mutex mutex;
+    cache::LruMap<std::string, Entry> entries;
+  };
+
+  Way& GetWay(const std::string& key);
+  bool IsCacheable(const USERVER_NAMESPACE::redis::ReplyData& value) const;
+  std::optional<USERVER_NAMESPACE::redis::ReplyData> AccountLookup(
+      const CachedReply* cached);
+
+  const NearCacheSettings settings_;
+  std::vector<std::unique_ptr<Way>> ways_;
+  std::atomic<Generation> generation_{0};
+
+  std::atomic<std::uint64_t> hits_{0};
+  std::atomic<std::uint64_t> misses_{0};
+  std::atomic<std::uint64_t> invalidations_{0};
+  std::atomic<std::uint64_t> flushes_{0};
+};
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
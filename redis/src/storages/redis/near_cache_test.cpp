@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+
+#include "near_cache.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using storages::redis::NearCache;
+using storages::redis::NearCacheSettings;
+using ReplyData = USERVER_NAMESPACE::redis::ReplyData;
+
+NearCacheSettings MakeSettings() {
+  NearCacheSettings settings;
+  settings.max_size = 1024;
+  return settings;
+}
+
+}  // namespace
+
+TEST(NearCache, GetValue) {
+  NearCache cache(MakeSettings());
+  EXPECT_FALSE(cache.GetValue("key"));
+
+  cache.PutValue("key", ReplyData{"value"}, cache.GetGeneration());
+  cache.PutValue("missing", ReplyData::CreateNil(), cache.GetGeneration());
+
+  const auto value = cache.GetValue("key");
+  ASSERT_TRUE(value);
+  EXPECT_EQ(value->GetString(), "value");
+  const auto missing = cache.GetValue("missing");
+  ASSERT_TRUE(missing);
+  EXPECT_TRUE(missing->IsNil());
+
+  const auto stats = cache.GetStatistics();
+  EXPECT_EQ(stats.hits, 2);
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.size, 2);
+}
+
+TEST(NearCache, GetField) {
+  auto settings = MakeSettings();
+  settings.max_fields_per_key = 1;
+  NearCache cache(settings);
+
+  cache.PutField("key", "field", ReplyData{"value"}, cache.GetGeneration());
+  cache.PutField("key", "other", ReplyData{"value"}, cache.GetGeneration());
+
+  const auto value = cache.GetField("key", "field");
+  ASSERT_TRUE(value);
+  EXPECT_EQ(value->GetString(), "value");
+  EXPECT_FALSE(cache.GetField("key", "other"));
+  EXPECT_FALSE(cache.GetValue("key"));
+}
+
+TEST(NearCache, NotCacheable) {
+  auto settings = MakeSettings();
+  settings.max_value_size = 4;
+  NearCache cache(settings);
+
+  cache.PutValue("long", ReplyData{"value"}, cache.GetGeneration());
+  cache.PutValue("error", ReplyData::CreateError("ERR"), cache.GetGeneration());
+  cache.PutValue("integer", ReplyData{42}, cache.GetGeneration());
+
+  EXPECT_FALSE(cache.GetValue("long"));
+  EXPECT_FALSE(cache.GetValue("error"));
+  EXPECT_FALSE(cache.GetValue("integer"));
+  EXPECT_EQ(cache.GetStatistics().size, 0);
+}
+
+TEST(NearCache, Invalidate) {
+  NearCache cache(MakeSettings());
+  cache.PutValue("a", ReplyData{"1"}, cache.GetGeneration());
+  cache.PutValue("b", ReplyData{"2"}, cache.GetGeneration());
+  cache.PutField("b", "field", ReplyData{"3"}, cache.GetGeneration());
+
+  cache.Invalidate({"b"});
+  EXPECT_TRUE(cache.GetValue("a"));
+  EXPECT_FALSE(cache.GetValue("b"));
+  EXPECT_FALSE(cache.GetField("b", "field"));
+
+  cache.Invalidate({});
+  EXPECT_FALSE(cache.GetValue("a"));
+
+  const auto stats = cache.GetStatistics();
+  EXPECT_EQ(stats.invalidations, 1);
+  EXPECT_EQ(stats.flushes, 1);
+  EXPECT_EQ(stats.size, 0);
+}
+
+TEST(NearCache, InvalidatedWhileInFlight) {
+  NearCache cache(MakeSettings());
+
+  // The reply may be older than the invalidation
+  const auto generation = cache.GetGeneration();
+  cache.Invalidate({"other"});
+  cache.PutValue("key", ReplyData{"stale"}, generation);
+  EXPECT_FALSE(cache.GetValue("key"));
+
+  cache.PutValue("key", ReplyData{"fresh"}, cache.GetGeneration());
+  EXPECT_TRUE(cache.GetValue("key"));
+}
+
+TEST(NearCache, Ttl) {
+  auto settings = MakeSettings();
+  settings.ttl = std::chrono::milliseconds{0};
+  NearCache cache(settings);
+
+  cache.PutValue("key", ReplyData{"value"}, cache.GetGeneration());
+  EXPECT_FALSE(cache.GetValue("key"));
+}
+
+TEST(NearCache, MaxSize) {
+  auto settings = MakeSettings();
+  settings.max_size = 1;
+  NearCache cache(settings);
+
+  for (int i = 0; i < 1000; ++i) {
+    cache.PutValue(std::to_string(i), ReplyData{"value"},
+                   cache.GetGeneration());
+  }
+  // One key per way at most
+  EXPECT_LE(cache.GetStatistics().size, 16);
+}
+
+TEST(NearCache, TrackingSettings) {
+  auto settings = MakeSettings();
+  settings.prefixes = {"user:", "session:"};
+  NearCache cache(settings);
+  EXPECT_EQ(cache.GetTrackingSettings().prefixes, settings.prefixes);
+}
+
+USERVER_NAMESPACE_END
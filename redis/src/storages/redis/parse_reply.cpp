@@ -1,5 +1,8 @@
 #include <userver/storages/redis/parse_reply.hpp>
 
+#include <cerrno>
+#include <cstdlib>
+
 #include <userver/storages/redis/reply.hpp>
 #include <userver/utils/from_string.hpp>
 
@@ -65,11 +68,72 @@ Point ParsePointArray(const redis::ReplyData& elem,
   }
 }
 
+std::string_view GetStringElem(ReplyDataView array_data, size_t elem_idx,
+                               const std::string& request_description) {
+  const auto elem = array_data[elem_idx];
+  if (!elem.IsString()) {
+    throw USERVER_NAMESPACE::redis::ParseReplyException(
+        "Unexpected redis reply type to '" + request_description +
+        "' request: " + "array[" + std::to_string(elem_idx) + "]: expected " +
+        ReplyData::TypeToString(ReplyData::Type::kString) +
+        ", got type=" + elem.GetTypeString() + " elem=" + elem.ToDebugString() +
+        " array=" + array_data.ToDebugString());
+  }
+  return elem.GetString();
+}
+
+// Same checks as ReplyData::GetKeyValues()
+void ExpectKeyValues(ReplyDataView array_data,
+                     const std::string& request_description) {
+  const auto size = array_data.GetArraySize();
+  std::string error;
+  if (size & 1) {
+    error = "Array size is odd: " + std::to_string(size);
+  } else {
+    for (size_t i = 0; i < size; ++i) {
+      const auto elem = array_data[i];
+      if (!elem.IsString()) {
+        error = "Non-string element (" + elem.GetTypeString() + ')';
+        break;
+      }
+    }
+  }
+  if (!error.empty()) {
+    throw USERVER_NAMESPACE::redis::ParseReplyException(
+        "Can't parse response to '" + request_description +
+        "' request: " + error);
+  }
+}
+
+// The view strings are NUL-terminated, so strtod reads them in place. Accepts
+// the same input as std::stod.
+double ParseScore(std::string_view score, ReplyDataView array_data,
+                  const std::string& request_description) {
+  char* end = nullptr;
+  errno = 0;
+  const double result = std::strtod(score.data(), &end);
+  if (end == score.data() || errno == ERANGE) {
+    throw USERVER_NAMESPACE::redis::ParseReplyException(
+        std::string("Can't parse response to '")
+            .append(request_description)
+            .append("' request: can't parse score from '")
+            .append(score)
+            .append("' array=")
+            .append(array_data.ToDebugString()));
+  }
+  return result;
+}
+
 }  // namespace
 
 namespace impl {
 
-ReplyData&& ExtractData(ReplyPtr& reply) { return std::move(reply->data); }
+ReplyData&& ExtractData(ReplyPtr& reply) {
+  reply->ConvertViewToData();
+  return std::move(reply->data);
+}
+
+ReplyDataView GetView(const ReplyPtr& reply) { return reply->GetView(); }
 
 bool IsNil(const ReplyData& reply_data) { return reply_data.IsNil(); }
 
@@ -383,6 +447,90 @@ ReplyData Parse(ReplyData&& reply_data, const std::string&, To<ReplyData>) {
   return std::move(reply_data);
 }
 
+std::string Parse(ReplyDataView reply_data,
+                  const std::string& request_description, To<std::string>) {
+  reply_data.ExpectString(request_description);
+  return std::string{reply_data.GetString()};
+}
+
+std::optional<std::string> Parse(ReplyDataView reply_data,
+                                 const std::string& request_description,
+                                 To<std::optional<std::string>>) {
+  if (reply_data.IsNil()) return std::nullopt;
+  return Parse(reply_data, request_description, To<std::string>{});
+}
+
+std::vector<std::string> Parse(ReplyDataView reply_data,
+                               const std::string& request_description,
+                               To<std::vector<std::string>>) {
+  reply_data.ExpectArray(request_description);
+
+  const auto size = reply_data.GetArraySize();
+  std::vector<std::string> result;
+  result.reserve(size);
+
+  for (size_t elem_idx = 0; elem_idx < size; ++elem_idx) {
+    result.emplace_back(
+        GetStringElem(reply_data, elem_idx, request_description));
+  }
+  return result;
+}
+
+std::vector<std::optional<std::string>> Parse(
+    ReplyDataView reply_data, const std::string& request_description,
+    To<std::vector<std::optional<std::string>>>) {
+  reply_data.ExpectArray(request_description);
+
+  const auto size = reply_data.GetArraySize();
+  std::vector<std::optional<std::string>> result;
+  result.reserve(size);
+
+  for (size_t elem_idx = 0; elem_idx < size; ++elem_idx) {
+    if (reply_data[elem_idx].IsNil()) {
+      result.emplace_back(std::nullopt);
+      continue;
+    }
+    result.emplace_back(
+        GetStringElem(reply_data, elem_idx, request_description));
+  }
+  return result;
+}
+
+std::vector<MemberScore> Parse(ReplyDataView reply_data,
+                               const std::string& request_description,
+                               To<std::vector<MemberScore>>) {
+  reply_data.ExpectArray(request_description);
+  ExpectKeyValues(reply_data, request_description);
+
+  const auto size = reply_data.GetArraySize();
+  std::vector<MemberScore> result;
+  result.reserve(size / 2);
+
+  for (size_t i = 0; i < size; i += 2) {
+    const auto score = ParseScore(reply_data[i + 1].GetString(), reply_data,
+                                  request_description);
+    result.emplace_back(std::string{reply_data[i].GetString()}, score);
+  }
+  return result;
+}
+
+std::unordered_map<std::string, std::string> Parse(
+    ReplyDataView reply_data, const std::string& request_description,
+    To<std::unordered_map<std::string, std::string>>) {
+  reply_data.ExpectArray(request_description);
+  ExpectKeyValues(reply_data, request_description);
+
+  const auto size = reply_data.GetArraySize();
+  std::unordered_map<std::string, std::string> result;
+  result.reserve(size / 2);
+
+  for (size_t i = 0; i < size; i += 2) {
+    result[std::string{reply_data[i].GetString()}] =
+        reply_data[i + 1].GetString();
+  }
+  return result;
+}
+
 }  // namespace storages::redis
 
 USERVER_NAMESPACE_END
@@ -91,6 +91,8 @@ USERVER_NAMESPACE::redis::CommandsBufferingSettings Parse(
       elem["commands_buffering_threshold"].As<size_t>(0);
   result.watch_command_timer_interval = std::chrono::microseconds(
       elem["watch_command_timer_interval_us"].As<size_t>());
+  result.adaptive_buffering = elem["adaptive_buffering"].As<bool>(false);
+  result.single_flight = elem["single_flight"].As<bool>(false);
   return result;
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 
@@ -70,7 +71,39 @@ class RequestDataImpl final : public RequestDataImplBase,
     return ParseReply<Result, ReplyType>(std::move(reply), request_description);
   }
 
-  ReplyPtr GetRaw() override { return GetReply(); }
+  ReplyPtr GetRaw() override {
+    auto reply = GetReply();
+    reply->ConvertViewToData();
+    return reply;
+  }
+};
+
+/// Hands the successful reply over to the near cache before parsing it
+template <typename Result, typename ReplyType>
+class CachingRequestDataImpl final : public RequestDataImplBase,
+                                     public RequestDataBase<Result, ReplyType> {
+ public:
+  using StoreFunc = std::function<void(const ReplyData&)>;
+
+  CachingRequestDataImpl(USERVER_NAMESPACE::redis::Request&& request,
+                         StoreFunc store)
+      : RequestDataImplBase(std::move(request)), store_(std::move(store)) {}
+
+  void Wait() override { impl::Wait(GetRequest()); }
+
+  ReplyType Get(const std::string& request_description) override {
+    return ParseReply<Result, ReplyType>(GetRaw(), request_description);
+  }
+
+  ReplyPtr GetRaw() override {
+    auto reply = GetReply();
+    reply->ConvertViewToData();
+    if (reply->IsOk()) store_(reply->data);
+    return reply;
+  }
+
+ private:
+  StoreFunc store_;
 };
 
 template <typename Result, typename ReplyType>
@@ -19,6 +19,16 @@ Request<Result, ReplyType> CreateRequest(
       std::make_unique<RequestDataImpl<Result, ReplyType>>(std::move(request)));
 }
 
+template <typename Result, typename ReplyType = DefaultReplyType<Result>>
+Request<Result, ReplyType> CreateCachingRequest(
+    USERVER_NAMESPACE::redis::Request&& request,
+    typename CachingRequestDataImpl<Result, ReplyType>::StoreFunc&& store,
+    Request<Result, ReplyType>* /* for ADL */) {
+  return Request<Result, ReplyType>(
+      std::make_unique<CachingRequestDataImpl<Result, ReplyType>>(
+          std::move(request), std::move(store)));
+}
+
 template <typename Result, typename ReplyType = DefaultReplyType<Result>>
 Request<Result, ReplyType> CreateAggregateRequest(
     std::vector<USERVER_NAMESPACE::redis::Request>&& requests,
@@ -50,6 +60,14 @@ Request CreateRequest(USERVER_NAMESPACE::redis::Request&& request) {
   return impl::CreateRequest(std::move(request), tmp);
 }
 
+template <typename Request, typename StoreFunc>
+Request CreateCachingRequest(USERVER_NAMESPACE::redis::Request&& request,
+                             StoreFunc&& store) {
+  Request* tmp = nullptr;
+  return impl::CreateCachingRequest(std::move(request),
+                                    std::forward<StoreFunc>(store), tmp);
+}
+
 template <typename Request>
 Request CreateAggregateRequest(
     std::vector<USERVER_NAMESPACE::redis::Request>&& requests) {
@@ -53,6 +53,7 @@ USERVER_BUILDDEPS=" \
   libpq-dev \
   libssl-dev \
   libyaml-cpp-dev \
+  libzstd-dev \
   libyandex-clickhousecpp \
   libyandex-taxi-c-ares-dev \
   libyandex-taxi-curl4-openssl-dev \
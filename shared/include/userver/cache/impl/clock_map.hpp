@@ -0,0 +1,182 @@
+#pragma once
+
+#include <atomic>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Key value storage with CLOCK (second chance) eviction.
+///
+/// Unlike LRU, a hit does not reorder anything: it only sets an atomic access
+/// bit of the entry. Get() and GetOr() are const and may be called
+/// concurrently with each other, all the other member functions require
+/// exclusive access. That allows serving the hits under a shared lock.
+template <typename T, typename U, typename Hash = std::hash<T>,
+          typename Equal = std::equal_to<T>>
+class ClockMap final {
+ public:
+  explicit ClockMap(size_t max_size, const Hash& hash = Hash(),
+                    const Equal& equal = Equal())
+      : map_(max_size, hash, equal) {
+    SetMaxSize(max_size);
+  }
+
+  // Map nodes and thus ring_ pointers survive the move
+  ClockMap(ClockMap&&) noexcept = default;
+  ClockMap(const ClockMap&) = delete;
+  ClockMap& operator=(ClockMap&&) noexcept = default;
+  ClockMap& operator=(const ClockMap&) = delete;
+
+  /// Adds or rewrites key/value, marks it as accessed
+  /// @returns true if key is a new one
+  bool Put(const T& key, U value);
+
+  /// Removes key from the map
+  void Erase(const T& key);
+
+  /// Returns pointer to value if the key is in the map and marks it as
+  /// accessed; returns nullptr otherwise.
+  /// @warning Returned pointer may be freed on the next non-const map access!
+  const U* Get(const T& key) const;
+
+  /// Returns value by key and marks it as accessed; returns default_value
+  /// otherwise.
+  U GetOr(const T& key, const U& default_value) const {
+    const auto* ptr = Get(key);
+    if (ptr) return *ptr;
+    return default_value;
+  }
+
+  /// Sets the max size of the map, evicts values if new_max_size < GetSize()
+  void SetMaxSize(size_t new_max_size);
+
+  /// Removes all the elements
+  void Clear() noexcept;
+
+  /// Call Function(const T&, const U&) for all items
+  template <typename Function>
+  void VisitAll(Function&& func) const {
+    for (const auto& [key, entry] : map_) func(key, entry.value);
+  }
+
+  size_t GetSize() const { return map_.size(); }
+
+ private:
+  struct Entry {
+    explicit Entry(U&& value) : value(std::move(value)) {}
+
+    U value;
+    // Position of the entry in ring_
+    size_t position{0};
+    mutable std::atomic<bool> is_accessed{false};
+  };
+
+  using Map = std::unordered_map<T, Entry, Hash, Equal>;
+  using Node = typename Map::value_type;
+
+  size_t FindVictim() noexcept;
+  void EraseAt(size_t position);
+
+  Map map_;
+  // Map nodes are stable, ring_ stores pointers to them in the clock order
+  std::vector<Node*> ring_;
+  size_t hand_{0};
+  size_t max_size_{0};
+};
+
+template <typename T, typename U, typename Hash, typename Equal>
+bool ClockMap<T, U, Hash, Equal>::Put(const T& key, U value) {
+  const auto it = map_.find(key);
+  if (it != map_.end()) {
+    it->second.value = std::move(value);
+    it->second.is_accessed.store(true, std::memory_order_relaxed);
+    return false;
+  }
+
+  if (ring_.size() == max_size_) EraseAt(FindVictim());
+
+  auto& node = *map_.emplace(std::piecewise_construct,
+                             std::forward_as_tuple(key),
+                             std::forward_as_tuple(std::move(value)))
+                    .first;
+  node.second.position = ring_.size();
+  ring_.push_back(&node);  // capacity is reserved, does not throw
+  return true;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockMap<T, U, Hash, Equal>::Erase(const T& key) {
+  const auto it = map_.find(key);
+  if (it == map_.end()) return;
+  EraseAt(it->second.position);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+const U* ClockMap<T, U, Hash, Equal>::Get(const T& key) const {
+  const auto it = map_.find(key);
+  if (it == map_.end()) return nullptr;
+
+  // Avoid dirtying the cache line of a hot entry on every hit
+  auto& is_accessed = it->second.is_accessed;
+  if (!is_accessed.load(std::memory_order_relaxed)) {
+    is_accessed.store(true, std::memory_order_relaxed);
+  }
+  return &it->second.value;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockMap<T, U, Hash, Equal>::SetMaxSize(size_t new_max_size) {
+  UASSERT(new_max_size > 0);
+  if (!new_max_size) ++new_max_size;
+
+  while (ring_.size() > new_max_size) EraseAt(FindVictim());
+  max_size_ = new_max_size;
+  ring_.reserve(max_size_);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockMap<T, U, Hash, Equal>::Clear() noexcept {
+  ring_.clear();
+  map_.clear();
+  hand_ = 0;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+size_t ClockMap<T, U, Hash, Equal>::FindVictim() noexcept {
+  UASSERT(!ring_.empty());
+
+  // Terminates within two turns: the first one clears all the access bits.
+  // The hand stays on the victim, EraseAt() moves the next entry to examine
+  // into its position.
+  while (true) {
+    if (hand_ >= ring_.size()) hand_ = 0;
+    auto& is_accessed = ring_[hand_]->second.is_accessed;
+    if (!is_accessed.load(std::memory_order_relaxed)) return hand_;
+    is_accessed.store(false, std::memory_order_relaxed);
+    ++hand_;
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockMap<T, U, Hash, Equal>::EraseAt(size_t position) {
+  UASSERT(position < ring_.size());
+
+  auto* node = ring_[position];
+  if (position != ring_.size() - 1) {
+    ring_[position] = ring_.back();
+    ring_[position]->second.position = position;
+  }
+  ring_.pop_back();
+  map_.erase(node->first);
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,448 @@
+#pragma once
+
+/// @file userver/cache/persistent_hash_map.hpp
+/// @brief @copybrief cache::PersistentHashMap
+
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @ingroup userver_containers
+///
+/// @brief Hash map with structural sharing between copies (hash array mapped
+/// trie).
+///
+/// Copying the map is O(1): the copies share all the nodes. A modification
+/// copies only the nodes on the path from the root to the changed entry
+/// (O(log32(size)) small nodes), the rest of the trie stays shared. Nodes that
+/// are not shared with any other copy are modified in place.
+///
+/// Useful as a data type of caches with incremental updates
+/// (e.g. `CacheContainer` of components::PostgreCache): an update copies the
+/// current snapshot and applies the delta without copying the whole container,
+/// so neither the update time nor the peak memory depends on the cache size.
+///
+/// Lookups are several times slower than those of std::unordered_map because
+/// of the pointer chasing, so the map pays off for big caches that are
+/// updated incrementally.
+///
+/// Thread safety matches Standard Library thread safety: different copies may
+/// be used concurrently, even if they share nodes.
+///
+/// Values are immutable once inserted, use insert_or_assign() to change them.
+/// Any modification invalidates the iterators.
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class PersistentHashMap final {
+  struct Entry;
+  struct Node;
+  using EntryPtr = std::shared_ptr<const Entry>;
+  using NodePtr = std::shared_ptr<Node>;
+  using Slot = std::variant<EntryPtr, NodePtr>;
+
+  static constexpr unsigned kBitsPerLevel = 5;
+  static constexpr std::size_t kLevelMask = (1 << kBitsPerLevel) - 1;
+  static constexpr unsigned kHashBits = sizeof(std::size_t) * CHAR_BIT;
+  // Branch levels plus the level of collision nodes
+  static constexpr std::size_t kMaxDepth =
+      (kHashBits + kBitsPerLevel - 1) / kBitsPerLevel + 1;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const Key, Value>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = Equal;
+
+  class const_iterator;
+  using iterator = const_iterator;
+
+  PersistentHashMap() = default;
+  explicit PersistentHashMap(const Hash& hash, const Equal& equal = Equal())
+      : hash_(hash), equal_(equal) {}
+
+  /// O(1), the copies share the data
+  PersistentHashMap(const PersistentHashMap&) = default;
+  PersistentHashMap(PersistentHashMap&&) noexcept = default;
+  PersistentHashMap& operator=(const PersistentHashMap&) = default;
+  PersistentHashMap& operator=(PersistentHashMap&&) noexcept = default;
+
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  const_iterator begin() const { return const_iterator{root_.get()}; }
+  const_iterator end() const noexcept { return const_iterator{}; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  const_iterator find(const Key& key) const;
+
+  size_type count(const Key& key) const { return FindEntry(key) ? 1 : 0; }
+  bool contains(const Key& key) const { return FindEntry(key) != nullptr; }
+
+  /// @throws std::out_of_range if there is no such key
+  const Value& at(const Key& key) const;
+
+  /// Adds the key/value or replaces the value of an existing key
+  /// @returns true if the key is a new one
+  template <typename K, typename V>
+  bool insert_or_assign(K&& key, V&& value) {
+    return InsertEntry(std::make_shared<const Entry>(
+                           hash_, std::forward<K>(key), std::forward<V>(value)),
+                       /*is_assign=*/true);
+  }
+
+  /// Adds the key/value if there is no such key
+  /// @returns true if the value was inserted
+  bool insert(value_type value) {
+    if (contains(value.first)) return false;
+    auto entry = std::make_shared<const Entry>(hash_, std::move(value.first),
+                                               std::move(value.second));
+    return InsertEntry(std::move(entry), /*is_assign=*/false);
+  }
+
+  /// @returns the number of erased elements (0 or 1)
+  size_type erase(const Key& key);
+
+  void clear() noexcept {
+    root_.reset();
+    size_ = 0;
+  }
+
+  void swap(PersistentHashMap& other) noexcept {
+    using std::swap;
+    swap(root_, other.root_);
+    swap(size_, other.size_);
+    swap(hash_, other.hash_);
+    swap(equal_, other.equal_);
+  }
+
+ private:
+  struct Entry final {
+    template <typename K, typename V>
+    Entry(const Hash& hash_func, K&& key, V&& value)
+        : kv(std::forward<K>(key), std::forward<V>(value)),
+          hash(hash_func(kv.first)) {}
+
+    value_type kv;
+    std::size_t hash;
+  };
+
+  // Branch node: a slot per set bit of bitmap, in the order of the bits.
+  // Collision node (below the last branch level): unordered entries with
+  // equal hashes, bitmap is not used.
+  struct Node final {
+    std::uint32_t bitmap{0};
+    std::vector<Slot> slots;
+  };
+
+  static std::uint32_t GetBit(std::size_t hash, unsigned shift) noexcept {
+    return std::uint32_t{1} << ((hash >> shift) & kLevelMask);
+  }
+
+  static std::size_t GetIndex(std::uint32_t bitmap,
+                              std::uint32_t bit) noexcept {
+    return __builtin_popcount(bitmap & (bit - 1));
+  }
+
+  // Copies the node if it is shared with another map
+  static void MakeMutable(NodePtr& node) {
+    if (!node) {
+      node = std::make_shared<Node>();
+    } else if (node.use_count() > 1) {
+      node = std::make_shared<Node>(*node);
+    }
+  }
+
+  const Entry* FindEntry(const Key& key) const;
+
+  bool InsertEntry(EntryPtr&& entry, bool is_assign);
+  bool Insert(NodePtr& node, unsigned shift, EntryPtr&& entry, bool is_assign);
+  void Erase(NodePtr& node, unsigned shift, std::size_t hash, const Key& key);
+
+  NodePtr root_;
+  size_type size_{0};
+  Hash hash_;
+  Equal equal_;
+};
+
+/// Forward iterator over the entries of cache::PersistentHashMap
+template <typename Key, typename Value, typename Hash, typename Equal>
+class PersistentHashMap<Key, Value, Hash, Equal>::const_iterator final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = PersistentHashMap::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference = const value_type&;
+  using pointer = const value_type*;
+
+  const_iterator() = default;
+
+  reference operator*() const {
+    UASSERT(entry_);
+    return entry_->kv;
+  }
+  pointer operator->() const { return &**this; }
+
+  const_iterator& operator++() {
+    UASSERT(entry_ && depth_ > 0);
+    ++path_[depth_ - 1].index;
+    FindNextEntry();
+    return *this;
+  }
+
+  const_iterator operator++(int) {
+    auto copy = *this;
+    ++*this;
+    return copy;
+  }
+
+  bool operator==(const const_iterator& other) const noexcept {
+    return entry_ == other.entry_;
+  }
+  bool operator!=(const const_iterator& other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  friend class PersistentHashMap;
+
+  struct Position final {
+    const Node* node{nullptr};
+    std::size_t index{0};
+  };
+
+  explicit const_iterator(const Node* root) {
+    if (!root) return;
+    path_[depth_++] = {root, 0};
+    FindNextEntry();
+  }
+
+  // Moves to the first entry at or after the current position
+  void FindNextEntry() {
+    while (depth_ > 0) {
+      auto& position = path_[depth_ - 1];
+      if (position.index >= position.node->slots.size()) {
+        if (--depth_ > 0) ++path_[depth_ - 1].index;
+        continue;
+      }
+
+      const auto& slot = position.node->slots[position.index];
+      if (const auto* entry = std::get_if<EntryPtr>(&slot)) {
+        entry_ = entry->get();
+        return;
+      }
+      UASSERT(depth_ < kMaxDepth);
+      path_[depth_++] = {std::get<NodePtr>(slot).get(), 0};
+    }
+    entry_ = nullptr;
+  }
+
+  std::array<Position, kMaxDepth> path_{};
+  std::size_t depth_{0};
+  const Entry* entry_{nullptr};
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+typename PersistentHashMap<Key, Value, Hash, Equal>::const_iterator
+PersistentHashMap<Key, Value, Hash, Equal>::find(const Key& key) const {
+  const auto hash = hash_(key);
+  const_iterator it;
+  const Node* node = root_.get();
+  for (unsigned shift = 0; node; shift += kBitsPerLevel) {
+    if (shift >= kHashBits) {
+      for (std::size_t i = 0; i < node->slots.size(); ++i) {
+        const auto& entry = std::get<EntryPtr>(node->slots[i]);
+        if (equal_(entry->kv.first, key)) {
+          it.path_[it.depth_++] = {node, i};
+          it.entry_ = entry.get();
+          return it;
+        }
+      }
+      return end();
+    }
+
+    const auto bit = GetBit(hash, shift);
+    if (!(node->bitmap & bit)) return end();
+    const auto index = GetIndex(node->bitmap, bit);
+    it.path_[it.depth_++] = {node, index};
+
+    const auto& slot = node->slots[index];
+    if (const auto* entry = std::get_if<EntryPtr>(&slot)) {
+      if ((*entry)->hash != hash || !equal_((*entry)->kv.first, key)) {
+        return end();
+      }
+      it.entry_ = entry->get();
+      return it;
+    }
+    node = std::get<NodePtr>(slot).get();
+  }
+  return end();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+const Value& PersistentHashMap<Key, Value, Hash, Equal>::at(
+    const Key& key) const {
+  const auto* entry = FindEntry(key);
+  if (!entry) throw std::out_of_range("PersistentHashMap::at");
+  return entry->kv.second;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+typename PersistentHashMap<Key, Value, Hash, Equal>::size_type
+PersistentHashMap<Key, Value, Hash, Equal>::erase(const Key& key) {
+  // Checking first, so that a miss does not copy the shared nodes
+  if (!contains(key)) return 0;
+
+  Erase(root_, 0, hash_(key), key);
+  --size_;
+  if (size_ == 0) root_.reset();
+  return 1;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+const typename PersistentHashMap<Key, Value, Hash, Equal>::Entry*
+PersistentHashMap<Key, Value, Hash, Equal>::FindEntry(const Key& key) const {
+  const auto hash = hash_(key);
+  const Node* node = root_.get();
+  for (unsigned shift = 0; node; shift += kBitsPerLevel) {
+    if (shift >= kHashBits) {
+      for (const auto& slot : node->slots) {
+        const auto& entry = std::get<EntryPtr>(slot);
+        if (equal_(entry->kv.first, key)) return entry.get();
+      }
+      return nullptr;
+    }
+
+    const auto bit = GetBit(hash, shift);
+    if (!(node->bitmap & bit)) return nullptr;
+
+    const auto& slot = node->slots[GetIndex(node->bitmap, bit)];
+    if (const auto* entry = std::get_if<EntryPtr>(&slot)) {
+      if ((*entry)->hash != hash || !equal_((*entry)->kv.first, key)) {
+        return nullptr;
+      }
+      return entry->get();
+    }
+    node = std::get<NodePtr>(slot).get();
+  }
+  return nullptr;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool PersistentHashMap<Key, Value, Hash, Equal>::InsertEntry(EntryPtr&& entry,
+                                                             bool is_assign) {
+  const bool is_new = Insert(root_, 0, std::move(entry), is_assign);
+  if (is_new) ++size_;
+  return is_new;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool PersistentHashMap<Key, Value, Hash, Equal>::Insert(NodePtr& node,
+                                                        unsigned shift,
+                                                        EntryPtr&& entry,
+                                                        bool is_assign) {
+  MakeMutable(node);
+  auto& slots = node->slots;
+
+  if (shift >= kHashBits) {
+    for (auto& slot : slots) {
+      auto& existing = std::get<EntryPtr>(slot);
+      if (equal_(existing->kv.first, entry->kv.first)) {
+        if (is_assign) existing = std::move(entry);
+        return false;
+      }
+    }
+    slots.emplace_back(std::move(entry));
+    return true;
+  }
+
+  const auto bit = GetBit(entry->hash, shift);
+  const auto index = GetIndex(node->bitmap, bit);
+  if (!(node->bitmap & bit)) {
+    slots.emplace(slots.begin() + index, std::move(entry));
+    node->bitmap |= bit;
+    return true;
+  }
+
+  auto& slot = slots[index];
+  if (auto* child = std::get_if<NodePtr>(&slot)) {
+    return Insert(*child, shift + kBitsPerLevel, std::move(entry), is_assign);
+  }
+
+  auto& existing = std::get<EntryPtr>(slot);
+  if (existing->hash == entry->hash &&
+      equal_(existing->kv.first, entry->kv.first)) {
+    if (is_assign) existing = std::move(entry);
+    return false;
+  }
+
+  // Push both entries one level down
+  NodePtr child;
+  Insert(child, shift + kBitsPerLevel, std::move(existing), is_assign);
+  Insert(child, shift + kBitsPerLevel, std::move(entry), is_assign);
+  slot = std::move(child);
+  return true;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void PersistentHashMap<Key, Value, Hash, Equal>::Erase(NodePtr& node,
+                                                       unsigned shift,
+                                                       std::size_t hash,
+                                                       const Key& key) {
+  // The key is known to be present
+  MakeMutable(node);
+  auto& slots = node->slots;
+
+  if (shift >= kHashBits) {
+    for (auto it = slots.begin(); it != slots.end(); ++it) {
+      if (equal_(std::get<EntryPtr>(*it)->kv.first, key)) {
+        slots.erase(it);
+        return;
+      }
+    }
+    UASSERT_MSG(false, "Key was not found in a collision node");
+    return;
+  }
+
+  const auto bit = GetBit(hash, shift);
+  UASSERT(node->bitmap & bit);
+  const auto index = GetIndex(node->bitmap, bit);
+
+  auto& slot = slots[index];
+  if (auto* child_ptr = std::get_if<NodePtr>(&slot)) {
+    auto& child = *child_ptr;
+    Erase(child, shift + kBitsPerLevel, hash, key);
+
+    // Keep the trie canonical: a node with a single entry is replaced with
+    // the entry itself, the parents collapse the same way on return
+    if (child->slots.size() == 1 &&
+        std::holds_alternative<EntryPtr>(child->slots.front())) {
+      auto entry = std::get<EntryPtr>(std::move(child->slots.front()));
+      slot = std::move(entry);
+    }
+    return;
+  }
+
+  slots.erase(slots.begin() + index);
+  node->bitmap &= ~bit;
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
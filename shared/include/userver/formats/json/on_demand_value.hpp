@@ -0,0 +1,197 @@
+#pragma once
+
+/// @file userver/formats/json/on_demand_value.hpp
+/// @brief @copybrief formats::json::OnDemandValue
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+namespace impl {
+struct OnDemandTape;
+}  // namespace impl
+
+/// @ingroup userver_containers userver_formats
+///
+/// @brief Non-mutable view of a JSON document that is parsed on demand.
+///
+/// formats::json::FromString(doc, formats::json::kOnDemand) only builds a
+/// structural index of the document, locating the values with a SIMD scan.
+/// Values are parsed into formats::json::Value on access, so reading a few
+/// fields of a large document does not pay for the whole DOM.
+///
+/// The structure of the document is validated on indexing. Scalars and key
+/// uniqueness are only validated for the values that are accessed.
+///
+/// @warning The view references the parsed string, which must outlive it.
+///
+/// ## Example usage:
+///
+/// @snippet formats/json/on_demand_value_test.cpp  Sample OnDemandValue usage
+class OnDemandValue final {
+ public:
+  class const_iterator;
+
+  /// @brief Constructs a view that holds a null.
+  OnDemandValue() noexcept;
+
+  OnDemandValue(const OnDemandValue&);
+  OnDemandValue(OnDemandValue&&) noexcept;
+  OnDemandValue& operator=(const OnDemandValue&);
+  OnDemandValue& operator=(OnDemandValue&&) noexcept;
+  ~OnDemandValue();
+
+  /// @brief Access member by key, takes linear time.
+  /// @throw TypeMismatchException if not a missing value, an object or null.
+  OnDemandValue operator[](std::string_view key) const;
+  /// @brief Access array member by index, takes linear time.
+  /// @throw TypeMismatchException if not an array value.
+  /// @throw OutOfBoundsException if index is greater or equal than size.
+  OnDemandValue operator[](std::size_t index) const;
+
+  /// @brief Returns an iterator to the beginning of the held array or map.
+  /// @throw TypeMismatchException if not an array, object, or null.
+  const_iterator begin() const;
+  /// @brief Returns an iterator to the end of the held array or map.
+  /// @throw TypeMismatchException if not an array, object, or null.
+  const_iterator end() const;
+
+  /// @brief Returns whether the array or object is empty.
+  /// @throw TypeMismatchException if not an array, object, or null.
+  bool IsEmpty() const;
+  /// @brief Returns array size, object members count, or 0 for null.
+  /// @throw TypeMismatchException if not an array, object, or null.
+  std::size_t GetSize() const;
+
+  /// @brief Returns true if *this holds a `key`.
+  /// @throw TypeMismatchException if `*this` is not a map or null.
+  bool HasMember(std::string_view key) const;
+
+  bool IsMissing() const noexcept;
+  bool IsNull() const noexcept;
+  bool IsBool() const noexcept;
+  /// @brief Returns true for the number tokens, the number itself is
+  /// validated on conversion.
+  bool IsNumber() const noexcept;
+  bool IsString() const noexcept;
+  bool IsArray() const noexcept;
+  bool IsObject() const noexcept;
+
+  /// @brief Returns the value converted to T, materializing it.
+  /// @throw Anything derived from std::exception.
+  template <typename T>
+  T As() const;
+
+  /// @brief Returns the value converted to T or T(args) if the value is
+  /// missing or null.
+  template <typename T, typename First, typename... Rest>
+  T As(First&& default_arg, Rest&&... more_default_args) const;
+
+  /// @brief Parses the value into a DOM.
+  ///
+  /// The result is a root value, the paths in its exceptions are relative to
+  /// *this.
+  /// @throw MemberMissingException if `this->IsMissing()`.
+  /// @throw ParseException if the value is not a valid JSON.
+  Value Materialize() const;
+
+  /// @brief Returns the JSON text of the value.
+  /// @throw MemberMissingException if `this->IsMissing()`.
+  std::string_view GetRawJson() const;
+
+  /// @brief Returns full path to this value.
+  std::string GetPath() const;
+
+  /// @throw MemberMissingException if `this->IsMissing()`.
+  void CheckNotMissing() const;
+
+ private:
+  using TapePtr = std::shared_ptr<const impl::OnDemandTape>;
+
+  OnDemandValue(TapePtr tape, std::uint32_t node) noexcept;
+  OnDemandValue(TapePtr tape, std::string&& detached_path) noexcept;
+
+  char GetFirstChar() const noexcept;
+  void CheckObjectOrNull() const;
+  void CheckArrayOrNull() const;
+  void CheckObjectOrArrayOrNull() const;
+  [[noreturn]] void ThrowTypeMismatch(int expected) const;
+  std::uint32_t FindMember(std::string_view key) const;
+
+  TapePtr tape_;
+  std::uint32_t node_{0};
+  /// Full path of node (only for missing nodes)
+  std::string detached_path_;
+
+  friend OnDemandValue FromString(std::string_view, OnDemandTag);
+};
+
+/// @brief Forward iterator over the array elements or object members of
+/// formats::json::OnDemandValue
+class OnDemandValue::const_iterator final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = OnDemandValue;
+  using reference = const OnDemandValue&;
+  using pointer = const OnDemandValue*;
+
+  const_iterator() noexcept;
+
+  reference operator*() const { return current_; }
+  pointer operator->() const { return &current_; }
+
+  const_iterator& operator++();
+  const_iterator operator++(int);
+
+  bool operator==(const const_iterator& other) const noexcept;
+  bool operator!=(const const_iterator& other) const noexcept;
+
+  /// @brief Returns the name of the member.
+  /// @throw TypeMismatchException if not iterating over an object.
+  std::string GetName() const;
+  /// @brief Returns the index of the element or of the member.
+  std::size_t GetIndex() const noexcept { return index_; }
+
+ private:
+  const_iterator(OnDemandValue current, std::size_t index) noexcept;
+
+  OnDemandValue current_;
+  std::size_t index_{0};
+
+  friend class OnDemandValue;
+};
+
+template <typename T>
+T OnDemandValue::As() const {
+  return Materialize().As<T>();
+}
+
+template <>
+std::string OnDemandValue::As<std::string>() const;
+
+template <>
+bool OnDemandValue::As<bool>() const;
+
+template <typename T, typename First, typename... Rest>
+T OnDemandValue::As(First&& default_arg, Rest&&... more_default_args) const {
+  if (IsMissing() || IsNull()) {
+    // intended raw ctor call, sometimes casts
+    // NOLINTNEXTLINE(google-readability-casting)
+    return T(std::forward<First>(default_arg),
+             std::forward<Rest>(more_default_args)...);
+  }
+  return As<T>();
+}
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
@@ -20,9 +20,19 @@ class LogHelper;
 
 namespace formats::json {
 
+class OnDemandValue;
+
+/// Tag for FromString that selects the on-demand parsing
+struct OnDemandTag {};
+inline constexpr OnDemandTag kOnDemand{};
+
 /// Parse JSON from string
 formats::json::Value FromString(std::string_view doc);
 
+/// @brief Index JSON in the string for parsing on demand, see
+/// formats::json::OnDemandValue. The string must outlive the result.
+OnDemandValue FromString(std::string_view doc, OnDemandTag);
+
 /// Parse JSON from stream
 formats::json::Value FromStream(std::istream& is);
 
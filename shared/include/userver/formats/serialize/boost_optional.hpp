@@ -21,6 +21,17 @@ Value Serialize(const boost::optional<T>& value, To<Value>) {
   return typename Value::Builder(*value).ExtractValue();
 }
 
+/// boost::optional serialization
+template <typename T, typename StringBuilder>
+void WriteToStream(const boost::optional<T>& value, StringBuilder& sw) {
+  if (!value) {
+    sw.WriteNull();
+    return;
+  }
+
+  WriteToStream(*value, sw);
+}
+
 }  // namespace formats::serialize
 
 USERVER_NAMESPACE_END
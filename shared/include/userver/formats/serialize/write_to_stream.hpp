@@ -6,11 +6,13 @@
 
 #include <map>
 #include <optional>
+#include <string_view>
 #include <type_traits>
 #include <unordered_map>
 #include <variant>
 
 #include <userver/utils/meta.hpp>
+#include <userver/utils/strong_typedef.hpp>
 
 #include <userver/formats/common/meta.hpp>
 
@@ -58,12 +60,23 @@ void WriteToStreamArray(const T& value, StringBuilder& sw) {
   }
 }
 
+// Keys of the dict like types
+inline std::string_view GetKeyView(std::string_view key) { return key; }
+
+template <typename Tag, utils::StrongTypedefOps Ops, typename Enable>
+std::string_view GetKeyView(
+    const utils::StrongTypedef<Tag, std::string, Ops, Enable>& key) {
+  utils::impl::strong_typedef::CheckIfAllowsLogging<
+      utils::StrongTypedef<Tag, std::string, Ops, Enable>>();
+  return key.GetUnderlying();
+}
+
 // Dict like types serialization
 template <typename T, typename StringBuilder>
 void WriteToStreamDict(const T& value, StringBuilder& sw) {
   typename StringBuilder::ObjectGuard guard(sw);
   for (const auto& [key, value] : value) {
-    sw.Key(key);
+    sw.Key(impl::GetKeyView(key));
     WriteToStream(value, sw);
   }
 }
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <userver/cache/impl/clock_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using Clock = cache::impl::ClockMap<int, int>;
+
+TEST(ClockMap, SetGet) {
+  Clock cache(10);
+  EXPECT_EQ(nullptr, cache.Get(1));
+  EXPECT_TRUE(cache.Put(1, 2));
+  EXPECT_EQ(2, cache.GetOr(1, -1));
+  EXPECT_FALSE(cache.Put(1, 3));
+  EXPECT_EQ(3, cache.GetOr(1, -1));
+  EXPECT_EQ(1, cache.GetSize());
+}
+
+TEST(ClockMap, Erase) {
+  Clock cache(10);
+  cache.Put(1, 10);
+  cache.Put(2, 20);
+  cache.Put(3, 30);
+  cache.Erase(1);
+  cache.Erase(4);
+  EXPECT_EQ(nullptr, cache.Get(1));
+  EXPECT_EQ(20, cache.GetOr(2, -1));
+  EXPECT_EQ(30, cache.GetOr(3, -1));
+  EXPECT_EQ(2, cache.GetSize());
+}
+
+TEST(ClockMap, SecondChance) {
+  Clock cache(3);
+  cache.Put(1, 10);
+  cache.Put(2, 20);
+  cache.Put(3, 30);
+
+  // Accessed entries survive one turn of the clock
+  EXPECT_EQ(10, cache.GetOr(1, -1));
+  EXPECT_EQ(30, cache.GetOr(3, -1));
+  cache.Put(4, 40);
+
+  EXPECT_EQ(nullptr, cache.Get(2));
+  EXPECT_EQ(10, cache.GetOr(1, -1));
+  EXPECT_EQ(30, cache.GetOr(3, -1));
+  EXPECT_EQ(40, cache.GetOr(4, -1));
+  EXPECT_EQ(3, cache.GetSize());
+}
+
+TEST(ClockMap, SwappedInEntryIsExamined) {
+  Clock cache(3);
+  cache.Put(1, 10);
+  cache.Put(2, 20);
+  cache.Put(3, 30);
+  cache.Get(2);
+
+  // Evicts 1, the last entry 3 takes its place in the ring
+  cache.Put(4, 40);
+  EXPECT_EQ(nullptr, cache.Get(1));
+
+  // The hand is still on the place of 1, so 3 is examined first
+  cache.Put(5, 50);
+  EXPECT_EQ(nullptr, cache.Get(3));
+  EXPECT_EQ(20, cache.GetOr(2, -1));
+  EXPECT_EQ(40, cache.GetOr(4, -1));
+  EXPECT_EQ(50, cache.GetOr(5, -1));
+}
+
+TEST(ClockMap, AllAccessed) {
+  Clock cache(2);
+  cache.Put(1, 10);
+  cache.Put(2, 20);
+  cache.Get(1);
+  cache.Get(2);
+
+  // Falls back to FIFO order when every entry was accessed
+  cache.Put(3, 30);
+  EXPECT_EQ(2, cache.GetSize());
+  EXPECT_EQ(nullptr, cache.Get(1));
+  EXPECT_EQ(30, cache.GetOr(3, -1));
+}
+
+TEST(ClockMap, SetMaxSize) {
+  Clock cache(10);
+  for (int i = 0; i < 10; ++i) cache.Put(i, i);
+
+  cache.SetMaxSize(3);
+  EXPECT_EQ(3, cache.GetSize());
+
+  int visited = 0;
+  cache.VisitAll([&visited](int key, int value) {
+    EXPECT_EQ(key, value);
+    ++visited;
+  });
+  EXPECT_EQ(3, visited);
+
+  for (int i = 10; i < 20; ++i) cache.Put(i, i);
+  EXPECT_EQ(3, cache.GetSize());
+}
+
+TEST(ClockMap, Clear) {
+  cache::impl::ClockMap<std::string, std::string> cache(2);
+  cache.Put("a", "1");
+  cache.Put("b", "2");
+  cache.Clear();
+  EXPECT_EQ(0, cache.GetSize());
+
+  cache.Put("c", "3");
+  EXPECT_EQ("3", cache.GetOr("c", {}));
+}
+
+USERVER_NAMESPACE_END
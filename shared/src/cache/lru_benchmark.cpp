@@ -1,5 +1,7 @@
 #include <benchmark/benchmark.h>
 
+#include <userver/cache/impl/clock_map.hpp>
+#include <userver/cache/lru_map.hpp>
 #include <userver/cache/lru_set.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -51,4 +53,22 @@ void LruPutOverflow(benchmark::State& state) {
 }
 BENCHMARK(LruPutOverflow);
 
+// Hits of a single NWayLRU way, see nway_lru_cache_benchmark.cpp for the
+// concurrent ones
+template <typename Map>
+void LruMapGet(benchmark::State& state) {
+  Map map(kElementsCount);
+  for (unsigned i = 0; i < kElementsCount; ++i) {
+    map.Put(i, i);
+  }
+
+  for (auto _ : state) {
+    for (unsigned i = 0; i < kElementsCount; ++i) {
+      benchmark::DoNotOptimize(map.Get(i));
+    }
+  }
+}
+BENCHMARK_TEMPLATE(LruMapGet, cache::LruMap<unsigned, unsigned>);
+BENCHMARK_TEMPLATE(LruMapGet, cache::impl::ClockMap<unsigned, unsigned>);
+
 USERVER_NAMESPACE_END
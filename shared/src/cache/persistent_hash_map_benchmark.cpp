@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <unordered_map>
+
+#include <userver/cache/persistent_hash_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Typical size of an incremental update of a cache
+constexpr unsigned kDeltaSize = 100;
+
+template <typename Map>
+Map FillMap(unsigned size) {
+  Map map;
+  for (unsigned i = 0; i < size; ++i) {
+    map.insert_or_assign(i, std::to_string(i));
+  }
+  return map;
+}
+
+}  // namespace
+
+// Incremental update of a cache snapshot: copy the current data, apply the
+// delta, publish the copy. state.range(0) is the cache size.
+template <typename Map>
+void cache_incremental_update(benchmark::State& state) {
+  const auto size = static_cast<unsigned>(state.range(0));
+  auto current = FillMap<Map>(size);
+  unsigned key = 0;
+
+  for (auto _ : state) {
+    auto next = current;
+    for (unsigned i = 0; i < kDeltaSize; ++i) {
+      // Spread the changed keys over the whole map
+      key = (key + 7919) % size;
+      next.insert_or_assign(key, std::to_string(i));
+    }
+    current = std::move(next);
+    benchmark::DoNotOptimize(current);
+  }
+  state.SetItemsProcessed(state.iterations() * kDeltaSize);
+}
+BENCHMARK_TEMPLATE(cache_incremental_update,
+                   std::unordered_map<unsigned, std::string>)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 1'000'000);
+BENCHMARK_TEMPLATE(cache_incremental_update,
+                   cache::PersistentHashMap<unsigned, std::string>)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 1'000'000);
+
+template <typename Map>
+void cache_lookup(benchmark::State& state) {
+  const auto size = static_cast<unsigned>(state.range(0));
+  const auto map = FillMap<Map>(size);
+  unsigned key = 0;
+
+  for (auto _ : state) {
+    key = (key + 7919) % size;
+    benchmark::DoNotOptimize(map.find(key));
+  }
+}
+BENCHMARK_TEMPLATE(cache_lookup, std::unordered_map<unsigned, std::string>)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 1'000'000);
+BENCHMARK_TEMPLATE(cache_lookup,
+                   cache::PersistentHashMap<unsigned, std::string>)
+    ->RangeMultiplier(10)
+    ->Range(1'000, 1'000'000);
+
+USERVER_NAMESPACE_END
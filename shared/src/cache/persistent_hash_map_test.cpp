@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include <userver/cache/persistent_hash_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Map = cache::PersistentHashMap<int, std::string>;
+
+// Forces the keys into the same branches and collision nodes
+struct BadHash final {
+  std::size_t operator()(int key) const noexcept { return key % 3; }
+};
+
+template <typename Container>
+std::map<int, std::string> ToStdMap(const Container& container) {
+  std::map<int, std::string> result;
+  for (const auto& [key, value] : container) {
+    EXPECT_TRUE(result.emplace(key, value).second) << "duplicate key " << key;
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(PersistentHashMap, Basic) {
+  Map map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.find(1), map.end());
+
+  EXPECT_TRUE(map.insert_or_assign(1, "one"));
+  EXPECT_TRUE(map.insert({2, "two"}));
+  EXPECT_FALSE(map.insert({2, "zwei"}));
+  EXPECT_FALSE(map.insert_or_assign(1, "uno"));
+
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map.at(1), "uno");
+  EXPECT_EQ(map.find(2)->second, "two");
+  EXPECT_EQ(map.count(3), 0);
+  EXPECT_THROW(map.at(3), std::out_of_range);
+
+  EXPECT_EQ(map.erase(3), 0);
+  EXPECT_EQ(map.erase(1), 1);
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_EQ(map.size(), 1);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(PersistentHashMap, CopiesAreIndependent) {
+  Map original;
+  for (int i = 0; i < 1000; ++i) {
+    original.insert_or_assign(i, std::to_string(i));
+  }
+
+  auto copy = original;
+  copy.insert_or_assign(1, "changed");
+  copy.insert_or_assign(1000, "new");
+  copy.erase(2);
+
+  EXPECT_EQ(original.size(), 1000);
+  EXPECT_EQ(original.at(1), "1");
+  EXPECT_FALSE(original.contains(1000));
+  EXPECT_EQ(original.at(2), "2");
+
+  EXPECT_EQ(copy.size(), 1000);
+  EXPECT_EQ(copy.at(1), "changed");
+  EXPECT_EQ(copy.at(1000), "new");
+  EXPECT_FALSE(copy.contains(2));
+}
+
+TEST(PersistentHashMap, Collisions) {
+  cache::PersistentHashMap<int, std::string, BadHash> map;
+  for (int i = 0; i < 30; ++i) map.insert_or_assign(i, std::to_string(i));
+  EXPECT_EQ(map.size(), 30);
+
+  auto copy = map;
+  for (int i = 0; i < 30; i += 2) EXPECT_EQ(copy.erase(i), 1);
+  EXPECT_EQ(copy.size(), 15);
+
+  for (int i = 0; i < 30; ++i) {
+    EXPECT_EQ(map.at(i), std::to_string(i));
+    EXPECT_EQ(copy.contains(i), i % 2 == 1);
+  }
+  EXPECT_EQ(ToStdMap(copy).size(), 15);
+}
+
+TEST(PersistentHashMap, MatchesUnorderedMap) {
+  std::mt19937 rng{42};
+  std::uniform_int_distribution<int> key_distribution{0, 5000};
+
+  Map map;
+  std::unordered_map<int, std::string> expected;
+  std::vector<std::pair<Map, std::map<int, std::string>>> snapshots;
+
+  for (int i = 0; i < 50000; ++i) {
+    const auto key = key_distribution(rng);
+    if (i % 3 == 0) {
+      EXPECT_EQ(map.erase(key), expected.erase(key));
+    } else {
+      const auto value = std::to_string(i);
+      EXPECT_EQ(map.insert_or_assign(key, value),
+                expected.insert_or_assign(key, value).second);
+    }
+    ASSERT_EQ(map.size(), expected.size());
+
+    if (i % 10000 == 0) snapshots.emplace_back(map, ToStdMap(expected));
+  }
+
+  EXPECT_EQ(ToStdMap(map), ToStdMap(expected));
+  for (const auto& [key, value] : expected) {
+    const auto it = map.find(key);
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->second, value);
+  }
+
+  // Older snapshots are not affected by the later modifications
+  for (const auto& [snapshot, snapshot_expected] : snapshots) {
+    EXPECT_EQ(ToStdMap(snapshot), snapshot_expected);
+  }
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,344 @@
+#include <formats/json/impl/on_demand_tape.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include <fmt/format.h>
+
+#include <userver/formats/json/exception.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::impl {
+
+namespace {
+
+constexpr std::size_t kBlockSize = 64;
+constexpr std::uint64_t kOddBits = 0xAAAAAAAAAAAAAAAAULL;
+
+[[noreturn]] void ThrowParseError(std::string_view json, std::size_t offset,
+                                  std::string_view message) {
+  offset = std::min(offset, json.size());
+  const auto line = 1 + std::count(json.begin(), json.begin() + offset, '\n');
+  const auto from_pos = json.substr(0, offset).find_last_of('\n');
+  const auto column = offset > from_pos ? offset - from_pos : offset + 1;
+  throw ParseException(fmt::format("JSON parse error at line {} column {}: {}",
+                                   line, column, message));
+}
+
+bool IsWhitespace(char c) noexcept {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+struct BlockMasks {
+  std::uint64_t backslash{0};
+  std::uint64_t quote{0};
+  // {}[]:,
+  std::uint64_t op{0};
+  std::uint64_t whitespace{0};
+};
+
+using ClassifyFunc = BlockMasks (*)(const char* block);
+
+BlockMasks ClassifyScalar(const char* block) {
+  BlockMasks masks;
+  for (std::size_t i = 0; i < kBlockSize; ++i) {
+    const std::uint64_t bit = std::uint64_t{1} << i;
+    switch (block[i]) {
+      case '\\':
+        masks.backslash |= bit;
+        break;
+      case '"':
+        masks.quote |= bit;
+        break;
+      case '{':
+      case '}':
+      case '[':
+      case ']':
+      case ':':
+      case ',':
+        masks.op |= bit;
+        break;
+      case ' ':
+      case '\t':
+      case '\n':
+      case '\r':
+        masks.whitespace |= bit;
+        break;
+      default:
+        break;
+    }
+  }
+  return masks;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2"))) std::uint64_t EqualMask(__m256i lo, __m256i hi,
+                                                       char c) {
+  const auto pattern = _mm256_set1_epi8(c);
+  const auto lo_mask = static_cast<std::uint32_t>(
+      _mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, pattern)));
+  const auto hi_mask = static_cast<std::uint32_t>(
+      _mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, pattern)));
+  return lo_mask | (std::uint64_t{hi_mask} << 32);
+}
+
+__attribute__((target("avx2"))) BlockMasks ClassifyAvx2(const char* block) {
+  const auto lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+  const auto hi =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+
+  BlockMasks masks;
+  masks.backslash = EqualMask(lo, hi, '\\');
+  masks.quote = EqualMask(lo, hi, '"');
+  // '{' and '[' differ from '}' and ']' in a single bit
+  const auto brace = _mm256_set1_epi8(0x20);
+  masks.op = EqualMask(_mm256_or_si256(lo, brace), _mm256_or_si256(hi, brace),
+                       '{') |
+             EqualMask(_mm256_or_si256(lo, brace), _mm256_or_si256(hi, brace),
+                       '}') |
+             EqualMask(lo, hi, ':') | EqualMask(lo, hi, ',');
+  masks.whitespace = EqualMask(lo, hi, ' ') | EqualMask(lo, hi, '\t') |
+                     EqualMask(lo, hi, '\n') | EqualMask(lo, hi, '\r');
+  return masks;
+}
+#endif
+
+ClassifyFunc GetClassifier(SimdLevel level) {
+#if defined(__x86_64__)
+  if (level == SimdLevel::kAvx2) return &ClassifyAvx2;
+#endif
+  static_cast<void>(level);
+  return &ClassifyScalar;
+}
+
+// Bit i is set if the count of the set bits in [0, i] is odd
+std::uint64_t PrefixXor(std::uint64_t bits) noexcept {
+  bits ^= bits << 1;
+  bits ^= bits << 2;
+  bits ^= bits << 4;
+  bits ^= bits << 8;
+  bits ^= bits << 16;
+  bits ^= bits << 32;
+  return bits;
+}
+
+// State of the scan that is carried between the blocks
+class StructuralScanner final {
+ public:
+  // Returns the structurals mask of the block
+  std::uint64_t Next(const BlockMasks& masks) noexcept {
+    const auto quote = masks.quote & ~NextEscaped(masks.backslash);
+    // opening quotes and the string contents
+    const auto in_string = PrefixXor(quote) ^ prev_in_string_;
+    prev_in_string_ = static_cast<std::uint64_t>(
+        static_cast<std::int64_t>(in_string) >> 63);
+
+    const auto scalar = ~(masks.op | masks.whitespace | quote | in_string);
+    const auto scalar_start = scalar & ~((scalar << 1) | prev_scalar_);
+    prev_scalar_ = scalar >> 63;
+
+    return (masks.op & ~in_string) | quote | scalar_start;
+  }
+
+  bool IsInString() const noexcept { return prev_in_string_ != 0; }
+
+ private:
+  // Chars that follow an odd-length sequence of backslashes, the trick is
+  // described in "Parsing Gigabytes of JSON per Second", Langdale & Lemire
+  std::uint64_t NextEscaped(std::uint64_t backslash) noexcept {
+    if (!backslash) {
+      const auto escaped = next_is_escaped_;
+      next_is_escaped_ = 0;
+      return escaped;
+    }
+    const auto potential_escape = backslash & ~next_is_escaped_;
+    const auto escape_and_terminal_code =
+        (((potential_escape << 1) | kOddBits) - potential_escape) ^ kOddBits;
+    const auto escaped =
+        escape_and_terminal_code ^ (backslash | next_is_escaped_);
+    next_is_escaped_ = (escape_and_terminal_code & backslash) >> 63;
+    return escaped;
+  }
+
+  std::uint64_t next_is_escaped_{0};
+  std::uint64_t prev_in_string_{0};
+  std::uint64_t prev_scalar_{0};
+};
+
+void AppendOffsets(std::uint64_t bits, std::uint32_t base,
+                   std::vector<std::uint32_t>& offsets) {
+  const auto old_size = offsets.size();
+  offsets.resize(old_size + __builtin_popcountll(bits));
+  auto* out = offsets.data() + old_size;
+  while (bits) {
+    *out++ = base + __builtin_ctzll(bits);
+    bits &= bits - 1;
+  }
+}
+
+}  // namespace
+
+SimdLevel GetSimdLevel() noexcept {
+#if defined(__x86_64__)
+  static const SimdLevel kLevel = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? SimdLevel::kAvx2
+                                          : SimdLevel::kScalar;
+  }();
+  return kLevel;
+#else
+  return SimdLevel::kScalar;
+#endif
+}
+
+std::vector<std::uint32_t> FindStructurals(std::string_view json,
+                                           SimdLevel level) {
+  if (json.size() >= std::numeric_limits<std::uint32_t>::max()) {
+    throw ParseException("JSON document is too large for on-demand parsing");
+  }
+
+  const auto classify = GetClassifier(level);
+  StructuralScanner scanner;
+  std::vector<std::uint32_t> offsets;
+  offsets.reserve(json.size() / 4 + kBlockSize);
+
+  std::size_t offset = 0;
+  for (; offset + kBlockSize <= json.size(); offset += kBlockSize) {
+    AppendOffsets(scanner.Next(classify(json.data() + offset)), offset,
+                  offsets);
+  }
+  if (offset < json.size()) {
+    char tail[kBlockSize];
+    std::memset(tail, ' ', kBlockSize);
+    std::memcpy(tail, json.data() + offset, json.size() - offset);
+    AppendOffsets(scanner.Next(classify(tail)), offset, offsets);
+  }
+
+  if (scanner.IsInString()) {
+    ThrowParseError(json, json.size(),
+                    "Missing a closing quotation mark in string.");
+  }
+  return offsets;
+}
+
+std::vector<TapeNode> BuildTape(std::string_view json,
+                                const std::vector<std::uint32_t>& structurals) {
+  enum class State { kValue, kObjectKey, kAfterValue };
+
+  std::vector<TapeNode> nodes;
+  nodes.reserve(structurals.size() / 2 + 1);
+  // open arrays and objects
+  std::vector<std::uint32_t> stack;
+
+  const auto count = structurals.size();
+  std::size_t i = 0;
+  const auto current_char = [&] {
+    return i < count ? json[structurals[i]] : '\0';
+  };
+  const auto current_offset = [&] {
+    return i < count ? structurals[i] : json.size();
+  };
+  const auto parent = [&] { return stack.empty() ? kNoNode : stack.back(); };
+  const auto add_string = [&] {
+    // stage 1 guarantees that quotes go in pairs
+    const auto index = static_cast<std::uint32_t>(nodes.size());
+    nodes.push_back(TapeNode{structurals[i], structurals[i + 1] + 1, index + 1,
+                             parent(), 0});
+    i += 2;
+  };
+  const auto close_container = [&] {
+    auto& node = nodes[stack.back()];
+    node.end = structurals[i] + 1;
+    node.next = nodes.size();
+    stack.pop_back();
+    ++i;
+  };
+
+  auto state = State::kValue;
+  while (true) {
+    switch (state) {
+      case State::kValue: {
+        const char c = current_char();
+        const auto index = static_cast<std::uint32_t>(nodes.size());
+        if (c == '{' || c == '[') {
+          nodes.push_back(TapeNode{structurals[i], 0, 0, parent(), 0});
+          stack.push_back(index);
+          ++i;
+          if (current_char() == (c == '{' ? '}' : ']')) {
+            close_container();
+            state = State::kAfterValue;
+          } else {
+            state = c == '{' ? State::kObjectKey : State::kValue;
+          }
+        } else if (c == '"') {
+          add_string();
+          state = State::kAfterValue;
+        } else if (c == '-' || (c >= '0' && c <= '9') || c == 't' ||
+                   c == 'f' || c == 'n') {
+          const auto begin = structurals[i];
+          std::size_t end = i + 1 < count ? structurals[i + 1] : json.size();
+          while (IsWhitespace(json[end - 1])) --end;
+          nodes.push_back(TapeNode{begin, static_cast<std::uint32_t>(end),
+                                   index + 1, parent(), 0});
+          ++i;
+          state = State::kAfterValue;
+        } else {
+          ThrowParseError(json, current_offset(), "Invalid value.");
+        }
+        break;
+      }
+
+      case State::kObjectKey:
+        if (current_char() != '"') {
+          ThrowParseError(json, current_offset(),
+                          "Missing a name for object member.");
+        }
+        add_string();
+        if (current_char() != ':') {
+          ThrowParseError(json, current_offset(),
+                          "Missing a colon after a name of object member.");
+        }
+        ++i;
+        state = State::kValue;
+        break;
+
+      case State::kAfterValue: {
+        if (stack.empty()) {
+          if (i != count) {
+            ThrowParseError(
+                json, current_offset(),
+                "The document root must not be followed by other values.");
+          }
+          return nodes;
+        }
+
+        auto& container = nodes[stack.back()];
+        ++container.size;
+        const bool is_object = json[container.begin] == '{';
+        const char c = current_char();
+        if (c == ',') {
+          ++i;
+          state = is_object ? State::kObjectKey : State::kValue;
+        } else if (c == (is_object ? '}' : ']')) {
+          close_container();
+        } else {
+          ThrowParseError(
+              json, current_offset(),
+              is_object ? "Missing a comma or '}' after an object member."
+                        : "Missing a comma or ']' after an array element.");
+        }
+        break;
+      }
+    }
+  }
+}
+
+}  // namespace formats::json::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::impl {
+
+inline constexpr std::uint32_t kNoNode = -1;
+
+/// Value of the document. Keys of the objects are nodes as well, each key is
+/// directly followed by the value of the member.
+struct TapeNode {
+  /// Offset of the first byte of the value
+  std::uint32_t begin;
+  /// Offset past the last byte of the value
+  std::uint32_t end;
+  /// Index of the node that follows the subtree of this node
+  std::uint32_t next;
+  /// Index of the array or the object, kNoNode for the root
+  std::uint32_t parent;
+  /// Count of the array elements or the object members
+  std::uint32_t size;
+};
+
+struct OnDemandTape {
+  std::string_view json;
+  std::vector<TapeNode> nodes;
+};
+
+enum class SimdLevel {
+  kScalar,
+  kAvx2,
+};
+
+/// The best instruction set supported by the CPU
+SimdLevel GetSimdLevel() noexcept;
+
+/// @brief Stage 1 of the on-demand parsing: finds offsets of `{}[]:,` out of
+/// the strings, of the unescaped quotes and of the first bytes of the other
+/// tokens, 64 bytes at a time.
+/// @throws ParseException if a string is not terminated
+std::vector<std::uint32_t> FindStructurals(std::string_view json,
+                                           SimdLevel level = GetSimdLevel());
+
+/// @brief Stage 2 of the on-demand parsing: builds the tape out of the
+/// structurals, validating the structure of the document. Scalars are only
+/// checked to start with a valid char.
+/// @throws ParseException
+std::vector<TapeNode> BuildTape(std::string_view json,
+                                const std::vector<std::uint32_t>& structurals);
+
+}  // namespace formats::json::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,316 @@
+#include <userver/formats/json/on_demand_value.hpp>
+
+#include <vector>
+
+#include <userver/formats/common/path.hpp>
+#include <userver/formats/json/exception.hpp>
+
+#include <formats/json/impl/exttypes.hpp>
+#include <formats/json/impl/on_demand_tape.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+
+namespace {
+
+bool IsObjectNode(const impl::OnDemandTape& tape, std::uint32_t node) {
+  return tape.json[tape.nodes[node].begin] == '{';
+}
+
+std::string_view GetNodeJson(const impl::OnDemandTape& tape,
+                             std::uint32_t node) {
+  const auto& tape_node = tape.nodes[node];
+  return tape.json.substr(tape_node.begin, tape_node.end - tape_node.begin);
+}
+
+// Contents of a string token that needs no unescaping
+bool IsPlainString(std::string_view contents) {
+  for (const char c : contents) {
+    if (c == '\\' || static_cast<unsigned char>(c) < 0x20) return false;
+  }
+  return true;
+}
+
+std::string DecodeString(std::string_view raw) {
+  const auto contents = raw.substr(1, raw.size() - 2);
+  if (IsPlainString(contents)) return std::string{contents};
+  return FromString(raw).As<std::string>();
+}
+
+bool KeyEquals(std::string_view raw, std::string_view key) {
+  const auto contents = raw.substr(1, raw.size() - 2);
+  // unescaping only makes the string shorter
+  if (contents.size() < key.size()) return false;
+  if (contents.find('\\') == std::string_view::npos) return contents == key;
+  return DecodeString(raw) == key;
+}
+
+int GetExtendedType(std::string_view raw) {
+  switch (raw.front()) {
+    case '{':
+      return impl::objectValue;
+    case '[':
+      return impl::arrayValue;
+    case '"':
+      return impl::stringValue;
+    case 't':
+    case 'f':
+      return impl::booleanValue;
+    case 'n':
+      return impl::nullValue;
+    default:
+      if (raw.find_first_of(".eE") != std::string_view::npos) {
+        return impl::realValue;
+      }
+      return raw.front() == '-' ? impl::intValue : impl::uintValue;
+  }
+}
+
+}  // namespace
+
+OnDemandValue::OnDemandValue() noexcept = default;
+
+OnDemandValue::OnDemandValue(TapePtr tape, std::uint32_t node) noexcept
+    : tape_(std::move(tape)), node_(node) {}
+
+OnDemandValue::OnDemandValue(TapePtr tape,
+                             std::string&& detached_path) noexcept
+    : tape_(std::move(tape)),
+      node_(impl::kNoNode),
+      detached_path_(std::move(detached_path)) {}
+
+OnDemandValue::OnDemandValue(const OnDemandValue&) = default;
+OnDemandValue::OnDemandValue(OnDemandValue&&) noexcept = default;
+OnDemandValue& OnDemandValue::operator=(const OnDemandValue&) = default;
+OnDemandValue& OnDemandValue::operator=(OnDemandValue&&) noexcept = default;
+OnDemandValue::~OnDemandValue() = default;
+
+OnDemandValue OnDemandValue::operator[](std::string_view key) const {
+  if (!IsMissing()) {
+    CheckObjectOrNull();
+    if (IsObject()) {
+      const auto member = FindMember(key);
+      if (member != impl::kNoNode) return {tape_, member};
+    }
+  }
+  return {tape_, formats::common::MakeChildPath(GetPath(), key)};
+}
+
+OnDemandValue OnDemandValue::operator[](std::size_t index) const {
+  CheckArrayOrNull();
+  const auto size = GetSize();
+  if (index >= size) {
+    throw OutOfBoundsException(index, size, GetPath());
+  }
+
+  auto node = node_ + 1;
+  for (std::size_t i = 0; i < index; ++i) node = tape_->nodes[node].next;
+  return {tape_, node};
+}
+
+OnDemandValue::const_iterator OnDemandValue::begin() const {
+  CheckObjectOrArrayOrNull();
+  if (IsEmpty()) return end();
+  // members start from the key
+  return {{tape_, node_ + (IsObject() ? 2 : 1)}, 0};
+}
+
+OnDemandValue::const_iterator OnDemandValue::end() const {
+  CheckObjectOrArrayOrNull();
+  return {{}, GetSize()};
+}
+
+bool OnDemandValue::IsEmpty() const { return GetSize() == 0; }
+
+std::size_t OnDemandValue::GetSize() const {
+  CheckObjectOrArrayOrNull();
+  if (IsNull()) return 0;  // nulls are "empty arrays"
+  return tape_->nodes[node_].size;
+}
+
+bool OnDemandValue::HasMember(std::string_view key) const {
+  CheckObjectOrNull();
+  return IsObject() && FindMember(key) != impl::kNoNode;
+}
+
+bool OnDemandValue::IsMissing() const noexcept {
+  return node_ == impl::kNoNode;
+}
+
+bool OnDemandValue::IsNull() const noexcept {
+  return !IsMissing() && (!tape_ || GetFirstChar() == 'n');
+}
+
+bool OnDemandValue::IsBool() const noexcept {
+  const char c = GetFirstChar();
+  return c == 't' || c == 'f';
+}
+
+bool OnDemandValue::IsNumber() const noexcept {
+  const char c = GetFirstChar();
+  return c == '-' || (c >= '0' && c <= '9');
+}
+
+bool OnDemandValue::IsString() const noexcept { return GetFirstChar() == '"'; }
+
+bool OnDemandValue::IsArray() const noexcept { return GetFirstChar() == '['; }
+
+bool OnDemandValue::IsObject() const noexcept { return GetFirstChar() == '{'; }
+
+template <>
+std::string OnDemandValue::As<std::string>() const {
+  if (IsString()) {
+    const auto raw = GetRawJson();
+    const auto contents = raw.substr(1, raw.size() - 2);
+    if (IsPlainString(contents)) return std::string{contents};
+  }
+  return Materialize().As<std::string>();
+}
+
+template <>
+bool OnDemandValue::As<bool>() const {
+  const auto raw = GetRawJson();
+  if (raw == "true") return true;
+  if (raw == "false") return false;
+  if (IsBool() || IsNull()) return Materialize().As<bool>();
+  ThrowTypeMismatch(impl::booleanValue);
+}
+
+Value OnDemandValue::Materialize() const {
+  if (!tape_) return {};
+  return FromString(GetRawJson());
+}
+
+std::string_view OnDemandValue::GetRawJson() const {
+  CheckNotMissing();
+  if (!tape_) return "null";
+  return GetNodeJson(*tape_, node_);
+}
+
+std::string OnDemandValue::GetPath() const {
+  if (IsMissing()) return detached_path_;
+  if (!tape_) return formats::common::kPathRoot;
+
+  const auto& nodes = tape_->nodes;
+  std::vector<std::uint32_t> chain;
+  for (auto node = node_; nodes[node].parent != impl::kNoNode;
+       node = nodes[node].parent) {
+    chain.push_back(node);
+  }
+  if (chain.empty()) return formats::common::kPathRoot;
+
+  std::string path;
+  for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+    const auto parent = nodes[*it].parent;
+    if (IsObjectNode(*tape_, parent)) {
+      formats::common::AppendPath(
+          path, DecodeString(GetNodeJson(*tape_, *it - 1)));
+    } else {
+      std::size_t index = 0;
+      for (auto node = parent + 1; node != *it; node = nodes[node].next) {
+        ++index;
+      }
+      formats::common::AppendPath(path, index);
+    }
+  }
+  return path;
+}
+
+void OnDemandValue::CheckNotMissing() const {
+  if (IsMissing()) {
+    throw MemberMissingException(GetPath());
+  }
+}
+
+char OnDemandValue::GetFirstChar() const noexcept {
+  if (IsMissing() || !tape_) return '\0';
+  return tape_->json[tape_->nodes[node_].begin];
+}
+
+void OnDemandValue::CheckObjectOrNull() const {
+  if (!IsNull() && !IsObject()) ThrowTypeMismatch(impl::objectValue);
+}
+
+void OnDemandValue::CheckArrayOrNull() const {
+  if (!IsNull() && !IsArray()) ThrowTypeMismatch(impl::arrayValue);
+}
+
+void OnDemandValue::CheckObjectOrArrayOrNull() const {
+  if (!IsNull() && !IsObject() && !IsArray()) {
+    ThrowTypeMismatch(impl::objectValue);
+  }
+}
+
+void OnDemandValue::ThrowTypeMismatch(int expected) const {
+  CheckNotMissing();
+  throw TypeMismatchException(GetExtendedType(GetRawJson()), expected,
+                              GetPath());
+}
+
+std::uint32_t OnDemandValue::FindMember(std::string_view key) const {
+  const auto& nodes = tape_->nodes;
+  auto key_node = node_ + 1;
+  for (std::uint32_t i = 0; i < nodes[node_].size; ++i) {
+    if (KeyEquals(GetNodeJson(*tape_, key_node), key)) return key_node + 1;
+    key_node = nodes[key_node + 1].next;
+  }
+  return impl::kNoNode;
+}
+
+OnDemandValue::const_iterator::const_iterator() noexcept = default;
+
+OnDemandValue::const_iterator::const_iterator(OnDemandValue current,
+                                              std::size_t index) noexcept
+    : current_(std::move(current)), index_(index) {}
+
+OnDemandValue::const_iterator& OnDemandValue::const_iterator::operator++() {
+  const auto& tape = *current_.tape_;
+  const auto next = tape.nodes[current_.node_].next;
+  current_.node_ =
+      IsObjectNode(tape, tape.nodes[current_.node_].parent) ? next + 1 : next;
+  ++index_;
+  return *this;
+}
+
+OnDemandValue::const_iterator OnDemandValue::const_iterator::operator++(int) {
+  auto result = *this;
+  ++*this;
+  return result;
+}
+
+bool OnDemandValue::const_iterator::operator==(
+    const const_iterator& other) const noexcept {
+  return index_ == other.index_;
+}
+
+bool OnDemandValue::const_iterator::operator!=(
+    const const_iterator& other) const noexcept {
+  return index_ != other.index_;
+}
+
+std::string OnDemandValue::const_iterator::GetName() const {
+  const auto& tape = *current_.tape_;
+  const auto parent = tape.nodes[current_.node_].parent;
+  if (!IsObjectNode(tape, parent)) {
+    const OnDemandValue container{current_.tape_, parent};
+    throw TypeMismatchException(impl::arrayValue, impl::objectValue,
+                                container.GetPath());
+  }
+  return DecodeString(GetNodeJson(tape, current_.node_ - 1));
+}
+
+OnDemandValue FromString(std::string_view doc, OnDemandTag) {
+  if (doc.empty()) {
+    throw ParseException("JSON document is empty");
+  }
+
+  auto tape = std::make_shared<impl::OnDemandTape>();
+  tape->json = doc;
+  tape->nodes = impl::BuildTape(doc, impl::FindStructurals(doc));
+  return OnDemandValue{std::move(tape), 0};
+}
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
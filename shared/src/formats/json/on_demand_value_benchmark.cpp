@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <fmt/format.h>
+
+#include <userver/formats/json/on_demand_value.hpp>
+#include <userver/formats/json/parser/parser.hpp>
+#include <userver/formats/json/serialize.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// A request with a few fields that are read by the handler and a large
+// payload that is only passed through
+std::string BuildDocument(std::size_t size) {
+  std::string result = R"({"id": 1234, "name": "document", "items": [)";
+  for (std::size_t i = 0; result.size() < size; ++i) {
+    if (i > 0) result += ',';
+    result += fmt::format(
+        R"({{"index": {}, "value": {}.5, "tags": ["a", "b\"c"], )"
+        R"("text": "some string with \\escapes\\ and spaces"}})",
+        i, i);
+  }
+  result += R"(], "status": "ok"})";
+  return result;
+}
+
+constexpr std::int64_t kMinSize = 1 << 10;
+constexpr std::int64_t kMaxSize = 10 << 20;
+
+}  // namespace
+
+void JsonParseDocumentDom(benchmark::State& state) {
+  const auto input = BuildDocument(state.range(0));
+  for (auto _ : state) {
+    const auto json = formats::json::FromString(input);
+    benchmark::DoNotOptimize(json["id"].As<int>());
+    benchmark::DoNotOptimize(json["name"].As<std::string>());
+    benchmark::DoNotOptimize(json["status"].As<std::string>());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParseDocumentDom)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void JsonParseDocumentSax(benchmark::State& state) {
+  const auto input = BuildDocument(state.range(0));
+  for (auto _ : state) {
+    const auto json = formats::json::parser::ParseToType<
+        formats::json::Value, formats::json::parser::JsonValueParser>(input);
+    benchmark::DoNotOptimize(json["id"].As<int>());
+    benchmark::DoNotOptimize(json["name"].As<std::string>());
+    benchmark::DoNotOptimize(json["status"].As<std::string>());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParseDocumentSax)->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+
+void JsonParseDocumentOnDemand(benchmark::State& state) {
+  const auto input = BuildDocument(state.range(0));
+  for (auto _ : state) {
+    const auto json =
+        formats::json::FromString(input, formats::json::kOnDemand);
+    benchmark::DoNotOptimize(json["id"].As<int>());
+    benchmark::DoNotOptimize(json["name"].As<std::string>());
+    benchmark::DoNotOptimize(json["status"].As<std::string>());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParseDocumentOnDemand)
+    ->RangeMultiplier(8)
+    ->Range(kMinSize, kMaxSize);
+
+USERVER_NAMESPACE_END
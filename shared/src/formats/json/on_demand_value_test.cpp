@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/on_demand_value.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value.hpp>
+
+#include <formats/json/impl/on_demand_tape.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::string_view kDoc = R"({
+  "id": 42,
+  "name": "item",
+  "tags": ["a", "b", {"nested": [1, 2.5, -3e2]}],
+  "flags": {"enabled": true, "hidden": false, "extra": null},
+  "empty_object": {},
+  "empty_array": [],
+  "escaped\"key": "line\nbreak A\\"
+})";
+
+void ExpectSameAsDom(const formats::json::OnDemandValue& value,
+                     const formats::json::Value& dom) {
+  EXPECT_EQ(value.GetPath(), dom.GetPath());
+  EXPECT_EQ(value.IsNull(), dom.IsNull());
+  EXPECT_EQ(value.IsBool(), dom.IsBool());
+  EXPECT_EQ(value.IsNumber(), dom.IsDouble());
+  EXPECT_EQ(value.IsString(), dom.IsString());
+  EXPECT_EQ(value.IsArray(), dom.IsArray());
+  EXPECT_EQ(value.IsObject(), dom.IsObject());
+  EXPECT_EQ(value.Materialize(), formats::json::FromString(ToString(dom)));
+
+  if (dom.IsArray() || dom.IsObject()) {
+    ASSERT_EQ(value.GetSize(), dom.GetSize());
+    auto it = value.begin();
+    for (auto dom_it = dom.begin(); dom_it != dom.end(); ++dom_it, ++it) {
+      ASSERT_NE(it, value.end());
+      if (dom.IsObject()) {
+        EXPECT_EQ(it.GetName(), dom_it.GetName());
+      } else {
+        EXPECT_EQ(it.GetIndex(), dom_it.GetIndex());
+      }
+      ExpectSameAsDom(*it, *dom_it);
+    }
+    EXPECT_EQ(it, value.end());
+  }
+}
+
+// Structurals of the document, found char by char
+std::vector<std::uint32_t> FindStructuralsReference(std::string_view json) {
+  std::vector<std::uint32_t> result;
+  bool in_string = false;
+  bool in_scalar = false;
+  for (std::size_t i = 0; i < json.size(); ++i) {
+    const char c = json[i];
+    if (in_string) {
+      if (c == '\\') {
+        ++i;
+      } else if (c == '"') {
+        result.push_back(i);
+        in_string = false;
+      }
+      continue;
+    }
+    const bool is_op =
+        std::string_view{"{}[]:,"}.find(c) != std::string_view::npos;
+    const bool is_space = c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    if (c == '"') {
+      result.push_back(i);
+      in_string = true;
+    } else if (is_op || (!is_space && !in_scalar)) {
+      result.push_back(i);
+    }
+    in_scalar = !is_op && !is_space && c != '"';
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(FormatsJsonOnDemand, Sample) {
+  /// [Sample OnDemandValue usage]
+  const std::string json = R"({"key": {"array": [1, 2, "three"]}, "big": [1]})";
+  const auto value = formats::json::FromString(json, formats::json::kOnDemand);
+
+  EXPECT_EQ(value["key"]["array"][0].As<int>(), 1);
+  EXPECT_EQ(value["key"]["array"][2].As<std::string>(), "three");
+  EXPECT_EQ(value["key"]["array"].GetRawJson(), R"([1, 2, "three"])");
+  EXPECT_EQ(value["missing"].As<int>(42), 42);
+
+  const formats::json::Value big = value["big"].Materialize();
+  EXPECT_EQ(big[0].As<int>(), 1);
+  /// [Sample OnDemandValue usage]
+}
+
+TEST(FormatsJsonOnDemand, SameAsDom) {
+  const auto value = formats::json::FromString(kDoc, formats::json::kOnDemand);
+  ExpectSameAsDom(value, formats::json::FromString(kDoc));
+}
+
+TEST(FormatsJsonOnDemand, Scalars) {
+  const auto value = formats::json::FromString(kDoc, formats::json::kOnDemand);
+
+  EXPECT_EQ(value["id"].As<int>(), 42);
+  EXPECT_EQ(value["name"].As<std::string>(), "item");
+  EXPECT_EQ(value["tags"][2]["nested"][1].As<double>(), 2.5);
+  EXPECT_EQ(value["tags"][2]["nested"][2].As<int>(), -300);
+  EXPECT_TRUE(value["flags"]["enabled"].As<bool>());
+  EXPECT_FALSE(value["flags"]["hidden"].As<bool>());
+  EXPECT_TRUE(value["flags"]["extra"].IsNull());
+  EXPECT_EQ(value["escaped\"key"].As<std::string>(), "line\nbreak A\\");
+  EXPECT_EQ(value["tags"][2]["nested"][2].GetRawJson(), "-3e2");
+}
+
+TEST(FormatsJsonOnDemand, Paths) {
+  const auto value = formats::json::FromString(kDoc, formats::json::kOnDemand);
+
+  EXPECT_EQ(value.GetPath(), "/");
+  EXPECT_EQ(value["tags"][2]["nested"][1].GetPath(), "tags[2].nested[1]");
+  EXPECT_EQ(value["escaped\"key"].GetPath(), "escaped\"key");
+  EXPECT_EQ(value["flags"]["missing"]["deeper"].GetPath(),
+            "flags.missing.deeper");
+}
+
+TEST(FormatsJsonOnDemand, Missing) {
+  const auto value = formats::json::FromString(kDoc, formats::json::kOnDemand);
+
+  EXPECT_TRUE(value["missing"].IsMissing());
+  EXPECT_TRUE(value["missing"]["deeper"].IsMissing());
+  EXPECT_FALSE(value["missing"].IsNull());
+  EXPECT_FALSE(value.HasMember("missing"));
+  EXPECT_TRUE(value.HasMember("flags"));
+  EXPECT_EQ(value["flags"]["extra"].As<int>(1), 1);
+  EXPECT_THROW(value["missing"].As<int>(),
+               formats::json::MemberMissingException);
+  EXPECT_THROW(value["missing"].GetRawJson(),
+               formats::json::MemberMissingException);
+}
+
+TEST(FormatsJsonOnDemand, TypeMismatch) {
+  const auto value = formats::json::FromString(kDoc, formats::json::kOnDemand);
+
+  EXPECT_THROW(value["id"]["field"], formats::json::TypeMismatchException);
+  EXPECT_THROW(value["id"][0], formats::json::TypeMismatchException);
+  EXPECT_THROW(value["name"].GetSize(), formats::json::TypeMismatchException);
+  EXPECT_THROW(value["tags"]["field"], formats::json::TypeMismatchException);
+  EXPECT_THROW(value["tags"].begin().GetName(),
+               formats::json::TypeMismatchException);
+  EXPECT_THROW(value["name"].As<bool>(), formats::json::TypeMismatchException);
+  EXPECT_THROW(value["name"].As<int>(), formats::json::TypeMismatchException);
+  EXPECT_THROW(value["tags"][3], formats::json::OutOfBoundsException);
+}
+
+TEST(FormatsJsonOnDemand, Null) {
+  const formats::json::OnDemandValue value;
+  EXPECT_TRUE(value.IsNull());
+  EXPECT_TRUE(value.IsEmpty());
+  EXPECT_EQ(value.begin(), value.end());
+  EXPECT_TRUE(value["key"].IsMissing());
+  EXPECT_EQ(value.GetRawJson(), "null");
+  EXPECT_TRUE(value.Materialize().IsNull());
+}
+
+TEST(FormatsJsonOnDemand, ParseErrors) {
+  using formats::json::FromString;
+  using formats::json::kOnDemand;
+  using formats::json::ParseException;
+
+  EXPECT_NO_THROW(FromString(" {} ", kOnDemand));
+  EXPECT_NO_THROW(FromString("1", kOnDemand));
+  EXPECT_NO_THROW(FromString(R"("string")", kOnDemand));
+
+  EXPECT_THROW(FromString("", kOnDemand), ParseException);
+  EXPECT_THROW(FromString("   ", kOnDemand), ParseException);
+  EXPECT_THROW(FromString("{}{}", kOnDemand), ParseException);
+  EXPECT_THROW(FromString("[1 2]", kOnDemand), ParseException);
+  EXPECT_THROW(FromString("[1,]", kOnDemand), ParseException);
+  EXPECT_THROW(FromString("[1", kOnDemand), ParseException);
+  EXPECT_THROW(FromString("{\"a\" 1}", kOnDemand), ParseException);
+  EXPECT_THROW(FromString("{1: 1}", kOnDemand), ParseException);
+  EXPECT_THROW(FromString("{\"a\": 1]", kOnDemand), ParseException);
+  EXPECT_THROW(FromString(R"({"a": "unterminated})", kOnDemand),
+               ParseException);
+  EXPECT_THROW(FromString(R"(["escaped quote\"])", kOnDemand),
+               ParseException);
+  EXPECT_THROW(FromString("'string'", kOnDemand), ParseException);
+
+  try {
+    FromString("{\n  \"a\": 1,\n  \"b\" 2\n}", kOnDemand);
+    FAIL() << "ParseException expected";
+  } catch (const ParseException& e) {
+    EXPECT_EQ(std::string{e.what()},
+              "JSON parse error at line 3 column 7: Missing a colon after a "
+              "name of object member.");
+  }
+
+  // scalars are validated on access
+  const auto value = FromString("[tru, 1x]", kOnDemand);
+  EXPECT_THROW(value[0].As<bool>(), ParseException);
+  EXPECT_THROW(value[1].As<int>(), ParseException);
+}
+
+TEST(FormatsJsonOnDemand, StructuralsMatchReference) {
+  using formats::json::impl::FindStructurals;
+  using formats::json::impl::SimdLevel;
+
+  std::string json = "[";
+  for (int i = 0; i < 100; ++i) {
+    // backslash runs of different lengths cross the 64-byte blocks
+    json += R"({"k\\\"": "v)" + std::string(i % 7, '\\') +
+            std::string(i % 7 % 2, '\\') + R"(", "n": -1.5e3, "t": true},)";
+  }
+  json += "null]";
+  ASSERT_NO_THROW(formats::json::FromString(json));
+
+  const auto reference = FindStructuralsReference(json);
+  EXPECT_EQ(FindStructurals(json, SimdLevel::kScalar), reference);
+  if (formats::json::impl::GetSimdLevel() == SimdLevel::kAvx2) {
+    EXPECT_EQ(FindStructurals(json, SimdLevel::kAvx2), reference);
+  }
+
+  const auto value = formats::json::FromString(json, formats::json::kOnDemand);
+  ExpectSameAsDom(value, formats::json::FromString(json));
+}
+
+USERVER_NAMESPACE_END
@@ -1,7 +1,17 @@
 #include <benchmark/benchmark.h>
 
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/serialize_duration.hpp>
 #include <userver/formats/json/string_builder.hpp>
 #include <userver/formats/json/value_builder.hpp>
+#include <userver/formats/serialize/common_containers.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -73,4 +83,86 @@ void JsonStringBuilder(benchmark::State& state) {
 }
 BENCHMARK(JsonStringBuilder)->RangeMultiplier(4)->Range(1, 1024);
 
+namespace {
+
+// An element of the list responses
+struct Item {
+  std::string id;
+  std::int64_t count;
+  double price;
+  std::optional<std::string> comment;
+  std::vector<std::string> tags;
+  std::chrono::milliseconds ttl;
+};
+
+Value Serialize(const Item& item, formats::serialize::To<Value>) {
+  ValueBuilder builder;
+  builder["id"] = item.id;
+  builder["count"] = item.count;
+  builder["price"] = item.price;
+  builder["comment"] = item.comment;
+  builder["tags"] = item.tags;
+  builder["ttl"] = item.ttl;
+  return builder.ExtractValue();
+}
+
+void WriteToStream(const Item& item, StringBuilder& sw) {
+  StringBuilder::ObjectGuard guard(sw);
+  sw.Key("id");
+  WriteToStream(item.id, sw);
+  sw.Key("count");
+  WriteToStream(item.count, sw);
+  sw.Key("price");
+  WriteToStream(item.price, sw);
+  sw.Key("comment");
+  WriteToStream(item.comment, sw);
+  sw.Key("tags");
+  WriteToStream(item.tags, sw);
+  sw.Key("ttl");
+  WriteToStream(item.ttl, sw);
+}
+
+std::vector<Item> BuildItems(std::size_t count) {
+  std::vector<Item> items;
+  items.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    items.push_back({fmt::format("item-{:08}", i),
+                     static_cast<std::int64_t>(i * 7), i * 0.25,
+                     i % 2 ? std::nullopt
+                           : std::optional<std::string>{"some comment"},
+                     {"first-tag", "second-tag", "third-tag"},
+                     std::chrono::milliseconds{i}});
+  }
+  return items;
+}
+
+}  // namespace
+
+// ~120 bytes per item, 60 KB - 1 MB responses
+void JsonSerializeListDom(benchmark::State& state) {
+  const auto items = BuildItems(state.range(0));
+  std::size_t size = 0;
+  for (auto _ : state) {
+    const auto res = ToString(ValueBuilder(items).ExtractValue());
+    size = res.size();
+    benchmark::DoNotOptimize(res);
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(JsonSerializeListDom)->RangeMultiplier(4)->Range(512, 8192);
+
+void JsonSerializeListStream(benchmark::State& state) {
+  const auto items = BuildItems(state.range(0));
+  std::size_t size = 0;
+  for (auto _ : state) {
+    StringBuilder sw;
+    WriteToStream(items, sw);
+    const auto res = sw.GetString();
+    size = res.size();
+    benchmark::DoNotOptimize(res);
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(JsonSerializeListStream)->RangeMultiplier(4)->Range(512, 8192);
+
 USERVER_NAMESPACE_END
@@ -1,12 +1,20 @@
 #include <gtest/gtest.h>
 
 #include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/serialize_boost_variant.hpp>
 #include <userver/formats/json/serialize_duration.hpp>
+#include <userver/formats/json/serialize_variant.hpp>
 #include <userver/formats/json/string_builder.hpp>
 #include <userver/formats/json/value_builder.hpp>
+#include <userver/formats/serialize/boost_optional.hpp>
+#include <userver/formats/serialize/common_containers.hpp>
+#include <userver/utils/strong_typedef.hpp>
 
 #include <array>
 #include <cstring>
+#include <map>
+#include <unordered_map>
+#include <variant>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -217,6 +225,49 @@ TEST(JsonStringBuilder, FilledOptional) {
   EXPECT_EQ(sw.GetString(), "42");
 }
 
+TEST(JsonStringBuilder, StrongTypedef) {
+  using Id = utils::StrongTypedef<class IdTag, std::string>;
+  using Count = utils::StrongTypedef<class CountTag, int>;
+
+  StringBuilder sw;
+  WriteToStream(std::map<Id, std::vector<Count>>{{Id{"a"}, {Count{1}}}}, sw);
+  EXPECT_EQ(sw.GetString(), R"({"a":[1]})");
+}
+
+TEST(JsonStringBuilder, Variant) {
+  StringBuilder sw;
+  WriteToStream(std::vector<std::variant<int, std::string>>{1, "two"}, sw);
+  EXPECT_EQ(sw.GetString(), R"([1,"two"])");
+}
+
+TEST(JsonStringBuilder, BoostOptionalAndVariant) {
+  StringBuilder sw;
+  WriteToStream(std::vector<boost::optional<boost::variant<int, std::string>>>{
+                    {}, {1}, {std::string{"two"}}},
+                sw);
+  EXPECT_EQ(sw.GetString(), R"([null,1,"two"])");
+}
+
+TEST(JsonStringBuilder, SameAsValueBuilder) {
+  const std::unordered_map<std::string,
+                           std::vector<std::optional<std::chrono::seconds>>>
+      value{{"key", {std::chrono::seconds{1}, std::nullopt}}, {"empty", {}}};
+  const auto time_point = std::chrono::system_clock::time_point{} +
+                          std::chrono::hours{24 * 365};
+
+  StringBuilder sw;
+  {
+    StringBuilder::ArrayGuard guard(sw);
+    WriteToStream(value, sw);
+    WriteToStream(time_point, sw);
+  }
+
+  ValueBuilder builder;
+  builder.PushBack(value);
+  builder.PushBack(time_point);
+  EXPECT_EQ(FromString(sw.GetString()), builder.ExtractValue());
+}
+
 template <typename T>
 class JsonStringBuilderIntegralTypes : public ::testing::Test {};
 
@@ -27,6 +27,7 @@ std::string UrlDecode(std::string_view url) {
   }
 
   std::string res;
+  res.reserve(url.size());
   for (const char* ptr = data; ptr < data_end; ++ptr) {
     if (*ptr == '%') {
       if (ptr + 2 < data_end &&